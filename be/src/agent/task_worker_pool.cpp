@@ -55,6 +55,7 @@
 #include "util/scoped_cleanup.h"
 #include "util/stopwatch.hpp"
 #include "util/threadpool.h"
+#include "util/time.h"
 #include "util/trace.h"
 
 namespace doris {
@@ -1169,6 +1170,16 @@ void TaskWorkerPool::_report_tablet_worker_thread_callback() {
     TReportRequest request;
     request.__set_backend(_backend);
     request.__isset.tablets = true;
+    // Tablet reports only contain the tablets whose report stamp is larger than the stamp taken
+    // before the last successful report, except for the full reports. A full report is sent
+    // until master tells it handles incremental reports, every full_report_tablet_interval_seconds,
+    // when master asks for it, and after BE dropped tablets on its own, which only a full report
+    // can tell master.
+    bool master_supports_incremental_report = false;
+    bool need_full_report = true;
+    int64_t last_full_report_time = 0;
+    int64_t reported_stamp = 0;
+    int64_t self_dropped_tablet_count = 0;
     while (_is_work) {
         _is_doing_work = false;
 
@@ -1191,10 +1202,21 @@ void TaskWorkerPool::_report_tablet_worker_thread_callback() {
         // See _random_sleep() comment in _report_disk_state_worker_thread_callback
         _random_sleep(5);
         request.tablets.clear();
+        TabletManager* tablet_manager = StorageEngine::instance()->tablet_manager();
+        int64_t dropped_count = tablet_manager->self_dropped_tablet_count();
+        if (dropped_count != self_dropped_tablet_count) {
+            need_full_report = true;
+        }
+        bool full_report = need_full_report || !master_supports_incremental_report ||
+                           config::full_report_tablet_interval_seconds <= 0 ||
+                           MonotonicSeconds() - last_full_report_time >=
+                                   config::full_report_tablet_interval_seconds;
+        // a tablet changed after this is reported by the next report at the latest
+        int64_t report_stamp = TabletMeta::current_report_stamp();
         uint64_t report_version = _s_report_version;
         Status build_all_report_tablets_info_status =
-                StorageEngine::instance()->tablet_manager()->build_all_report_tablets_info(
-                        &request.tablets);
+                tablet_manager->build_all_report_tablets_info(&request.tablets,
+                                                              full_report ? 0 : reported_stamp);
         if (report_version < _s_report_version) {
             // TODO llj This can only reduce the possibility for report error, but can't avoid it.
             // If FE create a tablet in FE meta and send CREATE task to this BE, the tablet may not be included in this
@@ -1215,7 +1237,23 @@ void TaskWorkerPool::_report_tablet_worker_thread_callback() {
                          DorisMetrics::instance()->tablet_base_max_compaction_score->value());
         request.__set_tablet_max_compaction_score(max_compaction_score);
         request.__set_report_version(report_version);
-        _handle_report(request, ReportType::TABLET);
+        request.__set_incremental_tablet_report(!full_report);
+        TMasterResult result;
+        if (!_handle_report(request, ReportType::TABLET, &result)) {
+            // the changed tablets are sent again by the next report
+            continue;
+        }
+        reported_stamp = report_stamp;
+        if (full_report) {
+            need_full_report = false;
+            last_full_report_time = MonotonicSeconds();
+            self_dropped_tablet_count = dropped_count;
+        }
+        // a master which does not know incremental reports never sets need_full_tablet_report
+        master_supports_incremental_report = result.__isset.need_full_tablet_report;
+        if (result.__isset.need_full_tablet_report && result.need_full_tablet_report) {
+            need_full_report = true;
+        }
     }
     StorageEngine::instance()->deregister_report_listener(this);
 }
@@ -1554,8 +1592,10 @@ Status TaskWorkerPool::_move_dir(const TTabletId tablet_id, const std::string& s
     return Status::OK();
 }
 
-void TaskWorkerPool::_handle_report(TReportRequest& request, ReportType type) {
-    TMasterResult result;
+bool TaskWorkerPool::_handle_report(TReportRequest& request, ReportType type,
+                                    TMasterResult* master_result) {
+    TMasterResult local_result;
+    TMasterResult& result = master_result != nullptr ? *master_result : local_result;
     Status status = _master_client->report(request, &result);
     bool is_report_success = false;
     if (!status.ok()) {
@@ -1601,6 +1641,7 @@ void TaskWorkerPool::_handle_report(TReportRequest& request, ReportType type) {
     default:
         break;
     }
+    return is_report_success;
 }
 
 void TaskWorkerPool::_random_sleep(int second) {
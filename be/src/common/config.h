@@ -107,6 +107,10 @@ CONF_mInt32(report_task_interval_seconds, "10");
 CONF_mInt32(report_disk_state_interval_seconds, "60");
 // the interval time(seconds) for agent report olap table to FE
 CONF_mInt32(report_tablet_interval_seconds, "60");
+// the interval time(seconds) for agent report all olap tables to FE. The reports in between only
+// contain the tablets changed since the last report, if FE supports incremental tablet reports.
+// Set it to 0 to always report all tablets.
+CONF_mInt32(full_report_tablet_interval_seconds, "3600");
 // the max download speed(KB/s)
 CONF_mInt32(max_download_speed_kbps, "50000");
 // download low speed limit(KB/s)
@@ -181,6 +185,10 @@ CONF_mInt32(max_pushdown_conditions_per_column, "1024");
 CONF_mInt32(doris_max_pushdown_conjuncts_return_rate, "90");
 // (Advanced) Maximum size of per-query receive-side buffer
 CONF_mInt32(exchg_node_buffer_size_bytes, "10485760");
+// A merging exchange with more senders than parallel_merge_runs_per_thread merges every
+// parallel_merge_runs_per_thread senders in a separate thread before the final merge.
+// 0 disables the parallel merge.
+CONF_mInt32(parallel_merge_runs_per_thread, "16");
 // push_write_mbytes_per_sec
 CONF_mInt32(push_write_mbytes_per_sec, "100");
 
@@ -234,6 +242,19 @@ CONF_Int32(storage_page_cache_shard_size, "16");
 CONF_Int32(index_page_cache_percentage, "10");
 // whether to disable page cache feature in storage
 CONF_Bool(disable_storage_page_cache, "false");
+// Whether to use scan resistant 2Q eviction policy for data page cache, so a large scan
+// can't wash out the hot data pages. Lookups of data page cache also don't block each other.
+CONF_Bool(enable_storage_page_cache_scan_resistance, "true");
+// Percentage of data page cache used to cache compressed data pages. Compressed pages are
+// promoted to the decompressed part when they are hit again. 0 means disabled.
+CONF_Int32(compressed_data_page_cache_percentage, "0");
+// Percentage of index page cache used to cache the short key index and key bloom filter pages of
+// segments apart from the other index pages. 0 means they share the index page cache.
+CONF_Int32(key_index_page_cache_percentage, "0");
+// Whether to write a bloom filter of the keys of every segment of unique key tablets, so a lookup
+// of a single key skips the segments without it. It costs memory for every open segment, so it is
+// only worth enabling for tablets serving point lookups.
+CONF_Bool(enable_segment_key_bloom_filter, "false");
 
 CONF_Bool(enable_storage_vectorization, "false");
 
@@ -244,6 +265,21 @@ CONF_Bool(enable_low_cardinality_optimize, "false");
 CONF_mBool(disable_auto_compaction, "false");
 // whether enable vectorized compaction
 CONF_Bool(enable_vectorized_compaction, "true");
+// whether enable vertical compaction, which merges key columns first and then merges value
+// columns group by group, so that the memory usage is bounded by a column group.
+// only works when vectorized compaction is enabled.
+CONF_mBool(enable_vertical_compaction, "false");
+// number of value columns merged together in one group of vertical compaction
+CONF_mInt32(vertical_compaction_num_columns_per_group, "5");
+// max memory of row sources kept by vertical compaction, the rest will be spilled to disk
+CONF_mInt64(vertical_compaction_max_row_source_memory_mb, "200");
+// whether enable ordered data compaction, which links the segment files of input rowsets
+// to the output rowset directly if the keys of input segments are in order.
+// only works for DUP_KEYS tables.
+CONF_mBool(enable_ordered_data_compaction, "true");
+// ordered data compaction is only done when the average segment size of every input rowset
+// is larger than this value, to avoid keeping too many small segments.
+CONF_mInt64(ordered_data_compaction_min_segment_size, "10485760");
 // check the configuration of auto compaction in seconds when auto compaction disabled
 CONF_mInt32(check_auto_compaction_interval_seconds, "5");
 
@@ -337,6 +373,10 @@ CONF_mInt64(tablet_scan_frequency_time_node_interval_second, "300");
 // coefficient for tablet scan frequency and compaction score when finding a tablet for compaction
 CONF_mInt32(compaction_tablet_scan_frequency_factor, "0");
 CONF_mInt32(compaction_tablet_compaction_score_factor, "1");
+// coefficient for tablet read amplification when finding a tablet for compaction. The read
+// amplification is the number of segments opened by queries per minute, scaled up by the
+// ratio of scanned rows that were merged away, so hot and fragmented tablets are compacted first.
+CONF_mInt32(compaction_tablet_read_amplification_factor, "0");
 
 // This config can be set to limit thread number in tablet migration thread pool.
 CONF_Int32(min_tablet_migration_threads, "1");
@@ -368,6 +408,9 @@ CONF_mInt64(streaming_load_max_mb, "10240");
 // Therefore, it is necessary to limit the maximum number of
 // such data when using stream load to prevent excessive memory consumption.
 CONF_mInt64(streaming_load_json_max_mb, "100");
+// Whether to parse json load data by simdjson on demand API in vectorized json scanner,
+// only works for the json data without jsonpaths and json_root.
+CONF_mBool(enable_simdjson_reader, "true");
 // the alive time of a TabletsChannel.
 // If the channel does not receive any data till this time,
 // the channel will be removed.
@@ -387,6 +430,11 @@ CONF_Int32(stream_load_record_expire_time_secs, "28800");
 // time interval to clean expired stream load records
 CONF_mInt64(clean_stream_load_record_interval_secs, "1800");
 CONF_mBool(disable_stream_load_2pc, "true");
+// Number of scanners that parse the body of a single csv or line-delimited json stream load
+// in parallel, the body is split at line boundaries. The rows with the same key of a unique
+// key table without sequence column may be applied in a different order than in the body,
+// so it is disabled by default.
+CONF_mInt32(stream_load_parallel_scanner_num, "1");
 
 // OlapTableSink sender's send interval, should be less than the real response time of a tablet writer rpc.
 // You may need to lower the speed when the sink receiver bes are too busy.
@@ -431,6 +479,21 @@ CONF_Int64(chunk_reserved_bytes_limit, "2147483648");
 // Enable quadratic probing hash table
 CONF_Bool(enable_quadratic_probing, "false");
 
+// The hash table of a vectorized aggregation is converted to a two-level one, whose 256 buckets
+// are resized separately and built into the result in parallel, when it has more keys than
+// agg_two_level_hash_table_threshold_rows or takes more memory than
+// agg_two_level_hash_table_threshold_bytes. 0 disables the check.
+CONF_mInt64(agg_two_level_hash_table_threshold_rows, "100000");
+CONF_mInt64(agg_two_level_hash_table_threshold_bytes, "52428800");
+// number of threads building the result of two-level aggregation hash tables
+CONF_Int32(agg_thread_pool_thread_num, "16");
+// number of tasks queued in the thread pool of aggregation
+CONF_Int32(agg_thread_pool_queue_size, "102400");
+// The vectorized analytic node writes the columns of the buffered blocks waiting for output to a
+// tmp file, except for the partition by and order by columns, when they take more memory than
+// analytic_spill_threshold_bytes. 0 disables spilling.
+CONF_mInt64(analytic_spill_threshold_bytes, "2147483648");
+
 // for pprof
 CONF_String(pprof_profile_dir, "${DORIS_HOME}/log");
 
@@ -513,6 +576,17 @@ CONF_Int32(routine_load_thread_pool_size, "10");
 // default is 20, batch_size's default value is 1024 means 20 * 1024 rows will be cached
 CONF_mInt32(max_memory_sink_batch_count, "20");
 
+// the number of threads serving fetch_arrow_data, which waits for the next arrow record batch
+// of a memory scratch sink
+CONF_Int32(fetch_arrow_data_threads, "8");
+
+// the max number of prepared point lookups kept by a BE, the point lookups of a statement reuse
+// the columns prepared by the first of them
+CONF_Int32(point_lookup_prepared_cache_capacity, "1024");
+
+// the number of threads serving tablet_key_lookup, which reads the segments of a tablet
+CONF_Int32(point_lookup_threads, "16");
+
 // This configuration is used for the context gc thread schedule period
 // note: unit is minute, default is 5min
 CONF_mInt32(scan_context_gc_interval_min, "5");
@@ -585,6 +659,12 @@ CONF_Int32(txn_shard_size, "1024");
 // Whether to continue to start be when load tablet from header failed.
 CONF_Bool(ignore_load_tablet_failure, "false");
 
+// number of threads to load the tablets and rowsets of a data dir when be starts
+CONF_Int32(load_tablet_thread_num_per_store, "4");
+// number of tablet metas read from the meta env of a data dir before they are loaded by the
+// load threads, only a batch of them is held in memory
+CONF_Int32(load_tablet_batch_size, "1024");
+
 // Whether to continue to start be when load tablet from header failed.
 CONF_mBool(ignore_rowset_stale_unconsistent_delete, "false");
 
@@ -324,11 +324,19 @@ Status BaseScanner::_materialize_dest_block(vectorized::Block* dest_block) {
         }
         int dest_index = ctx_idx++;
 
-        auto* ctx = _dest_vexpr_ctx[dest_index];
-        int result_column_id = -1;
-        // PT1 => dest primitive type
-        RETURN_IF_ERROR(ctx->execute(&_src_block, &result_column_id));
-        auto column_ptr = _src_block.get_by_position(result_column_id).column;
+        const TextDestColumn* text_column = nullptr;
+        vectorized::ColumnPtr column_ptr;
+        if (dest_index < _text_dest_columns.size() && _text_dest_columns[dest_index].column) {
+            // already parsed from the text by the scanner
+            text_column = &_text_dest_columns[dest_index];
+            column_ptr = text_column->column;
+        } else {
+            auto* ctx = _dest_vexpr_ctx[dest_index];
+            int result_column_id = -1;
+            // PT1 => dest primitive type
+            RETURN_IF_ERROR(ctx->execute(&_src_block, &result_column_id));
+            column_ptr = _src_block.get_by_position(result_column_id).column;
+        }
 
         // because of src_slot_desc is always be nullable, so the column_ptr after do dest_expr
         // is likely to be nullable
@@ -337,17 +345,23 @@ Status BaseScanner::_materialize_dest_block(vectorized::Block* dest_block) {
                     reinterpret_cast<const vectorized::ColumnNullable*>(column_ptr.get());
             for (int i = 0; i < rows; ++i) {
                 if (filter_map[i] && nullable_column->is_null_at(i)) {
+                    bool src_is_null = text_column != nullptr
+                                               ? text_column->src_null_map[i]
+                                               : _src_block.get_by_position(dest_index)
+                                                         .column->is_null_at(i);
                     if (_strict_mode && (_src_slot_descs_order_by_dest[dest_index]) &&
-                        !_src_block.get_by_position(dest_index).column->is_null_at(i)) {
+                        !src_is_null) {
                         RETURN_IF_ERROR(_state->append_error_msg_to_file(
+                                [&]() -> std::string { return _dump_src_line(i); },
                                 [&]() -> std::string {
-                                    return _src_block.dump_one_line(i, _num_of_columns_from_file);
-                                },
-                                [&]() -> std::string {
-                                    auto raw_value =
-                                            _src_block.get_by_position(ctx_idx).column->get_data_at(
-                                                    i);
-                                    std::string raw_string = raw_value.to_string();
+                                    std::string raw_string;
+                                    if (text_column != nullptr) {
+                                        raw_string = (*text_column->values)[i].to_string();
+                                    } else {
+                                        raw_string = _src_block.get_by_position(ctx_idx)
+                                                             .column->get_data_at(i)
+                                                             .to_string();
+                                    }
                                     fmt::memory_buffer error_msg;
                                     fmt::format_to(error_msg,
                                                    "column({}) value is incorrect while strict "
@@ -360,9 +374,7 @@ Status BaseScanner::_materialize_dest_block(vectorized::Block* dest_block) {
                         filter_map[i] = false;
                     } else if (!slot_desc->is_nullable()) {
                         RETURN_IF_ERROR(_state->append_error_msg_to_file(
-                                [&]() -> std::string {
-                                    return _src_block.dump_one_line(i, _num_of_columns_from_file);
-                                },
+                                [&]() -> std::string { return _dump_src_line(i); },
                                 [&]() -> std::string {
                                     fmt::memory_buffer error_msg;
                                     fmt::format_to(error_msg,
@@ -386,6 +398,9 @@ Status BaseScanner::_materialize_dest_block(vectorized::Block* dest_block) {
 
     // after do the dest block insert operation, clear _src_block to remove the reference of origin column
     _src_block.clear();
+    for (auto& text_column : _text_dest_columns) {
+        text_column.column = nullptr;
+    }
 
     size_t dest_size = dest_block->columns();
     // do filter
@@ -398,6 +413,27 @@ Status BaseScanner::_materialize_dest_block(vectorized::Block* dest_block) {
     return Status::OK();
 }
 
+std::string BaseScanner::_dump_src_line(size_t row) const {
+    if (_text_dest_columns.empty()) {
+        return _src_block.dump_one_line(row, _num_of_columns_from_file);
+    }
+    // the src columns of the parsed dest columns are nulls, dump their text instead
+    std::vector<const std::vector<Slice>*> text_values(_num_of_columns_from_file, nullptr);
+    for (const auto& text_column : _text_dest_columns) {
+        if (text_column.column) {
+            text_values[text_column.src_index] = text_column.values;
+        }
+    }
+    fmt::memory_buffer buffer;
+    for (int i = 0; i < _num_of_columns_from_file; ++i) {
+        std::string value = text_values[i] != nullptr
+                                    ? (*text_values[i])[row].to_string()
+                                    : _src_block.get_by_position(i).to_string(row);
+        fmt::format_to(buffer, i == 0 ? "{}" : " {}", value);
+    }
+    return fmt::to_string(buffer);
+}
+
 // TODO: opt the reuse of src_block or dest_block column. some case we have to
 // shallow copy the column of src_block to dest block
 Status BaseScanner::_init_src_block() {
@@ -21,6 +21,8 @@
 #include "exprs/expr.h"
 #include "runtime/tuple.h"
 #include "util/runtime_profile.h"
+#include "util/slice.h"
+#include "vec/columns/column_nullable.h"
 #include "vec/exprs/vexpr.h"
 #include "vec/exprs/vexpr_context.h"
 
@@ -142,10 +144,25 @@ protected:
     vectorized::Block _src_block;
     int _num_of_columns_from_file;
 
+    // A dest column that the scanner parsed straight from the text of one src slot, instead of
+    // evaluating its dest expr on the src block. The column of the src slot in the src block
+    // only holds nulls then.
+    struct TextDestColumn {
+        vectorized::ColumnPtr column;
+        int src_index = -1;
+        // the text of each row, valid until the next batch is read
+        const std::vector<Slice>* values = nullptr;
+        // set for the rows whose text is the null marker
+        vectorized::NullMap src_null_map;
+    };
+    // indexed like _dest_vexpr_ctx, the dest exprs of entries without column are evaluated
+    std::vector<TextDestColumn> _text_dest_columns;
+
 private:
     Status _filter_src_block();
     void _fill_columns_from_path();
     Status _materialize_dest_block(vectorized::Block* output_block);
+    std::string _dump_src_line(size_t row) const;
     Status _fill_dest_tuple(Tuple* dest_tuple, MemPool* mem_pool);
 };
 
@@ -252,6 +252,7 @@ Status BrokerScanner::open_line_reader() {
     if (_cur_line_reader != nullptr) {
         delete _cur_line_reader;
         _cur_line_reader = nullptr;
+        _value_separator_positions = nullptr;
     }
 
     const TBrokerRangeDesc& range = _ranges[_next_range];
@@ -279,10 +280,18 @@ Status BrokerScanner::open_line_reader() {
     case TFileFormatType::FORMAT_CSV_BZ2:
     case TFileFormatType::FORMAT_CSV_LZ4FRAME:
     case TFileFormatType::FORMAT_CSV_LZOP:
-    case TFileFormatType::FORMAT_CSV_DEFLATE:
-        _cur_line_reader = new PlainTextLineReader(_profile, _cur_file_reader, _cur_decompressor,
-                                                   size, _line_delimiter, _line_delimiter_length);
+    case TFileFormatType::FORMAT_CSV_DEFLATE: {
+        auto text_line_reader =
+                new PlainTextLineReader(_profile, _cur_file_reader, _cur_decompressor, size,
+                                        _line_delimiter, _line_delimiter_length);
+        // find the value separators together with the line delimiter
+        if (_value_separator_length == 1 &&
+            text_line_reader->set_field_separator(_value_separator[0])) {
+            _value_separator_positions = &text_line_reader->field_separator_positions();
+        }
+        _cur_line_reader = text_line_reader;
         break;
+    }
     case TFileFormatType::FORMAT_PROTO:
         _cur_line_reader = new PlainBinaryLineReader(_cur_file_reader);
         break;
@@ -308,6 +317,7 @@ void BrokerScanner::close() {
     if (_cur_line_reader != nullptr) {
         delete _cur_line_reader;
         _cur_line_reader = nullptr;
+        _value_separator_positions = nullptr;
     }
 
     if (_cur_file_reader != nullptr) {
@@ -334,6 +344,28 @@ void BrokerScanner::split_line(const Slice& line) {
         }
         delete row;
         delete[] ptr;
+    } else if (_value_separator_positions != nullptr) {
+        // the line reader has found the separators
+        const char* value = line.data;
+        size_t start = 0;
+        for (size_t pos : *_value_separator_positions) {
+            size_t non_space = pos;
+            // Trim tailing spaces. Be consistent with hive and trino's behavior.
+            if (_state->trim_tailing_spaces_for_external_table_query()) {
+                while (non_space > start && *(value + non_space - 1) == ' ') {
+                    non_space--;
+                }
+            }
+            _split_values.emplace_back(value + start, non_space - start);
+            start = pos + 1;
+        }
+        size_t non_space = line.size;
+        if (_state->trim_tailing_spaces_for_external_table_query()) {
+            while (non_space > start && *(value + non_space - 1) == ' ') {
+                non_space--;
+            }
+        }
+        _split_values.emplace_back(value + start, non_space - start);
     } else {
         const char* value = line.data;
         size_t start = 0;     // point to the start pos of next col value.
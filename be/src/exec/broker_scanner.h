@@ -111,6 +111,9 @@ protected:
     LineReader* _cur_line_reader;
     Decompressor* _cur_decompressor;
     bool _cur_line_reader_eof;
+    // positions of value separators saved by _cur_line_reader when it reads the line,
+    // nullptr if the line has to be scanned for them in split_line()
+    const std::vector<size_t>* _value_separator_positions = nullptr;
 
     // When we fetch range start from 0, header_type="csv_with_names" skip first line
     // When we fetch range start from 0, header_type="csv_with_names_and_types" skip first two line
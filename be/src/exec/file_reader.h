@@ -22,6 +22,7 @@
 #include <memory>
 
 #include "common/status.h"
+#include "util/byte_buffer.h"
 
 namespace doris {
 
@@ -43,6 +44,25 @@ public:
      *  other return readed bytes.
      */
     virtual Status read_one_message(std::unique_ptr<uint8_t[]>* buf, int64_t* length) = 0;
+
+    /**
+     * Same as read_one_message(), but the message is held by buf, which may wrap the memory
+     *  the reader keeps the message in instead of a copy of it.
+     *
+     * if read eof then return Status::OK and buf is set nullptr.
+     */
+    virtual Status read_one_buffer(ByteBufferPtr* buf) {
+        std::unique_ptr<uint8_t[]> data;
+        int64_t length = 0;
+        RETURN_IF_ERROR(read_one_message(&data, &length));
+        if (length == 0) {
+            buf->reset();
+            return Status::OK();
+        }
+        uint8_t* ptr = data.release();
+        *buf = ByteBuffer::wrap(reinterpret_cast<char*>(ptr), length, [ptr]() { delete[] ptr; });
+        return Status::OK();
+    }
     virtual int64_t size() = 0;
     virtual Status seek(int64_t position) = 0;
     virtual Status tell(int64_t* position) = 0;
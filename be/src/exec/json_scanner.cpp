@@ -378,24 +378,33 @@ void JsonReader::_close() {
 // return Status::DataQualityError() if data has quality error.
 // return other error if encounter other problemes.
 // return Status::OK() if parse succeed or reach EOF.
-Status JsonReader::_parse_json_doc(size_t* size, bool* eof) {
-    // read a whole message
+Status JsonReader::_read_one_message(ByteBufferPtr* file_buf, const uint8_t** json_str,
+                                     size_t* size, bool* eof) {
     SCOPED_TIMER(_file_read_timer);
-    const uint8_t* json_str = nullptr;
-    std::unique_ptr<uint8_t[]> json_str_ptr;
     if (_line_reader != nullptr) {
-        RETURN_IF_ERROR(_line_reader->read_line(&json_str, size, eof));
+        RETURN_IF_ERROR(_line_reader->read_line(json_str, size, eof));
     } else {
-        int64_t length = 0;
-        RETURN_IF_ERROR(_file_reader->read_one_message(&json_str_ptr, &length));
-        json_str = json_str_ptr.get();
-        *size = length;
-        if (length == 0) {
+        // a kafka message is read as the buffer it is received in, without copying it
+        RETURN_IF_ERROR(_file_reader->read_one_buffer(file_buf));
+        if (*file_buf == nullptr || !(*file_buf)->has_remaining()) {
+            *json_str = nullptr;
+            *size = 0;
             *eof = true;
+        } else {
+            *json_str = reinterpret_cast<const uint8_t*>((*file_buf)->ptr + (*file_buf)->pos);
+            *size = (*file_buf)->remaining();
         }
     }
 
     _bytes_read_counter += *size;
+    return Status::OK();
+}
+
+Status JsonReader::_parse_json_doc(size_t* size, bool* eof) {
+    // read a whole message
+    const uint8_t* json_str = nullptr;
+    ByteBufferPtr json_str_ptr;
+    RETURN_IF_ERROR(_read_one_message(&json_str_ptr, &json_str, size, eof));
     if (*eof) {
         return Status::OK();
     }
@@ -147,6 +147,9 @@ protected:
 
     void _fill_slot(Tuple* tuple, SlotDescriptor* slot_desc, MemPool* mem_pool,
                     const uint8_t* value, int32_t len);
+    // read a line or a whole message, file_buf holds the data if it is read from file reader
+    Status _read_one_message(ByteBufferPtr* file_buf, const uint8_t** json_str, size_t* size,
+                             bool* eof);
     Status _parse_json_doc(size_t* size, bool* eof);
     Status _set_tuple_value(rapidjson::Value& objectValue, Tuple* tuple,
                             const std::vector<SlotDescriptor*>& slot_descs, MemPool* tuple_pool,
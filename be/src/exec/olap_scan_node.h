@@ -320,6 +320,8 @@ protected:
     // page read from cache
     // used by segment v2
     RuntimeProfile::Counter* _cached_pages_num_counter = nullptr;
+    // page read from compressed tier of page cache
+    RuntimeProfile::Counter* _compressed_cached_pages_num_counter = nullptr;
 
     // row count filtered by bitmap inverted index
     RuntimeProfile::Counter* _bitmap_index_filter_counter = nullptr;
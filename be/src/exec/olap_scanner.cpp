@@ -87,23 +87,23 @@ Status OlapScanner::prepare(
             return Status::InternalError(ss.str());
         }
         {
-            std::shared_lock rdlock(_tablet->get_header_lock());
-            const RowsetSharedPtr rowset = _tablet->rowset_with_max_version();
-            if (rowset == nullptr) {
-                std::stringstream ss;
-                ss << "fail to get latest version of tablet: " << tablet_id;
-                LOG(WARNING) << ss.str();
-                return Status::InternalError(ss.str());
-            }
-
             // acquire tablet rowset readers at the beginning of the scan node
             // to prevent this case: when there are lots of olap scanners to run for example 10000
-            // the rowsets maybe compacted when the last olap scanner starts
+            // the rowsets maybe compacted when the last olap scanner starts.
+            // The header lock is only taken when the rowsets of the version are not captured
+            // by another scanner already.
             Version rd_version(0, _version);
-            Status acquire_reader_st =
-                    _tablet->capture_rs_readers(rd_version, &_tablet_reader_params.rs_readers);
+            Status acquire_reader_st = _tablet->capture_rs_readers(
+                    rd_version, &_tablet_reader_params.rs_readers, false);
             if (!acquire_reader_st.ok()) {
                 LOG(WARNING) << "fail to init reader.res=" << acquire_reader_st;
+                std::shared_lock rdlock(_tablet->get_header_lock());
+                if (_tablet->rowset_with_max_version() == nullptr) {
+                    std::stringstream ss;
+                    ss << "fail to get latest version of tablet: " << tablet_id;
+                    LOG(WARNING) << ss.str();
+                    return Status::InternalError(ss.str());
+                }
                 std::stringstream ss;
                 ss << "failed to initialize storage reader. tablet=" << _tablet->full_name()
                    << ", res=" << acquire_reader_st
@@ -570,6 +570,8 @@ void OlapScanner::update_counter() {
 
     COUNTER_UPDATE(_parent->_total_pages_num_counter, stats.total_pages_num);
     COUNTER_UPDATE(_parent->_cached_pages_num_counter, stats.cached_pages_num);
+    COUNTER_UPDATE(_parent->_compressed_cached_pages_num_counter,
+                   stats.compressed_cached_pages_num);
 
     COUNTER_UPDATE(_parent->_bitmap_index_filter_counter, stats.rows_bitmap_index_filtered);
     COUNTER_UPDATE(_parent->_bitmap_index_filter_timer, stats.bitmap_index_filter_timer);
@@ -584,6 +586,8 @@ void OlapScanner::update_counter() {
     _tablet->query_scan_bytes->increment(_compressed_bytes_read);
     _tablet->query_scan_rows->increment(_raw_rows_read);
     _tablet->query_scan_count->increment(1);
+    _tablet->query_scan_segments->increment(stats.total_segment_number);
+    _tablet->query_merged_rows->increment(_tablet_reader->merged_rows());
 
     _has_update_counter = true;
 }
@@ -20,6 +20,7 @@
 #include "common/status.h"
 #include "exec/decompressor.h"
 #include "exec/file_reader.h"
+#include "util/simd/bits.h"
 
 // INPUT_CHUNK must
 //  larger than 15B for correct lz4 file decompressing
@@ -91,10 +92,55 @@ inline bool PlainTextLineReader::update_eof() {
     return _eof;
 }
 
+bool PlainTextLineReader::set_field_separator(char field_separator) {
+    _save_field_pos = _line_delimiter_length == 1 && _line_delimiter[0] != field_separator;
+    _field_separator = field_separator;
+    return _save_field_pos;
+}
+
+inline void PlainTextLineReader::append_field_pos(uint64_t mask, size_t base) {
+    while (mask != 0) {
+        _field_pos.push_back(base + __builtin_ctzll(mask));
+        mask &= mask - 1;
+    }
+}
+
 uint8_t* PlainTextLineReader::update_field_pos_and_find_line_delimiter(const uint8_t* start,
                                                                        size_t len) {
-    // TODO: meanwhile find and save field pos
-    return (uint8_t*)memmem(start, len, _line_delimiter.c_str(), _line_delimiter_length);
+    if (!_save_field_pos) {
+        return (uint8_t*)memmem(start, len, _line_delimiter.c_str(), _line_delimiter_length);
+    }
+
+    // positions are relative to the line start, forget those found by a former scan of
+    // the same bytes
+    size_t base = start - (_output_buf + _output_buf_pos);
+    while (!_field_pos.empty() && _field_pos.back() >= base) {
+        _field_pos.pop_back();
+    }
+
+    const uint8_t line_delimiter = _line_delimiter[0];
+    const uint8_t field_separator = _field_separator;
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        uint64_t line_mask = simd::bytes64_mask_of_char(start + i, line_delimiter);
+        uint64_t field_mask = simd::bytes64_mask_of_char(start + i, field_separator);
+        if (line_mask != 0) {
+            // only the separators before the line delimiter belong to this line
+            size_t line_end = __builtin_ctzll(line_mask);
+            append_field_pos(field_mask & ((uint64_t(1) << line_end) - 1), base + i);
+            return const_cast<uint8_t*>(start + i + line_end);
+        }
+        append_field_pos(field_mask, base + i);
+    }
+    for (; i < len; ++i) {
+        if (start[i] == line_delimiter) {
+            return const_cast<uint8_t*>(start + i);
+        }
+        if (start[i] == field_separator) {
+            _field_pos.push_back(base + i);
+        }
+    }
+    return nullptr;
 }
 
 // extend input buf if necessary only when _more_input_bytes > 0
@@ -189,6 +235,7 @@ Status PlainTextLineReader::read_line(const uint8_t** ptr, size_t* size, bool* e
     }
     int found_line_delimiter = 0;
     size_t offset = 0;
+    _field_pos.clear();
     while (!done()) {
         // find line delimiter in current decompressed data
         uint8_t* cur_ptr = _output_buf + _output_buf_pos;
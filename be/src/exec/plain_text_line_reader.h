@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "exec/line_reader.h"
 #include "util/runtime_profile.h"
 
@@ -38,6 +40,16 @@ public:
 
     void close() override;
 
+    // Save the positions of the single byte field separator while looking for the line
+    // delimiter, so that a line does not have to be scanned again to split it.
+    // Return false if the positions can't be saved, which needs a single byte line delimiter
+    // different from the separator.
+    bool set_field_separator(char field_separator);
+
+    // positions of the field separators in the line returned by the last read_line(),
+    // relative to the start of the line. Only valid if set_field_separator() returned true.
+    const std::vector<size_t>& field_separator_positions() const { return _field_pos; }
+
 private:
     bool update_eof();
 
@@ -49,10 +61,13 @@ private:
 
     // find line delimiter from 'start' to 'start' + len,
     // return line delimiter pos if found, otherwise return nullptr.
-    // TODO:
-    //  save to positions of field separator
+    // If a field separator is set, also save the positions of field separator before the
+    // line delimiter, the bytes are compared 64 at a time.
     uint8_t* update_field_pos_and_find_line_delimiter(const uint8_t* start, size_t len);
 
+    // append the positions of the bits set in mask, bit 0 is at position 'base'
+    void append_field_pos(uint64_t mask, size_t base);
+
     void extend_input_buf();
     void extend_output_buf();
 
@@ -65,6 +80,10 @@ private:
     std::string _line_delimiter;
     size_t _line_delimiter_length;
 
+    bool _save_field_pos = false;
+    char _field_separator = 0;
+    std::vector<size_t> _field_pos;
+
     // save the data read from file reader
     uint8_t* _input_buf;
     size_t _input_buf_size;
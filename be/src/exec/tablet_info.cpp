@@ -565,6 +565,48 @@ uint32_t VOlapTablePartitionParam::find_tablet(BlockRow* block_row,
     return _compute_tablet_index(block_row, partition.num_buckets);
 }
 
+void VOlapTablePartitionParam::find_tablets(
+        vectorized::Block* block, const std::vector<const VOlapTablePartition*>& partitions,
+        std::vector<uint32_t>* tablet_indexes) const {
+    const size_t num_rows = partitions.size();
+    tablet_indexes->assign(num_rows, 0);
+    if (_distributed_slot_locs.empty()) {
+        for (size_t i = 0; i < num_rows; ++i) {
+            if (partitions[i] != nullptr) {
+                BlockRow block_row(block, i);
+                (*tablet_indexes)[i] = find_tablet(&block_row, *partitions[i]);
+            }
+        }
+        return;
+    }
+
+    // must be the same hash as _compute_tablet_index, only the loops are swapped
+    static const int INT_VALUE = 0;
+    static const TypeDescriptor INT_TYPE(TYPE_INT);
+    std::vector<uint32_t> hash_vals(num_rows, 0);
+    for (auto loc : _distributed_slot_locs) {
+        auto type = _slots[loc]->type().type;
+        const auto& column = block->get_by_position(loc).column;
+        for (size_t i = 0; i < num_rows; ++i) {
+            if (partitions[i] == nullptr) {
+                continue;
+            }
+            auto val = column->get_data_at(i);
+            if (val.data != nullptr) {
+                hash_vals[i] = RawValue::zlib_crc32(val.data, val.size, type, hash_vals[i]);
+            } else {
+                // NULL is treat as 0 when hash
+                hash_vals[i] = RawValue::zlib_crc32(&INT_VALUE, INT_TYPE, hash_vals[i]);
+            }
+        }
+    }
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (partitions[i] != nullptr) {
+            (*tablet_indexes)[i] = hash_vals[i] % partitions[i]->num_buckets;
+        }
+    }
+}
+
 Status VOlapTablePartitionParam::_create_partition_keys(const std::vector<TExprNode>& t_exprs,
                                                         BlockRow* part_key) {
     for (int i = 0; i < t_exprs.size(); i++) {
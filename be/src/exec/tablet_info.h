@@ -266,6 +266,12 @@ public:
 
     uint32_t find_tablet(BlockRow* block_row, const VOlapTablePartition& partition) const;
 
+    // find the tablet index of every row of block in one pass, the distributed columns are
+    // hashed column by column. partitions[i] is the partition of row i, nullptr means skip it.
+    void find_tablets(vectorized::Block* block,
+                      const std::vector<const VOlapTablePartition*>& partitions,
+                      std::vector<uint32_t>* tablet_indexes) const;
+
     const std::vector<VOlapTablePartition*>& get_partitions() const { return _partitions; }
 
 private:
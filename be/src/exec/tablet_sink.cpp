@@ -587,6 +587,38 @@ Status IndexChannel::init(RuntimeState* state, const std::vector<TTabletWithPart
     return Status::OK();
 }
 
+void IndexChannel::add_rows(vectorized::Block* block, const std::vector<int>& row_idxs,
+                            const std::vector<int64_t>& tablet_ids) {
+    SCOPED_SWITCH_THREAD_LOCAL_MEM_TRACKER(_index_channel_tracker);
+    std::unordered_map<NodeChannel*, std::pair<std::vector<int>, std::vector<int64_t>>>
+            rows_by_channel;
+    // rows of a tablet are usually adjacent, avoid looking up the same tablet again
+    int64_t last_tablet_id = -1;
+    const std::vector<std::shared_ptr<NodeChannel>>* channels = nullptr;
+    for (size_t i = 0; i < row_idxs.size(); ++i) {
+        if (channels == nullptr || tablet_ids[i] != last_tablet_id) {
+            auto it = _channels_by_tablet.find(tablet_ids[i]);
+            DCHECK(it != _channels_by_tablet.end())
+                    << "unknown tablet, tablet_id=" << tablet_ids[i];
+            channels = &it->second;
+            last_tablet_id = tablet_ids[i];
+        }
+        for (const auto& channel : *channels) {
+            auto& rows = rows_by_channel[channel.get()];
+            rows.first.push_back(row_idxs[i]);
+            rows.second.push_back(tablet_ids[i]);
+        }
+    }
+    for (auto& [channel, rows] : rows_by_channel) {
+        // if this node channel is already failed, this add_rows will be skipped
+        auto st = channel->add_rows(block, rows.first, rows.second);
+        if (!st.ok()) {
+            mark_as_failed(channel->node_id(), channel->host(), st.get_error_msg());
+            // continue add rows to other node, the error will be checked for every batch outside
+        }
+    }
+}
+
 void IndexChannel::mark_as_failed(int64_t node_id, const std::string& host, const std::string& err,
                                   int64_t tablet_id) {
     SCOPED_SWITCH_THREAD_LOCAL_MEM_TRACKER(_index_channel_tracker);
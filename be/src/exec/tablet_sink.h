@@ -180,8 +180,10 @@ public:
     virtual Status open_wait();
 
     Status add_row(Tuple* tuple, int64_t tablet_id);
-    virtual Status add_row(const BlockRow& block_row, int64_t tablet_id) {
-        LOG(FATAL) << "add block row to NodeChannel not supported";
+    // add the rows row_idxs of block, tablet_ids[i] is the tablet of row row_idxs[i]
+    virtual Status add_rows(vectorized::Block* block, const std::vector<int>& row_idxs,
+                            const std::vector<int64_t>& tablet_ids) {
+        LOG(FATAL) << "add block rows to NodeChannel not supported";
         return Status::OK();
     }
 
@@ -335,6 +337,11 @@ public:
     template <typename Row>
     void add_row(const Row& tuple, int64_t tablet_id);
 
+    // scatter the rows row_idxs of block to the node channels of their tablets, every node
+    // channel gets all of its rows in one call
+    void add_rows(vectorized::Block* block, const std::vector<int>& row_idxs,
+                  const std::vector<int64_t>& tablet_ids);
+
     void for_each_node_channel(
             const std::function<void(const std::shared_ptr<NodeChannel>&)>& func) {
         SCOPED_SWITCH_THREAD_LOCAL_MEM_TRACKER(_index_channel_tracker);
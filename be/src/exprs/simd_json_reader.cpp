@@ -0,0 +1,340 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "exprs/simd_json_reader.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "util/string_parser.hpp"
+
+namespace doris {
+
+bool SimdJsonReader::to_json_pointer(const std::vector<JsonPath>& parsed_paths,
+                                     std::string* pointer) {
+    // "$" alone means the whole document, leave it to rapidjson
+    if (parsed_paths.size() < 2 || !parsed_paths[0].is_valid) {
+        return false;
+    }
+
+    pointer->clear();
+    for (size_t i = 1; i < parsed_paths.size(); ++i) {
+        const JsonPath& path = parsed_paths[i];
+        if (!path.is_valid || path.idx == -2) {
+            return false;
+        }
+        if (!path.key.empty()) {
+            // A key made of digits is an array index in JSON pointer, but it is always a
+            // member name in our json path.
+            if (path.key == "-" || std::all_of(path.key.begin(), path.key.end(),
+                                               [](char c) { return c >= '0' && c <= '9'; })) {
+                return false;
+            }
+            pointer->push_back('/');
+            for (char c : path.key) {
+                if (c == '~') {
+                    pointer->append("~0");
+                } else if (c == '/') {
+                    pointer->append("~1");
+                } else {
+                    pointer->push_back(c);
+                }
+            }
+        }
+        if (path.idx >= 0) {
+            pointer->push_back('/');
+            pointer->append(std::to_string(path.idx));
+        }
+    }
+    return true;
+}
+
+bool SimdJsonReader::parse_number(std::string_view token, SimdJsonNumber* number) {
+    while (!token.empty() && (token.back() == ' ' || token.back() == '\t' ||
+                              token.back() == '\n' || token.back() == '\r')) {
+        token.remove_suffix(1);
+    }
+    if (token.empty()) {
+        return false;
+    }
+
+    StringParser::ParseResult result = StringParser::PARSE_SUCCESS;
+    if (token.find_first_of(".eE") == std::string_view::npos) {
+        if (token[0] == '-') {
+            number->int64_value =
+                    StringParser::string_to_int<int64_t>(token.data(), token.size(), &result);
+            number->type = SimdJsonNumber::INT64;
+        } else {
+            number->uint64_value = StringParser::string_to_unsigned_int<uint64_t>(
+                    token.data(), token.size(), &result);
+            number->type = SimdJsonNumber::UINT64;
+        }
+        if (result == StringParser::PARSE_SUCCESS) {
+            return true;
+        }
+        if (result != StringParser::PARSE_OVERFLOW && result != StringParser::PARSE_UNDERFLOW) {
+            return false;
+        }
+        // too large for 64 bits integer, parse it as double like rapidjson
+    }
+    number->double_value =
+            StringParser::string_to_float<double>(token.data(), token.size(), &result);
+    number->type = SimdJsonNumber::DOUBLE;
+    return result == StringParser::PARSE_SUCCESS;
+}
+
+simdjson::error_code SimdJsonReader::write_value(
+        simdjson::ondemand::value value, rapidjson::Writer<rapidjson::StringBuffer>* writer,
+        bool number_as_string) {
+    simdjson::ondemand::json_type type;
+    auto error = value.type().get(type);
+    if (error) {
+        return error;
+    }
+
+    switch (type) {
+    case simdjson::ondemand::json_type::object: {
+        simdjson::ondemand::object object;
+        if ((error = value.get_object().get(object))) {
+            return error;
+        }
+        writer->StartObject();
+        for (auto field_result : object) {
+            simdjson::ondemand::field field;
+            std::string_view key;
+            if ((error = field_result.get(field)) || (error = field.unescaped_key().get(key))) {
+                return error;
+            }
+            writer->Key(key.data(), key.size());
+            if ((error = write_value(field.value(), writer, number_as_string))) {
+                return error;
+            }
+        }
+        writer->EndObject();
+        break;
+    }
+    case simdjson::ondemand::json_type::array: {
+        simdjson::ondemand::array array;
+        if ((error = value.get_array().get(array))) {
+            return error;
+        }
+        writer->StartArray();
+        for (auto element_result : array) {
+            simdjson::ondemand::value element;
+            if ((error = element_result.get(element)) ||
+                (error = write_value(element, writer, number_as_string))) {
+                return error;
+            }
+        }
+        writer->EndArray();
+        break;
+    }
+    case simdjson::ondemand::json_type::string: {
+        std::string_view str;
+        if ((error = value.get_string().get(str))) {
+            return error;
+        }
+        writer->String(str.data(), str.size());
+        break;
+    }
+    case simdjson::ondemand::json_type::number: {
+        std::string_view token = value.raw_json_token();
+        SimdJsonNumber number;
+        if (!parse_number(token, &number)) {
+            return simdjson::NUMBER_ERROR;
+        }
+        if (number_as_string) {
+            writer->String(token.data(), token.find_last_not_of(" \t\n\r") + 1);
+        } else if (number.type == SimdJsonNumber::INT64) {
+            writer->Int64(number.int64_value);
+        } else if (number.type == SimdJsonNumber::UINT64) {
+            writer->Uint64(number.uint64_value);
+        } else {
+            writer->Double(number.double_value);
+        }
+        break;
+    }
+    case simdjson::ondemand::json_type::boolean: {
+        bool b = false;
+        if ((error = value.get_bool().get(b))) {
+            return error;
+        }
+        writer->Bool(b);
+        break;
+    }
+    case simdjson::ondemand::json_type::null:
+        writer->Null();
+        break;
+    }
+    return simdjson::SUCCESS;
+}
+
+// Consume value and everything in it, the grammar of each token is checked when it is
+// consumed.
+static simdjson::error_code validate_value(simdjson::ondemand::value value) {
+    simdjson::ondemand::json_type type;
+    auto error = value.type().get(type);
+    if (error) {
+        return error;
+    }
+
+    switch (type) {
+    case simdjson::ondemand::json_type::object: {
+        simdjson::ondemand::object object;
+        if ((error = value.get_object().get(object))) {
+            return error;
+        }
+        for (auto field_result : object) {
+            simdjson::ondemand::field field;
+            std::string_view key;
+            if ((error = field_result.get(field)) || (error = field.unescaped_key().get(key)) ||
+                (error = validate_value(field.value()))) {
+                return error;
+            }
+        }
+        break;
+    }
+    case simdjson::ondemand::json_type::array: {
+        simdjson::ondemand::array array;
+        if ((error = value.get_array().get(array))) {
+            return error;
+        }
+        for (auto element_result : array) {
+            simdjson::ondemand::value element;
+            if ((error = element_result.get(element)) || (error = validate_value(element))) {
+                return error;
+            }
+        }
+        break;
+    }
+    case simdjson::ondemand::json_type::string: {
+        std::string_view str;
+        error = value.get_string().get(str);
+        break;
+    }
+    case simdjson::ondemand::json_type::number: {
+        double d = 0;
+        error = value.get_double().get(d);
+        break;
+    }
+    case simdjson::ondemand::json_type::boolean: {
+        bool b = false;
+        error = value.get_bool().get(b);
+        break;
+    }
+    case simdjson::ondemand::json_type::null:
+        if (!value.is_null()) {
+            error = simdjson::N_ATOM_ERROR;
+        }
+        break;
+    }
+    return error;
+}
+
+simdjson::error_code SimdJsonReader::validate() {
+    simdjson::ondemand::json_type type;
+    auto error = _document.type().get(type);
+    if (!error) {
+        // the root is read from the document itself, since scalars at root are parsed
+        // differently from the ones in an object or array
+        switch (type) {
+        case simdjson::ondemand::json_type::object: {
+            simdjson::ondemand::object object;
+            if ((error = _document.get_object().get(object))) {
+                break;
+            }
+            for (auto field_result : object) {
+                simdjson::ondemand::field field;
+                std::string_view key;
+                if ((error = field_result.get(field)) ||
+                    (error = field.unescaped_key().get(key)) ||
+                    (error = validate_value(field.value()))) {
+                    break;
+                }
+            }
+            break;
+        }
+        case simdjson::ondemand::json_type::array: {
+            simdjson::ondemand::array array;
+            if ((error = _document.get_array().get(array))) {
+                break;
+            }
+            for (auto element_result : array) {
+                simdjson::ondemand::value element;
+                if ((error = element_result.get(element)) || (error = validate_value(element))) {
+                    break;
+                }
+            }
+            break;
+        }
+        case simdjson::ondemand::json_type::string: {
+            std::string_view str;
+            error = _document.get_string().get(str);
+            break;
+        }
+        case simdjson::ondemand::json_type::number: {
+            double d = 0;
+            error = _document.get_double().get(d);
+            break;
+        }
+        case simdjson::ondemand::json_type::boolean: {
+            bool b = false;
+            error = _document.get_bool().get(b);
+            break;
+        }
+        case simdjson::ondemand::json_type::null:
+            if (!_document.is_null()) {
+                error = simdjson::N_ATOM_ERROR;
+            }
+            break;
+        }
+    }
+    // rapidjson rejects anything but white spaces after the root value
+    if (!error && !_document.at_end()) {
+        error = simdjson::TAPE_ERROR;
+    }
+    _document.rewind();
+    return error;
+}
+
+simdjson::error_code SimdJsonReader::iterate(std::string_view json) {
+    // simdjson reads a few bytes beyond the end of input, so the input is copied into a
+    // buffer with SIMDJSON_PADDING bytes after it
+    const size_t capacity = json.size() + simdjson::SIMDJSON_PADDING;
+    if (capacity > _capacity) {
+        _capacity = std::max(capacity, _capacity * 2);
+        _buffer.reset(new char[_capacity]);
+    }
+    memcpy(_buffer.get(), json.data(), json.size());
+    memset(_buffer.get() + json.size(), 0, simdjson::SIMDJSON_PADDING);
+    _size = json.size();
+    return _parser.iterate(_buffer.get(), _size, _capacity).get(_document);
+}
+
+simdjson::error_code SimdJsonReader::find(std::string_view json, const std::string& pointer,
+                                          simdjson::ondemand::value* value) {
+    auto error = iterate(json);
+    if (!error) {
+        error = validate();
+    }
+    if (error) {
+        return error;
+    }
+    return _document.at_pointer(pointer).get(*value);
+}
+
+} // namespace doris
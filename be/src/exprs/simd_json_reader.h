@@ -0,0 +1,95 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <simdjson.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "exprs/json_functions.h"
+
+namespace doris {
+
+// A number token of json. Like rapidjson, integers which fit in 64 bits are kept exactly and
+// all the others are converted to double.
+struct SimdJsonNumber {
+    enum Type { INT64, UINT64, DOUBLE };
+
+    Type type = INT64;
+    int64_t int64_value = 0;
+    uint64_t uint64_value = 0;
+    double double_value = 0;
+};
+
+// Reads json with the simdjson On Demand API, which only parses the parts of a document
+// that are visited. Extracting a few fields from a wide json record is much cheaper than
+// building a whole rapidjson::Document for it.
+//
+// The reader keeps a padded copy of the last input, so the values returned are valid until
+// the next call of iterate() or find().
+class SimdJsonReader {
+public:
+    // Compile json paths parsed by JsonFunctions into a JSON pointer, e.g. $.k1.k2[0] is
+    // compiled into /k1/k2/0. Return false if the paths can not be expressed by a JSON
+    // pointer with the same semantic as rapidjson based matching, which are invalid paths,
+    // "$" alone, [*] and keys made of digits.
+    static bool to_json_pointer(const std::vector<JsonPath>& parsed_paths, std::string* pointer);
+
+    // Parse a number token, trailing white spaces are allowed.
+    static bool parse_number(std::string_view token, SimdJsonNumber* number);
+
+    // Write value as compact json, the output is the same as rapidjson::Writer. Numbers are
+    // written as strings if number_as_string, like rapidjson::kParseNumbersAsStringsFlag.
+    static simdjson::error_code write_value(simdjson::ondemand::value value,
+                                            rapidjson::Writer<rapidjson::StringBuffer>* writer,
+                                            bool number_as_string = false);
+
+    // Start iterating json, the document is returned by document().
+    simdjson::error_code iterate(std::string_view json);
+
+    // On Demand only checks the parts of a document that are visited, so malformed json
+    // such as trailing garbage or a broken value after the visited ones is not noticed.
+    // Visit the whole document iterated last and return the error rapidjson would fail
+    // to parse it with, the document is rewound to the beginning afterwards.
+    simdjson::error_code validate();
+
+    // Parse json and find the value pointed by pointer. NO_SUCH_FIELD and
+    // INDEX_OUT_OF_BOUNDS are returned if the value does not exist, and the error of
+    // validate() if the document is malformed.
+    simdjson::error_code find(std::string_view json, const std::string& pointer,
+                              simdjson::ondemand::value* value);
+
+    simdjson::ondemand::document& document() { return _document; }
+
+    // The last input of iterate() or find().
+    std::string_view json() const { return std::string_view(_buffer.get(), _size); }
+
+private:
+    simdjson::ondemand::parser _parser;
+    simdjson::ondemand::document _document;
+    std::unique_ptr<char[]> _buffer;
+    size_t _capacity = 0;
+    size_t _size = 0;
+};
+
+} // namespace doris
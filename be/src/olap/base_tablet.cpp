@@ -28,6 +28,8 @@ namespace doris {
 extern MetricPrototype METRIC_query_scan_bytes;
 extern MetricPrototype METRIC_query_scan_rows;
 extern MetricPrototype METRIC_query_scan_count;
+extern MetricPrototype METRIC_query_scan_segments;
+extern MetricPrototype METRIC_query_merged_rows;
 
 BaseTablet::BaseTablet(TabletMetaSharedPtr tablet_meta, const StorageParamPB& storage_param,
                        DataDir* data_dir)
@@ -49,6 +51,8 @@ BaseTablet::BaseTablet(TabletMetaSharedPtr tablet_meta, const StorageParamPB& st
     INT_COUNTER_METRIC_REGISTER(_metric_entity, query_scan_bytes);
     INT_COUNTER_METRIC_REGISTER(_metric_entity, query_scan_rows);
     INT_COUNTER_METRIC_REGISTER(_metric_entity, query_scan_count);
+    INT_COUNTER_METRIC_REGISTER(_metric_entity, query_scan_segments);
+    INT_COUNTER_METRIC_REGISTER(_metric_entity, query_merged_rows);
 }
 
 BaseTablet::~BaseTablet() {
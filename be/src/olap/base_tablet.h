@@ -82,6 +82,10 @@ public:
     IntCounter* query_scan_bytes;
     IntCounter* query_scan_rows;
     IntCounter* query_scan_count;
+    // segments opened and rows merged away by queries, used to estimate the
+    // read amplification that compaction could remove.
+    IntCounter* query_scan_segments;
+    IntCounter* query_merged_rows;
 
 private:
     DISALLOW_COPY_AND_ASSIGN(BaseTablet);
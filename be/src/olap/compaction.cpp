@@ -18,8 +18,10 @@
 #include "olap/compaction.h"
 
 #include "gutil/strings/substitute.h"
+#include "olap/rowset/segment_v2/segment_writer.h"
 #include "util/time.h"
 #include "util/trace.h"
+#include "vec/olap/vertical_merge_iterator.h"
 
 using std::vector;
 
@@ -83,13 +85,23 @@ Status Compaction::do_compaction_impl(int64_t permits) {
             Version(_input_rowsets.front()->start_version(), _input_rowsets.back()->end_version());
 
     auto use_vectorized_compaction = config::enable_vectorized_compaction;
-    string merge_type = use_vectorized_compaction ? "v" : "";
+    bool ordered_compaction = should_ordered_data_compaction();
+    bool vertical_compaction = !ordered_compaction && should_vertical_compaction();
+    RETURN_NOT_OK(construct_output_rowset_writer(vertical_compaction));
+    // the output rowset may not be a beta rowset, which does not support ordered data
+    // compaction and vertical compaction
+    ordered_compaction = ordered_compaction && _output_rs_writer->type() == BETA_ROWSET;
+    vertical_compaction = vertical_compaction && _output_rs_writer->type() == BETA_ROWSET;
+    string merge_type = ordered_compaction    ? "ordered "
+                        : vertical_compaction ? "vertical "
+                                              : (use_vectorized_compaction ? "v" : "");
 
     LOG(INFO) << "start " << merge_type << compaction_name() << ". tablet=" << _tablet->full_name()
               << ", output_version=" << _output_version << ", permits: " << permits;
 
-    RETURN_NOT_OK(construct_output_rowset_writer());
-    RETURN_NOT_OK(construct_input_rowset_readers());
+    if (!ordered_compaction && !vertical_compaction) {
+        RETURN_NOT_OK(construct_input_rowset_readers());
+    }
     TRACE("prepare finished");
 
     // 2. write merged rows to output rowset
@@ -97,7 +109,14 @@ Status Compaction::do_compaction_impl(int64_t permits) {
     Merger::Statistics stats;
     Status res;
 
-    if (use_vectorized_compaction) {
+    if (ordered_compaction) {
+        res = do_compact_ordered_rowsets(&stats);
+    } else if (vertical_compaction) {
+        res = Merger::vertical_merge_rowsets(_tablet, compaction_type(), _input_rowsets,
+                                             _output_rs_writer.get(),
+                                             get_vertical_compaction_max_rows_per_segment(),
+                                             &stats);
+    } else if (use_vectorized_compaction) {
         res = Merger::vmerge_rowsets(_tablet, compaction_type(), _input_rs_readers,
                                      _output_rs_writer.get(), &stats);
     } else {
@@ -165,9 +184,112 @@ Status Compaction::do_compaction_impl(int64_t permits) {
     return Status::OK();
 }
 
-Status Compaction::construct_output_rowset_writer() {
+Status Compaction::construct_output_rowset_writer(bool is_vertical) {
     return _tablet->create_rowset_writer(_output_version, VISIBLE, NONOVERLAPPING,
-                                         &_output_rs_writer);
+                                         &_output_rs_writer, is_vertical);
+}
+
+bool Compaction::should_vertical_compaction() {
+    if (!config::enable_vertical_compaction || !config::enable_vectorized_compaction) {
+        return false;
+    }
+    // only wide tables benefit from vertical compaction
+    const auto& tablet_schema = _tablet->tablet_schema();
+    size_t num_key_group_columns =
+            tablet_schema.num_key_columns() + (tablet_schema.has_sequence_col() ? 1 : 0);
+    if (tablet_schema.num_columns() <=
+        num_key_group_columns + config::vertical_compaction_num_columns_per_group) {
+        return false;
+    }
+    int64_t num_segments = 0;
+    for (auto& rowset : _input_rowsets) {
+        if (rowset->rowset_meta()->rowset_type() != BETA_ROWSET) {
+            return false;
+        }
+        num_segments += rowset->num_segments();
+    }
+    if (num_segments > vectorized::RowSource::MAX_SOURCE_NUM) {
+        return false;
+    }
+    // delete predicates are not supported by vertical compaction yet
+    return !_has_delete_predicates_to_apply();
+}
+
+bool Compaction::_has_delete_predicates_to_apply() {
+    // delete predicates are only applied by base compaction
+    if (compaction_type() != ReaderType::READER_BASE_COMPACTION) {
+        return false;
+    }
+    for (const auto& delete_pred : _tablet->delete_predicates()) {
+        if (delete_pred.version() <= _output_version.second) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Compaction::should_ordered_data_compaction() {
+    if (!config::enable_ordered_data_compaction) {
+        return false;
+    }
+    // rows with the same keys need to be merged for other keys types
+    if (_tablet->keys_type() != KeysType::DUP_KEYS || _has_delete_predicates_to_apply()) {
+        return false;
+    }
+    const std::string* pre_max_key = nullptr;
+    for (auto& rowset : _input_rowsets) {
+        const auto& rowset_meta = rowset->rowset_meta();
+        if (rowset_meta->rowset_type() != BETA_ROWSET || rowset_meta->has_delete_predicate()) {
+            return false;
+        }
+        if (rowset_meta->num_segments() == 0) {
+            continue;
+        }
+        // rowsets written by old versions do not have key bounds
+        if (!rowset_meta->has_segments_key_bounds()) {
+            return false;
+        }
+        if (rowset_meta->data_disk_size() / rowset_meta->num_segments() <
+            config::ordered_data_compaction_min_segment_size) {
+            return false;
+        }
+        // rows with the same keys can be in different segments for DUP_KEYS
+        for (const auto& key_bounds : rowset_meta->segments_key_bounds()) {
+            if (pre_max_key != nullptr && key_bounds.min_key().compare(*pre_max_key) < 0) {
+                return false;
+            }
+            pre_max_key = &key_bounds.max_key();
+        }
+    }
+    return true;
+}
+
+Status Compaction::do_compact_ordered_rowsets(Merger::Statistics* stats) {
+    for (auto& rowset : _input_rowsets) {
+        RETURN_NOT_OK_LOG(_output_rs_writer->add_rowset(rowset),
+                          "failed to link rowset " + rowset->rowset_id().to_string() +
+                                  " when doing ordered data compaction of tablet " +
+                                  _tablet->full_name());
+    }
+    stats->output_rows = _input_row_num;
+    stats->merged_rows = 0;
+    stats->filtered_rows = 0;
+    return Status::OK();
+}
+
+uint32_t Compaction::get_vertical_compaction_max_rows_per_segment() {
+    int64_t total_size = 0;
+    int64_t total_rows = 0;
+    for (auto& rowset : _input_rowsets) {
+        total_size += rowset->data_disk_size();
+        total_rows += rowset->num_rows();
+    }
+    if (total_rows == 0 || total_size == 0) {
+        return INT32_MAX;
+    }
+    int64_t avg_row_size = std::max(total_size / total_rows, (int64_t)1);
+    return std::min(std::max((int64_t)MAX_SEGMENT_SIZE / avg_row_size, (int64_t)1),
+                    (int64_t)INT32_MAX);
 }
 
 Status Compaction::construct_input_rowset_readers() {
@@ -66,7 +66,7 @@ protected:
     Status modify_rowsets();
     void gc_output_rowset();
 
-    Status construct_output_rowset_writer();
+    Status construct_output_rowset_writer(bool is_vertical = false);
     Status construct_input_rowset_readers();
 
     Status check_version_continuity(const std::vector<RowsetSharedPtr>& rowsets);
@@ -75,7 +75,20 @@ protected:
                                             std::vector<Version>* missing_version);
     int64_t get_compaction_permits();
 
+    // whether the input rowsets can be merged by vertical compaction
+    bool should_vertical_compaction();
+    // whether the keys of input segments are in order, so that the output rowset can be
+    // built by linking the segment files of input rowsets
+    bool should_ordered_data_compaction();
+    Status do_compact_ordered_rowsets(Merger::Statistics* stats);
+    // max rows of each output segment of vertical compaction, estimated by the average
+    // row size of input rowsets
+    uint32_t get_vertical_compaction_max_rows_per_segment();
+
 private:
+    // whether there are delete predicates which should be applied by this compaction
+    bool _has_delete_predicates_to_apply();
+
     // get num rows from segment group meta of input rowsets.
     // return -1 if these are not alpha rowsets.
     int64_t _get_input_num_rows_from_seg_grps();
@@ -46,7 +46,9 @@
 #include "util/file_utils.h"
 #include "util/storage_backend.h"
 #include "util/storage_backend_mgr.h"
+#include "util/stopwatch.hpp"
 #include "util/string_util.h"
+#include "util/threadpool.h"
 
 using strings::Substitute;
 
@@ -356,6 +358,85 @@ Status DataDir::_check_incompatible_old_format_tablet() {
     return check_incompatible_old_status;
 }
 
+void DataDir::_run_in_parallel(ThreadPool* pool, int num_threads, size_t num_items,
+                               const std::function<void(size_t)>& func) {
+    // the items are taken one by one, so a thread meeting big items does not hold up the
+    // others. the calling thread takes items as well.
+    std::atomic<size_t> next_item {0};
+    auto run = [&next_item, num_items, &func]() {
+        for (size_t i = next_item++; i < num_items; i = next_item++) {
+            func(i);
+        }
+    };
+    for (int i = 0; pool != nullptr && i < num_threads - 1; ++i) {
+        if (!pool->submit_func(run).ok()) {
+            break;
+        }
+    }
+    run();
+    if (pool != nullptr) {
+        pool->wait();
+    }
+}
+
+Status DataDir::_load_tablets(ThreadPool* pool, int num_threads, std::set<int64_t>* tablet_ids,
+                             std::set<int64_t>* failed_tablet_ids) {
+    struct TabletHeader {
+        int64_t tablet_id;
+        int32_t schema_hash;
+        std::string value;
+    };
+    size_t batch_size = std::max(1, config::load_tablet_batch_size);
+    std::vector<TabletHeader> tablet_headers;
+    tablet_headers.reserve(batch_size);
+    std::mutex tablet_ids_lock;
+    auto load_tablet_headers = [&]() {
+        _run_in_parallel(pool, num_threads, tablet_headers.size(), [&](size_t i) {
+            const TabletHeader& header = tablet_headers[i];
+            Status status = _tablet_manager->load_tablet_from_meta(
+                    this, header.tablet_id, header.schema_hash, header.value, false, false,
+                    false, false);
+            std::lock_guard<std::mutex> l(tablet_ids_lock);
+            if (!status.ok() && status.precise_code() != OLAP_ERR_TABLE_ALREADY_DELETED_ERROR &&
+                status.precise_code() != OLAP_ERR_ENGINE_INSERT_OLD_TABLET) {
+                // load_tablet_from_meta() may return Status::OLAPInternalError(OLAP_ERR_TABLE_ALREADY_DELETED_ERROR)
+                // which means the tablet status is DELETED
+                // This may happen when the tablet was just deleted before the BE restarted,
+                // but it has not been cleared from rocksdb. At this time, restarting the BE
+                // will read the tablet in the DELETE state from rocksdb. These tablets have been
+                // added to the garbage collection queue and will be automatically deleted afterwards.
+                // Therefore, we believe that this situation is not a failure.
+
+                // Besides, load_tablet_from_meta() may return Status::OLAPInternalError(OLAP_ERR_ENGINE_INSERT_OLD_TABLET)
+                // when BE is restarting and the older tablet have been added to the
+                // garbage collection queue but not deleted yet.
+                // In this case, since the data_dirs are parallel loaded, a later loaded tablet
+                // may be older than previously loaded one, which should not be acknowledged as a
+                // failure.
+                LOG(WARNING) << "load tablet from header failed. status:" << status
+                             << ", tablet=" << header.tablet_id << "." << header.schema_hash;
+                failed_tablet_ids->insert(header.tablet_id);
+            } else {
+                tablet_ids->insert(header.tablet_id);
+            }
+        });
+        tablet_headers.clear();
+    };
+    // the headers are loaded a batch at a time while the meta env is traversed
+    auto load_tablet_func = [&tablet_headers, batch_size, &load_tablet_headers](
+                                    int64_t tablet_id, int32_t schema_hash,
+                                    const std::string& value) -> bool {
+        tablet_headers.push_back({tablet_id, schema_hash, value});
+        if (tablet_headers.size() >= batch_size) {
+            load_tablet_headers();
+        }
+        return true;
+    };
+    Status status = TabletMetaManager::traverse_headers(_meta, load_tablet_func);
+    load_tablet_headers();
+    return status;
+}
+
 // TODO(ygl): deal with rowsets and tablets when load failed
 Status DataDir::load() {
     LOG(INFO) << "start to load tablets from " << _path_desc.filepath;
@@ -372,21 +453,67 @@ Status DataDir::load() {
     // necessarily check incompatible old format. when there are old metas, it may load to data missing
     _check_incompatible_old_format_tablet();
 
-    std::vector<RowsetMetaSharedPtr> dir_rowset_metas;
+    MonotonicStopWatch watch;
+    watch.start();
+    int64_t last_elapsed_ns = 0;
+    std::stringstream phase_costs;
+    auto record_phase = [&watch, &last_elapsed_ns, &phase_costs](const char* phase) {
+        int64_t elapsed_ns = watch.elapsed_time();
+        phase_costs << phase << ": " << (elapsed_ns - last_elapsed_ns) / 1000 / 1000 << "ms, ";
+        last_elapsed_ns = elapsed_ns;
+    };
+
+    // the metas are read from the meta env by one thread, and parsed and loaded by
+    // load_tablet_thread_num_per_store threads
+    int num_threads = std::max(1, config::load_tablet_thread_num_per_store);
+    std::unique_ptr<ThreadPool> load_pool;
+    if (num_threads > 1) {
+        Status st = ThreadPoolBuilder("LoadTabletThreadPool")
+                            .set_min_threads(num_threads - 1)
+                            .set_max_threads(num_threads - 1)
+                            .build(&load_pool);
+        if (!st.ok()) {
+            // the calling thread loads everything by itself then
+            LOG(WARNING) << "failed to build thread pool to load tablets, load them with one "
+                         << "thread. path: " << _path_desc.filepath << ", status: " << st;
+            load_pool.reset();
+            num_threads = 1;
+        }
+    }
+
+    std::vector<std::pair<RowsetId, std::string>> rowset_meta_strs;
     LOG(INFO) << "begin loading rowset from meta";
-    auto load_rowset_func = [&dir_rowset_metas](TabletUid tablet_uid, RowsetId rowset_id,
+    auto load_rowset_func = [&rowset_meta_strs](TabletUid tablet_uid, RowsetId rowset_id,
                                                 const std::string& meta_str) -> bool {
-        RowsetMetaSharedPtr rowset_meta(new AlphaRowsetMeta());
-        bool parsed = rowset_meta->init(meta_str);
-        if (!parsed) {
-            LOG(WARNING) << "parse rowset meta string failed for rowset_id:" << rowset_id;
-            // return false will break meta iterator, return true to skip this error
-            return true;
-        }
-        dir_rowset_metas.push_back(rowset_meta);
+        rowset_meta_strs.emplace_back(rowset_id, meta_str);
         return true;
     };
     Status load_rowset_status = RowsetMetaManager::traverse_rowset_metas(_meta, load_rowset_func);
+    record_phase("read rowset metas");
+
+    std::vector<RowsetMetaSharedPtr> parsed_rowset_metas(rowset_meta_strs.size());
+    _run_in_parallel(load_pool.get(), num_threads, rowset_meta_strs.size(), [&](size_t i) {
+        RowsetMetaSharedPtr rowset_meta(new AlphaRowsetMeta());
+        bool parsed = rowset_meta->init(rowset_meta_strs[i].second);
+        if (!parsed) {
+            LOG(WARNING) << "parse rowset meta string failed for rowset_id:"
+                         << rowset_meta_strs[i].first;
+            // skip this error
+            return;
+        }
+        parsed_rowset_metas[i] = std::move(rowset_meta);
+    });
+    rowset_meta_strs.clear();
+    rowset_meta_strs.shrink_to_fit();
+    std::vector<RowsetMetaSharedPtr> dir_rowset_metas;
+    dir_rowset_metas.reserve(parsed_rowset_metas.size());
+    for (auto& rowset_meta : parsed_rowset_metas) {
+        if (rowset_meta != nullptr) {
+            dir_rowset_metas.push_back(std::move(rowset_meta));
+        }
+    }
+    parsed_rowset_metas.clear();
+    record_phase("parse rowset metas");
 
     if (!load_rowset_status) {
         LOG(WARNING) << "errors when load rowset meta from meta env, skip this data dir:"
@@ -400,36 +527,8 @@ Status DataDir::load() {
     LOG(INFO) << "begin loading tablet from meta";
     std::set<int64_t> tablet_ids;
     std::set<int64_t> failed_tablet_ids;
-    auto load_tablet_func = [this, &tablet_ids, &failed_tablet_ids](
-                                    int64_t tablet_id, int32_t schema_hash,
-                                    const std::string& value) -> bool {
-        Status status = _tablet_manager->load_tablet_from_meta(this, tablet_id, schema_hash, value,
-                                                               false, false, false, false);
-        if (!status.ok() && status.precise_code() != OLAP_ERR_TABLE_ALREADY_DELETED_ERROR &&
-            status.precise_code() != OLAP_ERR_ENGINE_INSERT_OLD_TABLET) {
-            // load_tablet_from_meta() may return Status::OLAPInternalError(OLAP_ERR_TABLE_ALREADY_DELETED_ERROR)
-            // which means the tablet status is DELETED
-            // This may happen when the tablet was just deleted before the BE restarted,
-            // but it has not been cleared from rocksdb. At this time, restarting the BE
-            // will read the tablet in the DELETE state from rocksdb. These tablets have been
-            // added to the garbage collection queue and will be automatically deleted afterwards.
-            // Therefore, we believe that this situation is not a failure.
-
-            // Besides, load_tablet_from_meta() may return Status::OLAPInternalError(OLAP_ERR_ENGINE_INSERT_OLD_TABLET)
-            // when BE is restarting and the older tablet have been added to the
-            // garbage collection queue but not deleted yet.
-            // In this case, since the data_dirs are parallel loaded, a later loaded tablet
-            // may be older than previously loaded one, which should not be acknowledged as a
-            // failure.
-            LOG(WARNING) << "load tablet from header failed. status:" << status
-                         << ", tablet=" << tablet_id << "." << schema_hash;
-            failed_tablet_ids.insert(tablet_id);
-        } else {
-            tablet_ids.insert(tablet_id);
-        }
-        return true;
-    };
-    Status load_tablet_status = TabletMetaManager::traverse_headers(_meta, load_tablet_func);
+    Status load_tablet_status =
+            _load_tablets(load_pool.get(), num_threads, &tablet_ids, &failed_tablet_ids);
     if (failed_tablet_ids.size() != 0) {
         LOG(WARNING) << "load tablets from header failed"
                      << ", loaded tablet: " << tablet_ids.size()
@@ -451,13 +550,14 @@ Status DataDir::load() {
                   << ", error tablet: " << failed_tablet_ids.size()
                   << ", path: " << _path_desc.filepath;
     }
-
+    record_phase("load tablets");
     // traverse rowset
     // 1. add committed rowset to txn map
     // 2. add visible rowset to tablet
     // ignore any errors when load tablet or rowset, because fe will repair them after report
-    int64_t invalid_rowset_counter = 0;
-    for (auto rowset_meta : dir_rowset_metas) {
+    std::atomic<int64_t> invalid_rowset_counter {0};
+    _run_in_parallel(load_pool.get(), num_threads, dir_rowset_metas.size(), [&](size_t i) {
+        const RowsetMetaSharedPtr& rowset_meta = dir_rowset_metas[i];
         TabletSharedPtr tablet = _tablet_manager->get_tablet(rowset_meta->tablet_id());
         // tablet maybe dropped, but not drop related rowset meta
         if (tablet == nullptr) {
@@ -465,7 +565,7 @@ Status DataDir::load() {
                         << ", schema hash: " << rowset_meta->tablet_schema_hash()
                         << ", for rowset: " << rowset_meta->rowset_id() << ", skip this rowset";
             ++invalid_rowset_counter;
-            continue;
+            return;
         }
         RowsetSharedPtr rowset;
         Status create_status = tablet->create_rowset(rowset_meta, &rowset);
@@ -474,7 +574,7 @@ Status DataDir::load() {
                          << " rowset_id: " << rowset_meta->rowset_id()
                          << " rowset_type: " << rowset_meta->rowset_type()
                          << " rowset_state: " << rowset_meta->rowset_state();
-            continue;
+            return;
         }
         if (rowset_meta->rowset_state() == RowsetStatePB::COMMITTED &&
             rowset_meta->tablet_uid() == tablet->tablet_uid()) {
@@ -514,13 +614,16 @@ Status DataDir::load() {
                          << " current valid tablet uid: " << tablet->tablet_uid();
             ++invalid_rowset_counter;
         }
-    }
+    });
+    record_phase("add rowsets");
     // At startup, we only count these invalid rowset, but do not actually delete it.
     // The actual delete operation is in StorageEngine::_clean_unused_rowset_metas,
     // which is cleaned up uniformly by the background cleanup thread.
     LOG(INFO) << "finish to load tablets from " << _path_desc.filepath
               << ", total rowset meta: " << dir_rowset_metas.size()
-              << ", invalid rowset num: " << invalid_rowset_counter;
+              << ", invalid rowset num: " << invalid_rowset_counter.load()
+              << ", threads: " << num_threads << ", cost: " << phase_costs.str()
+              << "total: " << watch.elapsed_time() / 1000 / 1000 << "ms";
 
     return Status::OK();
 }
@@ -19,6 +19,7 @@
 
 #include <condition_variable>
 #include <cstdint>
+#include <functional>
 #include <mutex>
 #include <set>
 #include <shared_mutex>
@@ -38,6 +39,7 @@ class Tablet;
 class TabletManager;
 class TabletMeta;
 class TxnManager;
+class ThreadPool;
 
 // A DataDir used to manage data in same path.
 // Now, After DataDir was created, it will never be deleted for easy implementation.
@@ -159,6 +161,17 @@ private:
 
     bool _check_pending_ids(const std::string& id);
 
+    // call func for every item in [0, num_items) with num_threads threads, which are the
+    // calling thread and num_threads - 1 threads of pool. Returns when all items are done.
+    static void _run_in_parallel(ThreadPool* pool, int num_threads, size_t num_items,
+                                 const std::function<void(size_t)>& func);
+
+    // load the tablets of the tablet metas in the meta env to the tablet manager with num_threads
+    // threads. the metas are read config::load_tablet_batch_size at a time and each batch is
+    // loaded before the next one is read. Returns the status of reading the metas.
+    Status _load_tablets(ThreadPool* pool, int num_threads, std::set<int64_t>* tablet_ids,
+                         std::set<int64_t>* failed_tablet_ids);
+
 private:
     bool _stop_bg_worker = false;
 
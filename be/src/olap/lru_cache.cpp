@@ -165,10 +165,12 @@ void HandleTable::_resize() {
     _length = new_length;
 }
 
-LRUCache::LRUCache(LRUCacheType type) : _type(type) {
+LRUCache::LRUCache(LRUCacheType type, CacheEvictionPolicy policy) : _type(type), _policy(policy) {
     // Make empty circular linked list
     _lru_normal.next = &_lru_normal;
     _lru_normal.prev = &_lru_normal;
+    _lru_protected.next = &_lru_protected;
+    _lru_protected.prev = &_lru_protected;
     _lru_durable.next = &_lru_durable;
     _lru_durable.prev = &_lru_durable;
 }
@@ -178,9 +180,9 @@ LRUCache::~LRUCache() {
 }
 
 bool LRUCache::_unref(LRUHandle* e) {
-    DCHECK(e->refs > 0);
-    e->refs--;
-    return e->refs == 0;
+    uint32_t old_refs = e->refs.fetch_sub(1, std::memory_order_acq_rel);
+    DCHECK(old_refs > 0);
+    return old_refs == 1;
 }
 
 void LRUCache::_lru_remove(LRUHandle* e) {
@@ -198,8 +200,11 @@ void LRUCache::_lru_append(LRUHandle* list, LRUHandle* e) {
 }
 
 Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
-    std::lock_guard<std::mutex> l(_mutex);
-    ++_lookup_count;
+    if (_policy == CacheEvictionPolicy::TWO_QUEUE) {
+        return _lookup_two_queue(key, hash);
+    }
+    std::lock_guard<std::shared_mutex> l(_mutex);
+    _lookup_count.fetch_add(1, std::memory_order_relaxed);
     LRUHandle* e = _table.lookup(key, hash);
     if (e != nullptr) {
         // we get it from _table, so in_cache must be true
@@ -209,7 +214,30 @@ Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
             _lru_remove(e);
         }
         e->refs++;
-        ++_hit_count;
+        _hit_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    return reinterpret_cast<Cache::Handle*>(e);
+}
+
+Cache::Handle* LRUCache::_lookup_two_queue(const CacheKey& key, uint32_t hash) {
+    LRUHandle* e = nullptr;
+    {
+        // The entry stays in its queue while being referenced, so lookups only read
+        // the hash table and can run concurrently.
+        std::shared_lock<std::shared_mutex> l(_mutex);
+        e = _table.lookup(key, hash);
+        if (e != nullptr) {
+            DCHECK(e->in_cache);
+            e->refs.fetch_add(1, std::memory_order_relaxed);
+            // avoid writing the shared cache line again for hot entries
+            if (!e->visited.load(std::memory_order_relaxed)) {
+                e->visited.store(true, std::memory_order_relaxed);
+            }
+        }
+    }
+    _lookup_count.fetch_add(1, std::memory_order_relaxed);
+    if (e != nullptr) {
+        _hit_count.fetch_add(1, std::memory_order_relaxed);
     }
     return reinterpret_cast<Cache::Handle*>(e);
 }
@@ -219,9 +247,13 @@ void LRUCache::release(Cache::Handle* handle) {
         return;
     }
     LRUHandle* e = reinterpret_cast<LRUHandle*>(handle);
+    if (_policy == CacheEvictionPolicy::TWO_QUEUE) {
+        _release_two_queue(e);
+        return;
+    }
     bool last_ref = false;
     {
-        std::lock_guard<std::mutex> l(_mutex);
+        std::lock_guard<std::shared_mutex> l(_mutex);
         last_ref = _unref(e);
         if (last_ref) {
             _usage -= e->total_size;
@@ -271,10 +303,104 @@ void LRUCache::_evict_from_lru(size_t total_size, LRUHandle** to_remove_head) {
     }
 }
 
+void LRUCache::_release_two_queue(LRUHandle* e) {
+    uint32_t old_refs = e->refs.fetch_sub(1, std::memory_order_acq_rel);
+    if (old_refs == 1) {
+        // the entry has been removed from cache, and it was the last reference
+        DCHECK(!e->in_cache);
+        e->free();
+        return;
+    }
+    if (old_refs == 2 && _usage.load(std::memory_order_relaxed) > _capacity) {
+        // take this opportunity to shrink the cache, the entry is only referenced
+        // by cache now and may be evicted
+        LRUHandle* to_remove_head = nullptr;
+        {
+            std::lock_guard<std::shared_mutex> l(_mutex);
+            _evict_from_two_queue(0, &to_remove_head);
+        }
+        while (to_remove_head != nullptr) {
+            LRUHandle* next = to_remove_head->next;
+            to_remove_head->free();
+            to_remove_head = next;
+        }
+    }
+}
+
+void LRUCache::_evict_from_two_queue(size_t total_size, LRUHandle** to_remove_head) {
+    // 1. evict probation entries which have not been hit since inserted,
+    // the ones which have been hit are promoted to the protected queue.
+    LRUHandle* e = _lru_normal.next;
+    while (_usage + total_size > _capacity && e != &_lru_normal) {
+        LRUHandle* next = e->next;
+        if (e->visited.load(std::memory_order_relaxed)) {
+            _promote(e);
+        } else if (e->refs.load(std::memory_order_acquire) == 1) {
+            _evict_one_entry(e);
+            e->next = *to_remove_head;
+            *to_remove_head = e;
+        }
+        e = next;
+    }
+    // 2. evict protected entries if need
+    _evict_with_second_chance(&_lru_protected, total_size, to_remove_head);
+    // 3. evict durable cache entries if need
+    _evict_with_second_chance(&_lru_durable, total_size, to_remove_head);
+}
+
+// Evict entries from the oldest end of list, and entries hit since last examined are
+// moved to the newest end instead, which approximates LRU without reordering the list
+// on lookup.
+void LRUCache::_evict_with_second_chance(LRUHandle* list, size_t total_size,
+                                         LRUHandle** to_remove_head) {
+    LRUHandle* e = list->next;
+    while (_usage + total_size > _capacity && e != list) {
+        LRUHandle* next = e->next;
+        if (e->visited.load(std::memory_order_relaxed)) {
+            e->visited.store(false, std::memory_order_relaxed);
+            if (next != list) {
+                _lru_remove(e);
+                _lru_append(list, e);
+            } else {
+                // e is the newest one, examine it again
+                next = e;
+            }
+        } else if (e->refs.load(std::memory_order_acquire) == 1) {
+            _evict_one_entry(e);
+            e->next = *to_remove_head;
+            *to_remove_head = e;
+        }
+        e = next;
+    }
+}
+
+void LRUCache::_promote(LRUHandle* e) {
+    DCHECK(!e->in_protected);
+    e->visited.store(false, std::memory_order_relaxed);
+    _lru_remove(e);
+    _lru_append(&_lru_protected, e);
+    e->in_protected = true;
+    _protected_usage += e->total_size;
+    // demote the oldest protected entries to the newest end of probation queue,
+    // they have to be hit again to get back.
+    while (_protected_usage > _protected_capacity) {
+        LRUHandle* old = _lru_protected.next;
+        old->visited.store(false, std::memory_order_relaxed);
+        old->in_protected = false;
+        _protected_usage -= old->total_size;
+        _lru_remove(old);
+        _lru_append(&_lru_normal, old);
+    }
+}
+
 void LRUCache::_evict_one_entry(LRUHandle* e) {
     DCHECK(e->in_cache);
     DCHECK(e->refs == 1); // LRU list contains elements which may be evicted
     _lru_remove(e);
+    if (e->in_protected) {
+        e->in_protected = false;
+        _protected_usage -= e->total_size;
+    }
     bool removed = _table.remove(e);
     DCHECK(removed);
     e->in_cache = false;
@@ -296,6 +422,8 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
     e->refs = 2; // one for the returned handle, one for LRUCache.
     e->next = e->prev = nullptr;
     e->in_cache = true;
+    e->visited = false;
+    e->in_protected = false;
     e->priority = priority;
     e->mem_tracker = tracker;
     memcpy(e->key_data, key.data(), key.size());
@@ -305,18 +433,38 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
         tls_ctx()->_thread_mem_tracker_mgr->mem_tracker()->transfer_to(tracker, e->total_size);
     LRUHandle* to_remove_head = nullptr;
     {
-        std::lock_guard<std::mutex> l(_mutex);
-
-        // Free the space following strict LRU policy until enough space
-        // is freed or the lru list is empty
-        _evict_from_lru(e->total_size, &to_remove_head);
+        std::lock_guard<std::shared_mutex> l(_mutex);
+
+        if (_policy == CacheEvictionPolicy::TWO_QUEUE) {
+            _evict_from_two_queue(e->total_size, &to_remove_head);
+        } else {
+            // Free the space following strict LRU policy until enough space
+            // is freed or the lru list is empty
+            _evict_from_lru(e->total_size, &to_remove_head);
+        }
 
         // insert into the cache
         // note that the cache might get larger than its capacity if not enough
         // space was freed
         auto old = _table.insert(e);
         _usage += e->total_size;
-        if (old != nullptr) {
+        if (_policy == CacheEvictionPolicy::TWO_QUEUE) {
+            _lru_append(priority == CachePriority::NORMAL ? &_lru_normal : &_lru_durable, e);
+            if (old != nullptr) {
+                // old stays in its queue until it is removed from cache
+                old->in_cache = false;
+                _lru_remove(old);
+                if (old->in_protected) {
+                    old->in_protected = false;
+                    _protected_usage -= old->total_size;
+                }
+                _usage -= old->total_size;
+                if (_unref(old)) {
+                    old->next = to_remove_head;
+                    to_remove_head = old;
+                }
+            }
+        } else if (old != nullptr) {
             old->in_cache = false;
             if (_unref(old)) {
                 _usage -= old->total_size;
@@ -344,9 +492,18 @@ void LRUCache::erase(const CacheKey& key, uint32_t hash) {
     LRUHandle* e = nullptr;
     bool last_ref = false;
     {
-        std::lock_guard<std::mutex> l(_mutex);
+        std::lock_guard<std::shared_mutex> l(_mutex);
         e = _table.remove(key, hash);
-        if (e != nullptr) {
+        if (e != nullptr && _policy == CacheEvictionPolicy::TWO_QUEUE) {
+            _lru_remove(e);
+            if (e->in_protected) {
+                e->in_protected = false;
+                _protected_usage -= e->total_size;
+            }
+            _usage -= e->total_size;
+            e->in_cache = false;
+            last_ref = _unref(e);
+        } else if (e != nullptr) {
             last_ref = _unref(e);
             if (last_ref) {
                 _usage -= e->total_size;
@@ -365,56 +522,25 @@ void LRUCache::erase(const CacheKey& key, uint32_t hash) {
 }
 
 int64_t LRUCache::prune() {
-    LRUHandle* to_remove_head = nullptr;
-    {
-        std::lock_guard<std::mutex> l(_mutex);
-        while (_lru_normal.next != &_lru_normal) {
-            LRUHandle* old = _lru_normal.next;
-            _evict_one_entry(old);
-            old->next = to_remove_head;
-            to_remove_head = old;
-        }
-        while (_lru_durable.next != &_lru_durable) {
-            LRUHandle* old = _lru_durable.next;
-            _evict_one_entry(old);
-            old->next = to_remove_head;
-            to_remove_head = old;
-        }
-    }
-    int64_t pruned_count = 0;
-    while (to_remove_head != nullptr) {
-        ++pruned_count;
-        LRUHandle* next = to_remove_head->next;
-        to_remove_head->free();
-        to_remove_head = next;
-    }
-    return pruned_count;
+    return prune_if([](const void*) { return true; });
 }
 
 int64_t LRUCache::prune_if(CacheValuePredicate pred) {
     LRUHandle* to_remove_head = nullptr;
     {
-        std::lock_guard<std::mutex> l(_mutex);
-        LRUHandle* p = _lru_normal.next;
-        while (p != &_lru_normal) {
-            LRUHandle* next = p->next;
-            if (pred(p->value)) {
-                _evict_one_entry(p);
-                p->next = to_remove_head;
-                to_remove_head = p;
-            }
-            p = next;
-        }
-
-        p = _lru_durable.next;
-        while (p != &_lru_durable) {
-            LRUHandle* next = p->next;
-            if (pred(p->value)) {
-                _evict_one_entry(p);
-                p->next = to_remove_head;
-                to_remove_head = p;
+        std::lock_guard<std::shared_mutex> l(_mutex);
+        for (LRUHandle* list : {&_lru_normal, &_lru_protected, &_lru_durable}) {
+            LRUHandle* p = list->next;
+            while (p != list) {
+                LRUHandle* next = p->next;
+                // entries of TWO_QUEUE policy are kept in list while being referenced
+                if (p->refs == 1 && pred(p->value)) {
+                    _evict_one_entry(p);
+                    p->next = to_remove_head;
+                    to_remove_head = p;
+                }
+                p = next;
             }
-            p = next;
         }
     }
     int64_t pruned_count = 0;
@@ -432,7 +558,7 @@ inline uint32_t ShardedLRUCache::_hash_slice(const CacheKey& s) {
 }
 
 ShardedLRUCache::ShardedLRUCache(const std::string& name, size_t total_capacity, LRUCacheType type,
-                                 uint32_t num_shards)
+                                 uint32_t num_shards, CacheEvictionPolicy policy)
         : _name(name),
           _num_shard_bits(Bits::FindLSBSetNonZero(num_shards)),
           _num_shards(num_shards),
@@ -446,7 +572,7 @@ ShardedLRUCache::ShardedLRUCache(const std::string& name, size_t total_capacity,
     const size_t per_shard = (total_capacity + (_num_shards - 1)) / _num_shards;
     LRUCache** shards = new (std::nothrow) LRUCache*[_num_shards];
     for (int s = 0; s < _num_shards; s++) {
-        shards[s] = new LRUCache(type);
+        shards[s] = new LRUCache(type, policy);
         shards[s]->set_capacity(per_shard);
     }
     _shards = shards;
@@ -547,8 +673,8 @@ void ShardedLRUCache::update_cache_metrics() const {
 }
 
 Cache* new_lru_cache(const std::string& name, size_t capacity, LRUCacheType type,
-                     uint32_t num_shards) {
-    return new ShardedLRUCache(name, capacity, type, num_shards);
+                     uint32_t num_shards, CacheEvictionPolicy policy) {
+    return new ShardedLRUCache(name, capacity, type, num_shards, policy);
 }
 
 } // namespace doris
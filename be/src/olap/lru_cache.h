@@ -9,7 +9,9 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <atomic>
 #include <functional>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 
@@ -53,10 +55,22 @@ enum LRUCacheType {
     NUMBER // The capacity of cache is based on the number of cache entry.
 };
 
+enum class CacheEvictionPolicy {
+    // Strict LRU, every hit moves the entry to the newest end of lru list.
+    LRU = 0,
+    // Scan resistant 2Q. New entries are put into a probation queue and only the ones
+    // hit again are promoted to a protected queue, so a large scan which touches every
+    // entry once can only wash out the probation queue. Lookups run under a shared lock
+    // and never reorder the queues, the hit is recorded in the entry and taken into
+    // account lazily when evicting.
+    TWO_QUEUE = 1
+};
+
 // Create a new cache with a specified name and capacity.
-// This implementation of Cache uses a least-recently-used eviction policy.
+// This implementation of Cache uses a least-recently-used eviction policy by default.
 extern Cache* new_lru_cache(const std::string& name, size_t capacity,
-                            LRUCacheType type = LRUCacheType::SIZE, uint32_t num_shards = 16);
+                            LRUCacheType type = LRUCacheType::SIZE, uint32_t num_shards = 16,
+                            CacheEvictionPolicy policy = CacheEvictionPolicy::LRU);
 
 class CacheKey {
 public:
@@ -233,7 +247,11 @@ typedef struct LRUHandle {
     size_t key_length;
     size_t total_size; // including key length
     bool in_cache;     // Whether entry is in the cache.
-    uint32_t refs;
+    // Whether entry was hit since it was inserted or examined by eviction last time,
+    // only used by CacheEvictionPolicy::TWO_QUEUE.
+    std::atomic<bool> visited;
+    bool in_protected; // Whether entry is in the protected queue of TWO_QUEUE policy.
+    std::atomic<uint32_t> refs;
     uint32_t hash; // Hash of key(); used for fast sharding and comparisons
     CachePriority priority = CachePriority::NORMAL;
     MemTracker* mem_tracker;
@@ -303,11 +321,14 @@ private:
 // A single shard of sharded cache.
 class LRUCache {
 public:
-    LRUCache(LRUCacheType type);
+    LRUCache(LRUCacheType type, CacheEvictionPolicy policy = CacheEvictionPolicy::LRU);
     ~LRUCache();
 
     // Separate from constructor so caller can easily make an array of LRUCache
-    void set_capacity(size_t capacity) { _capacity = capacity; }
+    void set_capacity(size_t capacity) {
+        _capacity = capacity;
+        _protected_capacity = capacity * kProtectedPercentage / 100;
+    }
 
     // Like Cache methods, but with an extra "hash" parameter.
     Cache::Handle* insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
@@ -320,45 +341,67 @@ public:
     int64_t prune();
     int64_t prune_if(CacheValuePredicate pred);
 
-    uint64_t get_lookup_count() const { return _lookup_count; }
-    uint64_t get_hit_count() const { return _hit_count; }
-    size_t get_usage() const { return _usage; }
+    uint64_t get_lookup_count() const { return _lookup_count.load(std::memory_order_relaxed); }
+    uint64_t get_hit_count() const { return _hit_count.load(std::memory_order_relaxed); }
+    size_t get_usage() const { return _usage.load(std::memory_order_relaxed); }
     size_t get_capacity() const { return _capacity; }
+    size_t get_protected_usage() const { return _protected_usage; }
 
 private:
+    // Percentage of capacity that protected queue of TWO_QUEUE policy can use.
+    static constexpr size_t kProtectedPercentage = 80;
+
     void _lru_remove(LRUHandle* e);
     void _lru_append(LRUHandle* list, LRUHandle* e);
     bool _unref(LRUHandle* e);
     void _evict_from_lru(size_t total_size, LRUHandle** to_remove_head);
     void _evict_one_entry(LRUHandle* e);
 
+    Cache::Handle* _lookup_two_queue(const CacheKey& key, uint32_t hash);
+    void _release_two_queue(LRUHandle* e);
+    void _evict_from_two_queue(size_t total_size, LRUHandle** to_remove_head);
+    void _evict_with_second_chance(LRUHandle* list, size_t total_size,
+                                   LRUHandle** to_remove_head);
+    void _promote(LRUHandle* e);
+
 private:
     LRUCacheType _type;
+    CacheEvictionPolicy _policy;
 
     // Initialized before use.
     size_t _capacity = 0;
+    size_t _protected_capacity = 0;
 
-    // _mutex protects the following state.
-    std::mutex _mutex;
-    size_t _usage = 0;
+    // _mutex protects the following state. Lookups of TWO_QUEUE policy only hold
+    // it in shared mode, everything else holds it exclusively.
+    std::shared_mutex _mutex;
+    // Only modified under _mutex, atomic so that releases of TWO_QUEUE policy and
+    // get_usage() can check it without taking the lock.
+    std::atomic<size_t> _usage {0};
+    size_t _protected_usage = 0;
 
     // Dummy head of LRU list.
-    // Entries have refs==1 and in_cache==true.
+    // Entries have refs==1 and in_cache==true. With TWO_QUEUE policy, entries stay
+    // in the lists as long as in_cache==true, no matter how many refs they have.
     // _lru_normal.prev is newest entry, _lru_normal.next is oldest entry.
+    // _lru_normal is used as the probation queue of TWO_QUEUE policy.
     LRUHandle _lru_normal;
+    // Protected queue of TWO_QUEUE policy, always empty with LRU policy.
+    LRUHandle _lru_protected;
     // _lru_durable.prev is newest entry, _lru_durable.next is oldest entry.
     LRUHandle _lru_durable;
 
     HandleTable _table;
 
-    uint64_t _lookup_count = 0; // cache查找总次数
-    uint64_t _hit_count = 0;    // 命中cache的总次数
+    std::atomic<uint64_t> _lookup_count {0}; // cache查找总次数
+    std::atomic<uint64_t> _hit_count {0};    // 命中cache的总次数
 };
 
 class ShardedLRUCache : public Cache {
 public:
     explicit ShardedLRUCache(const std::string& name, size_t total_capacity, LRUCacheType type,
-                             uint32_t num_shards);
+                             uint32_t num_shards,
+                             CacheEvictionPolicy policy = CacheEvictionPolicy::LRU);
     // TODO(fdy): 析构时清除所有cache元素
     virtual ~ShardedLRUCache();
     virtual Handle* insert(const CacheKey& key, void* value, size_t charge,
@@ -20,12 +20,16 @@
 #include <memory>
 #include <vector>
 
+#include "common/config.h"
 #include "olap/olap_define.h"
 #include "olap/row_cursor.h"
+#include "olap/rowset/beta_rowset.h"
+#include "olap/segment_loader.h"
 #include "olap/tablet.h"
 #include "olap/tuple_reader.h"
 #include "util/trace.h"
 #include "vec/olap/block_reader.h"
+#include "vec/olap/vertical_merge_iterator.h"
 
 namespace doris {
 
@@ -133,4 +137,158 @@ Status Merger::vmerge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
     return Status::OK();
 }
 
+void Merger::vertical_split_columns(const TabletSchema& tablet_schema,
+                                    std::vector<std::vector<uint32_t>>* column_groups) {
+    uint32_t num_key_cols = tablet_schema.num_key_columns();
+    uint32_t total_cols = tablet_schema.num_columns();
+    std::vector<uint32_t> key_columns;
+    for (uint32_t i = 0; i < num_key_cols; ++i) {
+        key_columns.push_back(i);
+    }
+    // sequence column is needed to decide which row is kept when merging keys
+    int32_t sequence_col_idx = tablet_schema.sequence_col_idx();
+    if (sequence_col_idx != -1) {
+        key_columns.push_back(sequence_col_idx);
+    }
+    column_groups->push_back(std::move(key_columns));
+
+    size_t num_columns_per_group = std::max(config::vertical_compaction_num_columns_per_group, 1);
+    std::vector<uint32_t> value_columns;
+    for (uint32_t i = num_key_cols; i < total_cols; ++i) {
+        if ((int32_t)i == sequence_col_idx) {
+            continue;
+        }
+        value_columns.push_back(i);
+        if (value_columns.size() == num_columns_per_group) {
+            column_groups->push_back(std::move(value_columns));
+            value_columns.clear();
+        }
+    }
+    if (!value_columns.empty()) {
+        column_groups->push_back(std::move(value_columns));
+    }
+}
+
+// create iterators of all segments of `src_rowsets` for columns in `column_ids`
+static Status create_segment_iterators(
+        std::vector<SegmentCacheHandle>& segment_cache_handles, const Schema& schema,
+        const StorageReadOptions& read_options,
+        std::vector<std::unique_ptr<RowwiseIterator>>* iterators) {
+    for (auto& handle : segment_cache_handles) {
+        for (auto& seg_ptr : handle.get_segments()) {
+            std::unique_ptr<RowwiseIterator> iter;
+            auto s = seg_ptr->new_iterator(schema, read_options, &iter);
+            if (!s.ok()) {
+                LOG(WARNING) << "failed to create iterator[" << seg_ptr->id()
+                             << "]: " << s.to_string();
+                return Status::OLAPInternalError(OLAP_ERR_ROWSET_READER_INIT);
+            }
+            iterators->push_back(std::move(iter));
+        }
+    }
+    return Status::OK();
+}
+
+Status Merger::vertical_merge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
+                                      const std::vector<RowsetSharedPtr>& src_rowsets,
+                                      RowsetWriter* dst_rowset_writer,
+                                      uint32_t max_rows_per_segment,
+                                      Merger::Statistics* stats_output) {
+    TRACE_COUNTER_SCOPE_LATENCY_US("vertical_merge_rowsets_latency_us");
+
+    const auto& tablet_schema = tablet->tablet_schema();
+    std::vector<std::vector<uint32_t>> column_groups;
+    vertical_split_columns(tablet_schema, &column_groups);
+
+    // load segments of all input rowsets, segments are kept until merge finished
+    std::vector<SegmentCacheHandle> segment_cache_handles(src_rowsets.size());
+    size_t num_segments = 0;
+    for (size_t i = 0; i < src_rowsets.size(); ++i) {
+        auto beta_rowset = std::static_pointer_cast<BetaRowset>(src_rowsets[i]);
+        RETURN_NOT_OK(beta_rowset->load());
+        RETURN_NOT_OK(SegmentLoader::instance()->load_segments(beta_rowset,
+                                                               &segment_cache_handles[i]));
+        num_segments += segment_cache_handles[i].get_segments().size();
+    }
+    if (num_segments > vectorized::RowSource::MAX_SOURCE_NUM) {
+        LOG(WARNING) << "too many segments for vertical merge, tablet=" << tablet->full_name()
+                     << ", num_segments=" << num_segments;
+        return Status::OLAPInternalError(OLAP_ERR_INPUT_PARAMETER_ERROR);
+    }
+
+    OlapReaderStatistics stats;
+    StorageReadOptions read_options;
+    read_options.stats = &stats;
+
+    vectorized::RowSourcesBuffer row_sources_buf(tablet->tablet_id(),
+                                                 tablet->tablet_path_desc().filepath,
+                                                 dst_rowset_writer->rowset_id().to_string());
+    size_t output_rows = 0;
+    int64_t merged_rows = 0;
+    for (size_t i = 0; i < column_groups.size(); ++i) {
+        const auto& column_ids = column_groups[i];
+        bool is_key = (i == 0);
+        Schema schema(tablet_schema.columns(), column_ids);
+        std::vector<std::unique_ptr<RowwiseIterator>> iterators;
+        RETURN_NOT_OK(create_segment_iterators(segment_cache_handles, schema, read_options,
+                                               &iterators));
+
+        std::unique_ptr<RowwiseIterator> merge_iter;
+        vectorized::VerticalHeapMergeIterator* key_merge_iter = nullptr;
+        if (is_key) {
+            int seq_col_idx = tablet_schema.has_sequence_col() ? tablet_schema.num_key_columns()
+                                                               : -1;
+            key_merge_iter = new vectorized::VerticalHeapMergeIterator(
+                    std::move(iterators), tablet_schema, column_ids,
+                    tablet_schema.num_key_columns(), seq_col_idx, &row_sources_buf);
+            merge_iter.reset(key_merge_iter);
+        } else {
+            RETURN_NOT_OK(row_sources_buf.flush());
+            RETURN_NOT_OK(row_sources_buf.seek_to_begin());
+            merge_iter.reset(new vectorized::VerticalMaskMergeIterator(
+                    std::move(iterators), tablet_schema, column_ids, &row_sources_buf));
+        }
+        RETURN_NOT_OK_LOG(merge_iter->init(read_options),
+                          "failed to init vertical merge iterator of tablet " +
+                                  tablet->full_name());
+
+        vectorized::Block block = tablet_schema.create_block(column_ids);
+        bool eof = false;
+        while (!eof) {
+            auto st = merge_iter->next_batch(&block);
+            if (st.is_end_of_file()) {
+                eof = true;
+            } else if (!st.ok()) {
+                LOG(WARNING) << "failed to read next block when vertical merging rowsets of tablet "
+                             << tablet->full_name() << ", err=" << st.to_string();
+                return st;
+            }
+            RETURN_NOT_OK_LOG(dst_rowset_writer->add_columns(&block, column_ids, is_key,
+                                                             max_rows_per_segment),
+                              "failed to write block when vertical merging rowsets of tablet " +
+                                      tablet->full_name());
+            if (is_key) {
+                output_rows += block.rows();
+            }
+            block.clear_column_data();
+        }
+        if (is_key) {
+            merged_rows = key_merge_iter->merged_rows();
+        }
+        RETURN_NOT_OK_LOG(dst_rowset_writer->flush_columns(),
+                          "failed to flush columns when vertical merging rowsets of tablet " +
+                                  tablet->full_name());
+    }
+    RETURN_NOT_OK_LOG(dst_rowset_writer->final_flush(),
+                      "failed to flush rowset when vertical merging rowsets of tablet " +
+                              tablet->full_name());
+
+    if (stats_output != nullptr) {
+        stats_output->output_rows = output_rows;
+        stats_output->merged_rows = merged_rows;
+        stats_output->filtered_rows = 0;
+    }
+    return Status::OK();
+}
+
 } // namespace doris
@@ -42,6 +42,19 @@ public:
     static Status vmerge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
                                  const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
                                  RowsetWriter* dst_rowset_writer, Statistics* stats_output);
+
+    // split columns of `tablet_schema` into column groups for vertical compaction,
+    // the first group contains all key columns and the sequence column if exists.
+    static void vertical_split_columns(const TabletSchema& tablet_schema,
+                                       std::vector<std::vector<uint32_t>>* column_groups);
+
+    // merge `src_rowsets` column group by column group and write into `dst_rowset_writer`,
+    // which must be created as a vertical rowset writer. All `src_rowsets` must be beta
+    // rowsets, and delete predicates are not applied.
+    static Status vertical_merge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
+                                         const std::vector<RowsetSharedPtr>& src_rowsets,
+                                         RowsetWriter* dst_rowset_writer,
+                                         uint32_t max_rows_per_segment, Statistics* stats_output);
 };
 
 } // namespace doris
@@ -514,12 +514,13 @@ std::vector<TabletSharedPtr> StorageEngine::_generate_compaction_tasks(
         // So that we can update the max_compaction_score metric.
         if (!data_dir->reach_capacity_limit(0)) {
             uint32_t disk_max_score = 0;
+            CompactionCandidate candidate;
             TabletSharedPtr tablet = _tablet_manager->find_best_tablet_to_compaction(
                     compaction_type, data_dir,
                     compaction_type == CompactionType::CUMULATIVE_COMPACTION
                             ? copied_cumu_map[data_dir]
                             : copied_base_map[data_dir],
-                    &disk_max_score, _cumulative_compaction_policy);
+                    &disk_max_score, _cumulative_compaction_policy, &candidate);
             if (data_dir->is_remote()) {
                 continue;
             }
@@ -529,6 +530,14 @@ std::vector<TabletSharedPtr> StorageEngine::_generate_compaction_tasks(
                 }
                 max_compaction_score = std::max(max_compaction_score, disk_max_score);
             }
+            {
+                std::unique_lock<std::mutex> lock(_tablet_submitted_compaction_mutex);
+                if (compaction_type == CompactionType::CUMULATIVE_COMPACTION) {
+                    _last_cumu_compaction_candidates[data_dir] = candidate;
+                } else {
+                    _last_base_compaction_candidates[data_dir] = candidate;
+                }
+            }
         }
     }
 
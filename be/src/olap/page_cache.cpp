@@ -24,33 +24,55 @@ namespace doris {
 StoragePageCache* StoragePageCache::_s_instance = nullptr;
 
 void StoragePageCache::create_global_cache(size_t capacity, int32_t index_cache_percentage,
-                                           uint32_t num_shards) {
+                                           uint32_t num_shards,
+                                           CacheEvictionPolicy data_page_policy,
+                                           int32_t compressed_cache_percentage,
+                                           int32_t key_index_cache_percentage) {
     DCHECK(_s_instance == nullptr);
-    static StoragePageCache instance(capacity, index_cache_percentage, num_shards);
+    static StoragePageCache instance(capacity, index_cache_percentage, num_shards,
+                                     data_page_policy, compressed_cache_percentage,
+                                     key_index_cache_percentage);
     _s_instance = &instance;
 }
 
 StoragePageCache::StoragePageCache(size_t capacity, int32_t index_cache_percentage,
-                                   uint32_t num_shards)
+                                   uint32_t num_shards, CacheEvictionPolicy data_page_policy,
+                                   int32_t compressed_cache_percentage,
+                                   int32_t key_index_cache_percentage)
         : _index_cache_percentage(index_cache_percentage),
           _mem_tracker(MemTracker::create_tracker(capacity, "StoragePageCache", nullptr,
                                                   MemTrackerLevel::OVERVIEW)) {
     SCOPED_SWITCH_THREAD_LOCAL_MEM_TRACKER(_mem_tracker);
-    if (index_cache_percentage == 0) {
+    CHECK(index_cache_percentage >= 0 && index_cache_percentage <= 100)
+            << "invalid index page cache percentage";
+    CHECK(compressed_cache_percentage >= 0 && compressed_cache_percentage < 100)
+            << "invalid compressed page cache percentage";
+    CHECK(key_index_cache_percentage >= 0 && key_index_cache_percentage < 100)
+            << "invalid key index page cache percentage";
+    size_t data_capacity = capacity * (100 - index_cache_percentage) / 100;
+    if (index_cache_percentage != 100) {
+        size_t compressed_capacity = data_capacity * compressed_cache_percentage / 100;
+        if (compressed_capacity > 0) {
+            // pages leave compressed tier once they are hit, so LRU is enough
+            _compressed_page_cache = std::unique_ptr<Cache>(
+                    new_lru_cache("CompressedDataPageCache", compressed_capacity,
+                                  LRUCacheType::SIZE, num_shards));
+        }
         _data_page_cache = std::unique_ptr<Cache>(
-                new_lru_cache("DataPageCache", capacity, LRUCacheType::SIZE, num_shards));
-    } else if (index_cache_percentage == 100) {
-        _index_page_cache = std::unique_ptr<Cache>(
-                new_lru_cache("IndexPageCache", capacity, LRUCacheType::SIZE, num_shards));
-    } else if (index_cache_percentage > 0 && index_cache_percentage < 100) {
-        _data_page_cache = std::unique_ptr<Cache>(
-                new_lru_cache("DataPageCache", capacity * (100 - index_cache_percentage) / 100,
-                              LRUCacheType::SIZE, num_shards));
+                new_lru_cache("DataPageCache", data_capacity - compressed_capacity,
+                              LRUCacheType::SIZE, num_shards, data_page_policy));
+    }
+    if (index_cache_percentage != 0) {
+        size_t index_capacity = capacity * index_cache_percentage / 100;
+        size_t key_index_capacity = index_capacity * key_index_cache_percentage / 100;
+        if (key_index_capacity > 0) {
+            _key_index_page_cache = std::unique_ptr<Cache>(
+                    new_lru_cache("KeyIndexPageCache", key_index_capacity, LRUCacheType::SIZE,
+                                  num_shards));
+        }
         _index_page_cache = std::unique_ptr<Cache>(
-                new_lru_cache("IndexPageCache", capacity * index_cache_percentage / 100,
+                new_lru_cache("IndexPageCache", index_capacity - key_index_capacity,
                               LRUCacheType::SIZE, num_shards));
-    } else {
-        CHECK(false) << "invalid index page cache percentage";
     }
 }
 
@@ -79,4 +101,26 @@ void StoragePageCache::insert(const CacheKey& key, const Slice& data, PageCacheH
     *handle = PageCacheHandle(cache, lru_handle);
 }
 
+bool StoragePageCache::lookup_compressed(const CacheKey& key, PageCacheHandle* handle) {
+    DCHECK(_compressed_page_cache != nullptr);
+    auto lru_handle = _compressed_page_cache->lookup(key.encode());
+    if (lru_handle == nullptr) {
+        return false;
+    }
+    *handle = PageCacheHandle(_compressed_page_cache.get(), lru_handle);
+    return true;
+}
+
+void StoragePageCache::insert_compressed(const CacheKey& key, const Slice& data) {
+    DCHECK(_compressed_page_cache != nullptr);
+    auto deleter = [](const doris::CacheKey& key, void* value) { delete[](uint8_t*) value; };
+    _compressed_page_cache->release(
+            _compressed_page_cache->insert(key.encode(), data.data, data.size, deleter));
+}
+
+void StoragePageCache::erase_compressed(const CacheKey& key) {
+    DCHECK(_compressed_page_cache != nullptr);
+    _compressed_page_cache->erase(key.encode());
+}
+
 } // namespace doris
@@ -32,7 +32,13 @@ class PageCacheHandle;
 
 // Wrapper around Cache, and used for cache page of column data
 // in Segment.
-// TODO(zc): We should add some metric to see cache hit/miss rate.
+// Data pages can optionally be cached in two tiers: a compressed tier which keeps the
+// page as it is stored in file, and the decompressed tier. A compressed data page is
+// first cached in compressed tier, and promoted to decompressed tier when it is hit
+// again, so cold pages take less memory at the cost of decompressing them on hit.
+// Each tier is an individual Cache, so hit/miss metrics are reported per tier.
+// The short key index and key bloom filter pages of segments can optionally be cached apart
+// from the other index pages, so the key indexes of hot tablets are not evicted by them.
 class StoragePageCache {
 public:
     // The unique key identifying entries in the page cache.
@@ -56,15 +62,27 @@ public:
 
     static constexpr uint32_t kDefaultNumShards = 16;
 
-    // Create global instance of this class
-    static void create_global_cache(size_t capacity, int32_t index_cache_percentage,
-                                    uint32_t num_shards = kDefaultNumShards);
+    // Create global instance of this class.
+    // data_page_policy is the eviction policy of data page cache, index page cache
+    // always uses LRU policy.
+    // compressed_cache_percentage is the percentage of data page cache capacity used
+    // by compressed tier, 0 means compressed tier is disabled.
+    // key_index_cache_percentage is the percentage of index page cache capacity used
+    // by key index pages, 0 means they are cached with the other index pages.
+    static void create_global_cache(
+            size_t capacity, int32_t index_cache_percentage,
+            uint32_t num_shards = kDefaultNumShards,
+            CacheEvictionPolicy data_page_policy = CacheEvictionPolicy::LRU,
+            int32_t compressed_cache_percentage = 0, int32_t key_index_cache_percentage = 0);
 
     // Return global instance.
     // Client should call create_global_cache before.
     static StoragePageCache* instance() { return _s_instance; }
 
-    StoragePageCache(size_t capacity, int32_t index_cache_percentage, uint32_t num_shards);
+    StoragePageCache(size_t capacity, int32_t index_cache_percentage, uint32_t num_shards,
+                     CacheEvictionPolicy data_page_policy = CacheEvictionPolicy::LRU,
+                     int32_t compressed_cache_percentage = 0,
+                     int32_t key_index_cache_percentage = 0);
 
     // Lookup the given page in the cache.
     //
@@ -91,6 +109,21 @@ public:
         return _get_page_cache(page_type) != nullptr;
     }
 
+    // Lookup the given data page in compressed tier.
+    // Return true if entry is found, otherwise return false.
+    bool lookup_compressed(const CacheKey& key, PageCacheHandle* handle);
+
+    // Insert a compressed data page with key into compressed tier, the cache takes
+    // the ownership of data.
+    void insert_compressed(const CacheKey& key, const Slice& data);
+
+    // Remove the data page from compressed tier, used when the page is promoted
+    // to decompressed tier.
+    void erase_compressed(const CacheKey& key);
+
+    // Whether the compressed tier of data page is enabled.
+    bool is_compressed_cache_available() const { return _compressed_page_cache != nullptr; }
+
 private:
     StoragePageCache();
     static StoragePageCache* _s_instance;
@@ -98,6 +131,8 @@ private:
     int32_t _index_cache_percentage = 0;
     std::unique_ptr<Cache> _data_page_cache = nullptr;
     std::unique_ptr<Cache> _index_page_cache = nullptr;
+    std::unique_ptr<Cache> _compressed_page_cache = nullptr;
+    std::unique_ptr<Cache> _key_index_page_cache = nullptr;
 
     std::shared_ptr<MemTracker> _mem_tracker = nullptr;
 
@@ -108,6 +143,10 @@ private:
         }
         case segment_v2::INDEX_PAGE:
             return _index_page_cache.get();
+        case segment_v2::SHORT_KEY_PAGE:
+        case segment_v2::KEY_BLOOM_FILTER_PAGE:
+            return _key_index_page_cache != nullptr ? _key_index_page_cache.get()
+                                                    : _index_page_cache.get();
         default:
             return nullptr;
         }
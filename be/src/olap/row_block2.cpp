@@ -189,7 +189,8 @@ Status RowBlockV2::_copy_data_to_column(int cid,
         }
         break;
     }
-    case OLAP_FIELD_TYPE_STRING: {
+    case OLAP_FIELD_TYPE_STRING:
+    case OLAP_FIELD_TYPE_JSONB: {
         auto column_string = assert_cast<vectorized::ColumnString*>(column);
         size_t limit = config::string_type_length_soft_limit_bytes;
         for (uint16_t j = 0; j < _selected_size; ++j) {
@@ -450,7 +451,8 @@ Status RowBlockV2::_append_data_to_column(const ColumnVectorBatch* batch, size_t
         }
         break;
     }
-    case OLAP_FIELD_TYPE_STRING: {
+    case OLAP_FIELD_TYPE_STRING:
+    case OLAP_FIELD_TYPE_JSONB: {
         auto column_string = assert_cast<vectorized::ColumnString*>(column);
 
         for (uint32_t j = 0; j < selected_size; ++j) {
@@ -111,9 +111,11 @@ void BetaRowset::do_close() {
     // do nothing.
 }
 
-Status BetaRowset::link_files_to(const FilePathDesc& dir_desc, RowsetId new_rowset_id) {
+Status BetaRowset::link_files_to(const FilePathDesc& dir_desc, RowsetId new_rowset_id,
+                                 size_t new_rowset_start_seg_id) {
     for (int i = 0; i < num_segments(); ++i) {
-        FilePathDesc dst_link_path_desc = segment_file_path(dir_desc, new_rowset_id, i);
+        FilePathDesc dst_link_path_desc =
+                segment_file_path(dir_desc, new_rowset_id, i + new_rowset_start_seg_id);
         // TODO(lingbin): use Env API? or EnvUtil?
         if (FileUtils::check_exist(dst_link_path_desc.filepath)) {
             LOG(WARNING) << "failed to create hard link, file already exist: "
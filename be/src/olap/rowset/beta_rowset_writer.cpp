@@ -161,11 +161,20 @@ template Status BetaRowsetWriter::_add_row(const ContiguousRow& row);
 
 Status BetaRowsetWriter::add_rowset(RowsetSharedPtr rowset) {
     assert(rowset->rowset_meta()->rowset_type() == BETA_ROWSET);
-    RETURN_NOT_OK(rowset->link_files_to(_context.path_desc, _context.rowset_id));
+    // segments of `rowset` are appended after the existing segments
+    int32_t start_segment_id = _num_segment;
+    RETURN_NOT_OK(rowset->link_files_to(_context.path_desc, _context.rowset_id, start_segment_id));
     _num_rows_written += rowset->num_rows();
     _total_data_size += rowset->rowset_meta()->data_disk_size();
     _total_index_size += rowset->rowset_meta()->index_disk_size();
     _num_segment += rowset->num_segments();
+    if (rowset->rowset_meta()->has_segments_key_bounds()) {
+        std::lock_guard<SpinLock> l(_lock);
+        const auto& segments_key_bounds = rowset->rowset_meta()->segments_key_bounds();
+        for (int i = 0; i < segments_key_bounds.size(); ++i) {
+            _segments_key_bounds[start_segment_id + i] = segments_key_bounds.Get(i);
+        }
+    }
     // TODO update zonemap
     if (rowset->rowset_meta()->has_delete_predicate()) {
         _rowset_meta->set_delete_predicate(rowset->rowset_meta()->delete_predicate());
@@ -282,6 +291,14 @@ RowsetSharedPtr BetaRowsetWriter::build() {
     _rowset_meta->set_empty(_num_rows_written == 0);
     _rowset_meta->set_creation_time(time(nullptr));
     _rowset_meta->set_num_segments(_num_segment);
+    // key bounds are recorded only if all segments have key bounds
+    if (_num_segment > 0 && _segments_key_bounds.size() == _num_segment) {
+        std::vector<KeyBoundsPB> segments_key_bounds;
+        for (auto& [segment_id, key_bounds] : _segments_key_bounds) {
+            segments_key_bounds.push_back(key_bounds);
+        }
+        _rowset_meta->set_segments_key_bounds(segments_key_bounds);
+    }
     if (_num_segment <= 1) {
         _rowset_meta->set_segments_overlap(NONOVERLAPPING);
     }
@@ -303,9 +320,11 @@ RowsetSharedPtr BetaRowsetWriter::build() {
 }
 
 Status BetaRowsetWriter::_create_segment_writer(
-        std::unique_ptr<segment_v2::SegmentWriter>* writer) {
+        std::unique_ptr<segment_v2::SegmentWriter>* writer,
+        const std::vector<uint32_t>* column_ids, bool is_key) {
+    int32_t segment_id = _num_segment.fetch_add(1);
     auto path_desc =
-            BetaRowset::segment_file_path(_context.path_desc, _context.rowset_id, _num_segment++);
+            BetaRowset::segment_file_path(_context.path_desc, _context.rowset_id, segment_id);
     // TODO(lingbin): should use a more general way to get BlockManager object
     // and tablets with the same type should share one BlockManager object;
     fs::BlockManager* block_mgr = fs::fs_util::block_manager(_context.path_desc);
@@ -321,7 +340,7 @@ Status BetaRowsetWriter::_create_segment_writer(
 
     DCHECK(wblock != nullptr);
     segment_v2::SegmentWriterOptions writer_options;
-    writer->reset(new segment_v2::SegmentWriter(wblock.get(), _num_segment, _context.tablet_schema,
+    writer->reset(new segment_v2::SegmentWriter(wblock.get(), segment_id, _context.tablet_schema,
                                                 _context.data_dir, _context.max_rows_per_segment,
                                                 writer_options));
     {
@@ -329,7 +348,9 @@ Status BetaRowsetWriter::_create_segment_writer(
         _wblocks.push_back(std::move(wblock));
     }
 
-    auto s = (*writer)->init(config::push_write_mbytes_per_sec);
+    auto s = column_ids == nullptr
+                     ? (*writer)->init(config::push_write_mbytes_per_sec)
+                     : (*writer)->init(config::push_write_mbytes_per_sec, *column_ids, is_key);
     if (!s.ok()) {
         LOG(WARNING) << "failed to init segment writer: " << s.to_string();
         writer->reset(nullptr);
@@ -351,8 +372,16 @@ Status BetaRowsetWriter::_flush_segment_writer(std::unique_ptr<segment_v2::Segme
     }
     _total_data_size += segment_size;
     _total_index_size += index_size;
+    _add_segment_key_bounds(**writer);
     writer->reset();
     return Status::OK();
 }
 
+void BetaRowsetWriter::_add_segment_key_bounds(const segment_v2::SegmentWriter& writer) {
+    KeyBoundsPB key_bounds;
+    writer.get_key_bounds(&key_bounds);
+    std::lock_guard<SpinLock> l(_lock);
+    _segments_key_bounds[writer.get_segment_id()] = std::move(key_bounds);
+}
+
 } // namespace doris
@@ -18,6 +18,8 @@
 #ifndef DORIS_BE_SRC_OLAP_ROWSET_BETA_ROWSET_WRITER_H
 #define DORIS_BE_SRC_OLAP_ROWSET_BETA_ROWSET_WRITER_H
 
+#include <map>
+
 #include "olap/rowset/rowset_writer.h"
 #include "vector"
 
@@ -69,17 +71,24 @@ public:
 
     RowsetTypePB type() const override { return RowsetTypePB::BETA_ROWSET; }
 
-private:
+protected:
     template <typename RowType>
     Status _add_row(const RowType& row);
     Status _add_block(const vectorized::Block* block,
                       std::unique_ptr<segment_v2::SegmentWriter>* writer);
 
-    Status _create_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* writer);
+    // create a segment writer which writes all columns of the tablet schema if `column_ids`
+    // is nullptr, or only writes the specified columns
+    Status _create_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* writer,
+                                  const std::vector<uint32_t>* column_ids = nullptr,
+                                  bool is_key = true);
 
     Status _flush_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* writer);
 
-private:
+    // record key bounds of a finalized segment
+    void _add_segment_key_bounds(const segment_v2::SegmentWriter& writer);
+
+protected:
     RowsetWriterContext _context;
     std::shared_ptr<RowsetMeta> _rowset_meta;
 
@@ -91,6 +100,8 @@ private:
     mutable SpinLock _lock; // lock to protect _wblocks.
     // TODO(lingbin): it is better to wrapper in a Batch?
     std::vector<std::unique_ptr<fs::WritableBlock>> _wblocks;
+    // key bounds of segments, indexed by segment id, also protected by _lock.
+    std::map<uint32_t, KeyBoundsPB> _segments_key_bounds;
 
     // counters and statistics maintained during data write
     std::atomic<int64_t> _num_rows_written;
@@ -192,8 +192,10 @@ public:
                     << "-" << end_version() << ", tabletid:" << _rowset_meta->tablet_id();
     }
 
-    // hard link all files in this rowset to `dir` to form a new rowset with id `new_rowset_id`.
-    virtual Status link_files_to(const FilePathDesc& dir_desc, RowsetId new_rowset_id) = 0;
+    // hard link all files in this rowset to `dir` to form a new rowset with id `new_rowset_id`,
+    // segments are numbered from `new_rowset_start_seg_id` in the new rowset.
+    virtual Status link_files_to(const FilePathDesc& dir_desc, RowsetId new_rowset_id,
+                                 size_t new_rowset_start_seg_id = 0) = 0;
 
     // copy all files to `dir`
     virtual Status copy_files_to(const std::string& dir, const RowsetId& new_rowset_id) = 0;
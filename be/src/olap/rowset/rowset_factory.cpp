@@ -25,6 +25,7 @@
 #include "olap/rowset/alpha_rowset_writer.h"
 #include "olap/rowset/beta_rowset_writer.h"
 #include "olap/rowset/rowset_writer.h"
+#include "olap/rowset/vertical_beta_rowset_writer.h"
 
 namespace doris {
 
@@ -49,6 +50,10 @@ Status RowsetFactory::create_rowset_writer(const RowsetWriterContext& context,
         return (*output)->init(context);
     }
     if (context.rowset_type == BETA_ROWSET) {
+        if (context.is_vertical) {
+            output->reset(new VerticalBetaRowsetWriter);
+            return (*output)->init(context);
+        }
         output->reset(new BetaRowsetWriter);
         return (*output)->init(context);
     }
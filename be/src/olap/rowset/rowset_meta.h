@@ -240,6 +240,22 @@ public:
         _rowset_meta_pb.set_segments_overlap_pb(segments_overlap);
     }
 
+    // return true if the key bounds of all segments are recorded
+    bool has_segments_key_bounds() const {
+        return num_segments() > 0 && _rowset_meta_pb.segments_key_bounds_size() == num_segments();
+    }
+
+    const google::protobuf::RepeatedPtrField<KeyBoundsPB>& segments_key_bounds() const {
+        return _rowset_meta_pb.segments_key_bounds();
+    }
+
+    void set_segments_key_bounds(const std::vector<KeyBoundsPB>& segments_key_bounds) {
+        _rowset_meta_pb.clear_segments_key_bounds();
+        for (const auto& key_bounds : segments_key_bounds) {
+            *_rowset_meta_pb.add_segments_key_bounds() = key_bounds;
+        }
+    }
+
     static bool comparator(const RowsetMetaSharedPtr& left, const RowsetMetaSharedPtr& right) {
         return left->end_version() < right->end_version();
     }
@@ -48,6 +48,25 @@ public:
         return Status::OLAPInternalError(OLAP_ERR_FUNC_NOT_IMPLEMENTED);
     }
 
+    // Used by vertical compaction: add the columns in `col_ids` of `block` to the rowset.
+    // The key column group must be added first, which decides the rows of each segment,
+    // `max_rows_per_segment` is only used when adding the key column group.
+    virtual Status add_columns(const vectorized::Block* block, const std::vector<uint32_t>& col_ids,
+                               bool is_key, uint32_t max_rows_per_segment) {
+        return Status::OLAPInternalError(OLAP_ERR_FUNC_NOT_IMPLEMENTED);
+    }
+
+    // Used by vertical compaction: flush the current column group of all segments.
+    virtual Status flush_columns() {
+        return Status::OLAPInternalError(OLAP_ERR_FUNC_NOT_IMPLEMENTED);
+    }
+
+    // Used by vertical compaction: write footers of all segments after all column groups
+    // are flushed.
+    virtual Status final_flush() {
+        return Status::OLAPInternalError(OLAP_ERR_FUNC_NOT_IMPLEMENTED);
+    }
+
     // Precondition: the input `rowset` should have the same type of the rowset we're building
     virtual Status add_rowset(RowsetSharedPtr rowset) = 0;
 
@@ -71,6 +71,8 @@ struct RowsetWriterContext {
     // ATTN: not support for RowsetConvertor.
     // (because it hard to refactor, and RowsetConvertor will be deprecated in future)
     DataDir* data_dir = nullptr;
+    // write the rowset column group by column group, used by vertical compaction
+    bool is_vertical = false;
 };
 
 } // namespace doris
@@ -55,7 +55,11 @@ public:
 
     BloomFilter() : _data(nullptr), _num_bytes(0), _size(0), _has_null(nullptr) {}
 
-    virtual ~BloomFilter() { delete[] _data; }
+    virtual ~BloomFilter() {
+        if (_owns_data) {
+            delete[] _data;
+        }
+    }
 
     // for write
     Status init(uint64_t n, double fpp, HashStrategyPB strategy) {
@@ -82,22 +86,14 @@ public:
     // for read
     // use deep copy to acquire the data
     Status init(const char* buf, uint32_t size, HashStrategyPB strategy) {
-        DCHECK(size > 1);
-        if (strategy == HASH_MURMUR3_X64_64) {
-            _hash_func = murmur_hash3_x64_64;
-        } else {
-            return Status::InvalidArgument(strings::Substitute("invalid strategy:$0", strategy));
-        }
-        if (size == 0) {
-            return Status::InvalidArgument(strings::Substitute("invalid size:$0", size));
-        }
-        _data = new char[size];
-        memcpy(_data, buf, size);
-        _size = size;
-        _num_bytes = _size - 1;
-        DCHECK((_num_bytes & (_num_bytes - 1)) == 0);
-        _has_null = (bool*)(_data + _num_bytes);
-        return Status::OK();
+        return _init_for_read(buf, size, strategy, true);
+    }
+
+    // for read
+    // refer to the data without copying it, so it must outlive the bloom filter, e.g. it is
+    // held by a page handle
+    Status init_without_copy(const char* buf, uint32_t size, HashStrategyPB strategy) {
+        return _init_for_read(buf, size, strategy, false);
     }
 
     void reset() { memset(_data, 0, _size); }
@@ -165,8 +161,34 @@ protected:
     uint32_t _size;
     // last byte's pointer in data for null flag
     bool* _has_null;
+    // false if _data refers to the data passed to init_without_copy()
+    bool _owns_data = true;
 
 private:
+    Status _init_for_read(const char* buf, uint32_t size, HashStrategyPB strategy, bool copy) {
+        DCHECK(size > 1);
+        if (strategy == HASH_MURMUR3_X64_64) {
+            _hash_func = murmur_hash3_x64_64;
+        } else {
+            return Status::InvalidArgument(strings::Substitute("invalid strategy:$0", strategy));
+        }
+        if (size == 0) {
+            return Status::InvalidArgument(strings::Substitute("invalid size:$0", size));
+        }
+        if (copy) {
+            _data = new char[size];
+            memcpy(_data, buf, size);
+        } else {
+            _data = const_cast<char*>(buf);
+            _owns_data = false;
+        }
+        _size = size;
+        _num_bytes = _size - 1;
+        DCHECK((_num_bytes & (_num_bytes - 1)) == 0);
+        _has_null = (bool*)(_data + _num_bytes);
+        return Status::OK();
+    }
+
     std::function<void(const void*, const int, const uint64_t, void*)> _hash_func;
 };
 
@@ -28,7 +28,8 @@
 #include "olap/rowset/segment_v2/page_pointer.h" // for PagePointer
 #include "olap/types.h"                          // for TypeInfo
 #include "util/block_compression.h"
-#include "util/coding.h"       // for get_varint32
+#include "util/coding.h" // for get_varint32
+#include "util/jsonb.h"
 #include "util/rle_encoding.h" // for RleDecoder
 #include "vec/core/types.h"
 #include "vec/runtime/vdatetime_value.h" //for VecDateTime
@@ -746,6 +747,15 @@ Status DefaultValueColumnIterator::init(const ColumnIteratorOptions& opts) {
                 memory_copy(string_buffer, _default_value.c_str(), length);
                 ((Slice*)_mem_value)->size = length;
                 ((Slice*)_mem_value)->data = string_buffer;
+            } else if (_type_info->type() == OLAP_FIELD_TYPE_JSONB) {
+                // the default value is json text
+                std::string jsonb;
+                RETURN_IF_ERROR(JsonbDocument::from_json(_default_value.data(),
+                                                         _default_value.length(), &jsonb));
+                char* string_buffer = reinterpret_cast<char*>(_pool->allocate(jsonb.size()));
+                memory_copy(string_buffer, jsonb.data(), jsonb.size());
+                ((Slice*)_mem_value)->size = jsonb.size();
+                ((Slice*)_mem_value)->data = string_buffer;
             } else if (_type_info->type() == OLAP_FIELD_TYPE_ARRAY) {
                 // TODO llj for Array default value
                 return Status::NotSupported("Array default type is unsupported");
@@ -834,6 +844,7 @@ void DefaultValueColumnIterator::insert_default_data(vectorized::MutableColumnPt
         break;
     }
     case OLAP_FIELD_TYPE_STRING:
+    case OLAP_FIELD_TYPE_JSONB:
     case OLAP_FIELD_TYPE_VARCHAR:
     case OLAP_FIELD_TYPE_CHAR: {
         data_ptr = ((Slice*)_mem_value)->data;
@@ -280,6 +280,8 @@ EncodingInfoResolver::EncodingInfoResolver() {
     _add_map<OLAP_FIELD_TYPE_OBJECT, PLAIN_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_QUANTILE_STATE, PLAIN_ENCODING>();
+
+    _add_map<OLAP_FIELD_TYPE_JSONB, PLAIN_ENCODING>();
 }
 
 EncodingInfoResolver::~EncodingInfoResolver() {
@@ -83,6 +83,9 @@ Status PageIO::write_page(fs::WritableBlock* wblock, const std::vector<Slice>& b
     case SHORT_KEY_PAGE:
         CHECK(footer.has_short_key_page_footer());
         break;
+    case KEY_BLOOM_FILTER_PAGE:
+        CHECK(footer.has_key_bloom_filter_page_footer());
+        break;
     default:
         CHECK(false) << "Invalid page footer type: " << footer.type();
         break;
@@ -134,29 +137,48 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
         return Status::OK();
     }
 
-    // every page contains 4 bytes footer length and 4 bytes checksum
-    const uint32_t page_size = opts.page_pointer.size;
-    if (page_size < 8) {
-        return Status::Corruption(strings::Substitute("Bad page: too small size ($0)", page_size));
-    }
+    // Compressed data pages are cached in compressed tier on first read, and promoted to
+    // decompressed tier when hit again. In-memory pages always go to decompressed tier.
+    bool use_compressed_cache = opts.use_page_cache && opts.type == DATA_PAGE &&
+                                !opts.kept_in_memory && cache->is_compressed_cache_available();
+    PageCacheHandle compressed_handle;
+    bool compressed_hit =
+            use_compressed_cache && cache->lookup_compressed(cache_key, &compressed_handle);
 
     // hold compressed page at first, reset to decompressed page later
-    std::unique_ptr<char[]> page(new char[page_size]);
-    Slice page_slice(page.get(), page_size);
-    {
-        SCOPED_RAW_TIMER(&opts.stats->io_ns);
-        RETURN_IF_ERROR(opts.rblock->read(opts.page_pointer.offset, page_slice));
-        opts.stats->compressed_bytes_read += page_size;
-    }
+    std::unique_ptr<char[]> page;
+    Slice page_slice;
+    if (compressed_hit) {
+        // checksum has been verified when the page was read from file
+        page_slice = compressed_handle.data();
+        opts.stats->compressed_cached_pages_num++;
+    } else {
+        // every page contains 4 bytes footer length and 4 bytes checksum
+        const uint32_t page_size = opts.page_pointer.size;
+        if (page_size < 8) {
+            return Status::Corruption(
+                    strings::Substitute("Bad page: too small size ($0)", page_size));
+        }
 
-    if (opts.verify_checksum) {
-        uint32_t expect = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
-        uint32_t actual = crc32c::Value(page_slice.data, page_slice.size - 4);
-        if (expect != actual) {
-            return Status::Corruption(strings::Substitute(
-                    "Bad page: checksum mismatch (actual=$0 vs expect=$1)", actual, expect));
+        page.reset(new char[page_size]);
+        page_slice = Slice(page.get(), page_size);
+        {
+            SCOPED_RAW_TIMER(&opts.stats->io_ns);
+            RETURN_IF_ERROR(opts.rblock->read(opts.page_pointer.offset, page_slice));
+            opts.stats->compressed_bytes_read += page_size;
+        }
+
+        if (opts.verify_checksum) {
+            uint32_t expect = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
+            uint32_t actual = crc32c::Value(page_slice.data, page_slice.size - 4);
+            if (expect != actual) {
+                return Status::Corruption(strings::Substitute(
+                        "Bad page: checksum mismatch (actual=$0 vs expect=$1)", actual, expect));
+            }
         }
     }
+    // the whole page as it is stored in file
+    const Slice file_page_slice = page_slice;
 
     // remove checksum suffix
     page_slice.size -= 4;
@@ -167,7 +189,8 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     }
 
     uint32_t body_size = page_slice.size - 4 - footer_size;
-    if (body_size != footer->uncompressed_size()) { // need decompress body
+    bool need_decompress = body_size != footer->uncompressed_size();
+    if (need_decompress) {
         if (opts.codec == nullptr) {
             return Status::Corruption("Bad page: page is compressed but codec is NO_COMPRESSION");
         }
@@ -187,16 +210,35 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
         // append footer and footer size
         memcpy(decompressed_body.data + decompressed_body.size, page_slice.data + body_size,
                footer_size + 4);
+        if (use_compressed_cache && !compressed_hit) {
+            // first read of the page, only cache it in compressed tier
+            cache->insert_compressed(cache_key, file_page_slice);
+            page.release(); // memory now managed by compressed tier
+        }
         // free memory of compressed page
         page = std::move(decompressed_page);
         page_slice = Slice(page.get(), footer->uncompressed_size() + footer_size + 4);
         opts.stats->uncompressed_bytes_read += page_slice.size;
     } else {
+        if (compressed_hit) {
+            // only compressed pages are put into compressed tier, drop the bad entry so that
+            // the page is read from file next time
+            compressed_handle = PageCacheHandle();
+            cache->erase_compressed(cache_key);
+            return Status::Corruption("Bad page: uncompressed page in compressed page cache");
+        }
         opts.stats->uncompressed_bytes_read += body_size;
     }
 
+    if (compressed_hit) {
+        // the page is hit again, promote it to decompressed tier
+        compressed_handle = PageCacheHandle();
+        cache->erase_compressed(cache_key);
+    }
+
     *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
-    if (opts.use_page_cache && cache->is_cache_available(opts.type)) {
+    if (opts.use_page_cache && cache->is_cache_available(opts.type) &&
+        !(use_compressed_cache && need_decompress && !compressed_hit)) {
         // insert this page into cache and return the cache handle
         cache->insert(cache_key, page_slice, &cache_handle, opts.type, opts.kept_in_memory);
         *handle = PageHandle(std::move(cache_handle));
@@ -56,7 +56,8 @@ struct PageReadOptions {
     bool kept_in_memory = false;
     // for page cache allocation
     // page types are divided into DATA_PAGE & INDEX_PAGE
-    // INDEX_PAGE including index_page, dict_page and short_key_page
+    // INDEX_PAGE including index_page and dict_page, short_key_page and
+    // key_bloom_filter_page are cached with them unless key index page cache is enabled
     PageTypePB type;
 
     void sanity_check() const {
@@ -17,11 +17,16 @@
 
 #include "olap/rowset/segment_v2/segment.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "common/logging.h" // LOG
 #include "gutil/strings/substitute.h"
 #include "olap/fs/fs_util.h"
+#include "olap/key_coder.h"
+#include "olap/row.h"
+#include "olap/row_cursor.h"
+#include "olap/rowset/segment_v2/bloom_filter.h"
 #include "olap/rowset/segment_v2/column_reader.h" // ColumnReader
 #include "olap/rowset/segment_v2/empty_segment_iterator.h"
 #include "olap/rowset/segment_v2/page_io.h"
@@ -92,6 +97,14 @@ Status Segment::new_iterator(const Schema& schema, const StorageReadOptions& rea
     }
 
     RETURN_IF_ERROR(_load_index());
+    // trying to prune the current segment by the keys looked up
+    if (!read_options.key_ranges.empty() &&
+        std::none_of(read_options.key_ranges.begin(), read_options.key_ranges.end(),
+                     [this](const auto& key_range) { return key_range_may_match(key_range); })) {
+        iter->reset(new EmptySegmentIterator(schema));
+        read_options.stats->filtered_segment_number++;
+        return Status::OK();
+    }
     iter->reset(new SegmentIterator(this->shared_from_this(), schema));
     iter->get()->init(read_options);
     return Status::OK();
@@ -163,7 +176,8 @@ Status Segment::_load_index() {
         opts.codec = nullptr; // short key index page uses NO_COMPRESSION for now
         OlapReaderStatistics tmp_stats;
         opts.stats = &tmp_stats;
-        opts.type = INDEX_PAGE;
+        opts.type = SHORT_KEY_PAGE;
+        opts.kept_in_memory = _tablet_schema->is_in_memory();
 
         Slice body;
         PageFooterPB footer;
@@ -173,10 +187,73 @@ Status Segment::_load_index() {
 
         _mem_tracker->consume(body.get_size());
         _sk_index_decoder.reset(new ShortKeyIndexDecoder);
-        return _sk_index_decoder->parse(body, footer.short_key_page_footer());
+        RETURN_IF_ERROR(_sk_index_decoder->parse(body, footer.short_key_page_footer()));
+        if (_footer.has_key_bloom_filter_page()) {
+            RETURN_IF_ERROR(_load_key_bloom_filter(rblock.get()));
+        }
+        return Status::OK();
     });
 }
 
+Status Segment::_load_key_bloom_filter(fs::ReadableBlock* rblock) {
+    PageReadOptions opts;
+    opts.rblock = rblock;
+    opts.page_pointer = PagePointer(_footer.key_bloom_filter_page());
+    opts.codec = nullptr;
+    OlapReaderStatistics tmp_stats;
+    opts.stats = &tmp_stats;
+    opts.type = KEY_BLOOM_FILTER_PAGE;
+    opts.kept_in_memory = _tablet_schema->is_in_memory();
+
+    PageHandle handle;
+    Slice body;
+    PageFooterPB footer;
+    RETURN_IF_ERROR(PageIO::read_and_decompress_page(opts, &handle, &body, &footer));
+    DCHECK_EQ(footer.type(), KEY_BLOOM_FILTER_PAGE);
+    const KeyBloomFilterFooterPB& bf_footer = footer.key_bloom_filter_page_footer();
+    // the keys of rows written before key columns are added can't be looked up in it
+    if (bf_footer.num_key_columns() != _tablet_schema->num_key_columns()) {
+        return Status::OK();
+    }
+    // the filter refers to the page kept by the handle, like the short key index decoder does
+    std::unique_ptr<BloomFilter> bf;
+    RETURN_IF_ERROR(BloomFilter::create(bf_footer.algorithm(), &bf));
+    RETURN_IF_ERROR(bf->init_without_copy(body.data, body.size, bf_footer.hash_strategy()));
+    _mem_tracker->consume(body.get_size());
+    _key_bloom_filter_handle = std::move(handle);
+    _key_bloom_filter = std::move(bf);
+    return Status::OK();
+}
+
+bool Segment::key_range_may_match(const StorageReadOptions::KeyRange& key_range) const {
+    DCHECK(_load_index_once.has_called() && _load_index_once.stored_result().ok());
+    if (_key_bloom_filter == nullptr || key_range.lower_key == nullptr ||
+        key_range.upper_key == nullptr || !key_range.include_lower || !key_range.include_upper) {
+        return true;
+    }
+    const RowCursor& key = *key_range.lower_key;
+    size_t num_key_columns = _tablet_schema->num_key_columns();
+    if (key.field_count() != num_key_columns ||
+        key_range.upper_key->field_count() != num_key_columns ||
+        compare_row_key(key, *key_range.upper_key) != 0) {
+        return true;
+    }
+    // encode the key like SegmentWriter::full_encode_keys
+    std::string encoded_key;
+    for (uint32_t cid = 0; cid < num_key_columns; ++cid) {
+        auto cell = key.cell(cid);
+        if (cell.is_null()) {
+            encoded_key.push_back(KEY_NULL_FIRST_MARKER);
+            continue;
+        }
+        encoded_key.push_back(KEY_NORMAL_MARKER);
+        get_key_coder(key.schema()->column(cid)->type())
+                ->full_encode_ascending(cell.cell_ptr(), &encoded_key);
+    }
+    return _key_bloom_filter->test_hash(
+            _key_bloom_filter->hash(encoded_key.data(), encoded_key.size()));
+}
+
 Status Segment::_create_column_readers() {
     for (uint32_t ordinal = 0; ordinal < _footer.columns().size(); ++ordinal) {
         auto& column_pb = _footer.columns(ordinal);
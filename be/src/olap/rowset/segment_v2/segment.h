@@ -40,9 +40,14 @@ class ShortKeyIndexDecoder;
 class Schema;
 class StorageReadOptions;
 
+namespace fs {
+class ReadableBlock;
+}
+
 namespace segment_v2 {
 
 class BitmapIndexIterator;
+class BloomFilter;
 class ColumnReader;
 class ColumnIterator;
 class Segment;
@@ -90,6 +95,10 @@ public:
         return _sk_index_decoder->upper_bound(key);
     }
 
+    // Return false if no row of this segment falls into key_range. Only a range of a single
+    // full key is checked, by the key bloom filter of this segment.
+    bool key_range_may_match(const StorageReadOptions::KeyRange& key_range) const;
+
     // This will return the last row block in this segment.
     // NOTE: Before call this function , client should assure that
     // this segment is not empty.
@@ -109,9 +118,10 @@ private:
     Status _open();
     Status _parse_footer();
     Status _create_column_readers();
-    // Load and decode short key index.
+    // Load and decode short key index and key bloom filter.
     // May be called multiple times, subsequent calls will no op.
     Status _load_index();
+    Status _load_key_bloom_filter(fs::ReadableBlock* rblock);
 
 private:
     friend class SegmentIterator;
@@ -140,6 +150,11 @@ private:
     PageHandle _sk_index_handle;
     // short key index decoder
     std::unique_ptr<ShortKeyIndexDecoder> _sk_index_decoder;
+    // used to hold the key bloom filter page in memory
+    PageHandle _key_bloom_filter_handle;
+    // bloom filter of the full keys of all rows, nullptr if the segment has none or it is
+    // written with other key columns
+    std::unique_ptr<BloomFilter> _key_bloom_filter;
     // segment footer need not to be read for remote storage, so _is_open is false. When remote file
     // need to be read. footer will be read and _is_open will be set to true.
     bool _is_open = false;
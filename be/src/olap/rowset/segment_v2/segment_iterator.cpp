@@ -167,6 +167,9 @@ Status SegmentIterator::_get_row_ranges_by_keys() {
 
     RowRanges result_ranges;
     for (auto& key_range : _opts.key_ranges) {
+        if (!_segment->key_range_may_match(key_range)) {
+            continue;
+        }
         rowid_t lower_rowid = 0;
         rowid_t upper_rowid = num_rows();
         RETURN_IF_ERROR(_prepare_seek(key_range));
@@ -718,9 +721,9 @@ void SegmentIterator::_vec_init_lazy_materialization() {
                      _is_need_short_eval) && // only when pred exists, we need to consider lazy materialization
                     (type == OLAP_FIELD_TYPE_HLL || type == OLAP_FIELD_TYPE_OBJECT ||
                      type == OLAP_FIELD_TYPE_VARCHAR || type == OLAP_FIELD_TYPE_CHAR ||
-                     type == OLAP_FIELD_TYPE_STRING || type == OLAP_FIELD_TYPE_BOOL ||
-                     type == OLAP_FIELD_TYPE_DATE || type == OLAP_FIELD_TYPE_DATETIME ||
-                     type == OLAP_FIELD_TYPE_DECIMAL)) {
+                     type == OLAP_FIELD_TYPE_STRING || type == OLAP_FIELD_TYPE_JSONB ||
+                     type == OLAP_FIELD_TYPE_BOOL || type == OLAP_FIELD_TYPE_DATE ||
+                     type == OLAP_FIELD_TYPE_DATETIME || type == OLAP_FIELD_TYPE_DECIMAL)) {
                     _lazy_materialization_read = true;
                 }
             }
@@ -17,12 +17,14 @@
 
 #include "olap/rowset/segment_v2/segment_writer.h"
 
+#include "common/config.h"
 #include "common/logging.h" // LOG
 #include "env/env.h"        // Env
 #include "olap/data_dir.h"
 #include "olap/fs/block_manager.h"
 #include "olap/row.h"                             // ContiguousRow
 #include "olap/row_cursor.h"                      // RowCursor
+#include "olap/rowset/segment_v2/bloom_filter.h"
 #include "olap/rowset/segment_v2/column_writer.h" // ColumnWriter
 #include "olap/rowset/segment_v2/page_io.h"
 #include "olap/schema.h"
@@ -30,12 +32,17 @@
 #include "runtime/mem_tracker.h"
 #include "util/crc32c.h"
 #include "util/faststring.h"
+#include "util/murmur_hash3.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_vector.h"
 
 namespace doris {
 namespace segment_v2 {
 
 const char* k_segment_magic = "D0R1";
 const uint32_t k_segment_magic_length = 4;
+// false positive probability of the key bloom filter of a segment
+static const double k_key_bloom_filter_fpp = 0.01;
 
 SegmentWriter::SegmentWriter(fs::WritableBlock* wblock, uint32_t segment_id,
                              const TabletSchema* tablet_schema, DataDir* data_dir,
@@ -56,6 +63,12 @@ SegmentWriter::SegmentWriter(fs::WritableBlock* wblock, uint32_t segment_id,
         _short_key_coders.push_back(get_key_coder(column.type()));
         _short_key_index_size.push_back(column.index_length());
     }
+    for (size_t cid = 0; cid < _tablet_schema->num_key_columns(); ++cid) {
+        _key_coders.push_back(get_key_coder(_tablet_schema->column(cid).type()));
+    }
+    // keys are unique in a segment of unique key tablets, and mostly looked up one by one
+    _has_key_bloom_filter = config::enable_segment_key_bloom_filter &&
+                            _tablet_schema->keys_type() == KeysType::UNIQUE_KEYS;
 }
 
 SegmentWriter::~SegmentWriter() {
@@ -79,20 +92,54 @@ void SegmentWriter::init_column_meta(ColumnMetaPB* meta, uint32_t* column_id,
     }
 }
 
-Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused))) {
-    uint32_t column_id = 0;
-    _column_writers.reserve(_tablet_schema->columns().size());
-    for (auto& column : _tablet_schema->columns()) {
-        ColumnWriterOptions opts;
-        opts.meta = _footer.add_columns();
+Status SegmentWriter::init(uint32_t write_mbytes_per_sec) {
+    std::vector<uint32_t> column_ids;
+    for (uint32_t i = 0; i < _tablet_schema->num_columns(); ++i) {
+        column_ids.push_back(i);
+    }
+    return init(write_mbytes_per_sec, column_ids, true);
+}
+
+Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused)),
+                           const std::vector<uint32_t>& col_ids, bool has_key) {
+    DCHECK(_column_writers.empty());
+    // add metas of all columns at the first time, so that the ids of sub columns
+    // are the same no matter how the columns are grouped
+    if (_footer.columns_size() == 0) {
+        uint32_t column_id = 0;
+        for (auto& column : _tablet_schema->columns()) {
+            init_column_meta(_footer.add_columns(), &column_id, column, _tablet_schema);
+        }
+    }
+    _column_ids = col_ids;
+    _has_key = has_key;
+    _num_rows_written = 0;
+    // the row store column is encoded from the other columns, it is copied as is when the
+    // columns are written group by group. Like the reader, only unique keys tablets store
+    // rows, the value columns of the others may be types that can't be encoded, e.g. HLL.
+    if (_tablet_schema->row_store_col_idx() != -1 &&
+        _tablet_schema->keys_type() == KeysType::UNIQUE_KEYS &&
+        col_ids.size() == _tablet_schema->num_columns()) {
+        _row_store_codec = std::make_unique<vectorized::RowStoreCodec>(*_tablet_schema);
+    } else {
+        _row_store_codec.reset();
+    }
 
-        init_column_meta(opts.meta, &column_id, column, _tablet_schema);
+    _column_writers.reserve(col_ids.size());
+    for (auto cid : col_ids) {
+        const auto& column = _tablet_schema->column(cid);
+        ColumnWriterOptions opts;
+        opts.meta = _footer.mutable_columns(cid);
 
         // now we create zone map for key columns in AGG_KEYS or all column in UNIQUE_KEYS or DUP_KEYS
         // and not support zone map for array type.
         opts.need_zone_map = column.is_key() || _tablet_schema->keys_type() != KeysType::AGG_KEYS;
         opts.need_bloom_filter = column.is_bf_column();
         opts.need_bitmap_index = column.has_bitmap_index();
+        if (static_cast<int32_t>(cid) == _tablet_schema->row_store_col_idx()) {
+            // no query filters by the values of the row store column
+            opts.need_zone_map = false;
+        }
         if (column.type() == FieldType::OLAP_FIELD_TYPE_ARRAY) {
             opts.need_zone_map = false;
             if (opts.need_bloom_filter) {
@@ -102,13 +149,25 @@ Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused))
                 return Status::NotSupported("Do not support bitmap index for array type");
             }
         }
+        if (column.type() == FieldType::OLAP_FIELD_TYPE_JSONB) {
+            // min/max of binary jsonb is meaningless
+            opts.need_zone_map = false;
+            if (opts.need_bloom_filter) {
+                return Status::NotSupported("Do not support bloom filter for jsonb type");
+            }
+            if (opts.need_bitmap_index) {
+                return Status::NotSupported("Do not support bitmap index for jsonb type");
+            }
+        }
 
         std::unique_ptr<ColumnWriter> writer;
         RETURN_IF_ERROR(ColumnWriter::create(opts, &column, _wblock, &writer));
         RETURN_IF_ERROR(writer->init());
         _column_writers.push_back(std::move(writer));
     }
-    _index_builder.reset(new ShortKeyIndexBuilder(_segment_id, _opts.num_rows_per_block));
+    if (_has_key) {
+        _index_builder.reset(new ShortKeyIndexBuilder(_segment_id, _opts.num_rows_per_block));
+    }
     return Status::OK();
 }
 
@@ -116,50 +175,97 @@ Status SegmentWriter::append_block(const vectorized::Block* block, size_t row_po
                                    size_t num_rows) {
     assert(block && num_rows > 0 && row_pos + num_rows <= block->rows() &&
            block->columns() == _column_writers.size());
-    _olap_data_convertor.set_source_content(block, row_pos, num_rows);
+    _olap_data_convertor.set_source_content_with_specifid_columns(block, row_pos, num_rows,
+                                                                  _column_ids);
+    if (_row_store_codec != nullptr) {
+        // the row store column of the block is replaced by the rows to append encoded from the
+        // other columns, all the columns are written so the position of a column is its id
+        int32_t row_store_col_idx = _tablet_schema->row_store_col_idx();
+        vectorized::ColumnWithTypeAndName row_store_column =
+                block->get_by_position(row_store_col_idx);
+        auto rows = _row_store_codec->encode(*block, row_pos, num_rows);
+        if (row_store_column.type->is_nullable()) {
+            row_store_column.column = vectorized::ColumnNullable::create(
+                    std::move(rows), vectorized::ColumnUInt8::create(num_rows, 0));
+        } else {
+            row_store_column.column = std::move(rows);
+        }
+        _olap_data_convertor.set_source_column(row_store_col_idx, row_store_column, 0, num_rows);
+    }
 
     // find all row pos for short key indexes
     std::vector<size_t> short_key_pos;
-    // We build a short key index every `_opts.num_rows_per_block` rows. Specifically, we
-    // build a short key index using 1st rows for first block and `_short_key_row_pos - _row_count`
-    // for next blocks.
-    // Ensure we build a short key index using 1st rows only for the first block (ISSUE-9766).
-    if (UNLIKELY(_short_key_row_pos == 0 && _row_count == 0)) {
-        short_key_pos.push_back(0);
-    }
-    while (_short_key_row_pos + _opts.num_rows_per_block < _row_count + num_rows) {
-        _short_key_row_pos += _opts.num_rows_per_block;
-        short_key_pos.push_back(_short_key_row_pos - _row_count);
+    if (_has_key) {
+        // We build a short key index every `_opts.num_rows_per_block` rows. Specifically, we
+        // build a short key index using 1st rows for first block and
+        // `_short_key_row_pos - _row_count` for next blocks.
+        // Ensure we build a short key index using 1st rows only for the first block (ISSUE-9766).
+        if (UNLIKELY(_short_key_row_pos == 0 && _row_count == 0)) {
+            short_key_pos.push_back(0);
+        }
+        while (_short_key_row_pos + _opts.num_rows_per_block < _row_count + num_rows) {
+            _short_key_row_pos += _opts.num_rows_per_block;
+            short_key_pos.push_back(_short_key_row_pos - _row_count);
+        }
     }
 
     // convert column data from engine format to storage layer format
-    std::vector<vectorized::IOlapColumnDataAccessor*> short_key_columns;
-    size_t num_key_columns = _tablet_schema->num_short_key_columns();
-    for (size_t cid = 0; cid < _column_writers.size(); ++cid) {
+    std::vector<vectorized::IOlapColumnDataAccessor*> key_columns;
+    size_t num_key_columns = _tablet_schema->num_key_columns();
+    for (size_t id = 0; id < _column_writers.size(); ++id) {
+        auto cid = _column_ids[id];
         auto converted_result = _olap_data_convertor.convert_column_data(cid);
         if (converted_result.first != Status::OK()) {
             return converted_result.first;
         }
-        if (cid < num_key_columns) {
-            short_key_columns.push_back(converted_result.second);
+        if (_has_key && cid < num_key_columns) {
+            key_columns.push_back(converted_result.second);
         }
-        RETURN_IF_ERROR(_column_writers[cid]->append(converted_result.second->get_nullmap(),
-                                                     converted_result.second->get_data(),
-                                                     num_rows));
+        RETURN_IF_ERROR(_column_writers[id]->append(converted_result.second->get_nullmap(),
+                                                    converted_result.second->get_data(),
+                                                    num_rows));
     }
 
-    // create short key indexes
+    // create short key indexes, short key columns are the prefix of key columns
+    size_t num_short_key_columns = _tablet_schema->num_short_key_columns();
     std::vector<const void*> key_column_fields;
     for (const auto pos : short_key_pos) {
-        for (const auto& column : short_key_columns) {
-            key_column_fields.push_back(column->get_data_at(pos));
+        for (size_t i = 0; i < num_short_key_columns; ++i) {
+            key_column_fields.push_back(key_columns[i]->get_data_at(pos));
         }
         std::string encoded_key = encode_short_keys(key_column_fields);
         RETURN_IF_ERROR(_index_builder->add_item(encoded_key));
         key_column_fields.clear();
     }
 
-    _row_count += num_rows;
+    // record min and max keys of this segment
+    if (_has_key) {
+        if (_row_count == 0) {
+            for (const auto& column : key_columns) {
+                key_column_fields.push_back(column->get_data_at(0));
+            }
+            _min_key = full_encode_keys(key_column_fields);
+            key_column_fields.clear();
+        }
+        if (_has_key_bloom_filter) {
+            for (size_t pos = 0; pos < num_rows; ++pos) {
+                for (const auto& column : key_columns) {
+                    key_column_fields.push_back(column->get_data_at(pos));
+                }
+                _add_key_to_bloom_filter(full_encode_keys(key_column_fields));
+                key_column_fields.clear();
+            }
+        }
+        for (const auto& column : key_columns) {
+            key_column_fields.push_back(column->get_data_at(num_rows - 1));
+        }
+        _max_key = full_encode_keys(key_column_fields);
+    }
+
+    if (_has_key) {
+        _row_count += num_rows;
+    }
+    _num_rows_written += num_rows;
     _olap_data_convertor.clear_source_content();
     return Status::OK();
 }
@@ -167,7 +273,7 @@ Status SegmentWriter::append_block(const vectorized::Block* block, size_t row_po
 int64_t SegmentWriter::max_row_to_add(size_t row_avg_size_in_bytes) {
     int64_t size_rows =
             ((int64_t)MAX_SEGMENT_SIZE - (int64_t)estimate_segment_size()) / row_avg_size_in_bytes;
-    int64_t count_rows = (int64_t)_max_row_per_segment - _row_count;
+    int64_t count_rows = (int64_t)_max_row_per_segment - _num_rows_written;
 
     return std::min(size_rows, count_rows);
 }
@@ -196,6 +302,31 @@ std::string SegmentWriter::encode_short_keys(const std::vector<const void*> key_
     return encoded_keys;
 }
 
+std::string SegmentWriter::full_encode_keys(const std::vector<const void*>& key_column_fields,
+                                            bool null_first) {
+    assert(key_column_fields.size() == _key_coders.size());
+
+    std::string encoded_keys;
+    for (size_t cid = 0; cid < key_column_fields.size(); ++cid) {
+        auto field = key_column_fields[cid];
+        if (UNLIKELY(!field)) {
+            if (null_first) {
+                encoded_keys.push_back(KEY_NULL_FIRST_MARKER);
+            } else {
+                encoded_keys.push_back(KEY_NULL_LAST_MARKER);
+            }
+            continue;
+        }
+        encoded_keys.push_back(KEY_NORMAL_MARKER);
+        _key_coders[cid]->full_encode_ascending(field, &encoded_keys);
+    }
+    return encoded_keys;
+}
+
+// The row store column is not encoded here but written as it is in the row, which is the value
+// copied from the input by row based compaction, or an empty or null one by row based loads.
+// Both are fine for readers, since an empty value or one encoded from other columns is never
+// decoded and the row is read from the other columns instead.
 template <typename RowType>
 Status SegmentWriter::append_row(const RowType& row) {
     for (size_t cid = 0; cid < _column_writers.size(); ++cid) {
@@ -209,10 +340,33 @@ Status SegmentWriter::append_row(const RowType& row) {
         encode_key(&encoded_key, row, _tablet_schema->num_short_key_columns());
         RETURN_IF_ERROR(_index_builder->add_item(encoded_key));
     }
+
+    // record min and max keys of this segment
+    std::vector<const void*> key_column_fields;
+    for (size_t cid = 0; cid < _key_coders.size(); ++cid) {
+        auto cell = row.cell(cid);
+        key_column_fields.push_back(cell.is_null() ? nullptr : cell.cell_ptr());
+    }
+    _max_key = full_encode_keys(key_column_fields);
+    if (_row_count == 0) {
+        _min_key = _max_key;
+    }
+    if (_has_key_bloom_filter) {
+        _add_key_to_bloom_filter(_max_key);
+    }
+
     ++_row_count;
+    ++_num_rows_written;
     return Status::OK();
 }
 
+void SegmentWriter::_add_key_to_bloom_filter(const std::string& encoded_key) {
+    // the same hash as BloomFilter::add_bytes
+    uint64_t hash;
+    murmur_hash3_x64_64(encoded_key.data(), encoded_key.size(), BloomFilter::DEFAULT_SEED, &hash);
+    _key_hashes.push_back(hash);
+}
+
 template Status SegmentWriter::append_row(const RowCursor& row);
 template Status SegmentWriter::append_row(const ContiguousRow& row);
 
@@ -226,7 +380,9 @@ uint64_t SegmentWriter::estimate_segment_size() {
     for (auto& column_writer : _column_writers) {
         size += column_writer->estimate_buffer_size();
     }
-    size += _index_builder->size();
+    if (_index_builder != nullptr) {
+        size += _index_builder->size();
+    }
 
     // update the mem_tracker of segment size
     _mem_tracker->consume(size - _mem_tracker->consumption());
@@ -234,11 +390,24 @@ uint64_t SegmentWriter::estimate_segment_size() {
 }
 
 Status SegmentWriter::finalize(uint64_t* segment_file_size, uint64_t* index_size) {
+    uint64_t columns_index_size = 0;
+    RETURN_IF_ERROR(finalize_columns(&columns_index_size));
+    RETURN_IF_ERROR(finalize_footer(segment_file_size, index_size));
+    *index_size += columns_index_size;
+    return Status::OK();
+}
+
+Status SegmentWriter::finalize_columns(uint64_t* index_size) {
     // check disk capacity
     if (_data_dir != nullptr && _data_dir->reach_capacity_limit((int64_t)estimate_segment_size())) {
         return Status::InternalError(
                 fmt::format("disk {} exceed capacity limit.", _data_dir->path_hash()));
     }
+    if (_num_rows_written != _row_count) {
+        return Status::InternalError(
+                fmt::format("rows of column group {} is not equal to rows of segment {}",
+                            _num_rows_written, _row_count));
+    }
     for (auto& column_writer : _column_writers) {
         RETURN_IF_ERROR(column_writer->finish());
     }
@@ -248,7 +417,18 @@ Status SegmentWriter::finalize(uint64_t* segment_file_size, uint64_t* index_size
     RETURN_IF_ERROR(_write_zone_map());
     RETURN_IF_ERROR(_write_bitmap_index());
     RETURN_IF_ERROR(_write_bloom_filter_index());
+    *index_size = _wblock->bytes_appended() - index_offset;
+    _column_writers.clear();
+    return Status::OK();
+}
+
+Status SegmentWriter::finalize_footer(uint64_t* segment_file_size, uint64_t* index_size) {
+    DCHECK(_column_writers.empty());
+    uint64_t index_offset = _wblock->bytes_appended();
     RETURN_IF_ERROR(_write_short_key_index());
+    if (_has_key_bloom_filter && !_key_hashes.empty()) {
+        RETURN_IF_ERROR(_write_key_bloom_filter());
+    }
     *index_size = _wblock->bytes_appended() - index_offset;
     RETURN_IF_ERROR(_write_footer());
     RETURN_IF_ERROR(_wblock->finalize());
@@ -304,6 +484,29 @@ Status SegmentWriter::_write_short_key_index() {
     return Status::OK();
 }
 
+Status SegmentWriter::_write_key_bloom_filter() {
+    std::unique_ptr<BloomFilter> bf;
+    RETURN_IF_ERROR(BloomFilter::create(BLOCK_BLOOM_FILTER, &bf));
+    RETURN_IF_ERROR(bf->init(_key_hashes.size(), k_key_bloom_filter_fpp, HASH_MURMUR3_X64_64));
+    for (auto hash : _key_hashes) {
+        bf->add_hash(hash);
+    }
+    _key_hashes.clear();
+    _key_hashes.shrink_to_fit();
+
+    PageFooterPB footer;
+    footer.set_type(KEY_BLOOM_FILTER_PAGE);
+    footer.set_uncompressed_size(bf->size());
+    KeyBloomFilterFooterPB* bf_footer = footer.mutable_key_bloom_filter_page_footer();
+    bf_footer->set_hash_strategy(HASH_MURMUR3_X64_64);
+    bf_footer->set_algorithm(BLOCK_BLOOM_FILTER);
+    bf_footer->set_num_key_columns(_key_coders.size());
+    PagePointer pp;
+    RETURN_IF_ERROR(PageIO::write_page(_wblock, {Slice(bf->data(), bf->size())}, footer, &pp));
+    pp.to_proto(_footer.mutable_key_bloom_filter_page());
+    return Status::OK();
+}
+
 Status SegmentWriter::_write_footer() {
     _footer.set_num_rows(_row_count);
 
@@ -23,10 +23,12 @@
 #include <vector>
 
 #include "common/status.h" // Status
+#include "gen_cpp/olap_file.pb.h"
 #include "gen_cpp/segment_v2.pb.h"
 #include "gutil/macros.h"
 #include "vec/core/block.h"
 #include "vec/olap/olap_data_convertor.h"
+#include "vec/olap/row_store_codec.h"
 
 namespace doris {
 
@@ -66,6 +68,12 @@ public:
 
     Status init(uint32_t write_mbytes_per_sec);
 
+    // Init the writer to write columns in `col_ids` only. It is used by vertical compaction
+    // to write a segment column group by column group, the key group must be the first one,
+    // and short key index is built when `has_key` is true.
+    Status init(uint32_t write_mbytes_per_sec, const std::vector<uint32_t>& col_ids,
+                bool has_key);
+
     template <typename RowType>
     Status append_row(const RowType& row);
 
@@ -75,10 +83,27 @@ public:
 
     uint64_t estimate_segment_size();
 
-    uint32_t num_rows_written() { return _row_count; }
+    // rows written to the current column group
+    uint32_t num_rows_written() { return _num_rows_written; }
+    // rows of this segment, decided by the key column group
+    uint32_t row_count() const { return _row_count; }
 
     Status finalize(uint64_t* segment_file_size, uint64_t* index_size);
 
+    // write data and indexes of the current column group, and release its column writers
+    Status finalize_columns(uint64_t* index_size);
+    // write short key index and footer after all column groups are finalized
+    Status finalize_footer(uint64_t* segment_file_size, uint64_t* index_size);
+
+    uint32_t get_segment_id() const { return _segment_id; }
+
+    // min and max encoded keys of rows written to this segment, only valid when rows
+    // are written
+    void get_key_bounds(KeyBoundsPB* key_bounds) const {
+        key_bounds->set_min_key(_min_key);
+        key_bounds->set_max_key(_max_key);
+    }
+
     static void init_column_meta(ColumnMetaPB* meta, uint32_t* column_id,
                                  const TabletColumn& column, const TabletSchema* tablet_schema);
 
@@ -90,11 +115,16 @@ private:
     Status _write_bitmap_index();
     Status _write_bloom_filter_index();
     Status _write_short_key_index();
+    Status _write_key_bloom_filter();
     Status _write_footer();
     Status _write_raw_data(const std::vector<Slice>& slices);
 
     std::string encode_short_keys(const std::vector<const void*> key_column_fields,
                                   bool null_first = true);
+    // encode all key columns with full content, the result is memcmp comparable
+    std::string full_encode_keys(const std::vector<const void*>& key_column_fields,
+                                 bool null_first = true);
+    void _add_key_to_bloom_filter(const std::string& encoded_key);
 
 private:
     uint32_t _segment_id;
@@ -112,10 +142,27 @@ private:
     std::shared_ptr<MemTracker> _mem_tracker;
     uint32_t _row_count = 0;
 
+    // columns of tablet schema written by _column_writers
+    std::vector<uint32_t> _column_ids;
+    bool _has_key = true;
+    // rows written to the current column group, equals to _row_count unless
+    // the segment is written column group by column group
+    uint32_t _num_rows_written = 0;
+
     vectorized::OlapBlockDataConvertor _olap_data_convertor;
+    // encodes the row store column of the tablet in append_block(), set only if the tablet is
+    // a unique keys one storing rows and all the columns are written at once
+    std::unique_ptr<vectorized::RowStoreCodec> _row_store_codec;
     std::vector<const KeyCoder*> _short_key_coders;
     std::vector<uint16_t> _short_key_index_size;
+    std::vector<const KeyCoder*> _key_coders;
+    std::string _min_key;
+    std::string _max_key;
     size_t _short_key_row_pos = 0;
+    // whether to write a bloom filter of the full encoded keys of all rows, and the hashes of
+    // the keys added so far
+    bool _has_key_bloom_filter = false;
+    std::vector<uint64_t> _key_hashes;
 };
 
 } // namespace segment_v2
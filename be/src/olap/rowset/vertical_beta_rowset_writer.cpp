@@ -0,0 +1,158 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/vertical_beta_rowset_writer.h"
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "olap/olap_define.h"
+
+namespace doris {
+
+VerticalBetaRowsetWriter::~VerticalBetaRowsetWriter() {
+    // ensure all files are closed before the base writer removes them on abnormal exit
+    for (auto& segment_writer : _segment_writers) {
+        segment_writer.reset();
+    }
+}
+
+Status VerticalBetaRowsetWriter::add_columns(const vectorized::Block* block,
+                                             const std::vector<uint32_t>& col_ids, bool is_key,
+                                             uint32_t max_rows_per_segment) {
+    size_t num_rows = block->rows();
+    if (num_rows == 0) {
+        return Status::OK();
+    }
+    if (UNLIKELY(_segment_writers.empty())) {
+        // it must be the key column group
+        DCHECK(is_key);
+        RETURN_NOT_OK(_create_segment_writer(col_ids, is_key));
+        _cur_writer_idx = 0;
+        _need_init_writer = false;
+    }
+
+    size_t row_offset = 0;
+    if (is_key) {
+        // the key column group decides the rows of each segment
+        while (row_offset < num_rows) {
+            auto& writer = _segment_writers[_cur_writer_idx];
+            if (writer->num_rows_written() >= max_rows_per_segment ||
+                writer->estimate_segment_size() >= MAX_SEGMENT_SIZE) {
+                RETURN_NOT_OK(_flush_columns(&writer));
+                RETURN_NOT_OK(_create_segment_writer(col_ids, is_key));
+                ++_cur_writer_idx;
+                continue;
+            }
+            size_t num_rows_to_add =
+                    std::min(num_rows - row_offset,
+                             (size_t)(max_rows_per_segment - writer->num_rows_written()));
+            auto s = writer->append_block(block, row_offset, num_rows_to_add);
+            if (UNLIKELY(!s.ok())) {
+                LOG(WARNING) << "failed to append block: " << s.to_string();
+                return Status::OLAPInternalError(OLAP_ERR_WRITER_DATA_WRITE_ERROR);
+            }
+            row_offset += num_rows_to_add;
+        }
+        _num_rows_written += num_rows;
+        return Status::OK();
+    }
+
+    // value column groups fill the segments created by the key column group one by one
+    while (row_offset < num_rows) {
+        if (UNLIKELY(_cur_writer_idx >= _segment_writers.size())) {
+            LOG(WARNING) << "too many rows in value column group, rowset_id="
+                         << _context.rowset_id;
+            return Status::OLAPInternalError(OLAP_ERR_WRITER_DATA_WRITE_ERROR);
+        }
+        auto& writer = _segment_writers[_cur_writer_idx];
+        if (_need_init_writer) {
+            auto s = writer->init(config::push_write_mbytes_per_sec, col_ids, is_key);
+            if (!s.ok()) {
+                LOG(WARNING) << "failed to init segment writer: " << s.to_string();
+                return Status::OLAPInternalError(OLAP_ERR_INIT_FAILED);
+            }
+            _need_init_writer = false;
+        }
+        if (writer->num_rows_written() >= writer->row_count()) {
+            RETURN_NOT_OK(_flush_columns(&writer));
+            ++_cur_writer_idx;
+            _need_init_writer = true;
+            continue;
+        }
+        size_t num_rows_to_add =
+                std::min(num_rows - row_offset,
+                         (size_t)(writer->row_count() - writer->num_rows_written()));
+        auto s = writer->append_block(block, row_offset, num_rows_to_add);
+        if (UNLIKELY(!s.ok())) {
+            LOG(WARNING) << "failed to append block: " << s.to_string();
+            return Status::OLAPInternalError(OLAP_ERR_WRITER_DATA_WRITE_ERROR);
+        }
+        row_offset += num_rows_to_add;
+    }
+    return Status::OK();
+}
+
+Status VerticalBetaRowsetWriter::flush_columns() {
+    if (_segment_writers.empty()) {
+        return Status::OK();
+    }
+    DCHECK(_cur_writer_idx == _segment_writers.size() - 1);
+    RETURN_NOT_OK(_flush_columns(&_segment_writers[_cur_writer_idx]));
+    _cur_writer_idx = 0;
+    _need_init_writer = true;
+    return Status::OK();
+}
+
+Status VerticalBetaRowsetWriter::final_flush() {
+    for (auto& segment_writer : _segment_writers) {
+        uint64_t segment_size = 0;
+        uint64_t index_size = 0;
+        auto s = segment_writer->finalize_footer(&segment_size, &index_size);
+        if (!s.ok()) {
+            LOG(WARNING) << "failed to finalize segment: " << s.to_string();
+            return Status::OLAPInternalError(OLAP_ERR_WRITER_DATA_WRITE_ERROR);
+        }
+        _total_data_size += segment_size;
+        _total_index_size += index_size;
+        _add_segment_key_bounds(*segment_writer);
+        segment_writer.reset();
+    }
+    _segment_writers.clear();
+    return Status::OK();
+}
+
+Status VerticalBetaRowsetWriter::_flush_columns(
+        std::unique_ptr<segment_v2::SegmentWriter>* segment_writer) {
+    uint64_t index_size = 0;
+    auto s = (*segment_writer)->finalize_columns(&index_size);
+    if (!s.ok()) {
+        LOG(WARNING) << "failed to finalize columns of segment: " << s.to_string();
+        return Status::OLAPInternalError(OLAP_ERR_WRITER_DATA_WRITE_ERROR);
+    }
+    _total_index_size += index_size;
+    return Status::OK();
+}
+
+Status VerticalBetaRowsetWriter::_create_segment_writer(const std::vector<uint32_t>& column_ids,
+                                                        bool is_key) {
+    std::unique_ptr<segment_v2::SegmentWriter> writer;
+    RETURN_NOT_OK(BetaRowsetWriter::_create_segment_writer(&writer, &column_ids, is_key));
+    _segment_writers.push_back(std::move(writer));
+    return Status::OK();
+}
+
+} // namespace doris
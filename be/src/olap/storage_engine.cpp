@@ -1149,6 +1149,31 @@ void StorageEngine::create_base_compaction(TabletSharedPtr best_tablet,
     base_compaction.reset(new BaseCompaction(best_tablet));
 }
 
+void StorageEngine::_add_compaction_candidates_json(
+        const std::string& name, const std::map<DataDir*, CompactionCandidate>& candidates,
+        rapidjson::Document* root) {
+    rapidjson::Document::AllocatorType& allocator = root->GetAllocator();
+    rapidjson::Value path_obj(rapidjson::kObjectType);
+    for (auto& it : candidates) {
+        const std::string& dir = it.first->path();
+        const CompactionCandidate& candidate = it.second;
+        rapidjson::Value path_key;
+        path_key.SetString(dir.c_str(), dir.length(), allocator);
+
+        rapidjson::Value candidate_obj(rapidjson::kObjectType);
+        candidate_obj.AddMember("tablet_id", candidate.tablet_id, allocator);
+        candidate_obj.AddMember("compaction_score", candidate.compaction_score, allocator);
+        candidate_obj.AddMember("scan_frequency", candidate.scan_frequency, allocator);
+        candidate_obj.AddMember("read_amplification", candidate.read_amplification, allocator);
+        candidate_obj.AddMember("tablet_score", candidate.tablet_score, allocator);
+        candidate_obj.AddMember("pick_time_ms", candidate.pick_time_ms, allocator);
+        path_obj.AddMember(path_key, candidate_obj, allocator);
+    }
+    rapidjson::Value key;
+    key.SetString(name.c_str(), name.length(), allocator);
+    root->AddMember(key, path_obj, allocator);
+}
+
 // Return json:
 // {
 //   "CumulativeCompaction": {
@@ -1158,6 +1183,26 @@ void StorageEngine::create_base_compaction(TabletSharedPtr best_tablet,
 //   "BaseCompaction": {
 //          "/home/disk1" : [10001, 10002],
 //          "/home/disk2" : [10003]
+//   },
+//   "CumulativeCompactionCandidates": {
+//          "/home/disk1" : {
+//              "tablet_id": 10001,
+//              "compaction_score": 12,
+//              "scan_frequency": 30.0,
+//              "read_amplification": 6.0,
+//              "tablet_score": 42.0,
+//              "pick_time_ms": 1666080000000
+//          }
+//   },
+//   "BaseCompactionCandidates": {
+//          "/home/disk2" : {
+//              "tablet_id": 10003,
+//              "compaction_score": 5,
+//              "scan_frequency": 0.0,
+//              "read_amplification": 5.0,
+//              "tablet_score": 5.0,
+//              "pick_time_ms": 1666080000000
+//          }
 //   }
 // }
 Status StorageEngine::get_compaction_status_json(std::string* result) {
@@ -1214,6 +1259,12 @@ Status StorageEngine::get_compaction_status_json(std::string* result) {
     }
     root.AddMember(base_key, path_obj2, root.GetAllocator());
 
+    // last picked candidates with their score breakdown
+    _add_compaction_candidates_json("CumulativeCompactionCandidates",
+                                    _last_cumu_compaction_candidates, &root);
+    _add_compaction_candidates_json("BaseCompactionCandidates", _last_base_compaction_candidates,
+                                    &root);
+
     rapidjson::StringBuffer strbuf;
     rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(strbuf);
     root.Accept(writer);
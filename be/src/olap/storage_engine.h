@@ -253,6 +253,11 @@ private:
 
     void _compaction_tasks_producer_callback();
 
+    // caller should hold _tablet_submitted_compaction_mutex
+    void _add_compaction_candidates_json(
+            const std::string& name, const std::map<DataDir*, CompactionCandidate>& candidates,
+            rapidjson::Document* root);
+
     void _alpha_rowset_scan_thread_callback();
 
     std::vector<TabletSharedPtr> _generate_compaction_tasks(CompactionType compaction_type,
@@ -390,6 +395,10 @@ private:
     // a tablet can do base and cumulative compaction at same time
     std::map<DataDir*, std::unordered_set<TTabletId>> _tablet_submitted_cumu_compaction;
     std::map<DataDir*, std::unordered_set<TTabletId>> _tablet_submitted_base_compaction;
+    // the tablet with the highest score picked on each data dir by the last round of
+    // compaction producer, also protected by _tablet_submitted_compaction_mutex
+    std::map<DataDir*, CompactionCandidate> _last_cumu_compaction_candidates;
+    std::map<DataDir*, CompactionCandidate> _last_base_compaction_candidates;
 
     std::atomic<int32_t> _wakeup_producer_flag {0};
 
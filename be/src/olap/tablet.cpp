@@ -77,6 +77,10 @@ Tablet::Tablet(TabletMetaSharedPtr tablet_meta, const StorageParamPB& storage_pa
           _cumulative_compaction_type(cumulative_compaction_type),
           _last_record_scan_count(0),
           _last_record_scan_count_timestamp(time(nullptr)),
+          _last_record_scan_segments(0),
+          _last_record_scan_rows(0),
+          _last_record_merged_rows(0),
+          _last_record_read_amplification_timestamp(time(nullptr)),
           _is_clone_occurred(false) {
     // construct _timestamped_versioned_tracker from rs and stale rs meta
     _timestamped_version_tracker.construct_versioned_tracker(_tablet_meta->all_rs_metas(),
@@ -192,6 +196,7 @@ Status Tablet::revise_tablet_meta(const std::vector<RowsetMetaSharedPtr>& rowset
         }
         _rs_version_map[version] = std::move(rowset);
     }
+    _clear_captured_rowsets();
 
     // reconstruct from tablet meta
     _timestamped_version_tracker.construct_versioned_tracker(_tablet_meta->all_rs_metas());
@@ -221,6 +226,7 @@ Status Tablet::add_rowset(RowsetSharedPtr rowset) {
     RETURN_NOT_OK(_tablet_meta->add_rs_meta(rowset->rowset_meta()));
     _rs_version_map[rowset->version()] = rowset;
     _timestamped_version_tracker.add_version(rowset->version());
+    _clear_captured_rowsets();
 
     std::vector<RowsetSharedPtr> rowsets_to_delete;
     // yiguolei: temp code, should remove the rowset contains by this rowset
@@ -309,6 +315,7 @@ Status Tablet::modify_rowsets(std::vector<RowsetSharedPtr>& to_add,
     }
 
     _tablet_meta->modify_rs_metas(rs_metas_to_add, rs_metas_to_delete, same_version);
+    _clear_captured_rowsets();
 
     if (!same_version) {
         // add rs_metas_to_delete to tracker
@@ -389,6 +396,7 @@ Status Tablet::add_inc_rowset(const RowsetSharedPtr& rowset) {
     _rs_version_map[rowset->version()] = rowset;
 
     _timestamped_version_tracker.add_version(rowset->version());
+    _clear_captured_rowsets();
 
     ++_newly_created_rowset_num;
     return Status::OK();
@@ -510,6 +518,8 @@ void Tablet::delete_expired_stale_rowset() {
 
     auto old_size = _stale_rs_version_map.size();
     auto old_meta_size = _tablet_meta->all_stale_rs_metas().size();
+    // the captured rowsets may hold the stale rowsets to delete
+    _clear_captured_rowsets();
 
     // do delete operation
     auto to_delete_iter = stale_version_path_map.begin();
@@ -612,12 +622,58 @@ void Tablet::acquire_version_and_rowsets(
 
 Status Tablet::capture_consistent_rowsets(const Version& spec_version,
                                           std::vector<RowsetSharedPtr>* rowsets) const {
+    std::shared_ptr<const CapturedRowsets> captured;
+    RETURN_NOT_OK(_capture_consistent_rowsets_cached(spec_version, &captured));
+    DCHECK(rowsets != nullptr && rowsets->empty());
+    *rowsets = captured->rowsets;
+    return Status::OK();
+}
+
+Status Tablet::_capture_consistent_rowsets_cached(const Version& spec_version,
+                                                  std::shared_ptr<const CapturedRowsets>* captured,
+                                                  bool header_locked) const {
+    // the queries reading the latest version of a hot tablet all capture the same rowsets,
+    // they share them without searching the version graph again. The rowsets are cleared
+    // under the header lock before they change, so a hit needs no header lock.
+    std::shared_ptr<const CapturedRowsets> cached = std::atomic_load(&_captured_rowsets);
+    if (cached != nullptr && cached->spec_version == spec_version) {
+        *captured = std::move(cached);
+        return Status::OK();
+    }
+
+    std::shared_lock<std::shared_mutex> rdlock(_meta_lock, std::defer_lock);
+    if (!header_locked) {
+        rdlock.lock();
+    }
+    int64_t generation;
+    {
+        std::lock_guard<std::mutex> l(_captured_rowsets_lock);
+        generation = _captured_rowsets_generation;
+    }
+    auto new_captured = std::make_shared<CapturedRowsets>();
+    new_captured->spec_version = spec_version;
     std::vector<Version> version_path;
     RETURN_NOT_OK(capture_consistent_versions(spec_version, &version_path));
-    RETURN_NOT_OK(_capture_consistent_rowsets_unlocked(version_path, rowsets));
+    RETURN_NOT_OK(_capture_consistent_rowsets_unlocked(version_path, &new_captured->rowsets));
+    {
+        // the rowsets of the tablet may have changed since the versions were captured,
+        // the capture is not cached then
+        std::lock_guard<std::mutex> l(_captured_rowsets_lock);
+        if (generation == _captured_rowsets_generation) {
+            std::atomic_store(&_captured_rowsets,
+                              std::shared_ptr<const CapturedRowsets>(new_captured));
+        }
+    }
+    *captured = std::move(new_captured);
     return Status::OK();
 }
 
+void Tablet::_clear_captured_rowsets() {
+    std::lock_guard<std::mutex> l(_captured_rowsets_lock);
+    ++_captured_rowsets_generation;
+    std::atomic_store(&_captured_rowsets, std::shared_ptr<const CapturedRowsets>());
+}
+
 Status Tablet::_capture_consistent_rowsets_unlocked(const std::vector<Version>& version_path,
                                                     std::vector<RowsetSharedPtr>* rowsets) const {
     DCHECK(rowsets != nullptr && rowsets->empty());
@@ -650,10 +706,25 @@ Status Tablet::_capture_consistent_rowsets_unlocked(const std::vector<Version>&
 }
 
 Status Tablet::capture_rs_readers(const Version& spec_version,
-                                  std::vector<RowsetReaderSharedPtr>* rs_readers) const {
-    std::vector<Version> version_path;
-    RETURN_NOT_OK(capture_consistent_versions(spec_version, &version_path));
-    RETURN_NOT_OK(capture_rs_readers(version_path, rs_readers));
+                                  std::vector<RowsetReaderSharedPtr>* rs_readers,
+                                  bool header_locked) const {
+    DCHECK(rs_readers != nullptr && rs_readers->empty());
+    std::shared_ptr<const CapturedRowsets> captured;
+    Status status = _capture_consistent_rowsets_cached(spec_version, &captured, header_locked);
+    if (status.precise_code() == OLAP_ERR_CAPTURE_ROWSET_ERROR) {
+        return Status::OLAPInternalError(OLAP_ERR_CAPTURE_ROWSET_READER_ERROR);
+    }
+    RETURN_NOT_OK(status);
+    rs_readers->reserve(captured->rowsets.size());
+    for (const auto& rowset : captured->rowsets) {
+        RowsetReaderSharedPtr rs_reader;
+        auto res = rowset->create_reader(&rs_reader);
+        if (!res.ok()) {
+            LOG(WARNING) << "failed to create reader for rowset:" << rowset->rowset_id();
+            return Status::OLAPInternalError(OLAP_ERR_CAPTURE_ROWSET_READER_ERROR);
+        }
+        rs_readers->push_back(std::move(rs_reader));
+    }
     return Status::OK();
 }
 
@@ -947,6 +1018,7 @@ void Tablet::delete_all_files() {
         it.second->remove();
     }
     _rs_version_map.clear();
+    _clear_captured_rowsets();
 
     for (auto it : _stale_rs_version_map) {
         it.second->remove();
@@ -1279,6 +1351,16 @@ bool Tablet::_contains_rowset(const RowsetId rowset_id) {
 
 void Tablet::build_tablet_report_info(TTabletInfo* tablet_info) {
     std::shared_lock rdlock(_meta_lock);
+    // the stamp is taken before the info is built, so a change made meanwhile is never missed
+    int64_t report_stamp = _tablet_meta->report_stamp();
+    {
+        std::lock_guard<std::mutex> l(_report_info_lock);
+        if (_report_info_stamp == report_stamp) {
+            *tablet_info = _report_info;
+            return;
+        }
+    }
+
     tablet_info->tablet_id = _tablet_meta->tablet_id();
     tablet_info->schema_hash = _tablet_meta->schema_hash();
     tablet_info->row_count = _tablet_meta->num_rows();
@@ -1324,6 +1406,10 @@ void Tablet::build_tablet_report_info(TTabletInfo* tablet_info) {
     tablet_info->__set_version_count(_tablet_meta->version_count());
     tablet_info->__set_path_hash(_data_dir->path_hash());
     tablet_info->__set_is_in_memory(_tablet_meta->tablet_schema().is_in_memory());
+
+    std::lock_guard<std::mutex> l(_report_info_lock);
+    _report_info_stamp = report_stamp;
+    _report_info = *tablet_info;
 }
 
 // should use this method to get a copy of current tablet meta
@@ -1355,6 +1441,30 @@ double Tablet::calculate_scan_frequency() {
     return scan_frequency;
 }
 
+double Tablet::calculate_read_amplification() {
+    time_t now = time(nullptr);
+    int64_t current_segments = query_scan_segments->value();
+    int64_t current_rows = query_scan_rows->value();
+    int64_t current_merged_rows = query_merged_rows->value();
+    double interval = difftime(now, _last_record_read_amplification_timestamp);
+    double read_amplification = 0.0;
+    if (interval > 0) {
+        int64_t scan_rows = current_rows - _last_record_scan_rows;
+        int64_t merged_rows = current_merged_rows - _last_record_merged_rows;
+        double merged_ratio =
+                scan_rows > 0 ? static_cast<double>(merged_rows) / scan_rows : 0.0;
+        read_amplification = (current_segments - _last_record_scan_segments) *
+                             (1 + merged_ratio) * 60 / interval;
+    }
+    if (interval >= config::tablet_scan_frequency_time_node_interval_second) {
+        _last_record_scan_segments = current_segments;
+        _last_record_scan_rows = current_rows;
+        _last_record_merged_rows = current_merged_rows;
+        _last_record_read_amplification_timestamp = now;
+    }
+    return read_amplification;
+}
+
 Status Tablet::prepare_compaction_and_calculate_permits(CompactionType compaction_type,
                                                         TabletSharedPtr tablet, int64_t* permits) {
     std::vector<RowsetSharedPtr> compaction_rowsets;
@@ -1524,11 +1634,13 @@ Status Tablet::create_initial_rowset(const int64_t req_version) {
 
 Status Tablet::create_rowset_writer(const Version& version, const RowsetStatePB& rowset_state,
                                     const SegmentsOverlapPB& overlap,
-                                    std::unique_ptr<RowsetWriter>* rowset_writer) {
+                                    std::unique_ptr<RowsetWriter>* rowset_writer,
+                                    bool is_vertical) {
     RowsetWriterContext context;
     context.version = version;
     context.rowset_state = rowset_state;
     context.segments_overlap = overlap;
+    context.is_vertical = is_vertical;
     _init_context_common_fields(context);
     return RowsetFactory::create_rowset_writer(context, rowset_writer);
 }
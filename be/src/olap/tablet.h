@@ -131,8 +131,11 @@ public:
 
     Status capture_consistent_rowsets(const Version& spec_version,
                                       std::vector<RowsetSharedPtr>* rowsets) const;
+    // If header_locked is false, the caller does not hold the header lock, it is only taken
+    // when the rowsets of spec_version are not captured yet.
     Status capture_rs_readers(const Version& spec_version,
-                              std::vector<RowsetReaderSharedPtr>* rs_readers) const;
+                              std::vector<RowsetReaderSharedPtr>* rs_readers,
+                              bool header_locked = true) const;
 
     Status capture_rs_readers(const std::vector<Version>& version_path,
                               std::vector<RowsetReaderSharedPtr>* rs_readers) const;
@@ -235,6 +238,9 @@ public:
     void get_compaction_status(std::string* json_result);
 
     double calculate_scan_frequency();
+    // Segments opened by queries per minute, scaled by the ratio of scanned rows
+    // merged away by the collect iterator, since the last record.
+    double calculate_read_amplification();
 
     Status prepare_compaction_and_calculate_permits(CompactionType compaction_type,
                                                     TabletSharedPtr tablet, int64_t* permits);
@@ -264,7 +270,8 @@ public:
 
     Status create_rowset_writer(const Version& version, const RowsetStatePB& rowset_state,
                                 const SegmentsOverlapPB& overlap,
-                                std::unique_ptr<RowsetWriter>* rowset_writer);
+                                std::unique_ptr<RowsetWriter>* rowset_writer,
+                                bool is_vertical = false);
 
     Status create_rowset_writer(const int64_t& txn_id, const PUniqueId& load_id,
                                 const RowsetStatePB& rowset_state, const SegmentsOverlapPB& overlap,
@@ -290,6 +297,21 @@ private:
     Status _capture_consistent_rowsets_unlocked(const std::vector<Version>& version_path,
                                                 std::vector<RowsetSharedPtr>* rowsets) const;
 
+    // the rowsets captured for a version, shared by the queries reading the same version
+    struct CapturedRowsets {
+        Version spec_version;
+        std::vector<RowsetSharedPtr> rowsets;
+    };
+    // capture the rowsets of spec_version, reuse the last captured rowsets if they are of the
+    // same version. If header_locked is false, the header lock is taken to capture them when
+    // they are not cached, a cache hit does not need it.
+    Status _capture_consistent_rowsets_cached(const Version& spec_version,
+                                              std::shared_ptr<const CapturedRowsets>* captured,
+                                              bool header_locked = true) const;
+    // called whenever the rowsets of the tablet change, so the captured rowsets are never stale
+    // and do not keep the deleted rowsets from being gc
+    void _clear_captured_rowsets();
+
     const uint32_t _calc_cumulative_compaction_score(
             std::shared_ptr<CumulativeCompactionPolicy> cumulative_compaction_policy);
     const uint32_t _calc_base_compaction_score() const;
@@ -318,6 +340,16 @@ private:
     // TODO(lingbin): There is a _meta_lock TabletMeta too, there should be a comment to
     // explain how these two locks work together.
     mutable std::shared_mutex _meta_lock;
+    // the info built by the last build_tablet_report_info() and the report stamp of the meta it
+    // was built from, it is reused as long as the stamp does not change
+    std::mutex _report_info_lock;
+    int64_t _report_info_stamp = -1;
+    TTabletInfo _report_info;
+    // the rowsets captured by the last query, read lock free with std::atomic_load. The
+    // generation is increased by every clear to drop the captures started before it.
+    mutable std::mutex _captured_rowsets_lock;
+    mutable int64_t _captured_rowsets_generation = 0;
+    mutable std::shared_ptr<const CapturedRowsets> _captured_rowsets;
     // After version 0.13, all newly created rowsets are saved in _rs_version_map.
     // And if rowset being compacted, the old rowsetis will be saved in _stale_rs_version_map;
     std::unordered_map<Version, RowsetSharedPtr, HashOfVersion> _rs_version_map;
@@ -351,6 +383,12 @@ private:
     int64_t _last_record_scan_count;
     // the timestamp of the last record.
     time_t _last_record_scan_count_timestamp;
+    // the values of metrics 'query_scan_segments', 'query_scan_rows' and 'query_merged_rows'
+    // recorded in the same way to calculate tablet read amplification.
+    int64_t _last_record_scan_segments;
+    int64_t _last_record_scan_rows;
+    int64_t _last_record_merged_rows;
+    time_t _last_record_read_amplification_timestamp;
 
     std::shared_ptr<CumulativeCompaction> _cumulative_compaction;
     std::shared_ptr<BaseCompaction> _base_compaction;
@@ -368,6 +368,7 @@ TabletSharedPtr TabletManager::_internal_create_tablet_unlocked(
     }
     // something is wrong, we need clear environment
     if (is_tablet_added) {
+        _self_dropped_tablet_count++;
         Status status = _drop_tablet_unlocked(new_tablet_id, false);
         if (!status.ok()) {
             LOG(WARNING) << "fail to drop tablet when create tablet failed. res=" << res;
@@ -446,9 +447,12 @@ TabletSharedPtr TabletManager::_create_tablet_meta_and_dir_unlocked(
     return nullptr;
 }
 
-Status TabletManager::drop_tablet(TTabletId tablet_id, bool keep_files) {
+Status TabletManager::drop_tablet(TTabletId tablet_id, bool keep_files, bool by_master) {
     std::lock_guard<std::shared_mutex> wrlock(_get_tablets_shard_lock(tablet_id));
     SCOPED_SWITCH_THREAD_LOCAL_MEM_TRACKER(_mem_tracker);
+    if (!by_master) {
+        _self_dropped_tablet_count++;
+    }
     return _drop_tablet_unlocked(tablet_id, keep_files);
 }
 
@@ -504,6 +508,7 @@ Status TabletManager::drop_tablets_on_error_root_path(
                 _remove_tablet_from_partition(dropped_tablet);
                 tablet_map_t& tablet_map = _get_tablet_map(tablet_id);
                 tablet_map.erase(tablet_id);
+                _self_dropped_tablet_count++;
             }
         }
     }
@@ -618,13 +623,15 @@ void TabletManager::find_tablet_have_alpha_rowset(std::vector<TabletSharedPtr>&
 TabletSharedPtr TabletManager::find_best_tablet_to_compaction(
         CompactionType compaction_type, DataDir* data_dir,
         const std::unordered_set<TTabletId>& tablet_submitted_compaction, uint32_t* score,
-        std::shared_ptr<CumulativeCompactionPolicy> cumulative_compaction_policy) {
+        std::shared_ptr<CumulativeCompactionPolicy> cumulative_compaction_policy,
+        CompactionCandidate* candidate) {
     int64_t now_ms = UnixMillis();
     const string& compaction_type_str =
             compaction_type == CompactionType::BASE_COMPACTION ? "base" : "cumulative";
     double highest_score = 0.0;
     uint32_t compaction_score = 0;
     double tablet_scan_frequency = 0.0;
+    double tablet_read_amplification = 0.0;
     TabletSharedPtr best_tablet;
     for (const auto& tablets_shard : _tablets_shards) {
         std::shared_lock rdlock(tablets_shard.lock);
@@ -675,13 +682,20 @@ TabletSharedPtr TabletManager::find_best_tablet_to_compaction(
                 scan_frequency = tablet_ptr->calculate_scan_frequency();
             }
 
+            double read_amplification = 0.0;
+            if (config::compaction_tablet_read_amplification_factor != 0) {
+                read_amplification = tablet_ptr->calculate_read_amplification();
+            }
+
             double tablet_score =
                     config::compaction_tablet_scan_frequency_factor * scan_frequency +
-                    config::compaction_tablet_compaction_score_factor * current_compaction_score;
+                    config::compaction_tablet_compaction_score_factor * current_compaction_score +
+                    config::compaction_tablet_read_amplification_factor * read_amplification;
             if (tablet_score > highest_score) {
                 highest_score = tablet_score;
                 compaction_score = current_compaction_score;
                 tablet_scan_frequency = scan_frequency;
+                tablet_read_amplification = read_amplification;
                 best_tablet = tablet_ptr;
             }
         }
@@ -693,8 +707,17 @@ TabletSharedPtr TabletManager::find_best_tablet_to_compaction(
                       << ", tablet_id=" << best_tablet->tablet_id() << ", path=" << data_dir->path()
                       << ", compaction_score=" << compaction_score
                       << ", tablet_scan_frequency=" << tablet_scan_frequency
+                      << ", tablet_read_amplification=" << tablet_read_amplification
                       << ", highest_score=" << highest_score;
         *score = compaction_score;
+        if (candidate != nullptr) {
+            candidate->tablet_id = best_tablet->tablet_id();
+            candidate->compaction_score = compaction_score;
+            candidate->scan_frequency = tablet_scan_frequency;
+            candidate->read_amplification = tablet_read_amplification;
+            candidate->tablet_score = highest_score;
+            candidate->pick_time_ms = now_ms;
+        }
     }
     return best_tablet;
 }
@@ -848,9 +871,10 @@ Status TabletManager::report_tablet_info(TTabletInfo* tablet_info) {
     return res;
 }
 
-Status TabletManager::build_all_report_tablets_info(std::map<TTabletId, TTablet>* tablets_info) {
+Status TabletManager::build_all_report_tablets_info(std::map<TTabletId, TTablet>* tablets_info,
+                                                    int64_t changed_since) {
     DCHECK(tablets_info != nullptr);
-    LOG(INFO) << "begin to build all report tablets info";
+    LOG(INFO) << "begin to build all report tablets info. changed_since=" << changed_since;
 
     // build the expired txn map first, outside the tablet map lock
     std::map<TabletInfo, std::vector<int64_t>> expire_txn_map;
@@ -859,32 +883,43 @@ Status TabletManager::build_all_report_tablets_info(std::map<TTabletId, TTablet>
 
     DorisMetrics::instance()->report_all_tablets_requests_total->increment(1);
     HistogramStat tablet_version_num_hist;
-    auto local_cache = std::make_shared<std::vector<TTabletStat>>();
+    // the tablets are only collected under the shard locks, the report info is built outside
+    // of them, so that tablets can be added and dropped meanwhile
+    std::vector<TabletSharedPtr> tablets;
     for (const auto& tablets_shard : _tablets_shards) {
         std::shared_lock rdlock(tablets_shard.lock);
         for (const auto& item : tablets_shard.tablet_map) {
-            uint64_t tablet_id = item.first;
-            TabletSharedPtr tablet_ptr = item.second;
-            TTablet t_tablet;
-            TTabletInfo tablet_info;
-            tablet_ptr->build_tablet_report_info(&tablet_info);
-            // find expired transaction corresponding to this tablet
-            TabletInfo tinfo(tablet_id, tablet_ptr->schema_hash(), tablet_ptr->tablet_uid());
-            auto find = expire_txn_map.find(tinfo);
-            if (find != expire_txn_map.end()) {
-                tablet_info.__set_transaction_ids(find->second);
-                expire_txn_map.erase(find);
-            }
+            tablets.push_back(item.second);
+        }
+    }
+
+    auto local_cache = std::make_shared<std::vector<TTabletStat>>();
+    local_cache->reserve(tablets.size());
+    for (const auto& tablet_ptr : tablets) {
+        uint64_t tablet_id = tablet_ptr->tablet_id();
+        TTablet t_tablet;
+        TTabletInfo tablet_info;
+        // only a tablet changed since its last report builds its info again
+        tablet_ptr->build_tablet_report_info(&tablet_info);
+        // find expired transaction corresponding to this tablet
+        TabletInfo tinfo(tablet_id, tablet_ptr->schema_hash(), tablet_ptr->tablet_uid());
+        auto find = expire_txn_map.find(tinfo);
+        bool has_expired_txn = find != expire_txn_map.end();
+        if (has_expired_txn) {
+            tablet_info.__set_transaction_ids(find->second);
+            expire_txn_map.erase(find);
+        }
+        tablet_version_num_hist.add(tablet_ptr->version_count());
+        if (has_expired_txn || tablet_ptr->tablet_meta()->report_stamp() > changed_since) {
             t_tablet.tablet_infos.push_back(tablet_info);
-            tablet_version_num_hist.add(tablet_ptr->version_count());
             tablets_info->emplace(tablet_id, t_tablet);
-            TTabletStat t_tablet_stat;
-            t_tablet_stat.__set_tablet_id(tablet_info.tablet_id);
-            t_tablet_stat.__set_data_size(tablet_info.data_size);
-            t_tablet_stat.__set_row_num(tablet_info.row_count);
-            t_tablet_stat.__set_version_count(tablet_info.version_count);
-            local_cache->emplace_back(std::move(t_tablet_stat));
         }
+        TTabletStat t_tablet_stat;
+        t_tablet_stat.__set_tablet_id(tablet_info.tablet_id);
+        t_tablet_stat.__set_data_size(tablet_info.data_size);
+        t_tablet_stat.__set_row_num(tablet_info.row_count);
+        t_tablet_stat.__set_version_count(tablet_info.version_count);
+        local_cache->emplace_back(std::move(t_tablet_stat));
     }
     {
         std::lock_guard<std::mutex> guard(_tablet_stat_cache_mutex);
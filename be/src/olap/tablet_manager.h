@@ -42,6 +42,17 @@ namespace doris {
 class Tablet;
 class DataDir;
 
+// Score breakdown of the tablet picked by find_best_tablet_to_compaction(),
+// kept by storage engine to show the compaction scheduler status.
+struct CompactionCandidate {
+    TTabletId tablet_id = 0;
+    uint32_t compaction_score = 0;
+    double scan_frequency = 0.0;
+    double read_amplification = 0.0;
+    double tablet_score = 0.0;
+    int64_t pick_time_ms = 0;
+};
+
 // TabletManager provides get, add, delete tablet method for storage engine
 // NOTE: If you want to add a method that needs to hold meta-lock before you can call it,
 // please uniformly name the method in "xxx_unlocked()" mode
@@ -66,14 +77,21 @@ public:
     // Return OLAP_SUCCESS, if run ok
     //        OLAP_ERR_TABLE_DELETE_NOEXIST_ERROR, if tablet not exist
     //        Status::OLAPInternalError(OLAP_ERR_NOT_INITED), if not inited
-    Status drop_tablet(TTabletId tablet_id, bool keep_files = false);
+    // Set by_master == false when BE drops the tablet on its own, see self_dropped_tablet_count().
+    Status drop_tablet(TTabletId tablet_id, bool keep_files = false, bool by_master = true);
 
     Status drop_tablets_on_error_root_path(const std::vector<TabletInfo>& tablet_info_vec);
 
+    // The number of tablets BE dropped on its own, e.g. the tablets on a broken disk. An
+    // incremental tablet report cannot tell master these tablets are gone, so the report
+    // thread sends a full report whenever this number changes.
+    int64_t self_dropped_tablet_count() const { return _self_dropped_tablet_count.load(); }
+
     TabletSharedPtr find_best_tablet_to_compaction(
             CompactionType compaction_type, DataDir* data_dir,
             const std::unordered_set<TTabletId>& tablet_submitted_compaction, uint32_t* score,
-            std::shared_ptr<CumulativeCompactionPolicy> cumulative_compaction_policy);
+            std::shared_ptr<CumulativeCompactionPolicy> cumulative_compaction_policy,
+            CompactionCandidate* candidate = nullptr);
 
     TabletSharedPtr get_tablet(TTabletId tablet_id, bool include_deleted = false,
                                std::string* err = nullptr);
@@ -115,7 +133,11 @@ public:
     //        Status::OLAPInternalError(OLAP_ERR_INPUT_PARAMETER_ERROR), if tables is null
     Status report_tablet_info(TTabletInfo* tablet_info);
 
-    Status build_all_report_tablets_info(std::map<TTabletId, TTablet>* tablets_info);
+    // Only the tablets whose report stamp is larger than changed_since are put into
+    // tablets_info, together with the tablets that have expired transactions to clear.
+    // The default 0 puts all tablets, see TabletMeta::current_report_stamp().
+    Status build_all_report_tablets_info(std::map<TTabletId, TTablet>* tablets_info,
+                                         int64_t changed_since = 0);
 
     Status start_trash_sweep();
 
@@ -219,6 +241,8 @@ private:
     std::map<int64_t, std::set<TabletInfo>> _partition_tablet_map;
     std::vector<TabletSharedPtr> _shutdown_tablets;
 
+    std::atomic<int64_t> _self_dropped_tablet_count {0};
+
     std::mutex _tablet_stat_cache_mutex;
     std::shared_ptr<std::vector<TTabletStat>> _tablet_stat_list_cache =
             std::make_shared<std::vector<TTabletStat>>();
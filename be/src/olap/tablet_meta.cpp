@@ -172,6 +172,10 @@ TabletMeta::TabletMeta(int64_t table_id, int64_t partition_id, int64_t tablet_id
         schema->set_delete_sign_idx(tablet_schema.delete_sign_idx);
     }
 
+    if (tablet_schema.__isset.row_store_col_idx) {
+        schema->set_row_store_col_idx(tablet_schema.row_store_col_idx);
+    }
+
     init_from_pb(tablet_meta_pb);
 }
 
@@ -370,6 +374,7 @@ Status TabletMeta::deserialize(const string& meta_binary) {
 }
 
 void TabletMeta::init_from_pb(const TabletMetaPB& tablet_meta_pb) {
+    _update_report_stamp();
     _table_id = tablet_meta_pb.table_id();
     _partition_id = tablet_meta_pb.partition_id();
     _tablet_id = tablet_meta_pb.tablet_id();
@@ -521,6 +526,7 @@ Status TabletMeta::add_rs_meta(const RowsetMetaSharedPtr& rs_meta) {
         }
     }
 
+    _update_report_stamp();
     _rs_metas.push_back(rs_meta);
     if (rs_meta->has_delete_predicate()) {
         add_delete_predicate(rs_meta->delete_predicate(), rs_meta->version().first);
@@ -537,6 +543,7 @@ void TabletMeta::delete_rs_meta_by_version(const Version& version,
             if (deleted_rs_metas != nullptr) {
                 deleted_rs_metas->push_back(*it);
             }
+            _update_report_stamp();
             _rs_metas.erase(it);
             return;
         } else {
@@ -548,6 +555,7 @@ void TabletMeta::delete_rs_meta_by_version(const Version& version,
 void TabletMeta::modify_rs_metas(const std::vector<RowsetMetaSharedPtr>& to_add,
                                  const std::vector<RowsetMetaSharedPtr>& to_delete,
                                  bool same_version) {
+    _update_report_stamp();
     // Remove to_delete rowsets from _rs_metas
     for (auto rs_to_del : to_delete) {
         auto it = _rs_metas.begin();
@@ -578,6 +586,7 @@ void TabletMeta::modify_rs_metas(const std::vector<RowsetMetaSharedPtr>& to_add,
 // is needed.
 void TabletMeta::revise_rs_metas(std::vector<RowsetMetaSharedPtr>&& rs_metas) {
     std::lock_guard<std::shared_mutex> wrlock(_meta_lock);
+    _update_report_stamp();
     _rs_metas = std::move(rs_metas);
     _stale_rs_metas.clear();
 }
@@ -668,11 +677,25 @@ std::string TabletMeta::full_name() const {
     return ss.str();
 }
 
+static std::atomic<int64_t>& report_stamp_counter() {
+    static std::atomic<int64_t> s_report_stamp {0};
+    return s_report_stamp;
+}
+
+int64_t TabletMeta::_next_report_stamp() {
+    return ++report_stamp_counter();
+}
+
+int64_t TabletMeta::current_report_stamp() {
+    return report_stamp_counter().load();
+}
+
 Status TabletMeta::set_partition_id(int64_t partition_id) {
     if ((_partition_id > 0 && _partition_id != partition_id) || partition_id < 1) {
         LOG(FATAL) << "cur partition id=" << _partition_id << " new partition id=" << partition_id
                    << " not equal";
     }
+    _update_report_stamp();
     _partition_id = partition_id;
     return Status::OK();
 }
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
@@ -172,12 +173,22 @@ public:
 
     bool all_beta() const;
 
+    // changes whenever something the tablet reports to FE may have changed, such as the rowsets,
+    // the state or the schema. Stamps are unique among all tablet metas, so the same stamp
+    // means the report info is the same, even if the meta of a tablet is replaced.
+    int64_t report_stamp() const { return _report_stamp.load(); }
+    // the largest report stamp handed out so far, a meta changed after this call always has a
+    // larger report stamp
+    static int64_t current_report_stamp();
+
     std::string remote_storage_name() const { return _remote_storage_name; }
 
     StorageMediumPB storage_medium() const { return _storage_medium; }
 
 private:
     Status _save_meta(DataDir* data_dir);
+    static int64_t _next_report_stamp();
+    void _update_report_stamp() { _report_stamp = _next_report_stamp(); }
     void _init_column_from_tcolumn(uint32_t unique_id, const TColumn& tcolumn, ColumnPB* column);
 
     // _del_pred_array is ignored to compare.
@@ -213,6 +224,8 @@ private:
     StorageMediumPB _storage_medium;
 
     std::shared_mutex _meta_lock;
+    // see report_stamp()
+    std::atomic<int64_t> _report_stamp {_next_report_stamp()};
 };
 
 static const std::string SEQUENCE_COL = "__DORIS_SEQUENCE_COL__";
@@ -287,6 +300,7 @@ inline TabletState TabletMeta::tablet_state() const {
 
 inline void TabletMeta::set_tablet_state(TabletState state) {
     _tablet_state = state;
+    _update_report_stamp();
 }
 
 inline bool TabletMeta::in_restore_mode() const {
@@ -302,6 +316,8 @@ inline const TabletSchema& TabletMeta::tablet_schema() const {
 }
 
 inline TabletSchema* TabletMeta::mutable_tablet_schema() {
+    // the schema may be changed by the caller, e.g. is_in_memory which is reported
+    _update_report_stamp();
     return _schema.get();
 }
 
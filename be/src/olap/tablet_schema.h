@@ -51,7 +51,8 @@ public:
     bool is_length_variable_type() const {
         return _type == OLAP_FIELD_TYPE_CHAR || _type == OLAP_FIELD_TYPE_VARCHAR ||
                _type == OLAP_FIELD_TYPE_STRING || _type == OLAP_FIELD_TYPE_HLL ||
-               _type == OLAP_FIELD_TYPE_OBJECT || _type == OLAP_FIELD_TYPE_QUANTILE_STATE;
+               _type == OLAP_FIELD_TYPE_OBJECT || _type == OLAP_FIELD_TYPE_QUANTILE_STATE ||
+               _type == OLAP_FIELD_TYPE_JSONB;
     }
     bool has_default_value() const { return _has_default_value; }
     std::string default_value() const { return _default_value; }
@@ -146,6 +147,11 @@ public:
     void set_delete_sign_idx(int32_t delete_sign_idx) { _delete_sign_idx = delete_sign_idx; }
     bool has_sequence_col() const { return _sequence_col_idx != -1; }
     int32_t sequence_col_idx() const { return _sequence_col_idx; }
+    // the hidden column storing all the other columns of a row, -1 if rows are not stored. The
+    // rows of aggregate keys are never stored, their values are aggregated column by column.
+    int32_t row_store_col_idx() const {
+        return _keys_type == KeysType::AGG_KEYS ? -1 : _row_store_col_idx;
+    }
     segment_v2::CompressionTypePB compression_type() const { return _compression_type; }
 
     vectorized::Block create_block(
@@ -179,6 +185,7 @@ private:
     bool _is_in_memory = false;
     int32_t _delete_sign_idx = -1;
     int32_t _sequence_col_idx = -1;
+    int32_t _row_store_col_idx = -1;
 };
 
 bool operator==(const TabletSchema& a, const TabletSchema& b);
@@ -30,6 +30,7 @@
 #include "olap/olap_define.h"
 #include "runtime/collection_value.h"
 #include "runtime/mem_pool.h"
+#include "util/jsonb.h"
 #include "util/mem_util.hpp"
 #include "util/mysql_global.h"
 #include "util/slice.h"
@@ -530,6 +531,10 @@ struct CppTypeTraits<OLAP_FIELD_TYPE_QUANTILE_STATE> {
     using CppType = Slice;
 };
 template <>
+struct CppTypeTraits<OLAP_FIELD_TYPE_JSONB> {
+    using CppType = Slice;
+};
+template <>
 struct CppTypeTraits<OLAP_FIELD_TYPE_ARRAY> {
     using CppType = CollectionValue;
 };
@@ -1264,6 +1269,23 @@ struct FieldTypeTraits<OLAP_FIELD_TYPE_QUANTILE_STATE>
     }
 };
 
+template <>
+struct FieldTypeTraits<OLAP_FIELD_TYPE_JSONB> : public FieldTypeTraits<OLAP_FIELD_TYPE_STRING> {
+    /*
+     * jsonb type only used as value, it's stored as binary jsonb
+     * and converted from json text when loading
+     */
+    static std::string to_string(const void* src) {
+        auto slice = reinterpret_cast<const Slice*>(src);
+        return JsonbDocument::to_json_string(slice->data, slice->size);
+    }
+
+    static Status convert_from(void* dest, const void* src, const TypeInfo* src_type,
+                               MemPool* mem_pool, size_t variable_len = 0) {
+        return Status::OLAPInternalError(OLAP_ERR_INVALID_SCHEMA);
+    }
+};
+
 // Instantiate this template to get static access to the type traits.
 template <FieldType field_type>
 struct TypeTraits : public FieldTypeTraits<field_type> {
@@ -27,10 +27,11 @@ WrapperField* WrapperField::create(const TabletColumn& column, uint32_t len) {
     bool is_string_type =
             (column.type() == OLAP_FIELD_TYPE_CHAR || column.type() == OLAP_FIELD_TYPE_VARCHAR ||
              column.type() == OLAP_FIELD_TYPE_HLL || column.type() == OLAP_FIELD_TYPE_OBJECT ||
-             column.type() == OLAP_FIELD_TYPE_STRING);
-    size_t max_length = column.type() == OLAP_FIELD_TYPE_STRING
-                                ? config::string_type_length_soft_limit_bytes
-                                : OLAP_VARCHAR_MAX_LENGTH;
+             column.type() == OLAP_FIELD_TYPE_STRING || column.type() == OLAP_FIELD_TYPE_JSONB);
+    size_t max_length =
+            column.type() == OLAP_FIELD_TYPE_STRING || column.type() == OLAP_FIELD_TYPE_JSONB
+                    ? config::string_type_length_soft_limit_bytes
+                    : OLAP_VARCHAR_MAX_LENGTH;
     if (is_string_type && len > max_length) {
         LOG(WARNING) << "length of string parameter is too long[len=" << len
                      << ", max_len=" << max_length << "].";
@@ -51,7 +52,7 @@ WrapperField* WrapperField::create(const TabletColumn& column, uint32_t len) {
         // variable_len is the real length of varchar
         variable_len =
                 std::max(len, static_cast<uint32_t>(column.length() - sizeof(VarcharLengthType)));
-    } else if (column.type() == OLAP_FIELD_TYPE_STRING) {
+    } else if (column.type() == OLAP_FIELD_TYPE_STRING || column.type() == OLAP_FIELD_TYPE_JSONB) {
         // column.length is the serialized varchar length
         // the first sizeof(StringLengthType) bytes is the length of varchar
         // variable_len is the real length of varchar
@@ -73,7 +74,8 @@ WrapperField* WrapperField::create_by_type(const FieldType& type, int32_t var_le
     bool is_string_type =
             (type == OLAP_FIELD_TYPE_CHAR || type == OLAP_FIELD_TYPE_VARCHAR ||
              type == OLAP_FIELD_TYPE_HLL || type == OLAP_FIELD_TYPE_OBJECT ||
-             type == OLAP_FIELD_TYPE_STRING || type == OLAP_FIELD_TYPE_QUANTILE_STATE);
+             type == OLAP_FIELD_TYPE_STRING || type == OLAP_FIELD_TYPE_QUANTILE_STATE ||
+             type == OLAP_FIELD_TYPE_JSONB);
     auto wrapper = new WrapperField(rep, var_length, is_string_type);
     return wrapper;
 }
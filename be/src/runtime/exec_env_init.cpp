@@ -121,6 +121,12 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
             .set_max_queue_size(config::send_batch_thread_pool_queue_size)
             .build(&_send_batch_thread_pool);
 
+    ThreadPoolBuilder("AggThreadPool")
+            .set_min_threads(1)
+            .set_max_threads(config::agg_thread_pool_thread_num)
+            .set_max_queue_size(config::agg_thread_pool_queue_size)
+            .build(&_agg_thread_pool);
+
     _etl_thread_pool = new PriorityThreadPool(config::etl_thread_pool_size,
                                               config::etl_thread_pool_queue_size);
     _cgroups_mgr = new CgroupsMgr(this, config::doris_cgroups);
@@ -252,7 +258,13 @@ Status ExecEnv::_init_mem_tracker() {
     }
     int32_t index_percentage = config::index_page_cache_percentage;
     uint32_t num_shards = config::storage_page_cache_shard_size;
-    StoragePageCache::create_global_cache(storage_cache_limit, index_percentage, num_shards);
+    CacheEvictionPolicy data_page_policy = config::enable_storage_page_cache_scan_resistance
+                                                   ? CacheEvictionPolicy::TWO_QUEUE
+                                                   : CacheEvictionPolicy::LRU;
+    StoragePageCache::create_global_cache(storage_cache_limit, index_percentage, num_shards,
+                                          data_page_policy,
+                                          config::compressed_data_page_cache_percentage,
+                                          config::key_index_page_cache_percentage);
     LOG(INFO) << "Storage page cache memory limit: "
               << PrettyPrinter::print(storage_cache_limit, TUnit::BYTES)
               << ", origin config value: " << config::storage_page_cache_limit;
@@ -0,0 +1,313 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/point_query_executor.h"
+
+#include <algorithm>
+#include <shared_mutex>
+
+#include "common/config.h"
+#include "olap/storage_engine.h"
+#include "olap/tablet_manager.h"
+#include "olap/tuple.h"
+#include "olap/utils.h"
+#include "util/uid_util.h"
+#include "vec/columns/column_vector.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/olap/block_reader.h"
+
+namespace doris {
+
+std::shared_ptr<const PreparedPointLookup> PreparedPointLookupCache::get(const std::string& id) {
+    std::lock_guard<std::mutex> l(_lock);
+    auto it = _entry_map.find(id);
+    if (it == _entry_map.end()) {
+        return nullptr;
+    }
+    _entries.splice(_entries.begin(), _entries, it->second);
+    return it->second->second;
+}
+
+void PreparedPointLookupCache::put(const std::string& id,
+                                   std::shared_ptr<const PreparedPointLookup> lookup) {
+    std::lock_guard<std::mutex> l(_lock);
+    auto it = _entry_map.find(id);
+    if (it != _entry_map.end()) {
+        it->second->second = std::move(lookup);
+        _entries.splice(_entries.begin(), _entries, it->second);
+        return;
+    }
+    _entries.emplace_front(id, std::move(lookup));
+    _entry_map[id] = _entries.begin();
+    while (_entries.size() > _capacity) {
+        _entry_map.erase(_entries.back().first);
+        _entries.pop_back();
+    }
+}
+
+size_t PreparedPointLookupCache::size() const {
+    std::lock_guard<std::mutex> l(_lock);
+    return _entries.size();
+}
+
+PointQueryExecutor::PointQueryExecutor()
+        : _prepared_cache(config::point_lookup_prepared_cache_capacity) {}
+
+Status PointQueryExecutor::lookup(const PTabletKeyLookupRequest& request,
+                                  PTabletKeyLookupResponse* response) {
+    TabletSharedPtr tablet =
+            StorageEngine::instance()->tablet_manager()->get_tablet(request.tablet_id());
+    if (tablet == nullptr) {
+        return Status::NotFound(fmt::format("tablet {} not found", request.tablet_id()));
+    }
+    // only the versions of a key of unique and aggregate keys tablets are merged into one row,
+    // a key of a duplicate keys tablet may have any number of rows
+    if (tablet->keys_type() != UNIQUE_KEYS && tablet->keys_type() != AGG_KEYS) {
+        return Status::InvalidArgument(fmt::format(
+                "tablet {} of {} can not be looked up by key, only unique and aggregate keys "
+                "tablets can",
+                request.tablet_id(), KeysType_Name(tablet->keys_type())));
+    }
+    if (static_cast<size_t>(request.key_tuple_size()) != tablet->num_key_columns()) {
+        return Status::InvalidArgument(fmt::format(
+                "the lookup of tablet {} has {} keys, but the tablet has {} key columns",
+                request.tablet_id(), request.key_tuple_size(), tablet->num_key_columns()));
+    }
+    std::shared_ptr<const PreparedPointLookup> prepared;
+    RETURN_IF_ERROR(_get_prepared(request, tablet, &prepared));
+
+    Version version(0, request.has_version() ? request.version() : -1);
+    if (!request.has_version()) {
+        std::shared_lock rdlock(tablet->get_header_lock());
+        version.second = tablet->max_version().second;
+    }
+    OlapTuple key(std::vector<std::string>(request.key_tuple().begin(), request.key_tuple().end()));
+    vectorized::Block result;
+    bool decoded = false;
+    if (prepared->use_row_store) {
+        vectorized::Block rows;
+        RETURN_IF_ERROR(_read(tablet, version, key, prepared->row_store_plan, &rows));
+        decoded = _decode_rows(*prepared, rows, &result);
+    }
+    if (!decoded) {
+        RETURN_IF_ERROR(_read(tablet, version, key, prepared->column_plan, &result));
+    }
+
+    size_t uncompressed_bytes = 0;
+    size_t compressed_bytes = 0;
+    std::string column_values;
+    RETURN_IF_ERROR(result.serialize(response->mutable_row_block(), &uncompressed_bytes,
+                                     &compressed_bytes, &column_values));
+    response->mutable_row_block()->set_column_values(std::move(column_values));
+    response->set_version(version.second);
+    return Status::OK();
+}
+
+Status PointQueryExecutor::_read(const TabletSharedPtr& tablet, const Version& version,
+                                 const OlapTuple& key, const PointLookupReadPlan& plan,
+                                 vectorized::Block* result) {
+    TabletReader::ReaderParams reader_params;
+    reader_params.tablet = tablet;
+    reader_params.reader_type = READER_QUERY;
+    reader_params.use_page_cache = !config::disable_storage_page_cache;
+    reader_params.version = version;
+    // the header lock is only taken when the rowsets of the version are not captured yet
+    RETURN_IF_ERROR(tablet->capture_rs_readers(version, &reader_params.rs_readers, false));
+    // the range of a single key, the segments seek to it by their short key index and
+    // ordinal index
+    reader_params.start_key.push_back(key);
+    reader_params.end_key.push_back(key);
+    reader_params.start_key_include = true;
+    reader_params.end_key_include = true;
+    std::vector<uint32_t> read_columns = plan.read_columns;
+    reader_params.origin_return_columns = &read_columns;
+    reader_params.return_columns = plan.reader_columns;
+
+    vectorized::BlockReader reader;
+    RETURN_IF_ERROR(reader.init(reader_params));
+    *result = plan.block.clone_empty();
+    vectorized::MutableColumns result_columns = result->mutate_columns();
+    bool eof = false;
+    while (!eof) {
+        vectorized::Block block = plan.block.clone_empty();
+        RETURN_IF_ERROR(reader.next_block_with_aggregation(&block, nullptr, nullptr, &eof));
+        for (size_t i = 0; i < block.columns(); ++i) {
+            result_columns[i]->insert_range_from(*block.get_by_position(i).column, 0,
+                                                 block.rows());
+        }
+    }
+    result->set_columns(std::move(result_columns));
+
+    if (plan.delete_sign_pos >= 0) {
+        // the versions are merged, a row is deleted if its last version is
+        const auto& delete_sign = result->get_by_position(plan.delete_sign_pos).column;
+        auto filter_column = vectorized::ColumnUInt8::create(result->rows());
+        auto& filter = filter_column->get_data();
+        for (size_t i = 0; i < result->rows(); ++i) {
+            filter[i] = delete_sign->get_int(i) == 0;
+        }
+        result->insert({std::move(filter_column), std::make_shared<vectorized::DataTypeUInt8>(),
+                        "delete_filter"});
+        RETURN_IF_ERROR(vectorized::Block::filter_block(result, result->columns() - 1,
+                                                        plan.num_return_columns));
+    }
+    return Status::OK();
+}
+
+bool PointQueryExecutor::_decode_rows(const PreparedPointLookup& prepared,
+                                      const vectorized::Block& rows, vectorized::Block* result) {
+    vectorized::Block row_block = prepared.row_block.clone_empty();
+    vectorized::MutableColumns row_columns = row_block.mutate_columns();
+    const auto& row_store_column = *rows.get_by_position(0).column;
+    for (size_t i = 0; i < rows.rows(); ++i) {
+        if (!prepared.row_store_codec->decode(row_store_column.get_data_at(i), row_columns)) {
+            return false;
+        }
+    }
+    row_block.set_columns(std::move(row_columns));
+
+    vectorized::ColumnsWithTypeAndName columns;
+    for (auto pos : prepared.row_store_positions) {
+        columns.push_back(row_block.get_by_position(pos));
+    }
+    *result = vectorized::Block(columns);
+    return true;
+}
+
+Status PointQueryExecutor::_get_prepared(const PTabletKeyLookupRequest& request,
+                                         const TabletSharedPtr& tablet,
+                                         std::shared_ptr<const PreparedPointLookup>* lookup) {
+    // a statement looks up the tablets of all the partitions and buckets of its table,
+    // it is prepared for each of them
+    std::string prepared_id;
+    if (request.has_prepared_id()) {
+        prepared_id = UniqueId(request.prepared_id()).to_string() + "_" +
+                      std::to_string(request.tablet_id());
+        auto cached = _prepared_cache.get(prepared_id);
+        if (cached != nullptr && cached->schema_hash == tablet->schema_hash()) {
+            *lookup = std::move(cached);
+            return Status::OK();
+        }
+    }
+    std::shared_ptr<PreparedPointLookup> prepared;
+    RETURN_IF_ERROR(_prepare(tablet, request.columns(), &prepared));
+    if (!prepared_id.empty()) {
+        _prepared_cache.put(prepared_id, prepared);
+    }
+    *lookup = std::move(prepared);
+    return Status::OK();
+}
+
+Status PointQueryExecutor::_prepare(const TabletSharedPtr& tablet,
+                                    const google::protobuf::RepeatedPtrField<std::string>& columns,
+                                    std::shared_ptr<PreparedPointLookup>* lookup) {
+    const TabletSchema& schema = tablet->tablet_schema();
+    int32_t sequence_col_idx = schema.sequence_col_idx();
+    auto prepared = std::make_shared<PreparedPointLookup>();
+    prepared->tablet_id = tablet->tablet_id();
+    prepared->schema_hash = tablet->schema_hash();
+
+    int32_t row_store_col_idx = schema.row_store_col_idx();
+    std::vector<uint32_t> return_columns;
+    if (columns.empty()) {
+        // all the columns but the hidden ones
+        for (uint32_t cid = 0; cid < schema.num_columns(); ++cid) {
+            if (static_cast<int32_t>(cid) != sequence_col_idx &&
+                static_cast<int32_t>(cid) != row_store_col_idx &&
+                schema.column(cid).name() != DELETE_SIGN) {
+                return_columns.push_back(cid);
+            }
+        }
+    } else {
+        for (const auto& name : columns) {
+            int32_t index = tablet->field_index(name);
+            if (index < 0) {
+                return Status::InvalidArgument(
+                        fmt::format("column {} not found in tablet {}", name, tablet->tablet_id()));
+            }
+            // the reader takes the last read column as the sequence column, so it can only be
+            // read for merging the versions
+            if (index == sequence_col_idx) {
+                return Status::InvalidArgument("the sequence column can not be looked up");
+            }
+            if (index == row_store_col_idx) {
+                return Status::InvalidArgument("the row store column can not be looked up");
+            }
+            auto cid = static_cast<uint32_t>(index);
+            if (std::find(return_columns.begin(), return_columns.end(), cid) !=
+                return_columns.end()) {
+                return Status::InvalidArgument(fmt::format("duplicate column {}", name));
+            }
+            return_columns.push_back(cid);
+        }
+    }
+    _init_read_plan(schema, return_columns, &prepared->column_plan);
+
+    size_t num_value_columns = std::count_if(
+            return_columns.begin(), return_columns.end(),
+            [&schema](uint32_t cid) { return !schema.column(cid).is_key(); });
+    // only the last version of a unique key replaces the others as a whole row, so only the rows
+    // of unique keys tablets are read from the row store column
+    if (row_store_col_idx != -1 && schema.keys_type() == UNIQUE_KEYS && num_value_columns > 1) {
+        prepared->use_row_store = true;
+        _init_read_plan(schema, {static_cast<uint32_t>(row_store_col_idx)},
+                        &prepared->row_store_plan);
+        prepared->row_store_codec = std::make_unique<vectorized::RowStoreCodec>(schema);
+        const auto& row_column_ids = prepared->row_store_codec->column_ids();
+        for (auto cid : return_columns) {
+            auto it = std::find(row_column_ids.begin(), row_column_ids.end(), cid);
+            DCHECK(it != row_column_ids.end());
+            prepared->row_store_positions.push_back(it - row_column_ids.begin());
+        }
+        prepared->row_block = schema.create_block(row_column_ids);
+    }
+    *lookup = std::move(prepared);
+    return Status::OK();
+}
+
+void PointQueryExecutor::_init_read_plan(const TabletSchema& schema,
+                                         std::vector<uint32_t> return_columns,
+                                         PointLookupReadPlan* plan) {
+    std::vector<uint32_t>& read_columns = plan->read_columns;
+    read_columns = std::move(return_columns);
+    plan->num_return_columns = read_columns.size();
+
+    if (int32_t delete_sign_idx = schema.delete_sign_idx(); delete_sign_idx != -1) {
+        auto cid = static_cast<uint32_t>(delete_sign_idx);
+        auto it = std::find(read_columns.begin(), read_columns.end(), cid);
+        plan->delete_sign_pos = it - read_columns.begin();
+        if (it == read_columns.end()) {
+            read_columns.push_back(cid);
+        }
+    }
+    plan->block = schema.create_block(read_columns);
+    if (int32_t sequence_col_idx = schema.sequence_col_idx(); sequence_col_idx != -1) {
+        read_columns.push_back(sequence_col_idx);
+    }
+
+    // the reader merges the versions by all the key columns
+    for (uint32_t cid = 0; cid < schema.num_key_columns(); ++cid) {
+        plan->reader_columns.push_back(cid);
+    }
+    for (auto cid : read_columns) {
+        if (!schema.column(cid).is_key()) {
+            plan->reader_columns.push_back(cid);
+        }
+    }
+}
+
+} // namespace doris
@@ -0,0 +1,121 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/status.h"
+#include "gen_cpp/internal_service.pb.h"
+#include "olap/tablet.h"
+#include "vec/core/block.h"
+#include "vec/olap/row_store_codec.h"
+
+namespace doris {
+
+// The columns a point lookup reads from a tablet.
+struct PointLookupReadPlan {
+    // the columns read from the tablet, the returned columns first and then the columns only
+    // needed to merge the versions and filter the deleted rows
+    std::vector<uint32_t> read_columns;
+    // the read columns reordered with the key columns first, which the reader merges by
+    std::vector<uint32_t> reader_columns;
+    size_t num_return_columns = 0;
+    // the position of the delete sign column in the read columns, -1 if there is none
+    int delete_sign_pos = -1;
+    // an empty block of the read columns
+    vectorized::Block block;
+};
+
+// The part of a point lookup that only depends on the statement, it is prepared by the first
+// lookup of a statement and reused by the following lookups of it.
+struct PreparedPointLookup {
+    int64_t tablet_id = 0;
+    int32_t schema_hash = 0;
+    // reads the returned columns one by one
+    PointLookupReadPlan column_plan;
+    // reads the row store column instead and decodes the returned columns from it, only used if
+    // the tablet stores rows and more than one value column is returned
+    bool use_row_store = false;
+    PointLookupReadPlan row_store_plan;
+    std::unique_ptr<vectorized::RowStoreCodec> row_store_codec;
+    // the positions of the returned columns in a decoded row
+    std::vector<size_t> row_store_positions;
+    // an empty block of the columns of a decoded row
+    vectorized::Block row_block;
+};
+
+// The prepared point lookups by the id of their statements, the least recently used one is
+// evicted when there are more than capacity of them.
+class PreparedPointLookupCache {
+public:
+    PreparedPointLookupCache(size_t capacity) : _capacity(capacity) {}
+
+    std::shared_ptr<const PreparedPointLookup> get(const std::string& id);
+
+    void put(const std::string& id, std::shared_ptr<const PreparedPointLookup> lookup);
+
+    size_t size() const;
+
+private:
+    using Entry = std::pair<std::string, std::shared_ptr<const PreparedPointLookup>>;
+
+    const size_t _capacity;
+    mutable std::mutex _lock;
+    // the most recently used entry is at the front
+    std::list<Entry> _entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> _entry_map;
+};
+
+// Looks up the row of a key in a unique or aggregate keys tablet without planning a fragment.
+// The rowsets of the tablet are read through the short key index and the ordinal index of their
+// segments, and the versions of the row are merged like a query does. A tablet storing rows
+// returns a row decoded from its row store column, unless the row is not stored in it.
+class PointQueryExecutor {
+public:
+    PointQueryExecutor();
+
+    Status lookup(const PTabletKeyLookupRequest& request, PTabletKeyLookupResponse* response);
+
+private:
+    static void _init_read_plan(const TabletSchema& schema, std::vector<uint32_t> return_columns,
+                                PointLookupReadPlan* plan);
+
+    static Status _read(const TabletSharedPtr& tablet, const Version& version,
+                        const OlapTuple& key, const PointLookupReadPlan& plan,
+                        vectorized::Block* result);
+
+    // returns false if any of the rows is not stored in the row store column
+    static bool _decode_rows(const PreparedPointLookup& prepared, const vectorized::Block& rows,
+                             vectorized::Block* result);
+
+    static Status _prepare(const TabletSharedPtr& tablet,
+                           const google::protobuf::RepeatedPtrField<std::string>& columns,
+                           std::shared_ptr<PreparedPointLookup>* lookup);
+
+    Status _get_prepared(const PTabletKeyLookupRequest& request, const TabletSharedPtr& tablet,
+                         std::shared_ptr<const PreparedPointLookup>* lookup);
+
+    PreparedPointLookupCache _prepared_cache;
+};
+
+} // namespace doris
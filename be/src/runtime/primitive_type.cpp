@@ -112,7 +112,7 @@ bool is_string_type(PrimitiveType type) {
 
 bool has_variable_type(PrimitiveType type) {
     return type == TYPE_CHAR || type == TYPE_VARCHAR || type == TYPE_OBJECT ||
-           type == TYPE_QUANTILE_STATE || type == TYPE_STRING;
+           type == TYPE_QUANTILE_STATE || type == TYPE_STRING || type == TYPE_JSONB;
 }
 
 // Returns the byte size of 'type'  Returns 0 for variable length types.
@@ -120,6 +120,7 @@ int get_byte_size(PrimitiveType type) {
     switch (type) {
     case TYPE_VARCHAR:
     case TYPE_STRING:
+    case TYPE_JSONB:
     case TYPE_OBJECT:
     case TYPE_HLL:
     case TYPE_QUANTILE_STATE:
@@ -165,6 +166,7 @@ int get_real_byte_size(PrimitiveType type) {
     case TYPE_HLL:
     case TYPE_VARCHAR:
     case TYPE_STRING:
+    case TYPE_JSONB:
     case TYPE_ARRAY:
         return 0;
 
@@ -285,6 +287,9 @@ PrimitiveType thrift_to_type(TPrimitiveType::type ttype) {
     case TPrimitiveType::STRING:
         return TYPE_STRING;
 
+    case TPrimitiveType::JSONB:
+        return TYPE_JSONB;
+
     case TPrimitiveType::BINARY:
         return TYPE_BINARY;
 
@@ -358,6 +363,9 @@ TPrimitiveType::type to_thrift(PrimitiveType ptype) {
     case TYPE_STRING:
         return TPrimitiveType::STRING;
 
+    case TYPE_JSONB:
+        return TPrimitiveType::JSONB;
+
     case TYPE_BINARY:
         return TPrimitiveType::BINARY;
 
@@ -431,6 +439,9 @@ std::string type_to_string(PrimitiveType t) {
     case TYPE_STRING:
         return "STRING";
 
+    case TYPE_JSONB:
+        return "JSONB";
+
     case TYPE_BINARY:
         return "BINARY";
 
@@ -505,6 +516,9 @@ std::string type_to_odbc_string(PrimitiveType t) {
     case TYPE_STRING:
         return "string";
 
+    case TYPE_JSONB:
+        return "jsonb";
+
     case TYPE_BINARY:
         return "binary";
 
@@ -562,6 +576,7 @@ int get_slot_size(PrimitiveType type) {
     case TYPE_CHAR:
     case TYPE_VARCHAR:
     case TYPE_STRING:
+    case TYPE_JSONB:
     case TYPE_OBJECT:
     case TYPE_HLL:
     case TYPE_QUANTILE_STATE:
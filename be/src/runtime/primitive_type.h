@@ -60,8 +60,9 @@ enum PrimitiveType {
 
     TYPE_TIME,          /* 21 */
     TYPE_OBJECT,        /* 22 */
-    TYPE_STRING,        /* 23 */
-    TYPE_QUANTILE_STATE /* 24 */
+    TYPE_STRING,         /* 23 */
+    TYPE_QUANTILE_STATE, /* 24 */
+    TYPE_JSONB           /* 25 */
 };
 
 PrimitiveType convert_type_to_primitive(FunctionContext::Type type);
@@ -168,6 +169,12 @@ struct PrimitiveTypeTraits<TYPE_STRING> {
     using ColumnType = vectorized::ColumnString;
 };
 
+template <>
+struct PrimitiveTypeTraits<TYPE_JSONB> {
+    using CppType = StringValue;
+    using ColumnType = vectorized::ColumnString;
+};
+
 // only for adapt get_predicate_column_ptr
 template <PrimitiveType type>
 struct PredicatePrimitiveTypeTraits {
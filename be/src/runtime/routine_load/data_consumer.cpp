@@ -173,7 +173,7 @@ Status KafkaDataConsumer::assign_topic_partitions(
     return Status::OK();
 }
 
-Status KafkaDataConsumer::group_consume(BlockingQueue<RdKafka::Message*>* queue,
+Status KafkaDataConsumer::group_consume(BlockingQueue<KafkaMessageBatch*>* queue,
                                         int64_t max_running_time_ms) {
     static constexpr int MAX_RETRY_TIMES_FOR_TRANSPORT_FAILURE = 3;
     int64_t left_time = max_running_time_ms;
@@ -182,11 +182,13 @@ Status KafkaDataConsumer::group_consume(BlockingQueue<RdKafka::Message*>* queue,
 
     int64_t received_rows = 0;
     int64_t put_rows = 0;
+    int64_t put_batches = 0;
     int32_t retry_times = 0;
     Status st = Status::OK();
     MonotonicStopWatch consumer_watch;
     MonotonicStopWatch watch;
     watch.start();
+    std::unique_ptr<KafkaMessageBatch> batch;
     while (true) {
         {
             std::unique_lock<std::mutex> l(_lock);
@@ -200,29 +202,36 @@ Status KafkaDataConsumer::group_consume(BlockingQueue<RdKafka::Message*>* queue,
         }
 
         bool done = false;
-        // consume 1 message at a time
+        bool flush = true;
+        // wait for the first message of a batch, the rest of the batch is taken from the
+        // messages librdkafka has already fetched, without waiting.
         consumer_watch.start();
-        std::unique_ptr<RdKafka::Message> msg(_k_consumer->consume(1000 /* timeout, ms */));
+        std::unique_ptr<RdKafka::Message> msg(
+                _k_consumer->consume(batch == nullptr ? 1000 : 0 /* timeout, ms */));
         consumer_watch.stop();
         switch (msg->err()) {
         case RdKafka::ERR_NO_ERROR:
+            ++received_rows;
             if (msg->len() == 0) {
                 // ignore msg with length 0.
                 // put empty msg into queue will cause the load process shutting down.
+                flush = false;
                 break;
-            } else if (!queue->blocking_put(msg.get())) {
-                // queue is shutdown
-                done = true;
-            } else {
-                ++put_rows;
-                msg.release(); // release the ownership, msg will be deleted after being processed
             }
-            ++received_rows;
+            if (batch == nullptr) {
+                batch.reset(new KafkaMessageBatch());
+                batch->consumer = shared_from_this();
+                batch->messages.reserve(MAX_MESSAGES_PER_BATCH);
+            }
+            batch->messages.push_back(std::move(msg));
+            flush = batch->messages.size() >= MAX_MESSAGES_PER_BATCH;
             break;
         case RdKafka::ERR__TIMED_OUT:
             // leave the status as OK, because this may happened
             // if there is no data in kafka.
-            LOG(INFO) << "kafka consume timeout: " << _id;
+            if (batch == nullptr) {
+                LOG(INFO) << "kafka consume timeout: " << _id;
+            }
             break;
         case RdKafka::ERR__TRANSPORT:
             LOG(INFO) << "kafka consume Disconnected: " << _id
@@ -239,6 +248,19 @@ Status KafkaDataConsumer::group_consume(BlockingQueue<RdKafka::Message*>* queue,
         }
 
         left_time = max_running_time_ms - watch.elapsed_time() / 1000 / 1000;
+        if (batch != nullptr && (flush || left_time <= 0)) {
+            size_t batch_rows = batch->messages.size();
+            if (!queue->blocking_put(batch.get())) {
+                // queue is shutdown
+                done = true;
+                batch.reset();
+            } else {
+                put_rows += batch_rows;
+                ++put_batches;
+                // release the ownership, msgs will be deleted after being processed
+                batch.release();
+            }
+        }
         if (done) {
             break;
         }
@@ -248,11 +270,22 @@ Status KafkaDataConsumer::group_consume(BlockingQueue<RdKafka::Message*>* queue,
               << ". cancelled: " << _cancelled << ", left time(ms): " << left_time
               << ", total cost(ms): " << watch.elapsed_time() / 1000 / 1000
               << ", consume cost(ms): " << consumer_watch.elapsed_time() / 1000 / 1000
-              << ", received rows: " << received_rows << ", put rows: " << put_rows;
+              << ", received rows: " << received_rows << ", put rows: " << put_rows
+              << ", put batches: " << put_batches;
 
     return st;
 }
 
+int64_t KafkaDataConsumer::get_cached_high_watermark(int32_t partition) {
+    int64_t low = -1;
+    int64_t high = -1;
+    RdKafka::ErrorCode err = _k_consumer->get_watermark_offsets(_topic, partition, &low, &high);
+    if (err != RdKafka::ERR_NO_ERROR) {
+        return -1;
+    }
+    return high;
+}
+
 Status KafkaDataConsumer::get_partition_meta(std::vector<int32_t>* partition_ids) {
     // create topic conf
     RdKafka::Conf* tconf = RdKafka::Conf::create(RdKafka::Conf::CONF_TOPIC);
@@ -20,6 +20,7 @@
 #include <ctime>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "librdkafka/rdkafkacpp.h"
 #include "runtime/stream_load/stream_load_context.h"
@@ -108,7 +109,15 @@ public:
     }
 };
 
-class KafkaDataConsumer : public DataConsumer {
+// the messages a kafka consumer hands to its consumer group at a time
+struct KafkaMessageBatch {
+    // the consumer is kept alive as long as its messages
+    std::shared_ptr<DataConsumer> consumer;
+    std::vector<std::unique_ptr<RdKafka::Message>> messages;
+};
+
+class KafkaDataConsumer : public DataConsumer,
+                          public std::enable_shared_from_this<KafkaDataConsumer> {
 public:
     KafkaDataConsumer(StreamLoadContext* ctx)
             : DataConsumer(ctx),
@@ -137,8 +146,15 @@ public:
     Status assign_topic_partitions(const std::map<int32_t, int64_t>& begin_partition_offset,
                                    const std::string& topic, StreamLoadContext* ctx);
 
-    // start the consumer and put msgs to queue
-    Status group_consume(BlockingQueue<RdKafka::Message*>* queue, int64_t max_running_time_ms);
+    // the max number of msgs a consumer puts to the queue at a time
+    static constexpr size_t MAX_MESSAGES_PER_BATCH = 50;
+
+    // start the consumer and put batches of msgs to queue
+    Status group_consume(BlockingQueue<KafkaMessageBatch*>* queue, int64_t max_running_time_ms);
+
+    // get the high watermark of the partition known from the last fetch, no request is sent
+    // to kafka. return -1 if it is not known yet.
+    int64_t get_cached_high_watermark(int32_t partition);
 
     // get the partitions ids of the topic
     Status get_partition_meta(std::vector<int32_t>* partition_ids);
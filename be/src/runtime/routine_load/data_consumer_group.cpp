@@ -16,14 +16,24 @@
 // under the License.
 #include "runtime/routine_load/data_consumer_group.h"
 
+#include <algorithm>
+
 #include "librdkafka/rdkafka.h"
 #include "librdkafka/rdkafkacpp.h"
 #include "runtime/routine_load/data_consumer.h"
 #include "runtime/routine_load/kafka_consumer_pipe.h"
 #include "runtime/stream_load/stream_load_context.h"
+#include "util/doris_metrics.h"
 
 namespace doris {
 
+DEFINE_COUNTER_METRIC_PROTOTYPE_3ARG(routine_load_kafka_consume_rows, MetricUnit::ROWS,
+                                     "rows consumed from a kafka partition");
+DEFINE_COUNTER_METRIC_PROTOTYPE_3ARG(routine_load_kafka_consume_bytes, MetricUnit::BYTES,
+                                     "bytes consumed from a kafka partition");
+DEFINE_GAUGE_METRIC_PROTOTYPE_3ARG(routine_load_kafka_consume_lag, MetricUnit::NOUNIT,
+                                   "msgs of a kafka partition not consumed yet");
+
 Status KafkaDataConsumerGroup::assign_topic_partitions(StreamLoadContext* ctx) {
     DCHECK(ctx->kafka_info);
     DCHECK(_consumers.size() >= 1);
@@ -31,10 +41,12 @@ Status KafkaDataConsumerGroup::assign_topic_partitions(StreamLoadContext* ctx) {
     // divide partitions
     int consumer_size = _consumers.size();
     std::vector<std::map<int32_t, int64_t>> divide_parts(consumer_size);
+    _consumer_partitions.assign(consumer_size, {});
     int i = 0;
     for (auto& kv : ctx->kafka_info->begin_offset) {
         int idx = i % consumer_size;
         divide_parts[idx].emplace(kv.first, kv.second);
+        _consumer_partitions[idx].push_back(kv.first);
         i++;
     }
 
@@ -52,10 +64,10 @@ KafkaDataConsumerGroup::~KafkaDataConsumerGroup() {
     // clean the msgs left in queue
     _queue.shutdown();
     while (true) {
-        RdKafka::Message* msg;
-        if (_queue.blocking_get(&msg)) {
-            delete msg;
-            msg = nullptr;
+        KafkaMessageBatch* batch;
+        if (_queue.blocking_get(&batch)) {
+            delete batch;
+            batch = nullptr;
         } else {
             break;
         }
@@ -66,8 +78,9 @@ KafkaDataConsumerGroup::~KafkaDataConsumerGroup() {
 Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
     Status result_st = Status::OK();
     // start all consumers
-    for (auto& consumer : _consumers) {
-        if (!_thread_pool.offer(std::bind<void>(
+    for (size_t i = 0; i < _consumers.size(); ++i) {
+        auto& consumer = _consumers[i];
+        if (!_thread_pool->offer(std::bind<void>(
                     &KafkaDataConsumerGroup::actual_consume, this, consumer, &_queue,
                     ctx->max_interval_s * 1000, [this, &result_st](const Status& st) {
                         std::unique_lock<std::mutex> lock(_mutex);
@@ -77,6 +90,7 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
                             _queue.shutdown();
                             LOG(INFO) << "all consumers are finished. shutdown queue. group id: "
                                       << _grp_id;
+                            _counter_cv.notify_all();
                         }
                         if (result_st.ok() && !st.ok()) {
                             result_st = st;
@@ -84,6 +98,12 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
                     }))) {
             LOG(WARNING) << "failed to submit data consumer: " << consumer->id()
                          << ", group id: " << _grp_id;
+            {
+                // the consumers not submitted will never finish
+                std::unique_lock<std::mutex> lock(_mutex);
+                _counter -= static_cast<int>(_consumers.size() - i);
+            }
+            _stop_consumers(ctx);
             return Status::InternalError("failed to submit data consumer");
         } else {
             VLOG_CRITICAL << "submit a data consumer: " << consumer->id()
@@ -93,79 +113,58 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
 
     // consuming from queue and put data to stream load pipe
     int64_t left_time = ctx->max_interval_s * 1000;
-    int64_t left_rows = ctx->max_batch_rows;
-    int64_t left_bytes = ctx->max_batch_size;
+    KafkaConsumeProgress progress;
+    progress.left_rows = ctx->max_batch_rows;
+    progress.left_bytes = ctx->max_batch_size;
 
     std::shared_ptr<KafkaConsumerPipe> kafka_pipe =
             std::static_pointer_cast<KafkaConsumerPipe>(ctx->body_sink);
 
     LOG(INFO) << "start consumer group: " << _grp_id << ". max time(ms): " << left_time
-              << ", batch rows: " << left_rows << ", batch size: " << left_bytes << ". "
-              << ctx->brief();
+              << ", batch rows: " << progress.left_rows
+              << ", batch size: " << progress.left_bytes << ". " << ctx->brief();
 
     // copy one
-    std::map<int32_t, int64_t> cmt_offset = ctx->kafka_info->cmt_offset;
-
-    //improve performance
-    Status (KafkaConsumerPipe::*append_data)(const char* data, size_t size);
-    if (ctx->format == TFileFormatType::FORMAT_JSON) {
-        append_data = &KafkaConsumerPipe::append_json;
-    } else {
-        append_data = &KafkaConsumerPipe::append_with_line_delimiter;
-    }
+    progress.cmt_offset = ctx->kafka_info->cmt_offset;
+
+    bool is_json = ctx->format == TFileFormatType::FORMAT_JSON;
 
     MonotonicStopWatch watch;
     watch.start();
     bool eos = false;
     while (true) {
-        if (eos || left_time <= 0 || left_rows <= 0 || left_bytes <= 0) {
+        if (eos || left_time <= 0 || progress.left_rows <= 0 || progress.left_bytes <= 0) {
             LOG(INFO) << "consumer group done: " << _grp_id
                       << ". consume time(ms)=" << ctx->max_interval_s * 1000 - left_time
-                      << ", received rows=" << ctx->max_batch_rows - left_rows
-                      << ", received bytes=" << ctx->max_batch_size - left_bytes << ", eos: " << eos
-                      << ", left_time: " << left_time << ", left_rows: " << left_rows
-                      << ", left_bytes: " << left_bytes
+                      << ", received rows=" << ctx->max_batch_rows - progress.left_rows
+                      << ", received bytes=" << ctx->max_batch_size - progress.left_bytes
+                      << ", eos: " << eos << ", left_time: " << left_time
+                      << ", left_rows: " << progress.left_rows
+                      << ", left_bytes: " << progress.left_bytes
                       << ", blocking get time(us): " << _queue.total_get_wait_time() / 1000
                       << ", blocking put time(us): " << _queue.total_put_wait_time() / 1000 << ", "
                       << ctx->brief();
 
-            // shutdown queue
-            _queue.shutdown();
-            // cancel all consumers
-            for (auto& consumer : _consumers) {
-                consumer->cancel(ctx);
-            }
-
-            // waiting all threads finished
-            _thread_pool.shutdown();
-            _thread_pool.join();
+            _stop_consumers(ctx);
             if (!result_st.ok()) {
                 kafka_pipe->cancel(result_st.get_error_msg());
                 return result_st;
             }
             kafka_pipe->finish();
-            ctx->kafka_info->cmt_offset = std::move(cmt_offset);
-            ctx->receive_bytes = ctx->max_batch_size - left_bytes;
+            _update_partition_metrics(ctx, progress.cmt_offset, progress.partition_rows,
+                                      progress.partition_bytes);
+            ctx->kafka_info->cmt_offset = std::move(progress.cmt_offset);
+            ctx->receive_bytes = ctx->max_batch_size - progress.left_bytes;
             return Status::OK();
         }
 
-        RdKafka::Message* msg;
-        bool res = _queue.blocking_get(&msg);
+        KafkaMessageBatch* batch;
+        bool res = _queue.blocking_get(&batch);
         if (res) {
-            VLOG_NOTICE << "get kafka message"
-                        << ", partition: " << msg->partition() << ", offset: " << msg->offset()
-                        << ", len: " << msg->len();
-
-            Status st = (kafka_pipe.get()->*append_data)(static_cast<const char*>(msg->payload()),
-                                                         static_cast<size_t>(msg->len()));
-            if (st.ok()) {
-                left_rows--;
-                left_bytes -= msg->len();
-                cmt_offset[msg->partition()] = msg->offset();
-                VLOG_NOTICE << "consume partition[" << msg->partition() << " - " << msg->offset()
-                            << "]";
-            } else {
-                // failed to append this msg, we must stop
+            std::unique_ptr<KafkaMessageBatch> batch_holder(batch);
+            Status st = _append_batch(batch, kafka_pipe.get(), is_json, &progress);
+            if (!st.ok()) {
+                // failed to append a msg, we must stop
                 LOG(WARNING) << "failed to append msg to pipe. grp: " << _grp_id;
                 eos = true;
                 {
@@ -175,7 +174,6 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
                     }
                 }
             }
-            delete msg;
         } else {
             // queue is empty and shutdown
             eos = true;
@@ -187,8 +185,91 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
     return Status::OK();
 }
 
+Status KafkaDataConsumerGroup::_append_batch(KafkaMessageBatch* batch, KafkaConsumerPipe* pipe,
+                                             bool is_json, KafkaConsumeProgress* progress) {
+    // the msgs left in the batch once the limits are reached are not loaded,
+    // their offsets are not committed either
+    for (auto& msg : batch->messages) {
+        if (progress->left_rows <= 0 || progress->left_bytes <= 0) {
+            break;
+        }
+        int32_t partition = msg->partition();
+        int64_t offset = msg->offset();
+        size_t len = msg->len();
+        VLOG_NOTICE << "get kafka message"
+                    << ", partition: " << partition << ", offset: " << offset
+                    << ", len: " << len;
+
+        if (is_json) {
+            // the payload is handed to the pipe as it is, the pipe owns the msg now
+            RETURN_IF_ERROR(pipe->append_json(msg.release(), batch->consumer));
+        } else {
+            RETURN_IF_ERROR(pipe->append_with_line_delimiter(
+                    static_cast<const char*>(msg->payload()), len));
+        }
+        progress->left_rows--;
+        progress->left_bytes -= len;
+        progress->cmt_offset[partition] = offset;
+        progress->partition_rows[partition]++;
+        progress->partition_bytes[partition] += len;
+        VLOG_NOTICE << "consume partition[" << partition << " - " << offset << "]";
+    }
+    return Status::OK();
+}
+
+void KafkaDataConsumerGroup::_stop_consumers(StreamLoadContext* ctx) {
+    // shutdown queue
+    _queue.shutdown();
+    // cancel all consumers
+    for (auto& consumer : _consumers) {
+        consumer->cancel(ctx);
+    }
+    // waiting all consumers finished, the threads are shared with other groups
+    std::unique_lock<std::mutex> lock(_mutex);
+    _counter_cv.wait(lock, [this] { return _counter == 0; });
+}
+
+void KafkaDataConsumerGroup::_update_partition_metrics(
+        StreamLoadContext* ctx, const std::map<int32_t, int64_t>& cmt_offset,
+        const std::map<int32_t, int64_t>& partition_rows,
+        const std::map<int32_t, int64_t>& partition_bytes) {
+    MetricRegistry* registry = DorisMetrics::instance()->metric_registry();
+    const std::string& topic = ctx->kafka_info->topic;
+    for (size_t i = 0; i < _consumer_partitions.size() && i < _consumers.size(); ++i) {
+        auto consumer = std::static_pointer_cast<KafkaDataConsumer>(_consumers[i]);
+        for (int32_t partition : _consumer_partitions[i]) {
+            std::string entity_name =
+                    "routine_load_kafka." + topic + "." + std::to_string(partition);
+            Labels labels = {{"topic", topic}, {"partition", std::to_string(partition)}};
+            std::shared_ptr<MetricEntity> entity = registry->get_entity(entity_name, labels);
+            if (entity == nullptr) {
+                entity = registry->register_entity(entity_name, labels);
+            }
+            IntCounter* routine_load_kafka_consume_rows = nullptr;
+            IntCounter* routine_load_kafka_consume_bytes = nullptr;
+            IntGauge* routine_load_kafka_consume_lag = nullptr;
+            INT_COUNTER_METRIC_REGISTER(entity, routine_load_kafka_consume_rows);
+            INT_COUNTER_METRIC_REGISTER(entity, routine_load_kafka_consume_bytes);
+            INT_GAUGE_METRIC_REGISTER(entity, routine_load_kafka_consume_lag);
+
+            auto rows = partition_rows.find(partition);
+            if (rows != partition_rows.end()) {
+                routine_load_kafka_consume_rows->increment(rows->second);
+                routine_load_kafka_consume_bytes->increment(partition_bytes.at(partition));
+            }
+            // the committed offset is the last msg loaded, the next one is not consumed yet
+            int64_t high_watermark = consumer->get_cached_high_watermark(partition);
+            auto offset = cmt_offset.find(partition);
+            if (high_watermark >= 0 && offset != cmt_offset.end()) {
+                routine_load_kafka_consume_lag->set_value(
+                        std::max<int64_t>(0, high_watermark - offset->second - 1));
+            }
+        }
+    }
+}
+
 void KafkaDataConsumerGroup::actual_consume(std::shared_ptr<DataConsumer> consumer,
-                                            BlockingQueue<RdKafka::Message*>* queue,
+                                            BlockingQueue<KafkaMessageBatch*>* queue,
                                             int64_t max_running_time_ms, ConsumeFinishCallback cb) {
     Status st = std::static_pointer_cast<KafkaDataConsumer>(consumer)->group_consume(
             queue, max_running_time_ms);
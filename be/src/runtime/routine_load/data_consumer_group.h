@@ -17,6 +17,9 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <map>
+
 #include "runtime/routine_load/data_consumer.h"
 #include "util/blocking_queue.hpp"
 #include "util/priority_thread_pool.hpp"
@@ -30,7 +33,8 @@ class DataConsumerGroup {
 public:
     typedef std::function<void(const Status&)> ConsumeFinishCallback;
 
-    DataConsumerGroup() : _grp_id(UniqueId::gen_uid()), _thread_pool(3, 10), _counter(0) {}
+    DataConsumerGroup(PriorityThreadPool* thread_pool)
+            : _grp_id(UniqueId::gen_uid()), _thread_pool(thread_pool), _counter(0) {}
 
     virtual ~DataConsumerGroup() { _consumers.clear(); }
 
@@ -50,20 +54,35 @@ public:
 protected:
     UniqueId _grp_id;
     std::vector<std::shared_ptr<DataConsumer>> _consumers;
-    // thread pool to run each consumer in multi thread
-    PriorityThreadPool _thread_pool;
+    // thread pool to run each consumer in multi thread, it is shared by all groups,
+    // so no thread is created for a group.
+    PriorityThreadPool* _thread_pool;
     // mutex to protect counter.
     // the counter is init as the number of consumers.
     // once a consumer is done, decrease the counter.
     // when the counter becomes zero, shutdown the queue to finish
     std::mutex _mutex;
     int _counter;
+    // notified when the counter becomes zero
+    std::condition_variable _counter_cv;
+};
+
+// what a kafka consumer group has loaded into its pipe so far
+struct KafkaConsumeProgress {
+    int64_t left_rows = 0;
+    int64_t left_bytes = 0;
+    // the offset of the last msg loaded of each partition
+    std::map<int32_t, int64_t> cmt_offset;
+    std::map<int32_t, int64_t> partition_rows;
+    std::map<int32_t, int64_t> partition_bytes;
 };
 
 // for kafka
 class KafkaDataConsumerGroup : public DataConsumerGroup {
 public:
-    KafkaDataConsumerGroup() : DataConsumerGroup(), _queue(500) {}
+    KafkaDataConsumerGroup(PriorityThreadPool* thread_pool)
+            : DataConsumerGroup(thread_pool),
+              _queue(500 / KafkaDataConsumer::MAX_MESSAGES_PER_BATCH) {}
 
     virtual ~KafkaDataConsumerGroup();
 
@@ -74,12 +93,25 @@ public:
 private:
     // start a single consumer
     void actual_consume(std::shared_ptr<DataConsumer> consumer,
-                        BlockingQueue<RdKafka::Message*>* queue, int64_t max_running_time_ms,
+                        BlockingQueue<KafkaMessageBatch*>* queue, int64_t max_running_time_ms,
                         ConsumeFinishCallback cb);
+    // append the msgs of batch to pipe until the rows or bytes left run out, the msgs left
+    // are neither loaded nor committed. Json msgs are moved out of batch into the pipe.
+    static Status _append_batch(KafkaMessageBatch* batch, KafkaConsumerPipe* pipe, bool is_json,
+                                KafkaConsumeProgress* progress);
+    // stop all consumers and wait until they are finished
+    void _stop_consumers(StreamLoadContext* ctx);
+    // update the consumed rows, bytes and lag of the partitions
+    void _update_partition_metrics(StreamLoadContext* ctx,
+                                   const std::map<int32_t, int64_t>& cmt_offset,
+                                   const std::map<int32_t, int64_t>& partition_rows,
+                                   const std::map<int32_t, int64_t>& partition_bytes);
 
 private:
-    // blocking queue to receive msgs from all consumers
-    BlockingQueue<RdKafka::Message*> _queue;
+    // blocking queue to receive batches of msgs from all consumers
+    BlockingQueue<KafkaMessageBatch*> _queue;
+    // the partitions assigned to each consumer
+    std::vector<std::vector<int32_t>> _consumer_partitions;
 };
 
 } // end namespace doris
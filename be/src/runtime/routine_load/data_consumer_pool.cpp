@@ -72,7 +72,8 @@ Status DataConsumerPool::get_consumer_grp(StreamLoadContext* ctx,
         return Status::InternalError("PAUSE: The size of begin_offset of task should not be 0.");
     }
 
-    std::shared_ptr<KafkaDataConsumerGroup> grp = std::make_shared<KafkaDataConsumerGroup>();
+    std::shared_ptr<KafkaDataConsumerGroup> grp =
+            std::make_shared<KafkaDataConsumerGroup>(&_consume_thread_pool);
 
     // one data consumer group contains at least one data consumers.
     int max_consumer_num = config::max_consumer_num_per_group;
@@ -21,10 +21,12 @@
 #include <memory>
 #include <mutex>
 
+#include "common/config.h"
 #include "gutil/ref_counted.h"
 #include "runtime/routine_load/data_consumer.h"
 #include "util/countdown_latch.h"
 #include "util/lru_cache.hpp"
+#include "util/priority_thread_pool.hpp"
 #include "util/thread.h"
 
 namespace doris {
@@ -38,7 +40,11 @@ class Status;
 class DataConsumerPool {
 public:
     DataConsumerPool(int64_t max_pool_size)
-            : _max_pool_size(max_pool_size), _stop_background_threads_latch(1) {}
+            : _max_pool_size(max_pool_size),
+              _consume_thread_pool(
+                      config::routine_load_thread_pool_size * config::max_consumer_num_per_group,
+                      config::routine_load_thread_pool_size * config::max_consumer_num_per_group),
+              _stop_background_threads_latch(1) {}
 
     ~DataConsumerPool() {
         _stop_background_threads_latch.count_down();
@@ -68,6 +74,9 @@ private:
     std::mutex _lock;
     std::list<std::shared_ptr<DataConsumer>> _pool;
     int64_t _max_pool_size;
+    // the threads running the consumers of all groups, they live as long as the pool
+    // instead of being created for every task
+    PriorityThreadPool _consume_thread_pool;
 
     CountDownLatch _stop_background_threads_latch;
     scoped_refptr<Thread> _clean_idle_consumer_thread;
@@ -25,6 +25,7 @@
 
 #include "exec/file_reader.h"
 #include "librdkafka/rdkafka.h"
+#include "librdkafka/rdkafkacpp.h"
 #include "runtime/message_body_sink.h"
 #include "runtime/stream_load/stream_load_pipe.h"
 
@@ -48,7 +49,14 @@ public:
         return st;
     }
 
-    Status append_json(const char* data, size_t size) { return append_and_flush(data, size); }
+    // hands the payload of msg to the reader without copying it, msg is deleted once the reader
+    // is done with it. The consumer msg comes from is kept alive until then, because a message
+    // must not outlive its kafka handle.
+    Status append_json(RdKafka::Message* msg, std::shared_ptr<void> consumer) {
+        ByteBufferPtr buf = ByteBuffer::wrap(static_cast<char*>(msg->payload()), msg->len(),
+                                             [msg, consumer]() { delete msg; });
+        return append(buf);
+    }
 };
 
 } // end namespace doris
@@ -114,6 +114,14 @@ public:
         return st;
     }
 
+    // A kafka message is handed over as the buffer it is appended in, without copying it.
+    Status read_one_buffer(ByteBufferPtr* buf) override {
+        if (_total_length != -1) {
+            return FileReader::read_one_buffer(buf);
+        }
+        return _read_next_buffer(buf);
+    }
+
     Status read(uint8_t* data, int64_t data_size, int64_t* bytes_read, bool* eof) override {
         *bytes_read = 0;
         while (*bytes_read < data_size) {
@@ -192,6 +200,21 @@ public:
 private:
     // read the next buffer from _buf_queue
     Status _read_next_buffer(std::unique_ptr<uint8_t[]>* data, int64_t* length) {
+        ByteBufferPtr buf;
+        RETURN_IF_ERROR(_read_next_buffer(&buf));
+        if (buf == nullptr) {
+            data->reset();
+            *length = 0;
+            return Status::OK();
+        }
+        *length = buf->remaining();
+        data->reset(new uint8_t[*length]);
+        buf->get_bytes((char*)(data->get()), *length);
+        return Status::OK();
+    }
+
+    // take the next buffer out of _buf_queue, buf is set nullptr if the pipe is finished
+    Status _read_next_buffer(ByteBufferPtr* buf) {
         std::unique_lock<std::mutex> l(_lock);
         while (!_cancelled && !_finished && _buf_queue.empty()) {
             _get_cond.wait(l);
@@ -203,19 +226,14 @@ private:
         // finished
         if (_buf_queue.empty()) {
             DCHECK(_finished);
-            data->reset();
-            *length = 0;
+            buf->reset();
             return Status::OK();
         }
-        auto buf = _buf_queue.front();
-        *length = buf->remaining();
-        data->reset(new uint8_t[*length]);
-        buf->get_bytes((char*)(data->get()), *length);
-
+        *buf = _buf_queue.front();
         _buf_queue.pop_front();
-        _buffered_bytes -= buf->limit;
+        _buffered_bytes -= (*buf)->limit;
         if (_use_proto) {
-            PDataRow** ptr = reinterpret_cast<PDataRow**>(data->get());
+            PDataRow** ptr = reinterpret_cast<PDataRow**>((*buf)->ptr + (*buf)->pos);
             _proto_buffered_bytes -= (sizeof(PDataRow*) + (*ptr)->GetCachedSize());
         }
         _put_cond.notify_one();
@@ -0,0 +1,123 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/stream_load/stream_load_pipe_splitter.h"
+
+#include "exec/plain_text_line_reader.h"
+#include "util/thread.h"
+
+namespace doris {
+
+StreamLoadPipeSplitter::StreamLoadPipeSplitter(RuntimeProfile* profile,
+                                               std::shared_ptr<StreamLoadPipe> source,
+                                               CompressType compress_type,
+                                               const std::string& line_delimiter, int skip_lines,
+                                               int num_pipes, size_t chunk_size)
+        : _profile(profile),
+          _source(std::move(source)),
+          _compress_type(compress_type),
+          _line_delimiter(line_delimiter),
+          _skip_lines(skip_lines),
+          _chunk_size(chunk_size) {
+    for (int i = 0; i < num_pipes; ++i) {
+        // each pipe buffers two chunks, so the splitter can go on while a scanner parses
+        _pipes.push_back(std::make_shared<StreamLoadPipe>(2 * chunk_size, chunk_size));
+    }
+}
+
+StreamLoadPipeSplitter::~StreamLoadPipeSplitter() {
+    if (_thread.joinable()) {
+        cancel("splitter destroyed");
+        _thread.join();
+    }
+}
+
+Status StreamLoadPipeSplitter::start() {
+    _thread = std::thread(&StreamLoadPipeSplitter::_split_thread, this);
+    return Status::OK();
+}
+
+void StreamLoadPipeSplitter::cancel(const std::string& reason) {
+    // the source is only cancelled while it is read, the body has been consumed otherwise
+    if (!_finished.load()) {
+        _source->cancel(reason);
+    }
+    for (auto& pipe : _pipes) {
+        pipe->cancel(reason);
+    }
+}
+
+void StreamLoadPipeSplitter::_split_thread() {
+    Thread::set_self_name("stream_load_splitter");
+    Status st = _split();
+    _finished.store(true);
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to split stream load body: " << st.get_error_msg();
+        for (auto& pipe : _pipes) {
+            pipe->cancel(st.get_error_msg());
+        }
+        return;
+    }
+    for (auto& pipe : _pipes) {
+        pipe->finish();
+    }
+}
+
+Status StreamLoadPipeSplitter::_split() {
+    Decompressor* decompressor = nullptr;
+    RETURN_IF_ERROR(Decompressor::create_decompressor(_compress_type, &decompressor));
+    std::unique_ptr<Decompressor> decompressor_holder(decompressor);
+    PlainTextLineReader line_reader(_profile, _source.get(), decompressor, -1, _line_delimiter,
+                                    _line_delimiter.size());
+
+    const uint8_t* line = nullptr;
+    size_t size = 0;
+    bool eof = false;
+    while (true) {
+        RETURN_IF_ERROR(line_reader.read_line(&line, &size, &eof));
+        if (eof) {
+            break;
+        }
+        if (_skip_lines > 0) {
+            _skip_lines--;
+            continue;
+        }
+        size_t line_size = size + _line_delimiter.size();
+        if (_chunk != nullptr && _chunk->remaining() < line_size) {
+            RETURN_IF_ERROR(_flush_chunk());
+        }
+        if (_chunk == nullptr) {
+            _chunk = ByteBuffer::allocate(std::max(_chunk_size, line_size));
+        }
+        _chunk->put_bytes(reinterpret_cast<const char*>(line), size);
+        _chunk->put_bytes(_line_delimiter.data(), _line_delimiter.size());
+    }
+    if (_chunk != nullptr) {
+        RETURN_IF_ERROR(_flush_chunk());
+    }
+    return Status::OK();
+}
+
+Status StreamLoadPipeSplitter::_flush_chunk() {
+    _chunk->flip();
+    RETURN_IF_ERROR(_pipes[_next_pipe]->append(_chunk));
+    _chunk.reset();
+    _next_pipe = (_next_pipe + 1) % _pipes.size();
+    return Status::OK();
+}
+
+} // namespace doris
@@ -0,0 +1,77 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/status.h"
+#include "exec/decompressor.h"
+#include "runtime/stream_load/stream_load_pipe.h"
+
+namespace doris {
+
+class RuntimeProfile;
+
+// StreamLoadPipeSplitter reads the body of a stream load from its pipe in a thread of its own,
+// decompresses it and deals it in chunks of whole lines to several uncompressed pipes, so that
+// a scanner on each of these pipes parses a part of the body in parallel.
+// The order of the lines is kept inside a chunk, but not between the chunks.
+class StreamLoadPipeSplitter {
+public:
+    // skip_lines: number of lines at the head of the body to drop, e.g. a csv header
+    StreamLoadPipeSplitter(RuntimeProfile* profile, std::shared_ptr<StreamLoadPipe> source,
+                           CompressType compress_type, const std::string& line_delimiter,
+                           int skip_lines, int num_pipes, size_t chunk_size);
+
+    // cancel and wait the split thread
+    ~StreamLoadPipeSplitter();
+
+    Status start();
+
+    // cancel the source and all the split pipes, called when the load or a scanner failed
+    void cancel(const std::string& reason);
+
+    const std::vector<std::shared_ptr<StreamLoadPipe>>& pipes() const { return _pipes; }
+
+private:
+    void _split_thread();
+    Status _split();
+
+    // append the filled chunk to the next pipe
+    Status _flush_chunk();
+
+    RuntimeProfile* _profile;
+    std::shared_ptr<StreamLoadPipe> _source;
+    CompressType _compress_type;
+    std::string _line_delimiter;
+    int _skip_lines;
+    size_t _chunk_size;
+
+    std::vector<std::shared_ptr<StreamLoadPipe>> _pipes;
+    size_t _next_pipe = 0;
+    ByteBufferPtr _chunk;
+
+    std::thread _thread;
+    std::atomic<bool> _finished {false};
+};
+
+} // namespace doris
@@ -159,7 +159,8 @@ struct TypeDescriptor {
 
     bool is_string_type() const {
         return type == TYPE_VARCHAR || type == TYPE_CHAR || type == TYPE_HLL ||
-               type == TYPE_OBJECT || type == TYPE_QUANTILE_STATE || type == TYPE_STRING;
+               type == TYPE_OBJECT || type == TYPE_QUANTILE_STATE || type == TYPE_STRING ||
+               type == TYPE_JSONB;
     }
 
     bool is_date_type() const { return type == TYPE_DATE || type == TYPE_DATETIME; }
@@ -170,7 +171,8 @@ struct TypeDescriptor {
 
     bool is_var_len_string_type() const {
         return type == TYPE_VARCHAR || type == TYPE_HLL || type == TYPE_CHAR ||
-               type == TYPE_OBJECT || type == TYPE_QUANTILE_STATE || type == TYPE_STRING;
+               type == TYPE_OBJECT || type == TYPE_QUANTILE_STATE || type == TYPE_STRING ||
+               type == TYPE_JSONB;
     }
 
     bool is_complex_type() const {
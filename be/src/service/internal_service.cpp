@@ -17,6 +17,8 @@
 
 #include "service/internal_service.h"
 
+#include <arrow/record_batch.h>
+
 #include "common/config.h"
 #include "gen_cpp/BackendService.h"
 #include "gen_cpp/internal_service.pb.h"
@@ -27,10 +29,12 @@
 #include "runtime/fragment_mgr.h"
 #include "runtime/load_channel_mgr.h"
 #include "runtime/result_buffer_mgr.h"
+#include "runtime/result_queue_mgr.h"
 #include "runtime/routine_load/routine_load_task_executor.h"
 #include "runtime/runtime_state.h"
 #include "runtime/thread_context.h"
 #include "service/brpc.h"
+#include "util/arrow/row_batch.h"
 #include "util/brpc_client_cache.h"
 #include "util/md5.h"
 #include "util/proto_util.h"
@@ -50,7 +54,10 @@ static void thread_context_deleter(void* d) {
 }
 
 PInternalServiceImpl::PInternalServiceImpl(ExecEnv* exec_env)
-        : _exec_env(exec_env), _tablet_worker_pool(config::number_tablet_writer_threads, 10240) {
+        : _exec_env(exec_env),
+          _tablet_worker_pool(config::number_tablet_writer_threads, 10240),
+          _arrow_fetch_pool(config::fetch_arrow_data_threads, 10240),
+          _point_lookup_pool(config::point_lookup_threads, 10240) {
     REGISTER_HOOK_METRIC(add_batch_task_queue_size,
                          [this]() { return _tablet_worker_pool.get_queue_size(); });
     CHECK_EQ(0, bthread_key_create(&btls_key, thread_context_deleter));
@@ -282,6 +289,52 @@ void PInternalServiceImpl::fetch_data(google::protobuf::RpcController* cntl_base
     _exec_env->result_mgr()->fetch_data(request->finst_id(), ctx);
 }
 
+void PInternalServiceImpl::fetch_arrow_data(google::protobuf::RpcController* cntl_base,
+                                            const PFetchArrowDataRequest* request,
+                                            PFetchArrowDataResult* result,
+                                            google::protobuf::Closure* done) {
+    _arrow_fetch_pool.offer([cntl_base, request, result, done, this]() {
+        brpc::ClosureGuard closure_guard(done);
+        brpc::Controller* cntl = static_cast<brpc::Controller*>(cntl_base);
+        TUniqueId fragment_instance_id = UniqueId(request->finst_id()).to_thrift();
+        std::shared_ptr<arrow::RecordBatch> record_batch;
+        bool eos = false;
+        Status st = _exec_env->result_queue_mgr()->fetch_result(fragment_instance_id,
+                                                                 &record_batch, &eos);
+        if (st.ok()) {
+            result->set_eos(eos);
+            if (!eos) {
+                std::string record_batch_str;
+                st = serialize_record_batch(*record_batch, &record_batch_str);
+                if (st.ok()) {
+                    result->set_num_rows(record_batch->num_rows());
+                    cntl->response_attachment().append(record_batch_str);
+                }
+            }
+        }
+        if (!st.ok()) {
+            LOG(WARNING) << "fragment_instance_id [" << print_id(fragment_instance_id)
+                         << "] fetch arrow data status [" << st.to_string() << "]";
+        }
+        st.to_protobuf(result->mutable_status());
+    });
+}
+
+void PInternalServiceImpl::tablet_key_lookup(google::protobuf::RpcController* controller,
+                                             const PTabletKeyLookupRequest* request,
+                                             PTabletKeyLookupResponse* response,
+                                             google::protobuf::Closure* done) {
+    _point_lookup_pool.offer([request, response, done, this]() {
+        brpc::ClosureGuard closure_guard(done);
+        Status st = _point_query_executor.lookup(*request, response);
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to look up key in tablet " << request->tablet_id()
+                         << ", errmsg=" << st.get_error_msg();
+        }
+        st.to_protobuf(response->mutable_status());
+    });
+}
+
 void PInternalServiceImpl::get_info(google::protobuf::RpcController* controller,
                                     const PProxyRequest* request, PProxyResult* response,
                                     google::protobuf::Closure* done) {
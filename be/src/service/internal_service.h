@@ -20,6 +20,7 @@
 #include "common/status.h"
 #include "gen_cpp/internal_service.pb.h"
 #include "runtime/cache/result_cache.h"
+#include "runtime/point_query_executor.h"
 #include "util/priority_thread_pool.hpp"
 
 namespace brpc {
@@ -63,6 +64,18 @@ public:
     void fetch_data(google::protobuf::RpcController* controller, const PFetchDataRequest* request,
                     PFetchDataResult* result, google::protobuf::Closure* done) override;
 
+    // fetch the next arrow record batch of a fragment instance that ends with a memory scratch
+    // sink, instances are independent so a client can fetch all of them in parallel
+    void fetch_arrow_data(google::protobuf::RpcController* controller,
+                          const PFetchArrowDataRequest* request, PFetchArrowDataResult* result,
+                          google::protobuf::Closure* done) override;
+
+    // look up the row of a key in a tablet, without planning and executing a fragment
+    void tablet_key_lookup(google::protobuf::RpcController* controller,
+                           const PTabletKeyLookupRequest* request,
+                           PTabletKeyLookupResponse* response,
+                           google::protobuf::Closure* done) override;
+
     void tablet_writer_open(google::protobuf::RpcController* controller,
                             const PTabletWriterOpenRequest* request,
                             PTabletWriterOpenResult* response,
@@ -139,6 +152,11 @@ private:
 private:
     ExecEnv* _exec_env;
     PriorityThreadPool _tablet_worker_pool;
+    // fetch_arrow_data blocks until a batch is produced, so it is not run on brpc workers
+    PriorityThreadPool _arrow_fetch_pool;
+    // tablet_key_lookup reads segment files, so it is not run on brpc workers either
+    PriorityThreadPool _point_lookup_pool;
+    PointQueryExecutor _point_query_executor;
 };
 
 } // namespace doris
@@ -0,0 +1,229 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "util/arrow/block_convertor.h"
+
+#include <arrow/array.h>
+#include <arrow/array/builder_primitive.h>
+#include <arrow/builder.h>
+#include <arrow/memory_pool.h>
+#include <arrow/record_batch.h>
+#include <arrow/status.h>
+#include <arrow/type.h>
+#include <arrow/visit_type_inline.h>
+#include <arrow/visitor.h>
+
+#include <memory>
+#include <vector>
+
+#include "common/logging.h"
+#include "gutil/strings/substitute.h"
+#include "util/arrow/utils.h"
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+
+namespace doris {
+
+// Convert Block to an Arrow::Array
+// Every column is converted as a whole, numeric columns are appended to the
+// arrow builder with one call instead of one call per row.
+class FromBlockConverter : public arrow::TypeVisitor {
+public:
+    FromBlockConverter(const vectorized::Block& block, const std::shared_ptr<arrow::Schema>& schema,
+                       arrow::MemoryPool* pool)
+            : _block(block), _schema(schema), _pool(pool), _cur_field_idx(-1) {}
+
+    ~FromBlockConverter() override = default;
+
+    // Use base class function
+    using arrow::TypeVisitor::Visit;
+
+#define PRIMITIVE_VISIT(TYPE) \
+    arrow::Status Visit(const arrow::TYPE& type) override { return _visit(type); }
+
+    PRIMITIVE_VISIT(Int8Type);
+    PRIMITIVE_VISIT(Int16Type);
+    PRIMITIVE_VISIT(Int32Type);
+    PRIMITIVE_VISIT(Int64Type);
+    PRIMITIVE_VISIT(FloatType);
+    PRIMITIVE_VISIT(DoubleType);
+
+#undef PRIMITIVE_VISIT
+
+    // process string-transformable field
+    arrow::Status Visit(const arrow::StringType& type) override {
+        arrow::StringBuilder builder(_pool);
+        size_t num_rows = _block.rows();
+        ARROW_RETURN_NOT_OK(builder.Reserve(num_rows));
+        const auto* string_column = vectorized::check_and_get_column<vectorized::ColumnString>(
+                *_cur_column);
+        if (string_column != nullptr) {
+            ARROW_RETURN_NOT_OK(builder.ReserveData(string_column->get_chars().size()));
+        }
+        for (size_t i = 0; i < num_rows; ++i) {
+            if (_is_null(i)) {
+                ARROW_RETURN_NOT_OK(builder.AppendNull());
+                continue;
+            }
+            if (string_column != nullptr) {
+                auto string_ref = string_column->get_data_at(i);
+                ARROW_RETURN_NOT_OK(builder.Append(string_ref.data, string_ref.size));
+            } else {
+                // date, datetime and largeint are sent as their text form
+                auto string_temp = _cur_type->to_string(*_cur_column, i);
+                ARROW_RETURN_NOT_OK(builder.Append(string_temp.data(), string_temp.size()));
+            }
+        }
+        return builder.Finish(&_arrays[_cur_field_idx]);
+    }
+
+    // process doris DecimalV2
+    arrow::Status Visit(const arrow::Decimal128Type& type) override {
+        const auto* decimal_column = vectorized::check_and_get_column<
+                vectorized::ColumnDecimal<vectorized::Decimal128>>(*_cur_column);
+        if (decimal_column == nullptr) {
+            return _type_error(type);
+        }
+        std::shared_ptr<arrow::DataType> s_decimal_ptr =
+                std::make_shared<arrow::Decimal128Type>(27, 9);
+        arrow::Decimal128Builder builder(s_decimal_ptr, _pool);
+        size_t num_rows = _block.rows();
+        ARROW_RETURN_NOT_OK(builder.Reserve(num_rows));
+        const auto& data = decimal_column->get_data();
+        for (size_t i = 0; i < num_rows; ++i) {
+            if (_is_null(i)) {
+                ARROW_RETURN_NOT_OK(builder.AppendNull());
+                continue;
+            }
+            int64_t high = data[i].value >> 64;
+            uint64_t low = data[i].value;
+            arrow::Decimal128 value(high, low);
+            ARROW_RETURN_NOT_OK(builder.Append(value));
+        }
+        return builder.Finish(&_arrays[_cur_field_idx]);
+    }
+
+    // process boolean
+    arrow::Status Visit(const arrow::BooleanType& type) override {
+        const auto* bool_column =
+                vectorized::check_and_get_column<vectorized::ColumnUInt8>(*_cur_column);
+        if (bool_column == nullptr) {
+            return _type_error(type);
+        }
+        arrow::BooleanBuilder builder(_pool);
+        ARROW_RETURN_NOT_OK(builder.AppendValues(bool_column->get_data().data(), _block.rows(),
+                                                 _valid_bytes()));
+        return builder.Finish(&_arrays[_cur_field_idx]);
+    }
+
+    Status convert(std::shared_ptr<arrow::RecordBatch>* out);
+
+private:
+    template <typename T>
+    typename std::enable_if<std::is_base_of<arrow::PrimitiveCType, T>::value, arrow::Status>::type
+    _visit(const T& type) {
+        using ColumnType = vectorized::ColumnVector<typename T::c_type>;
+        const auto* column = vectorized::check_and_get_column<ColumnType>(*_cur_column);
+        if (column == nullptr) {
+            return _type_error(type);
+        }
+        arrow::NumericBuilder<T> builder(_pool);
+        ARROW_RETURN_NOT_OK(
+                builder.AppendValues(column->get_data().data(), _block.rows(), _valid_bytes()));
+        return builder.Finish(&_arrays[_cur_field_idx]);
+    }
+
+    bool _is_null(size_t row) const { return _null_map != nullptr && (*_null_map)[row]; }
+
+    // arrow takes a byte per row which is not zero for a valid value, that is the
+    // inverse of the null map
+    const uint8_t* _valid_bytes() {
+        if (_null_map == nullptr) {
+            return nullptr;
+        }
+        _valid_bytes_buf.resize(_null_map->size());
+        for (size_t i = 0; i < _null_map->size(); ++i) {
+            _valid_bytes_buf[i] = !(*_null_map)[i];
+        }
+        return _valid_bytes_buf.data();
+    }
+
+    arrow::Status _type_error(const arrow::DataType& type) const {
+        LOG(WARNING) << "can't convert column " << _cur_column->get_name() << " to arrow type "
+                     << type.ToString();
+        return arrow::Status::TypeError("unsupported column type");
+    }
+
+private:
+    const vectorized::Block& _block;
+    const std::shared_ptr<arrow::Schema>& _schema;
+    arrow::MemoryPool* _pool;
+
+    size_t _cur_field_idx;
+    // keeps the column of current field alive when it is materialized from a const column
+    vectorized::ColumnPtr _full_column;
+    // the not nullable column and type of current field
+    vectorized::ColumnPtr _cur_column;
+    vectorized::DataTypePtr _cur_type;
+    const vectorized::NullMap* _null_map = nullptr;
+    std::vector<uint8_t> _valid_bytes_buf;
+
+    std::vector<std::shared_ptr<arrow::Array>> _arrays;
+};
+
+Status FromBlockConverter::convert(std::shared_ptr<arrow::RecordBatch>* out) {
+    size_t num_fields = _schema->num_fields();
+    if (_block.columns() != num_fields) {
+        return Status::InvalidArgument(strings::Substitute(
+                "number fields not match, block=$0, schema=$1", _block.columns(), num_fields));
+    }
+
+    _arrays.resize(num_fields);
+
+    for (size_t idx = 0; idx < num_fields; ++idx) {
+        _cur_field_idx = idx;
+        const auto& column_with_type = _block.get_by_position(idx);
+        _full_column = column_with_type.column->convert_to_full_column_if_const();
+        _cur_column = _full_column;
+        _cur_type = vectorized::remove_nullable(column_with_type.type);
+        _null_map = nullptr;
+        if (const auto* nullable_column =
+                    vectorized::check_and_get_column<vectorized::ColumnNullable>(*_full_column)) {
+            _null_map = &nullable_column->get_null_map_data();
+            _cur_column = nullable_column->get_nested_column_ptr();
+        }
+        auto arrow_st = arrow::VisitTypeInline(*_schema->field(idx)->type(), this);
+        if (!arrow_st.ok()) {
+            return to_status(arrow_st);
+        }
+    }
+    *out = arrow::RecordBatch::Make(_schema, _block.rows(), std::move(_arrays));
+    return Status::OK();
+}
+
+Status convert_to_arrow_batch(const vectorized::Block& block,
+                              const std::shared_ptr<arrow::Schema>& schema,
+                              arrow::MemoryPool* pool,
+                              std::shared_ptr<arrow::RecordBatch>* result) {
+    FromBlockConverter converter(block, schema, pool);
+    return converter.convert(result);
+}
+
+} // namespace doris
@@ -27,6 +27,7 @@
 
 namespace arrow {
 
+class DataType;
 class MemoryPool;
 class RecordBatch;
 class Schema;
@@ -38,6 +39,10 @@ namespace doris {
 class ObjectPool;
 class RowBatch;
 class RowDescriptor;
+struct TypeDescriptor;
+
+// Convert Doris TypeDescriptor to Arrow DataType.
+Status convert_to_arrow_type(const TypeDescriptor& type, std::shared_ptr<arrow::DataType>* result);
 
 // Convert Doris RowDescriptor to Arrow Schema.
 Status convert_to_arrow_schema(const RowDescriptor& row_desc,
@@ -20,6 +20,7 @@
 #include <string.h>
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 
 #include "common/logging.h"
@@ -35,7 +36,20 @@ struct ByteBuffer {
         return ptr;
     }
 
-    ~ByteBuffer() { delete[] ptr; }
+    // wraps memory owned by someone else without copying it, release is called instead of
+    // freeing the memory when the buffer is destroyed. The buffer is meant to be read only.
+    static ByteBufferPtr wrap(char* data, size_t size, std::function<void()> release) {
+        ByteBufferPtr ptr(new ByteBuffer(data, size, std::move(release)));
+        return ptr;
+    }
+
+    ~ByteBuffer() {
+        if (_release) {
+            _release();
+        } else {
+            delete[] ptr;
+        }
+    }
 
     void put_bytes(const char* data, size_t size) {
         memcpy(ptr + pos, data, size);
@@ -64,6 +78,11 @@ struct ByteBuffer {
 private:
     ByteBuffer(size_t capacity_)
             : ptr(new char[capacity_]), pos(0), limit(capacity_), capacity(capacity_) {}
+
+    ByteBuffer(char* data, size_t size, std::function<void()> release)
+            : ptr(data), pos(0), limit(size), capacity(size), _release(std::move(release)) {}
+
+    std::function<void()> _release;
 };
 
 } // namespace doris
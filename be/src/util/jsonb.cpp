@@ -0,0 +1,333 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/jsonb.h"
+
+#include <fmt/format.h>
+#include <rapidjson/error/en.h>
+#include <rapidjson/memorystream.h>
+#include <rapidjson/reader.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace doris {
+
+namespace {
+
+// Size of type, size and count of a container.
+constexpr size_t CONTAINER_HEADER_SIZE = 9;
+
+std::string_view entry_key(const uint8_t* entry) {
+    return std::string_view(reinterpret_cast<const char*>(entry + sizeof(uint32_t)),
+                            decode_fixed32_le(entry));
+}
+
+// Build jsonb from the SAX events of rapidjson::Reader. The size and count of a container
+// are unknown until it ends, so they are reserved when it starts and filled in when it ends.
+class JsonbBuilder : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, JsonbBuilder> {
+public:
+    explicit JsonbBuilder(std::string* out) : _out(out) {}
+
+    bool Null() {
+        _begin_value();
+        _put_type(JsonbType::NULL_VALUE);
+        return true;
+    }
+
+    bool Bool(bool b) {
+        _begin_value();
+        _put_type(b ? JsonbType::TRUE_VALUE : JsonbType::FALSE_VALUE);
+        return true;
+    }
+
+    bool Int(int i) { return Int64(i); }
+    bool Uint(unsigned u) { return Int64(u); }
+
+    bool Int64(int64_t i) {
+        _begin_value();
+        _put_type(JsonbType::INT64);
+        put_fixed64_le(_out, static_cast<uint64_t>(i));
+        return true;
+    }
+
+    bool Uint64(uint64_t u) {
+        if (u <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+            return Int64(static_cast<int64_t>(u));
+        }
+        _begin_value();
+        _put_type(JsonbType::UINT64);
+        put_fixed64_le(_out, u);
+        return true;
+    }
+
+    bool Double(double d) {
+        _begin_value();
+        _put_type(JsonbType::DOUBLE);
+        uint64_t bits = 0;
+        memcpy(&bits, &d, sizeof(d));
+        put_fixed64_le(_out, bits);
+        return true;
+    }
+
+    bool String(const char* str, rapidjson::SizeType length, bool /*copy*/) {
+        _begin_value();
+        _put_type(JsonbType::STRING);
+        put_fixed32_le(_out, length);
+        _out->append(str, length);
+        return true;
+    }
+
+    bool StartObject() { return _start_container(JsonbType::OBJECT); }
+
+    bool Key(const char* str, rapidjson::SizeType length, bool /*copy*/) {
+        // the offset of a member points to its key
+        _record_offset();
+        put_fixed32_le(_out, length);
+        _out->append(str, length);
+        return true;
+    }
+
+    bool EndObject(rapidjson::SizeType /*count*/) { return _end_container(); }
+
+    bool StartArray() { return _start_container(JsonbType::ARRAY); }
+
+    bool EndArray(rapidjson::SizeType /*count*/) { return _end_container(); }
+
+private:
+    struct Container {
+        size_t start;
+        bool is_object;
+        std::vector<uint32_t> offsets;
+    };
+
+    void _put_type(JsonbType type) { _out->push_back(static_cast<char>(type)); }
+
+    void _record_offset() {
+        Container& container = _stack.back();
+        container.offsets.push_back(_out->size() - container.start - CONTAINER_HEADER_SIZE);
+    }
+
+    void _begin_value() {
+        // members of object are recorded by Key()
+        if (!_stack.empty() && !_stack.back().is_object) {
+            _record_offset();
+        }
+    }
+
+    bool _start_container(JsonbType type) {
+        _begin_value();
+        _stack.push_back({_out->size(), type == JsonbType::OBJECT, {}});
+        _put_type(type);
+        // size and count
+        _out->append(CONTAINER_HEADER_SIZE - 1, '\0');
+        return true;
+    }
+
+    bool _end_container() {
+        Container& container = _stack.back();
+        auto* elements = reinterpret_cast<const uint8_t*>(_out->data()) + container.start +
+                         CONTAINER_HEADER_SIZE;
+        if (container.is_object) {
+            // stable, so the first one of duplicated keys is found by binary search
+            std::stable_sort(container.offsets.begin(), container.offsets.end(),
+                             [elements](uint32_t lhs, uint32_t rhs) {
+                                 return entry_key(elements + lhs) < entry_key(elements + rhs);
+                             });
+        }
+        for (uint32_t offset : container.offsets) {
+            put_fixed32_le(_out, offset);
+        }
+
+        auto* header = reinterpret_cast<uint8_t*>(_out->data()) + container.start;
+        encode_fixed32_le(header + 1, _out->size() - container.start - 5);
+        encode_fixed32_le(header + 5, container.offsets.size());
+        _stack.pop_back();
+        return true;
+    }
+
+    std::string* _out;
+    std::vector<Container> _stack;
+};
+
+} // namespace
+
+double JsonbValue::get_double() const {
+    uint64_t bits = decode_fixed64_le(_data + 1);
+    double d = 0;
+    memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+double JsonbValue::get_number() const {
+    switch (type()) {
+    case JsonbType::INT64:
+        return get_int64();
+    case JsonbType::UINT64:
+        return get_uint64();
+    case JsonbType::DOUBLE:
+        return get_double();
+    default:
+        return 0;
+    }
+}
+
+bool JsonbValue::find_key(std::string_view key, JsonbValue* value) const {
+    const uint8_t* elements = _elements();
+    const uint8_t* index = _index();
+    uint32_t low = 0;
+    uint32_t high = count();
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (entry_key(elements + decode_fixed32_le(index + mid * sizeof(uint32_t))) < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low == count()) {
+        return false;
+    }
+    const uint8_t* entry = elements + decode_fixed32_le(index + low * sizeof(uint32_t));
+    std::string_view found = entry_key(entry);
+    if (found != key) {
+        return false;
+    }
+    *value = JsonbValue(entry + sizeof(uint32_t) + found.size());
+    return true;
+}
+
+size_t JsonbValue::byte_size() const {
+    switch (type()) {
+    case JsonbType::NULL_VALUE:
+    case JsonbType::TRUE_VALUE:
+    case JsonbType::FALSE_VALUE:
+        return 1;
+    case JsonbType::INT64:
+    case JsonbType::UINT64:
+    case JsonbType::DOUBLE:
+        return 1 + sizeof(uint64_t);
+    case JsonbType::STRING:
+    case JsonbType::ARRAY:
+    case JsonbType::OBJECT:
+        return 1 + sizeof(uint32_t) + decode_fixed32_le(_data + 1);
+    }
+    return 1;
+}
+
+void JsonbValue::to_json(rapidjson::Writer<rapidjson::StringBuffer>* writer) const {
+    switch (type()) {
+    case JsonbType::NULL_VALUE:
+        writer->Null();
+        break;
+    case JsonbType::TRUE_VALUE:
+    case JsonbType::FALSE_VALUE:
+        writer->Bool(get_bool());
+        break;
+    case JsonbType::INT64:
+        writer->Int64(get_int64());
+        break;
+    case JsonbType::UINT64:
+        writer->Uint64(get_uint64());
+        break;
+    case JsonbType::DOUBLE:
+        writer->Double(get_double());
+        break;
+    case JsonbType::STRING: {
+        std::string_view str = get_string();
+        writer->String(str.data(), str.size());
+        break;
+    }
+    case JsonbType::ARRAY: {
+        writer->StartArray();
+        // walk the elements instead of the index, they are in the order of input
+        const uint8_t* element = _elements();
+        for (uint32_t i = 0; i < count(); ++i) {
+            JsonbValue value(element);
+            value.to_json(writer);
+            element += value.byte_size();
+        }
+        writer->EndArray();
+        break;
+    }
+    case JsonbType::OBJECT: {
+        writer->StartObject();
+        const uint8_t* entry = _elements();
+        for (uint32_t i = 0; i < count(); ++i) {
+            std::string_view key = entry_key(entry);
+            writer->Key(key.data(), key.size());
+            JsonbValue value(entry + sizeof(uint32_t) + key.size());
+            value.to_json(writer);
+            entry = reinterpret_cast<const uint8_t*>(value.data()) + value.byte_size();
+        }
+        writer->EndObject();
+        break;
+    }
+    }
+}
+
+std::string JsonbValue::to_json_string() const {
+    rapidjson::StringBuffer buf;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+    to_json(&writer);
+    return std::string(buf.GetString(), buf.GetSize());
+}
+
+Status JsonbDocument::from_json(const char* json, size_t size, std::string* jsonb) {
+    jsonb->clear();
+    jsonb->push_back(static_cast<char>(VERSION));
+
+    JsonbBuilder builder(jsonb);
+    rapidjson::Reader reader;
+    rapidjson::MemoryStream stream(json, size);
+    rapidjson::ParseResult result = reader.Parse(stream, builder);
+    if (result.IsError()) {
+        return Status::InvalidArgument(
+                fmt::format("invalid json: {}, offset: {}",
+                            rapidjson::GetParseError_En(result.Code()), result.Offset()));
+    }
+    return Status::OK();
+}
+
+Status JsonbDocument::get_root(const char* jsonb, size_t size, JsonbValue* root) {
+    const auto* data = reinterpret_cast<const uint8_t*>(jsonb);
+    if (size < 2 || data[0] != VERSION || data[1] > static_cast<uint8_t>(JsonbType::OBJECT)) {
+        return Status::Corruption("invalid jsonb header");
+    }
+    JsonbValue value(data + 1);
+    if (data[1] >= static_cast<uint8_t>(JsonbType::STRING) && size < 1 + 1 + sizeof(uint32_t)) {
+        return Status::Corruption("invalid jsonb header");
+    }
+    if (value.byte_size() != size - 1) {
+        return Status::Corruption(fmt::format("invalid jsonb size, expect {}, actual {}",
+                                              value.byte_size() + 1, size));
+    }
+    *root = value;
+    return Status::OK();
+}
+
+std::string JsonbDocument::to_json_string(const char* jsonb, size_t size) {
+    JsonbValue root;
+    if (!get_root(jsonb, size, &root).ok()) {
+        return "null";
+    }
+    return root.to_json_string();
+}
+
+} // namespace doris
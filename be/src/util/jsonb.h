@@ -0,0 +1,141 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "common/status.h"
+#include "util/coding.h"
+
+namespace doris {
+
+// JSONB is a binary representation of a json document. The document is parsed once when it
+// is loaded, after that a member of object or an element of array is found by looking up
+// the offset index of its parent instead of parsing the json text again.
+//
+// All integers are little endian.
+//
+//   document := version(uint8) value
+//   value    := type(uint8) payload
+//
+//   NULL, TRUE, FALSE     : no payload
+//   INT64, UINT64, DOUBLE : 8 bytes
+//   STRING                : length(uint32) bytes
+//   ARRAY                 : size(uint32) count(uint32) value * count offset(uint32) * count
+//   OBJECT                : size(uint32) count(uint32) entry * count offset(uint32) * count
+//   entry                 : key_length(uint32) key_bytes value
+//
+// size is the number of bytes after the size field. An offset is relative to the first
+// element of the container. The offsets of an array are in the order of elements, so the
+// i-th element is found directly. The offsets of an object are sorted by key, so a member
+// is found by binary search, and the entries themselves keep the order of the input.
+enum class JsonbType : uint8_t {
+    NULL_VALUE = 0,
+    TRUE_VALUE = 1,
+    FALSE_VALUE = 2,
+    INT64 = 3,
+    UINT64 = 4,
+    DOUBLE = 5,
+    STRING = 6,
+    ARRAY = 7,
+    OBJECT = 8,
+};
+
+// A read only view of a value in a jsonb document, it's valid as long as the document is.
+class JsonbValue {
+public:
+    JsonbValue() = default;
+    explicit JsonbValue(const void* data) : _data(static_cast<const uint8_t*>(data)) {}
+
+    JsonbType type() const { return static_cast<JsonbType>(_data[0]); }
+
+    bool is_null() const { return type() == JsonbType::NULL_VALUE; }
+    bool is_bool() const {
+        return type() == JsonbType::TRUE_VALUE || type() == JsonbType::FALSE_VALUE;
+    }
+    bool is_number() const {
+        return type() == JsonbType::INT64 || type() == JsonbType::UINT64 ||
+               type() == JsonbType::DOUBLE;
+    }
+    bool is_string() const { return type() == JsonbType::STRING; }
+    bool is_array() const { return type() == JsonbType::ARRAY; }
+    bool is_object() const { return type() == JsonbType::OBJECT; }
+
+    bool get_bool() const { return type() == JsonbType::TRUE_VALUE; }
+    int64_t get_int64() const { return static_cast<int64_t>(decode_fixed64_le(_data + 1)); }
+    uint64_t get_uint64() const { return decode_fixed64_le(_data + 1); }
+    double get_double() const;
+    // Any number as double.
+    double get_number() const;
+
+    std::string_view get_string() const {
+        return std::string_view(reinterpret_cast<const char*>(_data + 5),
+                                decode_fixed32_le(_data + 1));
+    }
+
+    // Number of elements of an array or members of an object.
+    uint32_t count() const { return decode_fixed32_le(_data + 5); }
+
+    // The index-th element of an array, index must be less than count().
+    JsonbValue array_at(uint32_t index) const {
+        return JsonbValue(_elements() + decode_fixed32_le(_index() + index * sizeof(uint32_t)));
+    }
+
+    // Find the value of key in an object. If key appears more than once, the first one is
+    // returned, which is the same as rapidjson.
+    bool find_key(std::string_view key, JsonbValue* value) const;
+
+    // Number of bytes of this value, including the type.
+    size_t byte_size() const;
+
+    // Write the value as compact json text.
+    void to_json(rapidjson::Writer<rapidjson::StringBuffer>* writer) const;
+
+    std::string to_json_string() const;
+
+    const char* data() const { return reinterpret_cast<const char*>(_data); }
+
+private:
+    const uint8_t* _elements() const { return _data + 9; }
+    const uint8_t* _index() const {
+        return _data + 5 + decode_fixed32_le(_data + 1) - count() * sizeof(uint32_t);
+    }
+
+    const uint8_t* _data = nullptr;
+};
+
+class JsonbDocument {
+public:
+    static constexpr uint8_t VERSION = 1;
+
+    // Convert json text to jsonb. Return error if json is invalid.
+    static Status from_json(const char* json, size_t size, std::string* jsonb);
+
+    // Get the root value of a jsonb document.
+    static Status get_root(const char* jsonb, size_t size, JsonbValue* root);
+
+    // Convert jsonb to compact json text, an invalid document is converted to "null".
+    static std::string to_json_string(const char* jsonb, size_t size);
+};
+
+} // namespace doris
@@ -23,6 +23,8 @@
 #include <immintrin.h>
 #elif __SSE2__
 #include <emmintrin.h>
+#elif __aarch64__
+#include "util/sse2neon.h"
 #endif
 
 namespace doris {
@@ -57,5 +59,32 @@ inline uint32_t bytes32_mask_to_bits32_mask(const bool* data) {
     return bytes32_mask_to_bits32_mask(reinterpret_cast<const uint8_t*>(data));
 }
 
+/// Compare 64 bytes with c, bit i of the result is set if data[i] == c
+inline uint64_t bytes64_mask_of_char(const uint8_t* data, uint8_t c) {
+#ifdef __AVX2__
+    auto c32 = _mm256_set1_epi8(static_cast<char>(c));
+    uint64_t low = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)), c32)));
+    uint64_t high = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 32)), c32)));
+    return low | (high << 32);
+#elif defined(__SSE2__) || defined(__aarch64__)
+    auto c16 = _mm_set1_epi8(static_cast<char>(c));
+    uint64_t mask = 0;
+    for (int i = 0; i < 4; ++i) {
+        uint64_t bits = static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 16)), c16)));
+        mask |= bits << (i * 16);
+    }
+    return mask;
+#else
+    uint64_t mask = 0;
+    for (std::size_t i = 0; i < 64; ++i) {
+        mask |= static_cast<uint64_t>(c == data[i]) << i;
+    }
+    return mask;
+#endif
+}
+
 } // namespace simd
 } // namespace doris
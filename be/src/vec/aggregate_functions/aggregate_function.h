@@ -87,6 +87,16 @@ public:
     virtual void add(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
                      Arena* arena) const = 0;
 
+    /** Returns true if a row added by "add" can be taken back by "remove", so that a sliding
+      *  window frame can be evaluated incrementally. Only exact (not floating point) states are
+      *  removable.
+      */
+    virtual bool is_removable() const { return false; }
+
+    /// Removes a value that was added before with "add". Only called when is_removable() is true.
+    virtual void remove(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
+                        Arena* arena) const {}
+
     /// Merges state (on which place points to) with other state of current aggregation function.
     virtual void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs,
                        Arena* arena) const = 0;
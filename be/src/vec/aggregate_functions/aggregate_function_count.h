@@ -50,6 +50,12 @@ public:
         ++data(place).count;
     }
 
+    bool is_removable() const override { return true; }
+
+    void remove(AggregateDataPtr __restrict place, const IColumn**, size_t, Arena*) const override {
+        --data(place).count;
+    }
+
     void reset(AggregateDataPtr place) const override {
         AggregateFunctionCount::data(place).count = 0;
     }
@@ -90,6 +96,13 @@ public:
         data(place).count += !assert_cast<const ColumnNullable&>(*columns[0]).is_null_at(row_num);
     }
 
+    bool is_removable() const override { return true; }
+
+    void remove(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
+                Arena*) const override {
+        data(place).count -= !assert_cast<const ColumnNullable&>(*columns[0]).is_null_at(row_num);
+    }
+
     void reset(AggregateDataPtr place) const override { data(place).count = 0; }
 
     void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs,
@@ -80,6 +80,14 @@ public:
         this->data(place).add(column.get_data()[row_num]);
     }
 
+    bool is_removable() const override { return !std::is_floating_point_v<TResult>; }
+
+    void remove(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
+                Arena*) const override {
+        const auto& column = static_cast<const ColVecType&>(*columns[0]);
+        this->data(place).sum -= column.get_data()[row_num];
+    }
+
     void reset(AggregateDataPtr place) const override { this->data(place).sum = {}; }
 
     void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs,
@@ -0,0 +1,109 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/aggregate_functions/window_segment_tree.h"
+
+namespace doris::vectorized {
+
+WindowSegmentTree::WindowSegmentTree(const IAggregateFunction* function,
+                                     std::vector<const IColumn*> columns, int64_t begin,
+                                     int64_t end)
+        : _function(function),
+          _columns(std::move(columns)),
+          _begin(begin),
+          _end(std::max(begin, end)) {
+    // the first level is built from the rows, every other level from the level below it
+    int64_t rows = _end - _begin;
+    if (rows == 0) {
+        return;
+    }
+    std::vector<AggregateDataPtr> nodes((rows + FANOUT - 1) / FANOUT);
+    for (int64_t i = 0; i < static_cast<int64_t>(nodes.size()); ++i) {
+        nodes[i] = _create_state();
+        int64_t node_end = std::min(_begin + (i + 1) * FANOUT, _end);
+        for (int64_t row = _begin + i * FANOUT; row < node_end; ++row) {
+            _function->add(nodes[i], _columns.data(), row, &_arena);
+        }
+    }
+    _levels.emplace_back(std::move(nodes));
+
+    while (_levels.back().size() > 1) {
+        const auto& children = _levels.back();
+        std::vector<AggregateDataPtr> parents((children.size() + FANOUT - 1) / FANOUT);
+        for (size_t i = 0; i < parents.size(); ++i) {
+            parents[i] = _create_state();
+            size_t child_end = std::min<size_t>((i + 1) * FANOUT, children.size());
+            for (size_t child = i * FANOUT; child < child_end; ++child) {
+                _function->merge(parents[i], children[child], &_arena);
+            }
+        }
+        _levels.emplace_back(std::move(parents));
+    }
+}
+
+WindowSegmentTree::~WindowSegmentTree() {
+    for (auto& level : _levels) {
+        for (auto place : level) {
+            _function->destroy(place);
+        }
+    }
+}
+
+AggregateDataPtr WindowSegmentTree::_create_state() {
+    AggregateDataPtr place = _arena.aligned_alloc(_function->size_of_data(),
+                                                  _function->align_of_data());
+    _function->create(place);
+    return place;
+}
+
+void WindowSegmentTree::aggregate(AggregateDataPtr place, int64_t frame_start,
+                                  int64_t frame_end) const {
+    // walk up from the rows, at each level only the nodes not covered by a whole parent are
+    // added, the rest of the frame is left to the parents
+    int64_t start = std::max(frame_start, _begin) - _begin;
+    int64_t end = std::min(frame_end, _end) - _begin;
+    size_t level = 0;
+    while (start < end) {
+        int64_t parent_start = (start + FANOUT - 1) / FANOUT;
+        int64_t parent_end = end / FANOUT;
+        if (level == _levels.size() || parent_start >= parent_end) {
+            _aggregate_level(place, level, start, end);
+            break;
+        }
+        _aggregate_level(place, level, start, parent_start * FANOUT);
+        _aggregate_level(place, level, parent_end * FANOUT, end);
+        start = parent_start;
+        end = parent_end;
+        ++level;
+    }
+}
+
+void WindowSegmentTree::_aggregate_level(AggregateDataPtr place, size_t level, int64_t start,
+                                         int64_t end) const {
+    if (level == 0) {
+        for (int64_t row = _begin + start; row < _begin + end; ++row) {
+            _function->add(place, _columns.data(), row, nullptr);
+        }
+        return;
+    }
+    const auto& nodes = _levels[level - 1];
+    for (int64_t i = start; i < end; ++i) {
+        _function->merge(place, nodes[i], nullptr);
+    }
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,63 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <vector>
+
+#include "vec/aggregate_functions/aggregate_function.h"
+#include "vec/common/arena.h"
+
+namespace doris::vectorized {
+
+/** Segment tree of aggregate states over the rows of one partition.
+  * Used to evaluate a sliding window frame of a function that can not take rows back
+  *  (e.g. min/max), so a frame costs O(FANOUT * log(rows)) instead of O(frame size).
+  * The leaves are the input rows themselves, only the inner nodes are materialized as states
+  *  that are combined with IAggregateFunction::merge.
+  */
+class WindowSegmentTree {
+public:
+    static constexpr int64_t FANOUT = 16;
+
+    /// Builds the tree over rows [begin, end) of columns, the columns must outlive the tree.
+    WindowSegmentTree(const IAggregateFunction* function, std::vector<const IColumn*> columns,
+                      int64_t begin, int64_t end);
+
+    ~WindowSegmentTree();
+
+    /// Adds the rows [frame_start, frame_end) to place, the frame is clipped to the tree rows.
+    void aggregate(AggregateDataPtr place, int64_t frame_start, int64_t frame_end) const;
+
+    int64_t begin() const { return _begin; }
+    int64_t end() const { return _end; }
+
+private:
+    AggregateDataPtr _create_state();
+    void _aggregate_level(AggregateDataPtr place, size_t level, int64_t start, int64_t end) const;
+
+    const IAggregateFunction* _function;
+    std::vector<const IColumn*> _columns;
+    int64_t _begin;
+    int64_t _end;
+
+    Arena _arena;
+    /// _levels[i] holds the nodes of level i + 1, a node of level i covers FANOUT^i rows.
+    std::vector<std::vector<AggregateDataPtr>> _levels;
+};
+
+} // namespace doris::vectorized
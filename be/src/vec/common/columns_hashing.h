@@ -125,6 +125,32 @@ struct HashMethodSerialized
                          const HashMethodContextPtr&)
             : key_columns(key_columns_), keys_size(key_columns_.size()) {}
 
+    using Base::emplace_key;
+    using Base::find_key;
+
+    /// A serialized key is put into the arena when it is got, so it must be got only once for
+    /// each row and batched hashing is a no-op for it, the hash values are not used.
+    template <typename Data>
+    ALWAYS_INLINE void get_hash_values(const Data&, size_t rows, Arena&,
+                                       std::vector<size_t>& hash_values) {
+        hash_values.resize(rows);
+    }
+
+    template <typename Data>
+    ALWAYS_INLINE typename Base::EmplaceResult emplace_key(Data& data, size_t /*hash_value*/,
+                                                           size_t row, Arena& pool) {
+        return Base::emplace_key(data, row, pool);
+    }
+
+    template <typename Data>
+    ALWAYS_INLINE typename Base::FindResult find_key(Data& data, size_t /*hash_value*/, size_t row,
+                                                     Arena& pool) {
+        return Base::find_key(data, row, pool);
+    }
+
+    template <bool READ, typename Data>
+    ALWAYS_INLINE void prefetch_by_hash(Data&, size_t) {}
+
 protected:
     friend class columns_hashing_impl::HashMethodBase<Self, Value, Mapped, false>;
 
@@ -210,6 +236,21 @@ struct HashMethodSingleLowNullableColumn : public SingleColumnMethod {
 
     template <typename Data>
     ALWAYS_INLINE EmplaceResult emplace_key(Data& data, size_t row, Arena& pool) {
+        return _emplace_key(data, row, pool);
+    }
+
+    /// The hash value of a null row is computed from the default value of nested column, it's
+    /// not used.
+    template <typename Data>
+    ALWAYS_INLINE EmplaceResult emplace_key(Data& data, size_t hash_value, size_t row,
+                                            Arena& pool) {
+        return _emplace_key(data, row, pool, hash_value);
+    }
+
+private:
+    template <typename Data, typename... HashValue>
+    ALWAYS_INLINE EmplaceResult _emplace_key(Data& data, size_t row, Arena& pool,
+                                             HashValue... hash_value) {
         if (key_columns[0]->is_null_at(row)) {
             bool has_null_key = data.has_null_key_data();
             data.has_null_key_data() = true;
@@ -225,7 +266,7 @@ struct HashMethodSingleLowNullableColumn : public SingleColumnMethod {
 
         bool inserted = false;
         typename Data::LookupResult it;
-        data.emplace(key_holder, it, inserted);
+        data.emplace(key_holder, it, inserted, hash_value...);
 
         if constexpr (has_mapped) {
             auto& mapped = *lookup_result_get_mapped(it);
@@ -150,6 +150,38 @@ public:
         data.prefetch(key_holder);
     }
 
+    /// Batched hashing: the hash values of all rows of a block are computed in a tight loop
+    /// first, so the hash function (CRC32 of fixed keys) of different rows is pipelined. Then
+    /// the rows are emplaced or found with their hash values, and the cell of a row
+    /// HASH_TABLE_PREFETCH_DIST rows ahead is prefetched by prefetch_by_hash().
+    template <typename Data>
+    ALWAYS_INLINE void get_hash_values(const Data& data, size_t rows, Arena& pool,
+                                       std::vector<size_t>& hash_values) {
+        hash_values.resize(rows);
+        for (size_t i = 0; i < rows; ++i) {
+            auto key_holder = static_cast<Derived&>(*this).get_key_holder(i, pool);
+            hash_values[i] = data.hash(key_holder_get_key(key_holder));
+        }
+    }
+
+    template <typename Data>
+    ALWAYS_INLINE EmplaceResult emplace_key(Data& data, size_t hash_value, size_t row,
+                                            Arena& pool) {
+        auto key_holder = static_cast<Derived&>(*this).get_key_holder(row, pool);
+        return emplaceImpl(key_holder, data, hash_value);
+    }
+
+    template <typename Data>
+    ALWAYS_INLINE FindResult find_key(Data& data, size_t hash_value, size_t row, Arena& pool) {
+        auto key_holder = static_cast<Derived&>(*this).get_key_holder(row, pool);
+        return find_key_impl(key_holder_get_key(key_holder), data, hash_value);
+    }
+
+    template <bool READ, typename Data>
+    ALWAYS_INLINE void prefetch_by_hash(Data& data, size_t hash_value) {
+        data.template prefetch_by_hash<READ>(hash_value);
+    }
+
 protected:
     Cache cache;
 
@@ -164,8 +196,10 @@ protected:
         }
     }
 
-    template <typename Data, typename KeyHolder>
-    ALWAYS_INLINE EmplaceResult emplaceImpl(KeyHolder& key_holder, Data& data) {
+    /// hash_value is empty or the hash value of the key computed beforehand.
+    template <typename Data, typename KeyHolder, typename... HashValue>
+    ALWAYS_INLINE EmplaceResult emplaceImpl(KeyHolder& key_holder, Data& data,
+                                            HashValue... hash_value) {
         if constexpr (Cache::consecutive_keys_optimization) {
             if (cache.found && cache.check(key_holder_get_key(key_holder))) {
                 if constexpr (has_mapped)
@@ -177,7 +211,7 @@ protected:
 
         typename Data::LookupResult it;
         bool inserted = false;
-        data.emplace(key_holder, it, inserted);
+        data.emplace(key_holder, it, inserted, hash_value...);
 
         [[maybe_unused]] Mapped* cached = nullptr;
         if constexpr (has_mapped) cached = lookup_result_get_mapped(it);
@@ -207,8 +241,8 @@ protected:
             return EmplaceResult(inserted);
     }
 
-    template <typename Data, typename Key>
-    ALWAYS_INLINE FindResult find_key_impl(Key key, Data& data) {
+    template <typename Data, typename Key, typename... HashValue>
+    ALWAYS_INLINE FindResult find_key_impl(Key key, Data& data, HashValue... hash_value) {
         if constexpr (Cache::consecutive_keys_optimization) {
             if (cache.check(key)) {
                 if constexpr (has_mapped)
@@ -218,7 +252,7 @@ protected:
             }
         }
 
-        auto it = data.find(key);
+        auto it = data.find(key, hash_value...);
 
         if constexpr (consecutive_keys_optimization) {
             cache.found = it != nullptr;
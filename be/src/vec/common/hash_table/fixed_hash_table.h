@@ -269,6 +269,12 @@ public:
         this->increase_size();
     }
 
+    /// The hash value is the key itself, exists for compatibility with HashTable interface.
+    template <bool READ>
+    void ALWAYS_INLINE prefetch_by_hash(size_t hash_value) {
+        __builtin_prefetch(&buf[hash_value], READ ? 0 : 1);
+    }
+
     std::pair<LookupResult, bool> ALWAYS_INLINE insert(const value_type& x) {
         std::pair<LookupResult, bool> res;
         emplace(Cell::get_key(x), res.first, res.second);
@@ -41,6 +41,10 @@
 #include <iostream>
 #endif
 
+/// In batched hashing, the cell of the row HASH_TABLE_PREFETCH_DIST rows after the current one
+/// is prefetched, which is far enough to hide the latency of a cache miss.
+static constexpr size_t HASH_TABLE_PREFETCH_DIST = 16;
+
 /** NOTE HashTable could only be used for memmoveable (position independent) types.
   * Example: std::string is not position independent in libstdc++ with C++11 ABI or in libc++.
   * Also, key in hash table must be of type, that zero bytes is compared equals to zero key.
@@ -760,6 +764,13 @@ public:
         __builtin_prefetch(&buf[place_value]);
     }
 
+    /// Prefetch the cell of a hash value computed beforehand, e.g. by a batched hashing pass.
+    /// READ is true if the cell will only be read by find(), emplace() writes it.
+    template <bool READ>
+    void ALWAYS_INLINE prefetch_by_hash(size_t hash_value) {
+        __builtin_prefetch(&buf[grower.place(hash_value)], READ ? 0 : 1);
+    }
+
     /// Reinsert node pointed to by iterator
     void ALWAYS_INLINE reinsert(iterator& it, size_t hash_value) {
         reinsert(*it.get_ptr(), hash_value);
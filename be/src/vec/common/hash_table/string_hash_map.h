@@ -0,0 +1,146 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+// This file is copied from
+// https://github.com/ClickHouse/ClickHouse/blob/master/src/Common/HashTable/StringHashMap.h
+// and modified by Doris
+
+#pragma once
+
+#include "vec/common/hash_table/hash_map.h"
+#include "vec/common/hash_table/string_hash_table.h"
+
+template <typename Key, typename TMapped>
+struct StringHashMapCell : public HashMapCell<Key, TMapped, StringHashTableHash, HashTableNoState> {
+    using Base = HashMapCell<Key, TMapped, StringHashTableHash, HashTableNoState>;
+    using value_type = typename Base::value_type;
+    using Base::Base;
+    static constexpr bool need_zero_value_storage = false;
+};
+
+/// The key of m1 is never zero, the last byte of a short string is not zero.
+template <typename TMapped>
+struct StringHashMapCell<StringKey8, TMapped>
+        : public HashMapCell<StringKey8, TMapped, StringHashTableHash, HashTableNoState> {
+    using Base = HashMapCell<StringKey8, TMapped, StringHashTableHash, HashTableNoState>;
+    using value_type = typename Base::value_type;
+    using Base::Base;
+    static constexpr bool need_zero_value_storage = false;
+};
+
+/// The high word of the key of m2 is never zero, so only it is checked.
+template <typename TMapped>
+struct StringHashMapCell<StringKey16, TMapped>
+        : public HashMapCell<StringKey16, TMapped, StringHashTableHash, HashTableNoState> {
+    using Base = HashMapCell<StringKey16, TMapped, StringHashTableHash, HashTableNoState>;
+    using value_type = typename Base::value_type;
+    using Base::Base;
+    static constexpr bool need_zero_value_storage = false;
+
+    bool is_zero(const HashTableNoState& state) const { return is_zero(this->value.first, state); }
+    static bool is_zero(const StringKey16& key, const HashTableNoState&) { return key.high == 0; }
+    void set_zero() { this->value.first.high = 0; }
+};
+
+/// The last word of the key of m3 is never zero, so only it is checked.
+template <typename TMapped>
+struct StringHashMapCell<StringKey24, TMapped>
+        : public HashMapCell<StringKey24, TMapped, StringHashTableHash, HashTableNoState> {
+    using Base = HashMapCell<StringKey24, TMapped, StringHashTableHash, HashTableNoState>;
+    using value_type = typename Base::value_type;
+    using Base::Base;
+    static constexpr bool need_zero_value_storage = false;
+
+    bool is_zero(const HashTableNoState& state) const { return is_zero(this->value.first, state); }
+    static bool is_zero(const StringKey24& key, const HashTableNoState&) { return key.c == 0; }
+    void set_zero() { this->value.first.c = 0; }
+};
+
+/// The long strings are compared with the saved hash first.
+template <typename TMapped>
+struct StringHashMapCell<StringRef, TMapped>
+        : public HashMapCellWithSavedHash<StringRef, TMapped, StringHashTableHash,
+                                          HashTableNoState> {
+    using Base =
+            HashMapCellWithSavedHash<StringRef, TMapped, StringHashTableHash, HashTableNoState>;
+    using value_type = typename Base::value_type;
+    using Base::Base;
+    static constexpr bool need_zero_value_storage = false;
+};
+
+template <typename Key, typename Mapped>
+ALWAYS_INLINE inline auto lookup_result_get_mapped(StringHashMapCell<Key, Mapped>* cell) {
+    return &cell->get_second();
+}
+
+template <typename Key, typename TMapped, typename Allocator>
+using StringHashMapSubMap = HashMapTable<Key, StringHashMapCell<Key, TMapped>, StringHashTableHash,
+                                         StringHashTableGrower<>, Allocator>;
+
+template <typename TMapped, typename Allocator>
+struct StringHashMapSubMaps {
+    using T0 = StringHashTableEmpty<StringHashMapCell<StringRef, TMapped>>;
+    using T1 = StringHashMapSubMap<StringKey8, TMapped, Allocator>;
+    using T2 = StringHashMapSubMap<StringKey16, TMapped, Allocator>;
+    using T3 = StringHashMapSubMap<StringKey24, TMapped, Allocator>;
+    using Ts = StringHashMapSubMap<StringRef, TMapped, Allocator>;
+};
+
+template <typename TMapped, typename Allocator = HashTableAllocator>
+class StringHashMap : public StringHashTable<StringHashMapSubMaps<TMapped, Allocator>> {
+public:
+    using Key = StringRef;
+    using Base = StringHashTable<StringHashMapSubMaps<TMapped, Allocator>>;
+    using Self = StringHashMap;
+    using LookupResult = typename Base::LookupResult;
+
+    using Base::Base;
+
+    /// Call func(const StringRef &, Mapped &) for each hash map element.
+    template <typename Func>
+    void for_each_value(Func&& func) {
+        for (auto it = this->begin(), end = this->end(); it != end; ++it) {
+            func(it->get_first(), it->get_second());
+        }
+    }
+
+    /// Call func(Mapped &) for each hash map element.
+    template <typename Func>
+    void for_each_mapped(Func&& func) {
+        for (auto it = this->begin(), end = this->end(); it != end; ++it) {
+            func(it->get_second());
+        }
+    }
+
+    size_t get_size() {
+        size_t count = 0;
+        for_each_mapped([&](auto& mapped) { count += mapped.get_row_count(); });
+        return count;
+    }
+
+    TMapped& ALWAYS_INLINE operator[](const Key& x) {
+        LookupResult it;
+        bool inserted;
+        this->emplace(x, it, inserted);
+        if (inserted) {
+            new (it) TMapped();
+        }
+        return *it;
+    }
+
+    char* get_null_key_data() { return nullptr; }
+    bool has_null_key_data() const { return false; }
+};
@@ -0,0 +1,530 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+// This file is copied from
+// https://github.com/ClickHouse/ClickHouse/blob/master/src/Common/HashTable/StringHashTable.h
+// and modified by Doris
+
+#pragma once
+
+#include <new>
+
+#include "vec/common/hash_table/hash.h"
+#include "vec/common/hash_table/hash_table.h"
+#include "vec/common/string_ref.h"
+
+using StringKey8 = doris::vectorized::UInt64;
+using StringKey16 = doris::vectorized::UInt128;
+struct StringKey24 {
+    doris::vectorized::UInt64 a;
+    doris::vectorized::UInt64 b;
+    doris::vectorized::UInt64 c;
+
+    bool operator==(const StringKey24 rhs) const { return a == rhs.a && b == rhs.b && c == rhs.c; }
+};
+
+/// A short string is stored in a fixed size key with the unused high bytes zeroed. The last
+/// byte of the string is not zero (see StringHashTable::dispatch), so the length is recovered
+/// from the number of leading zero bytes of the last word.
+inline StringRef ALWAYS_INLINE to_string_ref(const StringKey8& n) {
+    assert(n != 0);
+    return {reinterpret_cast<const char*>(&n), 8ul - (__builtin_clzll(n) >> 3)};
+}
+inline StringRef ALWAYS_INLINE to_string_ref(const StringKey16& n) {
+    assert(n.high != 0);
+    return {reinterpret_cast<const char*>(&n), 16ul - (__builtin_clzll(n.high) >> 3)};
+}
+inline StringRef ALWAYS_INLINE to_string_ref(const StringKey24& n) {
+    assert(n.c != 0);
+    return {reinterpret_cast<const char*>(&n), 24ul - (__builtin_clzll(n.c) >> 3)};
+}
+
+struct StringHashTableHash {
+#if defined(__SSE4_2__)
+    size_t ALWAYS_INLINE operator()(StringKey8 key) const {
+        size_t res = -1ULL;
+        res = _mm_crc32_u64(res, key);
+        return res;
+    }
+    size_t ALWAYS_INLINE operator()(StringKey16 key) const {
+        size_t res = -1ULL;
+        res = _mm_crc32_u64(res, key.low);
+        res = _mm_crc32_u64(res, key.high);
+        return res;
+    }
+    size_t ALWAYS_INLINE operator()(StringKey24 key) const {
+        size_t res = -1ULL;
+        res = _mm_crc32_u64(res, key.a);
+        res = _mm_crc32_u64(res, key.b);
+        res = _mm_crc32_u64(res, key.c);
+        return res;
+    }
+#else
+    size_t ALWAYS_INLINE operator()(StringKey8 key) const {
+        return util_hash::CityHash64(reinterpret_cast<const char*>(&key), 8);
+    }
+    size_t ALWAYS_INLINE operator()(StringKey16 key) const {
+        return util_hash::CityHash64(reinterpret_cast<const char*>(&key), 16);
+    }
+    size_t ALWAYS_INLINE operator()(StringKey24 key) const {
+        return util_hash::CityHash64(reinterpret_cast<const char*>(&key), 24);
+    }
+#endif
+    size_t ALWAYS_INLINE operator()(StringRef key) const { return StringRefHash()(key); }
+};
+
+/// The table of the empty string, it has at most one cell.
+template <typename Cell>
+struct StringHashTableEmpty {
+    using Self = StringHashTableEmpty;
+    using LookupResult = Cell*;
+
+    bool _has_zero = false;
+    std::aligned_storage_t<sizeof(Cell), alignof(Cell)> zero_value_storage;
+
+    bool has_zero() const { return _has_zero; }
+
+    void set_has_zero() {
+        _has_zero = true;
+        new (zero_value()) Cell(StringRef(), HashTableNoState());
+    }
+
+    void clear_has_zero() {
+        _has_zero = false;
+        if (!std::is_trivially_destructible_v<Cell>) {
+            zero_value()->~Cell();
+        }
+    }
+
+    Cell* zero_value() { return std::launder(reinterpret_cast<Cell*>(&zero_value_storage)); }
+    const Cell* zero_value() const {
+        return std::launder(reinterpret_cast<const Cell*>(&zero_value_storage));
+    }
+
+    template <typename KeyHolder>
+    void ALWAYS_INLINE emplace(KeyHolder&& key_holder, LookupResult& it, bool& inserted,
+                               size_t /*hash_value*/) {
+        key_holder_discard_key(key_holder);
+        if (!has_zero()) {
+            set_has_zero();
+            inserted = true;
+        } else {
+            inserted = false;
+        }
+        it = zero_value();
+    }
+
+    template <typename Key>
+    LookupResult ALWAYS_INLINE find(const Key&, size_t /*hash_value*/) {
+        return has_zero() ? zero_value() : nullptr;
+    }
+
+    size_t size() const { return has_zero() ? 1 : 0; }
+    bool empty() const { return !has_zero(); }
+    size_t get_buffer_size_in_bytes() const { return sizeof(Cell); }
+    size_t get_buffer_size_in_cells() const { return 1; }
+    bool add_elem_size_overflow(size_t /*add_size*/) const { return false; }
+    void reset_resize_timer() {}
+    int64_t get_resize_timer_value() const { return 0; }
+
+    void clear() {
+        if (has_zero()) {
+            clear_has_zero();
+        }
+    }
+    void clear_and_shrink() { clear(); }
+};
+
+/// The sub tables grow one size degree at a time, as the keys are spread over five of them.
+template <size_t initial_size_degree = 8>
+struct StringHashTableGrower : public HashTableGrower<initial_size_degree> {
+    void increase_size() { this->size_degree += 1; }
+};
+
+/// A hash table specialized for StringRef keys. A key is dispatched by its length to one of
+/// five sub tables:
+///   m0: the empty string;
+///   m1: 1..8 bytes, stored inline in a UInt64;
+///   m2: 9..16 bytes, stored inline in a UInt128;
+///   m3: 17..24 bytes, stored inline in three UInt64;
+///   ms: longer strings and strings ending with a zero byte, stored as StringRef to the arena.
+/// Short keys are compared and hashed as integers, and are never copied to the arena, which
+/// is both faster and smaller than a single table of StringRef with saved hash.
+///
+/// LookupResult is a pointer to the mapped value, the key of a cell is only available by
+/// iterating the table.
+template <typename SubMaps>
+class StringHashTable : private boost::noncopyable {
+protected:
+    using T0 = typename SubMaps::T0;
+    using T1 = typename SubMaps::T1;
+    using T2 = typename SubMaps::T2;
+    using T3 = typename SubMaps::T3;
+    using Ts = typename SubMaps::Ts;
+    using Self = StringHashTable;
+
+    T0 m0;
+    T1 m1;
+    T2 m2;
+    T3 m3;
+    Ts ms;
+
+public:
+    using Key = StringRef;
+    using key_type = Key;
+    using mapped_type = typename Ts::mapped_type;
+    using value_type = typename Ts::value_type;
+    using LookupResult = mapped_type*;
+
+    StringHashTable() = default;
+
+    ~StringHashTable() { m0.clear(); }
+
+    /// Dispatch a key to its sub table, and call func(sub_table, sub_key_holder, hash_value).
+    /// hash_value is the hash of the key in the sub table, it's computed here unless it's
+    /// given, see hash().
+    ///
+    /// A key of 1..8 bytes is read by one 8 bytes load. The load starts at the key if the key
+    /// is in the first half of a page, otherwise it ends at the end of the key, so it never
+    /// crosses into a page that may be unmapped. The keys are expected to be in the padded
+    /// chars of a ColumnString, so the load stays in the same allocation too.
+    template <typename TSelf, typename KeyHolder, typename Func, typename... HashValue>
+    static auto ALWAYS_INLINE dispatch(TSelf& self, KeyHolder&& key_holder, Func&& func,
+                                       HashValue... hash_value) {
+        const StringRef& x = key_holder_get_key(key_holder);
+        const size_t sz = x.size;
+        if (sz == 0) {
+            key_holder_discard_key(key_holder);
+            return func(self.m0, VoidKey {}, 0);
+        }
+
+        if (x.data[sz - 1] == 0) {
+            // Strings with trailing zeros are not representable as fixed-size
+            // string keys. Put them to the generic table.
+            return func(self.ms, std::forward<KeyHolder>(key_holder),
+                        _hash_or_compute(x, hash_value...));
+        }
+
+        const char* p = x.data;
+        // pending bits that needs to be shifted out
+        const char s = (-sz & 7) * 8;
+        union {
+            StringKey8 k8;
+            StringKey16 k16;
+            StringKey24 k24;
+            doris::vectorized::UInt64 n[3];
+        };
+        switch ((sz - 1) >> 3) {
+        case 0: { // 1..8 bytes
+            // first half page
+            if ((reinterpret_cast<uintptr_t>(p) & 2048) == 0) {
+                memcpy(&n[0], p, 8);
+                n[0] &= -1ULL >> s;
+            } else {
+                const char* lp = x.data + x.size - 8;
+                memcpy(&n[0], lp, 8);
+                n[0] >>= s;
+            }
+            key_holder_discard_key(key_holder);
+            return func(self.m1, k8, _hash_or_compute(k8, hash_value...));
+        }
+        case 1: { // 9..16 bytes
+            memcpy(&n[0], p, 8);
+            const char* lp = x.data + x.size - 8;
+            memcpy(&n[1], lp, 8);
+            n[1] >>= s;
+            key_holder_discard_key(key_holder);
+            return func(self.m2, k16, _hash_or_compute(k16, hash_value...));
+        }
+        case 2: { // 17..24 bytes
+            memcpy(&n[0], p, 16);
+            const char* lp = x.data + x.size - 8;
+            memcpy(&n[2], lp, 8);
+            n[2] >>= s;
+            key_holder_discard_key(key_holder);
+            return func(self.m3, k24, _hash_or_compute(k24, hash_value...));
+        }
+        default: { // >= 25 bytes
+            return func(self.ms, std::forward<KeyHolder>(key_holder),
+                        _hash_or_compute(x, hash_value...));
+        }
+        }
+    }
+
+    /// The hash of a key in its sub table, it can be passed to emplace() and find() to avoid
+    /// hashing the key again.
+    size_t ALWAYS_INLINE hash(const Key& x) const {
+        return dispatch(*this, x, [](auto&, auto&&, size_t hash_value) { return hash_value; });
+    }
+
+    template <typename KeyHolder>
+    void ALWAYS_INLINE emplace(KeyHolder&& key_holder, LookupResult& it, bool& inserted) {
+        this->dispatch(*this, key_holder, EmplaceCallable(it, inserted));
+    }
+
+    template <typename KeyHolder>
+    void ALWAYS_INLINE emplace(KeyHolder&& key_holder, LookupResult& it, bool& inserted,
+                               size_t hash_value) {
+        this->dispatch(*this, key_holder, EmplaceCallable(it, inserted), hash_value);
+    }
+
+    LookupResult ALWAYS_INLINE find(const Key& x) { return dispatch(*this, x, FindCallable {}); }
+
+    LookupResult ALWAYS_INLINE find(const Key& x, size_t hash_value) {
+        return dispatch(*this, x, FindCallable {}, hash_value);
+    }
+
+    bool ALWAYS_INLINE has(const Key& x) { return find(x) != nullptr; }
+
+    /// The sub table of a key is unknown from its hash value alone, so there is nothing to
+    /// prefetch. The short keys are stored inline, which already saves the cache miss of
+    /// comparing the key in the arena.
+    template <bool READ>
+    void ALWAYS_INLINE prefetch_by_hash(size_t /*hash_value*/) {}
+
+    size_t size() const { return m0.size() + m1.size() + m2.size() + m3.size() + ms.size(); }
+
+    bool empty() const {
+        return m0.empty() && m1.empty() && m2.empty() && m3.empty() && ms.empty();
+    }
+
+    size_t get_buffer_size_in_bytes() const {
+        return m0.get_buffer_size_in_bytes() + m1.get_buffer_size_in_bytes() +
+               m2.get_buffer_size_in_bytes() + m3.get_buffer_size_in_bytes() +
+               ms.get_buffer_size_in_bytes();
+    }
+
+    size_t get_buffer_size_in_cells() const {
+        return m0.get_buffer_size_in_cells() + m1.get_buffer_size_in_cells() +
+               m2.get_buffer_size_in_cells() + m3.get_buffer_size_in_cells() +
+               ms.get_buffer_size_in_cells();
+    }
+
+    /// Any of the sub tables may receive all of the new elements.
+    bool add_elem_size_overflow(size_t add_size) const {
+        return m1.add_elem_size_overflow(add_size) || m2.add_elem_size_overflow(add_size) ||
+               m3.add_elem_size_overflow(add_size) || ms.add_elem_size_overflow(add_size);
+    }
+
+    /// It's unknown how the new elements are spread over the sub tables, so they are not
+    /// resized in advance, each of them grows when it's full.
+    void expanse_for_add_elem(size_t /*num_elem*/) {}
+
+    void reset_resize_timer() {
+        m1.reset_resize_timer();
+        m2.reset_resize_timer();
+        m3.reset_resize_timer();
+        ms.reset_resize_timer();
+    }
+
+    int64_t get_resize_timer_value() const {
+        return m1.get_resize_timer_value() + m2.get_resize_timer_value() +
+               m3.get_resize_timer_value() + ms.get_resize_timer_value();
+    }
+
+    void clear() {
+        m0.clear();
+        m1.clear();
+        m2.clear();
+        m3.clear();
+        ms.clear();
+    }
+
+    void clear_and_shrink() {
+        m0.clear_and_shrink();
+        m1.clear_and_shrink();
+        m2.clear_and_shrink();
+        m3.clear_and_shrink();
+        ms.clear_and_shrink();
+    }
+
+    /// Iterate m0, m1, m2, m3 and ms in turn. The iterator is also the view of the current
+    /// cell: get_first() returns the key as StringRef, which points into the cell for the
+    /// short keys, get_second() returns the mapped value.
+    class iterator {
+    public:
+        iterator() = default;
+
+        bool operator==(const iterator& rhs) const {
+            if (sub_table_index != rhs.sub_table_index) {
+                return false;
+            }
+            switch (sub_table_index) {
+            case 0:
+                return true;
+            case 1:
+                return iterator1 == rhs.iterator1;
+            case 2:
+                return iterator2 == rhs.iterator2;
+            case 3:
+                return iterator3 == rhs.iterator3;
+            default:
+                return iterator4 == rhs.iterator4;
+            }
+        }
+
+        bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+
+        iterator& operator++() {
+            switch (sub_table_index) {
+            case 0:
+                break;
+            case 1:
+                if (++iterator1 != container->m1.end()) {
+                    return *this;
+                }
+                break;
+            case 2:
+                if (++iterator2 != container->m2.end()) {
+                    return *this;
+                }
+                break;
+            case 3:
+                if (++iterator3 != container->m3.end()) {
+                    return *this;
+                }
+                break;
+            default:
+                ++iterator4;
+                return *this;
+            }
+            _next_sub_table();
+            return *this;
+        }
+
+        iterator* operator->() { return this; }
+        const iterator* operator->() const { return this; }
+
+        StringRef get_first() const {
+            switch (sub_table_index) {
+            case 0:
+                return StringRef();
+            case 1:
+                return to_string_ref(iterator1->get_first());
+            case 2:
+                return to_string_ref(iterator2->get_first());
+            case 3:
+                return to_string_ref(iterator3->get_first());
+            default:
+                return iterator4->get_first();
+            }
+        }
+
+        mapped_type& get_second() const {
+            switch (sub_table_index) {
+            case 0:
+                return container->m0.zero_value()->get_second();
+            case 1:
+                return iterator1->get_second();
+            case 2:
+                return iterator2->get_second();
+            case 3:
+                return iterator3->get_second();
+            default:
+                return iterator4->get_second();
+            }
+        }
+
+    private:
+        friend class StringHashTable;
+
+        explicit iterator(StringHashTable* container_) : container(container_) {
+            if (!container->m0.has_zero()) {
+                _next_sub_table();
+            }
+        }
+
+        static iterator end(StringHashTable* container) {
+            iterator it;
+            it.container = container;
+            it.sub_table_index = 4;
+            it.iterator4 = container->ms.end();
+            return it;
+        }
+
+        /// Move to the first cell of the next non-empty sub table, or to the end of ms.
+        void _next_sub_table() {
+            while (true) {
+                switch (++sub_table_index) {
+                case 1:
+                    iterator1 = container->m1.begin();
+                    if (iterator1 != container->m1.end()) {
+                        return;
+                    }
+                    break;
+                case 2:
+                    iterator2 = container->m2.begin();
+                    if (iterator2 != container->m2.end()) {
+                        return;
+                    }
+                    break;
+                case 3:
+                    iterator3 = container->m3.begin();
+                    if (iterator3 != container->m3.end()) {
+                        return;
+                    }
+                    break;
+                default:
+                    iterator4 = container->ms.begin();
+                    return;
+                }
+            }
+        }
+
+        StringHashTable* container = nullptr;
+        int sub_table_index = 0;
+        typename T1::iterator iterator1;
+        typename T2::iterator iterator2;
+        typename T3::iterator iterator3;
+        typename Ts::iterator iterator4;
+    };
+
+    iterator begin() { return iterator(this); }
+    iterator end() { return iterator::end(this); }
+
+protected:
+    template <typename SubKey, typename... HashValue>
+    static size_t ALWAYS_INLINE _hash_or_compute(const SubKey& key, HashValue... hash_value) {
+        if constexpr (sizeof...(hash_value) > 0) {
+            return (hash_value, ...);
+        } else {
+            return StringHashTableHash()(key);
+        }
+    }
+
+    struct EmplaceCallable {
+        LookupResult& mapped;
+        bool& inserted;
+
+        EmplaceCallable(LookupResult& mapped_, bool& inserted_)
+                : mapped(mapped_), inserted(inserted_) {}
+
+        template <typename Map, typename KeyHolder>
+        void ALWAYS_INLINE operator()(Map& map, KeyHolder&& key_holder, size_t hash_value) {
+            typename Map::LookupResult result;
+            map.emplace(key_holder, result, inserted, hash_value);
+            mapped = &result->get_second();
+        }
+    };
+
+    struct FindCallable {
+        template <typename Map, typename SubKey>
+        LookupResult ALWAYS_INLINE operator()(Map& map, const SubKey& key, size_t hash_value) {
+            auto it = map.find(key, hash_value);
+            return it ? &it->get_second() : nullptr;
+        }
+    };
+};
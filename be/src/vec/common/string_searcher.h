@@ -0,0 +1,87 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace doris::vectorized {
+
+// Search a constant needle in haystack, which is usually the whole chars buffer of
+// a ColumnString, so the searcher is built once and used for the entire column.
+// With SSE2, the first and the last byte of needle are compared with 16 positions of
+// haystack at a time, and only the positions matching both are verified by memcmp.
+class StringSearcher {
+public:
+    StringSearcher() = default;
+    explicit StringSearcher(std::string needle) : _needle(std::move(needle)) {}
+
+    const std::string& needle() const { return _needle; }
+    size_t needle_size() const { return _needle.size(); }
+
+    // Return the first position of needle in [haystack, haystack_end), or haystack_end
+    // if not found. Empty needle matches at haystack.
+    const uint8_t* search(const uint8_t* haystack, const uint8_t* haystack_end) const {
+        const size_t size = _needle.size();
+        const auto* needle = reinterpret_cast<const uint8_t*>(_needle.data());
+        if (size == 0) {
+            return haystack;
+        }
+        if (haystack_end - haystack < static_cast<ptrdiff_t>(size)) {
+            return haystack_end;
+        }
+        if (size == 1) {
+            const void* pos = memchr(haystack, needle[0], haystack_end - haystack);
+            return pos == nullptr ? haystack_end : static_cast<const uint8_t*>(pos);
+        }
+
+        const uint8_t* pos = haystack;
+#ifdef __SSE2__
+        const __m128i first = _mm_set1_epi8(needle[0]);
+        const __m128i last = _mm_set1_epi8(needle[size - 1]);
+        // both loads of a block must be inside haystack
+        for (; haystack_end - pos >= static_cast<ptrdiff_t>(size + 15); pos += 16) {
+            const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+            const __m128i block_last =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos + size - 1));
+            uint32_t mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, block_first),
+                                                            _mm_cmpeq_epi8(last, block_last)));
+            while (mask != 0) {
+                const int offset = __builtin_ctz(mask);
+                if (memcmp(pos + offset + 1, needle + 1, size - 2) == 0) {
+                    return pos + offset;
+                }
+                mask &= mask - 1;
+            }
+        }
+#endif
+        return std::search(pos, haystack_end, needle, needle + size);
+    }
+
+private:
+    std::string _needle;
+};
+
+} // namespace doris::vectorized
@@ -74,6 +74,7 @@ enum class TypeIndex {
     LowCardinality,
     BitMap,
     HLL,
+    JSONB,
 };
 
 struct Consted {
@@ -430,6 +431,8 @@ inline const char* getTypeName(TypeIndex idx) {
         return TypeName<BitmapValue>::get();
     case TypeIndex::HLL:
         return TypeName<HyperLogLog>::get();
+    case TypeIndex::JSONB:
+        return "JSONB";
     }
 
     __builtin_unreachable();
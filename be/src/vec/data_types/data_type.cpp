@@ -133,6 +133,8 @@ PGenericType_TypeId IDataType::get_pdata_type(const IDataType* data_type) {
         return PGenericType::BITMAP;
     case TypeIndex::HLL:
         return PGenericType::HLL;
+    case TypeIndex::JSONB:
+        return PGenericType::JSONB;
     case TypeIndex::Array:
         return PGenericType::LIST;
     default:
@@ -99,6 +99,9 @@ DataTypePtr DataTypeFactory::create_data_type(const TypeDescriptor& col_desc, bo
     case TYPE_OBJECT:
         nested = std::make_shared<vectorized::DataTypeBitMap>();
         break;
+    case TYPE_JSONB:
+        nested = std::make_shared<vectorized::DataTypeJsonb>();
+        break;
     case TYPE_DECIMALV2:
         nested = std::make_shared<vectorized::DataTypeDecimal<vectorized::Decimal128>>(27, 9);
         break;
@@ -167,6 +170,9 @@ DataTypePtr DataTypeFactory::_create_primitive_data_type(const FieldType& type)
     case OLAP_FIELD_TYPE_OBJECT:
         result = std::make_shared<vectorized::DataTypeBitMap>();
         break;
+    case OLAP_FIELD_TYPE_JSONB:
+        result = std::make_shared<vectorized::DataTypeJsonb>();
+        break;
     case OLAP_FIELD_TYPE_DECIMAL:
         result = std::make_shared<vectorized::DataTypeDecimal<vectorized::Decimal128>>(27, 9);
         break;
@@ -244,6 +250,9 @@ DataTypePtr DataTypeFactory::create_data_type(const PColumnMeta& pcolumn) {
     case PGenericType::HLL:
         nested = std::make_shared<DataTypeHLL>();
         break;
+    case PGenericType::JSONB:
+        nested = std::make_shared<DataTypeJsonb>();
+        break;
     case PGenericType::LIST:
         DCHECK(pcolumn.children_size() == 1);
         nested = std::make_shared<DataTypeArray>(create_data_type(pcolumn.children(0)));
@@ -33,6 +33,7 @@
 #include "vec/data_types/data_type_date.h"
 #include "vec/data_types/data_type_date_time.h"
 #include "vec/data_types/data_type_decimal.h"
+#include "vec/data_types/data_type_jsonb.h"
 #include "vec/data_types/data_type_nothing.h"
 #include "vec/data_types/data_type_nullable.h"
 #include "vec/data_types/data_type_number.h"
@@ -65,6 +66,7 @@ public:
             instance.register_data_type("String", std::make_shared<DataTypeString>());
             instance.register_data_type("Decimal",
                                         std::make_shared<DataTypeDecimal<Decimal128>>(27, 9));
+            instance.register_data_type("Jsonb", std::make_shared<DataTypeJsonb>());
         });
         return instance;
     }
@@ -0,0 +1,38 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/data_types/data_type_jsonb.h"
+
+#include "util/jsonb.h"
+#include "vec/common/assert_cast.h"
+#include "vec/io/io_helper.h"
+
+namespace doris::vectorized {
+
+std::string DataTypeJsonb::to_string(const IColumn& column, size_t row_num) const {
+    const StringRef& s =
+            assert_cast<const ColumnString&>(*column.convert_to_full_column_if_const().get())
+                    .get_data_at(row_num);
+    return JsonbDocument::to_json_string(s.data, s.size);
+}
+
+void DataTypeJsonb::to_string(const IColumn& column, size_t row_num, BufferWritable& ostr) const {
+    std::string json = to_string(column, row_num);
+    ostr.write(json.data(), json.size());
+}
+
+} // namespace doris::vectorized
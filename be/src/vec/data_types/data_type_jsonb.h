@@ -0,0 +1,71 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "vec/columns/column_string.h"
+#include "vec/data_types/data_type.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris::vectorized {
+
+// Values are binary jsonb documents (see util/jsonb.h) kept in a ColumnString, they are
+// converted to json text only when they are output.
+class DataTypeJsonb final : public IDataType {
+public:
+    using ColumnType = ColumnString;
+    using FieldType = String;
+    static constexpr bool is_parametric = false;
+
+    const char* get_family_name() const override { return "JSONB"; }
+
+    TypeIndex get_type_id() const override { return TypeIndex::JSONB; }
+
+    int64_t get_uncompressed_serialized_bytes(const IColumn& column) const override {
+        return _data_type_string.get_uncompressed_serialized_bytes(column);
+    }
+    char* serialize(const IColumn& column, char* buf) const override {
+        return _data_type_string.serialize(column, buf);
+    }
+    const char* deserialize(const char* buf, IColumn* column) const override {
+        return _data_type_string.deserialize(buf, column);
+    }
+
+    MutableColumnPtr create_column() const override { return ColumnString::create(); }
+
+    // An empty value is not a valid jsonb document, it's output as json null.
+    Field get_default() const override { return String(); }
+
+    bool equals(const IDataType& rhs) const override { return typeid(rhs) == typeid(*this); }
+
+    bool get_is_parametric() const override { return false; }
+    bool have_subtypes() const override { return false; }
+    bool is_comparable() const override { return false; }
+    bool is_value_unambiguously_represented_in_contiguous_memory_region() const override {
+        return true;
+    }
+    bool can_be_inside_nullable() const override { return true; }
+    bool can_be_inside_low_cardinality() const override { return false; }
+
+    std::string to_string(const IColumn& column, size_t row_num) const override;
+    void to_string(const IColumn& column, size_t row_num, BufferWritable& ostr) const override;
+
+private:
+    DataTypeString _data_type_string;
+};
+
+} // namespace doris::vectorized
@@ -77,18 +77,24 @@ struct ProcessHashTableBuild {
             inserted_rows.reserve(_batch_size);
         }
 
+        std::vector<size_t> hash_values;
+        key_getter.get_hash_values(hash_table_ctx.hash_table, _rows, _join_node->_arena,
+                                   hash_values);
+
         for (size_t k = 0; k < _rows; ++k) {
+            if (k + HASH_TABLE_PREFETCH_DIST < _rows) {
+                key_getter.template prefetch_by_hash<false>(
+                        hash_table_ctx.hash_table, hash_values[k + HASH_TABLE_PREFETCH_DIST]);
+            }
+
             if constexpr (ignore_null) {
                 if ((*null_map)[k]) {
                     continue;
                 }
             }
 
-            auto emplace_result =
-                    key_getter.emplace_key(hash_table_ctx.hash_table, k, _join_node->_arena);
-            if (k + 1 < _rows) {
-                key_getter.prefetch(hash_table_ctx.hash_table, k + 1, _join_node->_arena);
-            }
+            auto emplace_result = key_getter.emplace_key(hash_table_ctx.hash_table, hash_values[k],
+                                                         k, _join_node->_arena);
 
             if (emplace_result.is_inserted()) {
                 new (&emplace_result.get_mapped()) Mapped({k, _offset});
@@ -169,6 +175,7 @@ struct ProcessHashTableProbe {
               _items_counts(join_node->_items_counts),
               _build_block_offsets(join_node->_build_block_offsets),
               _build_block_rows(join_node->_build_block_rows),
+              _probe_hash_values(join_node->_probe_hash_values),
               _rows_returned_counter(join_node->_rows_returned_counter),
               _search_hashtable_timer(join_node->_search_hashtable_timer),
               _build_side_output_timer(join_node->_build_side_output_timer),
@@ -275,7 +282,16 @@ struct ProcessHashTableProbe {
 
         {
             SCOPED_TIMER(_search_hashtable_timer);
+            if (_probe_index == 0) {
+                key_getter.get_hash_values(hash_table_ctx.hash_table, _probe_rows, _arena,
+                                           _probe_hash_values);
+            }
             for (; _probe_index < _probe_rows;) {
+                if (_probe_index + HASH_TABLE_PREFETCH_DIST < _probe_rows) {
+                    key_getter.template prefetch_by_hash<true>(
+                            hash_table_ctx.hash_table,
+                            _probe_hash_values[_probe_index + HASH_TABLE_PREFETCH_DIST]);
+                }
                 if constexpr (ignore_null) {
                     if ((*null_map)[_probe_index]) {
                         _items_counts[_probe_index++] = (uint32_t)0;
@@ -288,6 +304,7 @@ struct ProcessHashTableProbe {
                                                                           _probe_index,
                                                                           _arena)) {nullptr, false}
                                            : key_getter.find_key(hash_table_ctx.hash_table,
+                                                                 _probe_hash_values[_probe_index],
                                                                  _probe_index, _arena);
 
                 if constexpr (JoinOpType::value == TJoinOp::LEFT_ANTI_JOIN) {
@@ -312,11 +329,6 @@ struct ProcessHashTableProbe {
                                 ++current_offset;
                             }
                         } else {
-                            // prefetch is more useful while matching to multiple rows
-                            if (_probe_index + 2 < _probe_rows)
-                                key_getter.prefetch(hash_table_ctx.hash_table, _probe_index + 2,
-                                                    _arena);
-
                             for (auto it = mapped.begin(); it.ok(); ++it) {
                                 if constexpr (!is_right_semi_anti_join) {
                                     if (current_offset < _batch_size) {
@@ -394,7 +406,16 @@ struct ProcessHashTableProbe {
 
         int current_offset = 0;
 
+        if (_probe_index == 0) {
+            key_getter.get_hash_values(hash_table_ctx.hash_table, _probe_rows, _arena,
+                                       _probe_hash_values);
+        }
         for (; _probe_index < _probe_rows;) {
+            if (_probe_index + HASH_TABLE_PREFETCH_DIST < _probe_rows) {
+                key_getter.template prefetch_by_hash<true>(
+                        hash_table_ctx.hash_table,
+                        _probe_hash_values[_probe_index + HASH_TABLE_PREFETCH_DIST]);
+            }
             // ignore null rows
             if constexpr (ignore_null) {
                 if ((*null_map)[_probe_index]) {
@@ -408,7 +429,9 @@ struct ProcessHashTableProbe {
                     (*null_map)[_probe_index]
                             ? decltype(key_getter.find_key(hash_table_ctx.hash_table, _probe_index,
                                                            _arena)) {nullptr, false}
-                            : key_getter.find_key(hash_table_ctx.hash_table, _probe_index, _arena);
+                            : key_getter.find_key(hash_table_ctx.hash_table,
+                                                  _probe_hash_values[_probe_index], _probe_index,
+                                                  _arena);
 
             if (find_result.is_found()) {
                 auto& mapped = find_result.get_mapped();
@@ -641,6 +664,7 @@ private:
     std::vector<uint32_t>& _items_counts;
     std::vector<int8_t>& _build_block_offsets;
     std::vector<int>& _build_block_rows;
+    std::vector<size_t>& _probe_hash_values;
 
     ProfileCounter* _rows_returned_counter;
     ProfileCounter* _search_hashtable_timer;
@@ -1222,6 +1246,11 @@ void HashJoinNode::_hash_table_init() {
         case TYPE_DECIMALV2:
             _hash_table_variants.emplace<I128HashTableContext>();
             break;
+        case TYPE_CHAR:
+        case TYPE_VARCHAR:
+        case TYPE_STRING:
+            _hash_table_variants.emplace<StringHashTableContext>();
+            break;
         default:
             _hash_table_variants.emplace<SerializedHashTableContext>();
         }
@@ -25,6 +25,7 @@
 #include "vec/common/columns_hashing.h"
 #include "vec/common/hash_table/hash_map.h"
 #include "vec/common/hash_table/hash_table.h"
+#include "vec/common/hash_table/string_hash_map.h"
 #include "vec/exec/join/join_op.h"
 #include "vec/exec/join/vacquire_list.hpp"
 #include "vec/functions/function.h"
@@ -50,6 +51,26 @@ struct SerializedHashTableContext {
     }
 };
 
+// For a single string key, the keys of at most 24 bytes are stored inline.
+struct StringHashTableContext {
+    using Mapped = RowRefList;
+    using HashTable = StringHashMap<Mapped>;
+    using State = ColumnsHashing::HashMethodString<typename HashTable::value_type, Mapped, true,
+                                                   false>;
+    using Iter = typename HashTable::iterator;
+
+    HashTable hash_table;
+    Iter iter;
+    bool inited = false;
+
+    void init_once() {
+        if (!inited) {
+            inited = true;
+            iter = hash_table.begin();
+        }
+    }
+};
+
 // T should be UInt32 UInt64 UInt128
 template <class T>
 struct PrimaryTypeHashTableContext {
@@ -109,6 +130,16 @@ template <bool has_null>
 using I256FixedKeyHashTableContext = FixedKeyHashTableContext<UInt256, has_null>;
 
 using HashTableVariants =
+        std::variant<std::monostate, SerializedHashTableContext, I8HashTableContext,
+                     I16HashTableContext, I32HashTableContext, I64HashTableContext,
+                     I128HashTableContext, I256HashTableContext, I64FixedKeyHashTableContext<true>,
+                     I64FixedKeyHashTableContext<false>, I128FixedKeyHashTableContext<true>,
+                     I128FixedKeyHashTableContext<false>, I256FixedKeyHashTableContext<true>,
+                     I256FixedKeyHashTableContext<false>, StringHashTableContext>;
+
+// The set operation nodes shrink and rebuild their hash tables in place, which StringHashMap
+// does not support, so they don't use StringHashTableContext.
+using SetHashTableVariants =
         std::variant<std::monostate, SerializedHashTableContext, I8HashTableContext,
                      I16HashTableContext, I32HashTableContext, I64HashTableContext,
                      I128HashTableContext, I256HashTableContext, I64FixedKeyHashTableContext<true>,
@@ -230,6 +261,8 @@ private:
     std::vector<uint32_t> _items_counts;
     std::vector<int8_t> _build_block_offsets;
     std::vector<int> _build_block_rows;
+    // The hash values of the keys of _probe_block, computed once when the block arrives.
+    std::vector<size_t> _probe_hash_values;
 
     std::shared_ptr<MemTracker> _hash_table_mem_tracker;
 
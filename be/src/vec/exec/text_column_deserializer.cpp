@@ -0,0 +1,94 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/text_column_deserializer.h"
+
+#include "vec/data_types/data_type_date.h"
+#include "vec/data_types/data_type_date_time.h"
+#include "vec/data_types/data_type_decimal.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/functions/function_cast.h"
+#include "vec/io/reader_buffer.h"
+
+namespace doris::vectorized {
+
+template <typename DataType>
+class TextColumnDeserializerImpl final : public TextColumnDeserializer {
+public:
+    using FieldType = typename DataType::FieldType;
+    using ColumnType = std::conditional_t<IsDecimalNumber<FieldType>, ColumnDecimal<FieldType>,
+                                          ColumnVector<FieldType>>;
+
+    ColumnPtr deserialize(const Slice* values, size_t num_values,
+                          NullMap* src_null_map) const override {
+        typename ColumnType::MutablePtr column;
+        if constexpr (IsDecimalNumber<FieldType>) {
+            column = ColumnType::create(num_values, 9);
+        } else {
+            column = ColumnType::create(num_values);
+        }
+        auto null_column = ColumnUInt8::create(num_values);
+        auto& data = column->get_data();
+        auto& null_map = null_column->get_data();
+        src_null_map->resize(num_values);
+
+        for (size_t i = 0; i < num_values; ++i) {
+            const Slice& value = values[i];
+            bool is_null_marker = value.size == 2 && value.data[0] == '\\' && value.data[1] == 'N';
+            (*src_null_map)[i] = is_null_marker;
+            if (is_null_marker) {
+                data[i] = FieldType();
+                null_map[i] = 1;
+                continue;
+            }
+            ReadBuffer read_buffer(value.data, value.size);
+            null_map[i] = !try_parse_impl<DataType>(data[i], read_buffer, nullptr) ||
+                          !read_buffer.eof();
+        }
+        return ColumnNullable::create(std::move(column), std::move(null_column));
+    }
+};
+
+std::unique_ptr<TextColumnDeserializer> TextColumnDeserializer::create(
+        const TypeDescriptor& type) {
+    switch (type.type) {
+    case TYPE_TINYINT:
+        return std::make_unique<TextColumnDeserializerImpl<DataTypeInt8>>();
+    case TYPE_SMALLINT:
+        return std::make_unique<TextColumnDeserializerImpl<DataTypeInt16>>();
+    case TYPE_INT:
+        return std::make_unique<TextColumnDeserializerImpl<DataTypeInt32>>();
+    case TYPE_BIGINT:
+        return std::make_unique<TextColumnDeserializerImpl<DataTypeInt64>>();
+    case TYPE_LARGEINT:
+        return std::make_unique<TextColumnDeserializerImpl<DataTypeInt128>>();
+    case TYPE_FLOAT:
+        return std::make_unique<TextColumnDeserializerImpl<DataTypeFloat32>>();
+    case TYPE_DOUBLE:
+        return std::make_unique<TextColumnDeserializerImpl<DataTypeFloat64>>();
+    case TYPE_DECIMALV2:
+        return std::make_unique<TextColumnDeserializerImpl<DataTypeDecimal<Decimal128>>>();
+    case TYPE_DATE:
+        return std::make_unique<TextColumnDeserializerImpl<DataTypeDate>>();
+    case TYPE_DATETIME:
+        return std::make_unique<TextColumnDeserializerImpl<DataTypeDateTime>>();
+    default:
+        return nullptr;
+    }
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,46 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+
+#include "runtime/types.h"
+#include "util/slice.h"
+#include "vec/columns/column_nullable.h"
+
+namespace doris::vectorized {
+
+/** Parses the text fields of a load straight into a column of the dest type.
+  * The result is the same as casting a string column of the fields, but the fields are neither
+  *  copied into a string column nor cast by a generic function, a whole batch is parsed by one
+  *  loop specialized for the type.
+  */
+class TextColumnDeserializer {
+public:
+    virtual ~TextColumnDeserializer() = default;
+
+    /// Returns nullptr if fields of the type can not be deserialized.
+    static std::unique_ptr<TextColumnDeserializer> create(const TypeDescriptor& type);
+
+    /// Returns a nullable column of num_values rows, a row is null if its field is the null
+    ///  marker \N or can not be parsed. src_null_map is set for the null markers only.
+    virtual ColumnPtr deserialize(const Slice* values, size_t num_values,
+                                  NullMap* src_null_map) const = 0;
+};
+
+} // namespace doris::vectorized
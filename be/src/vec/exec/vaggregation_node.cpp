@@ -17,11 +17,20 @@
 
 #include "vec/exec/vaggregation_node.h"
 
+#include <atomic>
+#include <exception>
 #include <memory>
+#include <mutex>
 
+#include "common/config.h"
 #include "exec/exec_node.h"
+#include "runtime/exec_env.h"
 #include "runtime/mem_pool.h"
 #include "runtime/row_batch.h"
+#include "runtime/thread_context.h"
+#include "util/countdown_latch.h"
+#include "util/defer_op.h"
+#include "util/threadpool.h"
 #include "vec/core/block.h"
 #include "vec/data_types/data_type_nullable.h"
 #include "vec/data_types/data_type_string.h"
@@ -146,6 +155,11 @@ void AggregationNode::_init_hash_method(std::vector<VExprContext*>& probe_exprs)
         case TYPE_DECIMALV2:
             _agg_data.init(AggregatedDataVariants::Type::int128_key, is_nullable);
             return;
+        case TYPE_CHAR:
+        case TYPE_VARCHAR:
+        case TYPE_STRING:
+            _agg_data.init(AggregatedDataVariants::Type::string_key, is_nullable);
+            return;
         default:
             _agg_data.init(AggregatedDataVariants::Type::serialized);
         }
@@ -736,36 +750,7 @@ Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* i
             _agg_data._aggregated_method_variant);
 
     if (!ret_flag) {
-        std::visit(
-                [&](auto&& agg_method) -> void {
-                    using HashMethodType = std::decay_t<decltype(agg_method)>;
-                    using AggState = typename HashMethodType::State;
-                    AggState state(key_columns, _probe_key_sz, nullptr);
-                    /// For all rows.
-                    for (size_t i = 0; i < rows; ++i) {
-                        AggregateDataPtr aggregate_data = nullptr;
-
-                        auto emplace_result =
-                                state.emplace_key(agg_method.data, i, _agg_arena_pool);
-
-                        /// If a new key is inserted, initialize the states of the aggregate functions, and possibly something related to the key.
-                        if (emplace_result.is_inserted()) {
-                            /// exception-safety - if you can not allocate memory or create states, then destructors will not be called.
-                            emplace_result.set_mapped(nullptr);
-
-                            aggregate_data = _agg_arena_pool.aligned_alloc(
-                                    _total_size_of_aggregate_states, _align_aggregate_states);
-                            _create_agg_status(aggregate_data);
-
-                            emplace_result.set_mapped(aggregate_data);
-                        } else
-                            aggregate_data = emplace_result.get_mapped();
-
-                        places[i] = aggregate_data;
-                        assert(places[i] != nullptr);
-                    }
-                },
-                _agg_data._aggregated_method_variant);
+        _emplace_into_hash_table(places.data(), key_columns, rows);
 
         for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
             _aggregate_evaluators[i]->execute_batch_add(in_block, _offsets_of_aggregate_states[i],
@@ -776,37 +761,25 @@ Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* i
     return Status::OK();
 }
 
-Status AggregationNode::_execute_with_serialized_key(Block* block) {
-    SCOPED_TIMER(_build_timer);
-    DCHECK(!_probe_expr_ctxs.empty());
-
-    size_t key_size = _probe_expr_ctxs.size();
-    ColumnRawPtrs key_columns(key_size);
-    {
-        SCOPED_TIMER(_expr_timer);
-        for (size_t i = 0; i < key_size; ++i) {
-            int result_column_id = -1;
-            RETURN_IF_ERROR(_probe_expr_ctxs[i]->execute(block, &result_column_id));
-            block->get_by_position(result_column_id).column =
-                    block->get_by_position(result_column_id)
-                            .column->convert_to_full_column_if_const();
-            key_columns[i] = block->get_by_position(result_column_id).column.get();
-        }
-    }
-
-    int rows = block->rows();
-    PODArray<AggregateDataPtr> places(rows);
-
+void AggregationNode::_emplace_into_hash_table(AggregateDataPtr* places, ColumnRawPtrs& key_columns,
+                                               const size_t num_rows) {
     std::visit(
             [&](auto&& agg_method) -> void {
                 using HashMethodType = std::decay_t<decltype(agg_method)>;
                 using AggState = typename HashMethodType::State;
                 AggState state(key_columns, _probe_key_sz, nullptr);
+
+                state.get_hash_values(agg_method.data, num_rows, _agg_arena_pool, _hash_values);
                 /// For all rows.
-                for (size_t i = 0; i < rows; ++i) {
+                for (size_t i = 0; i < num_rows; ++i) {
                     AggregateDataPtr aggregate_data = nullptr;
 
-                    auto emplace_result = state.emplace_key(agg_method.data, i, _agg_arena_pool);
+                    if (i + HASH_TABLE_PREFETCH_DIST < num_rows) {
+                        state.template prefetch_by_hash<false>(
+                                agg_method.data, _hash_values[i + HASH_TABLE_PREFETCH_DIST]);
+                    }
+                    auto emplace_result =
+                            state.emplace_key(agg_method.data, _hash_values[i], i, _agg_arena_pool);
 
                     /// If a new key is inserted, initialize the states of the aggregate functions, and possibly something related to the key.
                     if (emplace_result.is_inserted()) {
@@ -827,6 +800,36 @@ Status AggregationNode::_execute_with_serialized_key(Block* block) {
             },
             _agg_data._aggregated_method_variant);
 
+    // The streaming preaggregation keeps its table in the cache, see
+    // _should_expand_preagg_hash_tables().
+    if (!_is_streaming_preagg) {
+        _try_convert_to_two_level();
+    }
+}
+
+Status AggregationNode::_execute_with_serialized_key(Block* block) {
+    SCOPED_TIMER(_build_timer);
+    DCHECK(!_probe_expr_ctxs.empty());
+
+    size_t key_size = _probe_expr_ctxs.size();
+    ColumnRawPtrs key_columns(key_size);
+    {
+        SCOPED_TIMER(_expr_timer);
+        for (size_t i = 0; i < key_size; ++i) {
+            int result_column_id = -1;
+            RETURN_IF_ERROR(_probe_expr_ctxs[i]->execute(block, &result_column_id));
+            block->get_by_position(result_column_id).column =
+                    block->get_by_position(result_column_id)
+                            .column->convert_to_full_column_if_const();
+            key_columns[i] = block->get_by_position(result_column_id).column.get();
+        }
+    }
+
+    int rows = block->rows();
+    PODArray<AggregateDataPtr> places(rows);
+
+    _emplace_into_hash_table(places.data(), key_columns, rows);
+
     for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
         _aggregate_evaluators[i]->execute_batch_add(block, _offsets_of_aggregate_states[i],
                                                     places.data(), &_agg_arena_pool);
@@ -837,6 +840,10 @@ Status AggregationNode::_execute_with_serialized_key(Block* block) {
 
 Status AggregationNode::_get_with_serialized_key_result(RuntimeState* state, Block* block,
                                                         bool* eos) {
+    if (_agg_data.is_two_level()) {
+        return _get_two_level_result(state, block, eos);
+    }
+
     bool mem_reuse = block->mem_reuse();
     auto column_withschema = VectorizedUtils::create_columns_with_type_and_name(row_desc());
     int key_size = _probe_expr_ctxs.size();
@@ -914,6 +921,10 @@ Status AggregationNode::_get_with_serialized_key_result(RuntimeState* state, Blo
 
 Status AggregationNode::_serialize_with_serialized_key_result(RuntimeState* state, Block* block,
                                                               bool* eos) {
+    if (_agg_data.is_two_level()) {
+        return _get_two_level_result(state, block, eos);
+    }
+
     int key_size = _probe_expr_ctxs.size();
     int agg_size = _aggregate_evaluators.size();
     MutableColumns value_columns(agg_size);
@@ -1016,35 +1027,7 @@ Status AggregationNode::_merge_with_serialized_key(Block* block) {
     int rows = block->rows();
     PODArray<AggregateDataPtr> places(rows);
 
-    std::visit(
-            [&](auto&& agg_method) -> void {
-                using HashMethodType = std::decay_t<decltype(agg_method)>;
-                using AggState = typename HashMethodType::State;
-                AggState state(key_columns, _probe_key_sz, nullptr);
-                /// For all rows.
-                for (size_t i = 0; i < rows; ++i) {
-                    AggregateDataPtr aggregate_data = nullptr;
-
-                    auto emplace_result = state.emplace_key(agg_method.data, i, _agg_arena_pool);
-
-                    /// If a new key is inserted, initialize the states of the aggregate functions, and possibly something related to the key.
-                    if (emplace_result.is_inserted()) {
-                        /// exception-safety - if you can not allocate memory or create states, then destructors will not be called.
-                        emplace_result.set_mapped(nullptr);
-
-                        aggregate_data = _agg_arena_pool.aligned_alloc(
-                                _total_size_of_aggregate_states, _align_aggregate_states);
-                        _create_agg_status(aggregate_data);
-
-                        emplace_result.set_mapped(aggregate_data);
-                    } else
-                        aggregate_data = emplace_result.get_mapped();
-
-                    places[i] = aggregate_data;
-                    assert(places[i] != nullptr);
-                }
-            },
-            _agg_data._aggregated_method_variant);
+    _emplace_into_hash_table(places.data(), key_columns, rows);
 
     std::unique_ptr<char[]> deserialize_buffer(new char[_total_size_of_aggregate_states]);
 
@@ -1078,6 +1061,200 @@ Status AggregationNode::_merge_with_serialized_key(Block* block) {
     return Status::OK();
 }
 
+void AggregationNode::_try_convert_to_two_level() {
+    if (!_agg_data.is_convertible_to_two_level()) {
+        return;
+    }
+
+    bool should_convert = std::visit(
+            [&](auto&& agg_method) -> bool {
+                auto& data = agg_method.data;
+                int64_t rows = data.size();
+                int64_t bytes = data.get_buffer_size_in_bytes() + _agg_arena_pool.size();
+                return (config::agg_two_level_hash_table_threshold_rows > 0 &&
+                        rows >= config::agg_two_level_hash_table_threshold_rows) ||
+                       (config::agg_two_level_hash_table_threshold_bytes > 0 &&
+                        bytes >= config::agg_two_level_hash_table_threshold_bytes);
+            },
+            _agg_data._aggregated_method_variant);
+
+    if (should_convert) {
+        _agg_data.convert_to_two_level();
+        runtime_profile()->append_exec_option("Two-level Hash Table");
+    }
+}
+
+Status AggregationNode::_get_two_level_result(RuntimeState* state, Block* block, bool* eos) {
+    SCOPED_TIMER(_get_results_timer);
+    while (_two_level_result_blocks.empty() && !_two_level_result_done) {
+        _build_two_level_result_blocks(state);
+    }
+
+    if (!_two_level_result_blocks.empty()) {
+        block->swap(_two_level_result_blocks.back());
+        _two_level_result_blocks.pop_back();
+    }
+    *eos = _two_level_result_blocks.empty() && _two_level_result_done;
+    return Status::OK();
+}
+
+void AggregationNode::_build_two_level_result_blocks(RuntimeState* state) {
+    int key_size = _probe_expr_ctxs.size();
+    ColumnsWithTypeAndName result_schema;
+    if (_needs_finalize) {
+        result_schema = VectorizedUtils::create_columns_with_type_and_name(row_desc());
+    } else {
+        for (int i = 0; i < key_size; ++i) {
+            result_schema.emplace_back(_probe_expr_ctxs[i]->root()->data_type(),
+                                       _probe_expr_ctxs[i]->root()->expr_name());
+        }
+        auto serialize_string_type = std::make_shared<DataTypeString>();
+        for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
+            result_schema.emplace_back(serialize_string_type, "");
+        }
+    }
+
+    // Every thread fills the columns of its own buckets, a block is cut every batch_size rows.
+    auto create_columns = [&](MutableColumns& key_columns, MutableColumns& value_columns) {
+        for (int i = 0; i < result_schema.size(); ++i) {
+            auto column = result_schema[i].type->create_column();
+            if (i < key_size) {
+                key_columns.emplace_back(std::move(column));
+            } else {
+                value_columns.emplace_back(std::move(column));
+            }
+        }
+    };
+    auto insert_values = [&](AggregateDataPtr mapped, MutableColumns& value_columns) {
+        for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
+            if (_needs_finalize) {
+                _aggregate_evaluators[i]->insert_result_info(
+                        mapped + _offsets_of_aggregate_states[i], value_columns[i].get());
+            } else {
+                VectorBufferWriter writer(*reinterpret_cast<ColumnString*>(value_columns[i].get()));
+                _aggregate_evaluators[i]->function()->serialize(
+                        mapped + _offsets_of_aggregate_states[i], writer);
+                writer.commit();
+            }
+        }
+    };
+    auto make_block = [&](MutableColumns& key_columns, MutableColumns& value_columns) {
+        ColumnsWithTypeAndName columns = result_schema;
+        for (int i = 0; i < columns.size(); ++i) {
+            if (i < key_size) {
+                columns[i].column = std::move(key_columns[i]);
+            } else {
+                columns[i].column = std::move(value_columns[i - key_size]);
+            }
+        }
+        key_columns.clear();
+        value_columns.clear();
+        return Block(columns);
+    };
+
+    std::visit(
+            [&](auto&& agg_method) -> void {
+                using HashTableType = std::decay_t<decltype(agg_method.data)>;
+                if constexpr (IsTwoLevelHashTable<HashTableType>::value) {
+                    auto& data = agg_method.data;
+
+                    // The current thread builds buckets too, so the result is always complete
+                    // even if no task could be submitted to the pool. A round has a bucket for
+                    // every thread, so only the results of a round are held at a time.
+                    ThreadPool* pool = state->exec_env() == nullptr
+                                               ? nullptr
+                                               : state->exec_env()->agg_thread_pool();
+                    int num_tasks = pool == nullptr
+                                            ? 0
+                                            : std::min<int>(config::agg_thread_pool_thread_num,
+                                                            HashTableType::NUM_BUCKETS) -
+                                                      1;
+                    num_tasks = std::max(num_tasks, 0);
+                    size_t round_end = std::min<size_t>(_two_level_next_bucket + num_tasks + 1,
+                                                        HashTableType::NUM_BUCKETS);
+                    std::atomic<size_t> next_bucket {_two_level_next_bucket};
+                    std::mutex result_lock;
+
+                    auto build_buckets = [&]() {
+                        std::vector<Block> blocks;
+                        MutableColumns key_columns;
+                        MutableColumns value_columns;
+                        for (size_t bucket = next_bucket++; bucket < round_end;
+                             bucket = next_bucket++) {
+                            auto& impl = data.impls[bucket];
+                            for (auto it = impl.begin(); it != impl.end(); ++it) {
+                                if (key_columns.empty()) {
+                                    create_columns(key_columns, value_columns);
+                                }
+                                agg_method.insert_key_into_columns(it->get_first(), key_columns,
+                                                                   _probe_key_sz);
+                                insert_values(it->get_second(), value_columns);
+                                if (key_columns[0]->size() >= state->batch_size()) {
+                                    blocks.emplace_back(make_block(key_columns, value_columns));
+                                }
+                            }
+                        }
+                        if (!key_columns.empty()) {
+                            blocks.emplace_back(make_block(key_columns, value_columns));
+                        }
+
+                        std::lock_guard<std::mutex> l(result_lock);
+                        for (auto& block : blocks) {
+                            _two_level_result_blocks.emplace_back(std::move(block));
+                        }
+                    };
+
+                    // a task always counts down, and an exception thrown by it is rethrown
+                    // here after all tasks are done, they refer to the locals of this frame
+                    CountDownLatch latch(num_tasks);
+                    std::exception_ptr task_exception;
+                    for (int i = 0; i < num_tasks; ++i) {
+                        auto st = pool->submit_func([&]() {
+                            Defer defer {[&]() { latch.count_down(); }};
+                            try {
+                                SCOPED_ATTACH_TASK_THREAD(state, mem_tracker());
+                                build_buckets();
+                            } catch (...) {
+                                std::lock_guard<std::mutex> l(result_lock);
+                                task_exception = std::current_exception();
+                            }
+                        });
+                        if (!st.ok()) {
+                            latch.count_down();
+                        }
+                    }
+                    {
+                        Defer defer {[&]() { latch.wait(); }};
+                        build_buckets();
+                    }
+                    if (task_exception) {
+                        std::rethrow_exception(task_exception);
+                    }
+                    _two_level_next_bucket = round_end;
+                    if (_two_level_next_bucket < HashTableType::NUM_BUCKETS) {
+                        return;
+                    }
+
+                    _two_level_result_done = true;
+                    if (data.has_null_key_data()) {
+                        // only one key of group by support wrap null key
+                        DCHECK(key_size == 1);
+                        MutableColumns key_columns;
+                        MutableColumns value_columns;
+                        create_columns(key_columns, value_columns);
+                        DCHECK(key_columns[0]->is_nullable());
+                        key_columns[0]->insert_data(nullptr, 0);
+                        insert_values(data.get_null_key_data(), value_columns);
+                        _two_level_result_blocks.emplace_back(
+                                make_block(key_columns, value_columns));
+                    }
+                } else {
+                    _two_level_result_done = true;
+                }
+            },
+            _agg_data._aggregated_method_variant);
+}
+
 void AggregationNode::_update_memusage_with_serialized_key() {
     std::visit(
             [&](auto&& agg_method) -> void {
@@ -25,6 +25,8 @@
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/common/columns_hashing.h"
 #include "vec/common/hash_table/fixed_hash_map.h"
+#include "vec/common/hash_table/string_hash_map.h"
+#include "vec/common/hash_table/two_level_hash_map.h"
 #include "vec/exprs/vectorized_agg_fn.h"
 
 namespace doris {
@@ -74,6 +76,42 @@ struct AggregationMethodSerialized {
 
 using AggregatedDataWithoutKey = AggregateDataPtr;
 using AggregatedDataWithStringKey = HashMapWithSavedHash<StringRef, AggregateDataPtr>;
+using AggregatedDataWithStringKeyTwoLevel =
+        TwoLevelHashMapWithSavedHash<StringRef, AggregateDataPtr>;
+using AggregatedDataWithShortStringKey = StringHashMap<AggregateDataPtr>;
+
+/// For the case where there is one string key. The keys are kept in a StringHashMap, the
+/// keys of at most 24 bytes are stored inline and only the longer ones are copied to the arena.
+template <typename TData>
+struct AggregationMethodStringNoCache {
+    using Data = TData;
+    using Key = typename Data::key_type;
+    using Mapped = typename Data::mapped_type;
+    using Iterator = typename Data::iterator;
+
+    Data data;
+    Iterator iterator;
+    bool inited = false;
+
+    AggregationMethodStringNoCache() = default;
+
+    template <typename Other>
+    explicit AggregationMethodStringNoCache(const Other& other) : data(other.data) {}
+
+    using State = ColumnsHashing::HashMethodString<typename Data::value_type, Mapped, true, false>;
+
+    static void insert_key_into_columns(const StringRef& key, MutableColumns& key_columns,
+                                        const Sizes&) {
+        key_columns[0]->insert_data(key.data, key.size);
+    }
+
+    void init_once() {
+        if (!inited) {
+            inited = true;
+            iterator = data.begin();
+        }
+    }
+};
 
 /// For the case where there is one numeric key.
 /// FieldType is UInt8/16/32/64 for any type with corresponding bit width.
@@ -117,6 +155,13 @@ template <typename Base>
 struct AggregationDataWithNullKey : public Base {
     using Base::Base;
 
+    /// Convert from the data of another hash table, e.g. the flat one of a two-level table.
+    template <typename Other>
+    explicit AggregationDataWithNullKey(const Other& other)
+            : Base(other),
+              has_null_key(other.has_null_key_data()),
+              null_key_data(other.get_null_key_data()) {}
+
     bool& has_null_key_data() { return has_null_key; }
     AggregateDataPtr& get_null_key_data() { return null_key_data; }
     bool has_null_key_data() const { return has_null_key; }
@@ -253,15 +298,34 @@ using AggregatedDataWithUInt64Key = HashMap<UInt64, AggregateDataPtr, HashCRC32<
 using AggregatedDataWithUInt128Key = HashMap<UInt128, AggregateDataPtr, HashCRC32<UInt128>>;
 using AggregatedDataWithUInt256Key = HashMap<UInt256, AggregateDataPtr, HashCRC32<UInt256>>;
 
+using AggregatedDataWithUInt32KeyTwoLevel =
+        TwoLevelHashMap<UInt32, AggregateDataPtr, HashCRC32<UInt32>>;
+using AggregatedDataWithUInt64KeyTwoLevel =
+        TwoLevelHashMap<UInt64, AggregateDataPtr, HashCRC32<UInt64>>;
+using AggregatedDataWithUInt128KeyTwoLevel =
+        TwoLevelHashMap<UInt128, AggregateDataPtr, HashCRC32<UInt128>>;
+using AggregatedDataWithUInt256KeyTwoLevel =
+        TwoLevelHashMap<UInt256, AggregateDataPtr, HashCRC32<UInt256>>;
+
 using AggregatedDataWithNullableUInt8Key = AggregationDataWithNullKey<AggregatedDataWithUInt8Key>;
 using AggregatedDataWithNullableUInt16Key = AggregationDataWithNullKey<AggregatedDataWithUInt16Key>;
 using AggregatedDataWithNullableUInt32Key = AggregationDataWithNullKey<AggregatedDataWithUInt32Key>;
 using AggregatedDataWithNullableUInt64Key = AggregationDataWithNullKey<AggregatedDataWithUInt64Key>;
 using AggregatedDataWithNullableUInt128Key =
         AggregationDataWithNullKey<AggregatedDataWithUInt128Key>;
+using AggregatedDataWithNullableShortStringKey =
+        AggregationDataWithNullKey<AggregatedDataWithShortStringKey>;
+
+using AggregatedDataWithNullableUInt32KeyTwoLevel =
+        AggregationDataWithNullKey<AggregatedDataWithUInt32KeyTwoLevel>;
+using AggregatedDataWithNullableUInt64KeyTwoLevel =
+        AggregationDataWithNullKey<AggregatedDataWithUInt64KeyTwoLevel>;
+using AggregatedDataWithNullableUInt128KeyTwoLevel =
+        AggregationDataWithNullKey<AggregatedDataWithUInt128KeyTwoLevel>;
 
 using AggregatedMethodVariants = std::variant<
         AggregationMethodSerialized<AggregatedDataWithStringKey>,
+        AggregationMethodStringNoCache<AggregatedDataWithShortStringKey>,
         AggregationMethodOneNumber<UInt8, AggregatedDataWithUInt8Key, false>,
         AggregationMethodOneNumber<UInt16, AggregatedDataWithUInt16Key, false>,
         AggregationMethodOneNumber<UInt32, AggregatedDataWithUInt32Key>,
@@ -277,12 +341,37 @@ using AggregatedMethodVariants = std::variant<
                 AggregationMethodOneNumber<UInt64, AggregatedDataWithNullableUInt64Key>>,
         AggregationMethodSingleNullableColumn<
                 AggregationMethodOneNumber<UInt128, AggregatedDataWithNullableUInt128Key>>,
+        AggregationMethodSingleNullableColumn<
+                AggregationMethodStringNoCache<AggregatedDataWithNullableShortStringKey>>,
         AggregationMethodKeysFixed<AggregatedDataWithUInt64Key, false>,
         AggregationMethodKeysFixed<AggregatedDataWithUInt64Key, true>,
         AggregationMethodKeysFixed<AggregatedDataWithUInt128Key, false>,
         AggregationMethodKeysFixed<AggregatedDataWithUInt128Key, true>,
         AggregationMethodKeysFixed<AggregatedDataWithUInt256Key, false>,
-        AggregationMethodKeysFixed<AggregatedDataWithUInt256Key, true>>;
+        AggregationMethodKeysFixed<AggregatedDataWithUInt256Key, true>,
+        AggregationMethodSerialized<AggregatedDataWithStringKeyTwoLevel>,
+        AggregationMethodOneNumber<UInt32, AggregatedDataWithUInt32KeyTwoLevel>,
+        AggregationMethodOneNumber<UInt64, AggregatedDataWithUInt64KeyTwoLevel>,
+        AggregationMethodOneNumber<UInt128, AggregatedDataWithUInt128KeyTwoLevel>,
+        AggregationMethodSingleNullableColumn<
+                AggregationMethodOneNumber<UInt32, AggregatedDataWithNullableUInt32KeyTwoLevel>>,
+        AggregationMethodSingleNullableColumn<
+                AggregationMethodOneNumber<UInt64, AggregatedDataWithNullableUInt64KeyTwoLevel>>,
+        AggregationMethodSingleNullableColumn<
+                AggregationMethodOneNumber<UInt128, AggregatedDataWithNullableUInt128KeyTwoLevel>>,
+        AggregationMethodKeysFixed<AggregatedDataWithUInt64KeyTwoLevel, false>,
+        AggregationMethodKeysFixed<AggregatedDataWithUInt64KeyTwoLevel, true>,
+        AggregationMethodKeysFixed<AggregatedDataWithUInt128KeyTwoLevel, false>,
+        AggregationMethodKeysFixed<AggregatedDataWithUInt128KeyTwoLevel, true>,
+        AggregationMethodKeysFixed<AggregatedDataWithUInt256KeyTwoLevel, false>,
+        AggregationMethodKeysFixed<AggregatedDataWithUInt256KeyTwoLevel, true>>;
+
+/// Whether the data of an aggregation method is a two-level hash table.
+template <typename Data, typename = void>
+struct IsTwoLevelHashTable : std::false_type {};
+
+template <typename Data>
+struct IsTwoLevelHashTable<Data, std::void_t<decltype(Data::NUM_BUCKETS)>> : std::true_type {};
 
 struct AggregatedDataVariants {
     AggregatedDataVariants() = default;
@@ -303,13 +392,17 @@ struct AggregatedDataVariants {
         int128_key,
         int64_keys,
         int128_keys,
-        int256_keys
+        int256_keys,
+        string_key
     };
 
     Type _type = Type::EMPTY;
+    bool _is_nullable = false;
+    bool _is_two_level = false;
 
     void init(Type type, bool is_nullable = false) {
         _type = type;
+        _is_nullable = is_nullable;
         switch (_type) {
         case Type::without_key:
             break;
@@ -392,10 +485,137 @@ struct AggregatedDataVariants {
                         .emplace<AggregationMethodKeysFixed<AggregatedDataWithUInt256Key, false>>();
             }
             break;
+        case Type::string_key:
+            if (is_nullable) {
+                _aggregated_method_variant.emplace<
+                        AggregationMethodSingleNullableColumn<AggregationMethodStringNoCache<
+                                AggregatedDataWithNullableShortStringKey>>>();
+            } else {
+                _aggregated_method_variant.emplace<
+                        AggregationMethodStringNoCache<AggregatedDataWithShortStringKey>>();
+            }
+            break;
         default:
             DCHECK(false) << "Do not have a rigth agg data type";
         }
     }
+
+    bool is_two_level() const { return _is_two_level; }
+
+    /// The small fixed and the short string keys are not worth to be split into buckets.
+    bool is_convertible_to_two_level() const {
+        switch (_type) {
+        case Type::serialized:
+        case Type::int32_key:
+        case Type::int64_key:
+        case Type::int128_key:
+        case Type::int64_keys:
+        case Type::int128_keys:
+        case Type::int256_keys:
+            return !_is_two_level;
+        default:
+            return false;
+        }
+    }
+
+    /// Move the keys of the flat hash table into a two-level one, the aggregate states are kept
+    /// in the arena, so the places handed out before stay valid.
+    void convert_to_two_level() {
+        DCHECK(is_convertible_to_two_level());
+        switch (_type) {
+        case Type::serialized:
+            _convert_to_two_level<
+                    AggregationMethodSerialized<AggregatedDataWithStringKey>,
+                    AggregationMethodSerialized<AggregatedDataWithStringKeyTwoLevel>>();
+            break;
+        case Type::int32_key:
+            if (_is_nullable) {
+                _convert_to_two_level<
+                        AggregationMethodSingleNullableColumn<AggregationMethodOneNumber<
+                                UInt32, AggregatedDataWithNullableUInt32Key>>,
+                        AggregationMethodSingleNullableColumn<AggregationMethodOneNumber<
+                                UInt32, AggregatedDataWithNullableUInt32KeyTwoLevel>>>();
+            } else {
+                _convert_to_two_level<
+                        AggregationMethodOneNumber<UInt32, AggregatedDataWithUInt32Key>,
+                        AggregationMethodOneNumber<UInt32, AggregatedDataWithUInt32KeyTwoLevel>>();
+            }
+            break;
+        case Type::int64_key:
+            if (_is_nullable) {
+                _convert_to_two_level<
+                        AggregationMethodSingleNullableColumn<AggregationMethodOneNumber<
+                                UInt64, AggregatedDataWithNullableUInt64Key>>,
+                        AggregationMethodSingleNullableColumn<AggregationMethodOneNumber<
+                                UInt64, AggregatedDataWithNullableUInt64KeyTwoLevel>>>();
+            } else {
+                _convert_to_two_level<
+                        AggregationMethodOneNumber<UInt64, AggregatedDataWithUInt64Key>,
+                        AggregationMethodOneNumber<UInt64, AggregatedDataWithUInt64KeyTwoLevel>>();
+            }
+            break;
+        case Type::int128_key:
+            if (_is_nullable) {
+                _convert_to_two_level<
+                        AggregationMethodSingleNullableColumn<AggregationMethodOneNumber<
+                                UInt128, AggregatedDataWithNullableUInt128Key>>,
+                        AggregationMethodSingleNullableColumn<AggregationMethodOneNumber<
+                                UInt128, AggregatedDataWithNullableUInt128KeyTwoLevel>>>();
+            } else {
+                _convert_to_two_level<
+                        AggregationMethodOneNumber<UInt128, AggregatedDataWithUInt128Key>,
+                        AggregationMethodOneNumber<UInt128,
+                                                   AggregatedDataWithUInt128KeyTwoLevel>>();
+            }
+            break;
+        case Type::int64_keys:
+            if (_is_nullable) {
+                _convert_to_two_level<
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt64Key, true>,
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt64KeyTwoLevel, true>>();
+            } else {
+                _convert_to_two_level<
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt64Key, false>,
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt64KeyTwoLevel, false>>();
+            }
+            break;
+        case Type::int128_keys:
+            if (_is_nullable) {
+                _convert_to_two_level<
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt128Key, true>,
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt128KeyTwoLevel, true>>();
+            } else {
+                _convert_to_two_level<
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt128Key, false>,
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt128KeyTwoLevel,
+                                                   false>>();
+            }
+            break;
+        case Type::int256_keys:
+            if (_is_nullable) {
+                _convert_to_two_level<
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt256Key, true>,
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt256KeyTwoLevel, true>>();
+            } else {
+                _convert_to_two_level<
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt256Key, false>,
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt256KeyTwoLevel,
+                                                   false>>();
+            }
+            break;
+        default:
+            return;
+        }
+        _is_two_level = true;
+    }
+
+private:
+    template <typename Method, typename TwoLevelMethod>
+    void _convert_to_two_level() {
+        // the two-level table copies the cells, the flat table is freed when it goes out of scope
+        Method method(std::move(std::get<Method>(_aggregated_method_variant)));
+        _aggregated_method_variant.emplace<TwoLevelMethod>(method);
+    }
 };
 
 using AggregatedDataVariantsPtr = std::shared_ptr<AggregatedDataVariants>;
@@ -446,6 +666,8 @@ private:
     AggregatedDataVariants _agg_data;
 
     Arena _agg_arena_pool;
+    // The hash values of the keys of a block, see HashMethodBase::get_hash_values().
+    std::vector<size_t> _hash_values;
 
     RuntimeProfile::Counter* _build_timer;
     RuntimeProfile::Counter* _exec_timer;
@@ -458,6 +680,13 @@ private:
     bool _should_expand_hash_table = true;
     std::vector<char*> _streaming_pre_places;
 
+    // The result blocks of a two-level hash table are built a round of buckets at a time,
+    // the buckets of a round are built by several threads, and the blocks are returned one
+    // by one before the next round is built.
+    size_t _two_level_next_bucket = 0;
+    bool _two_level_result_done = false;
+    std::vector<Block> _two_level_result_blocks;
+
 private:
     /// Return true if we should keep expanding hash tables in the preagg. If false,
     /// the preagg should pass through any rows it can't fit in its tables.
@@ -479,7 +708,15 @@ private:
     Status _serialize_with_serialized_key_result(RuntimeState* state, Block* block, bool* eos);
     Status _pre_agg_with_serialized_key(Block* in_block, Block* out_block);
     Status _execute_with_serialized_key(Block* block);
+    // Find or create the aggregate states of key_columns in the hash table.
+    void _emplace_into_hash_table(AggregateDataPtr* places, ColumnRawPtrs& key_columns,
+                                  const size_t num_rows);
     Status _merge_with_serialized_key(Block* block);
+    // Convert the hash table to a two-level one if it grows beyond the configured thresholds.
+    void _try_convert_to_two_level();
+    Status _get_two_level_result(RuntimeState* state, Block* block, bool* eos);
+    // Build the result blocks of the next round of buckets.
+    void _build_two_level_result_blocks(RuntimeState* state);
     void _update_memusage_with_serialized_key();
     void _close_with_serialized_key();
     void _init_hash_method(std::vector<VExprContext*>& probe_exprs);
@@ -17,12 +17,16 @@
 
 #include "vec/exec/vanalytic_eval_node.h"
 
+#include "common/config.h"
 #include "exprs/agg_fn_evaluator.h"
 #include "exprs/anyval_util.h"
 #include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
+#include "runtime/tmp_file_mgr.h"
 #include "udf/udf_internal.h"
+#include "util/uid_util.h"
 #include "vec/utils/util.hpp"
 
 namespace doris::vectorized {
@@ -151,6 +155,8 @@ Status VAnalyticEvalNode::prepare(RuntimeState* state) {
     DCHECK(child(0)->row_desc().is_prefix_of(row_desc()));
     _mem_pool.reset(new MemPool(mem_tracker().get()));
     _evaluation_timer = ADD_TIMER(runtime_profile(), "EvaluationTime");
+    _spill_timer = ADD_TIMER(runtime_profile(), "SpillTime");
+    _spilled_bytes_counter = ADD_COUNTER(runtime_profile(), "SpilledBytes", TUnit::BYTES);
     SCOPED_TIMER(_evaluation_timer);
 
     _intermediate_tuple_desc = state->desc_tbl().get_tuple_descriptor(_intermediate_tuple_id);
@@ -186,6 +192,7 @@ Status VAnalyticEvalNode::prepare(RuntimeState* state) {
     _fn_place_ptr =
             _agg_arena_pool.aligned_alloc(_total_size_of_aggregate_states, _align_aggregate_states);
     _create_agg_status();
+    _init_rows_frame_evaluators();
     _executor.insert_result =
             std::bind<void>(&VAnalyticEvalNode::_insert_result_info, this, std::placeholders::_1);
     _executor.execute =
@@ -239,7 +246,9 @@ Status VAnalyticEvalNode::close(RuntimeState* state) {
     for (size_t i = 0; i < _agg_functions_size; ++i) VExpr::close(_agg_expr_ctxs[i], state);
     for (auto* agg_function : _agg_functions) agg_function->close(state);
 
+    _segment_trees.clear();
     _destory_agg_status();
+    WARN_IF_ERROR(_remove_spill_file(), "failed to remove the spill file of analytic node");
     return ExecNode::close(state);
 }
 
@@ -328,8 +337,8 @@ Status VAnalyticEvalNode::_get_next_for_rows(RuntimeState* state, Block* block,
                 range_start.pos = _current_row_position;
                 range_end.pos = _current_row_position +
                                 1; //going on calculate,add up data, no need to reset state
+                _executor.execute(_partition_by_start, _partition_by_end, range_start, range_end);
             } else {
-                _reset_agg_status();
                 if (!_window.__isset
                              .window_start) { //[preceding, offset]        --unbound: [preceding, following]
                     range_start.pos = _partition_by_start.pos;
@@ -337,8 +346,8 @@ Status VAnalyticEvalNode::_get_next_for_rows(RuntimeState* state, Block* block,
                     range_start.pos = _current_row_position + _rows_start_offset;
                 }
                 range_end.pos = _current_row_position + _rows_end_offset + 1;
+                _execute_for_rows_frame(range_start, range_end);
             }
-            _executor.execute(_partition_by_start, _partition_by_end, range_start, range_end);
             _executor.insert_result(current_block_rows);
         }
         if (_window_end_position == current_block_rows) {
@@ -511,10 +520,108 @@ Status VAnalyticEvalNode::_fetch_next_block_data(RuntimeState* state) {
     }
     //TODO: if need improvement, the is a tips to maintain a free queue,
     //so the memory could reuse, no need to new/delete again;
+    _buffered_bytes += block.allocated_bytes();
     _input_blocks.emplace_back(std::move(block));
+    _spilled_blocks.emplace_back();
+    if (config::analytic_spill_threshold_bytes > 0 &&
+        _buffered_bytes > config::analytic_spill_threshold_bytes) {
+        RETURN_IF_ERROR(_spill_input_blocks(state));
+    }
+    return Status::OK();
+}
+
+//a partition is buffered until its end is found, so a big partition could use too much memory.
+//the blocks after the one being output are written to a tmp file, but the partition by and order
+//by columns are kept to search the boundaries, the other columns are replaced by constant columns
+//of the same rows and read back when the block is output
+Status VAnalyticEvalNode::_spill_input_blocks(RuntimeState* state) {
+    SCOPED_TIMER(_spill_timer);
+    if (_spill_file == nullptr) {
+        _spill_file_path = fmt::format("{}/analytic_{}_{}",
+                                       state->exec_env()->tmp_file_mgr()->get_tmp_dir_path(),
+                                       print_id(state->fragment_instance_id()), id());
+        RETURN_IF_ERROR(Env::Default()->new_random_rw_file(_spill_file_path, &_spill_file));
+    }
+
+    std::set<size_t> key_column_idxs(_partition_by_column_idxs.begin(),
+                                     _partition_by_column_idxs.end());
+    key_column_idxs.insert(_ordey_by_column_idxs.begin(), _ordey_by_column_idxs.end());
+    for (int64_t i = _output_block_index + 1; i < _input_blocks.size(); ++i) {
+        SpilledBlock& spilled = _spilled_blocks[i];
+        if (spilled.size > 0) {
+            continue;
+        }
+        Block& block = _input_blocks[i];
+        Block payload;
+        for (size_t idx = 0; idx < _origin_cols.size(); ++idx) {
+            if (key_column_idxs.count(idx) == 0) {
+                payload.insert(block.get_by_position(idx));
+                spilled.column_idxs.emplace_back(idx);
+            }
+        }
+        if (payload.columns() == 0) {
+            continue;
+        }
+
+        PBlock pblock;
+        size_t uncompressed_bytes = 0;
+        size_t compressed_bytes = 0;
+        std::string column_values;
+        RETURN_IF_ERROR(payload.serialize(&pblock, &uncompressed_bytes, &compressed_bytes,
+                                          &column_values));
+        pblock.set_column_values(std::move(column_values));
+        std::string data;
+        if (!pblock.SerializeToString(&data)) {
+            return Status::InternalError("failed to serialize the spilled block of analytic node");
+        }
+        RETURN_IF_ERROR(_spill_file->write_at(_spill_file_size, data));
+        spilled.offset = _spill_file_size;
+        spilled.size = data.size();
+        _spill_file_size += data.size();
+        COUNTER_UPDATE(_spilled_bytes_counter, data.size());
+
+        int64_t block_bytes = block.allocated_bytes();
+        size_t rows = block.rows();
+        for (size_t idx : spilled.column_idxs) {
+            auto& column = block.get_by_position(idx);
+            column.column = column.type->create_column_const_with_default_value(rows);
+        }
+        _buffered_bytes -= block_bytes - block.allocated_bytes();
+    }
+    return Status::OK();
+}
+
+Status VAnalyticEvalNode::_restore_spilled_block(int64_t block_index) {
+    SCOPED_TIMER(_spill_timer);
+    SpilledBlock& spilled = _spilled_blocks[block_index];
+    std::string data(spilled.size, '\0');
+    RETURN_IF_ERROR(_spill_file->read_at(spilled.offset, Slice(data)));
+    PBlock pblock;
+    if (!pblock.ParseFromString(data)) {
+        return Status::InternalError("failed to parse the spilled block of analytic node");
+    }
+    Block payload(pblock);
+
+    Block& block = _input_blocks[block_index];
+    int64_t block_bytes = block.allocated_bytes();
+    for (size_t i = 0; i < spilled.column_idxs.size(); ++i) {
+        block.get_by_position(spilled.column_idxs[i]).column = payload.get_by_position(i).column;
+    }
+    _buffered_bytes += block.allocated_bytes() - block_bytes;
+    spilled.size = 0;
+    spilled.column_idxs.clear();
     return Status::OK();
 }
 
+Status VAnalyticEvalNode::_remove_spill_file() {
+    if (_spill_file == nullptr) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_spill_file->close());
+    _spill_file.reset();
+    return Env::Default()->delete_file(_spill_file_path);
+}
+
 Status VAnalyticEvalNode::_insert_range_column(vectorized::Block* block, VExprContext* expr,
                                                IColumn* dst_column, size_t length) {
     int result_col_id = -1;
@@ -533,6 +640,8 @@ bool VAnalyticEvalNode::_init_next_partition(BlockRowPos found_partition_end) {
         _partition_by_end = found_partition_end;
         _current_row_position = _partition_by_start.pos;
         _reset_agg_status();
+        _incremental_frame_start = _partition_by_start.pos;
+        _incremental_frame_end = _partition_by_start.pos;
         return true;
     }
     return false;
@@ -565,6 +674,10 @@ void VAnalyticEvalNode::_insert_result_info(int64_t current_block_rows) {
 }
 
 Status VAnalyticEvalNode::_output_current_block(Block* block) {
+    if (_spilled_blocks[_output_block_index].size > 0) {
+        RETURN_IF_ERROR(_restore_spilled_block(_output_block_index));
+    }
+    _buffered_bytes -= _input_blocks[_output_block_index].allocated_bytes();
     block->swap(std::move(_input_blocks[_output_block_index]));
     if (_origin_cols.size() < block->columns()) {
         block->erase_not_in(_origin_cols);
@@ -596,6 +709,78 @@ void VAnalyticEvalNode::_execute_for_win_func(BlockRowPos partition_start,
     }
 }
 
+//sum/count/avg/min/max only depend on the rows in the frame, and the frame of ROWS only moves
+//forward, so they needn't add all the rows of the frame again for every row. the functions which
+//can remove a row, or only have the frame grow, update the state with the rows entering and leaving
+//the frame, the others merge the states of a segment tree. other functions are computed as before
+void VAnalyticEvalNode::_init_rows_frame_evaluators() {
+    static const std::set<std::string> frame_aggregate_functions = {"sum", "count", "avg", "min",
+                                                                    "max"};
+    _rows_frame_evaluators.assign(_agg_functions_size, RECOMPUTE);
+    _segment_trees.resize(_agg_functions_size);
+    if (_fn_scope != AnalyticFnScope::ROWS) {
+        return;
+    }
+    for (size_t i = 0; i < _agg_functions_size; ++i) {
+        const auto& function = _agg_functions[i]->function();
+        if (frame_aggregate_functions.count(function->get_name()) == 0) {
+            continue;
+        }
+        if (!_window.__isset.window_start || function->is_removable()) {
+            _rows_frame_evaluators[i] = INCREMENTAL;
+        } else {
+            _rows_frame_evaluators[i] = SEGMENT_TREE;
+        }
+    }
+}
+
+void VAnalyticEvalNode::_execute_for_rows_frame(BlockRowPos frame_start, BlockRowPos frame_end) {
+    //the frame is clipped to the partition, an empty frame stays at its start
+    int64_t start = std::clamp(frame_start.pos, _partition_by_start.pos, _partition_by_end.pos);
+    int64_t end = std::clamp(frame_end.pos, start, _partition_by_end.pos);
+    for (size_t i = 0; i < _agg_functions_size; ++i) {
+        AggregateDataPtr place = _fn_place_ptr + _offsets_of_aggregate_states[i];
+        const auto& function = _agg_functions[i]->function();
+        std::vector<const IColumn*> agg_columns;
+        for (int j = 0; j < _agg_intput_columns[i].size(); ++j) {
+            agg_columns.push_back(_agg_intput_columns[i][j].get());
+        }
+
+        switch (_rows_frame_evaluators[i]) {
+        case INCREMENTAL: {
+            int64_t remove_end = std::min(start, _incremental_frame_end);
+            for (int64_t row = _incremental_frame_start; row < remove_end; ++row) {
+                function->remove(place, agg_columns.data(), row, nullptr);
+            }
+            for (int64_t row = std::max(_incremental_frame_end, start); row < end; ++row) {
+                function->add(place, agg_columns.data(), row, nullptr);
+            }
+            break;
+        }
+        case SEGMENT_TREE: {
+            auto& tree = _segment_trees[i];
+            if (tree == nullptr || tree->begin() != _partition_by_start.pos ||
+                tree->end() != _partition_by_end.pos) {
+                tree.reset();
+                tree = std::make_unique<WindowSegmentTree>(function.get(), agg_columns,
+                                                           _partition_by_start.pos,
+                                                           _partition_by_end.pos);
+            }
+            _agg_functions[i]->reset(place);
+            tree->aggregate(place, start, end);
+            break;
+        }
+        default:
+            _agg_functions[i]->reset(place);
+            function->add_range_single_place(_partition_by_start.pos, _partition_by_end.pos,
+                                             frame_start.pos, frame_end.pos, place,
+                                             agg_columns.data(), nullptr);
+        }
+    }
+    _incremental_frame_start = start;
+    _incremental_frame_end = end;
+}
+
 //binary search for range to calculate peer group
 void VAnalyticEvalNode::_update_order_by_range() {
     _order_by_start = _order_by_end;
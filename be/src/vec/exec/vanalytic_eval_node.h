@@ -19,9 +19,11 @@
 
 #include <thrift/protocol/TDebugProtocol.h>
 
+#include "env/env.h"
 #include "exec/exec_node.h"
 #include "exprs/expr.h"
 #include "runtime/tuple.h"
+#include "vec/aggregate_functions/window_segment_tree.h"
 #include "vec/common/arena.h"
 #include "vec/core/block.h"
 #include "vec/exprs/vectorized_agg_fn.h"
@@ -60,6 +62,8 @@ private:
 
     void _execute_for_win_func(BlockRowPos partition_start, BlockRowPos partition_end,
                                BlockRowPos frame_start, BlockRowPos frame_end);
+    void _execute_for_rows_frame(BlockRowPos frame_start, BlockRowPos frame_end);
+    void _init_rows_frame_evaluators();
 
     Status _reset_agg_status();
     Status _init_result_columns();
@@ -76,6 +80,9 @@ private:
     BlockRowPos _compare_row_to_find_end(int idx, BlockRowPos start, BlockRowPos end);
 
     Status _fetch_next_block_data(RuntimeState* state);
+    Status _spill_input_blocks(RuntimeState* state);
+    Status _restore_spilled_block(int64_t block_index);
+    Status _remove_spill_file();
     Status _consumed_block_and_init_partition(RuntimeState* state, bool* next_partition, bool* eos);
     bool whether_need_next_partition(BlockRowPos found_partition_end);
 
@@ -98,6 +105,18 @@ private:
 
 private:
     enum AnalyticFnScope { PARTITION, RANGE, ROWS };
+    /// How a function computes a ROWS frame which is not [unbounded preceding, current row]
+    enum RowsFrameEvaluator {
+        RECOMPUTE,    // reset the state and add all the rows of the frame
+        INCREMENTAL,  // add the rows entering the frame and remove the rows leaving it
+        SEGMENT_TREE, // merge the states of a segment tree built over the partition
+    };
+    /// The payload columns of a buffered block which are kept in the spill file.
+    struct SpilledBlock {
+        int64_t offset = 0;
+        int64_t size = 0;
+        std::vector<size_t> column_idxs;
+    };
     std::vector<Block> _input_blocks;
     std::vector<int64_t> input_block_first_row_positions;
     std::vector<AggFnEvaluator*> _agg_functions;
@@ -134,6 +153,19 @@ private:
     Arena _agg_arena_pool;
     AggregateDataPtr _fn_place_ptr;
 
+    std::vector<RowsFrameEvaluator> _rows_frame_evaluators;
+    std::vector<std::unique_ptr<WindowSegmentTree>> _segment_trees;
+    /// The rows added to the states of the INCREMENTAL functions.
+    int64_t _incremental_frame_start = 0;
+    int64_t _incremental_frame_end = 0;
+
+    /// The memory of the input blocks held in memory.
+    int64_t _buffered_bytes = 0;
+    std::vector<SpilledBlock> _spilled_blocks;
+    std::string _spill_file_path;
+    std::unique_ptr<RandomRWFile> _spill_file;
+    int64_t _spill_file_size = 0;
+
     TTupleId _buffered_tuple_id = 0;
     TupleId _intermediate_tuple_id;
     TupleId _output_tuple_id;
@@ -144,5 +176,7 @@ private:
     std::vector<int64_t> _origin_cols;
 
     RuntimeProfile::Counter* _evaluation_timer;
+    RuntimeProfile::Counter* _spill_timer;
+    RuntimeProfile::Counter* _spilled_bytes_counter;
 };
 } // namespace doris::vectorized
@@ -17,13 +17,19 @@
 
 #include "vec/exec/vbroker_scan_node.h"
 
+#include "common/config.h"
+#include "common/consts.h"
 #include "gen_cpp/PlanNodes_types.h"
+#include "runtime/exec_env.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/runtime_state.h"
+#include "runtime/stream_load/load_stream_mgr.h"
+#include "runtime/stream_load/stream_load_pipe_splitter.h"
 #include "runtime/string_value.h"
 #include "runtime/tuple.h"
 #include "runtime/tuple_row.h"
 #include "util/runtime_profile.h"
+#include "util/string_util.h"
 #include "util/thread.h"
 #include "util/types.h"
 #include "vec/exprs/vexpr_context.h"
@@ -36,15 +42,130 @@ VBrokerScanNode::VBrokerScanNode(ObjectPool* pool, const TPlanNode& tnode,
     _vectorized = true;
 }
 
+VBrokerScanNode::~VBrokerScanNode() = default;
+
 Status VBrokerScanNode::start_scanners() {
+    RETURN_IF_ERROR(_split_stream_load());
+    if (_splitter == nullptr) {
+        {
+            std::unique_lock<std::mutex> l(_batch_queue_lock);
+            _num_running_scanners = 1;
+        }
+        _scanner_threads.emplace_back(&VBrokerScanNode::scanner_worker, this, 0,
+                                      _scan_ranges.size());
+        return Status::OK();
+    }
+
+    // one scanner for each split pipe
     {
         std::unique_lock<std::mutex> l(_batch_queue_lock);
-        _num_running_scanners = 1;
+        _num_running_scanners = _scan_ranges.size();
+    }
+    for (int i = 0; i < _scan_ranges.size(); ++i) {
+        _scanner_threads.emplace_back(&VBrokerScanNode::scanner_worker, this, i, 1);
     }
-    _scanner_threads.emplace_back(&VBrokerScanNode::scanner_worker, this, 0, _scan_ranges.size());
     return Status::OK();
 }
 
+Status VBrokerScanNode::_split_stream_load() {
+    int num_scanners = config::stream_load_parallel_scanner_num;
+    if (num_scanners <= 1 || _scan_ranges.size() != 1 ||
+        _scan_ranges[0].scan_range.broker_scan_range.ranges.size() != 1) {
+        return Status::OK();
+    }
+    const TBrokerScanRange& scan_range = _scan_ranges[0].scan_range.broker_scan_range;
+    const TBrokerRangeDesc& range = scan_range.ranges[0];
+    if (range.file_type != TFileType::FILE_STREAM) {
+        return Status::OK();
+    }
+
+    CompressType compress_type;
+    switch (range.format_type) {
+    case TFileFormatType::FORMAT_CSV_PLAIN:
+        compress_type = CompressType::UNCOMPRESSED;
+        break;
+    case TFileFormatType::FORMAT_CSV_GZ:
+        compress_type = CompressType::GZIP;
+        break;
+    case TFileFormatType::FORMAT_CSV_BZ2:
+        compress_type = CompressType::BZIP2;
+        break;
+    case TFileFormatType::FORMAT_CSV_LZ4FRAME:
+        compress_type = CompressType::LZ4FRAME;
+        break;
+    case TFileFormatType::FORMAT_CSV_LZOP:
+        compress_type = CompressType::LZOP;
+        break;
+    case TFileFormatType::FORMAT_CSV_DEFLATE:
+        compress_type = CompressType::DEFLATE;
+        break;
+    case TFileFormatType::FORMAT_JSON:
+        // a json document can only be split if there is one in each line
+        if (!range.__isset.read_json_by_line || !range.read_json_by_line) {
+            return Status::OK();
+        }
+        compress_type = CompressType::UNCOMPRESSED;
+        break;
+    default:
+        return Status::OK();
+    }
+
+    int skip_lines = 0;
+    if (range.__isset.header_type) {
+        std::string header_type = to_lower(range.header_type);
+        if (header_type == BeConsts::CSV_WITH_NAMES) {
+            skip_lines = 1;
+        } else if (header_type == BeConsts::CSV_WITH_NAMES_AND_TYPES) {
+            skip_lines = 2;
+        }
+    }
+    const TBrokerScanRangeParams& params = scan_range.params;
+    std::string line_delimiter;
+    if (params.__isset.line_delimiter_length && params.line_delimiter_length > 1) {
+        line_delimiter = params.line_delimiter_str;
+    } else {
+        line_delimiter.push_back(static_cast<char>(params.line_delimiter));
+    }
+
+    LoadStreamMgr* load_stream_mgr = _runtime_state->exec_env()->load_stream_mgr();
+    auto source = load_stream_mgr->get(range.load_id);
+    if (source == nullptr) {
+        // leave the error to the scanner
+        return Status::OK();
+    }
+    _splitter.reset(new StreamLoadPipeSplitter(runtime_profile(), source, compress_type,
+                                               line_delimiter, skip_lines, num_scanners,
+                                               _split_chunk_size));
+
+    // the split pipes are uncompressed and without header
+    std::vector<TScanRangeParams> split_ranges;
+    for (const auto& pipe : _splitter->pipes()) {
+        UniqueId pipe_id = UniqueId::gen_uid();
+        Status st = load_stream_mgr->put(pipe_id, pipe);
+        if (!st.ok()) {
+            _splitter->cancel(st.get_error_msg());
+            return st;
+        }
+        _split_pipe_ids.push_back(pipe_id);
+
+        TScanRangeParams split_range = _scan_ranges[0];
+        TBrokerRangeDesc& split_desc = split_range.scan_range.broker_scan_range.ranges[0];
+        split_desc.__set_load_id(pipe_id.to_thrift());
+        if (range.format_type != TFileFormatType::FORMAT_JSON) {
+            split_desc.__set_format_type(TFileFormatType::FORMAT_CSV_PLAIN);
+        }
+        // the scanners check header_type itself rather than its isset flag, and every
+        // split pipe starts at offset 0, so the string has to be cleared as well
+        split_desc.__set_header_type("");
+        split_desc.__isset.header_type = false;
+        split_ranges.push_back(std::move(split_range));
+    }
+    _scan_ranges.swap(split_ranges);
+    LOG(INFO) << "split stream load " << UniqueId(range.load_id) << " into " << num_scanners
+              << " pipes";
+    return _splitter->start();
+}
+
 Status VBrokerScanNode::get_next(RuntimeState* state, vectorized::Block* block, bool* eos) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
     // check if CANCELLED.
@@ -136,8 +257,16 @@ Status VBrokerScanNode::get_next(RuntimeState* state, vectorized::Block* block,
 }
 
 Status VBrokerScanNode::close(RuntimeState* state) {
+    // unblock the scanners waiting for data, before they are joined
+    if (_splitter != nullptr) {
+        _splitter->cancel("scan node closed");
+    }
     auto status = BrokerScanNode::close(state);
     _block_queue.clear();
+    for (const auto& pipe_id : _split_pipe_ids) {
+        _runtime_state->exec_env()->load_stream_mgr()->remove(pipe_id);
+    }
+    _splitter.reset();
     return status;
 }
 
@@ -227,6 +356,9 @@ void VBrokerScanNode::scanner_worker(int start_idx, int length) {
     // If one scanner failed, others don't need scan any more
     if (!status.ok()) {
         _queue_writer_cond.notify_all();
+        if (_splitter != nullptr) {
+            _splitter->cancel(status.get_error_msg());
+        }
     }
 }
 
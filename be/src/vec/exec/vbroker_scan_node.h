@@ -22,8 +22,12 @@
 #include "exec/broker_scan_node.h"
 #include "exec/scan_node.h"
 #include "runtime/descriptors.h"
+#include "util/uid_util.h"
+
 namespace doris {
 
+class StreamLoadPipeSplitter;
+
 class RuntimeState;
 class Status;
 
@@ -31,7 +35,7 @@ namespace vectorized {
 class VBrokerScanNode final : public BrokerScanNode {
 public:
     VBrokerScanNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
-    ~VBrokerScanNode() override = default;
+    ~VBrokerScanNode() override;
 
     // Fill the next row batch by calling next() on the scanner,
     virtual Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override {
@@ -46,12 +50,22 @@ public:
 private:
     Status start_scanners() override;
 
+    // Split the body of a single stream load into several pipes, and replace the scan range
+    // with one range per pipe, each of them is scanned by a scanner of its own.
+    Status _split_stream_load();
+
     void scanner_worker(int start_idx, int length);
     // Scan one range
     Status scanner_scan(const TBrokerScanRange& scan_range, ScannerCounter* counter);
 
     std::deque<std::shared_ptr<vectorized::Block>> _block_queue;
     std::unique_ptr<MutableBlock> _mutable_block;
+
+    // size of the chunks the body of a stream load is split into
+    size_t _split_chunk_size = 1024 * 1024;
+    std::unique_ptr<StreamLoadPipeSplitter> _splitter;
+    // ids of the split pipes in LoadStreamMgr, removed on close in case a scanner never opens
+    std::vector<UniqueId> _split_pipe_ids;
 };
 } // namespace vectorized
 } // namespace doris
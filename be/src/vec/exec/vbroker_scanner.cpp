@@ -20,12 +20,14 @@
 #include <fmt/format.h>
 
 #include <iostream>
+#include <map>
 
 #include "exec/exec_node.h"
 #include "exec/plain_text_line_reader.h"
 #include "exec/text_converter.h"
 #include "exec/text_converter.hpp"
 #include "exprs/expr_context.h"
+#include "runtime/mem_pool.h"
 #include "util/utf8_check.h"
 
 namespace doris::vectorized {
@@ -46,14 +48,86 @@ VBrokerScanner::VBrokerScanner(RuntimeState* state, RuntimeProfile* profile,
 
 VBrokerScanner::~VBrokerScanner() = default;
 
+Status VBrokerScanner::open() {
+    RETURN_IF_ERROR(BrokerScanner::open());
+    _init_text_dest_columns();
+    return Status::OK();
+}
+
+void VBrokerScanner::_init_text_dest_columns() {
+    // the pre filter is evaluated on the text of the src slots
+    if (_vpre_filter_ctx_ptr) {
+        return;
+    }
+    // a src slot referenced by another expr keeps its text in the src block
+    std::map<SlotId, int> slot_refs;
+    for (const auto& [dest_slot_id, texpr] : _params.expr_of_dest_slot) {
+        for (const auto& node : texpr.nodes) {
+            if (node.node_type == TExprNodeType::SLOT_REF) {
+                slot_refs[node.slot_ref.slot_id]++;
+            }
+        }
+    }
+    std::map<SlotId, int> src_indexes;
+    for (int i = 0; i < _num_of_columns_from_file; ++i) {
+        src_indexes.emplace(_src_slot_descs[i]->id(), i);
+    }
+
+    int dest_index = 0;
+    for (auto slot_desc : _dest_tuple_desc->slots()) {
+        if (!slot_desc->is_materialized()) {
+            continue;
+        }
+        int index = dest_index++;
+        const TExpr& texpr = _params.expr_of_dest_slot.at(slot_desc->id());
+        if (texpr.nodes.size() != 2 || texpr.nodes[0].node_type != TExprNodeType::CAST_EXPR ||
+            texpr.nodes[1].node_type != TExprNodeType::SLOT_REF) {
+            continue;
+        }
+        SlotId src_slot_id = texpr.nodes[1].slot_ref.slot_id;
+        auto it = src_indexes.find(src_slot_id);
+        if (it == src_indexes.end() || slot_refs[src_slot_id] != 1) {
+            continue;
+        }
+        auto src_slot_desc = _src_slot_descs[it->second];
+        if (!src_slot_desc->is_materialized() || !src_slot_desc->type().is_string_type() ||
+            TypeDescriptor::from_thrift(texpr.nodes[0].type).type != slot_desc->type().type) {
+            continue;
+        }
+        auto deserializer = TextColumnDeserializer::create(slot_desc->type());
+        if (deserializer == nullptr) {
+            continue;
+        }
+
+        if (_line_pool == nullptr) {
+            _line_pool.reset(new MemPool(_mem_tracker.get()));
+            _src_text_dest_index.resize(_src_slot_descs.size(), -1);
+            _src_deserializers.resize(_src_slot_descs.size());
+            _src_text_values.resize(_src_slot_descs.size());
+            _text_dest_columns.resize(_dest_vexpr_ctx.size());
+        }
+        _src_text_dest_index[it->second] = index;
+        _src_deserializers[it->second] = std::move(deserializer);
+        _text_dest_columns[index].src_index = it->second;
+        _text_dest_columns[index].values = &_src_text_values[it->second];
+    }
+}
+
 Status VBrokerScanner::get_next(Block* output_block, bool* eof) {
     SCOPED_TIMER(_read_timer);
     RETURN_IF_ERROR(_init_src_block());
 
     const int batch_size = _state->batch_size();
     auto columns = _src_block.mutate_columns();
+    if (_line_pool != nullptr) {
+        _line_pool->clear();
+        for (auto& values : _src_text_values) {
+            values.clear();
+        }
+    }
 
-    while (columns[0]->size() < batch_size && !_scanner_eof) {
+    int rows = 0;
+    while (rows < batch_size && !_scanner_eof) {
         if (_cur_line_reader == nullptr || _cur_line_reader_eof) {
             RETURN_IF_ERROR(open_next_reader());
             // If there isn't any more reader, break this
@@ -75,10 +149,33 @@ Status VBrokerScanner::get_next(Block* output_block, bool* eof) {
         {
             COUNTER_UPDATE(_rows_read_counter, 1);
             SCOPED_TIMER(_materialize_timer);
-            RETURN_IF_ERROR(_fill_dest_columns(Slice(ptr, size), columns));
+            Slice line(ptr, size);
+            if (_line_pool != nullptr) {
+                // the text values of the line are parsed at the end of the batch
+                uint8_t* line_copy = _line_pool->allocate(size);
+                memcpy(line_copy, ptr, size);
+                line = Slice(line_copy, size);
+            }
+            RETURN_IF_ERROR(_fill_dest_columns(line, columns));
             if (_success) {
                 free_expr_local_allocations();
+                rows++;
+            }
+        }
+    }
+
+    if (_line_pool != nullptr && rows > 0) {
+        SCOPED_TIMER(_materialize_timer);
+        for (int i = 0; i < _src_text_dest_index.size(); ++i) {
+            int dest_index = _src_text_dest_index[i];
+            if (dest_index < 0) {
+                continue;
             }
+            columns[i]->insert_many_defaults(rows);
+            auto& text_column = _text_dest_columns[dest_index];
+            text_column.column = _src_deserializers[i]->deserialize(
+                    _src_text_values[i].data(), _src_text_values[i].size(),
+                    &text_column.src_null_map);
         }
     }
 
@@ -103,6 +200,10 @@ Status VBrokerScanner::_fill_dest_columns(const Slice& line,
         }
 
         const Slice& value = _split_values[i];
+        if (!_src_text_dest_index.empty() && _src_text_dest_index[i] >= 0) {
+            _src_text_values[i].push_back(value);
+            continue;
+        }
         if (is_null(value)) {
             // nullable
             auto* nullable_column =
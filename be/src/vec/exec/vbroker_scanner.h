@@ -19,6 +19,8 @@
 
 #include <exec/broker_scanner.h>
 
+#include "vec/exec/text_column_deserializer.h"
+
 namespace doris::vectorized {
 class VBrokerScanner final : public BrokerScanner {
 public:
@@ -29,6 +31,8 @@ public:
                    const std::vector<TExpr>& pre_filter_texprs, ScannerCounter* counter);
     ~VBrokerScanner();
 
+    Status open() override;
+
     virtual Status get_next(doris::Tuple* tuple, MemPool* tuple_pool, bool* eof,
                             bool* fill_tuple) override {
         return Status::NotSupported("Not Implemented get next");
@@ -39,6 +43,18 @@ public:
 private:
     std::unique_ptr<TextConverter> _text_converter;
 
+    // Find the dest columns that only cast a src slot read from the file, they are parsed
+    // straight from the text of the slot by a TextColumnDeserializer.
+    void _init_text_dest_columns();
+
     Status _fill_dest_columns(const Slice& line, std::vector<MutableColumnPtr>& columns);
+
+    // indexed like _src_slot_descs, the dest column of a src slot parsed from text or -1
+    std::vector<int> _src_text_dest_index;
+    std::vector<std::unique_ptr<TextColumnDeserializer>> _src_deserializers;
+    // the text of these src slots in the rows of the current batch
+    std::vector<std::vector<Slice>> _src_text_values;
+    // holds the lines of the current batch, which the text values point into
+    std::unique_ptr<MemPool> _line_pool;
 };
 } // namespace doris::vectorized
@@ -21,6 +21,7 @@
 
 #include <algorithm>
 
+#include "common/config.h"
 #include "exec/line_reader.h"
 #include "exprs/json_functions.h"
 #include "runtime/runtime_state.h"
@@ -127,7 +128,12 @@ Status VJsonReader::init(const std::string& jsonpath, const std::string& json_ro
 
     //improve performance
     if (_parsed_jsonpaths.empty()) { // input is a simple json-string
-        _vhandle_json_callback = &VJsonReader::_vhandle_simple_json;
+        if (config::enable_simdjson_reader && _parsed_json_root.empty()) {
+            _simdjson_reader.reset(new SimdJsonReader());
+            _vhandle_json_callback = &VJsonReader::_simdjson_handle_simple_json;
+        } else {
+            _vhandle_json_callback = &VJsonReader::_vhandle_simple_json;
+        }
     } else { // input is a complex json-string and a json-path
         if (_strip_outer_array) {
             _vhandle_json_callback = &VJsonReader::_vhandle_flat_array_complex_json;
@@ -480,6 +486,314 @@ Status VJsonReader::_parse_json(bool* is_empty_row, bool* eof) {
     return Status::OK();
 }
 
+Status VJsonReader::_simdjson_handle_simple_json(std::vector<MutableColumnPtr>& columns,
+                                                 const std::vector<SlotDescriptor*>& slot_descs,
+                                                 bool* is_empty_row, bool* eof) {
+    do {
+        bool valid = false;
+        if (!_simdjson_has_row) { // parse json and generic document
+            Status st = _simdjson_parse_json(is_empty_row, eof);
+            if (st.is_data_quality_error()) {
+                continue; // continue to read next
+            }
+            RETURN_IF_ERROR(st);
+            if (*is_empty_row == true) {
+                return Status::OK();
+            }
+        }
+
+        simdjson::ondemand::object object;
+        simdjson::error_code error;
+        if (_simdjson_is_array) { // handle case 1
+            simdjson::ondemand::value value;
+            error = (*_simdjson_array_iter).get(value);
+            if (!error) {
+                error = value.get_object().get(object);
+            }
+        } else { // handle case 2
+            error = _simdjson_reader->document().get_object().get(object);
+            _simdjson_has_row = false;
+        }
+
+        if (error == simdjson::INCORRECT_TYPE) {
+            // Here we expect the incoming value to be a Json Object, such as {"key" : "value"},
+            // not other type of Json format.
+            RETURN_IF_ERROR(_append_simdjson_error_msg("Expect json object value", &valid));
+        } else if (error) {
+            RETURN_IF_ERROR(_append_simdjson_error_msg(
+                    fmt::format("Parse json data failed: {}", simdjson::error_message(error)),
+                    &valid));
+            _simdjson_has_row = false;
+        } else {
+            RETURN_IF_ERROR(_simdjson_set_column_value(object, columns, slot_descs, &valid));
+        }
+
+        // the iterator must be moved after the object is consumed, otherwise the object is
+        // skipped
+        if (_simdjson_is_array && _simdjson_has_row) {
+            ++_simdjson_array_iter;
+            _simdjson_has_row = _simdjson_array_iter != _simdjson_array_end;
+        }
+
+        if (!valid) {
+            if (*_scanner_eof) {
+                // When _scanner_eof is true and valid is false, it means that we have encountered
+                // unqualified data and decided to stop the scan.
+                *is_empty_row = true;
+                return Status::OK();
+            }
+            continue;
+        }
+        *is_empty_row = false;
+        break; // get a valid row, then break
+    } while (true);
+    return Status::OK();
+}
+
+Status VJsonReader::_simdjson_parse_json(bool* is_empty_row, bool* eof) {
+    const uint8_t* json_str = nullptr;
+    ByteBufferPtr json_str_ptr;
+    size_t size = 0;
+    RETURN_IF_ERROR(JsonReader::_read_one_message(&json_str_ptr, &json_str, &size, eof));
+    // read all data, then return
+    if (size == 0 || *eof) {
+        *is_empty_row = true;
+        return Status::OK();
+    }
+
+    std::string error_msg;
+    simdjson::ondemand::json_type type;
+    auto error = _simdjson_reader->iterate(
+            std::string_view(reinterpret_cast<const char*>(json_str), size));
+    if (!error) {
+        // reject the whole document if any part of it is malformed, like rapidjson does,
+        // rather than loading the rows before the broken one
+        error = _simdjson_reader->validate();
+    }
+    if (!error) {
+        error = _simdjson_reader->document().type().get(type);
+    }
+    if (error) {
+        error_msg = fmt::format("Parse json data for JsonDoc failed. code: {}, error info: {}",
+                                static_cast<int>(error), simdjson::error_message(error));
+    } else {
+        _simdjson_is_array = type == simdjson::ondemand::json_type::array;
+        if (_simdjson_is_array && !_strip_outer_array) {
+            error_msg = "JSON data is array-object, `strip_outer_array` must be TRUE.";
+        } else if (!_simdjson_is_array && _strip_outer_array) {
+            error_msg = "JSON data is not an array-object, `strip_outer_array` must be FALSE.";
+        }
+    }
+
+    if (error_msg.empty() && _simdjson_is_array) {
+        simdjson::ondemand::array array;
+        error = _simdjson_reader->document().get_array().get(array);
+        if (!error) {
+            error = array.begin().get(_simdjson_array_iter);
+        }
+        if (!error) {
+            error = array.end().get(_simdjson_array_end);
+        }
+        if (error) {
+            error_msg = fmt::format("Parse json data for JsonDoc failed. code: {}, error info: {}",
+                                    static_cast<int>(error), simdjson::error_message(error));
+        } else if (!(_simdjson_array_iter != _simdjson_array_end)) {
+            // may be passing an empty json, such as "[]"
+            RETURN_IF_ERROR(_append_simdjson_error_msg("Empty json line", nullptr));
+            *is_empty_row = true;
+            return Status::OK();
+        }
+    }
+
+    if (!error_msg.empty()) {
+        RETURN_IF_ERROR(_append_simdjson_error_msg(error_msg, nullptr));
+        if (*_scanner_eof) {
+            // we meet enough invalid rows and the scanner should be stopped
+            *eof = true;
+            *is_empty_row = true;
+            return Status::OK();
+        }
+        return Status::DataQualityError(error_msg);
+    }
+
+    _simdjson_has_row = true;
+    return Status::OK();
+}
+
+// Same as _set_column_value(), but the fields are visited in one pass in the order of json
+// object, then the columns are written together after the row is known to be valid.
+Status VJsonReader::_simdjson_set_column_value(simdjson::ondemand::object& object,
+                                               std::vector<MutableColumnPtr>& columns,
+                                               const std::vector<SlotDescriptor*>& slot_descs,
+                                               bool* valid) {
+    if (_slot_values.empty()) {
+        int ctx_idx = 0;
+        for (auto slot_desc : slot_descs) {
+            if (slot_desc->is_materialized()) {
+                _slot_index.emplace(slot_desc->col_name(), ctx_idx++);
+            }
+        }
+        _slot_values.resize(ctx_idx);
+    }
+    for (auto& slot_value : _slot_values) {
+        slot_value.found = false;
+    }
+
+    for (auto field_result : object) {
+        simdjson::ondemand::field field;
+        std::string_view key;
+        auto error = field_result.get(field);
+        if (!error) {
+            error = field.unescaped_key().get(key);
+        }
+        if (!error) {
+            auto it = _slot_index.find(key);
+            // the first one is used for duplicated keys, like rapidjson FindMember()
+            if (it == _slot_index.end() || _slot_values[it->second].found) {
+                continue;
+            }
+            error = _simdjson_read_value(field.value(), &_slot_values[it->second]);
+        }
+        if (error) {
+            // the rest of the document can't be read either
+            _simdjson_has_row = false;
+            RETURN_IF_ERROR(_append_simdjson_error_msg(
+                    fmt::format("Parse json data failed: {}", simdjson::error_message(error)),
+                    valid));
+            return Status::OK();
+        }
+    }
+
+    int nullcount = 0;
+    int ctx_idx = 0;
+    for (auto slot_desc : slot_descs) {
+        if (!slot_desc->is_materialized()) {
+            continue;
+        }
+        const auto& slot_value = _slot_values[ctx_idx++];
+        if (!slot_value.found) {
+            nullcount++;
+        }
+        if ((!slot_value.found || slot_value.is_null) && !slot_desc->is_nullable()) {
+            std::string error_msg =
+                    slot_value.found
+                            ? "Json value is null, but the column `{}` is not nullable."
+                            : "The column `{}` is not nullable, but it's not found in jsondata.";
+            RETURN_IF_ERROR(_append_simdjson_error_msg(
+                    fmt::format(error_msg, slot_desc->col_name()), valid));
+            return Status::OK();
+        }
+    }
+
+    if (nullcount == slot_descs.size()) {
+        RETURN_IF_ERROR(
+                _append_simdjson_error_msg("All fields is null, this is a invalid row.", valid));
+        return Status::OK();
+    }
+
+    ctx_idx = 0;
+    for (auto slot_desc : slot_descs) {
+        if (!slot_desc->is_materialized()) {
+            continue;
+        }
+        const auto& slot_value = _slot_values[ctx_idx];
+        auto* column_ptr = columns[ctx_idx++].get();
+        if (slot_desc->is_nullable()) {
+            auto* nullable_column = reinterpret_cast<vectorized::ColumnNullable*>(column_ptr);
+            if (!slot_value.found || slot_value.is_null) {
+                nullable_column->insert_default();
+                continue;
+            }
+            nullable_column->get_null_map_data().push_back(0);
+            column_ptr = &nullable_column->get_nested_column();
+        }
+        DCHECK(slot_desc->type().type == TYPE_VARCHAR);
+        assert_cast<ColumnString*>(column_ptr)
+                ->insert_data(slot_value.value.data(), slot_value.value.size());
+    }
+    *valid = true;
+    return Status::OK();
+}
+
+// Read value as the string to be inserted into column, see _write_data_to_column().
+simdjson::error_code VJsonReader::_simdjson_read_value(simdjson::ondemand::value value,
+                                                       SimdJsonSlotValue* slot_value) {
+    simdjson::ondemand::json_type type;
+    auto error = value.type().get(type);
+    if (error) {
+        return error;
+    }
+
+    slot_value->found = true;
+    slot_value->is_null = false;
+    switch (type) {
+    case simdjson::ondemand::json_type::string: {
+        std::string_view str;
+        if ((error = value.get_string().get(str))) {
+            return error;
+        }
+        slot_value->value = str.substr(0, str.find('\0'));
+        break;
+    }
+    case simdjson::ondemand::json_type::number: {
+        std::string_view token = value.raw_json_token();
+        SimdJsonNumber number;
+        if (!SimdJsonReader::parse_number(token, &number)) {
+            return simdjson::NUMBER_ERROR;
+        }
+        if (_num_as_string) {
+            slot_value->value = token.substr(0, token.find_last_not_of(" \t\n\r") + 1);
+            break;
+        }
+        if (number.type == SimdJsonNumber::INT64) {
+            slot_value->buffer = std::to_string(number.int64_value);
+        } else if (number.type == SimdJsonNumber::UINT64) {
+            slot_value->buffer = std::to_string(number.uint64_value);
+        } else {
+            slot_value->buffer = fmt::format("{:f}", number.double_value);
+        }
+        slot_value->value = slot_value->buffer;
+        break;
+    }
+    case simdjson::ondemand::json_type::boolean: {
+        bool b = false;
+        if ((error = value.get_bool().get(b))) {
+            return error;
+        }
+        slot_value->value = b ? "1" : "0";
+        break;
+    }
+    case simdjson::ondemand::json_type::null:
+        slot_value->is_null = true;
+        break;
+    default: {
+        // for other type like array or object. we convert it to string to save
+        rapidjson::StringBuffer buf;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+        if ((error = SimdJsonReader::write_value(value, &writer, _num_as_string))) {
+            return error;
+        }
+        slot_value->buffer.assign(buf.GetString(), buf.GetSize());
+        slot_value->value = slot_value->buffer;
+        break;
+    }
+    }
+    return simdjson::SUCCESS;
+}
+
+Status VJsonReader::_append_simdjson_error_msg(const std::string& error_msg, bool* valid) {
+    RETURN_IF_ERROR(_state->append_error_msg_to_file(
+            [&]() -> std::string { return std::string(_simdjson_reader->json()); },
+            [&]() -> std::string { return error_msg; }, _scanner_eof));
+
+    _counter->num_rows_filtered++;
+    if (valid != nullptr) {
+        // current row is invalid
+        *valid = false;
+    }
+    return Status::OK();
+}
+
 Status VJsonReader::_append_error_msg(const rapidjson::Value& objectValue, std::string error_msg,
                                       std::string col_name, bool* valid) {
     std::string err_msg;
@@ -26,12 +26,14 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 #include "common/status.h"
 #include "exec/base_scanner.h"
 #include "exec/json_scanner.h"
+#include "exprs/simd_json_reader.h"
 #include "runtime/descriptors.h"
 #include "util/runtime_profile.h"
 
@@ -108,6 +110,42 @@ private:
 
     Status _append_error_msg(const rapidjson::Value& objectValue, std::string error_msg,
                              std::string col_name, bool* valid);
+
+    // The simdjson version of _vhandle_simple_json(), which only visits the fields of slots
+    // instead of building a whole rapidjson document.
+    Status _simdjson_handle_simple_json(std::vector<MutableColumnPtr>& columns,
+                                        const std::vector<SlotDescriptor*>& slot_descs,
+                                        bool* is_empty_row, bool* eof);
+
+    Status _simdjson_parse_json(bool* is_empty_row, bool* eof);
+
+    Status _simdjson_set_column_value(simdjson::ondemand::object& object,
+                                      std::vector<MutableColumnPtr>& columns,
+                                      const std::vector<SlotDescriptor*>& slot_descs, bool* valid);
+
+    Status _append_simdjson_error_msg(const std::string& error_msg, bool* valid);
+
+private:
+    // value of a slot read from the current json object
+    struct SimdJsonSlotValue {
+        bool found = false;
+        bool is_null = false;
+        std::string_view value;
+        std::string buffer;
+    };
+
+    simdjson::error_code _simdjson_read_value(simdjson::ondemand::value value,
+                                              SimdJsonSlotValue* slot_value);
+
+    std::unique_ptr<SimdJsonReader> _simdjson_reader;
+    // whether there are rows left in the current json document
+    bool _simdjson_has_row = false;
+    bool _simdjson_is_array = false;
+    simdjson::ondemand::array_iterator _simdjson_array_iter;
+    simdjson::ondemand::array_iterator _simdjson_array_end;
+    // column name of materialized slot -> index of it in columns
+    std::unordered_map<std::string_view, int> _slot_index;
+    std::vector<SimdJsonSlotValue> _slot_values;
 };
 
 } // namespace vectorized
@@ -58,7 +58,7 @@ protected:
     void create_mutable_cols(Block* output_block);
 
 protected:
-    HashTableVariants _hash_table_variants;
+    SetHashTableVariants _hash_table_variants;
 
     std::vector<size_t> _probe_key_sz;
     std::vector<size_t> _build_key_sz;
@@ -23,6 +23,7 @@
 #include <fmt/format.h>
 
 #include "common/logging.h"
+#include "util/jsonb.h"
 #include "vec/columns/column_const.h"
 #include "vec/columns/column_nullable.h"
 #include "vec/columns/column_string.h"
@@ -32,6 +33,7 @@
 #include "vec/common/string_buffer.hpp"
 #include "vec/data_types/data_type_decimal.h"
 #include "vec/data_types/data_type_factory.hpp"
+#include "vec/data_types/data_type_jsonb.h"
 #include "vec/data_types/data_type_nothing.h"
 #include "vec/data_types/data_type_nullable.h"
 #include "vec/data_types/data_type_number.h"
@@ -245,6 +247,49 @@ struct ConvertImplGenericToString {
     }
 };
 
+// Convert json text to binary jsonb. Invalid json is converted to NULL if the result is
+// nullable, which is the case of loading, otherwise it's an error.
+struct ConvertImplStringToJsonb {
+    static Status execute(Block& block, const ColumnNumbers& arguments, size_t result,
+                          bool result_is_nullable) {
+        const auto col_from =
+                block.get_by_position(arguments[0]).column->convert_to_full_column_if_const();
+        const auto* col_from_string = check_and_get_column<ColumnString>(col_from.get());
+        if (!col_from_string) {
+            return Status::RuntimeError(
+                    fmt::format("Illegal column {} of first argument of cast to jsonb",
+                                col_from->get_name()));
+        }
+
+        size_t size = col_from_string->size();
+        auto col_to = ColumnString::create();
+        auto col_null_map_to = ColumnUInt8::create(size, 0);
+        auto& null_map = col_null_map_to->get_data();
+        std::string jsonb;
+        for (size_t i = 0; i < size; ++i) {
+            const auto json = col_from_string->get_data_at(i);
+            Status st = JsonbDocument::from_json(json.data, json.size, &jsonb);
+            if (!st.ok()) {
+                if (!result_is_nullable) {
+                    return st;
+                }
+                null_map[i] = 1;
+                col_to->insert_default();
+                continue;
+            }
+            col_to->insert_data(jsonb.data(), jsonb.size());
+        }
+
+        if (result_is_nullable) {
+            block.get_by_position(result).column =
+                    ColumnNullable::create(std::move(col_to), std::move(col_null_map_to));
+        } else {
+            block.get_by_position(result).column = std::move(col_to);
+        }
+        return Status::OK();
+    }
+};
+
 template <typename ToDataType, typename Name>
 struct ConvertImpl<DataTypeString, ToDataType, Name> {
     template <typename Additions = void*>
@@ -964,6 +1009,20 @@ private:
         };
     }
 
+    WrapperType create_jsonb_wrapper(const DataTypePtr& from_type,
+                                     bool requested_result_is_nullable) const {
+        if (!WhichDataType(from_type).is_string()) {
+            LOG(FATAL) << fmt::format("Conversion from {} to JSONB is not supported",
+                                      from_type->get_name());
+        }
+        return [requested_result_is_nullable](FunctionContext* context, Block& block,
+                                              const ColumnNumbers& arguments, const size_t result,
+                                              size_t input_rows_count) {
+            return ConvertImplStringToJsonb::execute(block, arguments, result,
+                                                     requested_result_is_nullable);
+        };
+    }
+
     template <typename FieldType>
     WrapperType create_decimal_wrapper(const DataTypePtr& from_type,
                                        const DataTypeDecimal<FieldType>* to_type) const {
@@ -1193,6 +1252,8 @@ private:
         switch (to_type->get_type_id()) {
         case TypeIndex::String:
             return create_string_wrapper(from_type);
+        case TypeIndex::JSONB:
+            return create_jsonb_wrapper(from_type, requested_result_is_nullable);
 
         default:
             break;
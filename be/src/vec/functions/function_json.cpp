@@ -20,9 +20,11 @@
 #include <rapidjson/writer.h>
 
 #include <boost/token_functions.hpp>
+#include <limits>
 #include <vector>
 
 #include "exprs/json_functions.h"
+#include "exprs/simd_json_reader.h"
 #include "util/string_parser.hpp"
 #include "util/string_util.h"
 #include "vec/columns/column.h"
@@ -189,14 +191,19 @@ rapidjson::Value* match_value(const std::vector<JsonPath>& parsed_paths, rapidjs
 template <JsonFunctionType fntype>
 rapidjson::Value* get_json_object(const std::string_view& json_string,
                                   const std::string_view& path_string,
-                                  rapidjson::Document* document) {
-    std::vector<JsonPath>* parsed_paths;
+                                  rapidjson::Document* document,
+                                  const std::vector<JsonPath>* compiled_paths = nullptr) {
+    const std::vector<JsonPath>* parsed_paths;
     std::vector<JsonPath> tmp_parsed_paths;
 
-    auto tok = get_json_token(path_string);
-    std::vector<std::string> paths(tok.begin(), tok.end());
-    get_parsed_paths(paths, &tmp_parsed_paths);
-    parsed_paths = &tmp_parsed_paths;
+    if (compiled_paths != nullptr) {
+        parsed_paths = compiled_paths;
+    } else {
+        auto tok = get_json_token(path_string);
+        std::vector<std::string> paths(tok.begin(), tok.end());
+        get_parsed_paths(paths, &tmp_parsed_paths);
+        parsed_paths = &tmp_parsed_paths;
+    }
 
     if (!(*parsed_paths)[0].is_valid) {
         return document;
@@ -221,6 +228,50 @@ rapidjson::Value* get_json_object(const std::string_view& json_string,
     return match_value(*parsed_paths, document, document->GetAllocator());
 }
 
+// The json path of get_json_xxx() compiled in prepare() when it is a constant, so it is not
+// tokenized again for every row. If the path can be expressed by a JSON pointer, the value is
+// looked up by simdjson without building a rapidjson::Document.
+struct JsonPathState {
+    std::vector<JsonPath> parsed_paths;
+    bool use_simdjson = false;
+    std::string json_pointer;
+    SimdJsonReader reader;
+
+    void init(const std::string_view& path_string) {
+        auto tok = get_json_token(path_string);
+        std::vector<std::string> paths(tok.begin(), tok.end());
+        get_parsed_paths(paths, &parsed_paths);
+        use_simdjson = SimdJsonReader::to_json_pointer(parsed_paths, &json_pointer);
+    }
+};
+
+JsonPathState* get_json_path_state(FunctionContext* context) {
+    auto* state = reinterpret_cast<JsonPathState*>(
+            context->get_function_state(FunctionContext::THREAD_LOCAL));
+    return state != nullptr && !state->parsed_paths.empty() ? state : nullptr;
+}
+
+// Find the value of json by simdjson. Return true if the result is known, and found is false
+// if the value is absent or null. Return false to fall back to rapidjson, for the cases that
+// match_value() handles differently from JSON pointer, such as a key applied to an array.
+bool find_json_value_by_simdjson(JsonPathState* state, const std::string_view& json_string,
+                                 simdjson::ondemand::value* value, bool* found) {
+    auto error = state->reader.find(json_string, state->json_pointer, value);
+    if (error == simdjson::SUCCESS) {
+        simdjson::ondemand::json_type type;
+        if (value->type().get(type) != simdjson::SUCCESS) {
+            return false;
+        }
+        *found = type != simdjson::ondemand::json_type::null;
+        return true;
+    }
+    if (error == simdjson::NO_SUCH_FIELD || error == simdjson::INDEX_OUT_OF_BOUNDS) {
+        *found = false;
+        return true;
+    }
+    return false;
+}
+
 template <typename NumberType>
 struct GetJsonNumberType {
     using ReturnType = typename NumberType::ReturnType;
@@ -233,6 +284,7 @@ struct GetJsonNumberType {
                               NullMap& null_map) {
         size_t size = loffsets.size();
         res.resize(size);
+        JsonPathState* state = get_json_path_state(context);
         for (size_t i = 0; i < size; ++i) {
             const char* l_raw_str = reinterpret_cast<const char*>(&ldata[loffsets[i - 1]]);
             int l_str_size = loffsets[i] - loffsets[i - 1] - 1;
@@ -248,19 +300,66 @@ struct GetJsonNumberType {
             std::string_view json_string(l_raw_str, l_str_size);
             std::string_view path_string(r_raw_str, r_str_size);
 
+            if (state != nullptr && state->use_simdjson) {
+                simdjson::ondemand::value value;
+                bool found = false;
+                if (find_json_value_by_simdjson(state, json_string, &value, &found)) {
+                    if (found) {
+                        handle_simdjson_result(value, res[i], null_map[i]);
+                    } else {
+                        res[i] = 0;
+                        null_map[i] = 1;
+                    }
+                    continue;
+                }
+            }
+
             rapidjson::Document document;
             rapidjson::Value* root = nullptr;
+            const std::vector<JsonPath>* parsed_paths =
+                    state != nullptr ? &state->parsed_paths : nullptr;
 
             if constexpr (std::is_same_v<double, typename NumberType::T>) {
-                root = get_json_object<JSON_FUN_DOUBLE>(json_string, path_string, &document);
+                root = get_json_object<JSON_FUN_DOUBLE>(json_string, path_string, &document,
+                                                        parsed_paths);
                 handle_result<double>(root, res[i], null_map[i]);
             } else if constexpr (std::is_same_v<int32_t, typename NumberType::T>) {
-                root = get_json_object<JSON_FUN_DOUBLE>(json_string, path_string, &document);
+                root = get_json_object<JSON_FUN_DOUBLE>(json_string, path_string, &document,
+                                                        parsed_paths);
                 handle_result<int32_t>(root, res[i], null_map[i]);
             }
         }
     }
 
+    // Same as handle_result(): rapidjson only treats the integers in int32 range as Int,
+    // other integers are neither Int nor Double.
+    static void handle_simdjson_result(simdjson::ondemand::value& value,
+                                       typename NumberType::T& res, uint8_t& res_null) {
+        simdjson::ondemand::json_type type;
+        SimdJsonNumber number;
+        if (value.type().get(type) != simdjson::SUCCESS ||
+            type != simdjson::ondemand::json_type::number ||
+            !SimdJsonReader::parse_number(value.raw_json_token(), &number)) {
+            res = 0;
+            res_null = 1;
+            return;
+        }
+
+        if (number.type == SimdJsonNumber::INT64 &&
+            number.int64_value >= std::numeric_limits<int32_t>::min()) {
+            res = number.int64_value;
+        } else if (number.type == SimdJsonNumber::UINT64 &&
+                   number.uint64_value <= std::numeric_limits<int32_t>::max()) {
+            res = number.uint64_value;
+        } else if (number.type == SimdJsonNumber::DOUBLE &&
+                   std::is_same_v<double, typename NumberType::T>) {
+            res = number.double_value;
+        } else {
+            res = 0;
+            res_null = 1;
+        }
+    }
+
     template <typename T, std::enable_if_t<std::is_same_v<double, T>, T>* = nullptr>
     static void handle_result(rapidjson::Value* root, T& res, uint8_t& res_null) {
         if (root == nullptr || root->IsNull()) {
@@ -316,11 +415,14 @@ struct GetJsonString {
     using ColumnType = ColumnString;
     using Chars = ColumnString::Chars;
     using Offsets = ColumnString::Offsets;
+    static constexpr int max_string_len = 65535;
+
     static void vector_vector(FunctionContext* context, const Chars& ldata, const Offsets& loffsets,
                               const Chars& rdata, const Offsets& roffsets, Chars& res_data,
                               Offsets& res_offsets, NullMap& null_map) {
         size_t input_rows_count = loffsets.size();
         res_offsets.resize(input_rows_count);
+        JsonPathState* state = get_json_path_state(context);
 
         for (size_t i = 0; i < input_rows_count; ++i) {
             int l_size = loffsets[i] - loffsets[i - 1] - 1;
@@ -337,11 +439,23 @@ struct GetJsonString {
             std::string_view json_string(l_raw, l_size);
             std::string_view path_string(r_raw, r_size);
 
+            if (state != nullptr && state->use_simdjson) {
+                simdjson::ondemand::value value;
+                bool found = false;
+                if (find_json_value_by_simdjson(state, json_string, &value, &found)) {
+                    if (!found || !handle_simdjson_result(value, i, res_data, res_offsets)) {
+                        StringOP::push_null_string(i, res_data, res_offsets, null_map);
+                    }
+                    continue;
+                }
+            }
+
             rapidjson::Document document;
             rapidjson::Value* root = nullptr;
 
-            root = get_json_object<JSON_FUN_STRING>(json_string, path_string, &document);
-            const int max_string_len = 65535;
+            root = get_json_object<JSON_FUN_STRING>(
+                    json_string, path_string, &document,
+                    state != nullptr ? &state->parsed_paths : nullptr);
 
             if (root == nullptr || root->IsNull()) {
                 StringOP::push_null_string(i, res_data, res_offsets, null_map);
@@ -360,6 +474,35 @@ struct GetJsonString {
             }
         }
     }
+
+    // Return false if the value turns out to be invalid json.
+    static bool handle_simdjson_result(simdjson::ondemand::value& value, size_t i,
+                                       Chars& res_data, Offsets& res_offsets) {
+        simdjson::ondemand::json_type type;
+        if (value.type().get(type) != simdjson::SUCCESS) {
+            return false;
+        }
+        if (type == simdjson::ondemand::json_type::string) {
+            std::string_view str;
+            if (value.get_string().get(str) != simdjson::SUCCESS) {
+                return false;
+            }
+            // a string is cut at the first '\0' like the rapidjson path
+            size_t len = strnlen(str.data(), std::min<size_t>(str.size(), max_string_len));
+            StringOP::push_value_string(std::string_view(str.data(), len), i, res_data,
+                                        res_offsets);
+        } else {
+            rapidjson::StringBuffer buf;
+            rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+            if (SimdJsonReader::write_value(value, &writer) != simdjson::SUCCESS) {
+                return false;
+            }
+            size_t len = strnlen(buf.GetString(), max_string_len);
+            StringOP::push_value_string(std::string_view(buf.GetString(), len), i, res_data,
+                                        res_offsets);
+        }
+        return true;
+    }
 };
 
 template <int flag>
@@ -563,9 +706,38 @@ public:
     }
 };
 
-using FunctionGetJsonDouble = FunctionBinaryStringOperateToNullType<GetJsonDouble>;
-using FunctionGetJsonInt = FunctionBinaryStringOperateToNullType<GetJsonInt>;
-using FunctionGetJsonString = FunctionBinaryStringOperateToNullType<GetJsonString>;
+template <typename Impl>
+class FunctionGetJsonByPath : public FunctionBinaryStringOperateToNullType<Impl> {
+public:
+    static FunctionPtr create() { return std::make_shared<FunctionGetJsonByPath<Impl>>(); }
+
+    Status prepare(FunctionContext* context, FunctionContext::FunctionStateScope scope) override {
+        if (scope != FunctionContext::THREAD_LOCAL) {
+            return Status::OK();
+        }
+        auto* state = new JsonPathState();
+        context->set_function_state(scope, state);
+        if (context->is_col_constant(1)) {
+            const auto path_col = context->get_constant_col(1)->column_ptr;
+            if (!path_col->is_null_at(0)) {
+                state->init(path_col->get_data_at(0).to_string_view());
+            }
+        }
+        return Status::OK();
+    }
+
+    Status close(FunctionContext* context, FunctionContext::FunctionStateScope scope) override {
+        if (scope == FunctionContext::THREAD_LOCAL) {
+            delete reinterpret_cast<JsonPathState*>(
+                    context->get_function_state(FunctionContext::THREAD_LOCAL));
+        }
+        return Status::OK();
+    }
+};
+
+using FunctionGetJsonDouble = FunctionGetJsonByPath<GetJsonDouble>;
+using FunctionGetJsonInt = FunctionGetJsonByPath<GetJsonInt>;
+using FunctionGetJsonString = FunctionGetJsonByPath<GetJsonString>;
 
 void register_function_json(SimpleFunctionFactory& factory) {
     factory.register_function<FunctionGetJsonInt>();
@@ -0,0 +1,246 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <limits>
+#include <vector>
+
+#include "exprs/json_functions.h"
+#include "util/jsonb.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/functions/function_string.h"
+#include "vec/functions/function_totype.h"
+#include "vec/functions/simple_function_factory.h"
+
+namespace doris::vectorized {
+
+// The json path of jsonb_extract_xxx() parsed in prepare() when it is a constant.
+struct JsonbPathState {
+    std::vector<JsonPath> parsed_paths;
+};
+
+// Find the value pointed by parsed_paths in a jsonb document. Every step is a lookup in the
+// offset index of the parent, the document is never parsed. Return false if the value does
+// not exist, the document is invalid or the paths contain [*].
+bool find_jsonb_value(const std::string_view& jsonb, const std::vector<JsonPath>& parsed_paths,
+                      JsonbValue* value) {
+    if (parsed_paths.empty() || !parsed_paths[0].is_valid) {
+        return false;
+    }
+    JsonbValue current;
+    if (!JsonbDocument::get_root(jsonb.data(), jsonb.size(), &current).ok()) {
+        return false;
+    }
+    for (size_t i = 1; i < parsed_paths.size(); ++i) {
+        const JsonPath& path = parsed_paths[i];
+        if (!path.is_valid || path.idx == -2) {
+            return false;
+        }
+        if (!path.key.empty()) {
+            if (!current.is_object() || !current.find_key(path.key, &current)) {
+                return false;
+            }
+        }
+        if (path.idx >= 0) {
+            if (!current.is_array() || static_cast<uint32_t>(path.idx) >= current.count()) {
+                return false;
+            }
+            current = current.array_at(path.idx);
+        }
+    }
+    *value = current;
+    return true;
+}
+
+const std::vector<JsonPath>& get_jsonb_paths(FunctionContext* context,
+                                             const std::string_view& path_string,
+                                             std::vector<JsonPath>* tmp_parsed_paths) {
+    auto* state = reinterpret_cast<JsonbPathState*>(
+            context->get_function_state(FunctionContext::THREAD_LOCAL));
+    if (state != nullptr && !state->parsed_paths.empty()) {
+        return state->parsed_paths;
+    }
+    tmp_parsed_paths->clear();
+    JsonFunctions::parse_json_paths(std::string(path_string), tmp_parsed_paths);
+    return *tmp_parsed_paths;
+}
+
+template <typename NumberType>
+struct JsonbExtractNumber {
+    using T = typename NumberType::T;
+    using ReturnType = typename NumberType::ReturnType;
+    using ColumnType = ColumnVector<T>;
+    using Container = typename ColumnType::Container;
+    static constexpr auto name = NumberType::name;
+
+    static void vector_vector(FunctionContext* context, const ColumnString::Chars& ldata,
+                              const ColumnString::Offsets& loffsets,
+                              const ColumnString::Chars& rdata,
+                              const ColumnString::Offsets& roffsets, Container& res,
+                              NullMap& null_map) {
+        size_t size = loffsets.size();
+        res.resize(size);
+        std::vector<JsonPath> tmp_parsed_paths;
+        for (size_t i = 0; i < size; ++i) {
+            res[i] = 0;
+            if (null_map[i]) {
+                continue;
+            }
+            std::string_view jsonb(reinterpret_cast<const char*>(&ldata[loffsets[i - 1]]),
+                                   loffsets[i] - loffsets[i - 1] - 1);
+            std::string_view path(reinterpret_cast<const char*>(&rdata[roffsets[i - 1]]),
+                                  roffsets[i] - roffsets[i - 1] - 1);
+
+            JsonbValue value;
+            if (!find_jsonb_value(jsonb, get_jsonb_paths(context, path, &tmp_parsed_paths),
+                                  &value) ||
+                !NumberType::get(value, &res[i])) {
+                null_map[i] = 1;
+            }
+        }
+    }
+};
+
+struct JsonbNumberTypeInt {
+    static constexpr auto name = "jsonb_extract_int";
+    using T = Int32;
+    using ReturnType = DataTypeInt32;
+
+    static bool get(const JsonbValue& value, T* res) {
+        if (value.type() != JsonbType::INT64 ||
+            value.get_int64() < std::numeric_limits<T>::min() ||
+            value.get_int64() > std::numeric_limits<T>::max()) {
+            return false;
+        }
+        *res = value.get_int64();
+        return true;
+    }
+};
+
+struct JsonbNumberTypeBigInt {
+    static constexpr auto name = "jsonb_extract_bigint";
+    using T = Int64;
+    using ReturnType = DataTypeInt64;
+
+    static bool get(const JsonbValue& value, T* res) {
+        if (value.type() != JsonbType::INT64) {
+            return false;
+        }
+        *res = value.get_int64();
+        return true;
+    }
+};
+
+struct JsonbNumberTypeDouble {
+    static constexpr auto name = "jsonb_extract_double";
+    using T = Float64;
+    using ReturnType = DataTypeFloat64;
+
+    static bool get(const JsonbValue& value, T* res) {
+        if (!value.is_number()) {
+            return false;
+        }
+        *res = value.get_number();
+        return true;
+    }
+};
+
+// Same as get_json_string(): a string is returned as it is, other values are returned as
+// json text and null is NULL.
+struct JsonbExtractString {
+    static constexpr auto name = "jsonb_extract_string";
+    using ReturnType = DataTypeString;
+    using ColumnType = ColumnString;
+    using Chars = ColumnString::Chars;
+    using Offsets = ColumnString::Offsets;
+
+    static void vector_vector(FunctionContext* context, const Chars& ldata, const Offsets& loffsets,
+                              const Chars& rdata, const Offsets& roffsets, Chars& res_data,
+                              Offsets& res_offsets, NullMap& null_map) {
+        size_t size = loffsets.size();
+        res_offsets.resize(size);
+        std::vector<JsonPath> tmp_parsed_paths;
+        for (size_t i = 0; i < size; ++i) {
+            if (null_map[i]) {
+                StringOP::push_null_string(i, res_data, res_offsets, null_map);
+                continue;
+            }
+            std::string_view jsonb(reinterpret_cast<const char*>(&ldata[loffsets[i - 1]]),
+                                   loffsets[i] - loffsets[i - 1] - 1);
+            std::string_view path(reinterpret_cast<const char*>(&rdata[roffsets[i - 1]]),
+                                  roffsets[i] - roffsets[i - 1] - 1);
+
+            JsonbValue value;
+            if (!find_jsonb_value(jsonb, get_jsonb_paths(context, path, &tmp_parsed_paths),
+                                  &value) ||
+                value.is_null()) {
+                StringOP::push_null_string(i, res_data, res_offsets, null_map);
+            } else if (value.is_string()) {
+                StringOP::push_value_string(value.get_string(), i, res_data, res_offsets);
+            } else {
+                StringOP::push_value_string(value.to_json_string(), i, res_data, res_offsets);
+            }
+        }
+    }
+};
+
+template <typename Impl>
+class FunctionJsonbExtract : public FunctionBinaryStringOperateToNullType<Impl> {
+public:
+    static FunctionPtr create() { return std::make_shared<FunctionJsonbExtract<Impl>>(); }
+
+    Status prepare(FunctionContext* context, FunctionContext::FunctionStateScope scope) override {
+        if (scope != FunctionContext::THREAD_LOCAL) {
+            return Status::OK();
+        }
+        auto* state = new JsonbPathState();
+        context->set_function_state(scope, state);
+        if (context->is_col_constant(1)) {
+            const auto path_col = context->get_constant_col(1)->column_ptr;
+            if (!path_col->is_null_at(0)) {
+                JsonFunctions::parse_json_paths(path_col->get_data_at(0).to_string(),
+                                                &state->parsed_paths);
+            }
+        }
+        return Status::OK();
+    }
+
+    Status close(FunctionContext* context, FunctionContext::FunctionStateScope scope) override {
+        if (scope == FunctionContext::THREAD_LOCAL) {
+            delete reinterpret_cast<JsonbPathState*>(
+                    context->get_function_state(FunctionContext::THREAD_LOCAL));
+        }
+        return Status::OK();
+    }
+};
+
+using FunctionJsonbExtractInt = FunctionJsonbExtract<JsonbExtractNumber<JsonbNumberTypeInt>>;
+using FunctionJsonbExtractBigInt = FunctionJsonbExtract<JsonbExtractNumber<JsonbNumberTypeBigInt>>;
+using FunctionJsonbExtractDouble = FunctionJsonbExtract<JsonbExtractNumber<JsonbNumberTypeDouble>>;
+using FunctionJsonbExtractString = FunctionJsonbExtract<JsonbExtractString>;
+
+void register_function_jsonb(SimpleFunctionFactory& factory) {
+    factory.register_function<FunctionJsonbExtractInt>();
+    factory.register_function<FunctionJsonbExtractBigInt>();
+    factory.register_function<FunctionJsonbExtractDouble>();
+    factory.register_function<FunctionJsonbExtractString>();
+}
+
+} // namespace doris::vectorized
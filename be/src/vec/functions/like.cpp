@@ -17,6 +17,8 @@
 
 #include "vec/functions/like.h"
 
+#include <algorithm>
+
 #include "runtime/string_value.h"
 #include "runtime/string_value.hpp"
 #include "vec/columns/column_const.h"
@@ -43,6 +45,12 @@ static const RE2 STARTS_WITH_RE("\\^([^\\.\\^\\{\\[\\(\\|\\)\\]\\}\\+\\*\\?\\$\\
 // A regex to match any regex pattern which is equivalent to a constant string match.
 static const RE2 EQUALS_RE("\\^([^\\.\\^\\{\\[\\(\\|\\)\\]\\}\\+\\*\\?\\$\\\\]*)\\$");
 
+// A regex to match any regex pattern which is an alternation of constant strings,
+// which is equivalent to searching any of the substrings.
+static const RE2 ALTERNATION_RE(
+        "[^\\.\\^\\{\\[\\(\\|\\)\\]\\}\\+\\*\\?\\$\\\\]+"
+        "(?:\\|[^\\.\\^\\{\\[\\(\\|\\)\\]\\}\\+\\*\\?\\$\\\\]+)+");
+
 // Like patterns
 static const re2::RE2 LIKE_SUBSTRING_RE("(?:%+)(((\\\\%)|(\\\\_)|([^%_]))+)(?:%+)");
 static const re2::RE2 LIKE_ENDS_WITH_RE("(?:%+)(((\\\\%)|(\\\\_)|([^%_]))+)");
@@ -82,19 +90,91 @@ Status FunctionLikeBase::constant_substring_fn(LikeSearchState* state, const Str
     return Status::OK();
 }
 
+Status FunctionLikeBase::vector_starts_with_fn(LikeSearchState* state,
+                                               const ColumnString& values,
+                                               ColumnUInt8::Container& result) {
+    const auto& chars = values.get_chars();
+    const auto& offsets = values.get_offsets();
+    const auto& needle = state->search_string;
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        size_t val_size = offsets[i] - offsets[i - 1] - 1;
+        result[i] = val_size >= needle.size() &&
+                    memcmp(&chars[offsets[i - 1]], needle.data(), needle.size()) == 0;
+    }
+    return Status::OK();
+}
+
+Status FunctionLikeBase::vector_ends_with_fn(LikeSearchState* state, const ColumnString& values,
+                                             ColumnUInt8::Container& result) {
+    const auto& chars = values.get_chars();
+    const auto& offsets = values.get_offsets();
+    const auto& needle = state->search_string;
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        size_t val_size = offsets[i] - offsets[i - 1] - 1;
+        result[i] = val_size >= needle.size() &&
+                    memcmp(&chars[offsets[i] - 1 - needle.size()], needle.data(),
+                           needle.size()) == 0;
+    }
+    return Status::OK();
+}
+
+Status FunctionLikeBase::vector_equals_fn(LikeSearchState* state, const ColumnString& values,
+                                          ColumnUInt8::Container& result) {
+    const auto& chars = values.get_chars();
+    const auto& offsets = values.get_offsets();
+    const auto& needle = state->search_string;
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        size_t val_size = offsets[i] - offsets[i - 1] - 1;
+        result[i] = val_size == needle.size() &&
+                    memcmp(&chars[offsets[i - 1]], needle.data(), needle.size()) == 0;
+    }
+    return Status::OK();
+}
+
+Status FunctionLikeBase::vector_substring_fn(LikeSearchState* state, const ColumnString& values,
+                                             ColumnUInt8::Container& result) {
+    if (state->search_string.empty()) {
+        std::fill(result.begin(), result.end(), 1);
+        return Status::OK();
+    }
+    std::fill(result.begin(), result.end(), 0);
+    search_in_column(state->substring_searcher, values, result);
+    return Status::OK();
+}
+
+void FunctionLikeBase::search_in_column(const StringSearcher& searcher, const ColumnString& values,
+                                        ColumnUInt8::Container& result) {
+    const auto& offsets = values.get_offsets();
+    const UInt8* begin = values.get_chars().data();
+    const UInt8* end = begin + values.get_chars().size();
+    const UInt8* pos = begin;
+    size_t row = 0;
+    while (pos < end) {
+        const UInt8* match = searcher.search(pos, end);
+        if (match == end) {
+            break;
+        }
+        // find the value where the match starts, every value is followed by a '\0'
+        while (begin + offsets[row] <= match) {
+            ++row;
+        }
+        if (match + searcher.needle_size() < begin + offsets[row]) {
+            result[row] = 1;
+        }
+        // a later match in this value can't end inside it either
+        pos = begin + offsets[row];
+        ++row;
+    }
+}
+
 Status FunctionLikeBase::execute_impl(FunctionContext* context, Block& block,
                                       const ColumnNumbers& arguments, size_t result,
                                       size_t /*input_rows_count*/) {
     // values and patterns
     const auto values_col =
             block.get_by_position(arguments[0]).column->convert_to_full_column_if_const();
-    const auto pattern_col =
-            block.get_by_position(arguments[1]).column->convert_to_full_column_if_const();
-
     const auto* values = check_and_get_column<ColumnString>(values_col.get());
-    const auto* patterns = check_and_get_column<ColumnString>(pattern_col.get());
-
-    if (!values || !patterns) {
+    if (!values) {
         return Status::InternalError("Not supported input arguments types");
     }
 
@@ -106,8 +186,20 @@ Status FunctionLikeBase::execute_impl(FunctionContext* context, Block& block,
     auto* state = reinterpret_cast<LikeState*>(
             context->get_function_state(FunctionContext::THREAD_LOCAL));
 
-    vector_vector(values->get_chars(), values->get_offsets(), patterns->get_chars(),
-                  patterns->get_offsets(), vec_res, state->function, &state->search_state);
+    const auto& pattern_column = block.get_by_position(arguments[1]).column;
+    if (state->vector_function && is_column_const(*pattern_column)) {
+        // the pattern was compiled in prepare(), no need to expand it to every row
+        RETURN_IF_ERROR(state->vector_function(&state->search_state, *values, vec_res));
+    } else {
+        const auto pattern_col = pattern_column->convert_to_full_column_if_const();
+        const auto* patterns = check_and_get_column<ColumnString>(pattern_col.get());
+        if (!patterns) {
+            return Status::InternalError("Not supported input arguments types");
+        }
+        RETURN_IF_ERROR(vector_vector(values->get_chars(), values->get_offsets(),
+                                      patterns->get_chars(), patterns->get_offsets(), vec_res,
+                                      state->function, &state->search_state));
+    }
 
     block.replace_by_position(result, std::move(res));
     return Status::OK();
@@ -165,6 +257,46 @@ Status FunctionLike::constant_regex_full_fn(LikeSearchState* state, const String
     return Status::OK();
 }
 
+Status FunctionLike::vector_regex_full_fn(LikeSearchState* state, const ColumnString& values,
+                                          ColumnUInt8::Container& result) {
+    const auto& prefilter = state->prefilter_searcher;
+    if (prefilter.needle_size() > 0) {
+        // only the values containing the constant part of pattern need to run regex
+        std::fill(result.begin(), result.end(), 0);
+        search_in_column(prefilter, values, result);
+    } else {
+        std::fill(result.begin(), result.end(), 1);
+    }
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (result[i]) {
+            StringRef val = values.get_data_at(i);
+            result[i] = RE2::FullMatch(re2::StringPiece(val.data, val.size), *state->regex);
+        }
+    }
+    return Status::OK();
+}
+
+std::string FunctionLike::extract_like_literal(LikeSearchState* state,
+                                               const std::string& pattern) {
+    std::string longest;
+    std::string current;
+    bool is_escaped = false;
+    for (char c : pattern) {
+        if (!is_escaped && (c == '%' || c == '_')) {
+            if (current.size() > longest.size()) {
+                longest.swap(current);
+            }
+            current.clear();
+        } else if (!is_escaped && c == state->escape_char) {
+            is_escaped = true;
+        } else {
+            current.append(1, c);
+            is_escaped = false;
+        }
+    }
+    return current.size() > longest.size() ? current : longest;
+}
+
 void FunctionLike::convert_like_pattern(LikeSearchState* state, const std::string& pattern,
                                         std::string* re_pattern) {
     re_pattern->clear();
@@ -227,18 +359,22 @@ Status FunctionLike::prepare(FunctionContext* context, FunctionContext::Function
             remove_escape_character(&search_string);
             state->search_state.set_search_string(search_string);
             state->function = constant_equals_fn;
+            state->vector_function = vector_equals_fn;
         } else if (RE2::FullMatch(pattern_str, LIKE_STARTS_WITH_RE, &search_string)) {
             remove_escape_character(&search_string);
             state->search_state.set_search_string(search_string);
             state->function = constant_starts_with_fn;
+            state->vector_function = vector_starts_with_fn;
         } else if (RE2::FullMatch(pattern_str, LIKE_ENDS_WITH_RE, &search_string)) {
             remove_escape_character(&search_string);
             state->search_state.set_search_string(search_string);
             state->function = constant_ends_with_fn;
+            state->vector_function = vector_ends_with_fn;
         } else if (RE2::FullMatch(pattern_str, LIKE_SUBSTRING_RE, &search_string)) {
             remove_escape_character(&search_string);
             state->search_state.set_search_string(search_string);
             state->function = constant_substring_fn;
+            state->vector_function = vector_substring_fn;
         } else {
             std::string re_pattern;
             convert_like_pattern(&state->search_state, pattern_str, &re_pattern);
@@ -250,7 +386,10 @@ Status FunctionLike::prepare(FunctionContext* context, FunctionContext::Function
                 return Status::InternalError(
                         fmt::format("Invalid regex expression: {}", pattern_str));
             }
+            state->search_state.prefilter_searcher =
+                    StringSearcher(extract_like_literal(&state->search_state, pattern_str));
             state->function = constant_regex_full_fn;
+            state->vector_function = vector_regex_full_fn;
         }
     }
     return Status::OK();
@@ -273,15 +412,19 @@ Status FunctionRegexp::prepare(FunctionContext* context,
         if (RE2::FullMatch(pattern_str, EQUALS_RE, &search_string)) {
             state->search_state.set_search_string(search_string);
             state->function = constant_equals_fn;
+            state->vector_function = vector_equals_fn;
         } else if (RE2::FullMatch(pattern_str, STARTS_WITH_RE, &search_string)) {
             state->search_state.set_search_string(search_string);
             state->function = constant_starts_with_fn;
+            state->vector_function = vector_starts_with_fn;
         } else if (RE2::FullMatch(pattern_str, ENDS_WITH_RE, &search_string)) {
             state->search_state.set_search_string(search_string);
             state->function = constant_ends_with_fn;
+            state->vector_function = vector_ends_with_fn;
         } else if (RE2::FullMatch(pattern_str, SUBSTRING_RE, &search_string)) {
             state->search_state.set_search_string(search_string);
             state->function = constant_substring_fn;
+            state->vector_function = vector_substring_fn;
         } else {
             RE2::Options opts;
             opts.set_never_nl(false);
@@ -292,6 +435,17 @@ Status FunctionRegexp::prepare(FunctionContext* context,
                         fmt::format("Invalid regex expression: {}", pattern_str));
             }
             state->function = constant_regex_partial_fn;
+            state->vector_function = vector_regex_partial_fn;
+            if (RE2::FullMatch(pattern_str, ALTERNATION_RE)) {
+                size_t start = 0;
+                while (start <= pattern_str.size()) {
+                    size_t end = std::min(pattern_str.find('|', start), pattern_str.size());
+                    state->search_state.alternative_searchers.emplace_back(
+                            pattern_str.substr(start, end - start));
+                    start = end + 1;
+                }
+                state->vector_function = vector_alternation_fn;
+            }
         }
     }
     return Status::OK();
@@ -304,6 +458,25 @@ Status FunctionRegexp::constant_regex_partial_fn(LikeSearchState* state, const S
     return Status::OK();
 }
 
+Status FunctionRegexp::vector_regex_partial_fn(LikeSearchState* state,
+                                               const ColumnString& values,
+                                               ColumnUInt8::Container& result) {
+    for (size_t i = 0; i < values.size(); ++i) {
+        StringRef val = values.get_data_at(i);
+        result[i] = RE2::PartialMatch(re2::StringPiece(val.data, val.size), *state->regex);
+    }
+    return Status::OK();
+}
+
+Status FunctionRegexp::vector_alternation_fn(LikeSearchState* state, const ColumnString& values,
+                                             ColumnUInt8::Container& result) {
+    std::fill(result.begin(), result.end(), 0);
+    for (const auto& searcher : state->alternative_searchers) {
+        search_in_column(searcher, values, result);
+    }
+    return Status::OK();
+}
+
 Status FunctionRegexp::regexp_fn(LikeSearchState* state, const StringValue& val,
                                  const StringValue& pattern, unsigned char* result) {
     std::string re_pattern(pattern.ptr, pattern.len);
@@ -19,12 +19,15 @@
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "runtime/string_search.hpp"
 #include "runtime/string_value.h"
 #include "vec/columns/column_const.h"
 #include "vec/columns/column_set.h"
+#include "vec/columns/column_string.h"
 #include "vec/columns/columns_number.h"
+#include "vec/common/string_searcher.h"
 #include "vec/data_types/data_type_nullable.h"
 #include "vec/data_types/data_type_number.h"
 #include "vec/exprs/vexpr.h"
@@ -53,6 +56,18 @@ struct LikeSearchState {
     /// in the value.
     doris::StringSearch substring_pattern;
 
+    /// Same as substring_pattern, but used to search the whole column at once.
+    StringSearcher substring_searcher;
+
+    /// Used for REGEXP predicates if the pattern is a constant alternation of strings,
+    /// e.g. "error|warn", a value matches if it contains any of them.
+    std::vector<StringSearcher> alternative_searchers;
+
+    /// Used for LIKE predicates if the pattern is a constant argument which can only be
+    /// matched by regex, holds the longest constant string every matched value must
+    /// contain, so that the regex only runs on the values containing it.
+    StringSearcher prefilter_searcher;
+
     /// Used for RLIKE and REGEXP predicates if the pattern is a constant argument.
     std::unique_ptr<re2::RE2> regex;
 
@@ -62,15 +77,22 @@ struct LikeSearchState {
         search_string = search_string_arg;
         search_string_sv = StringValue(search_string);
         substring_pattern = StringSearch(&search_string_sv);
+        substring_searcher = StringSearcher(search_string);
     }
 };
 
 using LikeFn = std::function<doris::Status(LikeSearchState* state, const StringValue&,
                                            const StringValue&, unsigned char*)>;
 
+/// Evaluate a constant pattern on all values of the column at once.
+using VectorLikeFn = std::function<doris::Status(LikeSearchState* state, const ColumnString&,
+                                                 ColumnUInt8::Container&)>;
+
 struct LikeState {
     LikeSearchState search_state;
     LikeFn function;
+    /// Set if the pattern is a constant argument.
+    VectorLikeFn vector_function;
 };
 
 class FunctionLikeBase : public IFunction {
@@ -105,6 +127,24 @@ protected:
 
     static Status constant_substring_fn(LikeSearchState* state, const StringValue& val,
                                         const StringValue& pattern, unsigned char* result);
+
+    static Status vector_starts_with_fn(LikeSearchState* state, const ColumnString& values,
+                                        ColumnUInt8::Container& result);
+
+    static Status vector_ends_with_fn(LikeSearchState* state, const ColumnString& values,
+                                      ColumnUInt8::Container& result);
+
+    static Status vector_equals_fn(LikeSearchState* state, const ColumnString& values,
+                                   ColumnUInt8::Container& result);
+
+    static Status vector_substring_fn(LikeSearchState* state, const ColumnString& values,
+                                      ColumnUInt8::Container& result);
+
+    // Set result of the values containing needle of searcher to 1, other results are
+    // not changed. The whole chars buffer of values is searched in one pass instead of
+    // searching every value separately.
+    static void search_in_column(const StringSearcher& searcher, const ColumnString& values,
+                                 ColumnUInt8::Container& result);
 };
 
 class FunctionLike : public FunctionLikeBase {
@@ -124,6 +164,13 @@ private:
     static Status constant_regex_full_fn(LikeSearchState* state, const StringValue& val,
                                          const StringValue& pattern, unsigned char* result);
 
+    static Status vector_regex_full_fn(LikeSearchState* state, const ColumnString& values,
+                                       ColumnUInt8::Container& result);
+
+    // Return the longest constant string in like pattern, which is contained in every
+    // value matching the pattern.
+    static std::string extract_like_literal(LikeSearchState* state, const std::string& pattern);
+
     static void convert_like_pattern(LikeSearchState* state, const std::string& pattern,
                                      std::string* re_pattern);
 
@@ -146,6 +193,12 @@ private:
 
     static Status constant_regex_partial_fn(LikeSearchState* state, const StringValue& val,
                                             const StringValue& pattern, unsigned char* result);
+
+    static Status vector_regex_partial_fn(LikeSearchState* state, const ColumnString& values,
+                                          ColumnUInt8::Container& result);
+
+    static Status vector_alternation_fn(LikeSearchState* state, const ColumnString& values,
+                                        ColumnUInt8::Container& result);
 };
 
 void register_function_like(SimpleFunctionFactory& factory) {
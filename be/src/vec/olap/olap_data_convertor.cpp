@@ -48,7 +48,8 @@ OlapBlockDataConvertor::create_olap_column_data_convertor(const TabletColumn& co
     case FieldType::OLAP_FIELD_TYPE_VARCHAR: {
         return std::make_unique<OlapColumnDataConvertorVarChar>(false);
     }
-    case FieldType::OLAP_FIELD_TYPE_STRING: {
+    case FieldType::OLAP_FIELD_TYPE_STRING:
+    case FieldType::OLAP_FIELD_TYPE_JSONB: {
         return std::make_unique<OlapColumnDataConvertorVarChar>(true);
     }
     case FieldType::OLAP_FIELD_TYPE_DATE: {
@@ -107,6 +108,23 @@ void OlapBlockDataConvertor::set_source_content(const vectorized::Block* block,
     }
 }
 
+void OlapBlockDataConvertor::set_source_content_with_specifid_columns(
+        const vectorized::Block* block, size_t row_pos, size_t num_rows,
+        const std::vector<uint32_t>& cids) {
+    assert(block && num_rows > 0 && row_pos + num_rows <= block->rows() &&
+           block->columns() == cids.size());
+    for (size_t i = 0; i < cids.size(); ++i) {
+        _convertors[cids[i]]->set_source_column(block->get_by_position(i), row_pos, num_rows);
+    }
+}
+
+void OlapBlockDataConvertor::set_source_column(
+        size_t cid, const vectorized::ColumnWithTypeAndName& typed_column, size_t row_pos,
+        size_t num_rows) {
+    assert(cid < _convertors.size());
+    _convertors[cid]->set_source_column(typed_column, row_pos, num_rows);
+}
+
 void OlapBlockDataConvertor::clear_source_content() {
     for (auto& convertor : _convertors) {
         convertor->clear_source_column();
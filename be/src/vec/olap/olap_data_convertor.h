@@ -36,6 +36,13 @@ class OlapBlockDataConvertor {
 public:
     OlapBlockDataConvertor(const TabletSchema* tablet_schema);
     void set_source_content(const vectorized::Block* block, size_t row_pos, size_t num_rows);
+    // the columns of `block` are the columns of tablet schema in `cids`
+    void set_source_content_with_specifid_columns(const vectorized::Block* block, size_t row_pos,
+                                                  size_t num_rows,
+                                                  const std::vector<uint32_t>& cids);
+    // replace the source of the column of tablet schema `cid` with `typed_column`
+    void set_source_column(size_t cid, const vectorized::ColumnWithTypeAndName& typed_column,
+                           size_t row_pos, size_t num_rows);
     void clear_source_content();
     std::pair<Status, IOlapColumnDataAccessor*> convert_column_data(size_t cid);
 
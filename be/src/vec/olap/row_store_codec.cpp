@@ -0,0 +1,91 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/olap/row_store_codec.h"
+
+#include "util/crc32c.h"
+#include "vec/columns/column_string.h"
+#include "vec/common/arena.h"
+#include "vec/common/unaligned.h"
+
+namespace doris::vectorized {
+
+RowStoreCodec::RowStoreCodec(const TabletSchema& schema) {
+    int32_t row_store_col_idx = schema.row_store_col_idx();
+    for (uint32_t cid = 0; cid < schema.num_columns(); ++cid) {
+        if (static_cast<int32_t>(cid) == row_store_col_idx) {
+            continue;
+        }
+        _column_ids.push_back(cid);
+        const TabletColumn& column = schema.column(cid);
+        int32_t unique_id = column.unique_id();
+        int32_t type = column.type();
+        _signature = crc32c::Extend(_signature, reinterpret_cast<const char*>(&unique_id),
+                                    sizeof(unique_id));
+        _signature = crc32c::Extend(_signature, reinterpret_cast<const char*>(&type), sizeof(type));
+    }
+}
+
+MutableColumnPtr RowStoreCodec::encode(const Block& block, size_t row_pos, size_t num_rows) const {
+    Columns columns;
+    for (auto cid : _column_ids) {
+        columns.push_back(block.get_by_position(cid).column->convert_to_full_column_if_const());
+    }
+
+    auto rows = ColumnString::create();
+    rows->reserve(num_rows);
+    Arena arena;
+    for (size_t i = row_pos; i < row_pos + num_rows; ++i) {
+        const char* begin = nullptr;
+        char* pos = arena.alloc_continue(sizeof(_signature), begin);
+        unaligned_store<uint32_t>(pos, _signature);
+        size_t size = sizeof(_signature);
+        for (const auto& column : columns) {
+            // every value starts with a null flag like a nullable one does, so a row is decoded
+            // no matter the nullability of the columns it is decoded into
+            if (!column->is_nullable()) {
+                pos = arena.alloc_continue(sizeof(UInt8), begin);
+                *pos = 0;
+                size += sizeof(UInt8);
+            }
+            size += column->serialize_value_into_arena(i, arena, begin).size;
+        }
+        rows->insert_data(begin, size);
+    }
+    return rows;
+}
+
+bool RowStoreCodec::decode(const StringRef& row, MutableColumns& columns) const {
+    DCHECK_EQ(_column_ids.size(), columns.size());
+    if (row.size < sizeof(_signature) || unaligned_load<uint32_t>(row.data) != _signature) {
+        return false;
+    }
+    const char* pos = row.data + sizeof(_signature);
+    for (auto& column : columns) {
+        if (column->is_nullable()) {
+            pos = column->deserialize_and_insert_from_arena(pos);
+        } else if (*pos++ != 0) {
+            column->insert_default();
+        } else {
+            pos = column->deserialize_and_insert_from_arena(pos);
+        }
+    }
+    DCHECK_EQ(pos, row.data + row.size);
+    return true;
+}
+
+} // namespace doris::vectorized
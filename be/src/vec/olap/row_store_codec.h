@@ -0,0 +1,54 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <vector>
+
+#include "olap/tablet_schema.h"
+#include "vec/common/string_ref.h"
+#include "vec/core/block.h"
+
+namespace doris::vectorized {
+
+/** Encodes the rows of a tablet into its row store column, which holds all the other columns of
+  *  a row in one value, so a whole row is read by one value instead of a page of every column.
+  * A value starts with a signature of the columns it is encoded from, it can only be decoded
+  *  by a schema with the same columns, e.g. not after a column is added by a linked schema
+  *  change. An empty value is never decoded.
+  */
+class RowStoreCodec {
+public:
+    explicit RowStoreCodec(const TabletSchema& schema);
+
+    /// The ids of the columns in a row, all the columns but the row store column.
+    const std::vector<uint32_t>& column_ids() const { return _column_ids; }
+
+    /// Returns a string column with a value for each of the num_rows rows of block from row_pos,
+    ///  the block holds all the columns of the schema.
+    MutableColumnPtr encode(const Block& block, size_t row_pos, size_t num_rows) const;
+
+    /// Appends the columns of a row to columns, in the order of column_ids(). Returns false
+    ///  and leaves columns unchanged if the row is empty or encoded from other columns.
+    bool decode(const StringRef& row, MutableColumns& columns) const;
+
+private:
+    std::vector<uint32_t> _column_ids;
+    uint32_t _signature = 0;
+};
+
+} // namespace doris::vectorized
@@ -0,0 +1,412 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/olap/vertical_merge_iterator.h"
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "olap/olap_define.h"
+#include "vec/aggregate_functions/aggregate_function_reader.h"
+#include "vec/aggregate_functions/aggregate_function_simple_factory.h"
+
+namespace doris {
+
+namespace vectorized {
+
+// -------------- RowSource -------------- //
+RowSource::RowSource(uint16_t source_num, bool agg_flag) {
+    DCHECK(source_num <= MAX_SOURCE_NUM);
+    _data = agg_flag ? (source_num | AGG_FLAG) : source_num;
+}
+
+void RowSource::set_agg_flag(bool agg_flag) {
+    _data = agg_flag ? (_data | AGG_FLAG) : (_data & SOURCE_FLAG);
+}
+
+// -------------- RowSourcesBuffer -------------- //
+RowSourcesBuffer::~RowSourcesBuffer() {
+    if (_file != nullptr) {
+        std::string file_name = _file->filename();
+        WARN_IF_ERROR(_file->close(), "failed to close row sources file " + file_name);
+        _file.reset();
+        WARN_IF_ERROR(Env::Default()->delete_file(file_name),
+                      "failed to delete row sources file " + file_name);
+    }
+}
+
+Status RowSourcesBuffer::append(const std::vector<RowSource>& row_sources) {
+    DCHECK(!_reading) << "row sources can't be appended after they are read";
+    if (row_sources.empty()) {
+        return Status::OK();
+    }
+    if (_buffer.size() * sizeof(uint16_t) >=
+        config::vertical_compaction_max_row_source_memory_mb * 1024 * 1024) {
+        // spill row sources in memory to file
+        if (_file == nullptr) {
+            RETURN_IF_ERROR(_create_buffer_file());
+        }
+        RETURN_IF_ERROR(_serialize());
+    }
+    for (const auto& row_source : row_sources) {
+        _buffer.push_back(row_source.data());
+    }
+    _total_size += row_sources.size();
+    return Status::OK();
+}
+
+Status RowSourcesBuffer::flush() {
+    // row sources in memory are read back from file after reading starts, they are
+    // written already
+    if (!_reading && _file != nullptr && !_buffer.empty()) {
+        RETURN_IF_ERROR(_serialize());
+    }
+    return Status::OK();
+}
+
+Status RowSourcesBuffer::seek_to_begin() {
+    RETURN_IF_ERROR(flush());
+    _reading = true;
+    _buf_idx = 0;
+    if (_file != nullptr) {
+        // all row sources are in file, read them from the beginning
+        _read_offset = 0;
+        _buffer.clear();
+    }
+    return Status::OK();
+}
+
+Status RowSourcesBuffer::has_remaining() {
+    if (_buf_idx < _buffer.size()) {
+        return Status::OK();
+    }
+    if (_file != nullptr && _read_offset < _file_size) {
+        RETURN_IF_ERROR(_deserialize());
+        _buf_idx = 0;
+        return Status::OK();
+    }
+    return Status::EndOfFile("end of row sources");
+}
+
+size_t RowSourcesBuffer::same_source_count(size_t limit) const {
+    size_t end = std::min(_buffer.size(), _buf_idx + limit);
+    uint16_t data = _buffer[_buf_idx];
+    size_t idx = _buf_idx + 1;
+    while (idx < end && _buffer[idx] == data) {
+        ++idx;
+    }
+    return idx - _buf_idx;
+}
+
+Status RowSourcesBuffer::_create_buffer_file() {
+    std::string file_path = _tablet_path + "/" + _rowset_id + "_row_sources.tmp";
+    RETURN_IF_ERROR(Env::Default()->new_random_rw_file(file_path, &_file));
+    LOG(INFO) << "create row sources file for vertical compaction, tablet_id=" << _tablet_id
+              << ", path=" << file_path;
+    return Status::OK();
+}
+
+Status RowSourcesBuffer::_serialize() {
+    Slice data((const char*)_buffer.data(), _buffer.size() * sizeof(uint16_t));
+    RETURN_IF_ERROR(_file->write_at(_file_size, data));
+    _file_size += data.size;
+    _buffer.clear();
+    return Status::OK();
+}
+
+Status RowSourcesBuffer::_deserialize() {
+    uint64_t max_bytes = config::vertical_compaction_max_row_source_memory_mb * 1024 * 1024;
+    max_bytes = std::max(max_bytes, (uint64_t)sizeof(uint16_t));
+    uint64_t bytes = std::min(_file_size - _read_offset, max_bytes);
+    bytes -= bytes % sizeof(uint16_t);
+    _buffer.resize(bytes / sizeof(uint16_t));
+    RETURN_IF_ERROR(_file->read_at(_read_offset, Slice((char*)_buffer.data(), bytes)));
+    _read_offset += bytes;
+    return Status::OK();
+}
+
+// -------------- VerticalMergeIteratorContext -------------- //
+Status VerticalMergeIteratorContext::init(const StorageReadOptions& opts) {
+    RETURN_IF_ERROR(_iter->init(opts));
+    _block = _tablet_schema.create_block(_column_ids);
+    return _load_next_block();
+}
+
+bool VerticalMergeIteratorContext::compare(const VerticalMergeIteratorContext& rhs) const {
+    int cmp_res = _block.compare_at(_index_in_block, rhs._index_in_block, _num_key_columns,
+                                    rhs._block, -1);
+    if (cmp_res != 0) {
+        return cmp_res > 0;
+    }
+    if (_seq_col_idx != -1) {
+        cmp_res = _block.compare_column_at(_index_in_block, rhs._index_in_block, _seq_col_idx,
+                                           rhs._block, -1);
+        if (cmp_res != 0) {
+            // row with larger sequence goes first
+            return cmp_res < 0;
+        }
+    }
+    if (_keys_type == UNIQUE_KEYS) {
+        // newer row goes first, and the others will be skipped
+        return _order < rhs._order;
+    }
+    // older row goes first, so that rows are aggregated in the order of versions
+    return _order > rhs._order;
+}
+
+bool VerticalMergeIteratorContext::is_same_keys(const VerticalMergeIteratorContext& rhs) const {
+    return _block.compare_at(_index_in_block, rhs._index_in_block, _num_key_columns, rhs._block,
+                             -1) == 0;
+}
+
+void VerticalMergeIteratorContext::copy_rows(Block* block, size_t count) {
+    DCHECK(count <= remain_rows());
+    for (size_t i = 0; i < _block.columns(); ++i) {
+        const auto& src_column = _block.get_by_position(i).column;
+        auto& dst_column = block->get_by_position(i).column;
+        ((IColumn&)(*dst_column)).insert_range_from(*src_column, _index_in_block, count);
+    }
+}
+
+Status VerticalMergeIteratorContext::advance(size_t step) {
+    _is_same = false;
+    _index_in_block += step;
+    if (LIKELY(_index_in_block < _block.rows())) {
+        return Status::OK();
+    }
+    return _load_next_block();
+}
+
+Status VerticalMergeIteratorContext::_load_next_block() {
+    do {
+        _block.clear_column_data();
+        Status st = _iter->next_batch(&_block);
+        if (!st.ok()) {
+            _valid = false;
+            if (st.is_end_of_file()) {
+                return Status::OK();
+            }
+            return st;
+        }
+    } while (_block.rows() == 0);
+    _index_in_block = 0;
+    _valid = true;
+    return Status::OK();
+}
+
+// -------------- VerticalHeapMergeIterator -------------- //
+VerticalHeapMergeIterator::~VerticalHeapMergeIterator() = default;
+
+Status VerticalHeapMergeIterator::init(const StorageReadOptions& opts) {
+    if (_origin_iters.empty()) {
+        return Status::OK();
+    }
+    if (_origin_iters.size() > RowSource::MAX_SOURCE_NUM) {
+        return Status::InternalError("too many inputs for vertical merge");
+    }
+    _schema = &(*_origin_iters.begin())->schema();
+
+    uint16_t order = 0;
+    for (auto& iter : _origin_iters) {
+        auto ctx = std::make_unique<VerticalMergeIteratorContext>(
+                std::move(iter), order++, _tablet_schema, _column_ids, _num_key_columns,
+                _seq_col_idx, _keys_type);
+        RETURN_IF_ERROR(ctx->init(opts));
+        if (ctx->valid()) {
+            _merge_heap.push(ctx.get());
+        }
+        _ctxs.push_back(std::move(ctx));
+    }
+    _origin_iters.clear();
+
+    _block_row_max = opts.block_row_max;
+    return Status::OK();
+}
+
+Status VerticalHeapMergeIterator::next_batch(Block* block) {
+    size_t num_rows = 0;
+    std::vector<RowSource> row_sources;
+    row_sources.reserve(_block_row_max);
+    while (num_rows < (size_t)_block_row_max && !_merge_heap.empty()) {
+        auto ctx = _merge_heap.top();
+        _merge_heap.pop();
+
+        bool is_same = ctx->is_same();
+        if (is_same) {
+            // rows with the same keys are merged into the first one
+            ++_merged_rows;
+        } else {
+            ctx->copy_rows(block, 1);
+            ++num_rows;
+        }
+        row_sources.emplace_back(ctx->order(), is_same);
+
+        // Rows of an input have different keys for UNIQUE_KEYS and AGG_KEYS, so the
+        // rows with the same keys as the current one must be on the top of heap now.
+        if (_keys_type != DUP_KEYS && !_merge_heap.empty()) {
+            auto next_ctx = _merge_heap.top();
+            next_ctx->set_is_same(ctx->is_same_keys(*next_ctx));
+        }
+
+        RETURN_IF_ERROR(ctx->advance());
+        if (ctx->valid()) {
+            _merge_heap.push(ctx);
+        }
+    }
+    RETURN_IF_ERROR(_row_sources_buf->append(row_sources));
+    if (!_merge_heap.empty()) {
+        return Status::OK();
+    }
+    // Still last batch needs to be processed
+    return Status::EndOfFile("no more data in segment");
+}
+
+// -------------- VerticalMaskMergeIterator -------------- //
+VerticalMaskMergeIterator::~VerticalMaskMergeIterator() {
+    for (int i = 0; i < _agg_functions.size(); ++i) {
+        _agg_functions[i]->destroy(_agg_places[i]);
+        delete[] _agg_places[i];
+    }
+}
+
+Status VerticalMaskMergeIterator::init(const StorageReadOptions& opts) {
+    if (_origin_iters.empty()) {
+        return Status::OK();
+    }
+    _schema = &(*_origin_iters.begin())->schema();
+
+    uint16_t order = 0;
+    for (auto& iter : _origin_iters) {
+        auto ctx = std::make_unique<VerticalMergeIteratorContext>(
+                std::move(iter), order++, _tablet_schema, _column_ids, 0, -1, _keys_type);
+        RETURN_IF_ERROR(ctx->init(opts));
+        _ctxs.push_back(std::move(ctx));
+    }
+    _origin_iters.clear();
+
+    _block_row_max = opts.block_row_max;
+    if (_keys_type == AGG_KEYS) {
+        RETURN_IF_ERROR(_init_agg_functions());
+    }
+    return Status::OK();
+}
+
+Status VerticalMaskMergeIterator::_init_agg_functions() {
+    _agg_block = _tablet_schema.create_block(_column_ids);
+    for (size_t i = 0; i < _column_ids.size(); ++i) {
+        const auto& column = _tablet_schema.column(_column_ids[i]);
+        std::string agg_name = TabletColumn::get_string_by_aggregation_type(column.aggregation()) +
+                               AGG_READER_SUFFIX;
+        std::transform(agg_name.begin(), agg_name.end(), agg_name.begin(),
+                       [](unsigned char c) { return std::tolower(c); });
+
+        auto data_type = _agg_block.get_data_type(i);
+        DataTypes argument_types;
+        argument_types.push_back(data_type);
+        Array params;
+        AggregateFunctionPtr function = AggregateFunctionSimpleFactory::instance().get(
+                agg_name, argument_types, params, data_type->is_nullable());
+        if (function == nullptr) {
+            return Status::InternalError("failed to create aggregate function " + agg_name);
+        }
+        _agg_functions.push_back(function);
+        AggregateDataPtr place = new char[function->size_of_data()];
+        function->create(place);
+        _agg_places.push_back(place);
+    }
+    return Status::OK();
+}
+
+Status VerticalMaskMergeIterator::next_batch(Block* block) {
+    Block* dst = _keys_type == AGG_KEYS ? &_agg_block : block;
+    size_t num_rows = 0;
+    while (true) {
+        auto st = _row_sources_buf->has_remaining();
+        if (st.is_end_of_file()) {
+            break;
+        }
+        RETURN_IF_ERROR(st);
+
+        auto row_source = _row_sources_buf->current();
+        // never split rows with the same keys into different blocks
+        if (num_rows >= (size_t)_block_row_max && !row_source.agg_flag()) {
+            break;
+        }
+        auto& ctx = _ctxs[row_source.get_source_num()];
+        if (UNLIKELY(!ctx->valid())) {
+            return Status::InternalError("row sources do not match inputs of vertical merge");
+        }
+        if (_keys_type == UNIQUE_KEYS && row_source.agg_flag()) {
+            // replaced by the newer row
+            _row_sources_buf->advance();
+            RETURN_IF_ERROR(ctx->advance());
+            continue;
+        }
+
+        // copy continuous rows from the same input at once
+        size_t limit = ctx->remain_rows();
+        if (_keys_type != AGG_KEYS) {
+            limit = std::min(limit, (size_t)_block_row_max - num_rows);
+        }
+        size_t count = _row_sources_buf->same_source_count(limit);
+        ctx->copy_rows(dst, count);
+        if (_keys_type == AGG_KEYS && !row_source.agg_flag()) {
+            // every row without agg flag starts a new aggregate group
+            for (size_t i = 0; i < count; ++i) {
+                _agg_group_starts.push_back(num_rows + i);
+            }
+        }
+        num_rows += count;
+        _row_sources_buf->advance(count);
+        RETURN_IF_ERROR(ctx->advance(count));
+    }
+
+    if (num_rows == 0) {
+        return Status::EndOfFile("no more row sources");
+    }
+    if (_keys_type == AGG_KEYS) {
+        _aggregate(block);
+    }
+    return Status::OK();
+}
+
+void VerticalMaskMergeIterator::_aggregate(Block* block) {
+    size_t num_rows = _agg_block.rows();
+    DCHECK(!_agg_group_starts.empty() && _agg_group_starts[0] == 0);
+    for (size_t i = 0; i < _agg_functions.size(); ++i) {
+        const auto& function = _agg_functions[i];
+        auto place = _agg_places[i];
+        const IColumn* column = _agg_block.get_by_position(i).column.get();
+        bool has_null = column->has_null(num_rows);
+        auto& dst_column = (IColumn&)(*block->get_by_position(i).column);
+        for (size_t group = 0; group < _agg_group_starts.size(); ++group) {
+            size_t begin = _agg_group_starts[group];
+            size_t end = group + 1 < _agg_group_starts.size() ? _agg_group_starts[group + 1]
+                                                              : num_rows;
+            function->add_batch_range(begin, end - 1, place, &column, nullptr, has_null);
+            function->insert_result_into(place, dst_column);
+            // reset aggregate data
+            function->destroy(place);
+            function->create(place);
+        }
+    }
+    _agg_group_starts.clear();
+    _agg_block.clear_column_data();
+}
+
+} // namespace vectorized
+
+} // namespace doris
@@ -0,0 +1,309 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <queue>
+
+#include "common/status.h"
+#include "env/env.h"
+#include "olap/iterators.h"
+#include "olap/schema.h"
+#include "olap/tablet_schema.h"
+#include "vec/aggregate_functions/aggregate_function.h"
+#include "vec/core/block.h"
+
+namespace doris {
+
+namespace vectorized {
+
+// Vertical compaction merges the input rowsets column group by column group.
+// The key column group is merged first by VerticalHeapMergeIterator, which records
+// the source of every merged row into RowSourcesBuffer. Then every value column
+// group is merged by VerticalMaskMergeIterator, following the recorded row sources
+// instead of comparing keys again.
+
+// RowSource records the input source (a segment of the input rowsets) of a row in
+// the key column group merge result. The lowest 15 bits are the order of the source,
+// and the highest bit is set if the keys of this row are the same as the previous row,
+// which means the row should be skipped (UNIQUE_KEYS) or aggregated into the previous
+// row (AGG_KEYS).
+class RowSource {
+public:
+    RowSource(uint16_t data) : _data(data) {}
+    RowSource(uint16_t source_num, bool agg_flag);
+
+    uint16_t get_source_num() const { return _data & SOURCE_FLAG; }
+    bool agg_flag() const { return (_data & AGG_FLAG) != 0; }
+    void set_agg_flag(bool agg_flag);
+
+    uint16_t data() const { return _data; }
+
+    // the max number of sources a RowSource can represent
+    static const uint16_t MAX_SOURCE_NUM = 0x7FFF;
+
+private:
+    uint16_t _data;
+    static const uint16_t SOURCE_FLAG = 0x7FFF;
+    static const uint16_t AGG_FLAG = 0x8000;
+};
+
+// RowSourcesBuffer holds the row sources generated by the key column group merge.
+// Row sources are kept in memory, and spilled to a temporary file in the tablet
+// directory when they exceed config::vertical_compaction_max_row_source_memory_mb.
+// The temporary file is named after the output rowset id, so it will not be removed
+// by path gc while the compaction is running, and it is removed when the buffer is
+// destroyed.
+//
+// Usage:
+//      RowSourcesBuffer buffer(tablet_id, tablet_path, rowset_id);
+//      RETURN_IF_ERROR(buffer.append(row_sources));
+//      ...
+//      RETURN_IF_ERROR(buffer.flush());
+//      RETURN_IF_ERROR(buffer.seek_to_begin());
+//      while (buffer.has_remaining().ok()) {
+//          visit(buffer.current());
+//          buffer.advance();
+//      }
+// Row sources can be read many times by seeking to the beginning again, but can't be
+// appended after they are read.
+class RowSourcesBuffer {
+public:
+    RowSourcesBuffer(int64_t tablet_id, const std::string& tablet_path,
+                     const std::string& rowset_id)
+            : _tablet_id(tablet_id), _tablet_path(tablet_path), _rowset_id(rowset_id) {}
+
+    ~RowSourcesBuffer();
+
+    // append row sources, spill to file if the memory limit is reached
+    Status append(const std::vector<RowSource>& row_sources);
+    // spill all row sources appended in memory to file if the file has been created,
+    // no op after reading starts
+    Status flush();
+
+    // prepare to read row sources from the first one
+    Status seek_to_begin();
+    // Return OK if there are remaining row sources to read, and make sure
+    // current() is valid. Return EndOfFile if all row sources have been read.
+    Status has_remaining();
+
+    RowSource current() const {
+        DCHECK(_buf_idx < _buffer.size());
+        return RowSource(_buffer[_buf_idx]);
+    }
+    void advance(size_t step = 1) {
+        DCHECK(_buf_idx + step <= _buffer.size());
+        _buf_idx += step;
+    }
+
+    // Return the number of continuous row sources in memory which are the same as the
+    // current one, at most `limit`. The current row source is counted.
+    size_t same_source_count(size_t limit) const;
+
+    uint64_t total_size() const { return _total_size; }
+
+private:
+    Status _create_buffer_file();
+    Status _serialize();
+    Status _deserialize();
+
+    int64_t _tablet_id;
+    std::string _tablet_path;
+    std::string _rowset_id;
+
+    std::unique_ptr<RandomRWFile> _file;
+    // bytes written to file
+    uint64_t _file_size = 0;
+    // bytes read from file
+    uint64_t _read_offset = 0;
+    // whether reading has started, when row sources in _buffer are read from file
+    // if it exists, otherwise they are appended and not written to file yet
+    bool _reading = false;
+
+    std::vector<uint16_t> _buffer;
+    size_t _buf_idx = 0;
+    uint64_t _total_size = 0;
+};
+
+// Used to store merge state for an input of vertical merge iterators.
+// It owns the input iterator, and keeps a block loaded from the iterator.
+class VerticalMergeIteratorContext {
+public:
+    VerticalMergeIteratorContext(std::unique_ptr<RowwiseIterator> iter, uint16_t order,
+                                 const TabletSchema& tablet_schema,
+                                 const std::vector<uint32_t>& column_ids, size_t num_key_columns,
+                                 int seq_col_idx, KeysType keys_type)
+            : _iter(std::move(iter)),
+              _order(order),
+              _tablet_schema(tablet_schema),
+              _column_ids(column_ids),
+              _num_key_columns(num_key_columns),
+              _seq_col_idx(seq_col_idx),
+              _keys_type(keys_type) {}
+
+    VerticalMergeIteratorContext(const VerticalMergeIteratorContext&) = delete;
+    VerticalMergeIteratorContext& operator=(const VerticalMergeIteratorContext&) = delete;
+
+    // Initialize this context and load the first block
+    Status init(const StorageReadOptions& opts);
+
+    // Return true if the current row of this context should be output after `rhs`.
+    // Rows are ordered by keys, then by sequence column in descending order, then by
+    // the order of inputs: newer input first for UNIQUE_KEYS, older input first otherwise.
+    bool compare(const VerticalMergeIteratorContext& rhs) const;
+
+    // Return true if the keys of current rows are the same
+    bool is_same_keys(const VerticalMergeIteratorContext& rhs) const;
+
+    // copy `count` rows from the current row to `block`
+    void copy_rows(Block* block, size_t count);
+
+    // Advance `step` rows, load next block if the current block is consumed
+    Status advance(size_t step = 1);
+
+    bool valid() const { return _valid; }
+    uint16_t order() const { return _order; }
+    size_t remain_rows() const { return _block.rows() - _index_in_block; }
+
+    bool is_same() const { return _is_same; }
+    void set_is_same(bool is_same) { _is_same = is_same; }
+
+private:
+    Status _load_next_block();
+
+    std::unique_ptr<RowwiseIterator> _iter;
+    uint16_t _order;
+    const TabletSchema& _tablet_schema;
+    std::vector<uint32_t> _column_ids;
+    size_t _num_key_columns;
+    int _seq_col_idx;
+    KeysType _keys_type;
+
+    Block _block;
+    size_t _index_in_block = 0;
+    bool _valid = false;
+    // whether the keys of current row are the same as the previous merged row
+    bool _is_same = false;
+};
+
+// Merge the key column group of inputs, and generate row sources.
+// For UNIQUE_KEYS and AGG_KEYS, rows with the same keys are merged into one row.
+class VerticalHeapMergeIterator : public RowwiseIterator {
+public:
+    // VerticalHeapMergeIterator takes the ownership of input iterators, inputs must be
+    // ordered by version, and the index of an input is its order in RowSource.
+    VerticalHeapMergeIterator(std::vector<std::unique_ptr<RowwiseIterator>> iters,
+                              const TabletSchema& tablet_schema,
+                              const std::vector<uint32_t>& column_ids, size_t num_key_columns,
+                              int seq_col_idx, RowSourcesBuffer* row_sources_buf)
+            : _origin_iters(std::move(iters)),
+              _tablet_schema(tablet_schema),
+              _column_ids(column_ids),
+              _num_key_columns(num_key_columns),
+              _seq_col_idx(seq_col_idx),
+              _keys_type(tablet_schema.keys_type()),
+              _row_sources_buf(row_sources_buf) {}
+
+    ~VerticalHeapMergeIterator() override;
+
+    Status init(const StorageReadOptions& opts) override;
+
+    // Same as VMergeIterator, return EndOfFile with the last batch
+    Status next_batch(Block* block) override;
+
+    const Schema& schema() const override { return *_schema; }
+
+    uint64_t merged_rows() const { return _merged_rows; }
+
+private:
+    struct VerticalMergeContextComparator {
+        bool operator()(const VerticalMergeIteratorContext* lhs,
+                        const VerticalMergeIteratorContext* rhs) const {
+            return lhs->compare(*rhs);
+        }
+    };
+
+    using VMergeHeap = std::priority_queue<VerticalMergeIteratorContext*,
+                                           std::vector<VerticalMergeIteratorContext*>,
+                                           VerticalMergeContextComparator>;
+
+    std::vector<std::unique_ptr<RowwiseIterator>> _origin_iters;
+    const Schema* _schema = nullptr;
+    const TabletSchema& _tablet_schema;
+    std::vector<uint32_t> _column_ids;
+    size_t _num_key_columns;
+    int _seq_col_idx;
+    KeysType _keys_type;
+    RowSourcesBuffer* _row_sources_buf;
+
+    std::vector<std::unique_ptr<VerticalMergeIteratorContext>> _ctxs;
+    VMergeHeap _merge_heap;
+    int _block_row_max = 0;
+    uint64_t _merged_rows = 0;
+};
+
+// Merge a value column group of inputs following the row sources generated by
+// VerticalHeapMergeIterator. For UNIQUE_KEYS, rows with agg flag are skipped, and
+// for AGG_KEYS, rows with agg flag are aggregated into the previous row.
+class VerticalMaskMergeIterator : public RowwiseIterator {
+public:
+    // VerticalMaskMergeIterator takes the ownership of input iterators, which must be
+    // in the same order as the inputs of VerticalHeapMergeIterator.
+    VerticalMaskMergeIterator(std::vector<std::unique_ptr<RowwiseIterator>> iters,
+                              const TabletSchema& tablet_schema,
+                              const std::vector<uint32_t>& column_ids,
+                              RowSourcesBuffer* row_sources_buf)
+            : _origin_iters(std::move(iters)),
+              _tablet_schema(tablet_schema),
+              _column_ids(column_ids),
+              _keys_type(tablet_schema.keys_type()),
+              _row_sources_buf(row_sources_buf) {}
+
+    ~VerticalMaskMergeIterator() override;
+
+    Status init(const StorageReadOptions& opts) override;
+
+    // Return EndOfFile when all row sources are consumed, the block is empty then
+    Status next_batch(Block* block) override;
+
+    const Schema& schema() const override { return *_schema; }
+
+private:
+    Status _init_agg_functions();
+    void _aggregate(Block* block);
+
+    std::vector<std::unique_ptr<RowwiseIterator>> _origin_iters;
+    const Schema* _schema = nullptr;
+    const TabletSchema& _tablet_schema;
+    std::vector<uint32_t> _column_ids;
+    KeysType _keys_type;
+    RowSourcesBuffer* _row_sources_buf;
+
+    std::vector<std::unique_ptr<VerticalMergeIteratorContext>> _ctxs;
+    int _block_row_max = 0;
+
+    // only used for AGG_KEYS
+    Block _agg_block;
+    // rows in _agg_block where aggregate groups start
+    std::vector<size_t> _agg_group_starts;
+    std::vector<AggregateFunctionPtr> _agg_functions;
+    std::vector<AggregateDataPtr> _agg_places;
+};
+
+} // namespace vectorized
+
+} // namespace doris
@@ -17,6 +17,7 @@
 
 #include "vec/runtime/vdata_stream_recvr.h"
 
+#include "common/config.h"
 #include "gen_cpp/data.pb.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/thread_context.h"
@@ -304,7 +305,9 @@ Status VDataStreamRecvr::create_merger(const std::vector<VExprContext*>& orderin
         child_block_suppliers.emplace_back(std::bind(std::mem_fn(&SenderQueue::get_batch),
                                                      _sender_queues[i], std::placeholders::_1));
     }
-    RETURN_IF_ERROR(_merger->prepare(child_block_suppliers));
+    bool parallel = config::parallel_merge_runs_per_thread > 0 &&
+                    _sender_queues.size() > config::parallel_merge_runs_per_thread;
+    RETURN_IF_ERROR(_merger->prepare(child_block_suppliers, parallel));
     return Status::OK();
 }
 
@@ -360,6 +363,12 @@ void VDataStreamRecvr::close() {
         return;
     }
     _is_closed = true;
+    if (_merger != nullptr) {
+        // the sub-mergers of a parallel merge read the sender queues in their own threads, they
+        // are woken up by the cancel and stopped before the queues are closed
+        cancel_stream();
+        _merger.reset();
+    }
     for (int i = 0; i < _sender_queues.size(); ++i) {
         _sender_queues[i]->close();
     }
@@ -368,7 +377,6 @@ void VDataStreamRecvr::close() {
     _mgr->deregister_recvr(fragment_instance_id(), dest_node_id());
     _mgr = nullptr;
 
-    _merger.reset();
     _block_mem_tracker->release(_block_mem_tracker->consumption());
 }
 
@@ -17,14 +17,19 @@
 
 #include "vec/runtime/vsorted_run_merger.h"
 
+#include <algorithm>
 #include <vector>
 
+#include "common/config.h"
 #include "runtime/descriptors.h"
 #include "runtime/row_batch.h"
 #include "runtime/sorter.h"
+#include "runtime/thread_context.h"
 #include "util/debug_util.h"
 #include "util/defer_op.h"
 #include "util/runtime_profile.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_context.h"
 
 using std::vector;
 
@@ -39,12 +44,43 @@ VSortedRunMerger::VSortedRunMerger(const std::vector<VExprContext*>& ordering_ex
           _nulls_first(nulls_first),
           _batch_size(batch_size),
           _limit(limit),
-          _offset(offset) {
+          _offset(offset),
+          _profile(profile) {
     _get_next_timer = ADD_TIMER(profile, "MergeGetNext");
     _get_next_block_timer = ADD_TIMER(profile, "MergeGetNextBlock");
 }
 
+VSortedRunMerger::~VSortedRunMerger() {
+    // the sub-mergers blocked on the input runs return after the runs are cancelled
+    for (auto& sub_merger : _sub_mergers) {
+        sub_merger->queue.shutdown();
+    }
+    if (_sub_merger_pool != nullptr) {
+        _sub_merger_pool->shutdown();
+    }
+    for (auto& sub_merger : _sub_mergers) {
+        Block* block = nullptr;
+        while (sub_merger->queue.blocking_get(&block)) {
+            delete block;
+        }
+    }
+}
+
 Status VSortedRunMerger::prepare(const vector<BlockSupplier>& input_runs, bool parallel) {
+    bool all_slot_refs = std::all_of(_ordering_expr.begin(), _ordering_expr.end(),
+                                     [](VExprContext* ctx) { return ctx->root()->is_slot_ref(); });
+    int runs_per_thread = config::parallel_merge_runs_per_thread;
+    if (parallel && all_slot_refs && runs_per_thread > 0 &&
+        input_runs.size() > static_cast<size_t>(runs_per_thread)) {
+        RETURN_IF_ERROR(_prepare_sub_mergers(input_runs, runs_per_thread));
+        std::vector<BlockSupplier> sub_merger_runs;
+        for (auto& sub_merger : _sub_mergers) {
+            sub_merger_runs.emplace_back(std::bind(&VSortedRunMerger::_get_sub_merger_block, this,
+                                                   sub_merger.get(), std::placeholders::_1));
+        }
+        return prepare(sub_merger_runs);
+    }
+
     for (const auto& supplier : input_runs) {
         _cursors.emplace_back(supplier, _ordering_expr, _is_asc_order, _nulls_first);
     }
@@ -65,6 +101,7 @@ Status VSortedRunMerger::prepare(const vector<BlockSupplier>& input_runs, bool p
 
 Status VSortedRunMerger::get_next(Block* output_block, bool* eos) {
     ScopedTimer<MonotonicStopWatch> timer(_get_next_timer);
+    RETURN_IF_ERROR(_sub_merger_status);
     // Only have one receive data queue of data, no need to do merge and
     // copy the data of block.
     // return the data in receive data directly
@@ -125,7 +162,7 @@ Status VSortedRunMerger::get_next(Block* output_block, bool* eos) {
 
         if (merged_rows == 0) {
             *eos = true;
-            return Status::OK();
+            return _sub_merger_status;
         }
 
         if (!mem_reuse) {
@@ -134,6 +171,10 @@ Status VSortedRunMerger::get_next(Block* output_block, bool* eos) {
         }
     }
 
+    // A sub-merger which failed looks like a finished run to the heap, so the rows merged
+    // after it failed are wrong, whether or not the merge has finished.
+    RETURN_IF_ERROR(_sub_merger_status);
+
     _num_rows_returned += output_block->rows();
     if (_limit != -1 && _num_rows_returned >= _limit) {
         output_block->set_num_rows(output_block->rows() - (_num_rows_returned - _limit));
@@ -142,6 +183,74 @@ Status VSortedRunMerger::get_next(Block* output_block, bool* eos) {
     return Status::OK();
 }
 
+Status VSortedRunMerger::_prepare_sub_mergers(const std::vector<BlockSupplier>& input_runs,
+                                              size_t runs_per_thread) {
+    DCHECK_GT(runs_per_thread, 0);
+    size_t num_sub_mergers = (input_runs.size() + runs_per_thread - 1) / runs_per_thread;
+    // the rows skipped by offset are skipped by this merger, the sub-mergers only stop early
+    int64_t sub_merger_limit = _limit == -1 ? -1 : _limit + static_cast<int64_t>(_offset);
+    for (size_t i = 0; i < num_sub_mergers; ++i) {
+        auto sub_merger = std::make_unique<SubMerger>();
+        size_t begin = input_runs.size() * i / num_sub_mergers;
+        size_t end = input_runs.size() * (i + 1) / num_sub_mergers;
+        sub_merger->input_runs.assign(input_runs.begin() + begin, input_runs.begin() + end);
+        sub_merger->merger.reset(new VSortedRunMerger(_ordering_expr, _is_asc_order, _nulls_first,
+                                                      _batch_size, sub_merger_limit, 0,
+                                                      _profile));
+        _sub_mergers.emplace_back(std::move(sub_merger));
+    }
+    _sub_merger_counter = ADD_COUNTER(_profile, "MergeSubMergers", TUnit::UNIT);
+    _sub_merger_wait_timer = ADD_TIMER(_profile, "MergeSubMergerWaitTime");
+    COUNTER_UPDATE(_sub_merger_counter, num_sub_mergers);
+
+    // every sub-merger has its own thread, as it blocks until its runs have data
+    _mem_tracker = tls_ctx()->_thread_mem_tracker_mgr->mem_tracker();
+    RETURN_IF_ERROR(ThreadPoolBuilder("SortedRunMerger")
+                            .set_min_threads(num_sub_mergers)
+                            .set_max_threads(num_sub_mergers)
+                            .build(&_sub_merger_pool));
+    for (auto& sub_merger : _sub_mergers) {
+        RETURN_IF_ERROR(_sub_merger_pool->submit_func(
+                std::bind(&VSortedRunMerger::_run_sub_merger, this, sub_merger.get())));
+    }
+    return Status::OK();
+}
+
+void VSortedRunMerger::_run_sub_merger(SubMerger* sub_merger) {
+    SCOPED_SWITCH_THREAD_LOCAL_MEM_TRACKER(_mem_tracker);
+    Status status = sub_merger->merger->prepare(sub_merger->input_runs);
+    bool eos = false;
+    while (status.ok() && !eos) {
+        auto block = std::make_unique<Block>();
+        status = sub_merger->merger->get_next(block.get(), &eos);
+        if (status.ok() && block->rows() > 0) {
+            if (!sub_merger->queue.blocking_put(block.get())) {
+                break;
+            }
+            block.release();
+        }
+    }
+    // the status is read after the queue is shut down
+    sub_merger->status = status;
+    sub_merger->queue.shutdown();
+}
+
+Status VSortedRunMerger::_get_sub_merger_block(SubMerger* sub_merger, Block** block) {
+    SCOPED_TIMER(_sub_merger_wait_timer);
+    Block* next_block = nullptr;
+    if (sub_merger->queue.blocking_get(&next_block)) {
+        sub_merger->current_block.reset(next_block);
+        *block = next_block;
+        return Status::OK();
+    }
+    sub_merger->current_block.reset();
+    *block = nullptr;
+    if (!sub_merger->status.ok() && _sub_merger_status.ok()) {
+        _sub_merger_status = sub_merger->status;
+    }
+    return sub_merger->status;
+}
+
 void VSortedRunMerger::next_heap(SortCursor& current) {
     if (!current->isLast()) {
         current->next();
@@ -20,11 +20,14 @@
 #include <queue>
 
 #include "common/object_pool.h"
+#include "util/blocking_queue.hpp"
+#include "util/threadpool.h"
 #include "util/tuple_row_compare.h"
 #include "vec/core/sort_cursor.h"
 
 namespace doris {
 
+class MemTracker;
 class RowBatch;
 class RuntimeProfile;
 
@@ -36,6 +39,10 @@ class Block;
 // rows in sorted order at the top of the heap.
 //
 // Merged block of rows are retrieved from VSortedRunMerger via calls to get_next().
+//
+// With many runs the heap driven by a single thread becomes the bottleneck, so a parallel
+// merger splits the runs into groups which are merged by sub-mergers in their own threads,
+// and merges the outputs of the sub-mergers.
 class VSortedRunMerger {
 public:
     // Function that returns the next block of rows from an input sorted run. The batch
@@ -46,11 +53,14 @@ public:
                      const size_t batch_size, int64_t limit, size_t offset,
                      RuntimeProfile* profile);
 
-    virtual ~VSortedRunMerger() = default;
+    virtual ~VSortedRunMerger();
 
     // Prepare this merger to merge and return rows from the sorted runs in 'input_runs'.
     // Retrieves the first batch from each run and sets up the binary heap implementing
     // the priority queue.
+    // If 'parallel' is true, every config::parallel_merge_runs_per_thread runs are merged by a
+    // sub-merger in its own thread, the suppliers of the runs must allow to be called from
+    // another thread and the ordering exprs must be slot refs.
     Status prepare(const std::vector<BlockSupplier>& input_runs, bool parallel = false);
 
     // Return the next block of sorted rows from this merger.
@@ -83,8 +93,39 @@ protected:
     RuntimeProfile::Counter* _get_next_block_timer;
 
 private:
+    struct SubMerger {
+        SubMerger() : queue(SUB_MERGER_QUEUE_SIZE) {}
+
+        std::vector<BlockSupplier> input_runs;
+        std::unique_ptr<VSortedRunMerger> merger;
+        // merged blocks not consumed yet, shut down when the sub-merger ends
+        BlockingQueue<Block*> queue;
+        // the block consumed by the parent merger now
+        std::unique_ptr<Block> current_block;
+        Status status;
+    };
+
+    static constexpr size_t SUB_MERGER_QUEUE_SIZE = 4;
+
     void next_heap(SortCursor& current);
     bool has_next_block(SortCursor& current);
+
+    // Every `runs_per_thread` input runs are merged by a sub-merger, `runs_per_thread` > 0
+    Status _prepare_sub_mergers(const std::vector<BlockSupplier>& input_runs,
+                                size_t runs_per_thread);
+    void _run_sub_merger(SubMerger* sub_merger);
+    Status _get_sub_merger_block(SubMerger* sub_merger, Block** block);
+
+    RuntimeProfile* _profile;
+    std::vector<std::unique_ptr<SubMerger>> _sub_mergers;
+    std::unique_ptr<ThreadPool> _sub_merger_pool;
+    std::shared_ptr<MemTracker> _mem_tracker;
+    // the first error of the sub-mergers seen by this merger
+    Status _sub_merger_status;
+
+    RuntimeProfile::Counter* _sub_merger_counter = nullptr;
+    // Times waiting for the blocks merged by the sub-mergers.
+    RuntimeProfile::Counter* _sub_merger_wait_timer = nullptr;
 };
 
 } // namespace vectorized
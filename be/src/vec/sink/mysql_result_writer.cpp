@@ -20,6 +20,7 @@
 #include "runtime/buffer_control_block.h"
 #include "runtime/large_int_value.h"
 #include "runtime/runtime_state.h"
+#include "util/jsonb.h"
 #include "vec/columns/column_nullable.h"
 #include "vec/columns/column_vector.h"
 #include "vec/common/assert_cast.h"
@@ -72,7 +73,7 @@ Status VMysqlResultWriter::_add_one_column(const ColumnPtr& column_ptr,
     MysqlRowBuffer _buffer;
     int buf_ret = 0;
 
-    if constexpr (type == TYPE_OBJECT || type == TYPE_VARCHAR) {
+    if constexpr (type == TYPE_OBJECT || type == TYPE_VARCHAR || type == TYPE_JSONB) {
         for (int i = 0; i < row_size; ++i) {
             if (0 != buf_ret) {
                 return Status::InternalError("pack mysql buffer failed.");
@@ -105,6 +106,11 @@ Status VMysqlResultWriter::_add_one_column(const ColumnPtr& column_ptr,
                     buf_ret = _buffer.push_string(string_val.data, string_val.size);
                 }
             }
+            if constexpr (type == TYPE_JSONB) {
+                const auto jsonb_val = column->get_data_at(i);
+                std::string json = JsonbDocument::to_json_string(jsonb_val.data, jsonb_val.size);
+                buf_ret = _buffer.push_string(json.data(), json.size());
+            }
 
             result->result_batch.rows[i].append(_buffer.buf(), _buffer.length());
         }
@@ -430,6 +436,14 @@ Status VMysqlResultWriter::append_block(Block& input_block) {
             }
             break;
         }
+        case TYPE_JSONB: {
+            if (type_ptr->is_nullable()) {
+                status = _add_one_column<PrimitiveType::TYPE_JSONB, true>(column_ptr, result);
+            } else {
+                status = _add_one_column<PrimitiveType::TYPE_JSONB, false>(column_ptr, result);
+            }
+            break;
+        }
         case TYPE_DECIMALV2: {
             if (type_ptr->is_nullable()) {
                 status = _add_one_column<PrimitiveType::TYPE_DECIMALV2, true>(column_ptr, result);
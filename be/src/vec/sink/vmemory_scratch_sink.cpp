@@ -0,0 +1,119 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "vec/sink/vmemory_scratch_sink.h"
+
+#include <arrow/memory_pool.h>
+#include <arrow/record_batch.h>
+#include <arrow/type.h>
+
+#include <sstream>
+
+#include "runtime/exec_env.h"
+#include "runtime/runtime_state.h"
+#include "util/arrow/block_convertor.h"
+#include "util/arrow/row_batch.h"
+#include "vec/core/block.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_context.h"
+
+namespace doris {
+namespace vectorized {
+
+VMemoryScratchSink::VMemoryScratchSink(const RowDescriptor& row_desc,
+                                       const std::vector<TExpr>& t_output_expr,
+                                       const TMemoryScratchSink& sink)
+        : _row_desc(row_desc), _t_output_expr(t_output_expr) {
+    _name = "VMemoryScratchSink";
+}
+
+VMemoryScratchSink::~VMemoryScratchSink() = default;
+
+Status VMemoryScratchSink::prepare_exprs(RuntimeState* state) {
+    // From the thrift expressions create the real exprs.
+    RETURN_IF_ERROR(
+            VExpr::create_expr_trees(state->obj_pool(), _t_output_expr, &_output_vexpr_ctxs));
+    // Prepare the exprs to run.
+    RETURN_IF_ERROR(VExpr::prepare(_output_vexpr_ctxs, state, _row_desc, _expr_mem_tracker));
+    // generate the arrow schema from the output exprs, which are the columns of sent blocks
+    std::vector<std::shared_ptr<arrow::Field>> fields;
+    for (auto ctx : _output_vexpr_ctxs) {
+        std::shared_ptr<arrow::DataType> type;
+        RETURN_IF_ERROR(convert_to_arrow_type(ctx->root()->type(), &type));
+        fields.push_back(arrow::field(ctx->root()->expr_name(), type, ctx->root()->is_nullable()));
+    }
+    _arrow_schema = arrow::schema(std::move(fields));
+    return Status::OK();
+}
+
+Status VMemoryScratchSink::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(DataSink::prepare(state));
+    // prepare output_expr
+    RETURN_IF_ERROR(prepare_exprs(state));
+    // create queue
+    TUniqueId fragment_instance_id = state->fragment_instance_id();
+    state->exec_env()->result_queue_mgr()->create_queue(fragment_instance_id, &_queue);
+    std::stringstream title;
+    title << "VMemoryScratchSink (frag_id=" << fragment_instance_id << ")";
+    // create profile
+    _profile = state->obj_pool()->add(new RuntimeProfile(title.str()));
+    _convert_timer = ADD_TIMER(_profile, "ConvertToArrowTime");
+    _queue_wait_timer = ADD_TIMER(_profile, "QueueWaitTime");
+
+    return Status::OK();
+}
+
+Status VMemoryScratchSink::send(RuntimeState* state, RowBatch* batch) {
+    return Status::NotSupported("Not Implemented VMemoryScratchSink::send scalar");
+}
+
+Status VMemoryScratchSink::send(RuntimeState* state, Block* block) {
+    if (nullptr == block || 0 == block->rows()) {
+        return Status::OK();
+    }
+    std::shared_ptr<arrow::RecordBatch> result;
+    {
+        SCOPED_TIMER(_convert_timer);
+        Status status;
+        auto output_block = VExprContext::get_output_block_after_execute_exprs(
+                _output_vexpr_ctxs, *block, status);
+        RETURN_IF_ERROR(status);
+        RETURN_IF_ERROR(convert_to_arrow_batch(output_block, _arrow_schema,
+                                               arrow::default_memory_pool(), &result));
+    }
+    SCOPED_TIMER(_queue_wait_timer);
+    _queue->blocking_put(result);
+    return Status::OK();
+}
+
+Status VMemoryScratchSink::open(RuntimeState* state) {
+    return VExpr::open(_output_vexpr_ctxs, state);
+}
+
+Status VMemoryScratchSink::close(RuntimeState* state, Status exec_status) {
+    if (_closed) {
+        return Status::OK();
+    }
+    // put sentinel
+    if (_queue != nullptr) {
+        _queue->blocking_put(nullptr);
+    }
+    VExpr::close(_output_vexpr_ctxs, state);
+    return DataSink::close(state, exec_status);
+}
+
+} // namespace vectorized
+} // namespace doris
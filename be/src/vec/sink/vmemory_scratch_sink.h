@@ -0,0 +1,85 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#pragma once
+
+#include "common/status.h"
+#include "exec/data_sink.h"
+#include "gen_cpp/DorisExternalService_types.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/result_queue_mgr.h"
+#include "util/runtime_profile.h"
+
+namespace arrow {
+
+class Schema;
+
+} // namespace arrow
+
+namespace doris {
+
+class RowBatch;
+class RuntimeState;
+class RuntimeProfile;
+
+namespace vectorized {
+
+class VExprContext;
+
+// Vectorized version of MemoryScratchSink, every block is converted to an
+// arrow RecordBatch column by column and pushed to the queue of this fragment
+// instance in ResultQueueMgr, where it is fetched by the external scan service.
+class VMemoryScratchSink : public DataSink {
+public:
+    VMemoryScratchSink(const RowDescriptor& row_desc, const std::vector<TExpr>& t_output_expr,
+                       const TMemoryScratchSink& sink);
+
+    ~VMemoryScratchSink() override;
+
+    Status prepare(RuntimeState* state) override;
+
+    Status open(RuntimeState* state) override;
+
+    Status send(RuntimeState* state, RowBatch* batch) override;
+
+    // send data in 'block' to this backend queue mgr
+    // Blocks until the converted block is pushed to the queue
+    Status send(RuntimeState* state, Block* block) override;
+
+    Status close(RuntimeState* state, Status exec_status) override;
+
+    RuntimeProfile* profile() override { return _profile; }
+
+private:
+    Status prepare_exprs(RuntimeState* state);
+
+    // Owned by the RuntimeState.
+    const RowDescriptor& _row_desc;
+    std::shared_ptr<arrow::Schema> _arrow_schema;
+
+    BlockQueueSharedPtr _queue;
+
+    RuntimeProfile* _profile = nullptr; // Allocated from _pool
+    RuntimeProfile::Counter* _convert_timer = nullptr;
+    RuntimeProfile::Counter* _queue_wait_timer = nullptr;
+
+    // Owned by the RuntimeState.
+    const std::vector<TExpr>& _t_output_expr;
+    std::vector<VExprContext*> _output_vexpr_ctxs;
+};
+
+} // namespace vectorized
+} // namespace doris
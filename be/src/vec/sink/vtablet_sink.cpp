@@ -135,51 +135,66 @@ Status VNodeChannel::open_wait() {
     return status;
 }
 
-Status VNodeChannel::add_row(const BlockRow& block_row, int64_t tablet_id) {
-    // If add_row() when _eos_is_produced==true, there must be sth wrong, we can only mark this channel as failed.
+Status VNodeChannel::add_rows(vectorized::Block* block, const std::vector<int>& row_idxs,
+                              const std::vector<int64_t>& tablet_ids) {
+    // If add_rows() when _eos_is_produced==true, there must be sth wrong, we can only mark this channel as failed.
     auto st = none_of({_cancelled, _eos_is_produced});
     if (!st.ok()) {
         if (_cancelled) {
             std::lock_guard<SpinLock> l(_cancel_msg_lock);
-            return Status::InternalError("add row failed. " + _cancel_msg);
+            return Status::InternalError("add rows failed. " + _cancel_msg);
         } else {
-            return st.clone_and_prepend("already stopped, can't add row. cancelled/eos: ");
+            return st.clone_and_prepend("already stopped, can't add rows. cancelled/eos: ");
         }
     }
 
-    // We use OlapTableSink mem_tracker which has the same ancestor of _plan node,
-    // so in the ideal case, mem limit is a matter for _plan node.
-    // But there is still some unfinished things, we do mem limit here temporarily.
-    // _cancelled may be set by rpc callback, and it's possible that _cancelled might be set in any of the steps below.
-    // It's fine to do a fake add_row() and return OK, because we will check _cancelled in next add_row() or mark_close().
-    while (!_cancelled &&
-           (_pending_batches_bytes > _max_pending_batches_bytes ||
-            _parent->_mem_tracker->any_limit_exceeded()) &&
-           _pending_batches_num > 0) {
-        SCOPED_ATOMIC_TIMER(&_mem_exceeded_block_ns);
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    }
-
-    _cur_mutable_block->add_row(block_row.first, block_row.second);
-    _cur_add_block_request.add_tablet_ids(tablet_id);
-
-    if (_cur_mutable_block->rows() == _batch_size) {
-        {
-            SCOPED_ATOMIC_TIMER(&_queue_push_lock_ns);
-            std::lock_guard<std::mutex> l(_pending_batches_lock);
-            //To simplify the add_row logic, postpone adding block into req until the time of sending req
-            _pending_batches_bytes += _cur_mutable_block->allocated_bytes();
-            _pending_blocks.emplace(std::move(_cur_mutable_block), _cur_add_block_request);
-            _pending_batches_num++;
+    size_t begin = 0;
+    while (begin < row_idxs.size()) {
+        // We use OlapTableSink mem_tracker which has the same ancestor of _plan node,
+        // so in the ideal case, mem limit is a matter for _plan node.
+        // But there is still some unfinished things, we do mem limit here temporarily.
+        // _cancelled may be set by rpc callback, and it's possible that _cancelled might be set in any of the steps below.
+        // It's fine to do a fake add_rows() and return OK, because we will check _cancelled in next add_rows() or mark_close().
+        while (!_cancelled &&
+               (_pending_batches_bytes > _max_pending_batches_bytes ||
+                _parent->_mem_tracker->any_limit_exceeded()) &&
+               _pending_batches_num > 0) {
+            SCOPED_ATOMIC_TIMER(&_mem_exceeded_block_ns);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
         }
 
-        _cur_mutable_block.reset(new vectorized::MutableBlock({_tuple_desc}));
-        _cur_add_block_request.clear_tablet_ids();
+        // gather as many rows as the current block can take, column by column
+        size_t length = std::min<size_t>(_batch_size - _cur_mutable_block->rows(),
+                                         row_idxs.size() - begin);
+        _cur_mutable_block->add_rows(block, row_idxs.data() + begin,
+                                     row_idxs.data() + begin + length);
+        for (size_t i = begin; i < begin + length; ++i) {
+            _cur_add_block_request.add_tablet_ids(tablet_ids[i]);
+        }
+        begin += length;
+        _try_push_pending_block();
     }
 
     return Status::OK();
 }
 
+void VNodeChannel::_try_push_pending_block() {
+    if (_cur_mutable_block->rows() < _batch_size) {
+        return;
+    }
+    {
+        SCOPED_ATOMIC_TIMER(&_queue_push_lock_ns);
+        std::lock_guard<std::mutex> l(_pending_batches_lock);
+        //To simplify the add_rows logic, postpone adding block into req until the time of sending req
+        _pending_batches_bytes += _cur_mutable_block->allocated_bytes();
+        _pending_blocks.emplace(std::move(_cur_mutable_block), _cur_add_block_request);
+        _pending_batches_num++;
+    }
+
+    _cur_mutable_block.reset(new vectorized::MutableBlock({_tuple_desc}));
+    _cur_add_block_request.clear_tablet_ids();
+}
+
 int VNodeChannel::try_send_and_fetch_status(RuntimeState* state,
                                             std::unique_ptr<ThreadPoolToken>& thread_pool_token) {
     auto st = none_of({_cancelled, _send_finished});
@@ -396,21 +411,20 @@ Status VOlapTableSink::send(RuntimeState* state, vectorized::Block* input_block)
         _convert_to_dest_desc_block(&block);
     }
 
-    BlockRow block_row;
     SCOPED_RAW_TIMER(&_send_data_ns);
     // This is just for passing compilation.
     bool stop_processing = false;
     if (findTabletMode == FindTabletMode::FIND_TABLET_EVERY_BATCH) {
         _partition_to_tablet_map.clear();
     }
+    // find the partition of every row first, nullptr for the filtered rows
+    std::vector<const VOlapTablePartition*> partitions(num_rows, nullptr);
     for (int i = 0; i < num_rows; ++i) {
         if (filtered_rows > 0 && _filter_bitmap.Get(i)) {
             continue;
         }
-        const VOlapTablePartition* partition = nullptr;
-        uint32_t tablet_index = 0;
-        block_row = {&block, i};
-        if (!_vpartition->find_partition(&block_row, &partition)) {
+        BlockRow block_row = {&block, i};
+        if (!_vpartition->find_partition(&block_row, &partitions[i])) {
             RETURN_IF_ERROR(state->append_error_msg_to_file(
                     []() -> std::string { return ""; },
                     [&]() -> std::string {
@@ -425,22 +439,46 @@ Status VOlapTableSink::send(RuntimeState* state, vectorized::Block* input_block)
             }
             continue;
         }
-        _partition_ids.emplace(partition->id);
-        if (findTabletMode != FindTabletMode::FIND_TABLET_EVERY_ROW) {
-            if (_partition_to_tablet_map.find(partition->id) == _partition_to_tablet_map.end()) {
-                tablet_index = _vpartition->find_tablet(&block_row, *partition);
-                _partition_to_tablet_map.emplace(partition->id, tablet_index);
+        _partition_ids.emplace(partitions[i]->id);
+    }
+
+    std::vector<uint32_t> tablet_indexes;
+    if (findTabletMode == FindTabletMode::FIND_TABLET_EVERY_ROW) {
+        _vpartition->find_tablets(&block, partitions, &tablet_indexes);
+    } else {
+        tablet_indexes.resize(num_rows, 0);
+        for (int i = 0; i < num_rows; ++i) {
+            if (partitions[i] == nullptr) {
+                continue;
+            }
+            auto it = _partition_to_tablet_map.find(partitions[i]->id);
+            if (it == _partition_to_tablet_map.end()) {
+                BlockRow block_row = {&block, i};
+                tablet_indexes[i] = _vpartition->find_tablet(&block_row, *partitions[i]);
+                _partition_to_tablet_map.emplace(partitions[i]->id, tablet_indexes[i]);
             } else {
-                tablet_index = _partition_to_tablet_map[partition->id];
+                tablet_indexes[i] = it->second;
             }
-        } else {
-            tablet_index = _vpartition->find_tablet(&block_row, *partition);
         }
-        for (int j = 0; j < partition->indexes.size(); ++j) {
-            int64_t tablet_id = partition->indexes[j].tablets[tablet_index];
-            _channels[j]->add_row(block_row, tablet_id);
-            _number_output_rows++;
+    }
+
+    // scatter the rows to the node channels of every index
+    std::vector<int> row_idxs;
+    std::vector<int64_t> tablet_ids;
+    row_idxs.reserve(num_rows);
+    tablet_ids.reserve(num_rows);
+    for (int j = 0; j < _channels.size(); ++j) {
+        row_idxs.clear();
+        tablet_ids.clear();
+        for (int i = 0; i < num_rows; ++i) {
+            if (partitions[i] == nullptr) {
+                continue;
+            }
+            row_idxs.push_back(i);
+            tablet_ids.push_back(partitions[i]->indexes[j].tablets[tablet_indexes[i]]);
         }
+        _channels[j]->add_rows(&block, row_idxs, tablet_ids);
+        _number_output_rows += row_idxs.size();
     }
 
     // check intolerable failure
@@ -38,7 +38,8 @@ public:
 
     Status open_wait() override;
 
-    Status add_row(const BlockRow& block_row, int64_t tablet_id) override;
+    Status add_rows(vectorized::Block* block, const std::vector<int>& row_idxs,
+                    const std::vector<int64_t>& tablet_ids) override;
 
     int try_send_and_fetch_status(RuntimeState* state,
                                   std::unique_ptr<ThreadPoolToken>& thread_pool_token) override;
@@ -56,6 +57,9 @@ protected:
     void _close_check() override;
 
 private:
+    // move the current block to the pending queue once it is full
+    void _try_push_pending_block();
+
     std::unique_ptr<vectorized::MutableBlock> _cur_mutable_block;
     PTabletWriterAddBlockRequest _cur_add_block_request;
 
@@ -17,10 +17,16 @@
 
 #include <gtest/gtest.h>
 
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
 #include "exec/decompressor.h"
 #include "exec/local_file_reader.h"
 #include "exec/plain_text_line_reader.h"
 #include "util/runtime_profile.h"
+#include "util/stopwatch.hpp"
 
 namespace doris {
 
@@ -290,4 +296,97 @@ TEST_F(PlainTextLineReaderUncompressedTest, uncompressed_test_empty) {
     EXPECT_TRUE(eof);
 }
 
+// write lines of random length, field i of line j has (i * 7 + j) % 23 bytes
+static std::string write_field_test_file(const std::string& name, int num_lines,
+                                         std::vector<std::string>* lines) {
+    std::string path = std::filesystem::temp_directory_path() / name;
+    std::ofstream out(path, std::ios::binary);
+    for (int j = 0; j < num_lines; ++j) {
+        std::string line;
+        int num_fields = j % 40;
+        for (int i = 0; i < num_fields; ++i) {
+            if (i > 0) {
+                line.push_back('|');
+            }
+            line.append((i * 7 + j) % 23, 'a' + i % 26);
+        }
+        out << line << "\n";
+        if (lines != nullptr) {
+            lines->push_back(std::move(line));
+        }
+    }
+    return path;
+}
+
+TEST_F(PlainTextLineReaderUncompressedTest, uncompressed_field_separator_positions) {
+    std::vector<std::string> lines;
+    auto path = write_field_test_file("plain_text_line_reader_field_pos.csv", 1000, &lines);
+    LocalFileReader file_reader(path, 0);
+    auto st = file_reader.open();
+    EXPECT_TRUE(st.ok());
+
+    PlainTextLineReader line_reader(&_profile, &file_reader, nullptr, -1, "\n", 1);
+    EXPECT_FALSE(line_reader.set_field_separator('\n'));
+    EXPECT_TRUE(line_reader.set_field_separator('|'));
+    const uint8_t* ptr;
+    size_t size;
+    bool eof;
+    for (const auto& line : lines) {
+        st = line_reader.read_line(&ptr, &size, &eof);
+        EXPECT_TRUE(st.ok());
+        EXPECT_FALSE(eof);
+        ASSERT_EQ(line, std::string((const char*)ptr, size));
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < line.size(); ++i) {
+            if (line[i] == '|') {
+                expected.push_back(i);
+            }
+        }
+        EXPECT_EQ(expected, line_reader.field_separator_positions());
+    }
+    st = line_reader.read_line(&ptr, &size, &eof);
+    EXPECT_TRUE(st.ok());
+    EXPECT_TRUE(eof);
+    std::filesystem::remove(path);
+}
+
+// Compare splitting lines by scanning them again with splitting by the positions found by the
+// line reader, run with --gtest_also_run_disabled_tests
+TEST_F(PlainTextLineReaderUncompressedTest, DISABLED_field_separator_positions_bench) {
+    auto path = write_field_test_file("plain_text_line_reader_field_pos_bench.csv", 2000000,
+                                      nullptr);
+    for (bool save_field_pos : {false, true}) {
+        LocalFileReader file_reader(path, 0);
+        EXPECT_TRUE(file_reader.open().ok());
+        PlainTextLineReader line_reader(&_profile, &file_reader, nullptr, -1, "\n", 1);
+        if (save_field_pos) {
+            line_reader.set_field_separator('|');
+        }
+        const uint8_t* ptr;
+        size_t size;
+        bool eof = false;
+        size_t num_fields = 0;
+        MonotonicStopWatch watch;
+        watch.start();
+        while (true) {
+            EXPECT_TRUE(line_reader.read_line(&ptr, &size, &eof).ok());
+            if (eof) {
+                break;
+            }
+            if (save_field_pos) {
+                num_fields += line_reader.field_separator_positions().size() + 1;
+            } else {
+                const uint8_t* end = ptr + size;
+                for (const uint8_t* p = ptr; p != nullptr; ++num_fields) {
+                    p = (const uint8_t*)memchr(p, '|', end - p);
+                    p = p == nullptr ? nullptr : p + 1;
+                }
+            }
+        }
+        LOG(INFO) << "save field pos: " << save_field_pos << ", fields: " << num_fields
+                  << ", cost: " << watch.elapsed_time() / 1000000 << "ms";
+    }
+    std::filesystem::remove(path);
+}
+
 } // end namespace doris
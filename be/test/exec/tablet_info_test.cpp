@@ -830,4 +830,73 @@ TEST_F(OlapTablePartitionParamTest, NodesInfo) {
     }
 }
 
+TEST_F(OlapTablePartitionParamTest, vec_find_tablets) {
+    TDescriptorTable t_desc_tbl;
+    auto t_schema = get_schema(&t_desc_tbl);
+    std::shared_ptr<OlapTableSchemaParam> schema(new OlapTableSchemaParam());
+    auto st = schema->init(t_schema);
+    EXPECT_TRUE(st.ok());
+
+    TOlapTablePartitionParam t_partition_param;
+    t_partition_param.db_id = 1;
+    t_partition_param.table_id = 2;
+    t_partition_param.version = 0;
+    t_partition_param.__set_distributed_columns({"c1", "c3"});
+    t_partition_param.partitions.resize(1);
+    t_partition_param.partitions[0].id = 10;
+    t_partition_param.partitions[0].num_buckets = 7;
+    t_partition_param.partitions[0].indexes.resize(2);
+    t_partition_param.partitions[0].indexes[0].index_id = 4;
+    t_partition_param.partitions[0].indexes[0].tablets = {21, 22, 23, 24, 25, 26, 27};
+    t_partition_param.partitions[0].indexes[1].index_id = 5;
+    t_partition_param.partitions[0].indexes[1].tablets = {31, 32, 33, 34, 35, 36, 37};
+
+    VOlapTablePartitionParam part(schema, t_partition_param);
+    st = part.init();
+    EXPECT_TRUE(st.ok());
+
+    vectorized::Block block;
+    for (auto slot : schema->tuple_desc()->slots()) {
+        block.insert({slot->get_empty_mutable_column(), slot->get_data_type_ptr(),
+                      slot->col_name()});
+    }
+    bool c1_nullable = schema->tuple_desc()->slots()[0]->is_nullable();
+    auto columns = block.mutate_columns();
+    for (int i = 0; i < 100; ++i) {
+        int32_t c1 = i * 31;
+        int64_t c2 = i;
+        std::string c3 = "str" + std::to_string(i);
+        if (c1_nullable && i % 10 == 0) {
+            columns[0]->insert_data(nullptr, 0);
+        } else {
+            columns[0]->insert_data(reinterpret_cast<const char*>(&c1), sizeof(c1));
+        }
+        columns[1]->insert_data(reinterpret_cast<const char*>(&c2), sizeof(c2));
+        columns[2]->insert_data(c3.data(), c3.size());
+    }
+    block.set_columns(std::move(columns));
+
+    std::vector<const VOlapTablePartition*> partitions(block.rows(), nullptr);
+    for (int i = 0; i < block.rows(); ++i) {
+        // every third row is skipped, as if it was filtered
+        if (i % 3 == 0) {
+            continue;
+        }
+        BlockRow block_row(&block, i);
+        EXPECT_TRUE(part.find_partition(&block_row, &partitions[i]));
+        EXPECT_EQ(10, partitions[i]->id);
+    }
+
+    std::vector<uint32_t> tablet_indexes;
+    part.find_tablets(&block, partitions, &tablet_indexes);
+    ASSERT_EQ(block.rows(), tablet_indexes.size());
+    for (int i = 0; i < block.rows(); ++i) {
+        if (partitions[i] == nullptr) {
+            continue;
+        }
+        BlockRow block_row(&block, i);
+        EXPECT_EQ(part.find_tablet(&block_row, *partitions[i]), tablet_indexes[i]);
+    }
+}
+
 } // namespace doris
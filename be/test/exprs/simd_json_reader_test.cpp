@@ -0,0 +1,172 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "exprs/simd_json_reader.h"
+
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "exprs/json_functions.h"
+
+namespace doris {
+
+class SimdJsonReaderTest : public testing::Test {
+public:
+    SimdJsonReaderTest() {}
+
+    static std::string to_json_pointer(const std::string& path) {
+        std::vector<JsonPath> parsed_paths;
+        JsonFunctions::parse_json_paths(path, &parsed_paths);
+        std::string pointer;
+        if (!SimdJsonReader::to_json_pointer(parsed_paths, &pointer)) {
+            return "UNSUPPORTED";
+        }
+        return pointer;
+    }
+
+    std::string find(const std::string& json, const std::string& path) {
+        simdjson::ondemand::value value;
+        auto error = _reader.find(json, to_json_pointer(path), &value);
+        if (error) {
+            return simdjson::error_message(error);
+        }
+        rapidjson::StringBuffer buf;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+        error = SimdJsonReader::write_value(value, &writer);
+        if (error) {
+            return simdjson::error_message(error);
+        }
+        return std::string(buf.GetString(), buf.GetSize());
+    }
+
+    // whether get_json_*() falls back to NULL for json, like rapidjson does
+    static bool rapidjson_parse_error(const std::string& json) {
+        rapidjson::Document document;
+        document.Parse(json.data(), json.size());
+        return document.HasParseError();
+    }
+
+protected:
+    SimdJsonReader _reader;
+};
+
+TEST_F(SimdJsonReaderTest, to_json_pointer) {
+    EXPECT_EQ("/k1", to_json_pointer("$.k1"));
+    EXPECT_EQ("/k1/k2/0", to_json_pointer("$.k1.k2[0]"));
+    EXPECT_EQ("/my.key/1", to_json_pointer("$.\"my.key\"[1]"));
+    EXPECT_EQ("/a~1b/c~0d", to_json_pointer("$.\"a/b\".c~d"));
+    EXPECT_EQ("/2", to_json_pointer("$.[2]"));
+
+    EXPECT_EQ("UNSUPPORTED", to_json_pointer("$"));
+    EXPECT_EQ("UNSUPPORTED", to_json_pointer("k1"));
+    EXPECT_EQ("UNSUPPORTED", to_json_pointer("$.k1[*]"));
+    EXPECT_EQ("UNSUPPORTED", to_json_pointer("$.k1.0"));
+}
+
+TEST_F(SimdJsonReaderTest, parse_number) {
+    SimdJsonNumber number;
+    EXPECT_TRUE(SimdJsonReader::parse_number("123 ", &number));
+    EXPECT_EQ(SimdJsonNumber::UINT64, number.type);
+    EXPECT_EQ(123, number.uint64_value);
+
+    EXPECT_TRUE(SimdJsonReader::parse_number("-9223372036854775808", &number));
+    EXPECT_EQ(SimdJsonNumber::INT64, number.type);
+    EXPECT_EQ(std::numeric_limits<int64_t>::min(), number.int64_value);
+
+    EXPECT_TRUE(SimdJsonReader::parse_number("18446744073709551616", &number));
+    EXPECT_EQ(SimdJsonNumber::DOUBLE, number.type);
+    EXPECT_DOUBLE_EQ(18446744073709551616.0, number.double_value);
+
+    EXPECT_TRUE(SimdJsonReader::parse_number("-1.5e2\n", &number));
+    EXPECT_EQ(SimdJsonNumber::DOUBLE, number.type);
+    EXPECT_DOUBLE_EQ(-150, number.double_value);
+
+    EXPECT_FALSE(SimdJsonReader::parse_number("", &number));
+}
+
+TEST_F(SimdJsonReaderTest, find) {
+    std::string json = R"({"k1": "v1", "k2": {"k3": [1, 2.50, true, null, "a\"b"]}, "k1": 3})";
+    EXPECT_EQ("\"v1\"", find(json, "$.k1"));
+    EXPECT_EQ(R"({"k3":[1,2.5,true,null,"a\"b"]})", find(json, "$.k2"));
+    EXPECT_EQ("2.5", find(json, "$.k2.k3[1]"));
+    EXPECT_EQ("null", find(json, "$.k2.k3[3]"));
+    EXPECT_EQ(simdjson::error_message(simdjson::NO_SUCH_FIELD), find(json, "$.k4"));
+    EXPECT_EQ(simdjson::error_message(simdjson::INDEX_OUT_OF_BOUNDS),
+              find(json, "$.k2.k3[5]"));
+    // reader is reused by the next json
+    EXPECT_EQ("-1", find(R"([{"k1": -1}])", "$.[0].k1"));
+}
+
+TEST_F(SimdJsonReaderTest, number_as_string) {
+    ASSERT_EQ(simdjson::SUCCESS, _reader.iterate(R"({"k1": [12345678901234567890123, 1.0]})"));
+    simdjson::ondemand::value value;
+    ASSERT_EQ(simdjson::SUCCESS, _reader.document().at_pointer("/k1").get(value));
+    rapidjson::StringBuffer buf;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+    ASSERT_EQ(simdjson::SUCCESS, SimdJsonReader::write_value(value, &writer, true));
+    EXPECT_EQ(R"(["12345678901234567890123","1.0"])", std::string(buf.GetString()));
+}
+
+TEST_F(SimdJsonReaderTest, malformed) {
+    std::vector<std::string> malformed_jsons = {
+            // trailing garbage
+            R"({"k1": 1} x)",
+            R"({"k1": 1} {"k1": 2})",
+            R"([1, 2] 3)",
+            R"(123abc)",
+            // broken values after the matched one
+            R"({"k1": 1, "k2": tru})",
+            R"({"k1": 1, "k2": nul})",
+            R"({"k1": 1, "k2": [1, 2.5.3]})",
+            R"({"k1": 1, "k2": {"k3" 1}})",
+            R"({"k1": 1 "k2": 2})",
+            R"({"k1": 1,})",
+            // truncated
+            R"({"k1": 1, "k2": [1, 2)",
+            R"({"k1": 1, "k2": {"k3": )",
+            R"({"k1": 1, "k2": "abc)",
+            R"({"k1": 1)"};
+    for (const auto& json : malformed_jsons) {
+        EXPECT_TRUE(rapidjson_parse_error(json)) << json;
+        simdjson::ondemand::value value;
+        EXPECT_NE(simdjson::SUCCESS, _reader.find(json, "/k1", &value)) << json;
+    }
+
+    std::vector<std::string> valid_jsons = {R"({"k1": 1, "k2": [1, {"k3": null}, "a"]} )",
+                                            R"( [1, 2.5e3, true, false, null] )", R"("abc")",
+                                            R"(-12.5)", R"(null)", R"({})"};
+    for (const auto& json : valid_jsons) {
+        EXPECT_FALSE(rapidjson_parse_error(json)) << json;
+        ASSERT_EQ(simdjson::SUCCESS, _reader.iterate(json)) << json;
+        EXPECT_EQ(simdjson::SUCCESS, _reader.validate()) << json;
+    }
+
+    // the document can still be read after validated
+    ASSERT_EQ(simdjson::SUCCESS, _reader.iterate(R"({"k1": [1, 2]})"));
+    ASSERT_EQ(simdjson::SUCCESS, _reader.validate());
+    simdjson::ondemand::value value;
+    ASSERT_EQ(simdjson::SUCCESS, _reader.document().at_pointer("/k1/1").get(value));
+    int64_t i = 0;
+    ASSERT_EQ(simdjson::SUCCESS, value.get_int64().get(i));
+    EXPECT_EQ(2, i);
+}
+
+} // namespace doris
@@ -19,10 +19,14 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <memory>
+#include <thread>
 #include <vector>
 
 #include "testutil/test_util.h"
 #include "util/logging.h"
+#include "util/stopwatch.hpp"
 
 using namespace doris;
 using namespace std;
@@ -355,6 +359,127 @@ TEST_F(CacheTest, SimpleBenchmark) {
     }
 }
 
+static bool lookup_LRUCache(LRUCache& cache, const CacheKey& key) {
+    uint32_t hash = key.hash(key.data(), key.size(), 0);
+    Cache::Handle* handle = cache.lookup(key, hash);
+    cache.release(handle);
+    return handle != nullptr;
+}
+
+TEST_F(CacheTest, TwoQueueScanResistance) {
+    LRUCache cache(LRUCacheType::NUMBER, CacheEvictionPolicy::TWO_QUEUE);
+    cache.set_capacity(10);
+
+    insert_LRUCache(cache, CacheKey("hot"), 1, CachePriority::NORMAL);
+    insert_LRUCache(cache, CacheKey("cold"), 2, CachePriority::NORMAL);
+    insert_LRUCache(cache, CacheKey("durable"), 3, CachePriority::DURABLE);
+    EXPECT_TRUE(lookup_LRUCache(cache, CacheKey("hot")));
+
+    // every entry of the scan is only touched once, so only the probation queue is washed out
+    for (int i = 0; i < 100; ++i) {
+        insert_LRUCache(cache, CacheKey {"scan" + std::to_string(i)}, i, CachePriority::NORMAL);
+    }
+    EXPECT_EQ(10, cache.get_usage());
+    EXPECT_EQ(1, cache.get_protected_usage());
+    EXPECT_TRUE(lookup_LRUCache(cache, CacheKey("hot")));
+    EXPECT_TRUE(lookup_LRUCache(cache, CacheKey("durable")));
+    EXPECT_FALSE(lookup_LRUCache(cache, CacheKey("cold")));
+    EXPECT_FALSE(lookup_LRUCache(cache, CacheKey("scan0")));
+    EXPECT_TRUE(lookup_LRUCache(cache, CacheKey("scan99")));
+    EXPECT_EQ(6, cache.get_lookup_count());
+    EXPECT_EQ(4, cache.get_hit_count());
+
+    // protected queue is limited, the oldest protected entries are demoted
+    for (int i = 92; i < 100; ++i) {
+        EXPECT_TRUE(lookup_LRUCache(cache, CacheKey {"scan" + std::to_string(i)}));
+    }
+    insert_LRUCache(cache, CacheKey("new"), 0, CachePriority::NORMAL);
+    EXPECT_EQ(10, cache.get_usage());
+    EXPECT_LE(cache.get_protected_usage(), 8);
+
+    cache.prune();
+    EXPECT_EQ(0, cache.get_usage());
+    EXPECT_EQ(0, cache.get_protected_usage());
+}
+
+TEST_F(CacheTest, TwoQueuePinnedEntries) {
+    _deleted_keys.clear();
+    LRUCache cache(LRUCacheType::NUMBER, CacheEvictionPolicy::TWO_QUEUE);
+    cache.set_capacity(2);
+
+    std::string result;
+    CacheKey key = EncodeKey(&result, 100);
+    uint32_t hash = key.hash(key.data(), key.size(), 0);
+    Cache::Handle* h1 = cache.insert(key, hash, EncodeValue(101), 1, &CacheTest::Deleter);
+    Cache::Handle* h2 = cache.lookup(key, hash);
+    ASSERT_EQ(h1, h2);
+
+    // pinned entry can't be evicted or pruned
+    for (int i = 0; i < 10; ++i) {
+        std::string buf;
+        CacheKey k = EncodeKey(&buf, 200 + i);
+        cache.release(cache.insert(k, k.hash(k.data(), k.size(), 0), EncodeValue(201 + i), 1,
+                                   &CacheTest::Deleter));
+    }
+    auto pred = [](const void* value) -> bool { return DecodeValue((void*)value) == 101; };
+    EXPECT_EQ(0, cache.prune_if(pred));
+    EXPECT_EQ(h1, cache.lookup(key, hash));
+    cache.release(h1);
+
+    // erased entry is removed from cache at once, and freed after the last release
+    _deleted_keys.clear();
+    cache.erase(key, hash);
+    EXPECT_EQ(1, cache.get_usage());
+    EXPECT_EQ(nullptr, cache.lookup(key, hash));
+    cache.release(h2);
+    EXPECT_EQ(0, _deleted_keys.size());
+    cache.release(h1);
+    ASSERT_EQ(1, _deleted_keys.size());
+    EXPECT_EQ(100, _deleted_keys[0]);
+}
+
+// Compare lookup throughput of the two policies when many threads hit the same cache.
+TEST_F(CacheTest, ConcurrentLookupBenchmark) {
+    const int num_threads = 64;
+    const int num_keys = 1024;
+    const int num_lookups = LOOP_LESS_OR_MORE(1000, 200000);
+    for (auto policy : {CacheEvictionPolicy::LRU, CacheEvictionPolicy::TWO_QUEUE}) {
+        std::unique_ptr<Cache> cache(new_lru_cache("bench", num_keys * 2, LRUCacheType::NUMBER,
+                                                   16, policy));
+        std::vector<std::string> keys(num_keys);
+        for (int i = 0; i < num_keys; ++i) {
+            EncodeKey(&keys[i], i);
+            cache->release(cache->insert(keys[i], EncodeValue(i), 1, &deleter));
+        }
+
+        std::atomic<int64_t> hits {0};
+        MonotonicStopWatch watch;
+        watch.start();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&, t]() {
+                int64_t local_hits = 0;
+                for (int i = 0; i < num_lookups; ++i) {
+                    Cache::Handle* handle = cache->lookup(keys[(i * 7 + t) % num_keys]);
+                    if (handle != nullptr) {
+                        ++local_hits;
+                        cache->release(handle);
+                    }
+                }
+                hits += local_hits;
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        int64_t elapsed_ns = std::max<int64_t>(watch.elapsed_time(), 1);
+        EXPECT_EQ((int64_t)num_threads * num_lookups, hits.load());
+        LOG(INFO) << (policy == CacheEvictionPolicy::LRU ? "LRU" : "TWO_QUEUE") << " policy, "
+                  << num_threads << " threads, lookups per second: "
+                  << hits.load() * 1000000000L / elapsed_ns;
+    }
+}
+
 TEST(CacheHandleTest, HandleTableTest) {
     HandleTable ht;
 
@@ -0,0 +1,306 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/config.h"
+#include "gen_cpp/AgentService_types.h"
+#include "olap/compaction.h"
+#include "olap/row_block.h"
+#include "olap/row_cursor.h"
+#include "olap/rowset/rowset_reader_context.h"
+#include "olap/rowset/rowset_writer.h"
+#include "olap/storage_engine.h"
+#include "olap/tablet.h"
+#include "olap/tablet_manager.h"
+#include "runtime/exec_env.h"
+#include "runtime/mem_pool.h"
+#include "util/file_utils.h"
+
+namespace doris {
+
+static const uint32_t MAX_PATH_LEN = 1024;
+
+static StorageEngine* k_engine = nullptr;
+
+// Compacts the given rowsets of a tablet as a cumulative compaction.
+class TestCompaction : public Compaction {
+public:
+    TestCompaction(TabletSharedPtr tablet, std::vector<RowsetSharedPtr> input_rowsets)
+            : Compaction(tablet, "TestCompaction") {
+        _input_rowsets = std::move(input_rowsets);
+    }
+
+    Status prepare_compact() override { return Status::OK(); }
+    Status execute_compact_impl() override { return do_compaction(0); }
+
+    using Compaction::should_ordered_data_compaction;
+
+    RowsetSharedPtr output_rowset() const { return _output_rowset; }
+
+protected:
+    Status pick_rowsets_to_compact() override { return Status::OK(); }
+    std::string compaction_name() const override { return "test compaction"; }
+    ReaderType compaction_type() const override {
+        return ReaderType::READER_CUMULATIVE_COMPACTION;
+    }
+};
+
+class OrderedDataCompactionTest : public testing::Test {
+public:
+    static void SetUpTestSuite() {
+        char buffer[MAX_PATH_LEN];
+        EXPECT_NE(getcwd(buffer, MAX_PATH_LEN), nullptr);
+        config::storage_root_path = std::string(buffer) + "/data_test";
+        FileUtils::remove_all(config::storage_root_path);
+        FileUtils::create_dir(config::storage_root_path);
+        std::vector<StorePath> paths;
+        paths.emplace_back(config::storage_root_path, -1);
+
+        EngineOptions options;
+        options.store_paths = paths;
+        Status s = StorageEngine::open(options, &k_engine);
+        EXPECT_TRUE(s.ok()) << s.to_string();
+        ExecEnv::GetInstance()->set_storage_engine(k_engine);
+        // no background threads, so the rowsets are only compacted by the tests
+    }
+
+    static void TearDownTestSuite() {
+        if (k_engine != nullptr) {
+            k_engine->stop();
+            delete k_engine;
+            k_engine = nullptr;
+        }
+        FileUtils::remove_all(config::storage_root_path);
+    }
+
+protected:
+    void SetUp() override {
+        _enable_ordered_data_compaction = config::enable_ordered_data_compaction;
+        _min_segment_size = config::ordered_data_compaction_min_segment_size;
+        config::enable_ordered_data_compaction = true;
+        // the segments written by the tests are tiny
+        config::ordered_data_compaction_min_segment_size = 0;
+    }
+
+    void TearDown() override {
+        config::enable_ordered_data_compaction = _enable_ordered_data_compaction;
+        config::ordered_data_compaction_min_segment_size = _min_segment_size;
+    }
+
+    // (k1 int, v1 int) duplicate key (k1)
+    static TabletSharedPtr create_tablet(int64_t tablet_id) {
+        TCreateTabletReq request;
+        request.tablet_id = tablet_id;
+        request.__set_version(1);
+        request.tablet_schema.schema_hash = 1111;
+        request.tablet_schema.short_key_column_count = 1;
+        request.tablet_schema.keys_type = TKeysType::DUP_KEYS;
+        request.tablet_schema.storage_type = TStorageType::COLUMN;
+        request.__set_storage_format(TStorageFormat::V2);
+
+        TColumn k1;
+        k1.column_name = "k1";
+        k1.__set_is_key(true);
+        k1.column_type.type = TPrimitiveType::INT;
+        request.tablet_schema.columns.push_back(k1);
+
+        TColumn v1;
+        v1.column_name = "v1";
+        v1.__set_is_key(false);
+        v1.column_type.type = TPrimitiveType::INT;
+        v1.__set_aggregation_type(TAggregationType::NONE);
+        request.tablet_schema.columns.push_back(v1);
+
+        Status s = k_engine->tablet_manager()->create_tablet(request, k_engine->get_stores());
+        EXPECT_TRUE(s.ok()) << s.to_string();
+        return k_engine->tablet_manager()->get_tablet(tablet_id);
+    }
+
+    // Writes a rowset of the given version, every [begin, end) of `segments` is a segment with
+    // the keys from begin to end - 1, the value of a row is 10 times its key.
+    static RowsetSharedPtr write_rowset(const TabletSharedPtr& tablet, int64_t version,
+                                        const std::vector<std::pair<int32_t, int32_t>>& segments) {
+        std::unique_ptr<RowsetWriter> writer;
+        Status s = tablet->create_rowset_writer(Version(version, version), VISIBLE,
+                                                NONOVERLAPPING, &writer);
+        EXPECT_TRUE(s.ok()) << s.to_string();
+
+        RowCursor row;
+        EXPECT_TRUE(row.init(tablet->tablet_schema()).ok());
+        MemPool mem_pool("OrderedDataCompactionTest");
+        for (auto [begin, end] : segments) {
+            for (int32_t key = begin; key < end; ++key) {
+                int32_t value = key * 10;
+                row.set_field_content(0, reinterpret_cast<char*>(&key), &mem_pool);
+                row.set_field_content(1, reinterpret_cast<char*>(&value), &mem_pool);
+                EXPECT_TRUE(writer->add_row(row).ok());
+            }
+            EXPECT_TRUE(writer->flush().ok());
+        }
+        RowsetSharedPtr rowset = writer->build();
+        EXPECT_TRUE(rowset != nullptr);
+        EXPECT_EQ(static_cast<int64_t>(segments.size()), rowset->num_segments());
+        EXPECT_TRUE(tablet->add_rowset(rowset).ok());
+        return rowset;
+    }
+
+    // the keys of the rowset in the order they are stored, the values are checked
+    std::vector<int32_t> read_keys(const TabletSharedPtr& tablet, const RowsetSharedPtr& rowset) {
+        std::vector<uint32_t> return_columns = {0, 1};
+        RowsetReaderContext reader_context;
+        reader_context.tablet_schema = &tablet->tablet_schema();
+        // read the segments one by one
+        reader_context.need_ordered_result = false;
+        reader_context.return_columns = &return_columns;
+        reader_context.seek_columns = &return_columns;
+        reader_context.stats = &_stats;
+
+        RowsetReaderSharedPtr reader;
+        EXPECT_TRUE(rowset->create_reader(&reader).ok());
+        EXPECT_TRUE(reader->init(&reader_context).ok());
+
+        std::vector<int32_t> keys;
+        RowBlock* block = nullptr;
+        while (reader->next_block(&block).ok() && block != nullptr) {
+            for (int i = 0; i < block->row_num(); ++i) {
+                int32_t key = *reinterpret_cast<int32_t*>(block->field_ptr(i, 0) + 1);
+                int32_t value = *reinterpret_cast<int32_t*>(block->field_ptr(i, 1) + 1);
+                EXPECT_EQ(key * 10, value);
+                keys.push_back(key);
+            }
+        }
+        return keys;
+    }
+
+    OlapReaderStatistics _stats;
+    bool _enable_ordered_data_compaction;
+    int64_t _min_segment_size;
+};
+
+TEST_F(OrderedDataCompactionTest, LinkOrderedRowsets) {
+    TabletSharedPtr tablet = create_tablet(10001);
+    ASSERT_TRUE(tablet != nullptr);
+    RowsetSharedPtr rs2 = write_rowset(tablet, 2, {{0, 100}, {100, 200}});
+    // a rowset without segments is skipped
+    RowsetSharedPtr rs3 = write_rowset(tablet, 3, {});
+    RowsetSharedPtr rs4 = write_rowset(tablet, 4, {{200, 300}});
+
+    TestCompaction compaction(tablet, {rs2, rs3, rs4});
+    EXPECT_TRUE(compaction.should_ordered_data_compaction());
+    Status s = compaction.execute_compact_impl();
+    ASSERT_TRUE(s.ok()) << s.to_string();
+
+    // the output rowset has the segments of the input rowsets, in the same order
+    RowsetSharedPtr output = compaction.output_rowset();
+    ASSERT_TRUE(output != nullptr);
+    EXPECT_EQ(Version(2, 4), output->version());
+    EXPECT_EQ(300, output->num_rows());
+    EXPECT_EQ(3, output->num_segments());
+    std::vector<KeyBoundsPB> input_key_bounds;
+    for (auto& rowset : {rs2, rs4}) {
+        for (auto& key_bounds : rowset->rowset_meta()->segments_key_bounds()) {
+            input_key_bounds.push_back(key_bounds);
+        }
+    }
+    const auto& output_key_bounds = output->rowset_meta()->segments_key_bounds();
+    ASSERT_EQ(input_key_bounds.size(), output_key_bounds.size());
+    for (int i = 0; i < output_key_bounds.size(); ++i) {
+        EXPECT_EQ(input_key_bounds[i].min_key(), output_key_bounds.Get(i).min_key());
+        EXPECT_EQ(input_key_bounds[i].max_key(), output_key_bounds.Get(i).max_key());
+    }
+
+    std::vector<int32_t> keys = read_keys(tablet, output);
+    ASSERT_EQ(300, keys.size());
+    for (int32_t i = 0; i < 300; ++i) {
+        EXPECT_EQ(i, keys[i]);
+    }
+    // the input rowsets are replaced by the output rowset
+    std::shared_lock rdlock(tablet->get_header_lock());
+    EXPECT_TRUE(tablet->get_rowset_by_version(Version(2, 4)) != nullptr);
+    EXPECT_TRUE(tablet->get_rowset_by_version(Version(2, 2)) == nullptr);
+}
+
+TEST_F(OrderedDataCompactionTest, MergeOverlappingRowsets) {
+    TabletSharedPtr tablet = create_tablet(10002);
+    ASSERT_TRUE(tablet != nullptr);
+    RowsetSharedPtr rs2 = write_rowset(tablet, 2, {{0, 100}});
+    RowsetSharedPtr rs3 = write_rowset(tablet, 3, {{50, 150}});
+
+    TestCompaction compaction(tablet, {rs2, rs3});
+    EXPECT_FALSE(compaction.should_ordered_data_compaction());
+    Status s = compaction.execute_compact_impl();
+    ASSERT_TRUE(s.ok()) << s.to_string();
+
+    // the rows are merged into one sorted segment, no rows are merged for DUP_KEYS
+    RowsetSharedPtr output = compaction.output_rowset();
+    ASSERT_TRUE(output != nullptr);
+    EXPECT_EQ(Version(2, 3), output->version());
+    EXPECT_EQ(200, output->num_rows());
+    EXPECT_EQ(1, output->num_segments());
+    const auto& output_key_bounds = output->rowset_meta()->segments_key_bounds();
+    ASSERT_EQ(1, output_key_bounds.size());
+    EXPECT_EQ(rs2->rowset_meta()->segments_key_bounds().Get(0).min_key(),
+              output_key_bounds.Get(0).min_key());
+    EXPECT_EQ(rs3->rowset_meta()->segments_key_bounds().Get(0).max_key(),
+              output_key_bounds.Get(0).max_key());
+
+    std::vector<int32_t> expected;
+    for (int32_t i = 0; i < 150; ++i) {
+        expected.push_back(i);
+        if (i >= 50 && i < 100) {
+            expected.push_back(i);
+        }
+    }
+    EXPECT_EQ(expected, read_keys(tablet, output));
+}
+
+TEST_F(OrderedDataCompactionTest, NotOrderedDataCompaction) {
+    TabletSharedPtr tablet = create_tablet(10003);
+    ASSERT_TRUE(tablet != nullptr);
+    RowsetSharedPtr rs2 = write_rowset(tablet, 2, {{0, 100}});
+    RowsetSharedPtr rs3 = write_rowset(tablet, 3, {{100, 200}});
+    {
+        TestCompaction compaction(tablet, {rs2, rs3});
+        EXPECT_TRUE(compaction.should_ordered_data_compaction());
+    }
+
+    // the segments of the input rowsets are too small
+    config::ordered_data_compaction_min_segment_size = 1L << 40;
+    {
+        TestCompaction compaction(tablet, {rs2, rs3});
+        EXPECT_FALSE(compaction.should_ordered_data_compaction());
+    }
+    config::ordered_data_compaction_min_segment_size = 0;
+
+    // an input rowset has a delete predicate
+    DeletePredicatePB delete_predicate;
+    delete_predicate.set_version(3);
+    delete_predicate.add_sub_predicates("k1>150");
+    rs3->rowset_meta()->set_delete_predicate(delete_predicate);
+    {
+        TestCompaction compaction(tablet, {rs2, rs3});
+        EXPECT_FALSE(compaction.should_ordered_data_compaction());
+    }
+}
+
+} // namespace doris
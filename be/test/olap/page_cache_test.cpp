@@ -32,6 +32,7 @@ public:
 // All cache space is allocated to data pages
 TEST(StoragePageCacheTest, data_page_only) {
     StoragePageCache cache(kNumShards * 2048, 0, kNumShards);
+    EXPECT_FALSE(cache.is_compressed_cache_available());
 
     StoragePageCache::CacheKey key("abc", 0);
     StoragePageCache::CacheKey memory_key("mem", 0);
@@ -245,4 +246,96 @@ TEST(StoragePageCacheTest, mixed_pages) {
     }
 }
 
+// A large scan can't evict hot data pages with scan resistant policy
+TEST(StoragePageCacheTest, data_page_scan_resistance) {
+    StoragePageCache cache(16 * 2048, 0, 1, CacheEvictionPolicy::TWO_QUEUE);
+
+    StoragePageCache::CacheKey hot_key("hot", 0);
+    StoragePageCache::CacheKey cold_key("cold", 0);
+    segment_v2::PageTypePB page_type = segment_v2::DATA_PAGE;
+
+    {
+        PageCacheHandle handle;
+        cache.insert(hot_key, Slice(new char[1024], 1024), &handle, page_type, false);
+        cache.insert(cold_key, Slice(new char[1024], 1024), &handle, page_type, false);
+        EXPECT_TRUE(cache.lookup(hot_key, &handle, page_type));
+        EXPECT_FALSE(cache.is_cache_available(segment_v2::INDEX_PAGE));
+    }
+
+    // every page of the scan is read only once
+    for (int i = 0; i < 10 * 16; ++i) {
+        StoragePageCache::CacheKey key("scan", i);
+        PageCacheHandle handle;
+        cache.insert(key, Slice(new char[1024], 1024), &handle, page_type, false);
+    }
+
+    {
+        PageCacheHandle handle;
+        EXPECT_TRUE(cache.lookup(hot_key, &handle, page_type));
+        EXPECT_FALSE(cache.lookup(cold_key, &handle, page_type));
+    }
+}
+
+TEST(StoragePageCacheTest, compressed_data_pages) {
+    StoragePageCache cache(kNumShards * 2048 * 2, 0, kNumShards, CacheEvictionPolicy::LRU, 50);
+    EXPECT_TRUE(cache.is_compressed_cache_available());
+    EXPECT_TRUE(cache.is_cache_available(segment_v2::DATA_PAGE));
+    EXPECT_FALSE(cache.is_cache_available(segment_v2::INDEX_PAGE));
+
+    StoragePageCache::CacheKey key("abc", 0);
+    char* buf = new char[1024];
+    cache.insert_compressed(key, Slice(buf, 1024));
+
+    {
+        PageCacheHandle handle;
+        EXPECT_TRUE(cache.lookup_compressed(key, &handle));
+        EXPECT_EQ(buf, handle.data().data);
+        EXPECT_EQ(1024, handle.data().size);
+        // two tiers are independent
+        EXPECT_FALSE(cache.lookup(key, &handle, segment_v2::DATA_PAGE));
+    }
+
+    // promote to decompressed tier
+    cache.erase_compressed(key);
+    {
+        PageCacheHandle handle;
+        EXPECT_FALSE(cache.lookup_compressed(key, &handle));
+        cache.insert(key, Slice(new char[2048], 2048), &handle, segment_v2::DATA_PAGE, false);
+        EXPECT_TRUE(cache.lookup(key, &handle, segment_v2::DATA_PAGE));
+    }
+}
+
+TEST(StoragePageCacheTest, key_index_pages) {
+    {
+        // key index pages are cached with the other index pages by default
+        StoragePageCache cache(kNumShards * 2048, 100, kNumShards);
+        StoragePageCache::CacheKey key("abc", 0);
+        PageCacheHandle handle;
+        cache.insert(key, Slice(new char[1024], 1024), &handle, segment_v2::SHORT_KEY_PAGE);
+        EXPECT_TRUE(cache.lookup(key, &handle, segment_v2::INDEX_PAGE));
+    }
+    {
+        StoragePageCache cache(kNumShards * 2048 * 2, 100, kNumShards, CacheEvictionPolicy::LRU, 0,
+                               50);
+        EXPECT_TRUE(cache.is_cache_available(segment_v2::SHORT_KEY_PAGE));
+        EXPECT_TRUE(cache.is_cache_available(segment_v2::KEY_BLOOM_FILTER_PAGE));
+
+        StoragePageCache::CacheKey key("abc", 0);
+        {
+            PageCacheHandle handle;
+            cache.insert(key, Slice(new char[1024], 1024), &handle, segment_v2::SHORT_KEY_PAGE);
+            EXPECT_TRUE(cache.lookup(key, &handle, segment_v2::KEY_BLOOM_FILTER_PAGE));
+            EXPECT_FALSE(cache.lookup(key, &handle, segment_v2::INDEX_PAGE));
+        }
+        // other index pages don't evict the key index pages
+        for (int i = 1; i <= 1024; ++i) {
+            StoragePageCache::CacheKey index_key("abc", i);
+            PageCacheHandle handle;
+            cache.insert(index_key, Slice(new char[1024], 1024), &handle, segment_v2::INDEX_PAGE);
+        }
+        PageCacheHandle handle;
+        EXPECT_TRUE(cache.lookup(key, &handle, segment_v2::SHORT_KEY_PAGE));
+    }
+}
+
 } // namespace doris
@@ -36,6 +36,7 @@
 #include "runtime/mem_tracker.h"
 #include "util/file_utils.h"
 #include "util/slice.h"
+#include "vec/core/block.h"
 
 using std::string;
 
@@ -204,6 +205,21 @@ TEST_F(BetaRowsetTest, BasicFunctionTest) {
         EXPECT_TRUE(rowset != nullptr);
         EXPECT_EQ(num_segments, rowset->rowset_meta()->num_segments());
         EXPECT_EQ(num_segments * rows_per_segment, rowset->rowset_meta()->num_rows());
+
+        // key bounds of every segment are recorded, segment "i" has keys from k1 = i
+        // to k1 = (rows_per_segment - 1) * 10 + i, so segments overlap with each other
+        EXPECT_TRUE(rowset->rowset_meta()->has_segments_key_bounds());
+        const auto& segments_key_bounds = rowset->rowset_meta()->segments_key_bounds();
+        EXPECT_EQ(num_segments, segments_key_bounds.size());
+        for (int i = 0; i < num_segments; ++i) {
+            EXPECT_LT(segments_key_bounds.Get(i).min_key(), segments_key_bounds.Get(i).max_key());
+            if (i > 0) {
+                EXPECT_LT(segments_key_bounds.Get(i - 1).min_key(),
+                          segments_key_bounds.Get(i).min_key());
+                EXPECT_LT(segments_key_bounds.Get(i).min_key(),
+                          segments_key_bounds.Get(i - 1).max_key());
+            }
+        }
     }
 
     { // test return ordered results and return k1 and k2
@@ -359,4 +375,81 @@ TEST_F(BetaRowsetTest, BasicFunctionTest) {
     }
 }
 
+TEST_F(BetaRowsetTest, VerticalWriteTest) {
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+
+    RowsetSharedPtr rowset;
+    const uint32_t num_rows = 250;
+    const uint32_t max_rows_per_segment = 100;
+    // for row "rid", k1 := rid, k2 := rid * 10, v1 := rid * 100
+    const int32_t multipliers[] = {1, 10, 100};
+    {
+        RowsetWriterContext writer_context;
+        create_rowset_writer_context(&tablet_schema, &writer_context);
+        writer_context.is_vertical = true;
+
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        Status s = RowsetFactory::create_rowset_writer(writer_context, &rowset_writer);
+        EXPECT_EQ(Status::OK(), s);
+
+        // the key column group decides the segments, the value column group is added in
+        // blocks across the segments
+        std::vector<std::vector<uint32_t>> column_groups = {{0, 1}, {2}};
+        for (size_t group = 0; group < column_groups.size(); ++group) {
+            const auto& column_ids = column_groups[group];
+            bool is_key = group == 0;
+            uint32_t block_rows = is_key ? 64 : 70;
+            for (uint32_t begin = 0; begin < num_rows; begin += block_rows) {
+                vectorized::Block block = tablet_schema.create_block(column_ids);
+                auto columns = block.mutate_columns();
+                for (uint32_t rid = begin; rid < std::min(num_rows, begin + block_rows); ++rid) {
+                    for (size_t i = 0; i < column_ids.size(); ++i) {
+                        int32_t value = rid * multipliers[column_ids[i]];
+                        columns[i]->insert_data(reinterpret_cast<const char*>(&value),
+                                                sizeof(value));
+                    }
+                }
+                block.set_columns(std::move(columns));
+                EXPECT_EQ(Status::OK(), rowset_writer->add_columns(&block, column_ids, is_key,
+                                                                   max_rows_per_segment));
+            }
+            EXPECT_EQ(Status::OK(), rowset_writer->flush_columns());
+        }
+        EXPECT_EQ(Status::OK(), rowset_writer->final_flush());
+
+        rowset = rowset_writer->build();
+        ASSERT_TRUE(rowset != nullptr);
+        EXPECT_EQ(3, rowset->rowset_meta()->num_segments());
+        EXPECT_EQ(num_rows, rowset->rowset_meta()->num_rows());
+    }
+
+    RowsetReaderContext reader_context;
+    reader_context.tablet_schema = &tablet_schema;
+    reader_context.need_ordered_result = false;
+    std::vector<uint32_t> return_columns = {0, 1, 2};
+    reader_context.return_columns = &return_columns;
+    reader_context.seek_columns = &return_columns;
+    reader_context.stats = &_stats;
+
+    RowsetReaderSharedPtr rowset_reader;
+    create_and_init_rowset_reader(rowset.get(), reader_context, &rowset_reader);
+    RowBlock* output_block;
+    uint32_t num_rows_read = 0;
+    Status s;
+    while ((s = rowset_reader->next_block(&output_block)) == Status::OK()) {
+        for (int i = 0; i < output_block->row_num(); ++i) {
+            for (uint32_t cid = 0; cid < return_columns.size(); ++cid) {
+                char* field = output_block->field_ptr(i, cid);
+                EXPECT_FALSE(*reinterpret_cast<bool*>(field));
+                EXPECT_EQ(num_rows_read * multipliers[cid],
+                          *reinterpret_cast<uint32_t*>(field + 1));
+            }
+            num_rows_read++;
+        }
+    }
+    EXPECT_EQ(Status::OLAPInternalError(OLAP_ERR_DATA_EOF), s);
+    EXPECT_EQ(num_rows, num_rows_read);
+}
+
 } // namespace doris
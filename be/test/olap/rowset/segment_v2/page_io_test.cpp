@@ -0,0 +1,232 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/page_io.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "olap/fs/block_manager.h"
+#include "olap/fs/fs_util.h"
+#include "olap/lru_cache.h"
+#include "olap/olap_common.h"
+#include "olap/page_cache.h"
+#include "util/block_compression.h"
+#include "util/file_utils.h"
+
+namespace doris {
+namespace segment_v2 {
+
+static const std::string TEST_DIR = "./ut_dir/page_io_test";
+
+class PageIOTest : public testing::Test {
+public:
+    PageIOTest()
+            : _page_cache(StoragePageCache::kDefaultNumShards * 64 * 1024, 0,
+                          StoragePageCache::kDefaultNumShards, CacheEvictionPolicy::LRU, 50) {}
+
+protected:
+    void SetUp() override {
+        if (FileUtils::check_exist(TEST_DIR)) {
+            EXPECT_TRUE(FileUtils::remove_all(TEST_DIR).ok());
+        }
+        EXPECT_TRUE(FileUtils::create_dir(TEST_DIR).ok());
+        EXPECT_TRUE(get_block_compression_codec(LZ4F, _codec).ok());
+        // PageIO reads through the global page cache
+        _origin_page_cache = StoragePageCache::_s_instance;
+        StoragePageCache::_s_instance = &_page_cache;
+    }
+
+    void TearDown() override {
+        StoragePageCache::_s_instance = _origin_page_cache;
+        if (FileUtils::check_exist(TEST_DIR)) {
+            EXPECT_TRUE(FileUtils::remove_all(TEST_DIR).ok());
+        }
+    }
+
+    // write a data page of body to fname, compressed if codec is not null
+    void write_page(const std::string& fname, const std::string& body,
+                    const BlockCompressionCodec* codec, PagePointer* page_pointer) {
+        std::unique_ptr<fs::WritableBlock> wblock;
+        fs::CreateBlockOptions opts(fname);
+        FilePathDesc path_desc;
+        path_desc.filepath = fname;
+        EXPECT_TRUE(fs::fs_util::block_manager(path_desc)->create_block(opts, &wblock).ok());
+        PageFooterPB footer;
+        footer.set_type(DATA_PAGE);
+        footer.set_uncompressed_size(body.size());
+        EXPECT_TRUE(PageIO::compress_and_write_page(codec, 0.1, wblock.get(), {Slice(body)},
+                                                    footer, page_pointer)
+                            .ok());
+        EXPECT_TRUE(wblock->close().ok());
+    }
+
+    Status read_page(fs::ReadableBlock* rblock, const PagePointer& page_pointer,
+                     PageHandle* handle, Slice* body, PageFooterPB* footer) {
+        PageReadOptions opts;
+        opts.rblock = rblock;
+        opts.page_pointer = page_pointer;
+        opts.codec = _codec.get();
+        opts.stats = &_stats;
+        opts.type = DATA_PAGE;
+        return PageIO::read_and_decompress_page(opts, handle, body, footer);
+    }
+
+    static size_t cache_usage(Cache* cache) {
+        auto sharded_cache = static_cast<ShardedLRUCache*>(cache);
+        size_t usage = 0;
+        for (int i = 0; i < sharded_cache->_num_shards; ++i) {
+            usage += sharded_cache->_shards[i]->get_usage();
+        }
+        return usage;
+    }
+
+    StoragePageCache _page_cache;
+    StoragePageCache* _origin_page_cache = nullptr;
+    std::unique_ptr<BlockCompressionCodec> _codec;
+    OlapReaderStatistics _stats;
+};
+
+TEST_F(PageIOTest, compressed_page_cache) {
+    ASSERT_TRUE(_page_cache.is_compressed_cache_available());
+    std::string fname = TEST_DIR + "/compressed_page";
+    std::string data(4096, 'a');
+    PagePointer page_pointer;
+    write_page(fname, data, _codec.get(), &page_pointer);
+    ASSERT_LT(page_pointer.size, data.size());
+
+    FilePathDesc path_desc;
+    path_desc.filepath = fname;
+    std::unique_ptr<fs::ReadableBlock> rblock;
+    ASSERT_TRUE(fs::fs_util::block_manager(path_desc)->open_block(path_desc, &rblock).ok());
+    StoragePageCache::CacheKey cache_key(fname, page_pointer.offset);
+
+    // the first read only caches the page as it is in file in compressed tier
+    {
+        PageHandle handle;
+        Slice body;
+        PageFooterPB footer;
+        ASSERT_TRUE(read_page(rblock.get(), page_pointer, &handle, &body, &footer).ok());
+        EXPECT_EQ(data, body.to_string());
+        EXPECT_EQ(data.size(), footer.uncompressed_size());
+        // the decompressed page is owned by the handle, not by a cache
+        EXPECT_TRUE(handle._is_data_owner);
+        EXPECT_EQ(page_pointer.size, _stats.compressed_bytes_read);
+        EXPECT_EQ(0, _stats.cached_pages_num);
+        EXPECT_EQ(0, _stats.compressed_cached_pages_num);
+
+        PageCacheHandle cache_handle;
+        ASSERT_TRUE(_page_cache.lookup_compressed(cache_key, &cache_handle));
+        // the compressed tier took the buffer read from file
+        EXPECT_EQ(page_pointer.size, cache_handle.data().size);
+        EXPECT_NE(body.data, cache_handle.data().data);
+        EXPECT_FALSE(_page_cache.lookup(cache_key, &cache_handle, DATA_PAGE));
+    }
+    EXPECT_GE(cache_usage(_page_cache._compressed_page_cache.get()), page_pointer.size);
+    EXPECT_EQ(0, cache_usage(_page_cache._data_page_cache.get()));
+
+    // a hit in compressed tier promotes the page to decompressed tier
+    {
+        PageHandle handle;
+        Slice body;
+        PageFooterPB footer;
+        ASSERT_TRUE(read_page(rblock.get(), page_pointer, &handle, &body, &footer).ok());
+        EXPECT_EQ(data, body.to_string());
+        EXPECT_FALSE(handle._is_data_owner);
+        // the page is not read from file again
+        EXPECT_EQ(page_pointer.size, _stats.compressed_bytes_read);
+        EXPECT_EQ(1, _stats.compressed_cached_pages_num);
+
+        PageCacheHandle cache_handle;
+        EXPECT_FALSE(_page_cache.lookup_compressed(cache_key, &cache_handle));
+        ASSERT_TRUE(_page_cache.lookup(cache_key, &cache_handle, DATA_PAGE));
+        EXPECT_EQ(body.data, cache_handle.data().data);
+    }
+    // the compressed page is freed once it is erased from compressed tier
+    EXPECT_EQ(0, cache_usage(_page_cache._compressed_page_cache.get()));
+    EXPECT_GE(cache_usage(_page_cache._data_page_cache.get()), data.size());
+
+    // later reads hit decompressed tier
+    {
+        PageHandle handle;
+        Slice body;
+        PageFooterPB footer;
+        ASSERT_TRUE(read_page(rblock.get(), page_pointer, &handle, &body, &footer).ok());
+        EXPECT_EQ(data, body.to_string());
+        EXPECT_EQ(1, _stats.cached_pages_num);
+        EXPECT_EQ(1, _stats.compressed_cached_pages_num);
+        EXPECT_EQ(page_pointer.size, _stats.compressed_bytes_read);
+    }
+    EXPECT_EQ(0, cache_usage(_page_cache._compressed_page_cache.get()));
+}
+
+TEST_F(PageIOTest, uncompressed_page_in_compressed_page_cache) {
+    std::string fname = TEST_DIR + "/uncompressed_page";
+    std::string data(4096, 'a');
+    PagePointer page_pointer;
+    write_page(fname, data, nullptr, &page_pointer);
+    ASSERT_GT(page_pointer.size, data.size());
+
+    FilePathDesc path_desc;
+    path_desc.filepath = fname;
+    std::unique_ptr<fs::ReadableBlock> rblock;
+    ASSERT_TRUE(fs::fs_util::block_manager(path_desc)->open_block(path_desc, &rblock).ok());
+    StoragePageCache::CacheKey cache_key(fname, page_pointer.offset);
+
+    // an uncompressed page is never cached in compressed tier
+    {
+        PageHandle handle;
+        Slice body;
+        PageFooterPB footer;
+        ASSERT_TRUE(read_page(rblock.get(), page_pointer, &handle, &body, &footer).ok());
+        EXPECT_EQ(data, body.to_string());
+        PageCacheHandle cache_handle;
+        EXPECT_FALSE(_page_cache.lookup_compressed(cache_key, &cache_handle));
+        EXPECT_TRUE(_page_cache.lookup(cache_key, &cache_handle, DATA_PAGE));
+    }
+    _page_cache._data_page_cache->erase(cache_key.encode());
+
+    // put it there anyway
+    char* page = new char[page_pointer.size];
+    ASSERT_TRUE(rblock->read(page_pointer.offset, Slice(page, page_pointer.size)).ok());
+    _page_cache.insert_compressed(cache_key, Slice(page, page_pointer.size));
+    {
+        PageHandle handle;
+        Slice body;
+        PageFooterPB footer;
+        Status st = read_page(rblock.get(), page_pointer, &handle, &body, &footer);
+        EXPECT_EQ(TStatusCode::CORRUPTION, st.code());
+        EXPECT_EQ(1, _stats.compressed_cached_pages_num);
+    }
+    // the bad entry is dropped and freed, the page is read from file again
+    EXPECT_EQ(0, cache_usage(_page_cache._compressed_page_cache.get()));
+    {
+        PageHandle handle;
+        Slice body;
+        PageFooterPB footer;
+        ASSERT_TRUE(read_page(rblock.get(), page_pointer, &handle, &body, &footer).ok());
+        EXPECT_EQ(data, body.to_string());
+        EXPECT_EQ(1, _stats.compressed_cached_pages_num);
+        PageCacheHandle cache_handle;
+        EXPECT_FALSE(_page_cache.lookup_compressed(cache_key, &cache_handle));
+    }
+}
+
+} // namespace segment_v2
+} // namespace doris
@@ -23,6 +23,7 @@
 #include <functional>
 #include <iostream>
 
+#include "common/config.h"
 #include "common/logging.h"
 #include "gutil/strings/substitute.h"
 #include "olap/comparison_predicate.h"
@@ -38,11 +39,18 @@
 #include "olap/rowset/segment_v2/segment_writer.h"
 #include "olap/tablet_schema.h"
 #include "olap/tablet_schema_helper.h"
+#include "olap/tuple.h"
 #include "olap/types.h"
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
 #include "testutil/test_util.h"
 #include "util/file_utils.h"
+#include "util/jsonb.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/common/assert_cast.h"
+#include "vec/core/block.h"
+#include "vec/olap/row_store_codec.h"
+
 namespace doris {
 namespace segment_v2 {
 
@@ -146,6 +154,140 @@ protected:
         EXPECT_EQ(nrows, (*res)->num_rows());
     }
 
+    // build a segment with the rows of `block` through the vectorized write path, column group
+    // by column group like vertical compaction does if `column_groups` is not empty
+    void build_segment(SegmentWriterOptions opts, const TabletSchema& tablet_schema,
+                       const vectorized::Block& block, shared_ptr<Segment>* res,
+                       const std::vector<std::vector<uint32_t>>& column_groups = {}) {
+        static int block_seg_id = 0;
+        std::string filename =
+                strings::Substitute("$0/block_seg_$1.dat", kSegmentDir, block_seg_id++);
+        std::unique_ptr<fs::WritableBlock> wblock;
+        fs::CreateBlockOptions block_opts(filename);
+        std::string storage_name;
+        Status st = fs::fs_util::block_manager(storage_name)->create_block(block_opts, &wblock);
+        EXPECT_TRUE(st.ok());
+        DataDir data_dir(kSegmentDir);
+        data_dir.init();
+        SegmentWriter writer(wblock.get(), 0, &tablet_schema, &data_dir, INT32_MAX, opts);
+
+        // append in two parts to cover a block appended from the middle
+        auto append_block = [&writer](const vectorized::Block& block) {
+            size_t half = block.rows() / 2;
+            if (half > 0) {
+                EXPECT_TRUE(writer.append_block(&block, 0, half).ok());
+            }
+            EXPECT_TRUE(writer.append_block(&block, half, block.rows() - half).ok());
+        };
+        uint64_t file_size, index_size;
+        if (column_groups.empty()) {
+            st = writer.init(10);
+            EXPECT_TRUE(st.ok());
+            append_block(block);
+            st = writer.finalize(&file_size, &index_size);
+            EXPECT_TRUE(st.ok());
+        } else {
+            for (size_t i = 0; i < column_groups.size(); ++i) {
+                // the key group is the first one
+                st = writer.init(10, column_groups[i], i == 0);
+                EXPECT_TRUE(st.ok());
+                vectorized::Block group_block;
+                for (auto cid : column_groups[i]) {
+                    group_block.insert(block.get_by_position(cid));
+                }
+                append_block(group_block);
+                st = writer.finalize_columns(&index_size);
+                EXPECT_TRUE(st.ok());
+            }
+            st = writer.finalize_footer(&file_size, &index_size);
+            EXPECT_TRUE(st.ok());
+        }
+        EXPECT_TRUE(wblock->close().ok());
+
+        FilePathDesc path_desc;
+        path_desc.filepath = filename;
+        st = Segment::open(path_desc, 0, &tablet_schema, res);
+        EXPECT_TRUE(st.ok());
+        EXPECT_EQ(block.rows(), (*res)->num_rows());
+    }
+
+    // read all the columns of all the rows of a segment through the vectorized read path
+    vectorized::Block read_segment(const TabletSchema& tablet_schema,
+                                   const shared_ptr<Segment>& segment) {
+        Schema schema(tablet_schema);
+        OlapReaderStatistics stats;
+        StorageReadOptions read_opts;
+        read_opts.stats = &stats;
+        std::unique_ptr<RowwiseIterator> iter;
+        EXPECT_TRUE(segment->new_iterator(schema, read_opts, &iter).ok());
+
+        std::vector<uint32_t> column_ids;
+        for (uint32_t cid = 0; cid < tablet_schema.num_columns(); ++cid) {
+            column_ids.push_back(cid);
+        }
+        vectorized::Block result = tablet_schema.create_block(column_ids);
+        auto result_columns = result.mutate_columns();
+        Status st;
+        do {
+            vectorized::Block block = tablet_schema.create_block(column_ids);
+            st = iter->next_batch(&block);
+            EXPECT_TRUE(st.ok() || st.is_end_of_file());
+            for (size_t i = 0; i < block.columns(); ++i) {
+                result_columns[i]->insert_range_from(*block.get_by_position(i).column, 0,
+                                                     block.rows());
+            }
+        } while (st.ok());
+        result.set_columns(std::move(result_columns));
+        return result;
+    }
+
+    // (k1 INT, v1 INT NULL, v2 VARCHAR NULL) of unique keys, followed by the row store column
+    TabletSchema create_row_store_schema() {
+        TabletColumn v2 = create_varchar_key(3);
+        v2._is_key = false;
+        v2._aggregation = OLAP_FIELD_AGGREGATION_REPLACE;
+        TabletColumn row_store_column;
+        row_store_column._unique_id = 4;
+        row_store_column._col_name = "__DORIS_ROW_STORE_COL__";
+        row_store_column._type = OLAP_FIELD_TYPE_STRING;
+        row_store_column._is_nullable = true;
+        row_store_column._length = 2147483643;
+        row_store_column._aggregation = OLAP_FIELD_AGGREGATION_REPLACE;
+        TabletSchema tablet_schema =
+                create_schema({create_int_key(1, false),
+                               create_int_value(2, OLAP_FIELD_AGGREGATION_REPLACE), v2,
+                               row_store_column});
+        tablet_schema._keys_type = UNIQUE_KEYS;
+        tablet_schema._row_store_col_idx = 3;
+        return tablet_schema;
+    }
+
+    // every 5th v1 and every 3rd v2 is null, the row store column is filled by `row_store`
+    vectorized::Block create_row_store_block(const TabletSchema& tablet_schema, int num_rows,
+                                             std::function<std::string(int)> row_store) {
+        vectorized::Block block = tablet_schema.create_block({0, 1, 2, 3});
+        auto columns = block.mutate_columns();
+        for (int rid = 0; rid < num_rows; ++rid) {
+            columns[0]->insert_data(reinterpret_cast<const char*>(&rid), sizeof(rid));
+            int32_t v1 = rid * 10;
+            if (rid % 5 == 0) {
+                columns[1]->insert_default();
+            } else {
+                columns[1]->insert_data(reinterpret_cast<const char*>(&v1), sizeof(v1));
+            }
+            std::string v2 = "value" + std::to_string(rid);
+            if (rid % 3 == 0) {
+                columns[2]->insert_default();
+            } else {
+                columns[2]->insert_data(v2.data(), v2.size());
+            }
+            std::string row = row_store(rid);
+            columns[3]->insert_data(row.data(), row.size());
+        }
+        block.set_columns(std::move(columns));
+        return block;
+    }
+
 private:
     const std::string kSegmentDir = "./ut_dir/segment_test";
 };
@@ -1169,5 +1311,321 @@ TEST_F(SegmentReaderWriterTest, TestBloomFilterIndexUniqueModel) {
     EXPECT_TRUE(column_contains_index(seg2->footer().columns(3), BLOOM_FILTER_INDEX));
 }
 
+TEST_F(SegmentReaderWriterTest, TestKeyBloomFilter) {
+    bool enable_key_bloom_filter = config::enable_segment_key_bloom_filter;
+    config::enable_segment_key_bloom_filter = true;
+    TabletSchema tablet_schema =
+            create_schema({create_int_key(1), create_int_key(2), create_int_value(3)});
+    SegmentWriterOptions opts;
+    opts.num_rows_per_block = 10;
+
+    // no key bloom filter for duplicate keys
+    shared_ptr<Segment> dup_segment;
+    build_segment(opts, tablet_schema, tablet_schema, 100, DefaultIntGenerator, &dup_segment);
+    EXPECT_FALSE(dup_segment->footer().has_key_bloom_filter_page());
+
+    tablet_schema._keys_type = UNIQUE_KEYS;
+    shared_ptr<Segment> segment;
+    build_segment(opts, tablet_schema, tablet_schema, 100, DefaultIntGenerator, &segment);
+    EXPECT_TRUE(segment->footer().has_key_bloom_filter_page());
+
+    auto make_key = [&tablet_schema](int k1, int k2) {
+        std::unique_ptr<RowCursor> key(new RowCursor());
+        key->init(tablet_schema, 2);
+        {
+            auto cell = key->cell(0);
+            cell.set_not_null();
+            *(int*)cell.mutable_cell_ptr() = k1;
+        }
+        {
+            auto cell = key->cell(1);
+            cell.set_not_null();
+            *(int*)cell.mutable_cell_ptr() = k2;
+        }
+        return key;
+    };
+    Schema schema(tablet_schema);
+    // the key of row 10
+    {
+        auto key = make_key(100, 101);
+        OlapReaderStatistics stats;
+        StorageReadOptions read_opts;
+        read_opts.stats = &stats;
+        read_opts.key_ranges.emplace_back(key.get(), true, key.get(), true);
+        std::unique_ptr<RowwiseIterator> iter;
+        EXPECT_TRUE(segment->new_iterator(schema, read_opts, &iter).ok());
+        EXPECT_EQ(0, stats.filtered_segment_number);
+
+        RowBlockV2 block(schema, 100);
+        EXPECT_TRUE(iter->next_batch(&block).ok());
+        EXPECT_EQ(1, block.num_rows());
+        EXPECT_EQ(102, *(int*)block.column_block(2).cell_ptr(0));
+    }
+    // the keys not in the segment but in the range of its keys
+    int num_filtered = 0;
+    int filtered_rid = -1;
+    for (int rid = 0; rid < 99; ++rid) {
+        auto key = make_key(rid * 10 + 5, rid * 10 + 6);
+        StorageReadOptions::KeyRange key_range(key.get(), true, key.get(), true);
+        if (!segment->key_range_may_match(key_range)) {
+            num_filtered++;
+            filtered_rid = rid;
+        }
+    }
+    EXPECT_GT(num_filtered, 90);
+    {
+        auto key = make_key(filtered_rid * 10 + 5, filtered_rid * 10 + 6);
+        OlapReaderStatistics stats;
+        StorageReadOptions read_opts;
+        read_opts.stats = &stats;
+        read_opts.key_ranges.emplace_back(key.get(), true, key.get(), true);
+        std::unique_ptr<RowwiseIterator> iter;
+        EXPECT_TRUE(segment->new_iterator(schema, read_opts, &iter).ok());
+        EXPECT_EQ(1, stats.filtered_segment_number);
+
+        RowBlockV2 block(schema, 100);
+        EXPECT_TRUE(iter->next_batch(&block).is_end_of_file());
+        EXPECT_EQ(0, block.num_rows());
+    }
+    // a range of keys is not checked
+    {
+        auto lower_key = make_key(105, 106);
+        auto upper_key = make_key(115, 116);
+        StorageReadOptions::KeyRange key_range(lower_key.get(), true, upper_key.get(), true);
+        EXPECT_TRUE(segment->key_range_may_match(key_range));
+    }
+    config::enable_segment_key_bloom_filter = enable_key_bloom_filter;
+}
+
+TEST_F(SegmentReaderWriterTest, TestKeyBloomFilterAppendBlock) {
+    bool enable_key_bloom_filter = config::enable_segment_key_bloom_filter;
+    config::enable_segment_key_bloom_filter = true;
+    // (k1 INT NULL, k2 VARCHAR, k3 CHAR(8) NULL) of unique keys
+    TabletSchema tablet_schema =
+            create_schema({create_int_key(1), create_varchar_key(2, false), create_char_key(3),
+                           create_int_value(4, OLAP_FIELD_AGGREGATION_REPLACE)});
+    tablet_schema._keys_type = UNIQUE_KEYS;
+
+    // the keys of row "rid", k1 of the first rows and k3 of every 7th row are null
+    const int num_rows = 1000;
+    auto key_of_row = [](int rid, const std::string& k2_suffix = "") {
+        OlapTuple key;
+        if (rid < 10) {
+            key.add_null();
+        } else {
+            key.add_value(std::to_string(rid / 10));
+        }
+        key.add_value(strings::Substitute("key$0", 10000 + rid) + k2_suffix);
+        if (rid % 7 == 0) {
+            key.add_null();
+        } else {
+            key.add_value("c" + std::to_string(rid % 100));
+        }
+        return key;
+    };
+    vectorized::Block block = tablet_schema.create_block({0, 1, 2, 3});
+    {
+        auto columns = block.mutate_columns();
+        for (int rid = 0; rid < num_rows; ++rid) {
+            OlapTuple key = key_of_row(rid);
+            if (key.is_null(0)) {
+                columns[0]->insert_default();
+            } else {
+                int32_t k1 = rid / 10;
+                columns[0]->insert_data(reinterpret_cast<const char*>(&k1), sizeof(k1));
+            }
+            columns[1]->insert_data(key.get_value(1).data(), key.get_value(1).size());
+            if (key.is_null(2)) {
+                columns[2]->insert_default();
+            } else {
+                columns[2]->insert_data(key.get_value(2).data(), key.get_value(2).size());
+            }
+            columns[3]->insert_data(reinterpret_cast<const char*>(&rid), sizeof(rid));
+        }
+        block.set_columns(std::move(columns));
+    }
+
+    SegmentWriterOptions opts;
+    opts.num_rows_per_block = 100;
+    shared_ptr<Segment> segment;
+    build_segment(opts, tablet_schema, block, &segment);
+    EXPECT_TRUE(segment->footer().has_key_bloom_filter_page());
+    ASSERT_TRUE(segment->_load_index().ok());
+
+    // the keys are encoded from the scan keys like a key lookup does
+    auto may_match = [&tablet_schema, &segment](const OlapTuple& tuple) {
+        RowCursor key;
+        EXPECT_TRUE(key.init_scan_key(tablet_schema, tuple.values()).ok());
+        EXPECT_TRUE(key.from_tuple(tuple).ok());
+        StorageReadOptions::KeyRange key_range(&key, true, &key, true);
+        return segment->key_range_may_match(key_range);
+    };
+    // the key of every row written by append_block matches
+    for (int rid = 0; rid < num_rows; ++rid) {
+        EXPECT_TRUE(may_match(key_of_row(rid))) << "row " << rid;
+    }
+    // the keys not in the segment
+    int num_filtered = 0;
+    for (int rid = 0; rid < num_rows; ++rid) {
+        if (!may_match(key_of_row(rid, "x"))) {
+            num_filtered++;
+        }
+    }
+    EXPECT_GT(num_filtered, num_rows * 9 / 10);
+    config::enable_segment_key_bloom_filter = enable_key_bloom_filter;
+}
+
+TEST_F(SegmentReaderWriterTest, TestJsonbColumn) {
+    TabletColumn jsonb_column;
+    jsonb_column._unique_id = 2;
+    jsonb_column._col_name = "2";
+    jsonb_column._type = OLAP_FIELD_TYPE_JSONB;
+    jsonb_column._is_nullable = true;
+    jsonb_column._length = 2147483643;
+    TabletSchema tablet_schema = create_schema({create_int_key(1, false), jsonb_column});
+
+    std::vector<std::string> jsons = {R"({"k1":"v1","k2":[1,2.5]})", R"([true,null])",
+                                      R"("str")", "-1", "{}"};
+    auto jsonb_of_row = [&jsons](int rid) {
+        std::string jsonb;
+        const auto& json = jsons[rid % jsons.size()];
+        EXPECT_TRUE(JsonbDocument::from_json(json.data(), json.size(), &jsonb).ok());
+        return jsonb;
+    };
+    // every 7th jsonb is null
+    const int num_rows = 5000;
+    vectorized::Block block = tablet_schema.create_block({0, 1});
+    {
+        auto columns = block.mutate_columns();
+        for (int rid = 0; rid < num_rows; ++rid) {
+            columns[0]->insert_data(reinterpret_cast<const char*>(&rid), sizeof(rid));
+            if (rid % 7 == 0) {
+                columns[1]->insert_default();
+            } else {
+                auto jsonb = jsonb_of_row(rid);
+                columns[1]->insert_data(jsonb.data(), jsonb.size());
+            }
+        }
+        block.set_columns(std::move(columns));
+    }
+
+    SegmentWriterOptions opts;
+    opts.num_rows_per_block = 100;
+    shared_ptr<Segment> segment;
+    build_segment(opts, tablet_schema, block, &segment);
+    // jsonb columns have no zone map
+    EXPECT_FALSE(column_contains_index(segment->footer().columns(1), ZONE_MAP_INDEX));
+
+    Schema schema(tablet_schema);
+    OlapReaderStatistics stats;
+    StorageReadOptions read_opts;
+    read_opts.stats = &stats;
+    std::unique_ptr<RowwiseIterator> iter;
+    ASSERT_TRUE(segment->new_iterator(schema, read_opts, &iter).ok());
+
+    int rid = 0;
+    vectorized::Block read_block = tablet_schema.create_block({0, 1});
+    Status st;
+    do {
+        read_block.clear_column_data();
+        st = iter->next_batch(&read_block);
+        EXPECT_TRUE(st.ok() || st.is_end_of_file());
+        const auto& jsonb_values = assert_cast<const vectorized::ColumnNullable&>(
+                *read_block.get_by_position(1).column);
+        for (size_t i = 0; i < read_block.rows(); ++i, ++rid) {
+            EXPECT_EQ(rid, read_block.get_by_position(0).column->get_int(i));
+            EXPECT_EQ(rid % 7 == 0, jsonb_values.is_null_at(i));
+            if (rid % 7 != 0) {
+                EXPECT_EQ(jsonb_of_row(rid),
+                          jsonb_values.get_nested_column().get_data_at(i).to_string());
+            }
+        }
+    } while (st.ok());
+    EXPECT_EQ(num_rows, rid);
+}
+
+TEST_F(SegmentReaderWriterTest, TestRowStoreColumn) {
+    TabletSchema tablet_schema = create_row_store_schema();
+    // the row store column of the block is replaced by the encoded rows
+    const int num_rows = 3000;
+    vectorized::Block block = create_row_store_block(tablet_schema, num_rows,
+                                                     [](int rid) { return std::string(); });
+
+    SegmentWriterOptions opts;
+    opts.num_rows_per_block = 100;
+    shared_ptr<Segment> segment;
+    build_segment(opts, tablet_schema, block, &segment);
+    EXPECT_FALSE(column_contains_index(segment->footer().columns(3), ZONE_MAP_INDEX));
+
+    vectorized::Block result = read_segment(tablet_schema, segment);
+    ASSERT_EQ(num_rows, result.rows());
+    vectorized::RowStoreCodec codec(tablet_schema);
+    vectorized::Block row_block = tablet_schema.create_block(codec.column_ids());
+    auto row_columns = row_block.mutate_columns();
+    const auto& rows = assert_cast<const vectorized::ColumnNullable&>(
+            *result.get_by_position(3).column);
+    for (size_t i = 0; i < result.rows(); ++i) {
+        ASSERT_FALSE(rows.is_null_at(i));
+        ASSERT_TRUE(codec.decode(rows.get_nested_column().get_data_at(i), row_columns));
+        // the decoded row is the same as the columns of the row
+        for (size_t cid = 0; cid < row_columns.size(); ++cid) {
+            EXPECT_EQ(0, row_columns[cid]->compare_at(i, i, *result.get_by_position(cid).column,
+                                                      -1));
+        }
+    }
+    EXPECT_EQ(num_rows, row_columns[0]->size());
+}
+
+TEST_F(SegmentReaderWriterTest, TestRowStoreColumnGroups) {
+    TabletSchema tablet_schema = create_row_store_schema();
+    // the row store column is written as is when the columns are written group by group
+    const int num_rows = 3000;
+    auto row_store = [](int rid) { return "row" + std::to_string(rid); };
+    vectorized::Block block = create_row_store_block(tablet_schema, num_rows, row_store);
+
+    SegmentWriterOptions opts;
+    opts.num_rows_per_block = 100;
+    shared_ptr<Segment> segment;
+    build_segment(opts, tablet_schema, block, &segment, {{0}, {1, 2, 3}});
+
+    vectorized::Block result = read_segment(tablet_schema, segment);
+    ASSERT_EQ(num_rows, result.rows());
+    const auto& rows = assert_cast<const vectorized::ColumnNullable&>(
+            *result.get_by_position(3).column);
+    for (int rid = 0; rid < num_rows; ++rid) {
+        EXPECT_EQ(rid, result.get_by_position(0).column->get_int(rid));
+        ASSERT_FALSE(rows.is_null_at(rid));
+        EXPECT_EQ(row_store(rid), rows.get_nested_column().get_data_at(rid).to_string());
+    }
+}
+
+TEST_F(SegmentReaderWriterTest, TestRowStoreColumnDupKeys) {
+    TabletSchema tablet_schema = create_row_store_schema();
+    tablet_schema._keys_type = DUP_KEYS;
+    for (auto& column : tablet_schema._cols) {
+        if (!column.is_key()) {
+            column._aggregation = OLAP_FIELD_AGGREGATION_NONE;
+        }
+    }
+    // only unique keys tablets store rows, the column of others is written as is
+    const int num_rows = 3000;
+    auto row_store = [](int rid) { return "row" + std::to_string(rid); };
+    vectorized::Block block = create_row_store_block(tablet_schema, num_rows, row_store);
+
+    SegmentWriterOptions opts;
+    opts.num_rows_per_block = 100;
+    shared_ptr<Segment> segment;
+    build_segment(opts, tablet_schema, block, &segment);
+
+    vectorized::Block result = read_segment(tablet_schema, segment);
+    ASSERT_EQ(num_rows, result.rows());
+    const auto& rows = assert_cast<const vectorized::ColumnNullable&>(
+            *result.get_by_position(3).column);
+    for (int rid = 0; rid < num_rows; ++rid) {
+        ASSERT_FALSE(rows.is_null_at(rid));
+        EXPECT_EQ(row_store(rid), rows.get_nested_column().get_data_at(rid).to_string());
+    }
+}
+
 } // namespace segment_v2
 } // namespace doris
@@ -42,4 +42,35 @@ TEST(TabletMetaTest, SaveAndParse) {
     EXPECT_EQ(old_tablet_meta, new_tablet_meta);
 }
 
+TEST(TabletMetaTest, ReportStamp) {
+    TabletMeta tablet_meta(1, 2, 3, 4, 5, TTabletSchema(), 6, {{7, 8}}, UniqueId(9, 10),
+                           TTabletType::TABLET_TYPE_DISK, TStorageMedium::HDD, "",
+                           TCompressionType::LZ4F);
+    TabletMeta other_tablet_meta;
+    // the stamps of different metas never equal
+    EXPECT_NE(tablet_meta.report_stamp(), other_tablet_meta.report_stamp());
+
+    int64_t stamp = tablet_meta.report_stamp();
+    EXPECT_EQ(stamp, tablet_meta.report_stamp());
+
+    RowsetMetaSharedPtr rs_meta(new RowsetMeta());
+    rs_meta->set_rowset_id(RowsetId());
+    rs_meta->set_version(Version(2, 2));
+    EXPECT_EQ(Status::OK(), tablet_meta.add_rs_meta(rs_meta));
+    EXPECT_NE(stamp, tablet_meta.report_stamp());
+
+    stamp = tablet_meta.report_stamp();
+    tablet_meta.set_tablet_state(TABLET_RUNNING);
+    EXPECT_NE(stamp, tablet_meta.report_stamp());
+
+    stamp = tablet_meta.report_stamp();
+    tablet_meta.delete_rs_meta_by_version(Version(2, 2), nullptr);
+    EXPECT_NE(stamp, tablet_meta.report_stamp());
+
+    // deleting a version that does not exist changes nothing
+    stamp = tablet_meta.report_stamp();
+    tablet_meta.delete_rs_meta_by_version(Version(3, 3), nullptr);
+    EXPECT_EQ(stamp, tablet_meta.report_stamp());
+}
+
 } // namespace doris
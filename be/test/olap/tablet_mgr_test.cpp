@@ -31,6 +31,7 @@
 #include "olap/tablet_meta_manager.h"
 #include "olap/txn_manager.h"
 #include "util/file_utils.h"
+#include "util/threadpool.h"
 
 #ifndef BE_TEST
 #define BE_TEST
@@ -245,6 +246,206 @@ TEST_F(TabletMgrTest, DropTablet) {
     EXPECT_TRUE(!dir_exist);
 }
 
+TEST_F(TabletMgrTest, BuildIncrementalReportTabletsInfo) {
+    TColumnType col_type;
+    col_type.__set_type(TPrimitiveType::SMALLINT);
+    TColumn col1;
+    col1.__set_column_name("col1");
+    col1.__set_column_type(col_type);
+    col1.__set_is_key(true);
+    std::vector<TColumn> cols;
+    cols.push_back(col1);
+    TTabletSchema tablet_schema;
+    tablet_schema.__set_short_key_column_count(1);
+    tablet_schema.__set_schema_hash(3333);
+    tablet_schema.__set_keys_type(TKeysType::AGG_KEYS);
+    tablet_schema.__set_storage_type(TStorageType::COLUMN);
+    tablet_schema.__set_columns(cols);
+    TCreateTabletReq create_tablet_req;
+    create_tablet_req.__set_tablet_schema(tablet_schema);
+    create_tablet_req.__set_version(2);
+    std::vector<DataDir*> data_dirs;
+    data_dirs.push_back(_data_dir);
+    create_tablet_req.__set_tablet_id(111);
+    EXPECT_TRUE(_tablet_mgr->create_tablet(create_tablet_req, data_dirs) == Status::OK());
+    create_tablet_req.__set_tablet_id(112);
+    EXPECT_TRUE(_tablet_mgr->create_tablet(create_tablet_req, data_dirs) == Status::OK());
+
+    // a full report contains all tablets
+    std::map<TTabletId, TTablet> tablets_info;
+    EXPECT_TRUE(_tablet_mgr->build_all_report_tablets_info(&tablets_info) == Status::OK());
+    EXPECT_EQ(2, tablets_info.size());
+
+    // nothing changed since the stamp
+    int64_t report_stamp = TabletMeta::current_report_stamp();
+    tablets_info.clear();
+    EXPECT_TRUE(_tablet_mgr->build_all_report_tablets_info(&tablets_info, report_stamp) ==
+                Status::OK());
+    EXPECT_TRUE(tablets_info.empty());
+
+    // only the changed tablet is reported
+    TabletSharedPtr tablet = _tablet_mgr->get_tablet(112);
+    EXPECT_TRUE(tablet != nullptr);
+    EXPECT_TRUE(tablet->set_tablet_state(TABLET_RUNNING) == Status::OK());
+    tablets_info.clear();
+    EXPECT_TRUE(_tablet_mgr->build_all_report_tablets_info(&tablets_info, report_stamp) ==
+                Status::OK());
+    EXPECT_EQ(1, tablets_info.size());
+    EXPECT_EQ(1, tablets_info.count(112));
+    EXPECT_EQ(112, tablets_info[112].tablet_infos[0].tablet_id);
+
+    // a newly created tablet is reported
+    report_stamp = TabletMeta::current_report_stamp();
+    create_tablet_req.__set_tablet_id(113);
+    EXPECT_TRUE(_tablet_mgr->create_tablet(create_tablet_req, data_dirs) == Status::OK());
+    tablets_info.clear();
+    EXPECT_TRUE(_tablet_mgr->build_all_report_tablets_info(&tablets_info, report_stamp) ==
+                Status::OK());
+    EXPECT_EQ(1, tablets_info.size());
+    EXPECT_EQ(1, tablets_info.count(113));
+
+    tablet.reset();
+    for (TTabletId tablet_id : {111, 112, 113}) {
+        EXPECT_TRUE(_tablet_mgr->drop_tablet(tablet_id, false) == Status::OK());
+    }
+    EXPECT_TRUE(_tablet_mgr->start_trash_sweep() == Status::OK());
+}
+
+TEST_F(TabletMgrTest, SelfDroppedTabletsNeedFullReport) {
+    TColumnType col_type;
+    col_type.__set_type(TPrimitiveType::SMALLINT);
+    TColumn col1;
+    col1.__set_column_name("col1");
+    col1.__set_column_type(col_type);
+    col1.__set_is_key(true);
+    std::vector<TColumn> cols;
+    cols.push_back(col1);
+    TTabletSchema tablet_schema;
+    tablet_schema.__set_short_key_column_count(1);
+    tablet_schema.__set_schema_hash(3333);
+    tablet_schema.__set_keys_type(TKeysType::AGG_KEYS);
+    tablet_schema.__set_storage_type(TStorageType::COLUMN);
+    tablet_schema.__set_columns(cols);
+    TCreateTabletReq create_tablet_req;
+    create_tablet_req.__set_tablet_schema(tablet_schema);
+    create_tablet_req.__set_version(2);
+    std::vector<DataDir*> data_dirs;
+    data_dirs.push_back(_data_dir);
+    create_tablet_req.__set_tablet_id(111);
+    EXPECT_TRUE(_tablet_mgr->create_tablet(create_tablet_req, data_dirs) == Status::OK());
+    create_tablet_req.__set_tablet_id(112);
+    EXPECT_TRUE(_tablet_mgr->create_tablet(create_tablet_req, data_dirs) == Status::OK());
+    int64_t report_stamp = TabletMeta::current_report_stamp();
+    int64_t dropped_count = _tablet_mgr->self_dropped_tablet_count();
+
+    // the tablets on a broken disk are dropped by BE itself
+    TabletSharedPtr tablet = _tablet_mgr->get_tablet(111);
+    EXPECT_TRUE(tablet != nullptr);
+    std::vector<TabletInfo> tablet_info_vec {tablet->get_tablet_info()};
+    EXPECT_TRUE(_tablet_mgr->drop_tablets_on_error_root_path(tablet_info_vec) == Status::OK());
+    EXPECT_TRUE(_tablet_mgr->get_tablet(111) == nullptr);
+
+    // an incremental report cannot tell master the tablet is gone ...
+    std::map<TTabletId, TTablet> tablets_info;
+    EXPECT_TRUE(_tablet_mgr->build_all_report_tablets_info(&tablets_info, report_stamp) ==
+                Status::OK());
+    EXPECT_TRUE(tablets_info.empty());
+    // ... so the moved count makes the report thread send a full one, without the tablet
+    EXPECT_EQ(dropped_count + 1, _tablet_mgr->self_dropped_tablet_count());
+    tablets_info.clear();
+    EXPECT_TRUE(_tablet_mgr->build_all_report_tablets_info(&tablets_info) == Status::OK());
+    EXPECT_EQ(1, tablets_info.size());
+    EXPECT_EQ(1, tablets_info.count(112));
+
+    // a stale tablet dropped after a failed clone is dropped by BE itself too
+    dropped_count = _tablet_mgr->self_dropped_tablet_count();
+    create_tablet_req.__set_tablet_id(113);
+    EXPECT_TRUE(_tablet_mgr->create_tablet(create_tablet_req, data_dirs) == Status::OK());
+    EXPECT_TRUE(_tablet_mgr->drop_tablet(113, false, false) == Status::OK());
+    EXPECT_EQ(dropped_count + 1, _tablet_mgr->self_dropped_tablet_count());
+
+    // master knows the tablets it drops, an incremental report is enough
+    dropped_count = _tablet_mgr->self_dropped_tablet_count();
+    EXPECT_TRUE(_tablet_mgr->drop_tablet(112, false) == Status::OK());
+    EXPECT_EQ(dropped_count, _tablet_mgr->self_dropped_tablet_count());
+
+    tablet.reset();
+    EXPECT_TRUE(_tablet_mgr->start_trash_sweep() == Status::OK());
+}
+
+TEST_F(TabletMgrTest, LoadTabletsOfDataDirInBatches) {
+    TColumnType col_type;
+    col_type.__set_type(TPrimitiveType::SMALLINT);
+    TColumn col1;
+    col1.__set_column_name("col1");
+    col1.__set_column_type(col_type);
+    col1.__set_is_key(true);
+    std::vector<TColumn> cols;
+    cols.push_back(col1);
+    TTabletSchema tablet_schema;
+    tablet_schema.__set_short_key_column_count(1);
+    tablet_schema.__set_schema_hash(3333);
+    tablet_schema.__set_keys_type(TKeysType::AGG_KEYS);
+    tablet_schema.__set_storage_type(TStorageType::COLUMN);
+    tablet_schema.__set_columns(cols);
+    TCreateTabletReq create_tablet_req;
+    create_tablet_req.__set_tablet_schema(tablet_schema);
+    create_tablet_req.__set_version(2);
+    std::vector<DataDir*> data_dirs;
+    data_dirs.push_back(_data_dir);
+    std::set<int64_t> expected_tablet_ids;
+    for (TTabletId tablet_id = 200; tablet_id < 207; ++tablet_id) {
+        create_tablet_req.__set_tablet_id(tablet_id);
+        EXPECT_TRUE(_tablet_mgr->create_tablet(create_tablet_req, data_dirs) == Status::OK());
+        expected_tablet_ids.insert(tablet_id);
+    }
+    // a tablet meta which can't be parsed
+    EXPECT_TRUE(TabletMetaManager::save(_data_dir, 300, 3333, std::string("corrupt header")) ==
+                Status::OK());
+
+    // the tablets are loaded from the meta of the data dir to an empty tablet manager
+    auto load_tablets = [this](ThreadPool* pool, int num_threads, std::set<int64_t>* tablet_ids,
+                               std::set<int64_t>* failed_tablet_ids) {
+        TabletManager tablet_manager(1);
+        _data_dir->_tablet_manager = &tablet_manager;
+        EXPECT_TRUE(_data_dir->_load_tablets(pool, num_threads, tablet_ids, failed_tablet_ids) ==
+                    Status::OK());
+        for (int64_t tablet_id : *tablet_ids) {
+            EXPECT_TRUE(tablet_manager.get_tablet(tablet_id) != nullptr);
+        }
+        EXPECT_TRUE(tablet_manager.get_tablet(300) == nullptr);
+        _data_dir->_tablet_manager = nullptr;
+    };
+
+    std::set<int64_t> serial_tablet_ids;
+    std::set<int64_t> serial_failed_tablet_ids;
+    load_tablets(nullptr, 1, &serial_tablet_ids, &serial_failed_tablet_ids);
+    EXPECT_EQ(expected_tablet_ids, serial_tablet_ids);
+    EXPECT_EQ(std::set<int64_t> {300}, serial_failed_tablet_ids);
+
+    // the 8 tablet metas are loaded in batches of 3 by 4 threads
+    int32_t load_tablet_batch_size = config::load_tablet_batch_size;
+    config::load_tablet_batch_size = 3;
+    std::unique_ptr<ThreadPool> pool;
+    EXPECT_TRUE(ThreadPoolBuilder("LoadTabletThreadPool")
+                        .set_min_threads(3)
+                        .set_max_threads(3)
+                        .build(&pool)
+                        .ok());
+    std::set<int64_t> tablet_ids;
+    std::set<int64_t> failed_tablet_ids;
+    load_tablets(pool.get(), 4, &tablet_ids, &failed_tablet_ids);
+    config::load_tablet_batch_size = load_tablet_batch_size;
+    pool->shutdown();
+    EXPECT_EQ(serial_tablet_ids, tablet_ids);
+    EXPECT_EQ(serial_failed_tablet_ids, failed_tablet_ids);
+
+    for (TTabletId tablet_id = 200; tablet_id < 207; ++tablet_id) {
+        EXPECT_TRUE(_tablet_mgr->drop_tablet(tablet_id, false) == Status::OK());
+    }
+    EXPECT_TRUE(_tablet_mgr->start_trash_sweep() == Status::OK());
+}
+
 TEST_F(TabletMgrTest, GetRowsetId) {
     // normal case
     {
@@ -22,6 +22,7 @@
 #include <sstream>
 
 #include "olap/olap_define.h"
+#include "olap/rowset/rowset_factory.h"
 #include "olap/tablet_meta.h"
 
 using namespace std;
@@ -118,6 +119,21 @@ public:
         init_rs_meta(ptr5, 10, 11);
         rs_metas->push_back(ptr5);
     }
+    // create a rowset of the tablet, with a rowset id different from the ones of init_rs_meta
+    RowsetSharedPtr create_rowset(const TabletSharedPtr& tablet, int64_t start, int64_t end,
+                                  int64_t id) {
+        RowsetMetaSharedPtr rs_meta(new RowsetMeta());
+        init_rs_meta(rs_meta, start, end);
+        RowsetId rowset_id;
+        rowset_id.init(id);
+        rs_meta->set_rowset_id(rowset_id);
+        RowsetSharedPtr rowset;
+        EXPECT_TRUE(RowsetFactory::create_rowset(&tablet->tablet_schema(),
+                                                 tablet->tablet_path_desc(), rs_meta, &rowset)
+                            .ok());
+        return rowset;
+    }
+
     void fetch_expired_row_rs_meta(std::vector<RowsetMetaSharedContainerPtr>* rs_metas) {
         RowsetMetaSharedContainerPtr v2(new std::vector<RowsetMetaSharedPtr>());
         RowsetMetaSharedPtr ptr1(new RowsetMeta());
@@ -193,4 +209,133 @@ TEST_F(TestTablet, delete_expired_stale_rowset) {
     EXPECT_EQ(0, _tablet->_timestamped_version_tracker._stale_version_path_map.size());
     _tablet.reset();
 }
+
+TEST_F(TestTablet, capture_consistent_rowsets_cached) {
+    std::vector<RowsetMetaSharedPtr> rs_metas;
+    init_all_rs_meta(&rs_metas);
+    for (auto& rowset : rs_metas) {
+        _tablet_meta->add_rs_meta(rowset);
+    }
+
+    StorageParamPB storage_param;
+    storage_param.set_storage_medium(StorageMediumPB::HDD);
+    TabletSharedPtr _tablet(new Tablet(_tablet_meta, storage_param, nullptr));
+    _tablet->init();
+
+    std::vector<RowsetSharedPtr> rowsets;
+    EXPECT_TRUE(_tablet->capture_consistent_rowsets(Version(0, 11), &rowsets).ok());
+    EXPECT_EQ(5, rowsets.size());
+    auto captured = _tablet->_captured_rowsets;
+    EXPECT_TRUE(captured != nullptr);
+
+    // the same version reuses the captured rowsets
+    std::vector<RowsetSharedPtr> cached_rowsets;
+    EXPECT_TRUE(_tablet->capture_consistent_rowsets(Version(0, 11), &cached_rowsets).ok());
+    EXPECT_EQ(rowsets, cached_rowsets);
+    EXPECT_EQ(captured, _tablet->_captured_rowsets);
+
+    // a version can not be captured
+    std::vector<RowsetSharedPtr> missing_rowsets;
+    EXPECT_FALSE(_tablet->capture_consistent_rowsets(Version(0, 20), &missing_rowsets).ok());
+    EXPECT_EQ(captured, _tablet->_captured_rowsets);
+
+    std::vector<RowsetSharedPtr> old_rowsets;
+    EXPECT_TRUE(_tablet->capture_consistent_rowsets(Version(0, 5), &old_rowsets).ok());
+    EXPECT_EQ(3, old_rowsets.size());
+    EXPECT_EQ(Version(0, 5), _tablet->_captured_rowsets->spec_version);
+
+    // deleting the expired stale rowsets drops the captured rowsets
+    std::vector<RowsetMetaSharedContainerPtr> expired_rs_metas;
+    fetch_expired_row_rs_meta(&expired_rs_metas);
+    for (auto ptr : expired_rs_metas) {
+        for (auto rs : *ptr) {
+            _tablet->_timestamped_version_tracker.add_version(rs->version());
+        }
+        _tablet->_timestamped_version_tracker.add_stale_path_version(*ptr);
+    }
+    _tablet->delete_expired_stale_rowset();
+    EXPECT_TRUE(_tablet->_captured_rowsets == nullptr);
+    rowsets.clear();
+    EXPECT_TRUE(_tablet->capture_consistent_rowsets(Version(0, 11), &rowsets).ok());
+    EXPECT_EQ(5, rowsets.size());
+    EXPECT_TRUE(_tablet->_captured_rowsets != nullptr);
+
+    // adding a rowset drops the captured rowsets
+    RowsetSharedPtr delta = create_rowset(_tablet, 12, 12, 540082);
+    EXPECT_TRUE(_tablet->add_rowset(delta).ok());
+    EXPECT_TRUE(_tablet->_captured_rowsets == nullptr);
+    rowsets.clear();
+    EXPECT_TRUE(_tablet->capture_consistent_rowsets(Version(0, 12), &rowsets).ok());
+    EXPECT_EQ(6, rowsets.size());
+    EXPECT_EQ(delta, rowsets.back());
+    EXPECT_TRUE(_tablet->_captured_rowsets != nullptr);
+
+    // replacing rowsets, as compaction does, drops the captured rowsets
+    RowsetSharedPtr compacted = create_rowset(_tablet, 10, 12, 540083);
+    std::vector<RowsetSharedPtr> to_add = {compacted};
+    std::vector<RowsetSharedPtr> to_delete = {_tablet->_rs_version_map[Version(10, 11)], delta};
+    EXPECT_TRUE(_tablet->modify_rowsets(to_add, to_delete).ok());
+    EXPECT_TRUE(_tablet->_captured_rowsets == nullptr);
+    rowsets.clear();
+    EXPECT_TRUE(_tablet->capture_consistent_rowsets(Version(0, 12), &rowsets).ok());
+    EXPECT_EQ(5, rowsets.size());
+    EXPECT_EQ(compacted, rowsets.back());
+    _tablet.reset();
+}
+
+TEST_F(TestTablet, capture_rs_readers_without_header_lock) {
+    std::vector<RowsetMetaSharedPtr> rs_metas;
+    init_all_rs_meta(&rs_metas);
+    for (auto& rowset : rs_metas) {
+        _tablet_meta->add_rs_meta(rowset);
+    }
+
+    StorageParamPB storage_param;
+    storage_param.set_storage_medium(StorageMediumPB::HDD);
+    TabletSharedPtr _tablet(new Tablet(_tablet_meta, storage_param, nullptr));
+    _tablet->init();
+
+    // a miss takes the header lock to capture the rowsets
+    std::vector<RowsetReaderSharedPtr> rs_readers;
+    EXPECT_TRUE(_tablet->capture_rs_readers(Version(0, 11), &rs_readers, false).ok());
+    EXPECT_EQ(5, rs_readers.size());
+    EXPECT_TRUE(_tablet->_captured_rowsets != nullptr);
+
+    {
+        // a hit does not take the header lock, it would block on the writer otherwise
+        std::lock_guard<std::shared_mutex> wrlock(_tablet->get_header_lock());
+        std::vector<RowsetReaderSharedPtr> cached_rs_readers;
+        EXPECT_TRUE(_tablet->capture_rs_readers(Version(0, 11), &cached_rs_readers, false).ok());
+        EXPECT_EQ(5, cached_rs_readers.size());
+    }
+
+    // a version can not be captured
+    std::vector<RowsetReaderSharedPtr> missing_rs_readers;
+    EXPECT_FALSE(_tablet->capture_rs_readers(Version(0, 20), &missing_rs_readers, false).ok());
+    _tablet.reset();
+}
+
+TEST_F(TestTablet, calculate_read_amplification) {
+    StorageParamPB storage_param;
+    storage_param.set_storage_medium(StorageMediumPB::HDD);
+    TabletSharedPtr _tablet(new Tablet(_tablet_meta, storage_param, nullptr));
+
+    // pretend the last record happened one minute ago
+    _tablet->_last_record_read_amplification_timestamp = time(nullptr) - 60;
+    _tablet->query_scan_segments->increment(100);
+    _tablet->query_scan_rows->increment(1000);
+    _tablet->query_merged_rows->increment(500);
+
+    // 100 segments per minute with half of the rows merged away
+    double read_amplification = _tablet->calculate_read_amplification();
+    EXPECT_NEAR(150.0, read_amplification, 10.0);
+
+    // no more queries since the last record
+    _tablet->_last_record_read_amplification_timestamp = time(nullptr) - 60;
+    _tablet->_last_record_scan_segments = _tablet->query_scan_segments->value();
+    _tablet->_last_record_scan_rows = _tablet->query_scan_rows->value();
+    _tablet->_last_record_merged_rows = _tablet->query_merged_rows->value();
+    EXPECT_EQ(0.0, _tablet->calculate_read_amplification());
+    _tablet.reset();
+}
 } // namespace doris
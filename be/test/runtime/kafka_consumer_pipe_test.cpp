@@ -19,8 +19,51 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "runtime/routine_load/data_consumer_group.h"
+
 namespace doris {
 
+// a kafka message with a payload of its own, deleted tells when it is destroyed
+class FakeKafkaMessage : public RdKafka::Message {
+public:
+    FakeKafkaMessage(int32_t partition, int64_t offset, std::string payload, bool* deleted)
+            : _partition(partition),
+              _offset(offset),
+              _payload(std::move(payload)),
+              _deleted(deleted) {}
+    ~FakeKafkaMessage() override { *_deleted = true; }
+
+    std::string errstr() const override { return ""; }
+    RdKafka::ErrorCode err() const override { return RdKafka::ERR_NO_ERROR; }
+    RdKafka::Topic* topic() const override { return nullptr; }
+    std::string topic_name() const override { return "test"; }
+    int32_t partition() const override { return _partition; }
+    void* payload() const override { return const_cast<char*>(_payload.data()); }
+    size_t len() const override { return _payload.size(); }
+    const std::string* key() const override { return nullptr; }
+    const void* key_pointer() const override { return nullptr; }
+    size_t key_len() const override { return 0; }
+    int64_t offset() const override { return _offset; }
+    RdKafka::MessageTimestamp timestamp() const override { return RdKafka::MessageTimestamp(); }
+    void* msg_opaque() const override { return nullptr; }
+    int64_t latency() const override { return 0; }
+    rd_kafka_message_s* c_ptr() override { return nullptr; }
+    RdKafka::Message::Status status() const override { return MSG_STATUS_NOT_PERSISTED; }
+    RdKafka::Headers* headers() override { return nullptr; }
+    RdKafka::Headers* headers(RdKafka::ErrorCode* err) override { return nullptr; }
+    int32_t broker_id() const override { return -1; }
+
+private:
+    int32_t _partition;
+    int64_t _offset;
+    std::string _payload;
+    bool* _deleted;
+};
+
 class KafkaConsumerPipeTest : public testing::Test {
 public:
     KafkaConsumerPipeTest() {}
@@ -63,4 +106,131 @@ TEST_F(KafkaConsumerPipeTest, append_read) {
     EXPECT_EQ(eof, true);
 }
 
+TEST_F(KafkaConsumerPipeTest, append_json_read_one_buffer) {
+    KafkaConsumerPipe k_pipe(1024 * 1024, 64 * 1024);
+
+    bool deleted1 = false;
+    bool deleted2 = false;
+    auto* msg1 = new FakeKafkaMessage(0, 10, R"({"k1": 1})", &deleted1);
+    auto* msg2 = new FakeKafkaMessage(1, 20, R"({"k1": 2, "k2": "v2"})", &deleted2);
+    const char* payload1 = static_cast<const char*>(msg1->payload());
+    auto consumer = std::make_shared<int>(0);
+    EXPECT_TRUE(k_pipe.append_json(msg1, consumer).ok());
+    EXPECT_TRUE(k_pipe.append_json(msg2, consumer).ok());
+    EXPECT_TRUE(k_pipe.finish().ok());
+    // the consumer is kept alive by the msgs in pipe
+    EXPECT_EQ(3, consumer.use_count());
+
+    // the payload is read as it is in the msg, which is deleted with the buffer
+    ByteBufferPtr buf;
+    EXPECT_TRUE(k_pipe.read_one_buffer(&buf).ok());
+    ASSERT_TRUE(buf != nullptr);
+    EXPECT_EQ(payload1, buf->ptr + buf->pos);
+    EXPECT_EQ(R"({"k1": 1})", std::string(buf->ptr + buf->pos, buf->remaining()));
+    EXPECT_FALSE(deleted1);
+    buf.reset();
+    EXPECT_TRUE(deleted1);
+    EXPECT_EQ(2, consumer.use_count());
+
+    // read_one_message still copies the payload
+    std::unique_ptr<uint8_t[]> data;
+    int64_t length = 0;
+    EXPECT_TRUE(k_pipe.read_one_message(&data, &length).ok());
+    EXPECT_EQ(R"({"k1": 2, "k2": "v2"})", std::string((char*)data.get(), length));
+    EXPECT_TRUE(deleted2);
+    EXPECT_EQ(1, consumer.use_count());
+
+    EXPECT_TRUE(k_pipe.read_one_buffer(&buf).ok());
+    EXPECT_TRUE(buf == nullptr);
+}
+
+TEST_F(KafkaConsumerPipeTest, append_batch) {
+    bool deleted[6] = {false};
+    auto create_batch = [&deleted]() {
+        auto batch = std::make_unique<KafkaMessageBatch>();
+        for (int i = 0; i < 6; ++i) {
+            deleted[i] = false;
+            // 10 bytes for each msg, in partition 0 and 1 alternately
+            batch->messages.emplace_back(new FakeKafkaMessage(
+                    i % 2, 100 + i, "{\"k\": " + std::to_string(100 + i) + "}", &deleted[i]));
+        }
+        return batch;
+    };
+
+    // the rows left run out
+    {
+        KafkaConsumerPipe k_pipe(1024 * 1024, 64 * 1024);
+        KafkaConsumeProgress progress;
+        progress.left_rows = 4;
+        progress.left_bytes = 1000;
+        progress.cmt_offset[0] = 50;
+        auto batch = create_batch();
+        EXPECT_TRUE(KafkaDataConsumerGroup::_append_batch(batch.get(), &k_pipe, true, &progress)
+                            .ok());
+        EXPECT_EQ(0, progress.left_rows);
+        EXPECT_EQ(960, progress.left_bytes);
+        EXPECT_EQ(102, progress.cmt_offset[0]);
+        EXPECT_EQ(103, progress.cmt_offset[1]);
+        EXPECT_EQ(2, progress.partition_rows[0]);
+        EXPECT_EQ(2, progress.partition_rows[1]);
+        EXPECT_EQ(20, progress.partition_bytes[0]);
+        EXPECT_EQ(20, progress.partition_bytes[1]);
+        EXPECT_TRUE(k_pipe.finish().ok());
+
+        ByteBufferPtr buf;
+        for (int i = 0; i < 4; ++i) {
+            EXPECT_TRUE(k_pipe.read_one_buffer(&buf).ok());
+            ASSERT_TRUE(buf != nullptr);
+            EXPECT_EQ("{\"k\": " + std::to_string(100 + i) + "}",
+                      std::string(buf->ptr + buf->pos, buf->remaining()));
+        }
+        EXPECT_TRUE(k_pipe.read_one_buffer(&buf).ok());
+        EXPECT_TRUE(buf == nullptr);
+        // the msgs not loaded are left in the batch
+        EXPECT_TRUE(batch->messages[0] == nullptr);
+        EXPECT_TRUE(batch->messages[4] != nullptr);
+        batch.reset();
+        for (int i = 0; i < 6; ++i) {
+            EXPECT_TRUE(deleted[i]);
+        }
+    }
+
+    // the bytes left run out, the msg exceeding them is still loaded
+    {
+        KafkaConsumerPipe k_pipe(1024 * 1024, 64 * 1024);
+        KafkaConsumeProgress progress;
+        progress.left_rows = 100;
+        progress.left_bytes = 25;
+        auto batch = create_batch();
+        EXPECT_TRUE(KafkaDataConsumerGroup::_append_batch(batch.get(), &k_pipe, false, &progress)
+                            .ok());
+        EXPECT_EQ(97, progress.left_rows);
+        EXPECT_EQ(-5, progress.left_bytes);
+        EXPECT_EQ(102, progress.cmt_offset[0]);
+        EXPECT_EQ(101, progress.cmt_offset[1]);
+        EXPECT_TRUE(k_pipe.finish().ok());
+
+        // csv msgs are copied with the line delimiter
+        char buf[1024];
+        int64_t read_bytes = 0;
+        bool eof = false;
+        EXPECT_TRUE(k_pipe.read((uint8_t*)buf, sizeof(buf), &read_bytes, &eof).ok());
+        EXPECT_EQ("{\"k\": 100}\n{\"k\": 101}\n{\"k\": 102}\n", std::string(buf, read_bytes));
+    }
+
+    // nothing is loaded into a cancelled pipe
+    {
+        KafkaConsumerPipe k_pipe(1024 * 1024, 64 * 1024);
+        k_pipe.cancel("test");
+        KafkaConsumeProgress progress;
+        progress.left_rows = 100;
+        progress.left_bytes = 1000;
+        auto batch = create_batch();
+        EXPECT_FALSE(KafkaDataConsumerGroup::_append_batch(batch.get(), &k_pipe, true, &progress)
+                             .ok());
+        EXPECT_EQ(100, progress.left_rows);
+        EXPECT_TRUE(progress.cmt_offset.empty());
+    }
+}
+
 } // namespace doris
@@ -0,0 +1,438 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/point_query_executor.h"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "gen_cpp/AgentService_types.h"
+#include "olap/options.h"
+#include "olap/rowset/rowset_writer.h"
+#include "olap/storage_engine.h"
+#include "olap/tablet_manager.h"
+#include "olap/utils.h"
+#include "runtime/exec_env.h"
+#include "util/file_utils.h"
+#include "vec/core/block.h"
+
+namespace doris {
+
+static std::shared_ptr<const PreparedPointLookup> make_lookup(int64_t tablet_id) {
+    auto lookup = std::make_shared<PreparedPointLookup>();
+    lookup->tablet_id = tablet_id;
+    return lookup;
+}
+
+TEST(PreparedPointLookupCacheTest, get_and_put) {
+    PreparedPointLookupCache cache(2);
+    EXPECT_TRUE(cache.get("a") == nullptr);
+
+    cache.put("a", make_lookup(1));
+    cache.put("b", make_lookup(2));
+    EXPECT_EQ(1, cache.get("a")->tablet_id);
+    EXPECT_EQ(2, cache.get("b")->tablet_id);
+
+    // replace an existing one
+    cache.put("a", make_lookup(3));
+    EXPECT_EQ(3, cache.get("a")->tablet_id);
+    EXPECT_EQ(2, cache.size());
+}
+
+TEST(PreparedPointLookupCacheTest, evict_least_recently_used) {
+    PreparedPointLookupCache cache(2);
+    cache.put("a", make_lookup(1));
+    cache.put("b", make_lookup(2));
+    // "a" is used after "b"
+    EXPECT_TRUE(cache.get("a") != nullptr);
+
+    cache.put("c", make_lookup(3));
+    EXPECT_EQ(2, cache.size());
+    EXPECT_TRUE(cache.get("b") == nullptr);
+    EXPECT_EQ(1, cache.get("a")->tablet_id);
+    EXPECT_EQ(3, cache.get("c")->tablet_id);
+}
+
+static const uint32_t MAX_PATH_LEN = 1024;
+static const int32_t SCHEMA_HASH = 1111;
+
+// A row of the tablets looked up by the tests, (k1 INT, k2 VARCHAR(20)) are the keys and
+// (v1 INT, v2 VARCHAR(20)) are the values, followed by the delete sign of unique keys tablets.
+struct LookupTestRow {
+    int32_t k1;
+    std::string k2;
+    int32_t v1;
+    std::string v2;
+    int8_t delete_sign = 0;
+};
+
+class PointQueryExecutorTest : public testing::Test {
+public:
+    static void SetUpTestSuite() {
+        char buffer[MAX_PATH_LEN];
+        EXPECT_NE(getcwd(buffer, MAX_PATH_LEN), nullptr);
+        config::storage_root_path = std::string(buffer) + "/data_test";
+        FileUtils::remove_all(config::storage_root_path);
+        FileUtils::create_dir(config::storage_root_path);
+        std::vector<StorePath> paths;
+        paths.emplace_back(config::storage_root_path, -1);
+
+        EngineOptions options;
+        options.store_paths = paths;
+        Status s = StorageEngine::open(options, &_engine);
+        EXPECT_TRUE(s.ok()) << s.to_string();
+        ExecEnv::GetInstance()->set_storage_engine(_engine);
+    }
+
+    static void TearDownTestSuite() {
+        if (_engine != nullptr) {
+            _engine->stop();
+            delete _engine;
+            _engine = nullptr;
+        }
+        FileUtils::remove_all(config::storage_root_path);
+    }
+
+protected:
+    static TColumn create_column(const std::string& name, TPrimitiveType::type type, bool is_key,
+                                 TKeysType::type keys_type) {
+        TColumn column;
+        column.column_name = name;
+        column.column_type.type = type;
+        if (type == TPrimitiveType::VARCHAR) {
+            column.column_type.__set_len(20);
+        }
+        column.__set_is_key(is_key);
+        if (!is_key) {
+            column.__set_aggregation_type(keys_type == TKeysType::UNIQUE_KEYS
+                                                  ? TAggregationType::REPLACE
+                                                  : TAggregationType::NONE);
+        }
+        return column;
+    }
+
+    // creates a tablet of version 1, unique keys tablets have a delete sign column, and the
+    // tablet has a row store column at last if `store_rows` is true
+    static TabletSharedPtr create_tablet(int64_t tablet_id, TKeysType::type keys_type,
+                                         bool store_rows = false) {
+        TCreateTabletReq request;
+        request.tablet_id = tablet_id;
+        request.__set_version(1);
+        request.tablet_schema.schema_hash = SCHEMA_HASH;
+        request.tablet_schema.short_key_column_count = 2;
+        request.tablet_schema.keys_type = keys_type;
+        request.tablet_schema.storage_type = TStorageType::COLUMN;
+        request.__set_storage_format(TStorageFormat::V2);
+        auto& columns = request.tablet_schema.columns;
+        columns.push_back(create_column("k1", TPrimitiveType::INT, true, keys_type));
+        columns.push_back(create_column("k2", TPrimitiveType::VARCHAR, true, keys_type));
+        columns.push_back(create_column("v1", TPrimitiveType::INT, false, keys_type));
+        columns.push_back(create_column("v2", TPrimitiveType::VARCHAR, false, keys_type));
+        if (keys_type == TKeysType::UNIQUE_KEYS) {
+            request.tablet_schema.__set_delete_sign_idx(columns.size());
+            columns.push_back(create_column(DELETE_SIGN, TPrimitiveType::TINYINT, false,
+                                            keys_type));
+        }
+        if (store_rows) {
+            request.tablet_schema.__set_row_store_col_idx(columns.size());
+            columns.push_back(create_column("__DORIS_ROW_STORE_COL__", TPrimitiveType::STRING,
+                                            false, keys_type));
+            columns.back().__set_is_allow_null(true);
+        }
+        Status s = _engine->create_tablet(request);
+        EXPECT_TRUE(s.ok()) << s.to_string();
+        return _engine->tablet_manager()->get_tablet(tablet_id);
+    }
+
+    // writes the rows, which are sorted by keys, as a rowset of the version
+    static void write_rowset(const TabletSharedPtr& tablet, int64_t version,
+                             const std::vector<LookupTestRow>& rows) {
+        const TabletSchema& schema = tablet->tablet_schema();
+        std::vector<uint32_t> column_ids;
+        for (uint32_t cid = 0; cid < schema.num_columns(); ++cid) {
+            column_ids.push_back(cid);
+        }
+        vectorized::Block block = schema.create_block(column_ids);
+        auto columns = block.mutate_columns();
+        for (const auto& row : rows) {
+            columns[0]->insert_data(reinterpret_cast<const char*>(&row.k1), sizeof(row.k1));
+            columns[1]->insert_data(row.k2.data(), row.k2.size());
+            columns[2]->insert_data(reinterpret_cast<const char*>(&row.v1), sizeof(row.v1));
+            columns[3]->insert_data(row.v2.data(), row.v2.size());
+            if (schema.delete_sign_idx() != -1) {
+                columns[schema.delete_sign_idx()]->insert_data(
+                        reinterpret_cast<const char*>(&row.delete_sign), sizeof(row.delete_sign));
+            }
+            // the row store column is encoded by the segment writer
+            if (schema.row_store_col_idx() != -1) {
+                columns[schema.row_store_col_idx()]->insert_default();
+            }
+        }
+        block.set_columns(std::move(columns));
+
+        std::unique_ptr<RowsetWriter> writer;
+        Status s = tablet->create_rowset_writer(Version(version, version), VISIBLE,
+                                                NONOVERLAPPING, &writer);
+        ASSERT_TRUE(s.ok()) << s.to_string();
+        ASSERT_TRUE(writer->add_block(&block).ok());
+        ASSERT_TRUE(writer->flush().ok());
+        RowsetSharedPtr rowset = writer->build();
+        ASSERT_TRUE(rowset != nullptr);
+        s = tablet->add_rowset(rowset);
+        ASSERT_TRUE(s.ok()) << s.to_string();
+    }
+
+    static PTabletKeyLookupRequest create_request(int64_t tablet_id,
+                                                  const std::vector<std::string>& keys,
+                                                  const std::vector<std::string>& columns = {}) {
+        PTabletKeyLookupRequest request;
+        request.set_tablet_id(tablet_id);
+        for (const auto& key : keys) {
+            request.add_key_tuple(key);
+        }
+        for (const auto& column : columns) {
+            request.add_columns(column);
+        }
+        return request;
+    }
+
+    static StorageEngine* _engine;
+};
+
+StorageEngine* PointQueryExecutorTest::_engine = nullptr;
+
+TEST_F(PointQueryExecutorTest, lookup) {
+    const int64_t tablet_id = 15001;
+    TabletSharedPtr tablet = create_tablet(tablet_id, TKeysType::UNIQUE_KEYS);
+    ASSERT_TRUE(tablet != nullptr);
+    write_rowset(tablet, 2, {{1, "a", 10, "x"}, {2, "b", 20, "y"}, {3, "c", 30, "z"}});
+    // updates key 1 and deletes key 2
+    write_rowset(tablet, 3, {{1, "a", 11, "xx"}, {2, "b", 20, "y", 1}});
+
+    PointQueryExecutor executor;
+    {
+        // the key is only in one version, all the columns but the delete sign are returned
+        PTabletKeyLookupResponse response;
+        ASSERT_TRUE(executor.lookup(create_request(tablet_id, {"3", "c"}), &response).ok());
+        EXPECT_EQ(3, response.version());
+        vectorized::Block block(response.row_block());
+        ASSERT_EQ(4, block.columns());
+        ASSERT_EQ(1, block.rows());
+        EXPECT_EQ("k1", block.get_by_position(0).name);
+        EXPECT_EQ("v2", block.get_by_position(3).name);
+        EXPECT_EQ(3, block.get_by_position(0).column->get_int(0));
+        EXPECT_EQ("c", block.get_by_position(1).column->get_data_at(0).to_string());
+        EXPECT_EQ(30, block.get_by_position(2).column->get_int(0));
+        EXPECT_EQ("z", block.get_by_position(3).column->get_data_at(0).to_string());
+    }
+    {
+        // the versions of the key are merged, the last one is returned
+        PTabletKeyLookupResponse response;
+        ASSERT_TRUE(executor.lookup(create_request(tablet_id, {"1", "a"}), &response).ok());
+        vectorized::Block block(response.row_block());
+        ASSERT_EQ(1, block.rows());
+        EXPECT_EQ(11, block.get_by_position(2).column->get_int(0));
+        EXPECT_EQ("xx", block.get_by_position(3).column->get_data_at(0).to_string());
+
+        // an earlier version is read up to it
+        PTabletKeyLookupRequest request = create_request(tablet_id, {"1", "a"});
+        request.set_version(2);
+        PTabletKeyLookupResponse old_response;
+        ASSERT_TRUE(executor.lookup(request, &old_response).ok());
+        EXPECT_EQ(2, old_response.version());
+        vectorized::Block old_block(old_response.row_block());
+        ASSERT_EQ(1, old_block.rows());
+        EXPECT_EQ(10, old_block.get_by_position(2).column->get_int(0));
+        EXPECT_EQ("x", old_block.get_by_position(3).column->get_data_at(0).to_string());
+    }
+    {
+        // the last version of the key is deleted
+        PTabletKeyLookupResponse response;
+        ASSERT_TRUE(executor.lookup(create_request(tablet_id, {"2", "b"}), &response).ok());
+        vectorized::Block block(response.row_block());
+        EXPECT_EQ(4, block.columns());
+        EXPECT_EQ(0, block.rows());
+
+        PTabletKeyLookupRequest request = create_request(tablet_id, {"2", "b"});
+        request.set_version(2);
+        PTabletKeyLookupResponse old_response;
+        ASSERT_TRUE(executor.lookup(request, &old_response).ok());
+        vectorized::Block old_block(old_response.row_block());
+        ASSERT_EQ(1, old_block.rows());
+        EXPECT_EQ(20, old_block.get_by_position(2).column->get_int(0));
+    }
+    {
+        // a key not in the tablet
+        PTabletKeyLookupResponse response;
+        ASSERT_TRUE(executor.lookup(create_request(tablet_id, {"4", "d"}), &response).ok());
+        EXPECT_EQ(0, vectorized::Block(response.row_block()).rows());
+    }
+    {
+        // the columns are returned in the requested order
+        PTabletKeyLookupResponse response;
+        ASSERT_TRUE(
+                executor.lookup(create_request(tablet_id, {"1", "a"}, {"v2", "k1"}), &response)
+                        .ok());
+        vectorized::Block block(response.row_block());
+        ASSERT_EQ(2, block.columns());
+        ASSERT_EQ(1, block.rows());
+        EXPECT_EQ("v2", block.get_by_position(0).name);
+        EXPECT_EQ("k1", block.get_by_position(1).name);
+        EXPECT_EQ("xx", block.get_by_position(0).column->get_data_at(0).to_string());
+        EXPECT_EQ(1, block.get_by_position(1).column->get_int(0));
+    }
+    {
+        PTabletKeyLookupResponse response;
+        EXPECT_TRUE(executor.lookup(create_request(tablet_id, {"1", "a"}, {"v3"}), &response)
+                            .is_invalid_argument());
+    }
+    EXPECT_TRUE(_engine->tablet_manager()->drop_tablet(tablet_id).ok());
+}
+
+TEST_F(PointQueryExecutorTest, lookup_row_store) {
+    const int64_t tablet_id = 15004;
+    TabletSharedPtr tablet = create_tablet(tablet_id, TKeysType::UNIQUE_KEYS, true);
+    ASSERT_TRUE(tablet != nullptr);
+    write_rowset(tablet, 2, {{1, "a", 10, "x"}, {2, "b", 20, "y"}, {3, "c", 30, "z"}});
+    write_rowset(tablet, 3, {{1, "a", 11, "xx"}, {2, "b", 20, "y", 1}});
+
+    // the rows are decoded from the row store column if more than one value column is returned
+    std::shared_ptr<PreparedPointLookup> prepared;
+    google::protobuf::RepeatedPtrField<std::string> columns;
+    ASSERT_TRUE(PointQueryExecutor::_prepare(tablet, columns, &prepared).ok());
+    EXPECT_TRUE(prepared->use_row_store);
+    columns.Add("v1");
+    std::shared_ptr<PreparedPointLookup> single_column;
+    ASSERT_TRUE(PointQueryExecutor::_prepare(tablet, columns, &single_column).ok());
+    EXPECT_FALSE(single_column->use_row_store);
+
+    PointQueryExecutor executor;
+    {
+        PTabletKeyLookupResponse response;
+        ASSERT_TRUE(executor.lookup(create_request(tablet_id, {"1", "a"}), &response).ok());
+        vectorized::Block block(response.row_block());
+        ASSERT_EQ(4, block.columns());
+        ASSERT_EQ(1, block.rows());
+        EXPECT_EQ(1, block.get_by_position(0).column->get_int(0));
+        EXPECT_EQ("a", block.get_by_position(1).column->get_data_at(0).to_string());
+        EXPECT_EQ(11, block.get_by_position(2).column->get_int(0));
+        EXPECT_EQ("xx", block.get_by_position(3).column->get_data_at(0).to_string());
+    }
+    {
+        // the deleted key is filtered by the delete sign read with the row store column
+        PTabletKeyLookupResponse response;
+        ASSERT_TRUE(executor.lookup(create_request(tablet_id, {"2", "b"}), &response).ok());
+        EXPECT_EQ(0, vectorized::Block(response.row_block()).rows());
+    }
+    {
+        PTabletKeyLookupResponse response;
+        ASSERT_TRUE(
+                executor.lookup(create_request(tablet_id, {"3", "c"}, {"v2", "v1"}), &response)
+                        .ok());
+        vectorized::Block block(response.row_block());
+        ASSERT_EQ(2, block.columns());
+        ASSERT_EQ(1, block.rows());
+        EXPECT_EQ("z", block.get_by_position(0).column->get_data_at(0).to_string());
+        EXPECT_EQ(30, block.get_by_position(1).column->get_int(0));
+    }
+    EXPECT_TRUE(_engine->tablet_manager()->drop_tablet(tablet_id).ok());
+}
+
+TEST_F(PointQueryExecutorTest, decode_rows_fallback) {
+    const int64_t tablet_id = 15005;
+    TabletSharedPtr tablet = create_tablet(tablet_id, TKeysType::UNIQUE_KEYS, true);
+    ASSERT_TRUE(tablet != nullptr);
+    const TabletSchema& schema = tablet->tablet_schema();
+    std::shared_ptr<PreparedPointLookup> prepared;
+    google::protobuf::RepeatedPtrField<std::string> columns;
+    columns.Add("v2");
+    columns.Add("v1");
+    ASSERT_TRUE(PointQueryExecutor::_prepare(tablet, columns, &prepared).ok());
+    ASSERT_TRUE(prepared->use_row_store);
+
+    // a row encoded by the codec of the tablet
+    std::vector<uint32_t> column_ids;
+    for (uint32_t cid = 0; cid < schema.num_columns(); ++cid) {
+        column_ids.push_back(cid);
+    }
+    vectorized::Block block = schema.create_block(column_ids);
+    auto block_columns = block.mutate_columns();
+    int32_t k1 = 1;
+    int32_t v1 = 10;
+    int8_t delete_sign = 0;
+    block_columns[0]->insert_data(reinterpret_cast<const char*>(&k1), sizeof(k1));
+    block_columns[1]->insert_data("a", 1);
+    block_columns[2]->insert_data(reinterpret_cast<const char*>(&v1), sizeof(v1));
+    block_columns[3]->insert_data("x", 1);
+    block_columns[4]->insert_data(reinterpret_cast<const char*>(&delete_sign),
+                                  sizeof(delete_sign));
+    block_columns[5]->insert_default();
+    block.set_columns(std::move(block_columns));
+    auto encoded = prepared->row_store_codec->encode(block, 0, 1);
+
+    // the delete sign read with the row store column is filtered out before the rows are decoded
+    vectorized::Block rows = prepared->row_store_plan.block.clone_empty();
+    ASSERT_EQ(2, rows.columns());
+    rows.erase(1);
+    auto row_columns = rows.mutate_columns();
+    row_columns[0]->insert_data(encoded->get_data_at(0).data, encoded->get_data_at(0).size);
+    rows.set_columns(std::move(row_columns));
+    vectorized::Block result;
+    ASSERT_TRUE(PointQueryExecutor::_decode_rows(*prepared, rows, &result));
+    ASSERT_EQ(2, result.columns());
+    ASSERT_EQ(1, result.rows());
+    EXPECT_EQ("x", result.get_by_position(0).column->get_data_at(0).to_string());
+    EXPECT_EQ(10, result.get_by_position(1).column->get_int(0));
+
+    // a row not stored, e.g. written column group by column group, falls back to the columns
+    row_columns = rows.mutate_columns();
+    row_columns[0]->insert_default();
+    rows.set_columns(std::move(row_columns));
+    vectorized::Block fallback_result;
+    EXPECT_FALSE(PointQueryExecutor::_decode_rows(*prepared, rows, &fallback_result));
+    EXPECT_EQ(0, fallback_result.columns());
+    EXPECT_TRUE(_engine->tablet_manager()->drop_tablet(tablet_id).ok());
+}
+
+TEST_F(PointQueryExecutorTest, invalid_lookup) {
+    const int64_t tablet_id = 15002;
+    TabletSharedPtr tablet = create_tablet(tablet_id, TKeysType::UNIQUE_KEYS);
+    ASSERT_TRUE(tablet != nullptr);
+    const int64_t dup_tablet_id = 15003;
+    TabletSharedPtr dup_tablet = create_tablet(dup_tablet_id, TKeysType::DUP_KEYS);
+    ASSERT_TRUE(dup_tablet != nullptr);
+
+    PointQueryExecutor executor;
+    PTabletKeyLookupResponse response;
+    // the value of every key column is required
+    EXPECT_TRUE(executor.lookup(create_request(tablet_id, {"1"}), &response)
+                        .is_invalid_argument());
+    EXPECT_TRUE(executor.lookup(create_request(tablet_id, {"1", "a", "x"}), &response)
+                        .is_invalid_argument());
+    EXPECT_TRUE(executor.lookup(create_request(20000, {"1", "a"}), &response).is_not_found());
+    // a key of a duplicate keys tablet may have several rows
+    EXPECT_TRUE(executor.lookup(create_request(dup_tablet_id, {"1", "a"}), &response)
+                        .is_invalid_argument());
+
+    EXPECT_TRUE(_engine->tablet_manager()->drop_tablet(tablet_id).ok());
+    EXPECT_TRUE(_engine->tablet_manager()->drop_tablet(dup_tablet_id).ok());
+}
+
+} // namespace doris
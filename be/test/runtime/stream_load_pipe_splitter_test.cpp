@@ -0,0 +1,165 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/stream_load/stream_load_pipe_splitter.h"
+
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "util/runtime_profile.h"
+
+namespace doris {
+
+class StreamLoadPipeSplitterTest : public testing::Test {
+public:
+    StreamLoadPipeSplitterTest() : _profile("TestProfile") {}
+
+protected:
+    // split body into num_pipes pipes, read all of them at the same time and return the
+    // lines of every pipe
+    std::vector<std::vector<std::string>> split(const std::string& body,
+                                                CompressType compress_type, int skip_lines,
+                                                int num_pipes) {
+        auto source = std::make_shared<StreamLoadPipe>(1024, 64);
+        StreamLoadPipeSplitter splitter(&_profile, source, compress_type, "\n", skip_lines,
+                                        num_pipes, 64);
+        EXPECT_TRUE(splitter.start().ok());
+
+        std::vector<std::string> contents(num_pipes);
+        std::vector<std::thread> readers;
+        for (int i = 0; i < num_pipes; ++i) {
+            readers.emplace_back([&splitter, &contents, i] {
+                uint8_t buf[100];
+                int64_t read_bytes = 0;
+                bool eof = false;
+                while (true) {
+                    EXPECT_TRUE(splitter.pipes()[i]->read(buf, 100, &read_bytes, &eof).ok());
+                    if (eof) {
+                        break;
+                    }
+                    contents[i].append((const char*)buf, read_bytes);
+                }
+            });
+        }
+        for (size_t pos = 0; pos < body.size(); pos += 37) {
+            size_t len = std::min<size_t>(37, body.size() - pos);
+            EXPECT_TRUE(source->append(body.data() + pos, len).ok());
+        }
+        EXPECT_TRUE(source->finish().ok());
+        for (auto& reader : readers) {
+            reader.join();
+        }
+
+        std::vector<std::vector<std::string>> lines(num_pipes);
+        for (int i = 0; i < num_pipes; ++i) {
+            // every pipe holds whole lines
+            EXPECT_TRUE(contents[i].empty() || contents[i].back() == '\n');
+            size_t start = 0;
+            while (start < contents[i].size()) {
+                size_t end = contents[i].find('\n', start);
+                lines[i].push_back(contents[i].substr(start, end - start));
+                start = end + 1;
+            }
+        }
+        return lines;
+    }
+
+    RuntimeProfile _profile;
+};
+
+static std::vector<std::string> make_lines(int num_lines) {
+    std::vector<std::string> lines;
+    for (int i = 0; i < num_lines; ++i) {
+        lines.push_back(std::to_string(i) + "," + std::string(i % 150, 'a' + i % 26));
+    }
+    return lines;
+}
+
+static std::string join_lines(const std::vector<std::string>& lines) {
+    std::string body;
+    for (const auto& line : lines) {
+        body.append(line).push_back('\n');
+    }
+    return body;
+}
+
+static void check_lines(std::vector<std::string> expected,
+                        const std::vector<std::vector<std::string>>& split_lines) {
+    std::vector<std::string> lines;
+    for (const auto& pipe_lines : split_lines) {
+        // the lines of a pipe keep their order in the body
+        std::vector<std::string> sorted = pipe_lines;
+        std::sort(sorted.begin(), sorted.end(), [](const std::string& a, const std::string& b) {
+            return std::stoi(a) < std::stoi(b);
+        });
+        EXPECT_EQ(sorted, pipe_lines);
+        lines.insert(lines.end(), pipe_lines.begin(), pipe_lines.end());
+    }
+    std::sort(lines.begin(), lines.end());
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(expected, lines);
+}
+
+TEST_F(StreamLoadPipeSplitterTest, split_plain) {
+    auto lines = make_lines(1000);
+    auto split_lines = split(join_lines(lines), CompressType::UNCOMPRESSED, 0, 3);
+    for (const auto& pipe_lines : split_lines) {
+        EXPECT_FALSE(pipe_lines.empty());
+    }
+    check_lines(lines, split_lines);
+}
+
+TEST_F(StreamLoadPipeSplitterTest, skip_header_and_no_last_delimiter) {
+    auto lines = make_lines(100);
+    std::string body = "k1,k2\n" + join_lines(lines);
+    body.pop_back();
+    check_lines(lines, split(body, CompressType::UNCOMPRESSED, 1, 4));
+}
+
+TEST_F(StreamLoadPipeSplitterTest, split_compressed) {
+    auto lines = make_lines(1000);
+    std::string body = join_lines(lines);
+    uLongf compressed_size = compressBound(body.size());
+    std::string compressed(compressed_size, '\0');
+    ASSERT_EQ(Z_OK, compress2((Bytef*)compressed.data(), &compressed_size,
+                              (const Bytef*)body.data(), body.size(), Z_DEFAULT_COMPRESSION));
+    compressed.resize(compressed_size);
+    check_lines(lines, split(compressed, CompressType::GZIP, 0, 2));
+}
+
+TEST_F(StreamLoadPipeSplitterTest, cancel) {
+    auto source = std::make_shared<StreamLoadPipe>(1024, 64);
+    StreamLoadPipeSplitter splitter(&_profile, source, CompressType::UNCOMPRESSED, "\n", 0, 2,
+                                    64);
+    EXPECT_TRUE(splitter.start().ok());
+    std::string body = join_lines(make_lines(10));
+    EXPECT_TRUE(source->append(body.data(), body.size()).ok());
+
+    // the pipes are not read, the splitter blocks until cancelled
+    splitter.cancel("test");
+    uint8_t buf[100];
+    int64_t read_bytes = 0;
+    bool eof = false;
+    EXPECT_FALSE(splitter.pipes()[0]->read(buf, 100, &read_bytes, &eof).ok());
+}
+
+} // namespace doris
@@ -19,6 +19,7 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
 #include <thread>
 
 namespace doris {
@@ -258,4 +259,18 @@ TEST_F(StreamLoadPipeTest, close) {
     t1.join();
 }
 
+TEST_F(StreamLoadPipeTest, read_one_buffer) {
+    // the whole body of a stream load with known length is read as one buffer
+    std::string body = "0123456789abcdefghij";
+    StreamLoadPipe pipe(66, 8, body.size());
+    EXPECT_TRUE(pipe.append(body.data(), 10).ok());
+    EXPECT_TRUE(pipe.append(body.data() + 10, 10).ok());
+    EXPECT_TRUE(pipe.finish().ok());
+
+    ByteBufferPtr buf;
+    EXPECT_TRUE(pipe.read_one_buffer(&buf).ok());
+    ASSERT_TRUE(buf != nullptr);
+    EXPECT_EQ(body, std::string(buf->ptr + buf->pos, buf->remaining()));
+}
+
 } // namespace doris
@@ -31,6 +31,8 @@
 
 #include "common/compiler_util.h"
 #include "common/logging.h"
+#include "exprs/json_functions.h"
+#include "exprs/simd_json_reader.h"
 #include "gutil/strings/split.h"
 #include "gutil/strings/substitute.h"
 #include "olap/comparison_predicate.h"
@@ -55,14 +57,22 @@
 #include "testutil/test_util.h"
 #include "util/debug_util.h"
 #include "util/file_utils.h"
+#include "vec/columns/column_vector.h"
+#include "vec/common/arena.h"
+#include "vec/common/columns_hashing.h"
+#include "vec/common/hash_table/hash.h"
+#include "vec/common/hash_table/hash_map.h"
 
 DEFINE_string(operation, "Custom",
               "valid operation: Custom, BinaryDictPageEncode, BinaryDictPageDecode, SegmentScan, "
               "SegmentWrite, "
-              "SegmentScanByFile, SegmentWriteByFile");
+              "SegmentScanByFile, SegmentWriteByFile, JsonExtract, HashJoinBuild, "
+              "HashJoinProbe, HashAgg");
 DEFINE_string(input_file, "./sample.dat", "input file directory");
 DEFINE_string(column_type, "int,varchar", "valid type: int, char, varchar, string");
 DEFINE_string(rows_number, "10000", "rows number");
+DEFINE_string(cardinality, "1000,1000000",
+              "numbers of distinct keys of hash table benchmarks, separated by comma");
 DEFINE_string(iterations, "10",
               "run times, this is set to 0 means the number of iterations is automatically set ");
 
@@ -87,6 +97,13 @@ std::string get_usage(const std::string& progname) {
           "--iterations=10\n";
     ss << "./benchmark_tool --operation=SegmentWriteByFile --input_file=./sample.dat "
           "--iterations=10\n";
+    ss << "./benchmark_tool --operation=JsonExtract --rows_number=10000 --iterations=10\n";
+    ss << "./benchmark_tool --operation=HashJoinBuild --rows_number=1000000 "
+          "--cardinality=1000,1000000 --iterations=10\n";
+    ss << "./benchmark_tool --operation=HashJoinProbe --rows_number=1000000 "
+          "--cardinality=1000,1000000 --iterations=10\n";
+    ss << "./benchmark_tool --operation=HashAgg --rows_number=1000000 "
+          "--cardinality=1000,1000000 --iterations=10\n";
 
     ss << "Sampe data file format: \n"
        << "The first line defines Shcema\n"
@@ -567,6 +584,208 @@ void custom_run_mod() {
     }
 }
 
+// Extract a field from 2KB event records, by rapidjson document and by simdjson on demand.
+// Call method: ./benchmark_tool --operation=JsonExtract --rows_number=10000 --iterations=10
+class JsonExtractBenchmark : public BaseBenchmark {
+public:
+    JsonExtractBenchmark(const std::string& name, int iterations, int rows_num, bool use_simdjson)
+            : BaseBenchmark(name, iterations), _rows_num(rows_num), _use_simdjson(use_simdjson) {
+        add_name(use_simdjson ? "/simdjson" : "/rapidjson");
+        JsonFunctions::parse_json_paths("$.context.device.os", &_parsed_paths);
+        SimdJsonReader::to_json_pointer(_parsed_paths, &_json_pointer);
+    }
+    virtual ~JsonExtractBenchmark() override {}
+
+    virtual void init() override {
+        if (!_records.empty()) {
+            return;
+        }
+        std::mt19937 rng(0);
+        for (int i = 0; i < _rows_num; ++i) {
+            _records.push_back(make_record(i, rng));
+        }
+    }
+
+    virtual void run() override {
+        size_t found_bytes = 0;
+        for (const auto& record : _records) {
+            if (_use_simdjson) {
+                simdjson::ondemand::value value;
+                std::string_view os;
+                if (_reader.find(record, _json_pointer, &value) == simdjson::SUCCESS &&
+                    value.get_string().get(os) == simdjson::SUCCESS) {
+                    found_bytes += os.size();
+                }
+            } else {
+                rapidjson::Document document;
+                document.Parse(record.data(), record.size());
+                rapidjson::Value* value = JsonFunctions::get_json_object_from_parsed_json(
+                        _parsed_paths, &document, document.GetAllocator());
+                if (value != nullptr && value->IsString()) {
+                    found_bytes += value->GetStringLength();
+                }
+            }
+        }
+        benchmark::DoNotOptimize(found_bytes);
+    }
+
+private:
+    // an event record of about 2KB, the extracted field is after the properties
+    static std::string make_record(int id, std::mt19937& rng) {
+        static const char* os_names[] = {"android", "ios", "windows", "macos", "linux"};
+        auto random_string = [&rng](size_t len) {
+            std::string str(len, 'a');
+            for (auto& c : str) {
+                c = 'a' + rng() % 26;
+            }
+            return str;
+        };
+
+        std::stringstream ss;
+        ss << "{\"event_id\":" << id << ",\"event_type\":\"" << random_string(8)
+           << "\",\"timestamp\":" << 1650000000000L + id << ",\"user_id\":\""
+           << random_string(16) << "\",\"properties\":{";
+        for (int i = 0; i < 24; ++i) {
+            ss << (i == 0 ? "" : ",") << "\"prop_" << i << "\":\"" << random_string(40)
+               << "\"";
+        }
+        ss << "},\"context\":{\"ip\":\"10.0." << rng() % 256 << "." << rng() % 256
+           << "\",\"device\":{\"os\":\"" << os_names[rng() % 5] << "\",\"model\":\""
+           << random_string(12) << "\",\"screen\":[1920,1080]},\"app\":{\"version\":\"1."
+           << rng() % 10 << "\",\"channel\":\"" << random_string(10) << "\"}},\"tags\":[";
+        for (int i = 0; i < 8; ++i) {
+            ss << (i == 0 ? "" : ",") << "\"" << random_string(24) << "\"";
+        }
+        ss << "],\"duration\":" << (rng() % 100000) / 100.0 << "}";
+        return ss.str();
+    }
+
+    int _rows_num;
+    bool _use_simdjson;
+    std::vector<JsonPath> _parsed_paths;
+    std::string _json_pointer;
+    SimdJsonReader _reader;
+    std::vector<std::string> _records;
+};
+
+// Join build, join probe and group by on a UInt64 key hashed by CRC32, one row at a time and by
+// batched hashing with prefetch.
+// Call method: ./benchmark_tool --operation=HashJoinBuild --rows_number=1000000
+//              --cardinality=1000,1000000 --iterations=10
+class HashTableBenchmark : public BaseBenchmark {
+public:
+    enum Mode { JOIN_BUILD, JOIN_PROBE, AGGREGATE };
+
+    using UInt64 = vectorized::UInt64;
+    // the mapped value is the row number in join and the count in aggregation
+    using HashTable = HashMap<UInt64, UInt64, HashCRC32<UInt64>>;
+    using State = vectorized::ColumnsHashing::HashMethodOneNumber<HashTable::value_type, UInt64,
+                                                                  UInt64, false>;
+
+    HashTableBenchmark(const std::string& name, int iterations, int rows_num, int cardinality,
+                       Mode mode, bool batched)
+            : BaseBenchmark(name, iterations),
+              _rows_num(rows_num),
+              _cardinality(cardinality),
+              _mode(mode),
+              _batched(batched) {
+        add_name("/cardinality:" + std::to_string(cardinality));
+        add_name(batched ? "/batched" : "/row_by_row");
+    }
+    virtual ~HashTableBenchmark() override {}
+
+    virtual void init() override {
+        if (!_keys) {
+            std::mt19937_64 rng(0);
+            auto keys = vectorized::ColumnUInt64::create();
+            for (int i = 0; i < _rows_num; ++i) {
+                keys->insert_value(rng() % _cardinality);
+            }
+            _keys = std::move(keys);
+        }
+        if (_mode == JOIN_PROBE) {
+            if (_hash_table.empty()) {
+                // half of the probe keys are found
+                for (UInt64 key = 0; key < _cardinality; key += 2) {
+                    _hash_table.insert({key, key});
+                }
+            }
+        } else {
+            _hash_table = HashTable();
+        }
+    }
+
+    virtual void run() override {
+        vectorized::ColumnRawPtrs key_columns {_keys.get()};
+        size_t rows = _keys->size();
+        size_t found = 0;
+        State state(key_columns, {}, nullptr);
+        if (_mode == JOIN_BUILD) {
+            _hash_table.expanse_for_add_elem(rows);
+            if (_batched) {
+                state.get_hash_values(_hash_table, rows, _arena, _hash_values);
+            }
+            for (size_t i = 0; i < rows; ++i) {
+                if (_batched) {
+                    if (i + HASH_TABLE_PREFETCH_DIST < rows) {
+                        state.prefetch_by_hash<false>(_hash_table,
+                                                      _hash_values[i + HASH_TABLE_PREFETCH_DIST]);
+                    }
+                    found += state.emplace_key(_hash_table, _hash_values[i], i, _arena)
+                                     .is_inserted();
+                } else {
+                    found += state.emplace_key(_hash_table, i, _arena).is_inserted();
+                    if (i + 1 < rows) {
+                        state.prefetch(_hash_table, i + 1, _arena);
+                    }
+                }
+            }
+        } else if (_mode == JOIN_PROBE) {
+            if (_batched) {
+                state.get_hash_values(_hash_table, rows, _arena, _hash_values);
+            }
+            for (size_t i = 0; i < rows; ++i) {
+                if (_batched) {
+                    if (i + HASH_TABLE_PREFETCH_DIST < rows) {
+                        state.prefetch_by_hash<true>(_hash_table,
+                                                     _hash_values[i + HASH_TABLE_PREFETCH_DIST]);
+                    }
+                    found += state.find_key(_hash_table, _hash_values[i], i, _arena).is_found();
+                } else {
+                    found += state.find_key(_hash_table, i, _arena).is_found();
+                }
+            }
+        } else {
+            if (_batched) {
+                state.get_hash_values(_hash_table, rows, _arena, _hash_values);
+            }
+            for (size_t i = 0; i < rows; ++i) {
+                if (_batched) {
+                    if (i + HASH_TABLE_PREFETCH_DIST < rows) {
+                        state.prefetch_by_hash<false>(_hash_table,
+                                                      _hash_values[i + HASH_TABLE_PREFETCH_DIST]);
+                    }
+                    ++state.emplace_key(_hash_table, _hash_values[i], i, _arena).get_mapped();
+                } else {
+                    ++state.emplace_key(_hash_table, i, _arena).get_mapped();
+                }
+            }
+            found = _hash_table.size();
+        }
+        benchmark::DoNotOptimize(found);
+    }
+
+private:
+    int _rows_num;
+    UInt64 _cardinality;
+    Mode _mode;
+    bool _batched;
+    vectorized::ColumnPtr _keys;
+    HashTable _hash_table;
+    vectorized::Arena _arena;
+    std::vector<size_t> _hash_values;
+};
+
 class MultiBenchmark {
 public:
     MultiBenchmark() {}
@@ -604,6 +823,29 @@ public:
         } else if (equal_ignore_case(FLAGS_operation, "SegmentWriteByFile")) {
             benchmarks.emplace_back(new doris::SegmentWriteByFileBenchmark(
                     FLAGS_operation, std::stoi(FLAGS_iterations), FLAGS_input_file));
+        } else if (equal_ignore_case(FLAGS_operation, "JsonExtract")) {
+            benchmarks.emplace_back(new doris::JsonExtractBenchmark(
+                    FLAGS_operation, std::stoi(FLAGS_iterations), std::stoi(FLAGS_rows_number),
+                    false));
+            benchmarks.emplace_back(new doris::JsonExtractBenchmark(
+                    FLAGS_operation, std::stoi(FLAGS_iterations), std::stoi(FLAGS_rows_number),
+                    true));
+        } else if (equal_ignore_case(FLAGS_operation, "HashJoinBuild") ||
+                   equal_ignore_case(FLAGS_operation, "HashJoinProbe") ||
+                   equal_ignore_case(FLAGS_operation, "HashAgg")) {
+            auto mode = equal_ignore_case(FLAGS_operation, "HashJoinBuild")
+                                ? doris::HashTableBenchmark::JOIN_BUILD
+                                : equal_ignore_case(FLAGS_operation, "HashJoinProbe")
+                                          ? doris::HashTableBenchmark::JOIN_PROBE
+                                          : doris::HashTableBenchmark::AGGREGATE;
+            std::vector<std::string> cardinalities = strings::Split(FLAGS_cardinality, ",");
+            for (const std::string& cardinality : cardinalities) {
+                for (bool batched : {false, true}) {
+                    benchmarks.emplace_back(new doris::HashTableBenchmark(
+                            FLAGS_operation, std::stoi(FLAGS_iterations),
+                            std::stoi(FLAGS_rows_number), std::stoi(cardinality), mode, batched));
+                }
+            }
         } else {
             std::cout << "operation invalid!" << std::endl;
         }
@@ -0,0 +1,100 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "util/arrow/block_convertor.h"
+
+#define ARROW_UTIL_LOGGING_H
+#include <arrow/array.h>
+#include <arrow/memory_pool.h>
+#include <arrow/record_batch.h>
+#include <arrow/type.h>
+
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris {
+
+TEST(ArrowBlockConvertorTest, Normal) {
+    auto int_column = vectorized::ColumnInt32::create();
+    auto null_map = vectorized::ColumnUInt8::create();
+    auto string_column = vectorized::ColumnString::create();
+    for (int i = 0; i < 5; ++i) {
+        int_column->insert_value(i * 10);
+        null_map->insert_value(i % 2);
+        std::string str = "str" + std::to_string(i);
+        string_column->insert_data(str.data(), str.size());
+    }
+    auto const_nested = vectorized::ColumnInt64::create();
+    const_nested->insert_value(42);
+
+    auto int_type = std::make_shared<vectorized::DataTypeInt32>();
+    vectorized::Block block(
+            {{vectorized::ColumnNullable::create(std::move(int_column), std::move(null_map)),
+              vectorized::make_nullable(int_type), "c1"},
+             {std::move(string_column), std::make_shared<vectorized::DataTypeString>(), "c2"},
+             {vectorized::ColumnConst::create(std::move(const_nested), 5),
+              std::make_shared<vectorized::DataTypeInt64>(), "c3"}});
+
+    auto schema = arrow::schema({arrow::field("c1", arrow::int32(), true),
+                                 arrow::field("c2", arrow::utf8(), false),
+                                 arrow::field("c3", arrow::int64(), false)});
+    std::shared_ptr<arrow::RecordBatch> record_batch;
+    auto st = convert_to_arrow_batch(block, schema, arrow::default_memory_pool(), &record_batch);
+    ASSERT_TRUE(st.ok());
+    ASSERT_EQ(5, record_batch->num_rows());
+
+    auto c1 = std::static_pointer_cast<arrow::Int32Array>(record_batch->column(0));
+    auto c2 = std::static_pointer_cast<arrow::StringArray>(record_batch->column(1));
+    auto c3 = std::static_pointer_cast<arrow::Int64Array>(record_batch->column(2));
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(i % 2 == 1, c1->IsNull(i));
+        if (i % 2 == 0) {
+            EXPECT_EQ(i * 10, c1->Value(i));
+        }
+        EXPECT_EQ("str" + std::to_string(i), c2->GetString(i));
+        EXPECT_EQ(42, c3->Value(i));
+    }
+}
+
+TEST(ArrowBlockConvertorTest, TypeMismatch) {
+    auto column = vectorized::ColumnInt32::create();
+    column->insert_value(1);
+    vectorized::Block block(
+            {{std::move(column), std::make_shared<vectorized::DataTypeInt32>(), "c1"}});
+
+    std::shared_ptr<arrow::RecordBatch> record_batch;
+    auto schema = arrow::schema({arrow::field("c1", arrow::int64(), false)});
+    EXPECT_FALSE(
+            convert_to_arrow_batch(block, schema, arrow::default_memory_pool(), &record_batch)
+                    .ok());
+    schema = arrow::schema({arrow::field("c1", arrow::int32(), false),
+                            arrow::field("c2", arrow::int32(), false)});
+    EXPECT_FALSE(
+            convert_to_arrow_batch(block, schema, arrow::default_memory_pool(), &record_batch)
+                    .ok());
+}
+
+} // namespace doris
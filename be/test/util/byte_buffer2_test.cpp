@@ -49,4 +49,24 @@ TEST_F(ByteBufferTest, normal) {
     EXPECT_EQ(3, buf->remaining());
 }
 
+TEST_F(ByteBufferTest, wrap) {
+    char data[] = {1, 2, 3};
+    bool released = false;
+    {
+        auto buf = ByteBuffer::wrap(data, 3, [&released]() { released = true; });
+        EXPECT_EQ(data, buf->ptr);
+        EXPECT_EQ(0, buf->pos);
+        EXPECT_EQ(3, buf->limit);
+        EXPECT_EQ(3, buf->remaining());
+
+        char out[3];
+        buf->get_bytes(out, 3);
+        EXPECT_EQ(2, out[1]);
+        EXPECT_FALSE(buf->has_remaining());
+        EXPECT_FALSE(released);
+    }
+    // the wrapped memory is released by the owner, not freed by the buffer
+    EXPECT_TRUE(released);
+}
+
 } // namespace doris
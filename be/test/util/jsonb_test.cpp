@@ -0,0 +1,113 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/jsonb.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <string>
+
+namespace doris {
+
+class JsonbTest : public testing::Test {
+public:
+    JsonbTest() {}
+
+    static std::string to_jsonb(const std::string& json) {
+        std::string jsonb;
+        EXPECT_TRUE(JsonbDocument::from_json(json.data(), json.size(), &jsonb).ok());
+        return jsonb;
+    }
+
+    static std::string round_trip(const std::string& json) {
+        std::string jsonb = to_jsonb(json);
+        return JsonbDocument::to_json_string(jsonb.data(), jsonb.size());
+    }
+};
+
+TEST_F(JsonbTest, round_trip) {
+    EXPECT_EQ("null", round_trip("null"));
+    EXPECT_EQ("true", round_trip(" true "));
+    EXPECT_EQ("-1", round_trip("-1"));
+    EXPECT_EQ("18446744073709551615", round_trip("18446744073709551615"));
+    EXPECT_EQ("1.5", round_trip("1.5"));
+    EXPECT_EQ("\"a\\\"b\"", round_trip("\"a\\\"b\""));
+    EXPECT_EQ("[]", round_trip("[ ]"));
+    EXPECT_EQ("{}", round_trip("{ }"));
+    // members keep the order of input
+    EXPECT_EQ(R"({"k2":[1,{"k3":null},"v"],"k1":false})",
+              round_trip(R"({"k2": [1, {"k3": null}, "v"], "k1": false})"));
+}
+
+TEST_F(JsonbTest, invalid) {
+    std::string jsonb;
+    std::string json = "{\"k1\": ";
+    EXPECT_FALSE(JsonbDocument::from_json(json.data(), json.size(), &jsonb).ok());
+
+    JsonbValue root;
+    EXPECT_FALSE(JsonbDocument::get_root("", 0, &root).ok());
+    jsonb = to_jsonb("[1, 2]");
+    EXPECT_FALSE(JsonbDocument::get_root(jsonb.data(), jsonb.size() - 1, &root).ok());
+    jsonb[0] = JsonbDocument::VERSION + 1;
+    EXPECT_FALSE(JsonbDocument::get_root(jsonb.data(), jsonb.size(), &root).ok());
+    EXPECT_EQ("null", JsonbDocument::to_json_string(jsonb.data(), jsonb.size()));
+}
+
+TEST_F(JsonbTest, number) {
+    std::string jsonb = to_jsonb("[-9223372036854775808, 18446744073709551615, 2.5, 3]");
+    JsonbValue root;
+    ASSERT_TRUE(JsonbDocument::get_root(jsonb.data(), jsonb.size(), &root).ok());
+    ASSERT_EQ(4, root.count());
+
+    EXPECT_EQ(JsonbType::INT64, root.array_at(0).type());
+    EXPECT_EQ(std::numeric_limits<int64_t>::min(), root.array_at(0).get_int64());
+    EXPECT_EQ(JsonbType::UINT64, root.array_at(1).type());
+    EXPECT_EQ(std::numeric_limits<uint64_t>::max(), root.array_at(1).get_uint64());
+    EXPECT_EQ(JsonbType::DOUBLE, root.array_at(2).type());
+    EXPECT_DOUBLE_EQ(2.5, root.array_at(2).get_double());
+    EXPECT_EQ(JsonbType::INT64, root.array_at(3).type());
+    EXPECT_DOUBLE_EQ(3, root.array_at(3).get_number());
+}
+
+TEST_F(JsonbTest, find) {
+    std::string jsonb = to_jsonb(R"({"k2": {"k3": [1, "v3"]}, "k1": "v1", "k0": 0, "k1": 2})");
+    JsonbValue root;
+    ASSERT_TRUE(JsonbDocument::get_root(jsonb.data(), jsonb.size(), &root).ok());
+    ASSERT_TRUE(root.is_object());
+    EXPECT_EQ(4, root.count());
+
+    JsonbValue value;
+    // the first one of duplicated keys
+    ASSERT_TRUE(root.find_key("k1", &value));
+    ASSERT_TRUE(value.is_string());
+    EXPECT_EQ("v1", value.get_string());
+    ASSERT_TRUE(root.find_key("k0", &value));
+    EXPECT_EQ(0, value.get_int64());
+    EXPECT_FALSE(root.find_key("k", &value));
+    EXPECT_FALSE(root.find_key("k4", &value));
+
+    ASSERT_TRUE(root.find_key("k2", &value));
+    ASSERT_TRUE(value.find_key("k3", &value));
+    ASSERT_TRUE(value.is_array());
+    ASSERT_EQ(2, value.count());
+    EXPECT_EQ(1, value.array_at(0).get_int64());
+    EXPECT_EQ("v3", value.array_at(1).get_string());
+    EXPECT_EQ("[1,\"v3\"]", value.to_json_string());
+}
+
+} // namespace doris
@@ -0,0 +1,109 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/aggregate_functions/window_segment_tree.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "vec/aggregate_functions/aggregate_function_simple_factory.h"
+#include "vec/columns/column_vector.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris::vectorized {
+// declare function
+void register_aggregate_function_sum(AggregateFunctionSimpleFactory& factory);
+void register_aggregate_function_minmax(AggregateFunctionSimpleFactory& factory);
+
+class WindowSegmentTreeTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        register_aggregate_function_sum(factory);
+        register_aggregate_function_minmax(factory);
+        column = ColumnInt32::create();
+        for (int i = 0; i < 1000; ++i) {
+            column->insert_value((i * 7919) % 1013 - 500);
+        }
+    }
+
+    AggregateFunctionSimpleFactory factory;
+    ColumnInt32::MutablePtr column;
+};
+
+TEST_F(WindowSegmentTreeTest, min_frames) {
+    DataTypes data_types = {std::make_shared<DataTypeInt32>()};
+    auto function = factory.get("min", data_types, {});
+    std::unique_ptr<char[]> memory(new char[function->size_of_data()]);
+    AggregateDataPtr place = memory.get();
+    function->create(place);
+
+    const auto& data = column->get_data();
+    WindowSegmentTree tree(function.get(), {column.get()}, 100, 900);
+    for (int64_t start = 90; start < 910; start += 37) {
+        for (int64_t end = start + 1; end < 920; end += 53) {
+            function->reset(place);
+            tree.aggregate(place, start, end);
+            ColumnInt32 result;
+            function->insert_result_into(place, result);
+            int64_t first = std::max<int64_t>(start, 100);
+            int64_t last = std::min<int64_t>(end, 900);
+            EXPECT_EQ(*std::min_element(data.begin() + first, data.begin() + last),
+                      result.get_element(0));
+        }
+    }
+    function->destroy(place);
+}
+
+TEST_F(WindowSegmentTreeTest, sum_matches_remove) {
+    DataTypes data_types = {std::make_shared<DataTypeInt32>()};
+    auto function = factory.get("sum", data_types, {});
+    ASSERT_TRUE(function->is_removable());
+    std::unique_ptr<char[]> tree_memory(new char[function->size_of_data()]);
+    std::unique_ptr<char[]> sliding_memory(new char[function->size_of_data()]);
+    AggregateDataPtr tree_place = tree_memory.get();
+    AggregateDataPtr sliding_place = sliding_memory.get();
+    function->create(tree_place);
+    function->create(sliding_place);
+
+    // a frame of [5 preceding, 3 following] slid over the whole column
+    const IColumn* columns[1] = {column.get()};
+    WindowSegmentTree tree(function.get(), {column.get()}, 0, column->size());
+    int64_t frame_start = 0;
+    int64_t frame_end = 0;
+    for (int64_t row = 0; row < column->size(); ++row) {
+        int64_t start = std::max<int64_t>(row - 5, 0);
+        int64_t end = std::min<int64_t>(row + 4, column->size());
+        for (; frame_start < start; ++frame_start) {
+            function->remove(sliding_place, columns, frame_start, nullptr);
+        }
+        for (; frame_end < end; ++frame_end) {
+            function->add(sliding_place, columns, frame_end, nullptr);
+        }
+
+        function->reset(tree_place);
+        tree.aggregate(tree_place, start, end);
+        ColumnInt64 result;
+        function->insert_result_into(tree_place, result);
+        function->insert_result_into(sliding_place, result);
+        EXPECT_EQ(result.get_element(0), result.get_element(1));
+    }
+    function->destroy(tree_place);
+    function->destroy(sliding_place);
+}
+
+} // namespace doris::vectorized
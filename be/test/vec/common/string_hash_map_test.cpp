@@ -0,0 +1,106 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/common/hash_table/string_hash_map.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "vec/columns/column_string.h"
+
+namespace doris::vectorized {
+
+TEST(StringHashMapTest, EmplaceFindIterate) {
+    // keys of every sub table, the column keeps the bytes after a key readable
+    std::vector<std::string> keys = {"",
+                                     "a",
+                                     "abcdefgh",
+                                     "abcdefghi",
+                                     "abcdefghijklmnop",
+                                     "abcdefghijklmnopq",
+                                     "abcdefghijklmnopqrstuvwx",
+                                     "abcdefghijklmnopqrstuvwxy",
+                                     std::string("ab\0", 3),
+                                     std::string("abcdefghijklmnopqrstuvw\0", 24)};
+    auto column = ColumnString::create();
+    for (const auto& key : keys) {
+        column->insert_data(key.data(), key.size());
+    }
+
+    StringHashMap<int> map;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        map[column->get_data_at(i)] = i;
+    }
+    EXPECT_EQ(keys.size(), map.size());
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        StringRef key = column->get_data_at(i);
+        auto* mapped = map.find(key);
+        ASSERT_NE(nullptr, mapped);
+        EXPECT_EQ(static_cast<int>(i), *mapped);
+        EXPECT_EQ(mapped, map.find(key, map.hash(key)));
+
+        StringHashMap<int>::LookupResult it;
+        bool inserted = true;
+        map.emplace(key, it, inserted, map.hash(key));
+        EXPECT_FALSE(inserted);
+        EXPECT_EQ(mapped, it);
+    }
+
+    auto missing = ColumnString::create();
+    for (const std::string& key : {"b", "abcdefgz", "ab", "abcdefghijklmnopqrstuvwxz"}) {
+        missing->insert_data(key.data(), key.size());
+    }
+    for (size_t i = 0; i < missing->size(); ++i) {
+        EXPECT_EQ(nullptr, map.find(missing->get_data_at(i)));
+    }
+
+    std::map<std::string, int> iterated;
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        iterated.emplace(it->get_first().to_string(), it->get_second());
+    }
+    ASSERT_EQ(keys.size(), iterated.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(static_cast<int>(i), iterated[keys[i]]);
+    }
+}
+
+TEST(StringHashMapTest, Grow) {
+    auto column = ColumnString::create();
+    for (int i = 0; i < 10000; ++i) {
+        std::string key = std::to_string(i) + std::string(i % 40, 'x');
+        column->insert_data(key.data(), key.size());
+    }
+
+    StringHashMap<int> map;
+    for (size_t i = 0; i < column->size(); ++i) {
+        ++map[column->get_data_at(i)];
+    }
+    EXPECT_EQ(column->size(), map.size());
+
+    size_t count = 0;
+    map.for_each_mapped([&](int& mapped) {
+        EXPECT_EQ(1, mapped);
+        ++count;
+    });
+    EXPECT_EQ(column->size(), count);
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,82 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/common/hash_table/two_level_hash_map.h"
+
+#include <gtest/gtest.h>
+
+#include "vec/common/hash_table/hash.h"
+
+namespace doris::vectorized {
+
+using FlatMap = HashMap<UInt64, UInt64, HashCRC32<UInt64>>;
+using TwoLevelMap = TwoLevelHashMap<UInt64, UInt64, HashCRC32<UInt64>>;
+
+TEST(TwoLevelHashMapTest, ConvertFromFlat) {
+    FlatMap flat;
+    // 0 is the zero key, which is stored out of the buffer of the flat map
+    for (UInt64 i = 0; i < 100000; ++i) {
+        flat[i] = i * 2;
+    }
+
+    TwoLevelMap map(flat);
+    EXPECT_EQ(flat.size(), map.size());
+    for (UInt64 i = 0; i < 100000; ++i) {
+        auto* cell = map.find(i);
+        ASSERT_NE(nullptr, cell);
+        EXPECT_EQ(i * 2, cell->get_second());
+        EXPECT_EQ(cell, map.find(i, map.hash(i)));
+    }
+    EXPECT_EQ(nullptr, map.find(100000));
+
+    size_t count = 0;
+    UInt64 sum = 0;
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        ++count;
+        sum += it->get_second();
+    }
+    EXPECT_EQ(flat.size(), count);
+    EXPECT_EQ(99999ULL * 100000, sum);
+}
+
+TEST(TwoLevelHashMapTest, EmplaceIntoBuckets) {
+    TwoLevelMap map;
+    for (UInt64 i = 0; i < 10000; ++i) {
+        TwoLevelMap::LookupResult it;
+        bool inserted;
+        map.emplace(i, it, inserted, map.hash(i));
+        EXPECT_TRUE(inserted);
+        new (lookup_result_get_mapped(it)) UInt64(i);
+    }
+    EXPECT_EQ(10000, map.size());
+
+    // every key is in the bucket of its hash, so the buckets can be iterated independently
+    size_t count = 0;
+    for (size_t bucket = 0; bucket < TwoLevelMap::NUM_BUCKETS; ++bucket) {
+        auto& impl = map.impls[bucket];
+        for (auto it = impl.begin(); it != impl.end(); ++it) {
+            EXPECT_EQ(bucket, TwoLevelMap::get_bucket_from_hash(map.hash(it->get_first())));
+            ++count;
+        }
+    }
+    EXPECT_EQ(10000, count);
+
+    map.clear_and_shrink();
+    EXPECT_TRUE(map.empty());
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,342 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/join/vhash_join_node.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+#include "common/object_pool.h"
+#include "gen_cpp/Descriptors_types.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptors.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/exec/block_source_node.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+using Key = std::optional<std::string>;
+// the key and the value of the probe row and of the build row, which are NULL for the probe rows
+// without a match of a left outer join
+using JoinedRow = std::tuple<Key, int64_t, Key, std::optional<int64_t>>;
+
+} // namespace
+
+class VHashJoinNodeTest : public testing::Test {
+public:
+    VHashJoinNodeTest() : _runtime_state(TQueryGlobals()) {
+        _runtime_state._instance_mem_tracker.reset(new MemTracker());
+        _runtime_state._query_options.enable_vectorized_engine = true;
+        _runtime_state._query_options.batch_size = 1024;
+    }
+
+protected:
+    void SetUp() override { init_desc_table(); }
+
+    static TTypeDesc create_type_desc(TPrimitiveType::type type) {
+        TTypeDesc type_desc;
+        TTypeNode node;
+        node.__set_type(TTypeNodeType::SCALAR);
+        TScalarType scalar_type;
+        scalar_type.__set_type(type);
+        node.__set_scalar_type(scalar_type);
+        type_desc.types.push_back(node);
+        return type_desc;
+    }
+
+    static TExprNode create_slot_ref(TPrimitiveType::type type, int slot_id, int tuple_id,
+                                     bool is_nullable) {
+        TExprNode node;
+        node.node_type = TExprNodeType::SLOT_REF;
+        node.type = create_type_desc(type);
+        node.num_children = 0;
+        node.output_scale = -1;
+        TSlotRef slot_ref;
+        slot_ref.slot_id = slot_id;
+        slot_ref.tuple_id = tuple_id;
+        node.__set_slot_ref(slot_ref);
+        node.__set_is_nullable(is_nullable);
+        return node;
+    }
+
+    // tuple 0 is the probe side (pk STRING NULL, pv BIGINT), tuple 1 is the build side
+    // (bk STRING NULL, bv BIGINT) of "SELECT * FROM probe JOIN build ON pk = bk"
+    void init_desc_table() {
+        TDescriptorTable t_desc_table;
+        std::vector<TPrimitiveType::type> types = {TPrimitiveType::STRING, TPrimitiveType::BIGINT};
+        int next_slot_id = 0;
+        for (int tuple_id = 0; tuple_id < 2; ++tuple_id) {
+            int byte_offset = 1;
+            for (size_t i = 0; i < types.size(); ++i) {
+                TSlotDescriptor slot_desc;
+                slot_desc.id = next_slot_id++;
+                slot_desc.parent = tuple_id;
+                slot_desc.slotType = create_type_desc(types[i]);
+                slot_desc.columnPos = i;
+                slot_desc.byteOffset = byte_offset;
+                slot_desc.nullIndicatorByte = 0;
+                slot_desc.nullIndicatorBit = i == 0 ? 0 : -1;
+                slot_desc.colName = std::string(tuple_id == 0 ? "p" : "b") + (i == 0 ? "k" : "v");
+                slot_desc.slotIdx = i;
+                slot_desc.isMaterialized = true;
+                t_desc_table.slotDescriptors.push_back(slot_desc);
+                byte_offset += i == 0 ? 16 : 8;
+            }
+
+            TTupleDescriptor t_tuple_desc;
+            t_tuple_desc.id = tuple_id;
+            t_tuple_desc.byteSize = byte_offset;
+            t_tuple_desc.numNullBytes = 1;
+            t_desc_table.tupleDescriptors.push_back(t_tuple_desc);
+        }
+        t_desc_table.__isset.slotDescriptors = true;
+
+        DescriptorTbl::create(&_obj_pool, t_desc_table, &_desc_tbl);
+        _runtime_state.set_desc_tbl(_desc_tbl);
+    }
+
+    static TPlanNode create_join_plan_node(TJoinOp::type join_op) {
+        TPlanNode tnode;
+        tnode.node_id = 2;
+        tnode.node_type = TPlanNodeType::HASH_JOIN_NODE;
+        tnode.num_children = 2;
+        tnode.limit = -1;
+        tnode.row_tuples.push_back(0);
+        tnode.row_tuples.push_back(1);
+        tnode.nullable_tuples.push_back(false);
+        tnode.nullable_tuples.push_back(join_op == TJoinOp::LEFT_OUTER_JOIN);
+        tnode.compact_data = true;
+
+        TEqJoinCondition eq_join_conjunct;
+        eq_join_conjunct.left.nodes.push_back(create_slot_ref(TPrimitiveType::STRING, 0, 0, true));
+        eq_join_conjunct.right.nodes.push_back(
+                create_slot_ref(TPrimitiveType::STRING, 2, 1, true));
+        tnode.hash_join_node.join_op = join_op;
+        tnode.hash_join_node.eq_join_conjuncts.push_back(eq_join_conjunct);
+        tnode.__isset.hash_join_node = true;
+        return tnode;
+    }
+
+    static TPlanNode create_source_plan_node(int node_id, int tuple_id) {
+        TPlanNode tnode;
+        tnode.node_id = node_id;
+        tnode.node_type = TPlanNodeType::EXCHANGE_NODE;
+        tnode.num_children = 0;
+        tnode.limit = -1;
+        tnode.row_tuples.push_back(tuple_id);
+        tnode.nullable_tuples.push_back(false);
+        tnode.compact_data = true;
+        return tnode;
+    }
+
+    // the value of the i-th key is i
+    static std::vector<Block> create_input_blocks(const std::vector<Key>& keys,
+                                                  size_t rows_per_block) {
+        std::vector<Block> blocks;
+        for (size_t begin = 0; begin < keys.size(); begin += rows_per_block) {
+            auto key_column = ColumnString::create();
+            auto null_map = ColumnUInt8::create();
+            auto values = ColumnInt64::create();
+            for (size_t i = begin; i < std::min(begin + rows_per_block, keys.size()); ++i) {
+                if (keys[i].has_value()) {
+                    key_column->insert_data(keys[i]->data(), keys[i]->size());
+                    null_map->insert_value(0);
+                } else {
+                    key_column->insert_default();
+                    null_map->insert_value(1);
+                }
+                values->insert_value(i);
+            }
+            Block block;
+            block.insert({ColumnNullable::create(std::move(key_column), std::move(null_map)),
+                          make_nullable(std::make_shared<DataTypeString>()), "k"});
+            block.insert({std::move(values), std::make_shared<DataTypeInt64>(), "v"});
+            blocks.push_back(std::move(block));
+        }
+        return blocks;
+    }
+
+    // the keys of every sub map of StringHashMap: the empty key, the keys of 1..8, 9..16, 17..24
+    // and more bytes, and the keys ending with a zero byte, which are kept as long keys. "a" and
+    // the empty key are duplicated.
+    static std::vector<Key> create_build_keys() {
+        return {"",
+                "a",
+                "ab",
+                std::string("ab\0", 3),
+                "abcdefgh",
+                "abcdefghi",
+                std::string(16, 'x'),
+                std::string(17, 'x'),
+                std::string("abcdefghijklmnop\0", 17),
+                std::string(24, 'y'),
+                std::string(25, 'y'),
+                std::string(100, 'z'),
+                std::nullopt,
+                "a",
+                "",
+                std::nullopt};
+    }
+
+    // the build keys in another order, keys which only differ from a build key in their length
+    // or their last byte, and NULL keys
+    static std::vector<Key> create_probe_keys() {
+        return {"ab",
+                "",
+                std::string("ab\0", 3),
+                "abcdefghi",
+                "abcdefgh",
+                "abcdefghij",
+                std::string(17, 'x'),
+                std::string(16, 'x'),
+                "abcdefghijklmnop",
+                std::string(25, 'y'),
+                std::string(24, 'y'),
+                std::string(100, 'z'),
+                std::string(99, 'z'),
+                std::nullopt,
+                "a",
+                "zz",
+                std::nullopt};
+    }
+
+    // joins the probe rows with the build rows one by one, NULL keys never match
+    static std::vector<JoinedRow> expected_rows(const std::vector<Key>& probe_keys,
+                                                const std::vector<Key>& build_keys,
+                                                bool left_outer) {
+        std::vector<JoinedRow> rows;
+        for (size_t p = 0; p < probe_keys.size(); ++p) {
+            bool matched = false;
+            for (size_t b = 0; b < build_keys.size(); ++b) {
+                if (probe_keys[p].has_value() && probe_keys[p] == build_keys[b]) {
+                    rows.emplace_back(probe_keys[p], p, build_keys[b], b);
+                    matched = true;
+                }
+            }
+            if (left_outer && !matched) {
+                rows.emplace_back(probe_keys[p], p, std::nullopt, std::nullopt);
+            }
+        }
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    static Key get_key(const ColumnPtr& column, size_t row) {
+        if (column->is_null_at(row)) {
+            return std::nullopt;
+        }
+        return column->get_data_at(row).to_string();
+    }
+
+    static std::optional<int64_t> get_value(const ColumnPtr& column, size_t row) {
+        if (column->is_null_at(row)) {
+            return std::nullopt;
+        }
+        if (const auto* nullable = check_and_get_column<ColumnNullable>(*column)) {
+            return nullable->get_nested_column().get_int(row);
+        }
+        return column->get_int(row);
+    }
+
+    std::vector<JoinedRow> join(TJoinOp::type join_op, const std::vector<Key>& probe_keys,
+                                const std::vector<Key>& build_keys) {
+        TPlanNode probe_tnode = create_source_plan_node(0, 0);
+        auto* probe = _obj_pool.add(new BlockSourceNode(&_obj_pool, probe_tnode, *_desc_tbl,
+                                                        create_input_blocks(probe_keys, 4)));
+        EXPECT_TRUE(probe->init(probe_tnode, &_runtime_state).ok());
+        TPlanNode build_tnode = create_source_plan_node(1, 1);
+        auto* build = _obj_pool.add(new BlockSourceNode(&_obj_pool, build_tnode, *_desc_tbl,
+                                                        create_input_blocks(build_keys, 5)));
+        EXPECT_TRUE(build->init(build_tnode, &_runtime_state).ok());
+
+        std::vector<JoinedRow> rows;
+        TPlanNode join_tnode = create_join_plan_node(join_op);
+        HashJoinNode join_node(&_obj_pool, join_tnode, *_desc_tbl);
+        join_node._children.push_back(probe);
+        join_node._children.push_back(build);
+        EXPECT_TRUE(join_node.init(join_tnode, &_runtime_state).ok());
+        EXPECT_TRUE(join_node.prepare(&_runtime_state).ok());
+        // the NULL build keys never match, so the build keys are kept in a StringHashMap
+        EXPECT_TRUE(std::holds_alternative<StringHashTableContext>(join_node._hash_table_variants));
+        EXPECT_TRUE(join_node.open(&_runtime_state).ok());
+
+        bool eos = false;
+        while (!eos) {
+            Block block;
+            Status st = join_node.get_next(&_runtime_state, &block, &eos);
+            EXPECT_TRUE(st.ok()) << st;
+            if (!st.ok()) {
+                break;
+            }
+            if (block.rows() == 0) {
+                continue;
+            }
+            EXPECT_EQ(4, block.columns());
+            for (size_t i = 0; i < block.rows(); ++i) {
+                rows.emplace_back(get_key(block.get_by_position(0).column, i),
+                                  *get_value(block.get_by_position(1).column, i),
+                                  get_key(block.get_by_position(2).column, i),
+                                  get_value(block.get_by_position(3).column, i));
+            }
+        }
+        EXPECT_TRUE(join_node.close(&_runtime_state).ok());
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    RuntimeState _runtime_state;
+    ObjectPool _obj_pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+};
+
+TEST_F(VHashJoinNodeTest, inner_join_on_string_key) {
+    std::vector<Key> probe_keys = create_probe_keys();
+    std::vector<Key> build_keys = create_build_keys();
+    std::vector<JoinedRow> rows = join(TJoinOp::INNER_JOIN, probe_keys, build_keys);
+    std::vector<JoinedRow> expected = expected_rows(probe_keys, build_keys, false);
+    // "" and "a" match two build rows, 9 other probe keys match one
+    EXPECT_EQ(13, expected.size());
+    EXPECT_EQ(expected, rows);
+}
+
+TEST_F(VHashJoinNodeTest, left_outer_join_on_string_key) {
+    std::vector<Key> probe_keys = create_probe_keys();
+    std::vector<Key> build_keys = create_build_keys();
+    std::vector<JoinedRow> rows = join(TJoinOp::LEFT_OUTER_JOIN, probe_keys, build_keys);
+    std::vector<JoinedRow> expected = expected_rows(probe_keys, build_keys, true);
+    // the 4 probe keys without a match and the 2 NULL probe keys are output with NULLs
+    EXPECT_EQ(13 + 6, expected.size());
+    EXPECT_EQ(expected, rows);
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,115 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/text_column_deserializer.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "runtime/decimalv2_value.h"
+#include "util/binary_cast.hpp"
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_vector.h"
+#include "vec/runtime/vdatetime_value.h"
+
+namespace doris::vectorized {
+
+static ColumnPtr deserialize(PrimitiveType type, const std::vector<std::string>& texts,
+                             NullMap* src_null_map) {
+    auto deserializer = TextColumnDeserializer::create(TypeDescriptor(type));
+    EXPECT_TRUE(deserializer != nullptr);
+    std::vector<Slice> values;
+    for (const auto& text : texts) {
+        values.emplace_back(text);
+    }
+    auto column = deserializer->deserialize(values.data(), values.size(), src_null_map);
+    EXPECT_EQ(texts.size(), column->size());
+    return column;
+}
+
+TEST(TextColumnDeserializerTest, int_values) {
+    NullMap src_null_map;
+    auto column = deserialize(TYPE_INT, {"1", "-20", "\\N", "abc", "2147483648", "3.5"},
+                              &src_null_map);
+    const auto& nullable = assert_cast<const ColumnNullable&>(*column);
+    const auto& data = assert_cast<const ColumnInt32&>(nullable.get_nested_column()).get_data();
+    EXPECT_FALSE(nullable.is_null_at(0));
+    EXPECT_EQ(1, data[0]);
+    EXPECT_FALSE(nullable.is_null_at(1));
+    EXPECT_EQ(-20, data[1]);
+    // the null marker, an invalid value, an overflow and a fraction
+    EXPECT_TRUE(nullable.is_null_at(2));
+    EXPECT_TRUE(nullable.is_null_at(3));
+    EXPECT_TRUE(nullable.is_null_at(4));
+    EXPECT_TRUE(nullable.is_null_at(5));
+    EXPECT_EQ(std::vector<UInt8>({0, 0, 1, 0, 0, 0}),
+              std::vector<UInt8>(src_null_map.begin(), src_null_map.end()));
+}
+
+TEST(TextColumnDeserializerTest, double_values) {
+    NullMap src_null_map;
+    auto column = deserialize(TYPE_DOUBLE, {"1.5", "-2e3", "nan", ""}, &src_null_map);
+    const auto& nullable = assert_cast<const ColumnNullable&>(*column);
+    const auto& data = assert_cast<const ColumnFloat64&>(nullable.get_nested_column()).get_data();
+    EXPECT_DOUBLE_EQ(1.5, data[0]);
+    EXPECT_DOUBLE_EQ(-2000, data[1]);
+    EXPECT_TRUE(nullable.is_null_at(2));
+    EXPECT_TRUE(nullable.is_null_at(3));
+    EXPECT_EQ(std::vector<UInt8>({0, 0, 0, 0}),
+              std::vector<UInt8>(src_null_map.begin(), src_null_map.end()));
+}
+
+TEST(TextColumnDeserializerTest, decimal_values) {
+    NullMap src_null_map;
+    auto column = deserialize(TYPE_DECIMALV2, {"12.345", "-0.5", "abc"}, &src_null_map);
+    const auto& nullable = assert_cast<const ColumnNullable&>(*column);
+    const auto& data =
+            assert_cast<const ColumnDecimal<Decimal128>&>(nullable.get_nested_column()).get_data();
+    EXPECT_EQ(DecimalV2Value(std::string("12.345")),
+              binary_cast<Int128, DecimalV2Value>(data[0].value));
+    EXPECT_EQ(DecimalV2Value(std::string("-0.5")),
+              binary_cast<Int128, DecimalV2Value>(data[1].value));
+    EXPECT_TRUE(nullable.is_null_at(2));
+}
+
+TEST(TextColumnDeserializerTest, date_values) {
+    NullMap src_null_map;
+    auto column = deserialize(TYPE_DATE, {"2022-05-01", "2022-05-01 12:00:00", "2022-13-01"},
+                              &src_null_map);
+    const auto& nullable = assert_cast<const ColumnNullable&>(*column);
+    const auto& data = assert_cast<const ColumnInt64&>(nullable.get_nested_column()).get_data();
+    EXPECT_EQ("2022-05-01", binary_cast<Int64, VecDateTimeValue>(data[0]).debug_string());
+    // the time part is dropped like a cast to date does
+    EXPECT_EQ("2022-05-01", binary_cast<Int64, VecDateTimeValue>(data[1]).debug_string());
+    EXPECT_TRUE(nullable.is_null_at(2));
+
+    column = deserialize(TYPE_DATETIME, {"2022-05-01 12:34:56"}, &src_null_map);
+    const auto& datetime_data =
+            assert_cast<const ColumnInt64&>(
+                    assert_cast<const ColumnNullable&>(*column).get_nested_column())
+                    .get_data();
+    EXPECT_EQ("2022-05-01 12:34:56",
+              binary_cast<Int64, VecDateTimeValue>(datetime_data[0]).debug_string());
+}
+
+TEST(TextColumnDeserializerTest, unsupported_type) {
+    EXPECT_TRUE(TextColumnDeserializer::create(TypeDescriptor(TYPE_HLL)) == nullptr);
+}
+
+} // namespace doris::vectorized
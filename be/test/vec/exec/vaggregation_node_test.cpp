@@ -0,0 +1,387 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vaggregation_node.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "common/config.h"
+#include "common/object_pool.h"
+#include "gen_cpp/Descriptors_types.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptors.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/exec/block_source_node.h"
+
+namespace doris::vectorized {
+
+class VAggregationNodeTest : public testing::Test {
+public:
+    VAggregationNodeTest() : _runtime_state(TQueryGlobals()) {
+        _runtime_state._instance_mem_tracker.reset(new MemTracker());
+        _runtime_state._query_options.enable_vectorized_engine = true;
+        _runtime_state._query_options.batch_size = 1024;
+    }
+
+protected:
+    void SetUp() override {
+        _threshold_rows = config::agg_two_level_hash_table_threshold_rows;
+        init_desc_table();
+    }
+
+    void TearDown() override {
+        config::agg_two_level_hash_table_threshold_rows = _threshold_rows;
+    }
+
+    static TTypeDesc create_type_desc(TPrimitiveType::type type) {
+        TTypeDesc type_desc;
+        TTypeNode node;
+        node.__set_type(TTypeNodeType::SCALAR);
+        TScalarType scalar_type;
+        scalar_type.__set_type(type);
+        node.__set_scalar_type(scalar_type);
+        type_desc.types.push_back(node);
+        return type_desc;
+    }
+
+    static TExprNode create_slot_ref(TPrimitiveType::type type, int slot_id, int tuple_id,
+                                     bool is_nullable = false) {
+        TExprNode node;
+        node.node_type = TExprNodeType::SLOT_REF;
+        node.type = create_type_desc(type);
+        node.num_children = 0;
+        node.output_scale = -1;
+        TSlotRef slot_ref;
+        slot_ref.slot_id = slot_id;
+        slot_ref.tuple_id = tuple_id;
+        node.__set_slot_ref(slot_ref);
+        node.__set_is_nullable(is_nullable);
+        return node;
+    }
+
+    // tuple 0 is the input (k1 INT, v1 BIGINT), tuple 1 and 2 are the intermediate and the
+    // output tuples of "SELECT k1, SUM(v1) GROUP BY k1". k1 may be of another type and nullable.
+    void init_desc_table(TPrimitiveType::type key_type = TPrimitiveType::INT,
+                         bool key_nullable = false) {
+        _key_type = key_type;
+        _key_nullable = key_nullable;
+        TDescriptorTable t_desc_table;
+        std::vector<TPrimitiveType::type> types = {key_type, TPrimitiveType::BIGINT};
+        int next_slot_id = 0;
+        for (int tuple_id = 0; tuple_id < 3; ++tuple_id) {
+            int byte_offset = 0;
+            for (size_t i = 0; i < types.size(); ++i) {
+                TSlotDescriptor slot_desc;
+                slot_desc.id = next_slot_id++;
+                slot_desc.parent = tuple_id;
+                slot_desc.slotType = create_type_desc(types[i]);
+                slot_desc.columnPos = i;
+                slot_desc.byteOffset = byte_offset;
+                slot_desc.nullIndicatorByte = 0;
+                slot_desc.nullIndicatorBit = i == 0 && key_nullable ? 0 : -1;
+                slot_desc.colName = i == 0 ? "k1" : "v1";
+                slot_desc.slotIdx = i;
+                slot_desc.isMaterialized = true;
+                t_desc_table.slotDescriptors.push_back(slot_desc);
+                byte_offset += i == 0 ? (key_type == TPrimitiveType::INT ? 4 : 16) : 8;
+            }
+
+            TTupleDescriptor t_tuple_desc;
+            t_tuple_desc.id = tuple_id;
+            t_tuple_desc.byteSize = byte_offset;
+            t_tuple_desc.numNullBytes = key_nullable ? 1 : 0;
+            t_desc_table.tupleDescriptors.push_back(t_tuple_desc);
+        }
+        t_desc_table.__isset.slotDescriptors = true;
+
+        DescriptorTbl::create(&_obj_pool, t_desc_table, &_desc_tbl);
+        _runtime_state.set_desc_tbl(_desc_tbl);
+    }
+
+    TPlanNode create_agg_plan_node() {
+        TPlanNode tnode;
+        tnode.node_id = 1;
+        tnode.node_type = TPlanNodeType::AGGREGATION_NODE;
+        tnode.num_children = 1;
+        tnode.limit = -1;
+        tnode.row_tuples.push_back(2);
+        tnode.nullable_tuples.push_back(false);
+        tnode.compact_data = true;
+
+        TExpr grouping_expr;
+        grouping_expr.nodes.push_back(create_slot_ref(_key_type, 0, 0, _key_nullable));
+        tnode.agg_node.__set_grouping_exprs({grouping_expr});
+
+        TFunction fn;
+        fn.name.function_name = "sum";
+        fn.binary_type = TFunctionBinaryType::BUILTIN;
+        fn.arg_types.push_back(create_type_desc(TPrimitiveType::BIGINT));
+        fn.ret_type = create_type_desc(TPrimitiveType::BIGINT);
+        fn.has_var_args = false;
+        TAggregateFunction agg_fn;
+        agg_fn.intermediate_type = create_type_desc(TPrimitiveType::BIGINT);
+        fn.__set_aggregate_fn(agg_fn);
+
+        TExprNode sum_node;
+        sum_node.node_type = TExprNodeType::AGG_EXPR;
+        sum_node.type = create_type_desc(TPrimitiveType::BIGINT);
+        sum_node.num_children = 1;
+        sum_node.output_scale = -1;
+        TAggregateExpr agg_expr;
+        agg_expr.is_merge_agg = false;
+        sum_node.__set_agg_expr(agg_expr);
+        sum_node.__set_fn(fn);
+        sum_node.__set_is_nullable(false);
+        TExpr sum_expr;
+        sum_expr.nodes.push_back(sum_node);
+        sum_expr.nodes.push_back(create_slot_ref(TPrimitiveType::BIGINT, 1, 0));
+        tnode.agg_node.aggregate_functions.push_back(sum_expr);
+
+        tnode.agg_node.intermediate_tuple_id = 1;
+        tnode.agg_node.output_tuple_id = 2;
+        tnode.agg_node.need_finalize = true;
+        tnode.__isset.agg_node = true;
+        return tnode;
+    }
+
+    TPlanNode create_source_plan_node() {
+        TPlanNode tnode;
+        tnode.node_id = 0;
+        tnode.node_type = TPlanNodeType::EXCHANGE_NODE;
+        tnode.num_children = 0;
+        tnode.limit = -1;
+        tnode.row_tuples.push_back(0);
+        tnode.nullable_tuples.push_back(false);
+        tnode.compact_data = true;
+        return tnode;
+    }
+
+    // every key in [0, num_keys) appears in each block, with the value "key + block index"
+    std::vector<Block> create_input_blocks(int num_keys, int num_blocks) {
+        std::vector<Block> blocks;
+        for (int b = 0; b < num_blocks; ++b) {
+            auto keys = ColumnInt32::create();
+            auto values = ColumnInt64::create();
+            for (int k = 0; k < num_keys; ++k) {
+                keys->insert_value(k);
+                values->insert_value(k + b);
+            }
+            Block block;
+            block.insert({std::move(keys), std::make_shared<DataTypeInt32>(), "k1"});
+            block.insert({std::move(values), std::make_shared<DataTypeInt64>(), "v1"});
+            blocks.push_back(std::move(block));
+        }
+        return blocks;
+    }
+
+    // the keys of every sub map of StringHashMap: the empty key, the keys of 1..8, 9..16, 17..24
+    // and more bytes, and the keys ending with a zero byte, which are kept as long keys
+    static std::vector<std::string> create_string_keys() {
+        return {"",
+                "a",
+                "ab",
+                std::string("ab\0", 3),
+                "abcdefgh",
+                "abcdefghi",
+                std::string(16, 'x'),
+                std::string(17, 'x'),
+                std::string("abcdefghijklmnop\0", 17),
+                std::string(24, 'y'),
+                std::string(25, 'y'),
+                std::string(100, 'z')};
+    }
+
+    // every key appears in each block with the value "key index + block index", the order of
+    // the keys is reversed in the odd blocks. with nullable keys, a NULL key with the value 1000
+    // follows every 5th key, starting from the first one.
+    std::vector<Block> create_string_input_blocks(const std::vector<std::string>& keys,
+                                                  int num_blocks) {
+        std::vector<Block> blocks;
+        for (int b = 0; b < num_blocks; ++b) {
+            auto key_column = ColumnString::create();
+            auto null_map = ColumnUInt8::create();
+            auto values = ColumnInt64::create();
+            for (int i = 0; i < keys.size(); ++i) {
+                int k = b % 2 == 0 ? i : static_cast<int>(keys.size()) - 1 - i;
+                key_column->insert_data(keys[k].data(), keys[k].size());
+                null_map->insert_value(0);
+                values->insert_value(k + b);
+                if (_key_nullable && i % 5 == 0) {
+                    key_column->insert_default();
+                    null_map->insert_value(1);
+                    values->insert_value(1000);
+                }
+            }
+            Block block;
+            if (_key_nullable) {
+                block.insert({ColumnNullable::create(std::move(key_column), std::move(null_map)),
+                              make_nullable(std::make_shared<DataTypeString>()), "k1"});
+            } else {
+                block.insert({std::move(key_column), std::make_shared<DataTypeString>(), "k1"});
+            }
+            block.insert({std::move(values), std::make_shared<DataTypeInt64>(), "v1"});
+            blocks.push_back(std::move(block));
+        }
+        return blocks;
+    }
+
+    // runs "SELECT k1, SUM(v1) GROUP BY k1" on the string keys, a NULL key is returned as
+    // std::nullopt
+    void aggregate_string_keys(const std::vector<std::string>& keys, int num_blocks,
+                               std::map<std::optional<std::string>, int64_t>* sums) {
+        TPlanNode source_tnode = create_source_plan_node();
+        auto* source =
+                _obj_pool.add(new BlockSourceNode(&_obj_pool, source_tnode, *_desc_tbl,
+                                                  create_string_input_blocks(keys, num_blocks)));
+        ASSERT_TRUE(source->init(source_tnode, &_runtime_state).ok());
+
+        TPlanNode agg_tnode = create_agg_plan_node();
+        AggregationNode agg_node(&_obj_pool, agg_tnode, *_desc_tbl);
+        ASSERT_TRUE(agg_node.init(agg_tnode, &_runtime_state).ok());
+        agg_node._children.push_back(source);
+        ASSERT_TRUE(agg_node.prepare(&_runtime_state).ok());
+        // the keys are kept in a StringHashMap
+        if (_key_nullable) {
+            EXPECT_TRUE(std::holds_alternative<
+                        AggregationMethodSingleNullableColumn<AggregationMethodStringNoCache<
+                                AggregatedDataWithNullableShortStringKey>>>(
+                    agg_node._agg_data._aggregated_method_variant));
+        } else {
+            EXPECT_TRUE(std::holds_alternative<
+                        AggregationMethodStringNoCache<AggregatedDataWithShortStringKey>>(
+                    agg_node._agg_data._aggregated_method_variant));
+        }
+        ASSERT_TRUE(agg_node.open(&_runtime_state).ok());
+
+        bool eos = false;
+        while (!eos) {
+            Block block;
+            ASSERT_TRUE(agg_node.get_next(&_runtime_state, &block, &eos).ok());
+            for (size_t i = 0; i < block.rows(); ++i) {
+                const auto& key_column = block.get_by_position(0).column;
+                std::optional<std::string> key;
+                if (!key_column->is_null_at(i)) {
+                    key = key_column->get_data_at(i).to_string();
+                }
+                // every key is output once
+                EXPECT_EQ(0, sums->count(key));
+                (*sums)[key] = block.get_by_position(1).column->get_int(i);
+            }
+        }
+        EXPECT_TRUE(agg_node.close(&_runtime_state).ok());
+    }
+
+    RuntimeState _runtime_state;
+    ObjectPool _obj_pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    TPrimitiveType::type _key_type = TPrimitiveType::INT;
+    bool _key_nullable = false;
+    int64_t _threshold_rows = 0;
+};
+
+TEST_F(VAggregationNodeTest, two_level_result) {
+    const int num_keys = 10000;
+    const int num_blocks = 3;
+    config::agg_two_level_hash_table_threshold_rows = 1000;
+
+    TPlanNode source_tnode = create_source_plan_node();
+    auto* source = _obj_pool.add(new BlockSourceNode(&_obj_pool, source_tnode, *_desc_tbl,
+                                                     create_input_blocks(num_keys, num_blocks)));
+    ASSERT_TRUE(source->init(source_tnode, &_runtime_state).ok());
+
+    TPlanNode agg_tnode = create_agg_plan_node();
+    AggregationNode agg_node(&_obj_pool, agg_tnode, *_desc_tbl);
+    ASSERT_TRUE(agg_node.init(agg_tnode, &_runtime_state).ok());
+    agg_node._children.push_back(source);
+    ASSERT_TRUE(agg_node.prepare(&_runtime_state).ok());
+    ASSERT_TRUE(agg_node.open(&_runtime_state).ok());
+    EXPECT_TRUE(agg_node._agg_data.is_two_level());
+
+    std::vector<int64_t> sums(num_keys, -1);
+    bool eos = false;
+    bool first_block = true;
+    while (!eos) {
+        Block block;
+        ASSERT_TRUE(agg_node.get_next(&_runtime_state, &block, &eos).ok());
+        if (first_block) {
+            // the result is built a round of buckets at a time
+            EXPECT_FALSE(eos);
+            EXPECT_FALSE(agg_node._two_level_result_done);
+            first_block = false;
+        }
+        EXPECT_LE(block.rows(), size_t(_runtime_state.batch_size()));
+        for (size_t i = 0; i < block.rows(); ++i) {
+            auto key = block.get_by_position(0).column->get_int(i);
+            ASSERT_TRUE(key >= 0 && key < num_keys);
+            // every key is output once
+            EXPECT_EQ(-1, sums[key]);
+            sums[key] = block.get_by_position(1).column->get_int(i);
+        }
+    }
+    EXPECT_TRUE(agg_node._two_level_result_done);
+    for (int k = 0; k < num_keys; ++k) {
+        EXPECT_EQ(int64_t(k) * num_blocks + num_blocks * (num_blocks - 1) / 2, sums[k]);
+    }
+    EXPECT_TRUE(agg_node.close(&_runtime_state).ok());
+}
+
+TEST_F(VAggregationNodeTest, string_key) {
+    init_desc_table(TPrimitiveType::STRING, false);
+    const int num_blocks = 3;
+    std::vector<std::string> keys = create_string_keys();
+    std::map<std::optional<std::string>, int64_t> sums;
+    aggregate_string_keys(keys, num_blocks, &sums);
+
+    EXPECT_EQ(keys.size(), sums.size());
+    for (int k = 0; k < keys.size(); ++k) {
+        EXPECT_EQ(int64_t(k) * num_blocks + num_blocks * (num_blocks - 1) / 2, sums[keys[k]])
+                << "key of " << keys[k].size() << " bytes";
+    }
+}
+
+TEST_F(VAggregationNodeTest, nullable_string_key) {
+    init_desc_table(TPrimitiveType::STRING, true);
+    const int num_blocks = 3;
+    std::vector<std::string> keys = create_string_keys();
+    std::map<std::optional<std::string>, int64_t> sums;
+    aggregate_string_keys(keys, num_blocks, &sums);
+
+    // the NULL key is a group of its own, apart from the empty key
+    EXPECT_EQ(keys.size() + 1, sums.size());
+    for (int k = 0; k < keys.size(); ++k) {
+        EXPECT_EQ(int64_t(k) * num_blocks + num_blocks * (num_blocks - 1) / 2, sums[keys[k]])
+                << "key of " << keys[k].size() << " bytes";
+    }
+    // 3 NULL keys in each block of 12 keys
+    EXPECT_EQ(1000 * 3 * num_blocks, sums[std::nullopt]);
+}
+
+} // namespace doris::vectorized
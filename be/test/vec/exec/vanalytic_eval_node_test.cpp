@@ -0,0 +1,397 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vanalytic_eval_node.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "common/object_pool.h"
+#include "gen_cpp/Descriptors_types.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+#include "runtime/tmp_file_mgr.h"
+#include "util/filesystem_util.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/exec/block_source_node.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+// p, o, v, sum(v) and max(v) of an output row
+using Row = std::array<int64_t, 5>;
+
+const std::string k_tmp_dir = "/tmp/vanalytic_eval_node_test";
+
+} // namespace
+
+class VAnalyticEvalNodeTest : public testing::Test {
+public:
+    VAnalyticEvalNodeTest() : _runtime_state(TQueryGlobals()) {
+        _runtime_state._instance_mem_tracker.reset(new MemTracker());
+        _runtime_state._query_options.enable_vectorized_engine = true;
+        _runtime_state._query_options.batch_size = 1024;
+    }
+
+protected:
+    void SetUp() override {
+        _spill_threshold_bytes = config::analytic_spill_threshold_bytes;
+        init_desc_table();
+    }
+
+    void TearDown() override {
+        config::analytic_spill_threshold_bytes = _spill_threshold_bytes;
+        if (_tmp_file_mgr != nullptr) {
+            ExecEnv::GetInstance()->_tmp_file_mgr = _origin_tmp_file_mgr;
+            FileSystemUtil::remove_paths({k_tmp_dir});
+        }
+    }
+
+    // the spill file is created in the scratch dir of the tmp file manager of the exec env
+    void init_tmp_file_mgr() {
+        ASSERT_TRUE(FileSystemUtil::create_directory(k_tmp_dir).ok());
+        _tmp_file_mgr = std::make_unique<TmpFileMgr>();
+        ASSERT_TRUE(_tmp_file_mgr->init_custom({k_tmp_dir}, false).ok());
+        _origin_tmp_file_mgr = ExecEnv::GetInstance()->_tmp_file_mgr;
+        ExecEnv::GetInstance()->_tmp_file_mgr = _tmp_file_mgr.get();
+        _runtime_state._exec_env = ExecEnv::GetInstance();
+    }
+
+    static TTypeDesc create_type_desc(TPrimitiveType::type type) {
+        TTypeDesc type_desc;
+        TTypeNode node;
+        node.__set_type(TTypeNodeType::SCALAR);
+        TScalarType scalar_type;
+        scalar_type.__set_type(type);
+        node.__set_scalar_type(scalar_type);
+        type_desc.types.push_back(node);
+        return type_desc;
+    }
+
+    static TExprNode create_slot_ref(TPrimitiveType::type type, int slot_id, int tuple_id) {
+        TExprNode node;
+        node.node_type = TExprNodeType::SLOT_REF;
+        node.type = create_type_desc(type);
+        node.num_children = 0;
+        node.output_scale = -1;
+        TSlotRef slot_ref;
+        slot_ref.slot_id = slot_id;
+        slot_ref.tuple_id = tuple_id;
+        node.__set_slot_ref(slot_ref);
+        node.__set_is_nullable(false);
+        return node;
+    }
+
+    static void add_tuple(TDescriptorTable* t_desc_table, int tuple_id,
+                          const std::vector<TPrimitiveType::type>& types,
+                          const std::vector<std::string>& names, int* next_slot_id) {
+        int byte_offset = 0;
+        for (size_t i = 0; i < types.size(); ++i) {
+            TSlotDescriptor slot_desc;
+            slot_desc.id = (*next_slot_id)++;
+            slot_desc.parent = tuple_id;
+            slot_desc.slotType = create_type_desc(types[i]);
+            slot_desc.columnPos = i;
+            slot_desc.byteOffset = byte_offset;
+            slot_desc.nullIndicatorByte = 0;
+            slot_desc.nullIndicatorBit = -1;
+            slot_desc.colName = names[i];
+            slot_desc.slotIdx = i;
+            slot_desc.isMaterialized = true;
+            t_desc_table->slotDescriptors.push_back(slot_desc);
+            byte_offset += types[i] == TPrimitiveType::INT ? 4 : 8;
+        }
+
+        TTupleDescriptor t_tuple_desc;
+        t_tuple_desc.id = tuple_id;
+        t_tuple_desc.byteSize = byte_offset;
+        t_tuple_desc.numNullBytes = 0;
+        t_desc_table->tupleDescriptors.push_back(t_tuple_desc);
+    }
+
+    // tuple 0 is the input (p INT, o INT, v BIGINT), tuple 1 and 2 are the intermediate and the
+    // output tuples of "SUM(v), MAX(v) OVER (PARTITION BY p ORDER BY o ROWS ...)"
+    void init_desc_table() {
+        TDescriptorTable t_desc_table;
+        int next_slot_id = 0;
+        add_tuple(&t_desc_table, 0,
+                  {TPrimitiveType::INT, TPrimitiveType::INT, TPrimitiveType::BIGINT},
+                  {"p", "o", "v"}, &next_slot_id);
+        for (int tuple_id = 1; tuple_id < 3; ++tuple_id) {
+            add_tuple(&t_desc_table, tuple_id, {TPrimitiveType::BIGINT, TPrimitiveType::BIGINT},
+                      {"sum_v", "max_v"}, &next_slot_id);
+        }
+        t_desc_table.__isset.slotDescriptors = true;
+
+        DescriptorTbl::create(&_obj_pool, t_desc_table, &_desc_tbl);
+        _runtime_state.set_desc_tbl(_desc_tbl);
+    }
+
+    static TExpr create_agg_expr(const std::string& name) {
+        TFunction fn;
+        fn.name.function_name = name;
+        fn.binary_type = TFunctionBinaryType::BUILTIN;
+        fn.arg_types.push_back(create_type_desc(TPrimitiveType::BIGINT));
+        fn.ret_type = create_type_desc(TPrimitiveType::BIGINT);
+        fn.has_var_args = false;
+        TAggregateFunction agg_fn;
+        agg_fn.intermediate_type = create_type_desc(TPrimitiveType::BIGINT);
+        fn.__set_aggregate_fn(agg_fn);
+
+        TExprNode agg_node;
+        agg_node.node_type = TExprNodeType::AGG_EXPR;
+        agg_node.type = create_type_desc(TPrimitiveType::BIGINT);
+        agg_node.num_children = 1;
+        agg_node.output_scale = -1;
+        TAggregateExpr agg_expr;
+        agg_expr.is_merge_agg = false;
+        agg_node.__set_agg_expr(agg_expr);
+        agg_node.__set_fn(fn);
+        agg_node.__set_is_nullable(false);
+        TExpr expr;
+        expr.nodes.push_back(agg_node);
+        expr.nodes.push_back(create_slot_ref(TPrimitiveType::BIGINT, 2, 0));
+        return expr;
+    }
+
+    // ROWS BETWEEN <preceding> PRECEDING AND <following> FOLLOWING, a negative preceding is
+    // UNBOUNDED PRECEDING
+    static TPlanNode create_analytic_plan_node(int64_t preceding, int64_t following) {
+        TPlanNode tnode;
+        tnode.node_id = 1;
+        tnode.node_type = TPlanNodeType::ANALYTIC_EVAL_NODE;
+        tnode.num_children = 1;
+        tnode.limit = -1;
+        tnode.row_tuples.push_back(0);
+        tnode.row_tuples.push_back(2);
+        tnode.nullable_tuples.push_back(false);
+        tnode.nullable_tuples.push_back(false);
+        tnode.compact_data = true;
+
+        TExpr partition_expr;
+        partition_expr.nodes.push_back(create_slot_ref(TPrimitiveType::INT, 0, 0));
+        tnode.analytic_node.partition_exprs.push_back(partition_expr);
+        TExpr order_by_expr;
+        order_by_expr.nodes.push_back(create_slot_ref(TPrimitiveType::INT, 1, 0));
+        tnode.analytic_node.order_by_exprs.push_back(order_by_expr);
+        tnode.analytic_node.analytic_functions.push_back(create_agg_expr("sum"));
+        tnode.analytic_node.analytic_functions.push_back(create_agg_expr("max"));
+
+        TAnalyticWindow window;
+        window.type = TAnalyticWindowType::ROWS;
+        if (preceding >= 0) {
+            TAnalyticWindowBoundary window_start;
+            window_start.type = TAnalyticWindowBoundaryType::PRECEDING;
+            window_start.__set_rows_offset_value(preceding);
+            window.__set_window_start(window_start);
+        }
+        TAnalyticWindowBoundary window_end;
+        window_end.type = TAnalyticWindowBoundaryType::FOLLOWING;
+        window_end.__set_rows_offset_value(following);
+        window.__set_window_end(window_end);
+        tnode.analytic_node.__set_window(window);
+
+        tnode.analytic_node.intermediate_tuple_id = 1;
+        tnode.analytic_node.output_tuple_id = 2;
+        tnode.__isset.analytic_node = true;
+        return tnode;
+    }
+
+    static TPlanNode create_source_plan_node() {
+        TPlanNode tnode;
+        tnode.node_id = 0;
+        tnode.node_type = TPlanNodeType::EXCHANGE_NODE;
+        tnode.num_children = 0;
+        tnode.limit = -1;
+        tnode.row_tuples.push_back(0);
+        tnode.nullable_tuples.push_back(false);
+        tnode.compact_data = true;
+        return tnode;
+    }
+
+    static int64_t value_of_row(int64_t row) { return (row * 37 + 11) % 101 - 50; }
+
+    // the rows of partition p are ordered by o in [0, partition_sizes[p]), the input is split
+    // into blocks of rows_per_block rows, so the partitions and the frames cross the blocks
+    static std::vector<Block> create_input_blocks(const std::vector<int>& partition_sizes,
+                                                  int rows_per_block) {
+        std::vector<Block> blocks;
+        auto p_column = ColumnInt32::create();
+        auto o_column = ColumnInt32::create();
+        auto v_column = ColumnInt64::create();
+        int64_t row = 0;
+        for (int p = 0; p < partition_sizes.size(); ++p) {
+            for (int o = 0; o < partition_sizes[p]; ++o) {
+                p_column->insert_value(p);
+                o_column->insert_value(o);
+                v_column->insert_value(value_of_row(row++));
+                if (p_column->size() == rows_per_block) {
+                    Block block;
+                    block.insert({std::move(p_column), std::make_shared<DataTypeInt32>(), "p"});
+                    block.insert({std::move(o_column), std::make_shared<DataTypeInt32>(), "o"});
+                    block.insert({std::move(v_column), std::make_shared<DataTypeInt64>(), "v"});
+                    blocks.push_back(std::move(block));
+                    p_column = ColumnInt32::create();
+                    o_column = ColumnInt32::create();
+                    v_column = ColumnInt64::create();
+                }
+            }
+        }
+        if (!p_column->empty()) {
+            Block block;
+            block.insert({std::move(p_column), std::make_shared<DataTypeInt32>(), "p"});
+            block.insert({std::move(o_column), std::make_shared<DataTypeInt32>(), "o"});
+            block.insert({std::move(v_column), std::make_shared<DataTypeInt64>(), "v"});
+            blocks.push_back(std::move(block));
+        }
+        return blocks;
+    }
+
+    // sums and maxes every frame from scratch, the frame always has the current row
+    static std::vector<Row> expected_rows(const std::vector<int>& partition_sizes,
+                                          int64_t preceding, int64_t following) {
+        std::vector<Row> rows;
+        int64_t partition_start = 0;
+        for (int p = 0; p < partition_sizes.size(); ++p) {
+            int64_t partition_end = partition_start + partition_sizes[p];
+            for (int64_t row = partition_start; row < partition_end; ++row) {
+                int64_t start = preceding < 0 ? partition_start
+                                              : std::max(partition_start, row - preceding);
+                int64_t end = std::min(partition_end, row + following + 1);
+                int64_t sum = 0;
+                int64_t max = value_of_row(start);
+                for (int64_t r = start; r < end; ++r) {
+                    sum += value_of_row(r);
+                    max = std::max(max, value_of_row(r));
+                }
+                rows.push_back({p, row - partition_start, value_of_row(row), sum, max});
+            }
+            partition_start = partition_end;
+        }
+        return rows;
+    }
+
+    // runs the node to the end of its output, the caller checks the node and closes it
+    void execute(VAnalyticEvalNode* node, const TPlanNode& tnode,
+                 const std::vector<int>& partition_sizes, int rows_per_block,
+                 std::vector<Row>* rows) {
+        TPlanNode source_tnode = create_source_plan_node();
+        auto* source = _obj_pool.add(
+                new BlockSourceNode(&_obj_pool, source_tnode, *_desc_tbl,
+                                    create_input_blocks(partition_sizes, rows_per_block)));
+        ASSERT_TRUE(source->init(source_tnode, &_runtime_state).ok());
+
+        ASSERT_TRUE(node->init(tnode, &_runtime_state).ok());
+        node->_children.push_back(source);
+        ASSERT_TRUE(node->prepare(&_runtime_state).ok());
+        ASSERT_TRUE(node->open(&_runtime_state).ok());
+
+        bool eos = false;
+        while (!eos) {
+            Block block;
+            ASSERT_TRUE(node->get_next(&_runtime_state, &block, &eos).ok());
+            if (block.rows() == 0) {
+                continue;
+            }
+            ASSERT_EQ(5, block.columns());
+            for (size_t i = 0; i < block.rows(); ++i) {
+                Row row;
+                for (size_t c = 0; c < row.size(); ++c) {
+                    row[c] = block.get_by_position(c).column->get_int(i);
+                }
+                rows->push_back(row);
+            }
+        }
+    }
+
+    RuntimeState _runtime_state;
+    ObjectPool _obj_pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    int64_t _spill_threshold_bytes = 0;
+    std::unique_ptr<TmpFileMgr> _tmp_file_mgr;
+    TmpFileMgr* _origin_tmp_file_mgr = nullptr;
+};
+
+TEST_F(VAnalyticEvalNodeTest, rows_frame_across_blocks) {
+    const std::vector<int> partition_sizes = {1, 5, 13, 7, 2, 9};
+    TPlanNode tnode = create_analytic_plan_node(2, 1);
+    VAnalyticEvalNode node(&_obj_pool, tnode, *_desc_tbl);
+    std::vector<Row> rows;
+    execute(&node, tnode, partition_sizes, 4, &rows);
+
+    // sum removes the rows leaving the frame, max merges the states of a segment tree
+    ASSERT_EQ(2, node._rows_frame_evaluators.size());
+    EXPECT_EQ(VAnalyticEvalNode::INCREMENTAL, node._rows_frame_evaluators[0]);
+    EXPECT_EQ(VAnalyticEvalNode::SEGMENT_TREE, node._rows_frame_evaluators[1]);
+    EXPECT_EQ(expected_rows(partition_sizes, 2, 1), rows);
+    EXPECT_TRUE(node.close(&_runtime_state).ok());
+}
+
+TEST_F(VAnalyticEvalNodeTest, growing_rows_frame_across_blocks) {
+    const std::vector<int> partition_sizes = {3, 11, 1, 6};
+    TPlanNode tnode = create_analytic_plan_node(-1, 2);
+    VAnalyticEvalNode node(&_obj_pool, tnode, *_desc_tbl);
+    std::vector<Row> rows;
+    execute(&node, tnode, partition_sizes, 3, &rows);
+
+    // the frame only grows, so both functions only add the rows entering the frame
+    ASSERT_EQ(2, node._rows_frame_evaluators.size());
+    EXPECT_EQ(VAnalyticEvalNode::INCREMENTAL, node._rows_frame_evaluators[0]);
+    EXPECT_EQ(VAnalyticEvalNode::INCREMENTAL, node._rows_frame_evaluators[1]);
+    EXPECT_EQ(expected_rows(partition_sizes, -1, 2), rows);
+    EXPECT_TRUE(node.close(&_runtime_state).ok());
+}
+
+TEST_F(VAnalyticEvalNodeTest, spill_and_restore_input_blocks) {
+    init_tmp_file_mgr();
+    // every block after the one being output is spilled as soon as it is buffered
+    config::analytic_spill_threshold_bytes = 1;
+
+    const std::vector<int> partition_sizes = {30, 3, 21};
+    TPlanNode tnode = create_analytic_plan_node(3, 2);
+    VAnalyticEvalNode node(&_obj_pool, tnode, *_desc_tbl);
+    std::vector<Row> rows;
+    execute(&node, tnode, partition_sizes, 4, &rows);
+
+    // the spilled v columns are read back when their blocks are output
+    EXPECT_GT(node._spilled_bytes_counter->value(), 0);
+    ASSERT_TRUE(node._spill_file != nullptr);
+    for (const auto& spilled : node._spilled_blocks) {
+        EXPECT_EQ(0, spilled.size);
+    }
+    EXPECT_EQ(expected_rows(partition_sizes, 3, 2), rows);
+
+    std::string spill_file_path = node._spill_file_path;
+    EXPECT_TRUE(std::filesystem::exists(spill_file_path));
+    EXPECT_TRUE(node.close(&_runtime_state).ok());
+    EXPECT_FALSE(std::filesystem::exists(spill_file_path));
+}
+
+} // namespace doris::vectorized
@@ -22,6 +22,8 @@
 #include <string>
 #include <vector>
 
+#include "common/config.h"
+#include "common/consts.h"
 #include "common/object_pool.h"
 #include "exec/local_file_reader.h"
 #include "exprs/binary_predicate.h"
@@ -31,10 +33,15 @@
 #include "gen_cpp/Descriptors_types.h"
 #include "gen_cpp/PlanNodes_types.h"
 #include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/primitive_type.h"
 #include "runtime/runtime_state.h"
+#include "runtime/stream_load/load_stream_mgr.h"
+#include "runtime/stream_load/stream_load_pipe.h"
 #include "runtime/user_function_cache.h"
+#include "util/defer_op.h"
+#include "util/uid_util.h"
 
 namespace doris {
 
@@ -634,5 +641,96 @@ TEST_F(VBrokerScanNodeTest, where_binary_pre) {
     }
 }
 
+TEST_F(VBrokerScanNodeTest, split_stream_load_with_header) {
+    ExecEnv env;
+    env._load_stream_mgr = new LoadStreamMgr();
+    _runtime_state._exec_env = &env;
+    int32_t old_scanner_num = config::stream_load_parallel_scanner_num;
+    config::stream_load_parallel_scanner_num = 3;
+    Defer defer {[&]() {
+        config::stream_load_parallel_scanner_num = old_scanner_num;
+        _runtime_state._exec_env = nullptr;
+        delete env._load_stream_mgr;
+        env._load_stream_mgr = nullptr;
+    }};
+
+    // the header and 100 rows, each of the split scanners gets several chunks of them
+    const int num_rows = 100;
+    std::string body = "k1,k2,k3\n";
+    int64_t k1_sum = 0;
+    for (int i = 0; i < num_rows; ++i) {
+        body += std::to_string(i) + "," + std::to_string(i + 1) + "," + std::to_string(i + 2) +
+                "\n";
+        k1_sum += i;
+    }
+    UniqueId load_id = UniqueId::gen_uid();
+    auto pipe = std::make_shared<StreamLoadPipe>(body.size() * 2, 64);
+    ASSERT_TRUE(env._load_stream_mgr->put(load_id, pipe).ok());
+    ASSERT_TRUE(pipe->append(body.data(), body.size()).ok());
+    ASSERT_TRUE(pipe->finish().ok());
+
+    VBrokerScanNode scan_node(&_obj_pool, _tnode, *_desc_tbl);
+    scan_node._split_chunk_size = 64;
+    scan_node.init(_tnode);
+    auto status = scan_node.prepare(&_runtime_state);
+    ASSERT_TRUE(status.ok());
+
+    std::vector<TScanRangeParams> scan_ranges;
+    {
+        TScanRangeParams scan_range_params;
+
+        TBrokerScanRange broker_scan_range;
+        broker_scan_range.params = _params;
+
+        TBrokerRangeDesc range;
+        range.start_offset = 0;
+        range.size = -1;
+        range.file_type = TFileType::FILE_STREAM;
+        range.format_type = TFileFormatType::FORMAT_CSV_PLAIN;
+        range.splittable = false;
+        range.__set_load_id(load_id.to_thrift());
+        range.__set_header_type(BeConsts::CSV_WITH_NAMES);
+        std::vector<std::string> columns_from_path {"1"};
+        range.__set_columns_from_path(columns_from_path);
+        range.__set_num_of_columns_from_file(3);
+        broker_scan_range.ranges.push_back(range);
+
+        scan_range_params.scan_range.__set_broker_scan_range(broker_scan_range);
+
+        scan_ranges.push_back(scan_range_params);
+    }
+    scan_node.set_scan_ranges(scan_ranges);
+
+    status = scan_node.open(&_runtime_state);
+    ASSERT_TRUE(status.ok());
+    // the body is scanned by one scanner for each split pipe
+    ASSERT_EQ(3, scan_node._scan_ranges.size());
+
+    int rows = 0;
+    int64_t scanned_k1_sum = 0;
+    bool eos = false;
+    while (!eos) {
+        doris::vectorized::Block block;
+        status = scan_node.get_next(&_runtime_state, &block, &eos);
+        ASSERT_TRUE(status.ok());
+        if (block.rows() == 0) {
+            continue;
+        }
+        auto columns = block.get_columns_with_type_and_name();
+        for (int i = 0; i < block.rows(); ++i) {
+            int64_t k1 = std::stoll(columns[0].to_string(i));
+            // no line of data is taken as the header
+            ASSERT_EQ(std::to_string(k1 + 1), columns[1].to_string(i));
+            ASSERT_EQ(std::to_string(k1 + 2), columns[2].to_string(i));
+            scanned_k1_sum += k1;
+        }
+        rows += block.rows();
+    }
+    ASSERT_EQ(num_rows, rows);
+    ASSERT_EQ(k1_sum, scanned_k1_sum);
+
+    scan_node.close(&_runtime_state);
+}
+
 } // namespace vectorized
 } // namespace doris
@@ -18,7 +18,9 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
 #include <map>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -28,9 +30,12 @@
 #include "gen_cpp/Descriptors_types.h"
 #include "gen_cpp/PlanNodes_types.h"
 #include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "runtime/load_path_mgr.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/runtime_state.h"
 #include "runtime/user_function_cache.h"
+#include "util/file_utils.h"
 
 namespace doris {
 
@@ -59,11 +64,21 @@ public:
 
 protected:
     virtual void SetUp() {}
-    virtual void TearDown() {}
+    virtual void TearDown() {
+        if (_load_path_mgr != nullptr) {
+            ExecEnv::GetInstance()->_load_path_mgr = nullptr;
+            FileUtils::remove_all(_load_path_mgr->get_load_error_file_dir());
+        }
+    }
 
 private:
     void init_desc_table();
     void init_params();
+    // add the pre filter k1 < 'value'
+    void init_pre_filter(const std::string& value);
+    // the error rows are only written to the error log of a load
+    void init_error_log();
+    std::string read_error_log();
 
     TupleId _dst_tuple_id = 0;
     TupleId _src_tuple_id = 1;
@@ -75,6 +90,7 @@ private:
     std::vector<TNetworkAddress> _addresses;
     ScannerCounter _counter;
     std::vector<TExpr> _pre_filter;
+    std::unique_ptr<LoadPathMgr> _load_path_mgr;
 };
 
 void VBrokerScannerTest::init_desc_table() {
@@ -348,58 +364,7 @@ void VBrokerScannerTest::init_params() {
     _params.__set_src_tuple_id(_src_tuple_id);
 }
 
-void VBrokerScannerTest::init() {
-    init_desc_table();
-    init_params();
-}
-
-TEST_F(VBrokerScannerTest, normal) {
-    std::vector<TBrokerRangeDesc> ranges;
-    TBrokerRangeDesc range;
-    range.path = "./be/test/exec/test_data/broker_scanner/normal.csv";
-    range.start_offset = 0;
-    range.size = -1;
-    range.splittable = true;
-    range.file_type = TFileType::FILE_LOCAL;
-    range.format_type = TFileFormatType::FORMAT_CSV_PLAIN;
-    ranges.push_back(range);
-    VBrokerScanner scanner(&_runtime_state, _profile, _params, ranges, _addresses, _pre_filter,
-                           &_counter);
-    auto st = scanner.open();
-    ASSERT_TRUE(st.ok());
-
-    std::unique_ptr<vectorized::Block> block(new vectorized::Block());
-    bool eof = false;
-    st = scanner.get_next(block.get(), &eof);
-    ASSERT_TRUE(st.ok());
-    ASSERT_TRUE(eof);
-    auto columns = block->get_columns();
-    ASSERT_EQ(columns.size(), 3);
-    ASSERT_EQ(columns[0]->get_int(0), 1);
-    ASSERT_EQ(columns[0]->get_int(1), 4);
-    ASSERT_EQ(columns[0]->get_int(2), 8);
-
-    ASSERT_EQ(columns[1]->get_int(0), 2);
-    ASSERT_EQ(columns[1]->get_int(1), 5);
-    ASSERT_EQ(columns[1]->get_int(2), 9);
-
-    ASSERT_EQ(columns[2]->get_int(0), 3);
-    ASSERT_EQ(columns[2]->get_int(1), 6);
-    ASSERT_EQ(columns[2]->get_int(2), 10);
-}
-
-TEST_F(VBrokerScannerTest, normal_with_pre_filter) {
-    std::vector<TBrokerRangeDesc> ranges;
-    TBrokerRangeDesc range;
-    range.path = "./be/test/exec/test_data/broker_scanner/normal.csv";
-    range.start_offset = 0;
-    range.size = -1;
-    range.splittable = true;
-    range.file_type = TFileType::FILE_LOCAL;
-    range.format_type = TFileFormatType::FORMAT_CSV_PLAIN;
-    ranges.push_back(range);
-
-    // init pre_filter expr: k1 < '8'
+void VBrokerScannerTest::init_pre_filter(const std::string& value) {
     TTypeDesc int_type;
     {
         TTypeNode node;
@@ -458,11 +423,86 @@ TEST_F(VBrokerScannerTest, normal_with_pre_filter) {
         expr_node.__set_num_children(0);
         expr_node.__isset.string_literal = true;
         TStringLiteral string_literal;
-        string_literal.__set_value("8");
+        string_literal.__set_value(value);
         expr_node.__set_string_literal(string_literal);
         filter_expr.nodes.push_back(expr_node);
     }
     _pre_filter.push_back(filter_expr);
+}
+
+void VBrokerScannerTest::init_error_log() {
+    _runtime_state._query_options.__set_query_type(TQueryType::LOAD);
+    _runtime_state._exec_env = ExecEnv::GetInstance();
+    _runtime_state._num_print_error_rows = 0;
+    _runtime_state._error_row_number = 0;
+    _load_path_mgr.reset(new LoadPathMgr(ExecEnv::GetInstance()));
+    _load_path_mgr->_error_log_dir = "./be/test/vec/exec/test_data/vbroker_scanner_error_log";
+    ExecEnv::GetInstance()->_load_path_mgr = _load_path_mgr.get();
+}
+
+std::string VBrokerScannerTest::read_error_log() {
+    if (_runtime_state._error_log_file == nullptr) {
+        return "";
+    }
+    std::ifstream error_log(
+            _load_path_mgr->get_load_error_absolute_path(_runtime_state.get_error_log_file_path()));
+    std::stringstream ss;
+    ss << error_log.rdbuf();
+    return ss.str();
+}
+
+void VBrokerScannerTest::init() {
+    init_desc_table();
+    init_params();
+}
+
+TEST_F(VBrokerScannerTest, normal) {
+    std::vector<TBrokerRangeDesc> ranges;
+    TBrokerRangeDesc range;
+    range.path = "./be/test/exec/test_data/broker_scanner/normal.csv";
+    range.start_offset = 0;
+    range.size = -1;
+    range.splittable = true;
+    range.file_type = TFileType::FILE_LOCAL;
+    range.format_type = TFileFormatType::FORMAT_CSV_PLAIN;
+    ranges.push_back(range);
+    VBrokerScanner scanner(&_runtime_state, _profile, _params, ranges, _addresses, _pre_filter,
+                           &_counter);
+    auto st = scanner.open();
+    ASSERT_TRUE(st.ok());
+
+    std::unique_ptr<vectorized::Block> block(new vectorized::Block());
+    bool eof = false;
+    st = scanner.get_next(block.get(), &eof);
+    ASSERT_TRUE(st.ok());
+    ASSERT_TRUE(eof);
+    auto columns = block->get_columns();
+    ASSERT_EQ(columns.size(), 3);
+    ASSERT_EQ(columns[0]->get_int(0), 1);
+    ASSERT_EQ(columns[0]->get_int(1), 4);
+    ASSERT_EQ(columns[0]->get_int(2), 8);
+
+    ASSERT_EQ(columns[1]->get_int(0), 2);
+    ASSERT_EQ(columns[1]->get_int(1), 5);
+    ASSERT_EQ(columns[1]->get_int(2), 9);
+
+    ASSERT_EQ(columns[2]->get_int(0), 3);
+    ASSERT_EQ(columns[2]->get_int(1), 6);
+    ASSERT_EQ(columns[2]->get_int(2), 10);
+}
+
+TEST_F(VBrokerScannerTest, normal_with_pre_filter) {
+    std::vector<TBrokerRangeDesc> ranges;
+    TBrokerRangeDesc range;
+    range.path = "./be/test/exec/test_data/broker_scanner/normal.csv";
+    range.start_offset = 0;
+    range.size = -1;
+    range.splittable = true;
+    range.file_type = TFileType::FILE_LOCAL;
+    range.format_type = TFileFormatType::FORMAT_CSV_PLAIN;
+    ranges.push_back(range);
+
+    init_pre_filter("8");
     VBrokerScanner scanner(&_runtime_state, _profile, _params, ranges, _addresses, _pre_filter,
                            &_counter);
     auto st = scanner.open();
@@ -551,5 +591,131 @@ TEST_F(VBrokerScannerTest, normal5) {
     ASSERT_EQ(columns.size(), 0);
 }
 
+TEST_F(VBrokerScannerTest, strict_mode_invalid_value) {
+    std::vector<TBrokerRangeDesc> ranges;
+    TBrokerRangeDesc range;
+    range.path = "./be/test/exec/test_data/broker_scanner/invalid_value.csv";
+    range.start_offset = 0;
+    range.size = -1;
+    range.splittable = true;
+    range.file_type = TFileType::FILE_LOCAL;
+    range.format_type = TFileFormatType::FORMAT_CSV_PLAIN;
+    ranges.push_back(range);
+    _params.__set_strict_mode(true);
+    _params.__set_dest_sid_to_src_sid_without_trans({{1, 4}, {2, 5}, {3, 6}});
+    init_error_log();
+    VBrokerScanner scanner(&_runtime_state, _profile, _params, ranges, _addresses, _pre_filter,
+                           &_counter);
+    auto st = scanner.open();
+    ASSERT_TRUE(st.ok());
+    // all the dest columns are parsed by the typed deserializers
+    ASSERT_EQ(3, scanner._text_dest_columns.size());
+    ASSERT_TRUE(scanner._src_deserializers[1] != nullptr);
+
+    std::unique_ptr<vectorized::Block> block(new vectorized::Block());
+    bool eof = false;
+    st = scanner.get_next(block.get(), &eof);
+    ASSERT_TRUE(st.ok());
+    ASSERT_TRUE(eof);
+    auto columns = block->get_columns();
+    ASSERT_EQ(columns.size(), 3);
+    ASSERT_EQ(2, block->rows());
+    ASSERT_EQ(columns[0]->get_int(0), 1);
+    ASSERT_EQ(columns[0]->get_int(1), 7);
+    ASSERT_EQ(columns[1]->get_int(0), 2);
+    ASSERT_EQ(columns[1]->get_int(1), 8);
+
+    ASSERT_EQ(1, _counter.num_rows_filtered);
+    ASSERT_EQ(0, _counter.num_rows_unselected);
+    ASSERT_EQ(1, _runtime_state._num_print_error_rows.load());
+    // the src line is dumped from the text of the row, the src columns only hold nulls
+    ASSERT_EQ(
+            "Reason: column(k2) value is incorrect while strict mode is true, src value is a5. "
+            "src line [4 a5 6]; \n",
+            read_error_log());
+}
+
+TEST_F(VBrokerScannerTest, null_value_of_not_nullable_column) {
+    std::vector<TBrokerRangeDesc> ranges;
+    TBrokerRangeDesc range;
+    range.path = "./be/test/exec/test_data/broker_scanner/null_value.csv";
+    range.start_offset = 0;
+    range.size = -1;
+    range.splittable = true;
+    range.file_type = TFileType::FILE_LOCAL;
+    range.format_type = TFileFormatType::FORMAT_CSV_PLAIN;
+    ranges.push_back(range);
+    _params.__set_strict_mode(true);
+    _params.__set_dest_sid_to_src_sid_without_trans({{1, 4}, {2, 5}, {3, 6}});
+    init_error_log();
+    VBrokerScanner scanner(&_runtime_state, _profile, _params, ranges, _addresses, _pre_filter,
+                           &_counter);
+    auto st = scanner.open();
+    ASSERT_TRUE(st.ok());
+    ASSERT_EQ(3, scanner._text_dest_columns.size());
+
+    std::unique_ptr<vectorized::Block> block(new vectorized::Block());
+    bool eof = false;
+    st = scanner.get_next(block.get(), &eof);
+    ASSERT_TRUE(st.ok());
+    ASSERT_TRUE(eof);
+    auto columns = block->get_columns();
+    ASSERT_EQ(columns.size(), 3);
+    ASSERT_EQ(2, block->rows());
+    ASSERT_FALSE(columns[1]->is_nullable());
+    ASSERT_EQ(columns[1]->get_int(0), 2);
+    ASSERT_EQ(columns[1]->get_int(1), 8);
+
+    // a null is not an incorrect value in strict mode, but the column is not nullable
+    ASSERT_EQ(1, _counter.num_rows_filtered);
+    ASSERT_EQ(1, _runtime_state._num_print_error_rows.load());
+    ASSERT_EQ(
+            "Reason: column(k2) values is null while columns is not nullable. "
+            "src line [4 \\N 6]; \n",
+            read_error_log());
+}
+
+TEST_F(VBrokerScannerTest, pre_filter_skips_invalid_value) {
+    std::vector<TBrokerRangeDesc> ranges;
+    TBrokerRangeDesc range;
+    range.path = "./be/test/exec/test_data/broker_scanner/invalid_value.csv";
+    range.start_offset = 0;
+    range.size = -1;
+    range.splittable = true;
+    range.file_type = TFileType::FILE_LOCAL;
+    range.format_type = TFileFormatType::FORMAT_CSV_PLAIN;
+    ranges.push_back(range);
+    _params.__set_strict_mode(true);
+    _params.__set_dest_sid_to_src_sid_without_trans({{1, 4}, {2, 5}, {3, 6}});
+    init_error_log();
+    // k1 < '4' drops the row with the invalid value of k2
+    init_pre_filter("4");
+    VBrokerScanner scanner(&_runtime_state, _profile, _params, ranges, _addresses, _pre_filter,
+                           &_counter);
+    auto st = scanner.open();
+    ASSERT_TRUE(st.ok());
+    // the pre filter reads the text of the src slots, they are not parsed by the deserializers
+    ASSERT_TRUE(scanner._text_dest_columns.empty());
+    ASSERT_TRUE(scanner._src_deserializers.empty());
+
+    std::unique_ptr<vectorized::Block> block(new vectorized::Block());
+    bool eof = false;
+    st = scanner.get_next(block.get(), &eof);
+    ASSERT_TRUE(st.ok());
+    ASSERT_TRUE(eof);
+    auto columns = block->get_columns();
+    ASSERT_EQ(columns.size(), 3);
+    ASSERT_EQ(1, block->rows());
+    ASSERT_EQ(columns[0]->get_int(0), 1);
+    ASSERT_EQ(columns[1]->get_int(0), 2);
+    ASSERT_EQ(columns[2]->get_int(0), 3);
+
+    // the dropped rows are unselected, the invalid value of them is never reported
+    ASSERT_EQ(2, _counter.num_rows_unselected);
+    ASSERT_EQ(0, _counter.num_rows_filtered);
+    ASSERT_EQ(0, _runtime_state._num_print_error_rows.load());
+    ASSERT_EQ("", read_error_log());
+}
+
 } // namespace vectorized
 } // namespace doris
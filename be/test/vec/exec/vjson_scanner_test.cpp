@@ -24,6 +24,7 @@
 #include <string>
 #include <vector>
 
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "exec/broker_scan_node.h"
 #include "exec/local_file_reader.h"
@@ -770,5 +771,65 @@ TEST_F(VJsonScannerTest, use_jsonpaths_mismatch) {
     scan_node.close(&_runtime_state);
 }
 
+TEST_F(VJsonScannerTest, malformed_json_by_line) {
+    bool old_enable_simdjson_reader = config::enable_simdjson_reader;
+    // the documents which are not well-formed as a whole are filtered by both readers, even
+    // if the broken part comes after all the columns
+    for (bool enable_simdjson_reader : {true, false}) {
+        config::enable_simdjson_reader = enable_simdjson_reader;
+        VBrokerScanNode scan_node(&_obj_pool, _tnode, *_desc_tbl);
+        scan_node.init(_tnode);
+        auto status = scan_node.prepare(&_runtime_state);
+        EXPECT_TRUE(status.ok());
+
+        std::vector<TScanRangeParams> scan_ranges;
+        {
+            TScanRangeParams scan_range_params;
+
+            TBrokerScanRange broker_scan_range;
+            broker_scan_range.params = _params;
+            TBrokerRangeDesc range;
+            range.start_offset = 0;
+            range.size = -1;
+            range.format_type = TFileFormatType::FORMAT_JSON;
+            range.splittable = true;
+            range.strip_outer_array = false;
+            range.__isset.strip_outer_array = true;
+            range.__set_num_as_string(true);
+            range.path = "./be/test/exec/test_data/json_scanner/test_malformed.json";
+            range.file_type = TFileType::FILE_LOCAL;
+            range.read_json_by_line = true;
+            range.__isset.read_json_by_line = true;
+            broker_scan_range.ranges.push_back(range);
+            scan_range_params.scan_range.__set_broker_scan_range(broker_scan_range);
+            scan_ranges.push_back(scan_range_params);
+        }
+
+        scan_node.set_scan_ranges(scan_ranges);
+        status = scan_node.open(&_runtime_state);
+        EXPECT_TRUE(status.ok());
+
+        std::vector<std::string> titles;
+        bool eof = false;
+        while (!eof) {
+            vectorized::Block block;
+            status = scan_node.get_next(&_runtime_state, &block, &eof);
+            ASSERT_TRUE(status.ok());
+            if (block.rows() == 0) {
+                continue;
+            }
+            auto columns = block.get_columns_with_type_and_name();
+            for (int i = 0; i < block.rows(); ++i) {
+                titles.push_back(columns[2].to_string(i));
+            }
+        }
+        ASSERT_EQ(2, titles.size()) << "enable_simdjson_reader=" << enable_simdjson_reader;
+        EXPECT_EQ("SayingsoftheCentury", titles[0]);
+        EXPECT_EQ("TheLordoftheRings", titles[1]);
+        scan_node.close(&_runtime_state);
+    }
+    config::enable_simdjson_reader = old_enable_simdjson_reader;
+}
+
 } // namespace vectorized
 } // namespace doris
@@ -35,6 +35,26 @@ TEST(FunctionJsonTEST, GetJsonDoubleTest) {
              DOUBLE(1.1)}};
 
     check_function<DataTypeFloat64, true>(func_name, input_types, data_set);
+
+    // path is constant value, which is compiled in prepare()
+    DataSet const_path_data_set = {
+            {{VARCHAR("{\"k1\":1.3, \"k2\":2}"), VARCHAR("$.k2")}, DOUBLE(2)},
+            {{VARCHAR("{\"k1\":1e2}"), VARCHAR("$.k1")}, DOUBLE(100)},
+            {{VARCHAR("{\"k1\":4294967296}"), VARCHAR("$.k1")}, Null()},
+            {{VARCHAR("{\"k1\":\"1.3\"}"), VARCHAR("$.k1")}, Null()},
+            {{VARCHAR("{\"k1\":null}"), VARCHAR("$.k1")}, Null()},
+            // malformed json is NULL, even if the broken part is after the value
+            {{VARCHAR("{\"k1\":1.3,}"), VARCHAR("$.k1")}, Null()},
+            {{VARCHAR("{\"k1\":1.3, \"k2\":[1, 2"), VARCHAR("$.k1")}, Null()}};
+    InputTypeSet const_path_input_types = {TypeIndex::String, Consted {TypeIndex::String}};
+    for (const auto& line : data_set) {
+        DataSet const_path_line = {line};
+        check_function<DataTypeFloat64, true>(func_name, const_path_input_types, const_path_line);
+    }
+    for (const auto& line : const_path_data_set) {
+        DataSet const_path_line = {line};
+        check_function<DataTypeFloat64, true>(func_name, const_path_input_types, const_path_line);
+    }
 }
 
 TEST(FunctionJsonTEST, GetJsonIntTest) {
@@ -47,6 +67,28 @@ TEST(FunctionJsonTEST, GetJsonIntTest) {
             {{VARCHAR("{\"k1.key\":{\"k2\":[1, 2]}}"), VARCHAR("$.\"k1.key\".k2[0]")}, INT(1)}};
 
     check_function<DataTypeInt32, true>(func_name, input_types, data_set);
+
+    // path is constant value, which is compiled in prepare()
+    DataSet const_path_data_set = {
+            {{VARCHAR("{\"k1\":-2147483648}"), VARCHAR("$.k1")}, INT(-2147483648)},
+            {{VARCHAR("{\"k1\":2147483648}"), VARCHAR("$.k1")}, Null()},
+            {{VARCHAR("{\"k1\":1.0}"), VARCHAR("$.k1")}, Null()},
+            {{VARCHAR("{\"k1\":[1, 2]}"), VARCHAR("$.k1[2]")}, Null()},
+            {{VARCHAR("{\"k1\":{\"k2\":3}}"), VARCHAR("$.k2")}, Null()},
+            {{VARCHAR("{\"k1\":{\"0\":3}}"), VARCHAR("$.k1.0")}, INT(3)},
+            {{VARCHAR("{\"k1/k2\":4}"), VARCHAR("$.\"k1/k2\"")}, INT(4)},
+            // malformed json is NULL, even if the broken part is after the value
+            {{VARCHAR("{\"k1\":1, \"k2\":tru}"), VARCHAR("$.k1")}, Null()},
+            {{VARCHAR("{\"k1\":1} 2"), VARCHAR("$.k1")}, Null()}};
+    InputTypeSet const_path_input_types = {TypeIndex::String, Consted {TypeIndex::String}};
+    for (const auto& line : data_set) {
+        DataSet const_path_line = {line};
+        check_function<DataTypeInt32, true>(func_name, const_path_input_types, const_path_line);
+    }
+    for (const auto& line : const_path_data_set) {
+        DataSet const_path_line = {line};
+        check_function<DataTypeInt32, true>(func_name, const_path_input_types, const_path_line);
+    }
 }
 
 TEST(FunctionJsonTEST, GetJsonStringTest) {
@@ -64,6 +106,34 @@ TEST(FunctionJsonTEST, GetJsonStringTest) {
              VARCHAR("[\"v1\",\"v3\",\"v4\"]")}};
 
     check_function<DataTypeString, true>(func_name, input_types, data_set);
+
+    // path is constant value, which is compiled in prepare()
+    DataSet const_path_data_set = {
+            {{VARCHAR("{\"k1\":{\"k2\":[1, 2.50, true, null, \"a\\\"b\"]}}"),
+              VARCHAR("$.k1")},
+             VARCHAR("{\"k2\":[1,2.5,true,null,\"a\\\"b\"]}")},
+            {{VARCHAR("{\"k1\":\"a\\\"b\"}"), VARCHAR("$.k1")}, VARCHAR("a\"b")},
+            {{VARCHAR("{\"k1\":-12}"), VARCHAR("$.k1")}, VARCHAR("-12")},
+            {{VARCHAR("{\"k1\":false}"), VARCHAR("$.k1")}, VARCHAR("false")},
+            {{VARCHAR("{\"k1\":null}"), VARCHAR("$.k1")}, Null()},
+            {{VARCHAR("{\"k1\":\"v1\"}"), VARCHAR("$.k2")}, Null()},
+            {{VARCHAR("[\"v1\", \"v2\"]"), VARCHAR("$.[1]")}, VARCHAR("v2")},
+            {{VARCHAR("{\"k1\":[\"v1\", \"v2\"]}"), VARCHAR("$.k1[*]")},
+             VARCHAR("[\"v1\",\"v2\"]")},
+            {{VARCHAR("{\"k1\":\"v1\""), VARCHAR("$.k2")}, Null()},
+            // malformed json is NULL, even if the broken part is after the value
+            {{VARCHAR("{\"k1\":\"v1\""), VARCHAR("$.k1")}, Null()},
+            {{VARCHAR("{\"k1\":\"v1\"} x"), VARCHAR("$.k1")}, Null()},
+            {{VARCHAR("{\"k1\":\"v1\", \"k2\":{\"k3\" 1}}"), VARCHAR("$.k1")}, Null()}};
+    InputTypeSet const_path_input_types = {TypeIndex::String, Consted {TypeIndex::String}};
+    for (const auto& line : data_set) {
+        DataSet const_path_line = {line};
+        check_function<DataTypeString, true>(func_name, const_path_input_types, const_path_line);
+    }
+    for (const auto& line : const_path_data_set) {
+        DataSet const_path_line = {line};
+        check_function<DataTypeString, true>(func_name, const_path_input_types, const_path_line);
+    }
 }
 
 } // namespace doris::vectorized
@@ -0,0 +1,184 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include "function_test_util.h"
+#include "gen_cpp/PaloInternalService_types.h"
+#include "util/jsonb.h"
+#include "util/mysql_row_buffer.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/data_types/data_type_jsonb.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/functions/function_cast.h"
+#include "vec/sink/mysql_result_writer.h"
+
+namespace doris::vectorized {
+using namespace ut_type;
+
+// jsonb is stored as binary in a string column
+static VARCHAR JSONB(const std::string& json) {
+    std::string jsonb;
+    EXPECT_TRUE(JsonbDocument::from_json(json.data(), json.size(), &jsonb).ok());
+    return jsonb;
+}
+
+TEST(FunctionJsonbTEST, JsonbExtractStringTest) {
+    std::string func_name = "jsonb_extract_string";
+    InputTypeSet input_types = {TypeIndex::String, TypeIndex::String};
+    DataSet data_set = {
+            {{JSONB(R"({"k1":"v1", "k2":2})"), VARCHAR("$.k1")}, VARCHAR("v1")},
+            {{JSONB(R"({"k1":"v1", "k2":[1, {"k3":true}]})"), VARCHAR("$.k2")},
+             VARCHAR(R"([1,{"k3":true}])")},
+            {{JSONB(R"({"my.key":["a", "b"]})"), VARCHAR("$.\"my.key\"[1]")}, VARCHAR("b")},
+            {{JSONB(R"({"k1":null})"), VARCHAR("$.k1")}, Null()},
+            {{JSONB(R"({"k1":"v1"})"), VARCHAR("$.k2")}, Null()},
+            {{JSONB(R"({"k1":"v1"})"), VARCHAR("$")}, VARCHAR(R"({"k1":"v1"})")},
+            {{VARCHAR("not jsonb"), VARCHAR("$.k1")}, Null()},
+            {{Null(), VARCHAR("$.k1")}, Null()}};
+
+    check_function<DataTypeString, true>(func_name, input_types, data_set);
+
+    // path is constant value, which is parsed in prepare()
+    InputTypeSet const_path_input_types = {TypeIndex::String, Consted {TypeIndex::String}};
+    for (const auto& line : data_set) {
+        DataSet const_path_line = {line};
+        check_function<DataTypeString, true>(func_name, const_path_input_types, const_path_line);
+    }
+}
+
+TEST(FunctionJsonbTEST, JsonbExtractNumberTest) {
+    InputTypeSet input_types = {TypeIndex::String, Consted {TypeIndex::String}};
+    {
+        DataSet data_set = {
+                {{JSONB(R"({"k1":[1, -2147483648]})"), VARCHAR("$.k1[1]")}, INT(-2147483648)},
+                {{JSONB(R"({"k1":2147483648})"), VARCHAR("$.k1")}, Null()},
+                {{JSONB(R"({"k1":1.0})"), VARCHAR("$.k1")}, Null()},
+                {{JSONB(R"({"k1":"1"})"), VARCHAR("$.k1")}, Null()},
+                {{JSONB(R"({"k1":[1, 2]})"), VARCHAR("$.k1[2]")}, Null()},
+                {{JSONB(R"({"k1":[1, 2]})"), VARCHAR("$.k1[*]")}, Null()}};
+        for (const auto& line : data_set) {
+            DataSet const_path_line = {line};
+            check_function<DataTypeInt32, true>("jsonb_extract_int", input_types,
+                                                const_path_line);
+        }
+    }
+    {
+        DataSet data_set = {
+                {{JSONB(R"({"k1":{"k2":-9223372036854775808}})"), VARCHAR("$.k1.k2")},
+                 BIGINT(std::numeric_limits<int64_t>::min())},
+                {{JSONB(R"({"k1":18446744073709551615})"), VARCHAR("$.k1")}, Null()}};
+        for (const auto& line : data_set) {
+            DataSet const_path_line = {line};
+            check_function<DataTypeInt64, true>("jsonb_extract_bigint", input_types,
+                                                const_path_line);
+        }
+    }
+    {
+        DataSet data_set = {{{JSONB(R"({"k1":1.5})"), VARCHAR("$.k1")}, DOUBLE(1.5)},
+                            {{JSONB(R"({"k1":2})"), VARCHAR("$.k1")}, DOUBLE(2)},
+                            {{JSONB(R"({"k1":true})"), VARCHAR("$.k1")}, Null()}};
+        for (const auto& line : data_set) {
+            DataSet const_path_line = {line};
+            check_function<DataTypeFloat64, true>("jsonb_extract_double", input_types,
+                                                  const_path_line);
+        }
+    }
+}
+
+TEST(FunctionJsonbTEST, CastStringToJsonbTest) {
+    std::vector<std::string> jsons = {R"({"k1":"v1"})", R"([1, 2.5, null, true])", R"("str")",
+                                      "not json", ""};
+    auto col_from = ColumnString::create();
+    for (const auto& json : jsons) {
+        col_from->insert_data(json.data(), json.size());
+    }
+    Block block;
+    block.insert({std::move(col_from), std::make_shared<DataTypeString>(), "json"});
+    block.insert({nullptr, make_nullable(std::make_shared<DataTypeJsonb>()), "jsonb"});
+
+    // invalid json is converted to NULL if the result is nullable
+    EXPECT_TRUE(ConvertImplStringToJsonb::execute(block, {0}, 1, true).ok());
+    const auto& result = assert_cast<const ColumnNullable&>(*block.get_by_position(1).column);
+    EXPECT_EQ(jsons.size(), result.size());
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_FALSE(result.is_null_at(i));
+        EXPECT_EQ(JSONB(jsons[i]), result.get_nested_column().get_data_at(i).to_string());
+    }
+    EXPECT_TRUE(result.is_null_at(3));
+    EXPECT_TRUE(result.is_null_at(4));
+
+    // otherwise it's an error
+    EXPECT_FALSE(ConvertImplStringToJsonb::execute(block, {0}, 1, false).ok());
+
+    // a constant column is converted for every row
+    auto col_json = ColumnString::create();
+    col_json->insert_data(jsons[0].data(), jsons[0].size());
+    Block const_block;
+    const_block.insert({ColumnConst::create(std::move(col_json), 3),
+                        std::make_shared<DataTypeString>(), "json"});
+    const_block.insert({nullptr, std::make_shared<DataTypeJsonb>(), "jsonb"});
+    EXPECT_TRUE(ConvertImplStringToJsonb::execute(const_block, {0}, 1, false).ok());
+    const auto& const_result = *const_block.get_by_position(1).column;
+    EXPECT_EQ(3, const_result.size());
+    for (size_t i = 0; i < const_result.size(); ++i) {
+        EXPECT_EQ(JSONB(jsons[0]), const_result.get_data_at(i).to_string());
+    }
+}
+
+TEST(FunctionJsonbTEST, MysqlResultOutputTest) {
+    std::vector<std::string> jsons = {R"({"k1":[1, 2.5, null]})", R"("str")", "true"};
+    auto jsonb_column = ColumnString::create();
+    auto null_map = ColumnUInt8::create();
+    for (const auto& json : jsons) {
+        auto jsonb = JSONB(json);
+        jsonb_column->insert_data(jsonb.data(), jsonb.size());
+        null_map->insert_value(0);
+    }
+    // a null value
+    jsonb_column->insert_default();
+    null_map->insert_value(1);
+    // the default value, which is not a valid jsonb document
+    jsonb_column->insert_default();
+    null_map->insert_value(0);
+    ColumnPtr column = ColumnNullable::create(std::move(jsonb_column), std::move(null_map));
+
+    std::vector<VExprContext*> output_vexpr_ctxs;
+    VMysqlResultWriter writer(nullptr, output_vexpr_ctxs, nullptr);
+    auto result = std::make_unique<TFetchDataResult>();
+    result->result_batch.rows.resize(column->size());
+    EXPECT_TRUE((writer._add_one_column<PrimitiveType::TYPE_JSONB, true>(column, result)).ok());
+
+    // jsonb is output as json text
+    std::vector<std::string> expected_jsons = {R"({"k1":[1,2.5,null]})", R"("str")", "true"};
+    for (size_t i = 0; i < column->size(); ++i) {
+        MysqlRowBuffer buffer;
+        if (i < expected_jsons.size()) {
+            buffer.push_string(expected_jsons[i].data(), expected_jsons[i].size());
+        } else if (i == expected_jsons.size()) {
+            buffer.push_null();
+        } else {
+            buffer.push_string("null", 4);
+        }
+        EXPECT_EQ(std::string(buffer.buf(), buffer.length()), result->result_batch.rows[i]);
+    }
+}
+
+} // namespace doris::vectorized
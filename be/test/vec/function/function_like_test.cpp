@@ -21,10 +21,28 @@
 
 #include "function_test_util.h"
 #include "util/cpu_info.h"
+#include "vec/common/string_searcher.h"
 #include "vec/core/types.h"
 
 namespace doris::vectorized {
 
+// Build a DataSet which matches the constant `pattern` against every haystack, `results` are
+// the expected results of `haystacks` in order, and a null haystack is appended at last.
+static DataSet const_pattern_data_set(const std::vector<std::string>& haystacks,
+                                      const std::any& pattern,
+                                      const std::vector<uint8_t>& results) {
+    DataSet data_set;
+    for (size_t i = 0; i < haystacks.size(); ++i) {
+        if (pattern.type() == typeid(Null)) {
+            data_set.push_back({{haystacks[i], pattern}, Null()});
+        } else {
+            data_set.push_back({{haystacks[i], pattern}, results[i]});
+        }
+    }
+    data_set.push_back({{Null(), pattern}, Null()});
+    return data_set;
+}
+
 TEST(FunctionLikeTest, like) {
     std::string func_name = "like";
 
@@ -49,16 +67,32 @@ TEST(FunctionLikeTest, like) {
                         {{std::string("abc"), std::string("_a_")}, uint8_t(0)},
                         {{std::string("abc"), std::string("a__")}, uint8_t(1)},
                         {{std::string("abc"), std::string("a_")}, uint8_t(0)},
+                        {{std::string("abxc"), std::string("%b%c")}, uint8_t(1)},
+                        {{std::string("acb"), std::string("%b%c")}, uint8_t(0)},
+                        {{std::string("a%bc"), std::string("%\\%b_")}, uint8_t(1)},
+                        {{std::string("abc"), std::string("%\\%b_")}, uint8_t(0)},
                         // null
                         {{std::string("abc"), Null()}, Null()},
                         {{Null(), std::string("_x__ab%")}, Null()}};
 
-    // pattern is constant value
+    // pattern is constant value, match every pattern against a column of many rows
     InputTypeSet const_pattern_input_types = {TypeIndex::String, Consted {TypeIndex::String}};
-    for (const auto& line : data_set) {
-        DataSet const_pattern_dataset = {line};
+    std::vector<std::string> haystacks = {"abc", "ab", "bc", "abxc", "acb", "a%bc", "abcd", ""};
+    std::vector<std::pair<std::any, std::vector<uint8_t>>> const_patterns = {
+            {std::string("%b%"), {1, 1, 1, 1, 1, 1, 1, 0}},
+            {std::string("%ad%"), {0, 0, 0, 0, 0, 0, 0, 0}},
+            {std::string("%c"), {1, 0, 1, 1, 0, 1, 0, 0}},
+            {std::string("a%"), {1, 1, 0, 1, 1, 1, 1, 0}},
+            {std::string("abc"), {1, 0, 0, 0, 0, 0, 0, 0}},
+            {std::string("a_c%"), {1, 0, 0, 0, 0, 0, 1, 0}},
+            {std::string("__c"), {1, 0, 0, 0, 0, 0, 0, 0}},
+            {std::string("_b_"), {1, 0, 0, 0, 0, 0, 0, 0}},
+            {std::string("%b%c"), {1, 0, 1, 1, 0, 1, 0, 0}},
+            {std::string("%\\%b_"), {0, 0, 0, 0, 0, 1, 0, 0}},
+            {Null(), {}}};
+    for (const auto& [pattern, results] : const_patterns) {
         check_function<DataTypeUInt8, true>(func_name, const_pattern_input_types,
-                                            const_pattern_dataset);
+                                            const_pattern_data_set(haystacks, pattern, results));
     }
 
     // pattern is not constant value
@@ -89,16 +123,31 @@ TEST(FunctionLikeTest, regexp) {
                         {{std::string("abc"), std::string(".c")}, uint8_t(1)},
                         {{std::string("abc"), std::string(".b.")}, uint8_t(1)},
                         {{std::string("abc"), std::string(".a.")}, uint8_t(0)},
+                        // alternation
+                        {{std::string("an error occurs"), std::string("warn|error")}, uint8_t(1)},
+                        {{std::string("info"), std::string("warn|error")}, uint8_t(0)},
+                        {{std::string("warn"), std::string("warn|error|fatal")}, uint8_t(1)},
                         // null
                         {{std::string("abc"), Null()}, Null()},
                         {{Null(), std::string("xxx.*")}, Null()}};
 
-    // pattern is constant value
+    // pattern is constant value, match every pattern against a column of many rows
     InputTypeSet const_pattern_input_types = {TypeIndex::String, Consted {TypeIndex::String}};
-    for (const auto& line : data_set) {
-        DataSet const_pattern_dataset = {line};
+    std::vector<std::string> haystacks = {"abc", "ab", "bc", "abcde", "abcd",
+                                          "an error occurs", "info", "warn", ""};
+    std::vector<std::pair<std::any, std::vector<uint8_t>>> const_patterns = {
+            {std::string(".*b.*"), {1, 1, 1, 1, 1, 0, 0, 0, 0}},
+            {std::string(".*ad.*"), {0, 0, 0, 0, 0, 0, 0, 0, 0}},
+            {std::string(".*c$"), {1, 0, 1, 0, 0, 0, 0, 0, 0}},
+            {std::string("^a.*"), {1, 1, 0, 1, 1, 1, 0, 0, 0}},
+            {std::string("^abc$"), {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+            {std::string("a.*d"), {0, 0, 0, 1, 1, 0, 0, 0, 0}},
+            {std::string(".b."), {1, 0, 0, 1, 1, 0, 0, 0, 0}},
+            {std::string("warn|error"), {0, 0, 0, 0, 0, 1, 0, 1, 0}},
+            {Null(), {}}};
+    for (const auto& [pattern, results] : const_patterns) {
         check_function<DataTypeUInt8, true>(func_name, const_pattern_input_types,
-                                            const_pattern_dataset);
+                                            const_pattern_data_set(haystacks, pattern, results));
     }
 
     // pattern is not constant value
@@ -106,6 +155,26 @@ TEST(FunctionLikeTest, regexp) {
     check_function<DataTypeUInt8, true>(func_name, input_types, data_set);
 }
 
+TEST(FunctionLikeTest, string_searcher) {
+    std::string haystack = "abcabdabcabeabcabdabcabfabcabdabcabe";
+    const auto* begin = reinterpret_cast<const uint8_t*>(haystack.data());
+    const auto* end = begin + haystack.size();
+
+    EXPECT_EQ(begin, StringSearcher("").search(begin, end));
+    EXPECT_EQ(begin + 5, StringSearcher("d").search(begin, end));
+    EXPECT_EQ(begin + 23, StringSearcher("f").search(begin, end));
+    EXPECT_EQ(end, StringSearcher("g").search(begin, end));
+    EXPECT_EQ(begin + 9, StringSearcher("abe").search(begin, end));
+    EXPECT_EQ(begin + 21, StringSearcher("abfab").search(begin, end));
+    EXPECT_EQ(begin + 33, StringSearcher("abe").search(begin + 10, end));
+    EXPECT_EQ(end, StringSearcher("abg").search(begin, end));
+    EXPECT_EQ(begin, StringSearcher(haystack).search(begin, end));
+    EXPECT_EQ(end, StringSearcher(haystack + "a").search(begin, end));
+    // match must be inside the range
+    EXPECT_EQ(begin + 11, StringSearcher("eabc").search(begin, begin + 15));
+    EXPECT_EQ(begin + 14, StringSearcher("eabc").search(begin, begin + 14));
+}
+
 TEST(FunctionLikeTest, regexp_extract) {
     std::string func_name = "regexp_extract";
 
@@ -218,7 +218,8 @@ Block* create_block_from_inputset(const InputTypeSet& input_types, const InputDa
                                 : desc.data_type;
         WhichDataType type(type_ptr);
 
-        for (int j = 0; j < row_size; j++) {
+        auto insert_rows = desc.is_const ? std::min<size_t>(row_size, 1) : row_size;
+        for (size_t j = 0; j < insert_rows; j++) {
             if (!insert_cell(column, type_ptr, input_set[j][i])) {
                 return nullptr;
             }
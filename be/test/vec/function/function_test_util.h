@@ -91,7 +91,8 @@ void check_vec_table_function(TableFunction* fn, const InputTypeSet& input_types
 
 // Null values are represented by Null()
 // The type of the constant column is represented as follows: Consted {TypeIndex::String}
-// A DataSet with a constant column can only have one row of data
+// The value of a constant column is taken from the first row of the DataSet, so all rows
+// of a DataSet with a constant column should have the same value in that column
 template <typename ReturnType, bool nullable = false>
 void check_function(const std::string& func_name, const InputTypeSet& input_types,
                     const DataSet& data_set) {
@@ -110,7 +111,8 @@ void check_function(const std::string& func_name, const InputTypeSet& input_type
         auto type_ptr = desc.data_type->is_nullable()
                                 ? ((DataTypeNullable*)(desc.data_type.get()))->get_nested_type()
                                 : desc.data_type;
-        for (int j = 0; j < row_size; j++) {
+        auto insert_rows = desc.is_const ? std::min<size_t>(row_size, 1) : row_size;
+        for (size_t j = 0; j < insert_rows; j++) {
             EXPECT_TRUE(insert_cell(column, type_ptr, data_set[j].first[i]));
         }
 
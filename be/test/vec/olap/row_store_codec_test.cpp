@@ -0,0 +1,119 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/olap/row_store_codec.h"
+
+#include <gtest/gtest.h>
+
+namespace doris::vectorized {
+
+static void add_column(TabletSchemaPB* schema_pb, const std::string& name, const std::string& type,
+                       bool is_key, bool is_nullable) {
+    ColumnPB* column = schema_pb->add_column();
+    column->set_unique_id(schema_pb->column_size());
+    column->set_name(name);
+    column->set_type(type);
+    column->set_is_key(is_key);
+    column->set_is_nullable(is_nullable);
+    column->set_length(type == "BIGINT" ? 8 : (type == "INT" ? 4 : 64));
+    column->set_aggregation(is_key ? "NONE" : "REPLACE");
+}
+
+static TabletSchemaPB make_schema_pb() {
+    TabletSchemaPB schema_pb;
+    schema_pb.set_keys_type(UNIQUE_KEYS);
+    add_column(&schema_pb, "k1", "INT", true, false);
+    add_column(&schema_pb, "v1", "VARCHAR", false, true);
+    add_column(&schema_pb, "v2", "BIGINT", false, false);
+    add_column(&schema_pb, "__DORIS_ROW_STORE_COL__", "STRING", false, true);
+    schema_pb.set_row_store_col_idx(3);
+    return schema_pb;
+}
+
+static Block make_block(const TabletSchema& schema) {
+    Block block = schema.create_block({0, 1, 2, 3});
+    MutableColumns columns = block.mutate_columns();
+    for (int i = 0; i < 3; ++i) {
+        int32_t k1 = i;
+        columns[0]->insert_data(reinterpret_cast<const char*>(&k1), sizeof(k1));
+        if (i == 1) {
+            columns[1]->insert_data(nullptr, 0);
+        } else {
+            std::string v1 = "value" + std::to_string(i);
+            columns[1]->insert_data(v1.data(), v1.size());
+        }
+        int64_t v2 = i * 100;
+        columns[2]->insert_data(reinterpret_cast<const char*>(&v2), sizeof(v2));
+        columns[3]->insert_default();
+    }
+    block.set_columns(std::move(columns));
+    return block;
+}
+
+TEST(RowStoreCodecTest, encode_and_decode) {
+    TabletSchema schema;
+    schema.init_from_pb(make_schema_pb());
+    RowStoreCodec codec(schema);
+    EXPECT_EQ(std::vector<uint32_t>({0, 1, 2}), codec.column_ids());
+
+    Block block = make_block(schema);
+    // only the rows in the range are encoded
+    auto rows = codec.encode(block, 1, 2);
+    ASSERT_EQ(2, rows->size());
+
+    Block row_block = schema.create_block(codec.column_ids());
+    MutableColumns columns = row_block.mutate_columns();
+    // an empty value is not decoded
+    EXPECT_FALSE(codec.decode(StringRef(), columns));
+    EXPECT_TRUE(codec.decode(rows->get_data_at(0), columns));
+    EXPECT_TRUE(codec.decode(rows->get_data_at(1), columns));
+    ASSERT_EQ(2, columns[0]->size());
+    EXPECT_EQ(1, columns[0]->get_int(0));
+    EXPECT_TRUE(columns[1]->is_null_at(0));
+    EXPECT_EQ(100, columns[2]->get_int(0));
+    EXPECT_EQ(2, columns[0]->get_int(1));
+    EXPECT_EQ("value2", columns[1]->get_data_at(1).to_string());
+    EXPECT_EQ(200, columns[2]->get_int(1));
+}
+
+TEST(RowStoreCodecTest, decode_with_other_columns) {
+    TabletSchema schema;
+    schema.init_from_pb(make_schema_pb());
+    Block block = make_block(schema);
+    auto rows = RowStoreCodec(schema).encode(block, 0, 3);
+
+    // a column is added after the rows are encoded
+    TabletSchemaPB new_schema_pb = make_schema_pb();
+    add_column(&new_schema_pb, "v3", "INT", false, true);
+    TabletSchema new_schema;
+    new_schema.init_from_pb(new_schema_pb);
+    RowStoreCodec new_codec(new_schema);
+    Block row_block = new_schema.create_block(new_codec.column_ids());
+    MutableColumns columns = row_block.mutate_columns();
+    EXPECT_FALSE(new_codec.decode(rows->get_data_at(0), columns));
+    EXPECT_EQ(0, columns[0]->size());
+}
+
+TEST(RowStoreCodecTest, aggregate_keys) {
+    TabletSchemaPB schema_pb = make_schema_pb();
+    schema_pb.set_keys_type(AGG_KEYS);
+    TabletSchema schema;
+    schema.init_from_pb(schema_pb);
+    EXPECT_EQ(-1, schema.row_store_col_idx());
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,332 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/olap/vertical_merge_iterator.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+#include "env/env.h"
+#include "olap/merger.h"
+#include "olap/tablet_schema.h"
+
+namespace doris {
+namespace vectorized {
+
+static const std::string kTestDir = "./ut_dir/vertical_merge_iterator_test";
+
+class VerticalMergeIteratorTest : public testing::Test {
+public:
+    void SetUp() override {
+        if (Env::Default()->path_exists(kTestDir).ok()) {
+            EXPECT_TRUE(Env::Default()->delete_dir(kTestDir).ok());
+        }
+        EXPECT_TRUE(Env::Default()->create_dirs(kTestDir).ok());
+        _origin_memory_mb = config::vertical_compaction_max_row_source_memory_mb;
+    }
+
+    void TearDown() override {
+        config::vertical_compaction_max_row_source_memory_mb = _origin_memory_mb;
+        EXPECT_TRUE(Env::Default()->delete_dir(kTestDir).ok());
+    }
+
+    static void add_column(TabletSchemaPB* schema_pb, const std::string& name, bool is_key,
+                           const std::string& aggregation = "REPLACE") {
+        ColumnPB* column = schema_pb->add_column();
+        column->set_unique_id(schema_pb->column_size());
+        column->set_name(name);
+        column->set_type("INT");
+        column->set_is_key(is_key);
+        column->set_is_nullable(false);
+        column->set_length(4);
+        column->set_aggregation(is_key ? "NONE" : aggregation);
+    }
+
+    using Rows = std::vector<std::vector<int32_t>>;
+
+    // Merge inputs of (k1, v1, v2) column group by column group like
+    // Merger::vertical_merge_rowsets, with the row sources spilled to file.
+    void vertical_merge(KeysType keys_type, const std::vector<Rows>& inputs, Rows* result,
+                        uint64_t* merged_rows);
+
+private:
+    int64_t _origin_memory_mb = 0;
+};
+
+TEST_F(VerticalMergeIteratorTest, row_source) {
+    RowSource row_source(10, false);
+    EXPECT_EQ(10, row_source.get_source_num());
+    EXPECT_FALSE(row_source.agg_flag());
+
+    row_source.set_agg_flag(true);
+    EXPECT_EQ(10, row_source.get_source_num());
+    EXPECT_TRUE(row_source.agg_flag());
+
+    RowSource from_data(row_source.data());
+    EXPECT_EQ(10, from_data.get_source_num());
+    EXPECT_TRUE(from_data.agg_flag());
+
+    from_data.set_agg_flag(false);
+    EXPECT_EQ(10, from_data.data());
+
+    RowSource max_source(RowSource::MAX_SOURCE_NUM, true);
+    EXPECT_EQ(RowSource::MAX_SOURCE_NUM, max_source.get_source_num());
+    EXPECT_TRUE(max_source.agg_flag());
+}
+
+// Returns the rows of a column group of an input in blocks of at most 2 rows.
+class ColumnGroupIterator : public RowwiseIterator {
+public:
+    ColumnGroupIterator(const TabletSchema& tablet_schema, const std::vector<uint32_t>& column_ids,
+                        const std::vector<std::vector<int32_t>>& rows)
+            : _schema(tablet_schema.columns(), column_ids) {
+        for (const auto& row : rows) {
+            std::vector<int32_t> values;
+            for (auto cid : column_ids) {
+                values.push_back(row[cid]);
+            }
+            _rows.push_back(std::move(values));
+        }
+    }
+
+    Status init(const StorageReadOptions& opts) override { return Status::OK(); }
+
+    Status next_batch(Block* block) override {
+        if (_row_idx >= _rows.size()) {
+            return Status::EndOfFile("no more rows");
+        }
+        for (size_t n = 0; n < 2 && _row_idx < _rows.size(); ++n, ++_row_idx) {
+            for (size_t i = 0; i < _rows[_row_idx].size(); ++i) {
+                auto& column = (IColumn&)(*block->get_by_position(i).column);
+                column.insert_data((const char*)&_rows[_row_idx][i], sizeof(int32_t));
+            }
+        }
+        return Status::OK();
+    }
+
+    const Schema& schema() const override { return _schema; }
+
+private:
+    Schema _schema;
+    std::vector<std::vector<int32_t>> _rows;
+    size_t _row_idx = 0;
+};
+
+static void read_all(RowwiseIterator* iter, const TabletSchema& tablet_schema,
+                     const std::vector<uint32_t>& column_ids,
+                     std::vector<std::vector<int32_t>>* rows) {
+    Status st;
+    do {
+        Block block = tablet_schema.create_block(column_ids);
+        st = iter->next_batch(&block);
+        for (size_t row = 0; row < block.rows(); ++row) {
+            std::vector<int32_t> values;
+            for (size_t i = 0; i < block.columns(); ++i) {
+                values.push_back(block.get_by_position(i).column->get_int(row));
+            }
+            rows->push_back(std::move(values));
+        }
+    } while (st.ok());
+    EXPECT_TRUE(st.is_end_of_file()) << st.to_string();
+}
+
+void VerticalMergeIteratorTest::vertical_merge(KeysType keys_type, const std::vector<Rows>& inputs,
+                                               Rows* result, uint64_t* merged_rows) {
+    TabletSchemaPB schema_pb;
+    schema_pb.set_keys_type(keys_type);
+    add_column(&schema_pb, "k1", true);
+    add_column(&schema_pb, "v1", false, "SUM");
+    add_column(&schema_pb, "v2", false, "SUM");
+    TabletSchema tablet_schema;
+    tablet_schema.init_from_pb(schema_pb);
+
+    // spill to file on every append
+    config::vertical_compaction_max_row_source_memory_mb = 0;
+    RowSourcesBuffer buffer(10001, kTestDir, "rowset_merge");
+    StorageReadOptions opts;
+    opts.block_row_max = 3;
+    std::vector<std::vector<uint32_t>> column_groups = {{0}, {1}, {2}};
+    for (const auto& column_ids : column_groups) {
+        std::vector<std::unique_ptr<RowwiseIterator>> iters;
+        for (const auto& input : inputs) {
+            iters.emplace_back(new ColumnGroupIterator(tablet_schema, column_ids, input));
+        }
+        Rows group_rows;
+        if (column_ids[0] == 0) {
+            VerticalHeapMergeIterator iter(std::move(iters), tablet_schema, column_ids, 1, -1,
+                                           &buffer);
+            ASSERT_TRUE(iter.init(opts).ok());
+            read_all(&iter, tablet_schema, column_ids, &group_rows);
+            *merged_rows = iter.merged_rows();
+            result->resize(group_rows.size());
+        } else {
+            ASSERT_TRUE(buffer.flush().ok());
+            ASSERT_TRUE(buffer.seek_to_begin().ok());
+            VerticalMaskMergeIterator iter(std::move(iters), tablet_schema, column_ids, &buffer);
+            ASSERT_TRUE(iter.init(opts).ok());
+            read_all(&iter, tablet_schema, column_ids, &group_rows);
+            ASSERT_EQ(result->size(), group_rows.size());
+        }
+        for (size_t row = 0; row < group_rows.size(); ++row) {
+            (*result)[row].push_back(group_rows[row][0]);
+        }
+    }
+}
+
+static const std::vector<std::vector<std::vector<int32_t>>> kMergeInputs = {
+        {{1, 10, 100}, {2, 20, 200}, {4, 40, 400}},
+        {{2, 21, 201}, {3, 31, 301}, {4, 41, 401}}};
+
+TEST_F(VerticalMergeIteratorTest, merge_unique_keys) {
+    Rows result;
+    uint64_t merged_rows = 0;
+    vertical_merge(UNIQUE_KEYS, kMergeInputs, &result, &merged_rows);
+    // the row of the newer input is kept
+    Rows expected = {{1, 10, 100}, {2, 21, 201}, {3, 31, 301}, {4, 41, 401}};
+    EXPECT_EQ(expected, result);
+    EXPECT_EQ(2, merged_rows);
+}
+
+TEST_F(VerticalMergeIteratorTest, merge_agg_keys) {
+    Rows result;
+    uint64_t merged_rows = 0;
+    vertical_merge(AGG_KEYS, kMergeInputs, &result, &merged_rows);
+    Rows expected = {{1, 10, 100}, {2, 41, 401}, {3, 31, 301}, {4, 81, 801}};
+    EXPECT_EQ(expected, result);
+    EXPECT_EQ(2, merged_rows);
+}
+
+TEST_F(VerticalMergeIteratorTest, merge_dup_keys) {
+    Rows result;
+    uint64_t merged_rows = 0;
+    vertical_merge(DUP_KEYS, kMergeInputs, &result, &merged_rows);
+    // the row of the older input goes first
+    Rows expected = {{1, 10, 100}, {2, 20, 200}, {2, 21, 201},
+                     {3, 31, 301}, {4, 40, 400}, {4, 41, 401}};
+    EXPECT_EQ(expected, result);
+    EXPECT_EQ(0, merged_rows);
+}
+
+static void check_row_sources(RowSourcesBuffer* buffer, const std::vector<RowSource>& expected) {
+    EXPECT_TRUE(buffer->seek_to_begin().ok());
+    size_t idx = 0;
+    while (buffer->has_remaining().ok()) {
+        ASSERT_LT(idx, expected.size());
+        EXPECT_EQ(expected[idx].data(), buffer->current().data());
+        buffer->advance();
+        ++idx;
+    }
+    EXPECT_EQ(expected.size(), idx);
+}
+
+TEST_F(VerticalMergeIteratorTest, row_sources_buffer_in_memory) {
+    RowSourcesBuffer buffer(10001, kTestDir, "rowset_in_memory");
+    std::vector<RowSource> row_sources;
+    for (uint16_t i = 0; i < 100; ++i) {
+        row_sources.emplace_back(i % 3, i % 5 == 0);
+    }
+    EXPECT_TRUE(buffer.append(row_sources).ok());
+    EXPECT_TRUE(buffer.flush().ok());
+    EXPECT_EQ(100, buffer.total_size());
+    EXPECT_FALSE(Env::Default()->path_exists(kTestDir + "/rowset_in_memory_row_sources.tmp").ok());
+
+    check_row_sources(&buffer, row_sources);
+}
+
+TEST_F(VerticalMergeIteratorTest, row_sources_buffer_spill) {
+    // spill to file on every append
+    config::vertical_compaction_max_row_source_memory_mb = 0;
+    std::string file_path = kTestDir + "/rowset_spill_row_sources.tmp";
+    std::vector<RowSource> expected;
+    {
+        RowSourcesBuffer buffer(10001, kTestDir, "rowset_spill");
+        for (int batch = 0; batch < 10; ++batch) {
+            std::vector<RowSource> row_sources;
+            for (uint16_t i = 0; i < 50; ++i) {
+                row_sources.emplace_back(batch, i % 2 == 1);
+            }
+            EXPECT_TRUE(buffer.append(row_sources).ok());
+            expected.insert(expected.end(), row_sources.begin(), row_sources.end());
+        }
+        EXPECT_TRUE(buffer.flush().ok());
+        EXPECT_EQ(500, buffer.total_size());
+        EXPECT_TRUE(Env::Default()->path_exists(file_path).ok());
+
+        // read in chunks of at most 1 MB
+        config::vertical_compaction_max_row_source_memory_mb = 1;
+        check_row_sources(&buffer, expected);
+
+        // read again like every value column group does, the row sources read into memory
+        // are not written to file again
+        for (int i = 0; i < 2; ++i) {
+            EXPECT_TRUE(buffer.flush().ok());
+            check_row_sources(&buffer, expected);
+        }
+        EXPECT_EQ(500 * sizeof(uint16_t), buffer._file_size);
+    }
+    // the file is removed with the buffer
+    EXPECT_FALSE(Env::Default()->path_exists(file_path).ok());
+}
+
+TEST_F(VerticalMergeIteratorTest, same_source_count) {
+    RowSourcesBuffer buffer(10001, kTestDir, "rowset_same_source");
+    std::vector<RowSource> row_sources = {{0, false}, {0, false}, {0, false}, {1, false},
+                                          {1, true},  {1, true},  {2, false}};
+    EXPECT_TRUE(buffer.append(row_sources).ok());
+    EXPECT_TRUE(buffer.seek_to_begin().ok());
+    EXPECT_TRUE(buffer.has_remaining().ok());
+
+    EXPECT_EQ(3, buffer.same_source_count(10));
+    EXPECT_EQ(2, buffer.same_source_count(2));
+    buffer.advance(3);
+    // agg flag is part of the row source
+    EXPECT_EQ(1, buffer.same_source_count(10));
+    buffer.advance();
+    EXPECT_EQ(2, buffer.same_source_count(10));
+    buffer.advance(2);
+    EXPECT_EQ(1, buffer.same_source_count(10));
+    buffer.advance();
+    EXPECT_TRUE(buffer.has_remaining().is_end_of_file());
+}
+
+TEST_F(VerticalMergeIteratorTest, split_columns) {
+    int32_t origin_columns_per_group = config::vertical_compaction_num_columns_per_group;
+    config::vertical_compaction_num_columns_per_group = 2;
+
+    TabletSchemaPB schema_pb;
+    schema_pb.set_keys_type(KeysType::UNIQUE_KEYS);
+    add_column(&schema_pb, "k1", true);
+    add_column(&schema_pb, "k2", true);
+    for (int i = 0; i < 5; ++i) {
+        add_column(&schema_pb, "v" + std::to_string(i), false);
+    }
+    add_column(&schema_pb, "__DORIS_SEQUENCE_COL__", false);
+    schema_pb.set_sequence_col_idx(7);
+
+    TabletSchema tablet_schema;
+    tablet_schema.init_from_pb(schema_pb);
+
+    std::vector<std::vector<uint32_t>> column_groups;
+    Merger::vertical_split_columns(tablet_schema, &column_groups);
+    std::vector<std::vector<uint32_t>> expected = {{0, 1, 7}, {2, 3}, {4, 5}, {6}};
+    EXPECT_EQ(expected, column_groups);
+
+    config::vertical_compaction_num_columns_per_group = origin_columns_per_group;
+}
+
+} // namespace vectorized
+} // namespace doris
@@ -0,0 +1,180 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/vsorted_run_merger.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "common/config.h"
+#include "runtime/types.h"
+#include "util/runtime_profile.h"
+#include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/exprs/vexpr_context.h"
+#include "vec/exprs/vslot_ref.h"
+
+namespace doris::vectorized {
+
+// A sorted run of int blocks, the blocks are handed out one by one by its supplier.
+struct TestRun {
+    std::vector<std::unique_ptr<Block>> blocks;
+    size_t next = 0;
+
+    Status get_next(Block** block) {
+        *block = next < blocks.size() ? blocks[next++].get() : nullptr;
+        return Status::OK();
+    }
+};
+
+class VSortedRunMergerTest : public testing::Test {
+public:
+    void SetUp() override {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::SLOT_REF);
+        node.__set_type(TypeDescriptor(TYPE_INT).to_thrift());
+        node.__set_is_nullable(false);
+        node.slot_ref.__set_slot_id(0);
+        node.slot_ref.__set_tuple_id(0);
+        _slot_ref = std::make_unique<VSlotRef>(node);
+        // the blocks only have the ordering column
+        _slot_ref->_column_id = 0;
+        _ctx = std::make_unique<VExprContext>(_slot_ref.get());
+        _ordering_expr.push_back(_ctx.get());
+    }
+
+protected:
+    // Run i holds the values i, i + num_runs, i + 2 * num_runs... in blocks of 3 rows, every
+    // 7th run is empty. Every value is also duplicated in the next run, if there is one.
+    static std::vector<std::unique_ptr<TestRun>> make_runs(int num_runs, int rows_per_run) {
+        std::vector<std::unique_ptr<TestRun>> runs;
+        for (int i = 0; i < num_runs; ++i) {
+            auto run = std::make_unique<TestRun>();
+            if (i % 7 != 3) {
+                std::vector<int32_t> values;
+                for (int j = 0; j < rows_per_run; ++j) {
+                    values.push_back(i + j * num_runs);
+                    if (i > 0) {
+                        values.push_back(i - 1 + j * num_runs);
+                    }
+                }
+                std::sort(values.begin(), values.end());
+                for (size_t begin = 0; begin < values.size(); begin += 3) {
+                    auto column = ColumnInt32::create();
+                    for (size_t k = begin; k < std::min(begin + 3, values.size()); ++k) {
+                        column->insert_value(values[k]);
+                    }
+                    auto block = std::make_unique<Block>();
+                    block->insert({std::move(column), std::make_shared<DataTypeInt32>(), "k"});
+                    run->blocks.emplace_back(std::move(block));
+                }
+            }
+            runs.emplace_back(std::move(run));
+        }
+        return runs;
+    }
+
+    std::vector<int32_t> merge(int num_runs, bool parallel, int64_t limit, size_t offset,
+                               size_t* num_sub_mergers) {
+        auto runs = make_runs(num_runs, 10);
+        std::vector<BlockSupplier> suppliers;
+        for (auto& run : runs) {
+            suppliers.emplace_back(
+                    std::bind(&TestRun::get_next, run.get(), std::placeholders::_1));
+        }
+
+        RuntimeProfile profile("VSortedRunMergerTest");
+        std::vector<int32_t> result;
+        {
+            VSortedRunMerger merger(_ordering_expr, _is_asc_order, _nulls_first, 8, limit,
+                                    offset, &profile);
+            EXPECT_TRUE(merger.prepare(suppliers, parallel).ok());
+            *num_sub_mergers = merger._sub_mergers.size();
+            bool eos = false;
+            while (!eos) {
+                Block block;
+                EXPECT_TRUE(merger.get_next(&block, &eos).ok());
+                for (size_t i = 0; i < block.rows(); ++i) {
+                    result.push_back(block.get_by_position(0).column->get_int(i));
+                }
+            }
+        }
+        return result;
+    }
+
+    std::unique_ptr<VSlotRef> _slot_ref;
+    std::unique_ptr<VExprContext> _ctx;
+    std::vector<VExprContext*> _ordering_expr;
+    std::vector<bool> _is_asc_order {true};
+    std::vector<bool> _nulls_first {false};
+};
+
+TEST_F(VSortedRunMergerTest, ParallelMergeEqualsSerialMerge) {
+    ASSERT_EQ(16, config::parallel_merge_runs_per_thread);
+    size_t num_sub_mergers = 0;
+    std::vector<int32_t> serial = merge(40, false, -1, 0, &num_sub_mergers);
+    EXPECT_EQ(0, num_sub_mergers);
+    std::vector<int32_t> parallel = merge(40, true, -1, 0, &num_sub_mergers);
+    EXPECT_EQ(3, num_sub_mergers);
+
+    // all rows of all runs in order, 6 of the 40 runs are empty
+    std::vector<int32_t> expected;
+    for (auto& run : make_runs(40, 10)) {
+        for (auto& block : run->blocks) {
+            for (size_t i = 0; i < block->rows(); ++i) {
+                expected.push_back(block->get_by_position(0).column->get_int(i));
+            }
+        }
+    }
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(34 * 10 + 33 * 10, expected.size());
+    EXPECT_EQ(expected, serial);
+    EXPECT_EQ(expected, parallel);
+}
+
+TEST_F(VSortedRunMergerTest, ParallelMergeWithLimitAndOffset) {
+    size_t num_sub_mergers = 0;
+    std::vector<int32_t> all = merge(40, false, -1, 0, &num_sub_mergers);
+    for (auto [limit, offset] : std::vector<std::pair<int64_t, size_t>> {
+                 {25, 0}, {25, 7}, {1, 100}, {-1, 30}, {1000, 600}}) {
+        std::vector<int32_t> serial = merge(40, false, limit, offset, &num_sub_mergers);
+        std::vector<int32_t> parallel = merge(40, true, limit, offset, &num_sub_mergers);
+        EXPECT_EQ(3, num_sub_mergers);
+
+        size_t begin = std::min(offset, all.size());
+        size_t end = limit == -1 ? all.size() : std::min(begin + limit, all.size());
+        std::vector<int32_t> expected(all.begin() + begin, all.begin() + end);
+        EXPECT_EQ(expected, serial) << "limit=" << limit << ", offset=" << offset;
+        EXPECT_EQ(expected, parallel) << "limit=" << limit << ", offset=" << offset;
+    }
+}
+
+TEST_F(VSortedRunMergerTest, NotParallelUnderThreshold) {
+    size_t num_sub_mergers = 0;
+    std::vector<int32_t> serial = merge(16, false, -1, 0, &num_sub_mergers);
+    std::vector<int32_t> parallel = merge(16, true, -1, 0, &num_sub_mergers);
+    // exactly parallel_merge_runs_per_thread runs are merged by one merger
+    EXPECT_EQ(0, num_sub_mergers);
+    EXPECT_EQ(serial, parallel);
+}
+
+} // namespace doris::vectorized
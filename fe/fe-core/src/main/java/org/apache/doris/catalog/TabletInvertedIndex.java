@@ -112,7 +112,9 @@ public class TabletInvertedIndex {
         this.lock.writeLock().unlock();
     }
 
-    public void tabletReport(long backendId, Map<Long, TTablet> backendTablets,
+    // if isIncremental, backendTablets only contains the changed tablets on the backend,
+    // so the replicas missing from it are not put into tabletDeleteFromMeta
+    public void tabletReport(long backendId, Map<Long, TTablet> backendTablets, boolean isIncremental,
                              final HashMap<Long, TStorageMedium> storageMediumMap,
                              ListMultimap<Long, Long> tabletSyncMap,
                              ListMultimap<Long, Long> tabletDeleteFromMeta,
@@ -231,7 +233,7 @@ public class TabletInvertedIndex {
                         if (backendTabletInfo.isSetVersionCount()) {
                             replica.setVersionCount(backendTabletInfo.getVersionCount());
                         }
-                    } else {
+                    } else if (!isIncremental) {
                         // 2. (meta - be)
                         // may need delete from meta
                         LOG.debug("backend[{}] does not report tablet[{}-{}]", backendId, tabletId, tabletMeta);
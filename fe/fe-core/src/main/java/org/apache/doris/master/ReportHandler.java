@@ -97,6 +97,11 @@ public class ReportHandler extends Daemon {
 
     private BlockingQueue<ReportTask> reportQueue = Queues.newLinkedBlockingQueue();
 
+    // backends whose full tablet report has been handled by this master.
+    // an incremental tablet report does not tell which tablets were dropped on the backend,
+    // so a backend not in this set is asked for a full tablet report.
+    private Set<Long> fullTabletReportedBackends = Sets.newConcurrentHashSet();
+
     private enum ReportType {
         UNKNOWN,
         TASK,
@@ -138,6 +143,7 @@ public class ReportHandler extends Daemon {
         Map<String, TDisk> disks = null;
         Map<Long, TTablet> tablets = null;
         long reportVersion = -1;
+        boolean isIncrementalTabletReport = false;
 
         ReportType reportType = ReportType.UNKNOWN;
 
@@ -162,11 +168,20 @@ public class ReportHandler extends Daemon {
             reportType = ReportType.TABLET;
         }
 
+        if (tablets != null) {
+            isIncrementalTabletReport = request.isSetIncrementalTabletReport()
+                    && request.isIncrementalTabletReport();
+            // setting it also tells the backend that incremental tablet reports are handled
+            result.setNeedFullTabletReport(isIncrementalTabletReport
+                    && !fullTabletReportedBackends.contains(beId));
+        }
+
         if (request.isSetTabletMaxCompactionScore()) {
             backend.setTabletMaxCompactionScore(request.getTabletMaxCompactionScore());
         }
 
-        ReportTask reportTask = new ReportTask(beId, tasks, disks, tablets, reportVersion);
+        ReportTask reportTask = new ReportTask(beId, tasks, disks, tablets, reportVersion,
+                isIncrementalTabletReport);
         try {
             putToQueue(reportTask);
         } catch (Exception e) {
@@ -178,8 +193,8 @@ public class ReportHandler extends Daemon {
             return result;
         }
 
-        LOG.info("receive report from be {}. type: {}, current queue size: {}",
-                backend.getId(), reportType, reportQueue.size());
+        LOG.info("receive report from be {}. type: {}, incremental: {}, current queue size: {}",
+                backend.getId(), reportType, isIncrementalTabletReport, reportQueue.size());
         return result;
     }
 
@@ -212,15 +227,18 @@ public class ReportHandler extends Daemon {
         private Map<String, TDisk> disks;
         private Map<Long, TTablet> tablets;
         private long reportVersion;
+        private boolean isIncrementalTabletReport;
 
         public ReportTask(long beId, Map<TTaskType, Set<Long>> tasks,
                           Map<String, TDisk> disks,
-                          Map<Long, TTablet> tablets, long reportVersion) {
+                          Map<Long, TTablet> tablets, long reportVersion,
+                          boolean isIncrementalTabletReport) {
             this.beId = beId;
             this.tasks = tasks;
             this.disks = disks;
             this.tablets = tablets;
             this.reportVersion = reportVersion;
+            this.isIncrementalTabletReport = isIncrementalTabletReport;
         }
 
         @Override
@@ -236,17 +254,25 @@ public class ReportHandler extends Daemon {
                 if (reportVersion < backendReportVersion) {
                     LOG.warn("out of date report version {} from backend[{}]. current report version[{}]",
                             reportVersion, beId, backendReportVersion);
+                    // the backend does not send the tablets of this report again in its incremental reports
+                    fullTabletReportedBackends.remove(beId);
                 } else {
-                    ReportHandler.tabletReport(beId, tablets, reportVersion);
+                    ReportHandler.tabletReport(beId, tablets, reportVersion, isIncrementalTabletReport);
+                    if (!isIncrementalTabletReport) {
+                        fullTabletReportedBackends.add(beId);
+                    }
                 }
             }
         }
     }
 
-    private static void tabletReport(long backendId, Map<Long, TTablet> backendTablets, long backendReportVersion) {
+    // an incremental report only contains the tablets changed since the last report of the backend,
+    // the replicas missing from it are kept as they are.
+    private static void tabletReport(long backendId, Map<Long, TTablet> backendTablets, long backendReportVersion,
+                                     boolean isIncremental) {
         long start = System.currentTimeMillis();
-        LOG.info("backend[{}] reports {} tablet(s). report version: {}",
-                backendId, backendTablets.size(), backendReportVersion);
+        LOG.info("backend[{}] reports {} tablet(s). report version: {}, incremental: {}",
+                backendId, backendTablets.size(), backendReportVersion, isIncremental);
 
         // storage medium map
         HashMap<Long, TStorageMedium> storageMediumMap = Config.disable_storage_medium_check
@@ -271,7 +297,7 @@ public class ReportHandler extends Daemon {
         List<Triple<Long, Integer, Boolean>> tabletToInMemory = Lists.newArrayList();
 
         // 1. do the diff. find out (intersection) / (be - meta) / (meta - be)
-        Catalog.getCurrentInvertedIndex().tabletReport(backendId, backendTablets, storageMediumMap,
+        Catalog.getCurrentInvertedIndex().tabletReport(backendId, backendTablets, isIncremental, storageMediumMap,
                 tabletSyncMap,
                 tabletDeleteFromMeta,
                 tabletFoundInMeta,
@@ -288,6 +314,7 @@ public class ReportHandler extends Daemon {
 
         // 3. delete (meta - be)
         // BE will automatically drop defective tablets. these tablets should also be dropped in catalog
+        // always empty for an incremental report
         if (!tabletDeleteFromMeta.isEmpty()) {
             deleteFromMeta(tabletDeleteFromMeta, backendId, backendReportVersion);
         }
@@ -51,6 +51,8 @@ struct TTabletSchema {
     10: optional i32 sequence_col_idx = -1
     11: optional Types.TSortType sort_type
     12: optional i32 sort_col_num
+    // the hidden column storing all the other columns of a row
+    13: optional i32 row_store_col_idx = -1
 }
 
 // this enum stands for different storage format in src_backends
@@ -89,11 +89,17 @@ struct TReportRequest {
     // the max compaction score of all tablets on a backend,
     // this field should be set along with tablet report
     8: optional i64 tablet_max_compaction_score
+    // if true, the tablets only contain the tablets changed since the last tablet report,
+    // the other tablets on the backend are left as they are
+    9: optional bool incremental_tablet_report
 }
 
 struct TMasterResult {
     // required in V1
     1: required Status.TStatus status
+    // only set in the result of a tablet report, by a master that handles incremental tablet
+    // reports. If true, the backend should send a full tablet report next time
+    2: optional bool need_full_tablet_report
 }
 
 // Now we only support CPU share.
@@ -83,6 +83,7 @@ enum TPrimitiveType {
   STRING,
   ALL,
   QUANTILE_STATE,
+  JSONB,
 }
 
 enum TTypeNodeType {